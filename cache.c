@@ -37,43 +37,43 @@ static CACHEBLK  cacheblk[ CACHE_MAX_INDEX ] = {0};
 /* Public functions                                                  */
 /*-------------------------------------------------------------------*/
 
-int cache_nbr (int ix)
+DLL_EXPORT int cache_nbr (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].nbr;
 }
 
-int cache_busy (int ix)
+DLL_EXPORT int cache_busy (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].busy;
 }
 
-int cache_empty (int ix)
+DLL_EXPORT int cache_empty (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].empty;
 }
 
-int cache_waiters (int ix)
+DLL_EXPORT int cache_waiters (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].waiters;
 }
 
-S64 cache_size (int ix)
+DLL_EXPORT S64 cache_size (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].size;
 }
 
-S64 cache_hits (int ix)
+DLL_EXPORT S64 cache_hits (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].hits;
 }
 
-S64 cache_misses (int ix)
+DLL_EXPORT S64 cache_misses (int ix)
 {
     if (cache_check_ix(ix)) return -1;
     return cacheblk[ix].misses;
@@ -251,13 +251,13 @@ typedef struct _CACHEBLK {              /* Cache header              */
 /*-------------------------------------------------------------------*/
 CCH_DLL_IMPORT int cachestats_cmd(int argc, char *argv[], char *cmdline);
 
-int         cache_nbr(int ix);
-int         cache_busy(int ix);
-int         cache_empty(int ix);
-int         cache_waiters(int ix);
-S64         cache_size(int ix);
-S64         cache_hits(int ix);
-S64         cache_misses(int ix);
+CCH_DLL_IMPORT int cache_nbr(int ix);
+CCH_DLL_IMPORT int cache_busy(int ix);
+CCH_DLL_IMPORT int cache_empty(int ix);
+CCH_DLL_IMPORT int cache_waiters(int ix);
+CCH_DLL_IMPORT S64 cache_size(int ix);
+CCH_DLL_IMPORT S64 cache_hits(int ix);
+CCH_DLL_IMPORT S64 cache_misses(int ix);
 int         cache_busy_percent(int ix);
 int         cache_empty_percent(int ix);
 int         cache_hit_percent(int ix);
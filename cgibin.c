@@ -65,6 +65,8 @@
 #include "devtype.h"
 #include "opcode.h"
 #include "httpmisc.h"
+#include "qeth.h"
+#include "cckddasd.h"
 
 /*-------------------------------------------------------------------*/
 /*                     cgibin_blinkenlights_cpu                      */
@@ -1195,6 +1197,512 @@ void cgibin_xml_rates_info(WEBBLK *webblk)
     hprintf(webblk->sock,"</hercules>\n");
 }
 
+/*-------------------------------------------------------------------*/
+/*                        cgibin_metrics                             */
+/*-------------------------------------------------------------------*/
+/* Emulator statistics in the Prometheus text exposition format,     */
+/* also served as "/metrics". The entire response is formatted in    */
+/* storage before anything is written to the socket so no lock is    */
+/* ever held while waiting on the network. Each CPU, and each        */
+/* device's I/O latency histograms, are locked only long enough to   */
+/* copy them; all other counters are simply read as they are. The    */
+/* interrupt lock is never obtained.                                 */
+/*-------------------------------------------------------------------*/
+
+struct METRICS                          /* Response being formatted  */
+{
+    char*   buf;                        /* Response buffer           */
+    size_t  len;                        /* Bytes used                */
+    size_t  size;                       /* Bytes allocated           */
+};
+typedef struct METRICS METRICS;
+
+struct METRICS_CPU                      /* Copy of a CPU's counters  */
+{
+    U64     instcount;                  /* Instructions executed     */
+    U64     siototal;                   /* SIO/SSCH count            */
+    U64     waitusecs;                  /* Time spent in wait state  */
+    U32     mipsrate;                   /* Instructions per second   */
+    U32     siosrate;                   /* IOs per second            */
+    int     cpupct;                     /* Percent CPU busy          */
+    BYTE    online;                     /* CPU is online             */
+    BYTE    started;                    /* CPU is started            */
+};
+typedef struct METRICS_CPU METRICS_CPU;
+
+static void metrics_printf( METRICS* m, const char* fmt, ... )
+{
+    va_list  vl;
+    char*    p;
+    int      n;
+
+    while (m->buf)
+    {
+        va_start( vl, fmt );
+        n = vsnprintf( m->buf + m->len, m->size - m->len, fmt, vl );
+        va_end( vl );
+
+        if (n < 0)
+            return;
+
+        if ((size_t) n < m->size - m->len)
+        {
+            m->len += n;
+            return;
+        }
+
+        /* Didn't fit: double the buffer and try again */
+        if (!(p = realloc( m->buf, m->size * 2 )))
+        {
+            free( m->buf );
+            m->buf = NULL;
+            return;
+        }
+        m->buf   = p;
+        m->size *= 2;
+    }
+}
+
+static void metrics_family( METRICS* m, const char* name,
+                            const char* type, const char* help )
+{
+    metrics_printf( m, "# HELP hercules_%s %s\n", name, help );
+    metrics_printf( m, "# TYPE hercules_%s %s\n", name, type );
+}
+
+/* Copy a label value escaping backslash, double quote and newline   */
+static char* metrics_label( char* buf, size_t bufsz, const char* str )
+{
+    size_t  i = 0;
+
+    for (; *str && i < bufsz - 2; str++)
+    {
+        if (*str == '\\' || *str == '"' || *str == '\n')
+            buf[ i++ ] = '\\';
+        buf[ i++ ] = (*str == '\n') ? 'n' : *str;
+    }
+    buf[ i ] = 0;
+    return buf;
+}
+
+static int metrics_lock_cmp( const void* p1, const void* p2 )
+{
+    return strcmp( ((const LOCKSTAT*) p1)->name,
+                   ((const LOCKSTAT*) p2)->name );
+}
+
+static void metrics_cpus( METRICS* m )
+{
+    METRICS_CPU  cpus[ MAX_CPU_ENGS ];
+    REGS*        regs;
+    U64          now;
+    int          cpu;
+
+    memset( cpus, 0, sizeof( cpus ));
+
+    for (cpu = 0; cpu < sysblk.hicpu; cpu++)
+    {
+        obtain_lock( &sysblk.cpulock[ cpu ]);
+        {
+            if (IS_CPU_ONLINE( cpu ))
+            {
+                regs = sysblk.regs[ cpu ];
+                now  = host_tod();
+
+                cpus[ cpu ].online    = TRUE;
+                cpus[ cpu ].started   = (regs->cpustate == CPUSTATE_STARTED);
+                cpus[ cpu ].instcount = regs->prevcount + regs->instcount;
+                cpus[ cpu ].siototal  = regs->siototal  + regs->siocount;
+                cpus[ cpu ].mipsrate  = regs->mipsrate;
+                cpus[ cpu ].siosrate  = regs->siosrate;
+                cpus[ cpu ].cpupct    = regs->cpupct;
+                cpus[ cpu ].waitusecs = ETOD_high64_to_usecs(
+                                          regs->waittime_accumulated
+                                        + regs->waittime
+                                        + ((regs->waittod && now > regs->waittod)
+                                           ? now - regs->waittod : 0) );
+            }
+        }
+        release_lock( &sysblk.cpulock[ cpu ]);
+    }
+
+#define METRICS_EACH_CPU( _fmt, _field )                                \
+    for (cpu = 0; cpu < sysblk.hicpu; cpu++)                            \
+        if (cpus[ cpu ].online)                                         \
+            metrics_printf( m, "hercules_%s{cpu=\"%s%02X\"} " _fmt "\n",\
+                name, PTYPSTR( cpu ), cpu, cpus[ cpu ]._field )
+
+    {
+        const char* name;
+
+        metrics_family( m, name = "cpu_started", "gauge",
+            "Whether the CPU is started (1) or stopped (0)." );
+        METRICS_EACH_CPU( "%d", started );
+
+        metrics_family( m, name = "cpu_instructions_total", "counter",
+            "Instructions executed by the CPU." );
+        METRICS_EACH_CPU( "%"PRIu64, instcount );
+
+        metrics_family( m, name = "cpu_instructions_per_second", "gauge",
+            "Instructions executed per second over the last interval." );
+        METRICS_EACH_CPU( "%u", mipsrate );
+
+        metrics_family( m, name = "cpu_sio_total", "counter",
+            "SIO/SSCH instructions issued by the CPU." );
+        METRICS_EACH_CPU( "%"PRIu64, siototal );
+
+        metrics_family( m, name = "cpu_sio_per_second", "gauge",
+            "SIO/SSCH instructions issued per second over the last interval." );
+        METRICS_EACH_CPU( "%u", siosrate );
+
+        metrics_family( m, name = "cpu_busy_percent", "gauge",
+            "Percentage of the last interval the CPU was not in wait state." );
+        METRICS_EACH_CPU( "%d", cpupct );
+
+        metrics_family( m, name = "cpu_wait_seconds_total", "counter",
+            "Time the CPU has spent in wait state." );
+        for (cpu = 0; cpu < sysblk.hicpu; cpu++)
+            if (cpus[ cpu ].online)
+                metrics_printf( m, "hercules_%s{cpu=\"%s%02X\"} %"PRIu64".%06u\n",
+                    name, PTYPSTR( cpu ), cpu,
+                    cpus[ cpu ].waitusecs / 1000000,
+                    (unsigned)(cpus[ cpu ].waitusecs % 1000000) );
+    }
+
+#undef METRICS_EACH_CPU
+
+    metrics_family( m, "instructions_per_second", "gauge",
+        "Instructions executed per second by all CPUs." );
+    metrics_printf( m, "hercules_instructions_per_second %u\n", sysblk.mipsrate );
+
+    metrics_family( m, "sio_per_second", "gauge",
+        "SIO/SSCH instructions issued per second by all CPUs." );
+    metrics_printf( m, "hercules_sio_per_second %u\n", sysblk.siosrate );
+}
+
+/* One I/O latency histogram of each device that has done any I/O   */
+static void metrics_iolat( METRICS* m, const char* name,
+                           size_t offset, const char* help )
+{
+    DEVBLK*     dev;
+    IOLAT_HIST  h;
+    U64         cum;
+    int         i;
+
+    metrics_family( m, name, "histogram", help );
+
+    for (dev = sysblk.firstdev; dev; dev = dev->nextdev)
+    {
+        if (!dev->allocated)
+            continue;
+
+        obtain_lock( &dev->lock );
+        {
+            memcpy( &h, (BYTE*) &dev->iolat + offset, sizeof( h ));
+        }
+        release_lock( &dev->lock );
+
+        if (!h.count)
+            continue;
+
+        /* (the control unit being the first two digits of devnum) */
+        for (i = 0, cum = 0; i < IOLAT_BUCKETS; i++)
+        {
+            cum += h.bucket[i];
+            if (i < IOLAT_BUCKETS-1)
+                metrics_printf( m, "hercules_%s_bucket{device=\"%1d:%04X\",cu=\"%1d:%02X\","
+                    "type=\"%s\",le=\"%"PRIu64".%06u\"} %"PRIu64"\n",
+                    name, LCSS_DEVNUM, SSID_TO_LCSS( dev->ssid ), dev->devnum >> 8,
+                    dev->typname, ((U64) 1 << i) / 1000000,
+                    (unsigned)(((U64) 1 << i) % 1000000), cum );
+            else
+                metrics_printf( m, "hercules_%s_bucket{device=\"%1d:%04X\",cu=\"%1d:%02X\","
+                    "type=\"%s\",le=\"+Inf\"} %"PRIu64"\n",
+                    name, LCSS_DEVNUM, SSID_TO_LCSS( dev->ssid ), dev->devnum >> 8,
+                    dev->typname, cum );
+        }
+        metrics_printf( m, "hercules_%s_sum{device=\"%1d:%04X\",cu=\"%1d:%02X\","
+            "type=\"%s\"} %"PRIu64".%06u\n",
+            name, LCSS_DEVNUM, SSID_TO_LCSS( dev->ssid ), dev->devnum >> 8,
+            dev->typname, h.sumusecs / 1000000, (unsigned)(h.sumusecs % 1000000) );
+        metrics_printf( m, "hercules_%s_count{device=\"%1d:%04X\",cu=\"%1d:%02X\","
+            "type=\"%s\"} %"PRIu64"\n",
+            name, LCSS_DEVNUM, SSID_TO_LCSS( dev->ssid ), dev->devnum >> 8,
+            dev->typname, h.count );
+    }
+}
+
+static void metrics_devices( METRICS* m )
+{
+    DEVBLK*  dev;
+
+    metrics_family( m, "device_io_total", "counter",
+        "Channel programs started on the device." );
+    for (dev = sysblk.firstdev; dev; dev = dev->nextdev)
+        if (dev->allocated)
+            metrics_printf( m, "hercules_device_io_total"
+                "{device=\"%1d:%04X\",type=\"%s\"} %"PRIu64"\n",
+                LCSS_DEVNUM, dev->typname, dev->excps );
+
+    metrics_family( m, "device_busy", "gauge",
+        "Whether the device is busy with an I/O operation." );
+    for (dev = sysblk.firstdev; dev; dev = dev->nextdev)
+        if (dev->allocated)
+            metrics_printf( m, "hercules_device_busy"
+                "{device=\"%1d:%04X\",type=\"%s\"} %d\n",
+                LCSS_DEVNUM, dev->typname, dev->busy ? 1 : 0 );
+
+    metrics_iolat( m, "device_io_queue_seconds", offsetof( IOLAT, queue ),
+        "Time from SSCH, SIO or RSCH until the channel program was started." );
+    metrics_iolat( m, "device_io_exec_seconds", offsetof( IOLAT, exec ),
+        "Time taken to execute the channel program." );
+    metrics_iolat( m, "device_io_intr_seconds", offsetof( IOLAT, intr ),
+        "Time from final status pending until presented to the guest." );
+}
+
+static void metrics_caches( METRICS* m )
+{
+    static const char* names[] = { "devbuf", "l2" };
+    char  label[ CACHE_MAX_INDEX ][ 16 ];
+    bool  created[ CACHE_MAX_INDEX ];
+    int   ix;
+
+    for (ix = 0; ix < CACHE_MAX_INDEX; ix++)
+    {
+        created[ ix ] = cache_nbr( ix ) > 0;
+        if (ix < (int) _countof( names ))
+            STRLCPY( label[ ix ], names[ ix ] );
+        else
+            MSGBUF( label[ ix ], "%d", ix );
+    }
+
+#define METRICS_EACH_CACHE( _name, _type, _help, _fmt, _value )         \
+    metrics_family( m, _name, _type, _help );                           \
+    for (ix = 0; ix < CACHE_MAX_INDEX; ix++)                            \
+        if (created[ ix ])                                              \
+            metrics_printf( m, "hercules_" _name "{cache=\"%s\"} "      \
+                _fmt "\n", label[ ix ], _value )
+
+    METRICS_EACH_CACHE( "cache_hits_total", "counter",
+        "Cache lookups that found the entry.", "%"PRId64, cache_hits( ix ));
+    METRICS_EACH_CACHE( "cache_misses_total", "counter",
+        "Cache lookups that did not find the entry.", "%"PRId64, cache_misses( ix ));
+    METRICS_EACH_CACHE( "cache_entries", "gauge",
+        "Number of cache entries.", "%d", cache_nbr( ix ));
+    METRICS_EACH_CACHE( "cache_busy_entries", "gauge",
+        "Number of cache entries in use.", "%d", cache_busy( ix ));
+    METRICS_EACH_CACHE( "cache_empty_entries", "gauge",
+        "Number of cache entries without a buffer.", "%d", cache_empty( ix ));
+    METRICS_EACH_CACHE( "cache_waiters", "gauge",
+        "Threads waiting for a cache entry.", "%d", cache_waiters( ix ));
+    METRICS_EACH_CACHE( "cache_size_bytes", "gauge",
+        "Storage used by the cache buffers.", "%"PRId64, cache_size( ix ));
+
+#undef METRICS_EACH_CACHE
+}
+
+static void metrics_cckd( METRICS* m )
+{
+    if (memcmp( cckdblk.id, CCKDBLK_ID, sizeof( cckdblk.id )) != 0)
+        return;     /* (no compressed dasd was ever opened) */
+
+#define METRICS_CCKD( _name, _type, _help, _fmt, _value )               \
+    metrics_family( m, _name, _type, _help );                           \
+    metrics_printf( m, "hercules_" _name " " _fmt "\n", _value )
+
+    METRICS_CCKD( "cckd_writes_pending", "gauge",
+        "Updated tracks waiting to be written.", "%d", cckdblk.wrpending );
+    METRICS_CCKD( "cckd_writers_waiting", "gauge",
+        "Idle writer threads.", "%d", cckdblk.wrwaiting );
+    METRICS_CCKD( "cckd_writers", "gauge",
+        "Writer threads started.", "%d", cckdblk.wrs );
+    METRICS_CCKD( "cckd_cache_hits_total", "counter",
+        "Track cache hits.", "%"PRIu64, cckdblk.stats_cachehits );
+    METRICS_CCKD( "cckd_cache_misses_total", "counter",
+        "Track cache misses.", "%"PRIu64, cckdblk.stats_cachemisses );
+    METRICS_CCKD( "cckd_l2_cache_hits_total", "counter",
+        "Level 2 table cache hits.", "%"PRIu64, cckdblk.stats_l2cachehits );
+    METRICS_CCKD( "cckd_l2_cache_misses_total", "counter",
+        "Level 2 table cache misses.", "%"PRIu64, cckdblk.stats_l2cachemisses );
+    METRICS_CCKD( "cckd_readaheads_total", "counter",
+        "Tracks read ahead.", "%"PRIu64, cckdblk.stats_readaheads );
+    METRICS_CCKD( "cckd_readahead_misses_total", "counter",
+        "Tracks read ahead but never used.", "%"PRIu64, cckdblk.stats_readaheadmisses );
+    METRICS_CCKD( "cckd_reads_total", "counter",
+        "Track images read.", "%"PRIu64, cckdblk.stats_reads );
+    METRICS_CCKD( "cckd_read_bytes_total", "counter",
+        "Bytes of track images read.", "%"PRIu64, cckdblk.stats_readbytes );
+    METRICS_CCKD( "cckd_writes_total", "counter",
+        "Track images written.", "%"PRIu64, cckdblk.stats_writes );
+    METRICS_CCKD( "cckd_write_bytes_total", "counter",
+        "Bytes of track images written.", "%"PRIu64, cckdblk.stats_writebytes );
+    METRICS_CCKD( "cckd_stress_writes_total", "counter",
+        "Tracks written early because the cache was under stress.", "%"PRIu64, cckdblk.stats_stresswrites );
+    METRICS_CCKD( "cckd_io_waits_total", "counter",
+        "Waits for track i/o to complete.", "%"PRIu64, cckdblk.stats_iowaits );
+    METRICS_CCKD( "cckd_cache_waits_total", "counter",
+        "Waits for a free cache entry.", "%"PRIu64, cckdblk.stats_cachewaits );
+
+#undef METRICS_CCKD
+}
+
+static void metrics_qeth( METRICS* m )
+{
+    static const struct
+    {
+        const char*  name;
+        const char*  type;
+        const char*  help;
+    }
+    fam[] =
+    {
+        { "qeth_rx_packets_total", "counter", "Packets read from the network." },
+        { "qeth_tx_packets_total", "counter", "Packets written to the network." },
+        { "qeth_dropped_total",    "counter", "Packets dropped."                },
+        { "qeth_rx_bytes_total",   "counter", "Bytes read from the network."    },
+        { "qeth_tx_bytes_total",   "counter", "Bytes written to the network."   },
+        { "qeth_interrupts_total", "counter", "Adapter interrupts presented."   },
+        { "qeth_coalesced_total",  "counter", "Input interrupts coalesced."     },
+    };
+    DEVBLK*   dev;
+    OSA_GRP*  grp;
+    U64       val[ _countof( fam ) ];
+    char      ifname[ 2 * IFNAMSIZ ];
+    int       f, i;
+
+    for (f = 0; f < (int) _countof( fam ); f++)
+    {
+        metrics_family( m, fam[f].name, fam[f].type, fam[f].help );
+
+        for (dev = sysblk.firstdev; dev; dev = dev->nextdev)
+        {
+            /* Once per complete QETH group, for its first device */
+            if (0
+                || !dev->allocated
+                || dev->devtype != 0x1731
+                || !dev->group
+                || dev->group->members != dev->group->acount
+                || dev->group->memdev[0] != dev
+            )
+                continue;
+
+            grp = dev->group->grp_data;
+            memset( val, 0, sizeof( val ));
+
+            /* (the counts are kept by whichever member is the data device) */
+            for (i = 0; i < dev->group->acount; i++)
+            {
+                val[0] += dev->group->memdev[i]->qdio.rxcnt;
+                val[1] += dev->group->memdev[i]->qdio.txcnt;
+                val[2] += dev->group->memdev[i]->qdio.dropcnt;
+                val[3] += dev->group->memdev[i]->qdio.rxbytes;
+                val[4] += dev->group->memdev[i]->qdio.txbytes;
+            }
+            val[5] = grp->intcnt;
+            val[6] = grp->iccnt;
+
+            metrics_printf( m, "hercules_%s{device=\"%1d:%04X\",interface=\"%s\"} %"PRIu64"\n",
+                fam[f].name, LCSS_DEVNUM,
+                metrics_label( ifname, sizeof( ifname ), grp->ttifname ), val[f] );
+        }
+    }
+}
+
+static void metrics_locks( METRICS* m )
+{
+    LOCKSTAT*  lks;
+    char       name[ 2 * sizeof( lks->name ) ];
+    int        i, j, n;
+
+    if (!(n = hthread_get_lock_stats( &lks )))
+        return;
+
+    /* Only locks ever obtained, summing any with the same name      */
+    qsort( lks, n, sizeof( LOCKSTAT ), metrics_lock_cmp );
+    for (i = -1, j = 0; j < n; j++)
+    {
+        if (!lks[j].obtains)
+            continue;
+        if (i >= 0 && strcmp( lks[i].name, lks[j].name ) == 0)
+        {
+            lks[i].obtains   += lks[j].obtains;
+            lks[i].contended += lks[j].contended;
+            lks[i].waitusecs += lks[j].waitusecs;
+        }
+        else
+            lks[++i] = lks[j];
+    }
+    n = i + 1;
+
+    metrics_family( m, "lock_obtains_total", "counter",
+        "Times the lock was obtained exclusively." );
+    for (i = 0; i < n; i++)
+        metrics_printf( m, "hercules_lock_obtains_total{lock=\"%s\"} %"PRIu64"\n",
+            metrics_label( name, sizeof( name ), lks[i].name ), lks[i].obtains );
+
+    metrics_family( m, "lock_contended_total", "counter",
+        "Times a thread had to wait to obtain the lock." );
+    for (i = 0; i < n; i++)
+        metrics_printf( m, "hercules_lock_contended_total{lock=\"%s\"} %"PRIu64"\n",
+            metrics_label( name, sizeof( name ), lks[i].name ), lks[i].contended );
+
+    metrics_family( m, "lock_wait_seconds_total", "counter",
+        "Time threads have spent waiting to obtain the lock." );
+    for (i = 0; i < n; i++)
+        metrics_printf( m, "hercules_lock_wait_seconds_total{lock=\"%s\"} %"PRIu64".%06u\n",
+            metrics_label( name, sizeof( name ), lks[i].name ),
+            lks[i].waitusecs / 1000000, (unsigned)(lks[i].waitusecs % 1000000) );
+
+    free( lks );
+}
+
+static void metrics_logger( METRICS* m )
+{
+    U64  msgs, dropped, blocked;
+    U32  inuse;
+
+    log_ringstats( &msgs, &dropped, &blocked, &inuse );
+
+    metrics_family( m, "log_messages_total", "counter",
+        "Messages written to the logger message ring." );
+    metrics_printf( m, "hercules_log_messages_total %"PRIu64"\n", msgs );
+    metrics_family( m, "log_dropped_total", "counter",
+        "Messages dropped because the logger message ring was full." );
+    metrics_printf( m, "hercules_log_dropped_total %"PRIu64"\n", dropped );
+    metrics_family( m, "log_blocked_total", "counter",
+        "Messages that had to wait for room in the logger message ring." );
+    metrics_printf( m, "hercules_log_blocked_total %"PRIu64"\n", blocked );
+    metrics_family( m, "log_ring_slots_used", "gauge",
+        "Logger message ring slots not yet processed by the logger." );
+    metrics_printf( m, "hercules_log_ring_slots_used %u\n", inuse );
+}
+
+void cgibin_metrics(WEBBLK *webblk)
+{
+    METRICS  m;
+
+    m.len  = 0;
+    m.size = 64 * 1024;
+    m.buf  = malloc( m.size );
+
+    metrics_cpus    ( &m );
+    metrics_devices ( &m );
+    metrics_caches  ( &m );
+    metrics_cckd    ( &m );
+    metrics_qeth    ( &m );
+    metrics_locks   ( &m );
+    metrics_logger  ( &m );
+
+    hprintf(webblk->sock,"Expires: 0\n");
+    hprintf(webblk->sock,"Content-type: text/plain; version=0.0.4\n\n");
+
+    if (m.buf)
+    {
+        hwrite( webblk->sock, m.buf, m.len );
+        free( m.buf );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*   cgibin_hwrite      --      helper function to output HTML       */
 /*-------------------------------------------------------------------*/
@@ -1344,6 +1852,8 @@ CGITAB cgidir[] =
 
     { "xml/rates",           &cgibin_xml_rates_info      },
 
+    { "metrics",             &cgibin_metrics             },
+
     { NULL, NULL }
 };
 
@@ -497,6 +497,41 @@ AIPSX (const SCSW* scsw)
 }
 
 
+/*--------------------------------------------------------------------*/
+/*  Record one I/O latency measurement: the time from 'since' until   */
+/*  now. Returns now.                          (dev->lock held)       */
+/*--------------------------------------------------------------------*/
+static INLINE U64
+iolat_record(IOLAT_HIST* hist, U64 since)
+{
+    U64  now   = host_tod();
+    U64  usecs = ETOD_high64_to_usecs( now > since ? now - since : 0 );
+    int  i;
+
+    for (i=0; i < IOLAT_BUCKETS-1 && usecs > (1ULL << i); i++);
+
+    hist->bucket[i]++;
+    hist->sumusecs += usecs;
+    hist->count++;
+    return (now);
+}
+
+
+/*--------------------------------------------------------------------*/
+/*  The final status of the last I/O is now being presented, either   */
+/*  as an I/O interrupt or by TEST SUBCHANNEL. (dev->lock held)       */
+/*--------------------------------------------------------------------*/
+static INLINE void
+iolat_presented(DEVBLK* dev)
+{
+    if (dev->iolat.endat)
+    {
+        iolat_record( &dev->iolat.intr, dev->iolat.endat );
+        dev->iolat.endat = 0;
+    }
+}
+
+
 /*--------------------------------------------------------------------*/
 /*  Queue I/O interrupt and update status (locked)                    */
 /*                                                                    */
@@ -521,6 +556,13 @@ queue_io_interrupt_and_update_status_locked(DEVBLK* dev, int clrbsy)
     else
         DEQUEUE_IO_INTERRUPT_QLOCKED(&dev->ioint);
 
+    /* Final status of a channel program ends its execution time */
+    if (clrbsy && dev->iolat.execat && (dev->scsw.flag3 & SCSW3_SC_PEND))
+    {
+        dev->iolat.endat  = iolat_record( &dev->iolat.exec, dev->iolat.execat );
+        dev->iolat.execat = 0;
+    }
+
     /* Perform cleanup for DEVBLK flags being deprecated */
     subchannel_interrupt_queue_cleanup(dev);
 
@@ -1539,6 +1581,9 @@ test_subchan_locked (REGS* regs, DEVBLK* dev,
     /* Ensure status removed from interrupt queue */
     DEQUEUE_IO_INTERRUPT_QLOCKED(*ioint);
 
+    if (status == normal)
+        iolat_presented( dev );
+
     /* Display the subchannel status word */
     if (CCW_TRACE_OR_STEP( dev ))
         display_scsw( dev, **scsw );
@@ -2752,6 +2797,7 @@ int cc;                                 /* Return code               */
 
         /* Set the resume pending flag and signal the subchannel */
         dev->scsw.flag2 |= SCSW2_AC_RESUM;
+        dev->iolat.startat = host_tod();
         cc = schedule_ioq(NULL, dev);
     }
 
@@ -4082,6 +4128,7 @@ int     rc;                             /* Return code               */
     dev->priority |= dev->orb.cupriority;
 
     /* Schedule the I/O for execution */
+    dev->iolat.startat = host_tod();
     rc = schedule_ioq((sysblk.arch_mode == ARCH_370_IDX) ? regs : NULL,
                       dev);
 
@@ -4210,6 +4257,13 @@ IOBUF iobuf_initial;                    /* Channel I/O buffer        */
     /* Increment excp count */
     dev->excps++;
 
+    /* Measure how long the request was waiting to be started */
+    if (dev->iolat.startat)
+    {
+        dev->iolat.execat  = iolat_record( &dev->iolat.queue, dev->iolat.startat );
+        dev->iolat.startat = 0;
+    }
+
     /* Indicate that we're started */
     dev->scsw.flag2 |= SCSW2_FC_START;
     dev->scsw.flag2 &= ~SCSW2_AC_START;
@@ -5989,6 +6043,9 @@ retry:
 
                 /* Dequeue the interrupt */
                 DEQUEUE_IO_INTERRUPT_QLOCKED( io );
+
+                if (io == &dev->ioint)
+                    iolat_presented( dev );
             }
 
             /* TEST SUBCHANNEL is now required to clear the interrupt */
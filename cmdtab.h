@@ -241,6 +241,19 @@
   "        OFF     disables command separation.\n"
 
 #define cnslport_cmd_desc       "Set console port"
+#define cnslthreads_cmd_desc    "Set/display number of console I/O threads"
+#define cnslthreads_cmd_help    \
+                                \
+  "Format: CNSLTHREADS [n]\n"                                                   \
+  "\n"                                                                          \
+  "Sets the number of threads that serve connected tn3270 and telnet\n"         \
+  "console clients, from 1 (the default) to 16. Each client is served by\n"     \
+  "the thread with the fewest clients when it connects. With more than\n"       \
+  "one thread the input of many busy clients is handled in parallel.\n"         \
+  "Threads are added as soon as the value is raised; lowering it takes\n"       \
+  "effect the next time the console connection thread is started. Only\n"       \
+  "used on hosts with epoll support. Enter without an argument to display\n"    \
+  "the current value.\n"
 
 #if defined(_FEATURE_047_CMPSC_ENH_FACILITY)
 #define cmpscpad_cmd_desc       "Set/display the CMPSC zero padding value."
@@ -494,6 +507,25 @@
   "Type \"ecpsvm help\" to see a list of available commands\n"
 
 #define engines_cmd_desc        "Set engines parameter"
+
+#define emustat_cmd_desc        "Display emulator hot path statistics"
+#define emustat_cmd_help        \
+                                \
+  "Format: \"emustat [ SNAP | DIFF | RESET | DUMP filename ]\"\n"               \
+  "\n"                                                                          \
+  "Displays how often each CPU took the slower paths through the\n"             \
+  "emulator: TLB hits and misses (full DAT translations) of virtual\n"          \
+  "storage accesses, calls to instfetch when the next instruction was not\n"    \
+  "on the current instruction page, storage operands crossing a page\n"         \
+  "boundary and instructions ended by a longjmp (program interrupts etc.).\n"   \
+  "SNAP remembers the current counts, DIFF displays how much they have\n"       \
+  "grown since, RESET zeroes them and DUMP appends them to a CSV file, one\n"   \
+  "line per CPU, for graphing. RESET is approximate on running CPUs: the\n"     \
+  "counters are updated without a lock, so an update racing the reset can\n"    \
+  "put back a count from just before it. Use 'icount time' for the host\n"      \
+  "time spent in each opcode. Only available when built with\n"                 \
+  "OPTION_EMULATION_STATS.\n"
+
 #define evm_cmd_desc            "Command deprecated - Use \"ECPSVM\""
 #define evm_cmd_help            \
                                 \
@@ -591,7 +623,8 @@
   "Format: \"hao  tgt <tgt> | cmd <cmd> | list <n> | del <n> | clear \".\n"     \
   "  hao tgt <tgt> : define target rule (regex pattern) to react on\n"          \
   "  hao cmd <cmd> : define command for previously defined rule\n"              \
-  "  hao list <n>  : list all rules/commands or only at index <n>\n"            \
+  "  hao list <n>  : list all rules/commands or only at index <n>,\n"           \
+  "                  with match statistics and prefilter keys\n"                \
   "  hao del <n>   : delete the rule at index <n>\n"                            \
   "  hao clear     : delete all rules (stops automatic operator)\n"
 
@@ -658,6 +691,8 @@
 #define icount_cmd_help         \
                                 \
   "Format: \"icount [[Enable|STArt] | [Disable|STOp] | [Clear|Reset|Zero]]\".\n" \
+  "        \"icount SAmple n\"\n"                                               \
+  "        \"icount Time ON|OFF\"\n"                                            \
   "\n"                                                                          \
   "Enables or disables the counting of, resets the counts for, or\n"            \
   "displays how often each instruction opcode is executed. This is a\n"         \
@@ -670,7 +705,13 @@
   "before enabling counting when your workload begins. Use the stop\n"          \
   "option when your workload ends to stop counting. Enter the command\n"        \
   "with no options to display a list of executed instruction opcodes\n"         \
-  "sorted by frequency/popularity.\n"
+  "sorted by frequency/popularity.\n"                                           \
+  "\n"                                                                          \
+  "Each CPU counts into its own table; the display totals them all.\n"          \
+  "SAMPLE n counts only one in every n instructions (each counted as n)\n"      \
+  "so counting can be left enabled with little overhead. TIME ON also\n"        \
+  "accumulates the host time (or cycles) spent in each opcode, and the\n"       \
+  "display then shows the average per instruction.\n"
 
 #define iodelay_cmd_desc        "Display or set I/O delay value"
 #define iodelay_cmd_help        \
@@ -684,6 +725,23 @@
   "machine because we may present an I/O interrupt sooner than a\n"             \
   "real machine.\n"
 
+#define iolat_cmd_desc          "Display device I/O latency statistics"
+#define iolat_cmd_help          \
+                                \
+  "Format: \"iolat [devn | CU | RESET]\"\n"                                     \
+  "\n"                                                                          \
+  "Displays, for every device that has done any I/O or only for device\n"       \
+  "devn, the average, median and 99th percentile of the time spent by its\n"    \
+  "I/O requests in each of three stages: \"queue\" from the acceptance of\n"    \
+  "the SSCH, SIO or RSCH until a device thread starts the channel program,\n"   \
+  "\"exec\" executing the channel program until its final status is made\n"     \
+  "pending, and \"intr\" from then until the status is presented to the\n"      \
+  "guest as an I/O interrupt or by TEST SUBCHANNEL. The median and 99th\n"      \
+  "percentile are the power of 2 microsecond bucket they fall into.\n"          \
+  "CU combines the devices of each control unit, i.e. whose device numbers\n"   \
+  "share the same first two digits. RESET zeroes all the statistics. The\n"     \
+  "full histograms are also provided by the HTTP server at /metrics.\n"
+
 #define ipending_cmd_desc       "Display pending interrupts"
 #define ipl_cmd_desc            "IPL from device or file"
 #define ipl_cmd_help            \
@@ -772,13 +830,17 @@
 #define logopt_cmd_desc         "Set/Display logging options"
 #define logopt_cmd_help         \
                                 \
-  "Format: \"LOGOPT [DATESTAMP | NODATESTAMP] [TIMESTAMP | NOTIMESTAMP]\".\n\n" \
+  "Format: \"LOGOPT [DATESTAMP | NODATESTAMP] [TIMESTAMP | NOTIMESTAMP]\n"      \
+  "                [DROP | BLOCK[=msecs]]\".\n\n"                               \
   "Sets logfile options. \"TIMESTAMP\" inserts a time stamp in front of\n"     \
   "each log message. \"NOTIMESTAMP\" logs messages without time stamps.\n"      \
   "Similarly, \"DATESTAMP\" and \"NODATESTAMP\" prefixes logfile messages\n"    \
   "with or without the current date. Entering the command with no arguments\n"  \
-  "displays current logging options. The current resolution of the stamp\n"     \
-  "is one second.\n"
+  "displays current logging options and logger message ring statistics.\n"      \
+  "The current resolution of the stamp is one second.\n\n"                      \
+  "\"DROP\" and \"BLOCK\" say what a thread does when the logger's message\n"   \
+  "ring is full: drop its message at once, or wait up to 'msecs' (default\n"    \
+  "50) for room before dropping it. The default is BLOCK=50.\n"
 
 #define lparname_cmd_desc       "Set LPAR name"
 #define lparname_cmd_help       \
@@ -1053,6 +1115,30 @@
   "interruption.\n"
 
 #define plant_cmd_desc          "Set STSI plant code"
+#define profile_cmd_desc        "Guest sampling profiler"
+#define profile_cmd_help        \
+                                \
+  "Format:  \"profile  [ ON [RATE=nnn] [SIZE=nnn] | OFF | CLEAR ]\"\n"          \
+  "         \"profile  [ TOP | PAGES | MODULES ]  [n]\"\n"                      \
+  "         \"profile  [ MAP | WRITE ]  filename\"\n"                           \
+  "\n"                                                                          \
+  "While the profiler is on, the timer thread samples every started CPU\n"      \
+  "RATE times a second (default 1000), recording the address it is\n"           \
+  "executing, its primary ASN, its problem/supervisor state and whether\n"      \
+  "it is running a SIE guest. This does not slow the CPUs. The samples\n"       \
+  "are counted in a table of SIZE addresses (default 65536). Samples of\n"      \
+  "waiting CPUs are counted separately. 'ON' discards previous samples;\n"      \
+  "'OFF' stops sampling but keeps them; 'CLEAR' discards them.\n"               \
+  "\n"                                                                          \
+  "'TOP' displays the n (default 20) most sampled addresses, 'PAGES' the\n"     \
+  "most sampled 4K pages and 'MODULES' the most sampled modules. Modules\n"     \
+  "are defined by the address map file loaded by 'MAP', each line of which\n"   \
+  "is \"start end name\" with the start and end address in hex.\n"              \
+  "\n"                                                                          \
+  "'WRITE' writes the samples as a collapsed stack file, which tools such\n"    \
+  "as flamegraph.pl can turn into a flame graph. The sampling rate cannot\n"    \
+  "usefully exceed the rate set by the 'timerint' command.\n"
+
 #define pr_cmd_desc             "Display or alter prefix register"
 #define pr_cmd_help             \
                                 \
@@ -1078,13 +1164,19 @@
   "\n"                                                                          \
   "Enter \"psw\" by itself to display the current PSW without altering it.\n"
 
-#define ptp_cmd_desc            "Enable/Disable PTP debugging"
+#define ptp_cmd_desc            "Enable/Disable PTP debugging or display PTP statistics"
 #define ptp_cmd_help            \
                                 \
   "Format:  \"ptp  debug  { on | off } [ [ <devnum> | ALL ] [ mask ] ]\".\n\n"  \
   "Enables/disables debug tracing for the PTP device group\n"                   \
   "identified by <devnum>, or for all PTP device groups if\n"                   \
-  "<devnum> is not specified or specified as 'ALL'.\n"
+  "<devnum> is not specified or specified as 'ALL'.\n\n"                        \
+  "Format:  \"ptp  stats  [ <devnum> | ALL ]\".\n\n"                            \
+  "Displays the MPC blocks, IP packets and bytes read and written\n"            \
+  "and the packets dropped on each path of the PTP device group\n"              \
+  "identified by <devnum>, or of all PTP device groups if <devnum>\n"           \
+  "is not specified or specified as 'ALL', together with the number\n"          \
+  "of times the guest's read was woken and the buffer pool usage.\n"
 
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
   #define ptt_cmd_help_txf "     (no)txf          trace Transactional-Execution Facility events\n"
@@ -1098,7 +1190,9 @@
   "Format: \"ptt [?] [events] [options] [nnnnnn]\"\n"                               \
   "\n"                                                                              \
   "When specified with no operands, the ptt command displays the defined trace\n"   \
-  "parameters and the contents of the internal trace table.\n"                      \
+  "parameters and the contents of the internal trace table. Each thread traces\n"   \
+  "into its own table without locking; all of them are merged by time of day\n"    \
+  "when displayed.\n"                                                               \
   "\n"                                                                              \
   "When specified with operands, the ptt command defines the trace parameters\n"    \
   "identifying which events are to be traced. When the last option is numeric,\n"   \
@@ -1125,11 +1219,11 @@
   "options:   (should be specified last, after any events are specified)\n"         \
   "\n"                                                                              \
   "     ?                show currently defined trace parameters\n"                 \
-  "     (no)lock         lock table before updating\n"                              \
+  "     (no)lock         (obsolete; ignored)\n"                                      \
   "     (no)tod          timestamp table entries\n"                                 \
   "     (no)wrap         wraparound trace table\n"                                  \
   "     to=nnn           automatic display timeout  (number of seconds)\n"          \
-  "     nnnnnn           table size                 (number of entries)\n"
+  "     nnnnnn           table size per thread      (number of entries)\n"
 
 #define qcpuid_cmd_desc         "Display cpuid(s)"
 #define qcpuid_cmd_help         \
@@ -1153,14 +1247,18 @@
 #define qeth_cmd_help           \
                                 \
   "Format:  \"QETH  DEBUG {ON|OFF}  [ [<devnum>|ALL] [mask ...] ]\"\n"          \
-  "         \"QETH  ADDR              [<devnum>|ALL]\"\n\n"                     \
+  "         \"QETH  ADDR              [<devnum>|ALL]\"\n"                       \
+  "         \"QETH  STATS             [<devnum>|ALL]\"\n\n"                     \
   "Enables/disables debug tracing for the QETH (OSA) device groups iden-\n"     \
   "tified by <devnum>, or for all QETH (OSA) device groups if <devnum> is\n"    \
   "not specified or specified as 'ALL', or displays all MAC addresses\n"        \
   "registered with the device identified by <devnum> or for all QETH (OSA)\n"   \
-  "device groups if <devnum> is not specified or specified as 'ALL'.  The\n"    \
-  "optional 'mask' value may be specified more than once. Mask values are\n"    \
-  "'Ccw', 'DAta', 'DRopped', 'Expand', 'Interupts', 'Packet', 'Queues',\n"      \
+  "device groups if <devnum> is not specified or specified as 'ALL', or\n"      \
+  "displays their packet and adapter interrupt rates, totals, current\n"        \
+  "interrupt coalescing (device options 'icpkts', 'icusecs', 'icadaptive')\n"   \
+  "and the average and maximum SIGA-w to transmit latency.\n"                   \
+  "The optional 'mask' value may be specified more than once. Mask values\n"    \
+  "are 'Ccw', 'DAta', 'DRopped', 'Expand', 'Interupts', 'Packet', 'Queues',\n"  \
   "'SBale', 'SIga', 'Updown' or 0xhhhhhhhh hexadecimal value.\n"
 
 #define qpfkeys_cmd_desc        "Display the current PF Key settings"
@@ -1648,6 +1746,27 @@
   "tracing.  Enter the 't+-' command by itself (without any arguments) to\n"    \
   "display the current settings.\n"
 
+#define tfile_cmd_desc          "Binary instruction trace to file"
+#define tfile_cmd_help          \
+                                \
+  "Format:  \"tfile  [ filename [STOR] [BUFSIZE=nnn] | OFF ]\"\n"               \
+  "\n"                                                                          \
+  "While a trace file is open, instructions selected for tracing by the\n"      \
+  "'t+' command are written to it as compact binary records instead of\n"       \
+  "being displayed, which is far faster and does not flood the log. Each\n"     \
+  "record holds the PSW, the instruction and whichever general registers\n"     \
+  "have changed, and with STOR also up to 16 bytes of each storage\n"           \
+  "operand. The file is gzip compressed and is decoded and filtered\n"          \
+  "offline with the 'itrcprt' utility.\n"                                       \
+  "\n"                                                                          \
+  "Each CPU fills its own two buffers of BUFSIZE kilobytes (default 256)\n"     \
+  "which are written to the file by a separate thread. Should a CPU fill\n"     \
+  "both before the thread has written them, the records that would not\n"       \
+  "fit are counted as lost rather than the CPU being slowed down.\n"            \
+  "\n"                                                                          \
+  "Enter 'tfile OFF' to close the file, or 'tfile' by itself to display\n"      \
+  "the trace status. Stepping ('s+') still displays each instruction.\n"
+
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
 
 #define txf_cmd_desc            "Transactional-Execution Facility tracing"
@@ -1834,6 +1953,7 @@ COMMAND( "define",                  define_cmd,             SYSCMD,
 COMMAND( "detach",                  detach_cmd,             SYSCMD,             detach_cmd_desc,        detach_cmd_help     )
 COMMAND( "devinit",                 devinit_cmd,            SYSCMD,             devinit_cmd_desc,       devinit_cmd_help    )
 COMMAND( "devlist",                 devlist_cmd,            SYSCMD,             devlist_cmd_desc,       devlist_cmd_help    )
+COMMAND( "iolat",                   iolat_cmd,              SYSCMD,             iolat_cmd_desc,         iolat_cmd_help      )
 COMMAND( "fcb",                     fcb_cmd,                SYSCMD,             fcb_cmd_desc,           fcb_cmd_help        )
 COMMAND( "cctape",                  cctape_cmd,             SYSCMD,             cctape_cmd_desc,        cctape_cmd_help     )
 COMMAND( "loadparm",                loadparm_cmd,           SYSCMD,             loadparm_cmd_desc,      loadparm_cmd_help   )
@@ -1890,6 +2010,7 @@ COMMAND( "numcpu",                  numcpu_cmd,             SYSCMDNOPER,
 COMMAND( "osa",                     qeth_cmd,               SYSCMDNOPER,        osa_cmd_desc,           qeth_cmd_help       )
 COMMAND( "ostailor",                ostailor_cmd,           SYSCMDNOPER,        ostailor_cmd_desc,      ostailor_cmd_help   )
 COMMAND( "pgmtrace",                pgmtrace_cmd,           SYSCMDNOPER,        pgmtrace_cmd_desc,      pgmtrace_cmd_help   )
+COMMAND( "profile",                 profile_cmd,            SYSCMDNOPER,        profile_cmd_desc,       profile_cmd_help    )
 COMMAND( "pr",                      pr_cmd,                 SYSCMDNOPER,        pr_cmd_desc,            pr_cmd_help         )
 COMMAND( "psw",                     psw_cmd,                SYSCMDNOPER,        psw_cmd_desc,           psw_cmd_help        )
 COMMAND( "ptp",                     ptp_cmd,                SYSCMDNOPER,        ptp_cmd_desc,           ptp_cmd_help        )
@@ -1919,6 +2040,7 @@ COMMAND( "t+",                      trace_cmd,              SYSCMDNOPER,
 COMMAND( "txf",                     txf_cmd,                SYSCMDNOPER,        txf_cmd_desc,           txf_cmd_help        )
 #endif
 COMMAND( "t+-",                     auto_trace_cmd,         SYSCMDNOPER,        auto_trace_desc,        auto_trace_help     )
+COMMAND( "tfile",                   tfile_cmd,              SYSCMDNOPER,        tfile_cmd_desc,         tfile_cmd_help      )
 COMMAND( "timerint",                timerint_cmd,           SYSCMDNOPER,        timerint_cmd_desc,      timerint_cmd_help   )
 COMMAND( "tlb",                     tlb_cmd,                SYSCMDNOPER,        tlb_cmd_desc,           NULL                )
 COMMAND( "toddrag",                 toddrag_cmd,            SYSCMDNOPER,        toddrag_cmd_desc,       NULL                )
@@ -1937,6 +2059,7 @@ COMMAND( "store",                   store_cmd,              SYSCMDNDIAG8,
 COMMAND( "sysclear",                sysclear_cmd,           SYSCMDNDIAG8,       sysclear_cmd_desc,      sysclear_cmd_help   )
 COMMAND( "sysreset",                sysreset_cmd,           SYSCMDNDIAG8,       sysreset_cmd_desc,      sysreset_cmd_help   )
 COMMAND( "cnslport",                cnslport_cmd,           SYSCFGNDIAG8,       cnslport_cmd_desc,      NULL                )
+COMMAND( "cnslthreads",             cnslthreads_cmd,        SYSCFGNDIAG8,       cnslthreads_cmd_desc,   cnslthreads_cmd_help )
 COMMAND( "cpuidfmt",                cpuidfmt_cmd,           SYSCFGNDIAG8,       cpuidfmt_cmd_desc,      NULL                )
 COMMAND( "cpumodel",                cpumodel_cmd,           SYSCFGNDIAG8,       cpumodel_cmd_desc,      NULL                )
 COMMAND( "cpuserial",               cpuserial_cmd,          SYSCFGNDIAG8,       cpuserial_cmd_desc,     NULL                )
@@ -2060,6 +2183,9 @@ COMMAND( "rmmod",                   rmmod_cmd,              SYSCMDNOPER,
 COMMAND( "hao",                     hao_cmd,                SYSPROGDEVEL,       hao_cmd_desc,           hao_cmd_help        )
 #endif
 COMMAND( "http",                    http_cmd,               SYSCONFIG,          http_cmd_desc,          http_cmd_help       )
+#if defined( OPTION_EMULATION_STATS )
+COMMAND( "emustat",                 emustat_cmd,            SYSCMDNOPER,        emustat_cmd_desc,       emustat_cmd_help    )
+#endif
 #if defined( OPTION_INSTRUCTION_COUNTING )
 COMMAND( "icount",                  icount_cmd,             SYSCMDNOPER,        icount_cmd_desc,        icount_cmd_help     )
 #endif
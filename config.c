@@ -685,6 +685,7 @@ char      buf[32];
     dev->member = 0;
 
     memset(dev->filename, 0, sizeof(dev->filename));
+    memset(&dev->iolat, 0, sizeof(dev->iolat));
 
     dev->cpuprio = sysblk.cpuprio;
     dev->devprio = sysblk.devprio;
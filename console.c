@@ -182,6 +182,243 @@ static void  loc3270_input( TELNET* tn, const BYTE* buffer, U32 size );
 static void  constty_input( TELNET* tn, const BYTE* buffer, U32 size );
 static void  negotiate_ttype( TELNET* tn );
 
+/*-------------------------------------------------------------------*/
+/*                  Console event loop definitions                   */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/*  Where epoll is available clients are served by one or more       */
+/*  event loops instead of a pselect() loop that has to rebuild its  */
+/*  read set from the entire DEVBLK chain every time it wakes up.    */
+/*  Each connected console's socket is registered with exactly one   */
+/*  loop once negotiations are complete. Loop 0 runs in the console  */
+/*  connection thread and also owns the listening socket and the     */
+/*  console thread's wakeup pipe; additional loops (see CNSLTHREADS) */
+/*  each run in a console I/O thread of their own.                   */
+/*                                                                   */
+/*  A console whose device cannot take input at the moment (busy or  */
+/*  with an interrupt pending) is "parked": its socket is removed    */
+/*  from the epoll set until the next wakeup finds the device ready  */
+/*  again. Output is sent without blocking; whatever the socket will */
+/*  not take is queued in the TELNET block and written by the loop   */
+/*  when the socket becomes writable.                                */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_SYS_EPOLL_H ) && defined( HAVE_SYS_EVENTFD_H )
+  #define CNSL_EPOLL            /* Use epoll event loops             */
+#endif
+
+#if defined( CNSL_EPOLL )
+
+#define CNSL_MAXEVENTS  64              /* Events per epoll_wait     */
+#define CNSL_MAXWBUF    (1024*1024)     /* Queued output before wait */
+
+typedef struct CNSLPARK                 /* Parked console entry      */
+{
+    DEVBLK   *dev;                      /* Device whose input waits  */
+    TELNET   *tn;                       /* Connection it was for     */
+}
+CNSLPARK;
+
+typedef struct CNSLLOOP                 /* Console event loop        */
+{
+    TID       tid;                      /* I/O thread (not loop 0)   */
+    int       epfd;                     /* epoll instance            */
+    int       evfd;                     /* eventfd to wake the loop  */
+    int       lsock;                    /* Listening socket in set   */
+    int       conns;                    /* Connections being served  */
+    int       nparked;                  /* Entries in parked list    */
+    int       maxparked;                /* Size of parked list       */
+    CNSLPARK *parked;                   /* Consoles with input held  */
+}
+CNSLLOOP;
+
+static CNSLLOOP  cnslloop[ MAX_CNSLTHREADS ];
+static int       cnslloops   = 0;       /* Event loops running       */
+static volatile int cnslstop = 0;       /* Stop console I/O threads  */
+static LOCK      cnslloop_lock;         /* Serializes the above      */
+
+static void cnsl_register( DEVBLK* dev, TELNET* tn );
+
+/*-------------------------------------------------------------------*/
+/*  Register, modify or remove a console's socket in its loop's      */
+/*  epoll set to match what it is currently waiting for: input       */
+/*  unless it is parked, and writability while output is queued.     */
+/*  The TELNET lock must be held.                                    */
+/*-------------------------------------------------------------------*/
+static void cnsl_rearm( TELNET* tn )
+{
+    struct epoll_event  ev;
+    U32                 want;
+
+    if (tn->epfd < 0)
+        return;
+
+    want = tn->rparked ? 0 : EPOLLIN;
+    if (tn->wlen)
+        want |= EPOLLOUT;
+
+    if (want == tn->epmask)
+        return;
+
+    memset( &ev, 0, sizeof( ev ));
+    ev.events   = want;
+    ev.data.ptr = tn->dev;
+
+    if (!want)
+        epoll_ctl( tn->epfd, EPOLL_CTL_DEL, tn->csock, &ev );
+    else if (!tn->epmask)
+        epoll_ctl( tn->epfd, EPOLL_CTL_ADD, tn->csock, &ev );
+    else
+        epoll_ctl( tn->epfd, EPOLL_CTL_MOD, tn->csock, &ev );
+
+    tn->epmask = want;
+}
+
+/*-------------------------------------------------------------------*/
+/*  Write as much queued output as the socket will take without      */
+/*  blocking. The TELNET lock must be held. Returns -1 if the socket */
+/*  failed, in which case the queued output is discarded.            */
+/*-------------------------------------------------------------------*/
+static int cnsl_flush( TELNET* tn )
+{
+    ssize_t  n;
+
+    while (tn->wlen)
+    {
+        n = send( tn->csock, tn->wbuf, tn->wlen, MSG_DONTWAIT );
+
+        if (n < 0)
+        {
+            if (HSO_EINTR == HSO_errno)
+                continue;
+            if (HSO_EAGAIN == HSO_errno || HSO_EWOULDBLOCK == HSO_errno)
+                break;
+            tn->wlen = 0;
+            return -1;
+        }
+
+        tn->wlen -= n;
+        if (tn->wlen)
+            memmove( tn->wbuf, tn->wbuf + n, tn->wlen );
+    }
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*  Send data to a client that is being served by an event loop.     */
+/*  The data is sent right away if nothing is queued ahead of it and */
+/*  the socket will take it; the remainder is queued and the loop is */
+/*  asked to wait for the socket to become writable. If the client   */
+/*  has fallen so far behind that too much output is queued already  */
+/*  we wait for it to catch up, just as a blocking send would have.  */
+/*  Returns the length sent or queued, or -1 with errno set if the   */
+/*  socket failed.                                                   */
+/*-------------------------------------------------------------------*/
+static int cnsl_send( TELNET* tn, const char* buf, size_t len )
+{
+    struct pollfd  pfd;
+    ssize_t        n = 0;
+    size_t         need;
+    BYTE          *wbuf;
+
+    obtain_lock( &tn->lock );
+
+    while (tn->wlen && tn->wlen + len > CNSL_MAXWBUF)
+    {
+        pfd.fd     = tn->csock;
+        pfd.events = POLLOUT;
+
+        release_lock( &tn->lock );
+        poll( &pfd, 1, 1000 );
+        obtain_lock( &tn->lock );
+
+        if (cnsl_flush( tn ) < 0)
+        {
+            release_lock( &tn->lock );
+            return -1;
+        }
+    }
+
+    if (!tn->wlen)
+    {
+        do
+            n = send( tn->csock, buf, len, MSG_DONTWAIT );
+        while (n < 0 && HSO_EINTR == HSO_errno);
+
+        if (n < 0)
+        {
+            if (HSO_EAGAIN != HSO_errno && HSO_EWOULDBLOCK != HSO_errno)
+            {
+                release_lock( &tn->lock );
+                return -1;
+            }
+            n = 0;
+        }
+    }
+
+    if ((size_t) n < len)
+    {
+        need = tn->wlen + (len - n);
+
+        if (need > tn->wsize)
+        {
+            size_t size = tn->wsize ? tn->wsize : 4096;
+
+            while (size < need)
+                size *= 2;
+
+            if (!(wbuf = realloc( tn->wbuf, size )))
+            {
+                release_lock( &tn->lock );
+                errno = ENOMEM;
+                return -1;
+            }
+            tn->wbuf  = wbuf;
+            tn->wsize = size;
+        }
+
+        memcpy( tn->wbuf + tn->wlen, buf + n, len - n );
+        tn->wlen = need;
+
+        cnsl_rearm( tn );
+    }
+
+    release_lock( &tn->lock );
+    return (int) len;
+}
+
+#endif /* defined( CNSL_EPOLL ) */
+
+/*-------------------------------------------------------------------*/
+/*  Gracefully close a client socket. libtelnet's telnet_closesocket */
+/*  waits for the client to close its end using select(), which does */
+/*  not work with the socket numbers above FD_SETSIZE that an event  */
+/*  loop can serve, so those sockets are shut down here with poll(). */
+/*-------------------------------------------------------------------*/
+static int cnsl_closesocket( int sock )
+{
+#if defined( CNSL_EPOLL )
+    if (sock >= FD_SETSIZE)
+    {
+        struct pollfd  pfd;
+        char           buf[128];
+        int            i;
+
+        if (shutdown( sock, SHUT_WR ) == 0)
+        {
+            pfd.fd     = sock;
+            pfd.events = POLLIN;
+
+            for (i=0; i < 10 && poll( &pfd, 1, 100 ) > 0; i++)
+                if (recv( sock, buf, sizeof( buf ), 0 ) <= 0)
+                    break;
+        }
+        return close_socket( sock );
+    }
+#endif
+    return telnet_closesocket( sock );
+}
+
 /*-------------------------------------------------------------------*/
 /*                Telnet options negotiation table                   */
 /*-------------------------------------------------------------------*/
@@ -309,6 +546,18 @@ static void telnet_ev_handler( telnet_t* telnet, telnet_event_t* ev,
         CONDEBUG2( HHC90500, "D", tn->clientid, ev->data.size );
         DUMPBUF(   HHC90500, ev->data.buffer, ev->data.size, tn->do_tn3270 ? 1 : 0 );
 
+#if defined( CNSL_EPOLL )
+        if (tn->epfd >= 0)
+        {
+            if (cnsl_send( tn, ev->data.buffer, ev->data.size ) < 0)
+            {
+                tn->send_err = TRUE;
+                // "%s COMM: send() failed: %s"
+                WRMSG( HHC02900, "E", tn->clientid, strerror( errno ));
+            }
+        }
+        else
+#endif
         if (write_socket( tn->csock, ev->data.buffer, ev->data.size ) <= 0)
         {
             tn->send_err = TRUE;
@@ -743,8 +992,23 @@ static void  disconnect_telnet_client( TELNET* tn )
     */
     if (tn)
     {
-        telnet_closesocket( tn->csock );
+#if defined( CNSL_EPOLL )
+        /* Leave the event loop, giving queued output a last chance */
+        if (tn->epfd >= 0)
+        {
+            obtain_lock( &tn->lock );
+            cnsl_flush( tn );
+            release_lock( &tn->lock );
+
+            obtain_lock( &cnslloop_lock );
+            cnslloop[ tn->loop ].conns--;
+            release_lock( &cnslloop_lock );
+        }
+        free( tn->wbuf );
+#endif
+        cnsl_closesocket( tn->csock );
         telnet_free( tn->ctl );
+        destroy_lock( &tn->lock );
 
         /* Free one shot send buffer if necessary */
         if (tn->sendbuf_size) free( tn->sendbuf );
@@ -2608,6 +2872,9 @@ BYTE    buf[ BUFLEN_3270 ];             /* Temporary recv() buffer   */
     /* Check for I/O error */
     if (rc < 0)
     {
+        if (HSO_EAGAIN == HSO_errno)
+            // non blocking call and no data
+            return 0;
         if (HSO_ECONNRESET == HSO_errno)
             // "%1d:%04X COMM: client %s devtype %4.4X: connection reset"
             WRMSG( HHC01090, "I", LCSS_DEVNUM,
@@ -2615,14 +2882,8 @@ BYTE    buf[ BUFLEN_3270 ];             /* Temporary recv() buffer   */
         else
             // "%s COMM: recv() failed: %s"
             CONERROR( HHC90507, "D", dev->tn->clientid, strerror( HSO_errno ));
-        if (HSO_EAGAIN == HSO_errno)
-            // non blocking call and no data
-            return 0;
-        else
-        {
-            dev->sense[0] = SENSE_EC;
-            return (CSW_ATTN | CSW_UC);
-        }
+        dev->sense[0] = SENSE_EC;
+        return (CSW_ATTN | CSW_UC);
     }
 
     /* If zero bytes were received then client has closed connection */
@@ -3241,6 +3502,11 @@ size_t                  logoheight;     /* Logo file number of lines */
     if (clientip)
         free( clientip );
 
+#if defined( CNSL_EPOLL )
+    /* Start receiving the client's input in an event loop */
+    cnsl_register( dev, tn );
+#endif
+
     /* Raise attention interrupt for the device */
     raise_device_attention( dev, CSW_DE );
 
@@ -3354,7 +3620,7 @@ struct sockaddr_in    *server;          /* Server address structure  */
     }
 
     /* Put the socket into listening state */
-    if ((rc = listen ( lsock, 10 )) < 0)
+    if ((rc = listen ( lsock, SOMAXCONN )) < 0)
     {
         // "COMM: error in function %s: %s"
         WRMSG( HHC01034, "E", "listen()", strerror( HSO_errno ));
@@ -3369,6 +3635,605 @@ struct sockaddr_in    *server;          /* Server address structure  */
     return lsock;
 }
 
+/*-------------------------------------------------------------------*/
+/*      Accept a client connection on the listening socket           */
+/*-------------------------------------------------------------------*/
+static void accept_client( int lsock )
+{
+int                    rc;              /* Return code               */
+int                    csock;           /* Socket for conversation   */
+TID                    tidneg;          /* Negotiation thread id     */
+TELNET                *tn;              /* Telnet Control Block      */
+
+    /* Accept a connection and create conversation socket */
+    csock = accept( lsock, NULL, NULL );
+
+    if (csock < 0)
+    {
+        // (use same technique as pselect error in our caller)
+
+        int accept_errno = HSO_errno; // (preserve orig errno)
+        static int issue_errmsg = 1;  // (prevents msgs flood)
+
+        if (HSO_EMFILE == accept_errno)
+        {
+            // Don't issue message more frequently
+            // than once every second or so, just in
+            // case the condition that's causing it
+            // keeps reoccurring over and over...
+
+            static struct timeval  prev = {0,0};
+                   struct timeval  curr;
+                   struct timeval  diff;
+
+            gettimeofday( &curr, NULL );
+            timeval_subtract( &prev, &curr, &diff );
+
+            // Has it been longer than one second
+            // since we last issued this message?
+
+            if (diff.tv_sec >= 1)
+            {
+                issue_errmsg = 1;
+                prev.tv_sec  = curr.tv_sec;
+                prev.tv_usec = curr.tv_usec;
+            }
+            else
+                issue_errmsg = 0;   // (prevents msgs flood)
+        }
+        else
+            issue_errmsg = 1;
+
+        if (issue_errmsg && EINTR != accept_errno)
+        {
+            // "COMM: accept() failed: %s"
+            CONERROR( HHC90509, "D", strerror( accept_errno ));
+            usleep( 50000 ); // (wait a bit; maybe it'll fix itself??)
+        }
+        return;
+    }
+
+    /* Allocate Telnet Control Block for this client */
+    if (!(tn = (TELNET*) calloc( 1, sizeof( TELNET ))))
+    {
+        // "Out of memory"
+        WRMSG( HHC00152, "E" );
+        cnsl_closesocket( csock );
+    }
+    else
+    {
+        static U32 clid = 0;
+        tn->csock = csock;
+        tn->epfd  = -1;
+        MSGBUF( tn->clientid, "client %u", clid++ );
+
+        /* Initialize libtelnet package */
+        tn->ctl = telnet_init( telnet_opts,
+            telnet_ev_handler, TELNET_FLAG_ACTIVE_NEG, tn );
+
+        if (!tn->ctl)
+        {
+            // "Out of memory"
+            WRMSG( HHC00152, "E" );
+            free( tn );
+            cnsl_closesocket( csock );
+        }
+        else
+        {
+            initialize_lock( &tn->lock );
+
+            /* Create a thread to complete the client connection */
+            rc = create_thread( &tidneg, DETACHED,
+                        connect_client, tn, CONN_CLI_THREAD_NAME );
+            if (rc)
+            {
+                // "Error in function create_thread(): %s"
+                WRMSG( HHC00102, "E", strerror( rc ));
+
+                destroy_lock( &tn->lock );
+                telnet_free( tn->ctl );
+                free( tn );
+                cnsl_closesocket( csock );
+            }
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*      Receive input from a connected console's client              */
+/*-------------------------------------------------------------------*/
+/* Called with the device lock held, which is released on return.    */
+/* Raises an attention interrupt for the device if any input was     */
+/* received or disconnects it if the connection failed.              */
+/*                                                                   */
+/* An event loop thread (evloop) serves many consoles and must never */
+/* block: it reads only what has arrived, and when that leaves a     */
+/* 3270 record incomplete, keeps it in the buffer and returns, to be */
+/* called again once its event loop reports more input.              */
+/*-------------------------------------------------------------------*/
+static void console_input( DEVBLK* dev, int evloop )
+{
+BYTE                   unitstat;        /* Status after receive data */
+int                    prev_rlen3270;
+
+    consio();
+
+    /* Receive console input data from the client */
+
+    /* Make the first call to recv below non-blocking
+       in case pselect lied to us and there isn't any
+       data available.  If we do multiple recv's then
+       the subsequent ones are blocking (but not from
+       an event loop). See the linux man page for
+       select(2) for more info.
+    */
+    socket_set_blocking_mode( dev->fd, 0 );
+    if ((dev->devtype == 0x3270) ||
+        (dev->devtype == 0x3287))
+    {
+        do
+            {
+                prev_rlen3270 = dev->rlen3270;
+                unitstat = recv_3270_data( dev );
+
+                // "%s COMM: recv_3270_data: %d bytes received"
+                CONDEBUG2( HHC90502, "D", dev->tn->clientid,
+                    dev->rlen3270 - prev_rlen3270 );
+                /* If we do another recv, make it blocking.
+                   Otherwise we might just spin. */
+                if (!evloop)
+                    socket_set_blocking_mode( dev->fd, 1 );
+            }
+            while ((unitstat == 0) && dev->rlen3270
+                && (!evloop || (int) dev->rlen3270 != prev_rlen3270));
+
+        /* Keep a partial record until the rest of it arrives */
+        if (evloop && unitstat == 0 && dev->rlen3270)
+        {
+            socket_set_blocking_mode( dev->fd, 1 );
+            release_lock( &dev->lock );
+            return;
+        }
+
+        socket_set_blocking_mode( dev->fd, 1 );
+        dev->readpending = 3;
+    }
+    else
+    {
+        unitstat = recv_1052_data( dev );
+        socket_set_blocking_mode( dev->fd, 1 );
+    }
+
+    /* Close the connection if an error occurred */
+    if (unitstat & CSW_UC)
+    {
+        disconnect_console_device( dev );
+        release_lock( &dev->lock );
+        return;
+    }
+
+    /* Release the device lock */
+    release_lock( &dev->lock );
+
+    if ((dev->devtype != 0x3270) &&
+        (dev->devtype != 0x3287))
+        raise_device_attention( dev, unitstat );
+    else
+    /* Raise attention interrupt for device, but only
+       if we actually received any 3270 data.  Telnet
+       keepalive messages for example, arrive as pure
+       telnet control messages which, once processed,
+       result in no actual 3270 client data remaining.
+    */
+    if (dev->rlen3270)
+        raise_device_attention( dev, unitstat );
+}
+
+#if defined( CNSL_EPOLL )
+
+/* Console device cannot take input now (busy or interrupt pending)  */
+#define CNSL_INPUT_HELD( dev )                                      \
+    (0                                                              \
+     || ((dev)->busy && !((dev)->scsw.flag3 & SCSW3_AC_SUSP))       \
+     || ((dev)->scsw.flag3 & SCSW3_SC_PEND)                         \
+     || IOPENDING( dev )                                            \
+    )
+
+/*-------------------------------------------------------------------*/
+/*    Create the epoll instance and wakeup eventfd of an event loop  */
+/*-------------------------------------------------------------------*/
+static int cnsl_loop_open( CNSLLOOP* lp )
+{
+    struct epoll_event  ev;
+
+    memset( lp, 0, sizeof( CNSLLOOP ));
+    lp->lsock = -1;
+
+    if ((lp->epfd = epoll_create1( EPOLL_CLOEXEC )) < 0)
+    {
+        // "COMM: error in function %s: %s"
+        WRMSG( HHC01034, "E", "epoll_create1()", strerror( errno ));
+        return -1;
+    }
+
+    if ((lp->evfd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC )) < 0)
+    {
+        // "COMM: error in function %s: %s"
+        WRMSG( HHC01034, "E", "eventfd()", strerror( errno ));
+        close( lp->epfd );
+        return -1;
+    }
+
+    memset( &ev, 0, sizeof( ev ));
+    ev.events   = EPOLLIN;
+    ev.data.ptr = &lp->evfd;
+    VERIFY( epoll_ctl( lp->epfd, EPOLL_CTL_ADD, lp->evfd, &ev ) == 0 );
+
+    return 0;
+}
+
+static void cnsl_loop_close( CNSLLOOP* lp )
+{
+    close( lp->evfd );
+    close( lp->epfd );
+    free( lp->parked );
+    lp->parked = NULL;
+    lp->nparked = lp->maxparked = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*    Hold back a console's input until its device can take it       */
+/*-------------------------------------------------------------------*/
+static void cnsl_park( CNSLLOOP* lp, DEVBLK* dev, TELNET* tn )
+{
+    CNSLPARK*  parked;
+
+    obtain_lock( &tn->lock );
+
+    if (!tn->rparked)
+    {
+        if (lp->nparked >= lp->maxparked)
+        {
+            int max = lp->maxparked ? lp->maxparked * 2 : 16;
+
+            if (!(parked = realloc( lp->parked, max * sizeof( CNSLPARK ))))
+            {
+                /* Leave it armed; we will just see it again */
+                release_lock( &tn->lock );
+                return;
+            }
+            lp->parked    = parked;
+            lp->maxparked = max;
+        }
+
+        lp->parked[ lp->nparked ].dev = dev;
+        lp->parked[ lp->nparked ].tn  = tn;
+        lp->nparked++;
+
+        tn->rparked = 1;
+        cnsl_rearm( tn );
+    }
+
+    release_lock( &tn->lock );
+}
+
+/*-------------------------------------------------------------------*/
+/*    Resume waiting for input from parked consoles whose device     */
+/*    can now take it, and forget those that have disconnected.      */
+/*-------------------------------------------------------------------*/
+static void cnsl_unpark( CNSLLOOP* lp )
+{
+    CNSLPARK*  p;
+    DEVBLK*    dev;
+    int        i, held;
+
+    for (i=0; i < lp->nparked; )
+    {
+        p    = &lp->parked[i];
+        dev  = p->dev;
+        held = 0;
+
+        obtain_lock( &dev->lock );
+
+        if (1
+            && dev->connected
+            && dev->tn == p->tn
+            && p->tn->epfd == lp->epfd
+            && p->tn->rparked
+        )
+        {
+            if (CNSL_INPUT_HELD( dev ))
+                held = 1;
+            else
+            {
+                obtain_lock( &p->tn->lock );
+                p->tn->rparked = 0;
+                cnsl_rearm( p->tn );
+                release_lock( &p->tn->lock );
+            }
+        }
+
+        release_lock( &dev->lock );
+
+        if (held)
+            i++;
+        else
+            lp->parked[i] = lp->parked[ --lp->nparked ];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*    Handle an epoll event for a connected console's socket         */
+/*-------------------------------------------------------------------*/
+static void cnsl_loop_event( CNSLLOOP* lp, DEVBLK* dev, U32 events )
+{
+    TELNET*  tn;
+
+    obtain_lock( &dev->lock );
+
+    /* Ignore events for a connection that has since gone away */
+    tn = dev->tn;
+    if (0
+        || !dev->allocated
+        || !dev->console
+        || !dev->connected
+        || !tn
+        || tn->epfd != lp->epfd
+    )
+    {
+        release_lock( &dev->lock );
+        return;
+    }
+
+    /* Write queued output now that the socket can take more. If the
+       socket failed the queued output is discarded; the failure will
+       be noticed when the input side is read.
+    */
+    if (events & EPOLLOUT)
+    {
+        obtain_lock( &tn->lock );
+        cnsl_flush( tn );
+        cnsl_rearm( tn );
+        release_lock( &tn->lock );
+    }
+
+    if (!(events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+    {
+        release_lock( &dev->lock );
+        return;
+    }
+
+    if (CNSL_INPUT_HELD( dev ))
+    {
+        cnsl_park( lp, dev, tn );
+        release_lock( &dev->lock );
+        return;
+    }
+
+    console_input( dev, 1 );    /* (releases the device lock) */
+}
+
+/*-------------------------------------------------------------------*/
+/*    Wait for and handle the next batch of events of an event loop  */
+/*-------------------------------------------------------------------*/
+/* Returns 1 if the listening socket (loop 0 only) has a connection  */
+/* waiting to be accepted, 0 otherwise.                              */
+/*-------------------------------------------------------------------*/
+static int cnsl_loop_wait( CNSLLOOP* lp, int lsock )
+{
+    struct epoll_event  ev[ CNSL_MAXEVENTS ];
+    eventfd_t           evcnt;
+    int                 i, n, msecs;
+    int                 lready = 0;
+
+    /* Register a new listening socket */
+    if (lsock != lp->lsock)
+    {
+        memset( &ev[0], 0, sizeof( ev[0] ));
+        ev[0].events   = EPOLLIN;
+        ev[0].data.ptr = &lp->lsock;
+        if (lsock >= 0)
+            epoll_ctl( lp->epfd, EPOLL_CTL_ADD, lsock, &ev[0] );
+        lp->lsock = lsock;
+    }
+
+    msecs = (int) ((timeout->tv_sec * 1000) + (timeout->tv_nsec / 1000000));
+    n = epoll_wait( lp->epfd, ev, CNSL_MAXEVENTS, msecs );
+
+    if (n < 0)
+    {
+        if (HSO_EINTR != HSO_errno)
+        {
+            // "COMM: error in function %s: %s"
+            WRMSG( HHC01034, "E", "epoll_wait()", strerror( HSO_errno ));
+            usleep( 50000 ); // (wait a bit; maybe it'll fix itself??)
+        }
+        return 0;
+    }
+
+    if (n == 0 && lp == &cnslloop[0])
+        consto();
+
+    for (i=0; i < n; i++)
+    {
+        if (ev[i].data.ptr == &lp->lsock)
+            lready = 1;
+        else if (ev[i].data.ptr == &lp->evfd)
+            eventfd_read( lp->evfd, &evcnt );
+        else if (ev[i].data.ptr == &sysblk.cnslrpipe)
+        {
+            int  j;
+
+            /* Clear the pipe signal and pass it on to the other loops
+               so they check whether their parked consoles can resume */
+            RECV_CONSOLE_THREAD_PIPE_SIGNAL();
+
+            obtain_lock( &cnslloop_lock );
+            for (j=1; j < cnslloops; j++)
+                VERIFY( eventfd_write( cnslloop[j].evfd, 1 ) == 0 );
+            release_lock( &cnslloop_lock );
+        }
+        else
+            cnsl_loop_event( lp, (DEVBLK*) ev[i].data.ptr, ev[i].events );
+    }
+
+    if (lp->nparked)
+        cnsl_unpark( lp );
+
+    return lready;
+}
+
+/*-------------------------------------------------------------------*/
+/*          CONSOLE I/O THREAD (event loops other than 0)            */
+/*-------------------------------------------------------------------*/
+static void* console_io_thread( void* arg )
+{
+    CNSLLOOP*  lp = (CNSLLOOP*) arg;
+
+    /* Set server thread priority; ignore any errors */
+    set_thread_priority( sysblk.srvprio );
+
+    // "Thread id "TIDPAT", prio %2d, name %s started"
+    LOG_THREAD_BEGIN( CON_IO_THREAD_NAME );
+
+    while (!cnslstop)
+        cnsl_loop_wait( lp, -1 );
+
+    // "Thread id "TIDPAT", prio %2d, name %s ended"
+    LOG_THREAD_END( CON_IO_THREAD_NAME );
+
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/*    Start event loop 0 in the console connection thread. If epoll  */
+/*    cannot be used no loop is started and the pselect loop is used */
+/*-------------------------------------------------------------------*/
+static void cnsl_loop_start()
+{
+    static int          inited = 0;
+    struct epoll_event  ev;
+
+    if (!inited)
+    {
+        initialize_lock( &cnslloop_lock );
+        inited = 1;
+    }
+
+    cnslstop = 0;
+
+    if (cnsl_loop_open( &cnslloop[0] ) != 0)
+        return;
+
+    memset( &ev, 0, sizeof( ev ));
+    ev.events   = EPOLLIN;
+    ev.data.ptr = &sysblk.cnslrpipe;
+    VERIFY( epoll_ctl( cnslloop[0].epfd, EPOLL_CTL_ADD,
+        sysblk.cnslrpipe, &ev ) == 0 );
+
+    obtain_lock( &cnslloop_lock );
+    cnslloops = 1;
+    release_lock( &cnslloop_lock );
+}
+
+/*-------------------------------------------------------------------*/
+/*    Start more console I/O threads if CNSLTHREADS was raised       */
+/*-------------------------------------------------------------------*/
+static void cnsl_loop_grow()
+{
+    CNSLLOOP*  lp;
+    int        rc, want;
+
+    want = MIN( MAX( sysblk.cnslthreads, 1 ), MAX_CNSLTHREADS );
+
+    while (cnslloops < want)
+    {
+        lp = &cnslloop[ cnslloops ];
+
+        if (cnsl_loop_open( lp ) != 0)
+        {
+            sysblk.cnslthreads = cnslloops;
+            break;
+        }
+
+        if ((rc = create_thread( &lp->tid, JOINABLE,
+                                 console_io_thread, lp,
+                                 CON_IO_THREAD_NAME )))
+        {
+            // "Error in function create_thread(): %s"
+            WRMSG( HHC00102, "E", strerror( rc ));
+            cnsl_loop_close( lp );
+            sysblk.cnslthreads = cnslloops;
+            break;
+        }
+
+        obtain_lock( &cnslloop_lock );
+        cnslloops++;
+        release_lock( &cnslloop_lock );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*    Stop the console I/O threads and close all event loops         */
+/*-------------------------------------------------------------------*/
+static void cnsl_loop_stop()
+{
+    int  i, n;
+
+    obtain_lock( &cnslloop_lock );
+    n = cnslloops;
+    cnslloops = 0;
+    cnslstop  = 1;
+    release_lock( &cnslloop_lock );
+
+    for (i=1; i < n; i++)
+    {
+        VERIFY( eventfd_write( cnslloop[i].evfd, 1 ) == 0 );
+        join_thread( cnslloop[i].tid, NULL );
+    }
+
+    for (i=0; i < n; i++)
+        cnsl_loop_close( &cnslloop[i] );
+}
+
+/*-------------------------------------------------------------------*/
+/*    Hand a newly connected console over to the event loop serving  */
+/*    the fewest connections. Does nothing if no event loop is       */
+/*    running, in which case the pselect loop serves the console.    */
+/*-------------------------------------------------------------------*/
+static void cnsl_register( DEVBLK* dev, TELNET* tn )
+{
+    int  i, best = -1;
+
+    obtain_lock( &dev->lock );
+
+    if (dev->connected && dev->tn == tn)
+    {
+        obtain_lock( &cnslloop_lock );
+
+        for (i=0; i < cnslloops; i++)
+            if (best < 0 || cnslloop[i].conns < cnslloop[ best ].conns)
+                best = i;
+
+        if (best >= 0)
+        {
+            cnslloop[ best ].conns++;
+
+            obtain_lock( &tn->lock );
+            tn->loop = best;
+            tn->epfd = cnslloop[ best ].epfd;
+            cnsl_rearm( tn );
+            release_lock( &tn->lock );
+        }
+
+        release_lock( &cnslloop_lock );
+    }
+
+    release_lock( &dev->lock );
+}
+
+#endif /* defined( CNSL_EPOLL ) */
+
 /*-------------------------------------------------------------------*/
 /*        CONSOLE CONNECTION AND ATTENTION HANDLER THREAD            */
 /*-------------------------------------------------------------------*/
@@ -3376,19 +4241,13 @@ static void* console_connection_handler( void* arg )
 {
 int                    rc = 0;          /* Return code               */
 int                    lsock;           /* Socket for listening      */
-int                    csock;           /* Socket for conversation   */
 fd_set                 readset;         /* Read bit map for pselect  */
 int                    maxfd;           /* Highest fd for pselect    */
 int                    scan_complete;   /* DEVBLK scan complete      */
 int                    scan_retries;    /* DEVBLK scan retries       */
-TID                    tidneg;          /* Negotiation thread id     */
 DEVBLK                *dev;             /* -> Device block           */
-BYTE                   unitstat;        /* Status after receive data */
-TELNET                *tn;              /* Telnet Control Block      */
 const char*            curr_cnslport;   /* Current sysblk.cnslport   */
 
-int prev_rlen3270;
-
     UNREFERENCED( arg );
 
     /* Set server thread priority; ignore any errors */
@@ -3409,6 +4268,11 @@ int prev_rlen3270;
     curr_cnslport = strdup( sysblk.cnslport );
     lsock = get_listening_socket();
 
+#if defined( CNSL_EPOLL )
+    /* Use event loops instead of pselect where possible */
+    cnsl_loop_start();
+#endif
+
     /* Handle connection requests and attention interrupts */
     while (console_cnslcnt > 0)
     {
@@ -3422,8 +4286,23 @@ int prev_rlen3270;
             free( curr_cnslport );
             curr_cnslport = strdup( sysblk.cnslport );
             lsock = get_listening_socket();
+#if defined( CNSL_EPOLL )
+            cnslloop[0].lsock = -1; /* (old socket left the set) */
+#endif
         }
 
+#if defined( CNSL_EPOLL )
+        /* Run event loop 0 if we have one */
+        if (cnslloops)
+        {
+            cnsl_loop_grow();
+
+            if (cnsl_loop_wait( &cnslloop[0], lsock ))
+                accept_client( lsock );
+            continue;
+        }
+#endif
+
         /* Initialize scan flags */
         scan_complete = TRUE;
         scan_retries = 0;
@@ -3596,96 +4475,7 @@ int prev_rlen3270;
 
         /* Accept incoming client connections */
         if (FD_ISSET( lsock, &readset ))
-        {
-            /* Accept a connection and create conversation socket */
-            csock = accept( lsock, NULL, NULL );
-
-            if (csock < 0)
-            {
-                // (use same technique as pselect error above)
-
-                int accept_errno = HSO_errno; // (preserve orig errno)
-                static int issue_errmsg = 1;  // (prevents msgs flood)
-
-                if (HSO_EMFILE == accept_errno)
-                {
-                    // Don't issue message more frequently
-                    // than once every second or so, just in
-                    // case the condition that's causing it
-                    // keeps reoccurring over and over...
-
-                    static struct timeval  prev = {0,0};
-                           struct timeval  curr;
-                           struct timeval  diff;
-
-                    gettimeofday( &curr, NULL );
-                    timeval_subtract( &prev, &curr, &diff );
-
-                    // Has it been longer than one second
-                    // since we last issued this message?
-
-                    if (diff.tv_sec >= 1)
-                    {
-                        issue_errmsg = 1;
-                        prev.tv_sec  = curr.tv_sec;
-                        prev.tv_usec = curr.tv_usec;
-                    }
-                    else
-                        issue_errmsg = 0;   // (prevents msgs flood)
-                }
-                else
-                    issue_errmsg = 1;
-
-                if (issue_errmsg && EINTR != accept_errno)
-                {
-                    // "COMM: accept() failed: %s"
-                    CONERROR( HHC90509, "D", strerror( accept_errno ));
-                    usleep( 50000 ); // (wait a bit; maybe it'll fix itself??)
-                }
-                continue;
-            }
-
-            /* Allocate Telnet Control Block for this client */
-            if (!(tn = (TELNET*) calloc( 1, sizeof( TELNET ))))
-            {
-                // "Out of memory"
-                WRMSG( HHC00152, "E" );
-                telnet_closesocket( csock );
-            }
-            else
-            {
-                static U32 clid = 0;
-                tn->csock = csock;
-                MSGBUF( tn->clientid, "client %u", clid++ );
-
-                /* Initialize libtelnet package */
-                tn->ctl = telnet_init( telnet_opts,
-                    telnet_ev_handler, TELNET_FLAG_ACTIVE_NEG, tn );
-
-                if (!tn->ctl)
-                {
-                    // "Out of memory"
-                    WRMSG( HHC00152, "E" );
-                    free( tn );
-                    telnet_closesocket( csock );
-                }
-                else
-                {
-                    /* Create a thread to complete the client connection */
-                    rc = create_thread( &tidneg, DETACHED,
-                                connect_client, tn, CONN_CLI_THREAD_NAME );
-                    if (rc)
-                    {
-                        // "Error in function create_thread(): %s"
-                        WRMSG( HHC00102, "E", strerror( rc ));
-
-                        telnet_free( tn->ctl );
-                        free( tn );
-                        telnet_closesocket( csock );
-                    }
-                }
-            }
-        } /* end accept incoming client connections */
+            accept_client( lsock );
 
         /* Initialize scan flags */
         scan_complete = TRUE;
@@ -3754,65 +4544,7 @@ int prev_rlen3270;
                     continue;
                 }
 
-                consio();
-
-                /* Receive console input data from the client */
-
-                /* Make the first call to recv below non-blocking
-                   in case pselect lied to us and there isn't any
-                   data available.  If we do multiple recv's then
-                   the subsequent ones are blocking. See the linux
-                   man page for select(2) for more info.
-                */
-                socket_set_blocking_mode( dev->fd, 0 );
-                if ((dev->devtype == 0x3270) ||
-                    (dev->devtype == 0x3287))
-                {
-                    do
-                        {
-                            prev_rlen3270 = dev->rlen3270;
-                            unitstat = recv_3270_data( dev );
-
-                            // "%s COMM: recv_3270_data: %d bytes received"
-                            CONDEBUG2( HHC90502, "D", dev->tn->clientid,
-                                dev->rlen3270 - prev_rlen3270 );
-                            /* If we do another recv, make it blocking.
-                               Otherwise we might just spin. */
-                            socket_set_blocking_mode( dev->fd, 1 );
-                        }
-                        while ((unitstat == 0) && dev->rlen3270);
-
-                    dev->readpending = 3;
-                }
-                else
-                {
-                    unitstat = recv_1052_data( dev );
-                    socket_set_blocking_mode( dev->fd, 1 );
-                }
-
-                /* Close the connection if an error occurred */
-                if (unitstat & CSW_UC)
-                {
-                    disconnect_console_device( dev );
-                    release_lock( &dev->lock );
-                    continue;
-                }
-
-                /* Release the device lock */
-                release_lock( &dev->lock );
-
-                if ((dev->devtype != 0x3270) &&
-                    (dev->devtype != 0x3287))
-                    raise_device_attention( dev, unitstat );
-                else
-                /* Raise attention interrupt for device, but only
-                   if we actually received any 3270 data.  Telnet
-                   keepalive messages for example, arrive as pure
-                   telnet control messages which, once processed,
-                   result in no actual 3270 client data remaining.
-                */
-                if (dev->rlen3270)
-                    raise_device_attention( dev, unitstat );
+                console_input( dev, 0 );    /* (releases the device lock) */
 
             } /* end scan DEVBLK chain */
 
@@ -3833,6 +4565,11 @@ int prev_rlen3270;
 
     free( curr_cnslport );
 
+#if defined( CNSL_EPOLL )
+    /* Stop the console I/O threads */
+    cnsl_loop_stop();
+#endif
+
     /* Initialize scan flags */
     scan_complete = TRUE;
     scan_retries = 0;
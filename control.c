@@ -44,6 +44,7 @@
 #include "opcode.h"
 #include "inline.h"
 #include "sie.h"
+#include "zvector.h"
 
 
 #if defined( FEATURE_SUBSPACE_GROUP )
@@ -5828,7 +5829,9 @@ static char *ordername[] = {
     /* 0x12 SIGP_SETARCH             */  "Set architecture mode",
     /* 0x13 SIGP_COND_EMERGENCY      */  "Conditional emergency",
     /* 0x14                          */  "Unassigned",
-    /* 0x15 SIGP_SENSE_RUNNING_STATE */  "Sense running state"
+    /* 0x15 SIGP_SENSE_RUNNING_STATE */  "Sense running state",
+    /* 0x16                          */  "Unassigned",
+    /* 0x17 SIGP_STORE_ADDITIONAL    */  "Store additional status at address"
 };
 
     RS( inst, regs, r1, r3, b2, effective_addr2 );
@@ -6475,6 +6478,53 @@ static char *ordername[] = {
 
 #endif /* defined( FEATURE_009_SENSE_RUN_STATUS_FACILITY ) */
 
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+        case SIGP_STORE_ADDITIONAL:
+        {
+            U64  addl;      /* Additional status area address
+                               and length characteristic      */
+
+            /* Invalid order if the vector facility is not enabled */
+            if (!FACILITY_ENABLED( 129_ZVECTOR, regs ))
+            {
+                status |= SIGP_STATUS_INVALID_ORDER;
+                break;
+            }
+
+            /* Test for checkstop state */
+            if (tregs->checkstop)
+            {
+                status |= SIGP_STATUS_CHECK_STOP;
+                break;
+            }
+
+            /* Exit with status bit 22 set if CPU is not stopped */
+            if (tregs->cpustate != CPUSTATE_STOPPED)
+            {
+                status |= SIGP_STATUS_INCORRECT_STATE;
+                break;
+            }
+
+            /* The full 64-bit parameter register holds the address
+               of the additional status area, which must be on a
+               1K boundary (length characteristic of zero) */
+            addl = (r1 & 1) ? regs->GR_G( r1 ) : regs->GR_G( r1+1 );
+
+            if ((addl & 0x3FF) || addl > regs->mainlim - 1023)
+            {
+                status |= SIGP_STATUS_INVALID_PARAMETER;
+                break;
+            }
+
+            abs = (RADR) addl;
+
+            /* Store the vector registers of the target CPU */
+            vr_store_all( tregs, tregs->mainstor + abs );
+            ARCH_DEP( or_storage_key )( abs, (STORKEY_REF | STORKEY_CHANGE) );
+        }
+        break;
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
         default:
             status = SIGP_STATUS_INVALID_ORDER;
         } /* end switch (order) */
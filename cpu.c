@@ -43,6 +43,7 @@
 #include "hercules.h"
 #include "opcode.h"
 #include "inline.h"
+#include "zvector.h"
 
 /*-------------------------------------------------------------------*/
 /*   ARCH_DEP section: compiled multiple times, once for each arch.  */
@@ -1224,7 +1225,13 @@ bool    intercept;                      /* False for virtual pgmint  */
         realregs->TEA = 0;
 
         /* Store Data exception code in PSA */
-        if (code == PGM_DATA_EXCEPTION)
+        if (0
+            || code == PGM_DATA_EXCEPTION
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+            /* (the Vector exception code is stored the same way) */
+            || code == PGM_VECTOR_PROCESSING_EXCEPTION
+#endif
+        )
         {
             STORE_FW( psa->DXC, regs->dxc );
 
@@ -1589,6 +1596,26 @@ RADR    fsta;                           /* Failing storage address   */
     memset(psa->storepsw, 0, 16);
 #endif
 
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+    /* Store the vector registers in the machine check extended
+       save area, if one has been designated, and indicate that
+       they are valid */
+    if (FACILITY_ENABLED( 129_ZVECTOR, regs ))
+    {
+        RADR mcesao;                    /* MC extended save area     */
+
+        FETCH_DW( mcesao, psa->mcesad );
+        mcesao &= ~0x3FFULL;
+
+        if (mcesao && mcesao <= regs->mainlim - 1023)
+        {
+            ARCH_DEP( or_storage_key )( mcesao, (STORKEY_REF | STORKEY_CHANGE) );
+            vr_store_all( regs, regs->mainstor + mcesao );
+            mcic |= MCIC_VR;
+        }
+    }
+#endif
+
     /* Store the machine check interrupt code at PSA+232 */
     STORE_DW(psa->mckint, mcic);
 
@@ -1896,6 +1923,11 @@ int     aswitch;
 
     regs->program_interrupt = &ARCH_DEP(program_interrupt);
 
+    /* Real mode TLB entries are identified by an architecture
+       dependent ASD, so any from a previous architecture must go */
+    regs->CR_G( CR_ASD_REAL ) = TLB_REAL_ASD;
+    ARCH_DEP( purge_tlb )( regs );
+
     regs->breakortrace = (sysblk.instbreak || sysblk.insttrace);
     regs->ints_state |= sysblk.ints_state;
 
@@ -1952,6 +1984,8 @@ int     aswitch;
     */
     if (setjmp( regs->progjmp ) && sysblk.ipled)
     {
+        EMU_STAT( regs, progjmp );
+
         /* Our instruction execution loop further below didn't finish
            due to a longjmp(progjmp) having been executed bringing us
            to here, thereby causing the instruction counter to not be
@@ -2122,8 +2156,10 @@ void ARCH_DEP( process_trace )( REGS* regs, BYTE* dest )
         }
     }
 
-    /* Display the instruction */
-    if (shouldtrace || regs->stepping)
+    /* Display the instruction, or write it to the trace file */
+    if (shouldtrace && sysblk.itrace && !regs->stepping)
+        ARCH_DEP( itrace_inst )( regs, dest );
+    else if (shouldtrace || regs->stepping)
         ARCH_DEP( display_inst )( regs, dest );
 
     /* Stop the CPU if instruction stepping */
@@ -123,11 +123,12 @@ static void     LCS_AddMulticast  ( PLCSDEV pLCSDEV, PLCSCMDHDR pCmdFrame, int i
 static void     LCS_DelMulticast  ( PLCSDEV pLCSDEV, PLCSCMDHDR pCmdFrame, int iCmdLen );
 static void     LCS_DefaultCmdProc( PLCSDEV pLCSDEV, PLCSCMDHDR pCmdFrame, int iCmdLen );
 
-static void*    LCS_PortThread( void* arg /* PLCSPORT pLCSPORT */ );
+static void*    LCS_PortThread( void* arg /* PLCSPORTQ pLCSPORTQ */ );
 static void*    LCS_AttnThread( void* arg /* PLCSBLK pLCSBLK */ );
 
 static void     LCS_EnqueueEthFrame     ( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV, BYTE* pData, size_t iSize );
 static int      LCS_DoEnqueueEthFrame   ( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV, BYTE* pData, size_t iSize );
+static void     LCS_WakeDevice          ( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV );
 
 static void     LCS_EnqueueReplyFrame   ( PLCSDEV pLCSDEV, PLCSCMDHDR pReply, size_t iSize );
 static int      LCS_DoEnqueueReplyFrame ( PLCSDEV pLCSDEV, PLCSCMDHDR pReply, size_t iSize );
@@ -173,6 +174,8 @@ static void     add_lcs_buffer_to_chain( PLCSDEV pLCSDEV, PLCSIBH pLCSIBH );
 static PLCSIBH  remove_lcs_buffer_from_chain( PLCSDEV pLCSDEV );
 static void     remove_and_free_any_lcs_buffers_on_chain( PLCSDEV pLCSDEV );
 static void     free_lcs_buffer( PLCSDEV pLCSDEV, PLCSIBH pLCSIBH );
+static void     prealloc_lcs_buffers( PLCSDEV pLCSDEV, int iCount );
+static void     free_lcs_buffer_pool( PLCSDEV pLCSDEV );
 
 static PLCSCONN alloc_connection( PLCSDEV pLCSDEV );
 static void     add_connection_to_chain( PLCSDEV pLCSDEV, PLCSCONN pLCSCONN );
@@ -262,6 +265,7 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
         }
         memset( pLCSBLK, 0, sizeof( LCSBLK ));
         pLCSBLK->iTraceLen = LCS_TRACE_LEN_DEFAULT;
+        pLCSBLK->iQueues   = 1;
 
         // Initialize locking and event mechanisms
         initialize_lock( &pLCSBLK->AttnLock );
@@ -275,6 +279,7 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
 
             pLCSPORT->bPort   = i;
             pLCSPORT->pLCSBLK = pLCSBLK;
+            pLCSPORT->nQueues = 1;
 
             // Initialize locking and event mechanisms
             initialize_lock( &pLCSPORT->PortDataLock );
@@ -425,9 +430,14 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
         initialize_lock( &pLCSDev->DevEventLock );
         initialize_condition( &pLCSDev->DevEvent );
         initialize_lock( &pLCSDev->LCSIBHChainLock );
+        initialize_lock( &pLCSDev->LCSIBHPoolLock );
         initialize_lock( &pLCSDev->LCSCONNChainLock );
         initialize_lock( &pLCSDev->InOutLock );
 
+        // Preallocate the SNA inbound buffers
+        if (pLCSDev->bMode == LCSDEV_MODE_SNA)
+            prealloc_lcs_buffers( pLCSDev, LCSIBH_POOL_INIT );
+
         // Create the TAP interface (if not already created by a
         // previous pass. More than one interface can exist on a port.
 
@@ -435,10 +445,16 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
 
         if (!pLCSPORT->fPortCreated)
         {
-            int  rc;
+            PLCSPORTQ  pLCSPORTQ;
+            int  rc, q, n;
+            int  iFlags = IFF_TAP | IFF_NO_PI;
 
+#if defined( TUNTAP_MULTIQUEUE )
+            if (pLCSBLK->iQueues > 1)
+                iFlags |= IFF_MULTI_QUEUE;
+#endif
             rc = TUNTAP_CreateInterface( pLCSBLK->pszTUNDevice,
-                                         IFF_TAP | IFF_NO_PI,
+                                         iFlags,
                                          &pLCSPORT->fd,
                                          pLCSPORT->szNetIfName );
 
@@ -457,6 +473,36 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
                                   pLCSDev->pDEVBLK[LCS_READ_SUBCHANN]->typname,
                                   pLCSPORT->szNetIfName, "TAP");
 
+#if defined( TUNTAP_MULTIQUEUE )
+            // Attach the additional queues of a multi-queue interface.
+            // Each queue has its own fd and its own read thread.
+            for (q=1; q < pLCSBLK->iQueues; q++)
+            {
+                char  szNetIfName[IFNAMSIZ];
+
+                STRLCPY( szNetIfName, pLCSPORT->szNetIfName );
+                pLCSPORTQ = &pLCSPORT->Queue[q];
+
+                if (TUNTAP_CreateInterface( pLCSBLK->pszTUNDevice, iFlags,
+                                            &pLCSPORTQ->fd, szNetIfName ) < 0)
+                {
+                    // "%1d:%04X %s: error in function %s: %s"
+                    WRMSG( HHC00900, "W", SSID_TO_LCSS( pLCSDev->pDEVBLK[LCS_READ_SUBCHANN]->ssid),
+                        pLCSDev->pDEVBLK[LCS_READ_SUBCHANN]->devnum, pLCSDev->pDEVBLK[LCS_READ_SUBCHANN]->typname,
+                        "TUNTAP_CreateInterface", strerror( errno ));
+                    break;
+                }
+                VERIFY( socket_set_blocking_mode( pLCSPORTQ->fd, 0 ) == 0 );
+            }
+            pLCSPORT->nQueues = q;
+#endif // defined( TUNTAP_MULTIQUEUE )
+
+#if !defined( OPTION_W32_CTCI )
+            // The port thread reads frames until none remain before
+            // waking the device(s) it has enqueued them to.
+            VERIFY( socket_set_blocking_mode( pLCSPORT->fd, 0 ) == 0 );
+#endif
+
             //
             if (!pLCSPORT->fPreconfigured)
             {
@@ -520,13 +566,46 @@ int  LCS_Init( DEVBLK* pDEVBLK, int argc, char *argv[] )
                                  pLCSBLK->pDevices->pDEVBLK[LCS_READ_SUBCHANN]->typname,
                                  pLCSBLK->pDevices->pDEVBLK[LCS_READ_SUBCHANN]->devnum,
                                  pLCSPORT->bPort);
+            pLCSPORTQ = &pLCSPORT->Queue[0];
+            pLCSPORTQ->pLCSPORT = pLCSPORT;
+            pLCSPORTQ->iQueue   = 0;
+            pLCSPORTQ->fd       = -1;
             rc = create_thread( &pLCSPORT->tid, JOINABLE,
-                                LCS_PortThread, pLCSPORT, thread_name );
+                                LCS_PortThread, pLCSPORTQ, thread_name );
             if (rc)
             {
                 // "Error in function create_thread(): %s"
                 WRMSG( HHC00102, "E", strerror( rc ));
             }
+            pLCSPORTQ->tid = pLCSPORT->tid;
+
+            // Likewise for the additional queues of the interface
+            for (q=1; q < pLCSPORT->nQueues; q++)
+            {
+                pLCSPORTQ = &pLCSPORT->Queue[q];
+                pLCSPORTQ->pLCSPORT = pLCSPORT;
+                pLCSPORTQ->iQueue   = q;
+                MSGBUF( thread_name, "%s %4.4X Port %d Queue %d",
+                                     pLCSBLK->pDevices->pDEVBLK[LCS_READ_SUBCHANN]->typname,
+                                     pLCSBLK->pDevices->pDEVBLK[LCS_READ_SUBCHANN]->devnum,
+                                     pLCSPORT->bPort, q);
+                rc = create_thread( &pLCSPORTQ->tid, JOINABLE,
+                                    LCS_PortThread, pLCSPORTQ, thread_name );
+                if (rc)
+                {
+                    // "Error in function create_thread(): %s"
+                    WRMSG( HHC00102, "E", strerror( rc ));
+                    break;
+                }
+            }
+
+            // (close any queues we couldn't create a thread for)
+            for (n=q; n < pLCSPORT->nQueues; n++)
+            {
+                VERIFY( TUNTAP_Close( pLCSPORT->Queue[n].fd ) == 0 );
+                pLCSPORT->Queue[n].fd = -1;
+            }
+            pLCSPORT->nQueues = q;
 
             // Identify thread ID with devices on which they're active
             pLCSDev->pDEVBLK[LCS_READ_SUBCHANN]->tid = pLCSPORT->tid;
@@ -1036,6 +1115,7 @@ int  LCS_Close( DEVBLK* pDEVBLK )
     PLCSDEV     pLCSDEV;
     PLCSBLK     pLCSBLK;
     PLCSPORT    pLCSPORT;
+    int         q;
 
     pLCSDEV = (PLCSDEV)pDEVBLK->dev_data;
     if (!pLCSDEV) return 0;  // (was incomplete group)
@@ -1089,7 +1169,7 @@ int  LCS_Close( DEVBLK* pDEVBLK )
                 PTT_DEBUG( "SET  closeInProg  ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
                 pLCSPORT->fCloseInProgress = 1;
                 PTT_DEBUG(             "SIG  PortEvent    ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
-                signal_condition( &pLCSPORT->PortEvent );
+                broadcast_condition( &pLCSPORT->PortEvent );
             }
             PTT_DEBUG(         "REL  PortEventLock", 000, pDEVBLK->devnum, pLCSPORT->bPort );
             release_lock( &pLCSPORT->PortEventLock );
@@ -1099,6 +1179,18 @@ int  LCS_Close( DEVBLK* pDEVBLK )
             detach_thread( tid );
         }
 
+        // The read threads of any additional queues exit (and close
+        // their own fd) as soon as they see the port has been closed.
+        for (q=1; q < pLCSPORT->nQueues; q++)
+        {
+            TID tid = pLCSPORT->Queue[q].tid;
+            PTT_DEBUG( "join_thread       ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
+            join_thread( tid, NULL );
+            PTT_DEBUG( "detach_thread     ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
+            detach_thread( tid );
+        }
+        pLCSPORT->nQueues = 1;
+
         if (pLCSDEV->pDEVBLK[ LCS_READ_SUBCHANN  ] && pLCSDEV->pDEVBLK[LCS_READ_SUBCHANN]->fd >= 0)
             pLCSDEV->pDEVBLK[ LCS_READ_SUBCHANN  ]->fd = -1;
         if (pLCSDEV->pDEVBLK[ LCS_WRITE_SUBCHANN ] && pLCSDEV->pDEVBLK[LCS_WRITE_SUBCHANN]->fd >= 0)
@@ -1137,6 +1229,8 @@ int  LCS_Close( DEVBLK* pDEVBLK )
                     pCurrLCSDev->pszIPAddress = NULL;
                 }
 
+                free_lcs_buffer_pool( pLCSDEV );
+
                 free( pLCSDEV );
                 pLCSDEV = NULL;
                 break;
@@ -1680,7 +1774,7 @@ static void  UpdatePortStarted( int bStarted, DEVBLK* pDEVBLK, PLCSPORT pLCSPORT
         // Wake up the LCS_PortThread...
 
         PTT_DEBUG(             "SIG  PortEvent    ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
-        signal_condition( &pLCSPORT->PortEvent );
+        broadcast_condition( &pLCSPORT->PortEvent );
     }
     PTT_DEBUG(         "REL  PortEventLock", 000, pDEVBLK->devnum, pLCSPORT->bPort );
     release_lock( &pLCSPORT->PortEventLock );
@@ -2269,12 +2363,32 @@ static int  LCS_DoEnqueueReplyFrame( PLCSDEV pLCSDEV, PLCSCMDHDR pReply, size_t
 // It waits for packets to arrive on the device and then enqueues them
 // to the device input queue to be read by the LCS_Read() function the
 // next time the guest issues a read CCW.
+//
+// Once a frame has arrived the thread keeps reading until no more are
+// waiting (or LCS_READ_BATCH have been read) and only then wakes the
+// device(s) the frames were enqueued to, so that a burst of frames
+// costs one wakeup of LCS_Read rather than one per frame.
+//
+// There is one such thread for each queue of a multi-queue interface.
+// Only the thread for queue 0 (the port's own fd) cleans up the port.
 // --------------------------------------------------------------------
 
+#if defined( OPTION_W32_CTCI )
+  #define LCS_READ_BATCH    1           // (reads are always blocking)
+#else
+  #define LCS_READ_BATCH    16          // Max frames read per wakeup
+#endif
+
 static void*  LCS_PortThread( void* arg)
 {
     DEVBLK*     pDEVBLK;
-    PLCSPORT    pLCSPORT = (PLCSPORT) arg;
+    PLCSPORTQ   pLCSPORTQ = (PLCSPORTQ) arg;
+    PLCSPORT    pLCSPORT  = pLCSPORTQ->pLCSPORT;
+    PLCSDEV     pWakeLCSDEV[ LCS_READ_BATCH ];
+    int         nWake     = 0;          // Devices to be woken
+    int         iBatch    = 0;          // Frames read since last wait
+    int         fd;
+    int         i;
     PLCSDEV     pLCSDev;
     PLCSDEV     pPrimaryLCSDEV;
     PLCSDEV     pSecondaryLCSDEV;
@@ -2298,12 +2412,30 @@ static void*  LCS_PortThread( void* arg)
 
     pDEVBLK = pLCSPORT->pLCSBLK->pDevices->pDEVBLK[ LCS_READ_SUBCHANN ];
 
-    pLCSPORT->pid = getpid();
+    if (!pLCSPORTQ->iQueue)
+        pLCSPORT->pid = getpid();
 
-    PTT_DEBUG(            "PORTHRD: ENTRY    ", 000, pDEVBLK->devnum, pLCSPORT->bPort );
+    PTT_DEBUG(            "PORTHRD: ENTRY    ", pLCSPORTQ->iQueue, pDEVBLK->devnum, pLCSPORT->bPort );
 
     for (;;)
     {
+        // Wake the devices we've enqueued frames to before we wait
+        // for anything, or once a full batch of frames has been read.
+
+        if (nWake && (0
+            || !iBatch
+            ||  iBatch >= LCS_READ_BATCH
+            || !pLCSPORT->fPortStarted
+            ||  pLCSPORT->fCloseInProgress
+        ))
+        {
+            for (i=0; i < nWake; i++)
+                LCS_WakeDevice( pLCSPORT, pWakeLCSDEV[i] );
+            nWake = 0;
+        }
+        if (iBatch >= LCS_READ_BATCH)
+            iBatch = 1;                 // (keep reading without waiting)
+
         PTT_DEBUG(        "GET  PortEventLock", 000, pDEVBLK->devnum, pLCSPORT->bPort );
         obtain_lock( &pLCSPORT->PortEventLock );
         PTT_DEBUG(        "GOT  PortEventLock", 000, pDEVBLK->devnum, pLCSPORT->bPort );
@@ -2368,13 +2500,29 @@ static void*  LCS_PortThread( void* arg)
         if ( pLCSPORT->fd < 0 || pLCSPORT->fCloseInProgress )
             break;
 
-        // Read an IP packet from the TAP device
+        fd = pLCSPORTQ->iQueue ? pLCSPORTQ->fd : pLCSPORT->fd;
+
+        // Read an IP packet from the TAP device, waiting for one to
+        // arrive only if the previous read found nothing more to read.
         PTT_TIMING( "b4 tt read", 0, 0, 0 );
-        iLength = read_tuntap( pLCSPORT->fd, szBuff, sizeof( szBuff ), DEF_NET_READ_TIMEOUT_SECS );
+        if (iBatch)
+        {
+            iLength = TUNTAP_Read( fd, szBuff, sizeof( szBuff ));
+            if (iLength < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+            {
+                iBatch = 0;
+                continue;
+            }
+        }
+        else
+            iLength = read_tuntap( fd, szBuff, sizeof( szBuff ), DEF_NET_READ_TIMEOUT_SECS );
         PTT_TIMING( "af tt read", 0, 0, iLength );
 
         if (iLength == 0)      // (probably EINTR; ignore)
+        {
+            iBatch = 0;
             continue;
+        }
 
         // Check for other error condition
         if (iLength < 0)
@@ -2386,6 +2534,8 @@ static void*  LCS_PortThread( void* arg)
             break;
         }
 
+        iBatch++;
+
         // Point to ethernet frame and determine frame type
         pEthFrame = (PETHFRM)szBuff;
 
@@ -2680,6 +2830,11 @@ static void*  LCS_PortThread( void* arg)
         if (pMatchingLCSDEV->bMode == LCSDEV_MODE_IP)
         {
             LCS_EnqueueEthFrame( pLCSPORT, pMatchingLCSDEV, szBuff, iLength );
+
+            // (remember to wake the device once the batch is done)
+            for (i=0; i < nWake && pWakeLCSDEV[i] != pMatchingLCSDEV; i++);
+            if (i == nWake)
+                pWakeLCSDEV[ nWake++ ] = pMatchingLCSDEV;
         }
         else  //  (pMatchingLCSDEV->bMode == LCSDEV_MODE_SNA)
         {
@@ -2688,8 +2843,21 @@ static void*  LCS_PortThread( void* arg)
 
     } // end for (;;)
 
+    for (i=0; i < nWake; i++)
+        LCS_WakeDevice( pLCSPORT, pWakeLCSDEV[i] );
+
     PTT_DEBUG( "PORTHRD Closing...", pLCSPORT->fPortStarted, pDEVBLK->devnum, pLCSPORT->bPort );
 
+    // The additional queues only need to close their own fd...
+
+    if (pLCSPORTQ->iQueue)
+    {
+        VERIFY( TUNTAP_Close( pLCSPORTQ->fd ) == 0 );
+        pLCSPORTQ->fd = -1;
+        PTT_DEBUG( "PORTHRD: EXIT     ", pLCSPORTQ->iQueue, pDEVBLK->devnum, pLCSPORT->bPort );
+        return NULL;
+    }
+
     // We must do the close since we were the one doing the i/o...
 
     VERIFY( pLCSPORT->fd == -1 || TUNTAP_Close( pLCSPORT->fd ) == 0 );
@@ -2733,6 +2901,7 @@ static void*  LCS_PortThread( void* arg)
 // Places the provided ethernet frame in the next available frame
 // slot in the adapter buffer. If buffer is full, keep trying.
 // The LCS device data lock must NOT be held when called!
+// The caller must wake the device (LCS_WakeDevice) afterwards.
 //
 // --------------------------------------------------------------------
 
@@ -2793,6 +2962,7 @@ static void LCS_EnqueueEthFrame( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV, BYTE* pData
         // Wait for LCS_Read to empty the buffer...
 
         ASSERT( ENOBUFS == errno );
+        LCS_WakeDevice( pLCSPORT, pLCSDEV );
         usleep( CTC_DELAY_USECS );
     }
     PTT_TIMING( "af enqueue", 0, iSize, 0 );
@@ -2879,7 +3049,27 @@ static int  LCS_DoEnqueueEthFrame( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV, BYTE* pDa
     PTT_DEBUG(        "REL  DevDataLock  ", 000, pDEVBLK->devnum, bPort );
     release_lock( &pLCSDEV->DevDataLock );
 
-    // (wake up "LCS_Read" function)
+    return 0;       // (success)
+}
+
+// ====================================================================
+//                       LCS_WakeDevice
+// ====================================================================
+//
+// Wakes up the "LCS_Read" function of the device after one or more
+// ethernet frames have been placed in its adapter buffer.
+//
+// --------------------------------------------------------------------
+
+static void  LCS_WakeDevice( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV )
+{
+    DEVBLK*     pDEVBLK;
+    BYTE        bPort;
+
+
+    pDEVBLK = pLCSDEV->pDEVBLK[ LCS_READ_SUBCHANN ];
+    bPort   = pLCSPORT->bPort;
+
     PTT_DEBUG(       "GET  DevEventLock ", 000, pDEVBLK->devnum, bPort );
     obtain_lock( &pLCSDEV->DevEventLock );
     PTT_DEBUG(       "GOT  DevEventLock ", 000, pDEVBLK->devnum, bPort );
@@ -2889,8 +3079,6 @@ static int  LCS_DoEnqueueEthFrame( PLCSPORT pLCSPORT, PLCSDEV pLCSDEV, BYTE* pDa
     }
     PTT_DEBUG(        "REL  DevEventLock ", 000, pDEVBLK->devnum, bPort );
     release_lock( &pLCSDEV->DevEventLock );
-
-    return 0;       // (success)
 }
 
 // ====================================================================
@@ -3277,6 +3465,9 @@ int  ParseArgs( DEVBLK* pDEVBLK, PLCSBLK pLCSBLK,
     int             i;
     int             iDiscTrace;
     int             iTraceLen;
+#if defined( TUNTAP_MULTIQUEUE )
+    int             iQueues;
+#endif
 #if defined(OPTION_W32_CTCI)
     int             iKernBuff;
     int             iIOBuff;
@@ -3322,6 +3513,8 @@ int  ParseArgs( DEVBLK* pDEVBLK, PLCSBLK pLCSBLK,
 
 #if defined( OPTION_W32_CTCI )
   #define  LCS_OPTSTRING    "e:n:m:o:s:t:dk:i:w"
+#elif defined( TUNTAP_MULTIQUEUE )
+  #define  LCS_OPTSTRING    "e:n:x:m:o:s:t:dq:"
 #else
   #define  LCS_OPTSTRING    "e:n:x:m:o:s:t:d"
 #endif
@@ -3340,6 +3533,9 @@ int  ParseArgs( DEVBLK* pDEVBLK, PLCSBLK pLCSBLK,
             { "distrc", required_argument, NULL, 's' },
             { "maxtrc", required_argument, NULL, 't' },
             { "debug",  no_argument,       NULL, 'd' },
+#if defined( TUNTAP_MULTIQUEUE )
+            { "queues", required_argument, NULL, 'q' },
+#endif
 #if defined( OPTION_W32_CTCI )
             { "kbuff",  required_argument, NULL, 'k' },
             { "ibuff",  required_argument, NULL, 'i' },
@@ -3468,6 +3664,25 @@ int  ParseArgs( DEVBLK* pDEVBLK, PLCSBLK pLCSBLK,
             pLCSBLK->fDebug = TRUE;
             break;
 
+#if defined( TUNTAP_MULTIQUEUE )
+
+        case 'q':     // Number of TAP queues (and read threads) per port
+
+            iQueues = atoi( optarg );
+
+            if (iQueues < 1 || iQueues > LCS_MAX_QUEUES)
+            {
+                // "%1d:%04X CTC: option %s value %s invalid"
+                WRMSG( HHC00916, "E", SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum, pDEVBLK->typname,
+                       "number of queues", optarg );
+                return -1;
+            }
+
+            pLCSBLK->iQueues = iQueues;
+            break;
+
+#endif // defined( TUNTAP_MULTIQUEUE )
+
 #if defined( OPTION_W32_CTCI )
 
         case 'k':     // Kernel Buffer Size (Windows only)
@@ -7458,20 +7673,47 @@ int  BuildLLC( PLLC pLLC, BYTE* pStart )
 /* ------------------------------------------------------------------ */
 /* alloc_lcs_buffer(): Allocate storage for an LCSIBH and data        */
 /* ------------------------------------------------------------------ */
+/* Buffers of up to LCSIBH_POOL_SIZE bytes are taken from the free    */
+/* pool if possible, and are always allocated at that size so that    */
+/* free_lcs_buffer() can return them to the pool for reuse.           */
 PLCSIBH  alloc_lcs_buffer( PLCSDEV pLCSDEV, int iSize )
 {
     DEVBLK*    pDEVBLK;
     PLCSIBH    pLCSIBH;                // LCSIBH
+    int        iBuffLen;               // Data area length
     int        iBufLen;                // Buffer length
     char       etext[40];              // malloc error text
 
 
+    // Take a buffer from the free pool if the data will fit.
+    if (iSize <= LCSIBH_POOL_SIZE)
+    {
+        obtain_lock( &pLCSDEV->LCSIBHPoolLock );
+        pLCSIBH = pLCSDEV->pFreeLCSIBH;
+        if (pLCSIBH)
+        {
+            pLCSDEV->pFreeLCSIBH = pLCSIBH->pNextLCSIBH;
+            pLCSDEV->iFreeLCSIBH--;
+        }
+        release_lock( &pLCSDEV->LCSIBHPoolLock );
+
+        if (pLCSIBH)
+        {
+            memset( pLCSIBH, 0, sizeof(LCSIBH) + iSize );
+            pLCSIBH->iAreaLen = iSize;
+            pLCSIBH->iBuffLen = LCSIBH_POOL_SIZE;
+            return pLCSIBH;
+        }
+    }
+
     // Allocate the buffer.
-    iBufLen = sizeof(LCSIBH) + iSize;
+    iBuffLen = iSize <= LCSIBH_POOL_SIZE ? LCSIBH_POOL_SIZE : iSize;
+    iBufLen = sizeof(LCSIBH) + iBuffLen;
     pLCSIBH = calloc( iBufLen, 1 );    // Allocate and clear the buffer
     if (pLCSIBH)                       // if the allocate was successful...
     {
         pLCSIBH->iAreaLen = iSize;
+        pLCSIBH->iBuffLen = iBuffLen;
     }
     else                               // ohdear, the allocate was not successful...
     {
@@ -7579,16 +7821,62 @@ void  remove_and_free_any_lcs_buffers_on_chain( PLCSDEV pLCSDEV )
 }
 
 /* ------------------------------------------------------------------ */
-/* free_lcs_buffer(): Free LCSIBH.                                    */
+/* free_lcs_buffer(): Free LCSIBH (or return it to the free pool).    */
 /* ------------------------------------------------------------------ */
 void  free_lcs_buffer( PLCSDEV pLCSDEV, PLCSIBH pLCSIBH )
 {
-    UNREFERENCED( pLCSDEV );
+    if (pLCSIBH->iBuffLen == LCSIBH_POOL_SIZE)
+    {
+        obtain_lock( &pLCSDEV->LCSIBHPoolLock );
+        if (pLCSDEV->iFreeLCSIBH < LCSIBH_POOL_MAX)
+        {
+            pLCSIBH->pNextLCSIBH = pLCSDEV->pFreeLCSIBH;
+            pLCSDEV->pFreeLCSIBH = pLCSIBH;
+            pLCSDEV->iFreeLCSIBH++;
+            pLCSIBH = NULL;
+        }
+        release_lock( &pLCSDEV->LCSIBHPoolLock );
+    }
 
     free( pLCSIBH );
     return;
 }
 
+/* ------------------------------------------------------------------ */
+/* prealloc_lcs_buffers(): Add new LCSIBHs to the free pool.          */
+/* ------------------------------------------------------------------ */
+void  prealloc_lcs_buffers( PLCSDEV pLCSDEV, int iCount )
+{
+    PLCSIBH    pLCSIBH;                // LCSIBH
+
+    while (iCount-- > 0)
+    {
+        pLCSIBH = calloc( sizeof(LCSIBH) + LCSIBH_POOL_SIZE, 1 );
+        if (!pLCSIBH)
+            break;                     // (alloc_lcs_buffer will report)
+        pLCSIBH->iBuffLen = LCSIBH_POOL_SIZE;
+        free_lcs_buffer( pLCSDEV, pLCSIBH );
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* free_lcs_buffer_pool(): Free all LCSIBHs in the free pool.         */
+/* ------------------------------------------------------------------ */
+void  free_lcs_buffer_pool( PLCSDEV pLCSDEV )
+{
+    PLCSIBH    pLCSIBH;                // LCSIBH
+
+    obtain_lock( &pLCSDEV->LCSIBHPoolLock );
+    while (pLCSDEV->pFreeLCSIBH)
+    {
+        pLCSIBH = pLCSDEV->pFreeLCSIBH;
+        pLCSDEV->pFreeLCSIBH = pLCSIBH->pNextLCSIBH;
+        free( pLCSIBH );
+    }
+    pLCSDEV->iFreeLCSIBH = 0;
+    release_lock( &pLCSDEV->LCSIBHPoolLock );
+}
+
 
 /* ------------------------------------------------------------------ */
 /* alloc_connection(): Allocate storage for an LCSCONN                */
@@ -106,6 +106,9 @@ static PTPHDR*  remove_buffer_from_chain( PTPATH* pPTPATH );
 static void*    remove_and_free_any_buffers_on_chain( PTPATH* pPTPATH );
 
 static PTPHDR*  alloc_ptp_buffer( DEVBLK* pDEVBLK, int iSize );
+static void     free_ptp_buffer( DEVBLK* pDEVBLK, PTPHDR* pPTPHDR );
+static void     alloc_ptp_pool( DEVBLK* pDEVBLK, PTPBLK* pPTPBLK );
+static void     free_ptp_pool( PTPBLK* pPTPBLK );
 static void*    alloc_storage( DEVBLK* pDEVBLK, int iSize );
 
 
@@ -462,6 +465,7 @@ int  ptp_init( DEVBLK* pDEVBLK, int argc, char *argv[] )
     initialize_condition( &pPTPBLK->ReadEvent );
     initialize_lock( &pPTPBLK->UnsolListLock );
     initialize_lock( &pPTPBLK->UpdateLock );
+    initialize_lock( &pPTPBLK->PoolLock );
 
     initialize_lock( &pPTPATHre->ChainLock );
     initialize_lock( &pPTPATHre->UnsolEventLock );
@@ -500,6 +504,12 @@ int  ptp_init( DEVBLK* pDEVBLK, int argc, char *argv[] )
     pPTPBLK->pDEVBLKRead->fd =
     pPTPBLK->pDEVBLKWrite->fd = pPTPBLK->fd;
 
+#if !defined( OPTION_W32_CTCI )
+    // The read thread reads packets until none remain before
+    // waking ptp_read.
+    VERIFY( socket_set_blocking_mode( pPTPBLK->fd, 0 ) == 0 );
+#endif
+
     /* */
     if (!pPTPBLK->fPreconfigured) {
 
@@ -570,6 +580,9 @@ int  ptp_init( DEVBLK* pDEVBLK, int argc, char *argv[] )
 
     }
 
+    // Allocate the buffer pool.
+    alloc_ptp_pool( pDEVBLK, pPTPBLK );
+
     // Create the read thread.
     MSGBUF( thread_name, "%s %4.4X ReadThread",
                          pPTPBLK->pDEVBLKRead->typname,
@@ -588,7 +601,8 @@ int  ptp_init( DEVBLK* pDEVBLK, int argc, char *argv[] )
         // Disconnect the DEVBLKs from the PTPATHs.
         pPTPBLK->pDEVBLKRead->dev_data = NULL;
         pPTPBLK->pDEVBLKWrite->dev_data = NULL;
-        // Free the PTPATHs and PTPBLK
+        // Free the buffer pool, PTPATHs and PTPBLK
+        free_ptp_pool( pPTPBLK );
         free( pPTPATHwr );
         free( pPTPATHre );
         free( pPTPBLK );
@@ -841,11 +855,11 @@ int  ptp_close( DEVBLK* pDEVBLK )
         // the "ptp_read_thread"s TUNTAP_Read of the adapter. Thus
         // we must simply wait for ptp_read_thread to eventually
         // notice that we're doing a close (via our setting of the
-        // fCloseInProgress flag). Its TUNTAP_Read will eventually
-        // timeout after a few seconds (currently 5, which is dif-
-        // ferent than the PTP_READ_TIMEOUT_SECS timeout value the
-        // ptp_read function uses) and will then do the close of
-        // the adapter for us (TUNTAP_Close) so we don't have to.
+        // fCloseInProgress flag). Its read_tuntap will eventually
+        // timeout after a few seconds (currently 5, the same as
+        // the PTP_READ_TIMEOUT_SECS timeout value the ptp_read
+        // function uses) and will then do the close of the
+        // adapter for us (TUNTAP_Close) so we don't have to.
         // All we need to do is ask it to exit (via our setting of
         // the fCloseInProgress flag) and then wait for it to exit
         // (which, as stated, could take up to a max of 5 seconds).
@@ -863,6 +877,21 @@ int  ptp_close( DEVBLK* pDEVBLK )
         join_thread( tid, NULL );       // (wait for thread to end)
 #endif
         detach_thread( tid );           // (wait for thread to end)
+
+        // Free any buffers still waiting to be read, the read buffer,
+        // the buffer pool and the write concatenation buffer. (The
+        // read buffer is returned before the pool is freed, as it may
+        // have been taken from the pool's slab.)
+        remove_and_free_any_buffers_on_chain( pPTPBLK->pPTPATHRead );
+        remove_and_free_any_buffers_on_chain( pPTPBLK->pPTPATHWrite );
+        obtain_lock( &pPTPBLK->ReadBufferLock );
+        free_ptp_buffer( pDEVBLK, pPTPBLK->pReadBuffer );
+        pPTPBLK->pReadBuffer = NULL;
+        release_lock( &pPTPBLK->ReadBufferLock );
+        free_ptp_pool( pPTPBLK );
+        free( pPTPBLK->pWriteBuffer );
+        pPTPBLK->pWriteBuffer = NULL;
+        pPTPBLK->iWriteBufferLen = 0;
     }
 
     pDEVBLK->fd = -1;           // indicate we're now closed
@@ -1297,6 +1326,7 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
 
     // Get the total length of the data referenced by all of the MPC_PHs.
     FETCH_F3( iDataLen, pMPC_RRH->lenalda );
+    pPTPATH->uBlocks++;
 
     // Check whether there is more than one MPC_PH.
     if (uNumPH == 1)
@@ -1305,11 +1335,20 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
     }
     else
     {
-        // More than one MPC_PH. Allocate a buffer in which all of
-        // the data referenced by the MPC_PHs will be concatanated.
-        pDataBuf = alloc_storage( pDEVBLK, iDataLen );   // Allocate buffer
-        if (!pDataBuf)               // if the allocate was not successful...
-            return -1;
+        // More than one MPC_PH. The data referenced by the MPC_PHs
+        // will be concatanated in the write buffer, which is kept
+        // between messages and only reallocated when a message with
+        // more data than it can hold arrives.
+        if (iDataLen > pPTPBLK->iWriteBufferLen)
+        {
+            pDataBuf = alloc_storage( pDEVBLK, iDataLen );   // Allocate buffer
+            if (!pDataBuf)           // if the allocate was not successful...
+                return -1;
+            free( pPTPBLK->pWriteBuffer );
+            pPTPBLK->pWriteBuffer = pDataBuf;
+            pPTPBLK->iWriteBufferLen = iDataLen;
+        }
+        pDataBuf = pPTPBLK->pWriteBuffer;
 
         // Copy and concatanate the data referenced by the MPC_PHs.
         pData = pDataBuf;
@@ -1363,6 +1402,7 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
                                      iTraceLen, iDataLen - iTraceLen );
             }
             net_data_trace( pDEVBLK, pData, iTraceLen, FROM_GUEST, 'I', "data", 0 );
+            pPTPATH->uDropped++;
             rv = -2;
             break;
         }
@@ -1409,6 +1449,7 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
                                      iTraceLen, iDataLen - iTraceLen );
             }
             net_data_trace( pDEVBLK, pData, iTraceLen, FROM_GUEST, 'I', "data", 0 );
+            pPTPATH->uDropped++;
             rv = -2;
             break;
         }
@@ -1426,6 +1467,7 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
                                      iTraceLen, iDataLen - iTraceLen );
             }
             net_data_trace( pDEVBLK, pData, iTraceLen, FROM_GUEST, 'I', "data", 0 );
+            pPTPATH->uDropped++;
             rv = -2;
             break;
         }
@@ -1469,7 +1511,11 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
                 rv = -3;
                 break;
             }
+            pPTPATH->uPackets++;
+            pPTPATH->uBytes += iPktLen;
         }
+        else
+            pPTPATH->uDropped++;
 
         rv = 0;
 
@@ -1479,10 +1525,6 @@ int   write_rrh_8108( DEVBLK* pDEVBLK, MPC_TH* pMPC_TH, MPC_RRH* pMPC_RRH )
 
     }   /* while( iDataLen > 0 ) */
 
-    // Free the data buffer, if one was used.
-    if (pDataBuf)
-        free( pDataBuf );
-
     return rv;
 }   /* End function  write_rrh_8108() */
 
@@ -1554,7 +1596,7 @@ void  ptp_read( DEVBLK* pDEVBLK, U32  uCount,
                                    pMore, pUnitStat, pResidual, pPTPHDR );
 
                 // Free the buffer.
-                free( pPTPHDR );
+                free_ptp_buffer( pDEVBLK, pPTPHDR );
                 return;
             }
 
@@ -1637,7 +1679,7 @@ void  ptp_read( DEVBLK* pDEVBLK, U32  uCount,
                                pMore, pUnitStat, pResidual, pPTPHDR );
 
             // Free the buffer.
-            free( pPTPHDR );
+            free_ptp_buffer( pDEVBLK, pPTPHDR );
 
             return;
         }
@@ -1695,6 +1737,7 @@ void  read_read_buffer( DEVBLK* pDEVBLK,   U32     uCount,
 
     // Set the transmission header sequence number.
     STORE_FW( pMPC_TH->seqnum, ++pPTPATH->uSeqNum );
+    pPTPATH->uBlocks++;
 
     // Set the destination Token.
     pMPC_RRH->tokenx5 = MPC_TOKEN_X5;
@@ -2032,6 +2075,12 @@ void  read_chain_buffer( DEVBLK* pDEVBLK,   U32  uCount,
 // thing. Because we are not processing the packets, we are simply
 // forwarding them, we may be forwarding them from something using a
 // larger MTU to something using a smaller MTU.
+//
+// Once a packet has arrived the thread keeps reading, packing the
+// packets into the read buffer, until no more are waiting (or
+// PTP_READ_BATCH have been read) and only then wakes ptp_read, so
+// that the guest reads a full MPC block rather than one block per
+// packet.
 
 void*  ptp_read_thread( void* arg )
 {
@@ -2053,6 +2102,8 @@ void*  ptp_read_thread( void* arg )
     char       cPktVer[8];
     int        iPktLen;
     int        iTraceLen;
+    int        iBatch  = 0;                    // Packets read since last wait
+    int        iQueued = 0;                    // Packets queued since last wakeup
 
 
     // Allocate the TUN read buffer.
@@ -2078,8 +2129,32 @@ void*  ptp_read_thread( void* arg )
     while( pPTPBLK->fd != -1 && !pPTPBLK->fCloseInProgress )
     {
 
-        // Read an IP packet from the TUN interface.
-        iLength = TUNTAP_Read( pPTPBLK->fd, (void*)pTunBuf, iTunLen );
+        // Wake ptp_read for the packets queued in the read buffer before
+        // we wait for anything, or once a full batch has been read.
+        if (iQueued && (!iBatch || iBatch >= PTP_READ_BATCH))
+        {
+            obtain_lock( &pPTPBLK->ReadEventLock );
+            signal_condition( &pPTPBLK->ReadEvent );
+            release_lock( &pPTPBLK->ReadEventLock );
+            pPTPATH->uWakeups++;
+            iQueued = 0;
+        }
+        if (iBatch >= PTP_READ_BATCH)
+            iBatch = 1;                 // (keep reading without waiting)
+
+        // Read an IP packet from the TUN interface, waiting for one to
+        // arrive only if the previous read found nothing more to read.
+        if (iBatch)
+        {
+            iLength = TUNTAP_Read( pPTPBLK->fd, (void*)pTunBuf, iTunLen );
+            if (iLength < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+            {
+                iBatch = 0;
+                continue;
+            }
+        }
+        else
+            iLength = read_tuntap( pPTPBLK->fd, pTunBuf, iTunLen, PTP_READ_TIMEOUT_SECS );
 
         // Check for error conditions...
         if (iLength < 0)
@@ -2093,8 +2168,13 @@ void*  ptp_read_thread( void* arg )
             break;
         }
 
-        if (iLength == 0)       // (probably EINTR; ignore)
+        if (iLength == 0)       // (timeout or EINTR; ignore)
+        {
+            iBatch = 0;
             continue;
+        }
+
+        iBatch++;
 
         // Check the IP packet version. The first 4-bits of the first
         // byte of the IP header contains the version number.
@@ -2110,6 +2190,7 @@ void*  ptp_read_thread( void* arg )
         else
         {
             // Err... not IPv4 or IPv6!
+            pPTPATH->uDropped++;
             // HHC03921 "%1d:%04X PTP: Packet of size %d bytes from device '%s' has an unknown IP version, packet dropped"
             WRMSG(HHC03921, "W", SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
                                  iLength, pPTPBLK->szTUNIfName );
@@ -2155,6 +2236,7 @@ void*  ptp_read_thread( void* arg )
         }
         if (iPktLen != iLength)
         {
+            pPTPATH->uDropped++;
             // HHC03922 "%1d:%04X PTP: Packet of size %d bytes from device '%s' is not equal to the packet length of %d bytes, packet dropped"
             WRMSG(HHC03922, "W", SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
                                  iLength, pPTPBLK->szTUNIfName,
@@ -2185,6 +2267,7 @@ void*  ptp_read_thread( void* arg )
                 {
                     // Release the read buffer lock.
                     release_lock( &pPTPBLK->ReadBufferLock );
+                    pPTPATH->uDropped++;
                     break;
                 }
             }
@@ -2194,6 +2277,7 @@ void*  ptp_read_thread( void* arg )
                 {
                     // Release the read buffer lock.
                     release_lock( &pPTPBLK->ReadBufferLock );
+                    pPTPATH->uDropped++;
                     break;
                 }
             }
@@ -2204,6 +2288,7 @@ void*  ptp_read_thread( void* arg )
             {
                 // Release the read buffer lock.
                 release_lock( &pPTPBLK->ReadBufferLock );
+                pPTPATH->uDropped++;
                 break;
             }
 
@@ -2213,6 +2298,7 @@ void*  ptp_read_thread( void* arg )
             {
                 // Release the read buffer lock.
                 release_lock( &pPTPBLK->ReadBufferLock );
+                pPTPATH->uDropped++;
                 // HHC03923 "%1d:%04X PTP: Packet of size %d bytes from device '%s' is larger than the guests actual MTU of %d bytes, packet dropped"
                 WRMSG(HHC03923, "W", SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
                                      iLength, pPTPBLK->szTUNIfName,
@@ -2235,6 +2321,7 @@ void*  ptp_read_thread( void* arg )
             {
                 // Release the read buffer lock.
                 release_lock( &pPTPBLK->ReadBufferLock );
+                pPTPATH->uDropped++;
                 // HHC03924 "%1d:%04X PTP: Packet of size %d bytes from device '%s' is too large for read buffer area of %d bytes, packet dropped"
                 WRMSG(HHC03924, "W", SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
                                      iLength, pPTPBLK->szTUNIfName,
@@ -2260,6 +2347,17 @@ void*  ptp_read_thread( void* arg )
                 // Release the read buffer lock.
                 release_lock( &pPTPBLK->ReadBufferLock );
 
+                // Wake ptp_read for the packets queued so far, if it
+                // has not been woken for them already.
+                if (iQueued)
+                {
+                    obtain_lock( &pPTPBLK->ReadEventLock );
+                    signal_condition( &pPTPBLK->ReadEvent );
+                    release_lock( &pPTPBLK->ReadEventLock );
+                    pPTPATH->uWakeups++;
+                    iQueued = 0;
+                }
+
                 // Don't use schedyield() here; use an actual non-dispatchable
                 // delay instead so as to allow another [possibly lower priority]
                 // thread to 'read' (remove) the packet(s) from the read buffer.
@@ -2294,10 +2392,10 @@ void*  ptp_read_thread( void* arg )
                 // Release the read buffer lock.
                 release_lock( &pPTPBLK->ReadBufferLock );
 
-                //
-                obtain_lock( &pPTPBLK->ReadEventLock );
-                signal_condition( &pPTPBLK->ReadEvent );
-                release_lock( &pPTPBLK->ReadEventLock );
+                // ptp_read is woken when the batch ends.
+                pPTPATH->uPackets++;
+                pPTPATH->uBytes += iLength;
+                iQueued++;
 
                 break;
 
@@ -2448,7 +2546,7 @@ void*    remove_and_free_any_buffers_on_chain( PTPATH* pPTPATH )
     {
         pPTPHDR = pPTPATH->pFirstPTPHDR;               // Pointer to first PTPHDR
         pPTPATH->pFirstPTPHDR = pPTPHDR->pNextPTPHDR;  // Make the next the first PTPHDR
-        free( pPTPHDR );                               // Free the message buffer
+        free_ptp_buffer( pPTPATH->pDEVBLK, pPTPHDR );  // Free the message buffer
     }
 
     // Reset the chain pointers.
@@ -2467,18 +2565,44 @@ void*    remove_and_free_any_buffers_on_chain( PTPATH* pPTPATH )
 /* ------------------------------------------------------------------ */
 /* alloc_ptp_buffer(): Allocate storage for a PTPHDR and data         */
 /* ------------------------------------------------------------------ */
+// Buffers with a data area of up to PTP_POOL_AREA_LEN bytes are taken
+// from the buffer pool, if it has a free buffer.
 
 PTPHDR*  alloc_ptp_buffer( DEVBLK* pDEVBLK, int iSize )
 {
 
+    PTPATH*    pPTPATH  = pDEVBLK->dev_data;   // PTPATH
+    PTPBLK*    pPTPBLK  = pPTPATH->pPTPBLK;    // PTPBLK
     PTPHDR*    pPTPHDR;                // PTPHDR
     int        iBufLen;                // Buffer length
     char       etext[40];              // malloc error text
 
 
-    // Allocate the buffer.
+    // Take a buffer from the pool, if possible.
     iBufLen = SIZE_HDR + iSize;
-    pPTPHDR = malloc( iBufLen );       // Allocate the buffer
+    pPTPHDR = NULL;
+    if (iSize <= PTP_POOL_AREA_LEN)
+    {
+        obtain_lock( &pPTPBLK->PoolLock );
+        pPTPHDR = pPTPBLK->pFreePTPHDR;
+        if (pPTPHDR)
+        {
+            pPTPBLK->pFreePTPHDR = pPTPHDR->pNextPTPHDR;
+            pPTPBLK->iFreePTPHDR--;
+        }
+        else
+            pPTPBLK->uPoolMisses++;
+        release_lock( &pPTPBLK->PoolLock );
+
+        // Buffers of the pool size are allocated when the pool is
+        // empty, so that any small buffer could be returned to it.
+        if (!pPTPHDR)
+            iBufLen = PTP_POOL_BUF_LEN;
+    }
+
+    // Otherwise allocate the buffer.
+    if (!pPTPHDR)
+        pPTPHDR = malloc( iBufLen );   // Allocate the buffer
     if (!pPTPHDR)                      // if the allocate was not successful...
     {
         // Report the bad news.
@@ -2490,13 +2614,127 @@ PTPHDR*  alloc_ptp_buffer( DEVBLK* pDEVBLK, int iSize )
     }
 
     // Clear the buffer.
-    memset( pPTPHDR, 0, iBufLen );
+    memset( pPTPHDR, 0, SIZE_HDR + iSize );
     pPTPHDR->iAreaLen = iSize;
 
     return pPTPHDR;
 }
 
 
+/* ------------------------------------------------------------------ */
+/* free_ptp_buffer(): Free storage for a PTPHDR and data              */
+/* ------------------------------------------------------------------ */
+// Buffers from the slab are always returned to the pool, small buffers
+// allocated while the pool was empty are returned to the pool until
+// it holds as many buffers as the slab, and the rest are freed.
+
+void  free_ptp_buffer( DEVBLK* pDEVBLK, PTPHDR* pPTPHDR )
+{
+
+    PTPATH*    pPTPATH  = pDEVBLK->dev_data;   // PTPATH
+    PTPBLK*    pPTPBLK  = pPTPATH->pPTPBLK;    // PTPBLK
+
+
+    if (!pPTPHDR)
+        return;
+
+    if (pPTPHDR->iAreaLen <= PTP_POOL_AREA_LEN)
+    {
+        obtain_lock( &pPTPBLK->PoolLock );
+        if (0
+            || IS_PTP_SLAB_BUFFER( pPTPBLK, pPTPHDR )
+            || (pPTPBLK->pPoolSlab && pPTPBLK->iFreePTPHDR < PTP_POOL_SLAB)
+        )
+        {
+            pPTPHDR->pNextPTPHDR = pPTPBLK->pFreePTPHDR;
+            pPTPBLK->pFreePTPHDR = pPTPHDR;
+            pPTPBLK->iFreePTPHDR++;
+            pPTPHDR = NULL;
+        }
+        release_lock( &pPTPBLK->PoolLock );
+    }
+
+    // Free the buffer if it was not returned to the pool.
+    if (pPTPHDR)
+        free( pPTPHDR );
+}
+
+
+/* ------------------------------------------------------------------ */
+/* alloc_ptp_pool(): Allocate the buffer pool slab                    */
+/* ------------------------------------------------------------------ */
+// If the slab cannot be allocated there is no pool, and every buffer
+// is allocated and freed individually.
+
+void  alloc_ptp_pool( DEVBLK* pDEVBLK, PTPBLK* pPTPBLK )
+{
+
+    PTPHDR*    pPTPHDR;                // PTPHDR
+    int        i;
+
+
+    pPTPBLK->pPoolSlab = alloc_storage( pDEVBLK, PTP_POOL_SLAB * PTP_POOL_BUF_LEN );
+    if (!pPTPBLK->pPoolSlab)
+        return;
+
+    for (i = PTP_POOL_SLAB - 1; i >= 0; i--)
+    {
+        pPTPHDR = (PTPHDR*)(pPTPBLK->pPoolSlab + (i * PTP_POOL_BUF_LEN));
+        pPTPHDR->pNextPTPHDR = pPTPBLK->pFreePTPHDR;
+        pPTPBLK->pFreePTPHDR = pPTPHDR;
+        pPTPBLK->iFreePTPHDR++;
+    }
+}
+
+
+/* ------------------------------------------------------------------ */
+/* free_ptp_pool(): Free the buffer pool                              */
+/* ------------------------------------------------------------------ */
+// The slab is only freed once all of its buffers have been returned
+// to the pool; until then buffers freed by free_ptp_buffer() continue
+// to be returned to it.
+
+void  free_ptp_pool( PTPBLK* pPTPBLK )
+{
+
+    PTPHDR*    pPTPHDR;                // PTPHDR
+    PTPHDR*    pNextPTPHDR;            // Next PTPHDR
+    int        iSlab = 0;
+
+
+    obtain_lock( &pPTPBLK->PoolLock );
+
+    // Free the buffers that were allocated outside the slab.
+    pPTPHDR = pPTPBLK->pFreePTPHDR;
+    pPTPBLK->pFreePTPHDR = NULL;
+    pPTPBLK->iFreePTPHDR = 0;
+    for (; pPTPHDR; pPTPHDR = pNextPTPHDR)
+    {
+        pNextPTPHDR = pPTPHDR->pNextPTPHDR;
+        if (IS_PTP_SLAB_BUFFER( pPTPBLK, pPTPHDR ))
+        {
+            pPTPHDR->pNextPTPHDR = pPTPBLK->pFreePTPHDR;
+            pPTPBLK->pFreePTPHDR = pPTPHDR;
+            pPTPBLK->iFreePTPHDR++;
+            iSlab++;
+        }
+        else
+            free( pPTPHDR );
+    }
+
+    // Free the slab, if all of its buffers are free.
+    if (pPTPBLK->pPoolSlab && iSlab == PTP_POOL_SLAB)
+    {
+        free( pPTPBLK->pPoolSlab );
+        pPTPBLK->pPoolSlab = NULL;
+        pPTPBLK->pFreePTPHDR = NULL;
+        pPTPBLK->iFreePTPHDR = 0;
+    }
+
+    release_lock( &pPTPBLK->PoolLock );
+}
+
+
 /* ------------------------------------------------------------------ */
 /* alloc_storage(): Allocate storage                                  */
 /* ------------------------------------------------------------------ */
@@ -4327,7 +4565,7 @@ void  write_hx2( DEVBLK* pDEVBLK, U32  uCount,
                 {
                     // Free the existing read buffer, if there is one.
                     if (pPTPHDR)
-                        free( pPTPHDR );
+                        free_ptp_buffer( pDEVBLK, pPTPHDR );
 
                     // Allocate a new read buffer.
                     pPTPHDR = alloc_ptp_buffer( pDEVBLK, (int)uMaxReadLen );
@@ -4423,7 +4661,7 @@ void  write_hx2( DEVBLK* pDEVBLK, U32  uCount,
         if (!pPTPHDRx2)
         {
             // Free the PTPHDR
-            free( pPTPHDRx0 );
+            free_ptp_buffer( pDEVBLK, pPTPHDRx0 );
             return;
         }
         pPTPHX2re = (PTPHX2*)((BYTE*)pPTPHDRx2 + SIZE_HDR);
@@ -4434,8 +4672,8 @@ void  write_hx2( DEVBLK* pDEVBLK, U32  uCount,
         if (!pPTPHDRvt)
         {
             // Free the PTPHDRs
-            free( pPTPHDRx2 );
-            free( pPTPHDRx0 );
+            free_ptp_buffer( pDEVBLK, pPTPHDRx2 );
+            free_ptp_buffer( pDEVBLK, pPTPHDRx0 );
             return;
         }
         pPTPVTMre = (BYTE*)pPTPHDRvt + SIZE_HDR;
@@ -6160,7 +6398,7 @@ int   write_rrh_C108( DEVBLK* pDEVBLK, MPC_TH* pMPC_THwr, MPC_RRH* pMPC_RRHwr )
                 pPTPHDRr2 = build_C108_my_address_4( pDEVBLK );
                 if (!pPTPHDRr2)
                 {
-                    free( pPTPHDRr1 );
+                    free_ptp_buffer( pDEVBLK, pPTPHDRr1 );
                     break;
                 }
 
@@ -6222,7 +6460,7 @@ int   write_rrh_C108( DEVBLK* pDEVBLK, MPC_TH* pMPC_THwr, MPC_RRH* pMPC_RRHwr )
                 pPTPHDRr2 = build_C108_my_address_6( pDEVBLK, TRUE );  // Link local
                 if (!pPTPHDRr2)
                 {
-                    free( pPTPHDRr1 );
+                    free_ptp_buffer( pDEVBLK, pPTPHDRr1 );
                     break;
                 }
 
@@ -6230,8 +6468,8 @@ int   write_rrh_C108( DEVBLK* pDEVBLK, MPC_TH* pMPC_THwr, MPC_RRH* pMPC_RRHwr )
                 pPTPHDRr3 = build_C108_my_address_6( pDEVBLK, FALSE );
                 if (!pPTPHDRr3)
                 {
-                    free( pPTPHDRr2 );
-                    free( pPTPHDRr1 );
+                    free_ptp_buffer( pDEVBLK, pPTPHDRr2 );
+                    free_ptp_buffer( pDEVBLK, pPTPHDRr1 );
                     break;
                 }
 
@@ -6765,7 +7003,7 @@ int   write_rrh_C108( DEVBLK* pDEVBLK, MPC_TH* pMPC_THwr, MPC_RRH* pMPC_RRHwr )
         pPTPHDRr2 = build_C108_will_you_stop_4( pDEVBLK );
         if (!pPTPHDRr2)
         {
-            free( pPTPHDRr1 );
+            free_ptp_buffer( pDEVBLK, pPTPHDRr1 );
             break;
         }
 
@@ -6800,7 +7038,7 @@ int   write_rrh_C108( DEVBLK* pDEVBLK, MPC_TH* pMPC_THwr, MPC_RRH* pMPC_RRHwr )
         pPTPHDRr2 = build_C108_will_you_stop_6( pDEVBLK );
         if (!pPTPHDRr2)
         {
-            free( pPTPHDRr1 );
+            free_ptp_buffer( pDEVBLK, pPTPHDRr1 );
             break;
         }
 
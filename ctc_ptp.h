@@ -51,6 +51,31 @@
                                         // mostly by enqueue frame buffer
                                         // full delay loop...
 
+#if defined( OPTION_W32_CTCI )
+  #define PTP_READ_BATCH       (1)      // (reads are always blocking)
+#else
+  #define PTP_READ_BATCH       (64)     // Max packets read per wakeup
+#endif
+
+
+/*-------------------------------------------------------------------*/
+/* PTP buffer pool: the small buffers used for the handshaking and   */
+/* connection control messages queued on the path chains are carved  */
+/* from a single slab allocated with the PTPBLK, larger buffers are  */
+/* allocated and freed individually.                                 */
+/*-------------------------------------------------------------------*/
+#define PTP_POOL_SLAB          (32)     // Buffers in the slab
+#define PTP_POOL_AREA_LEN      (256)    // Data area of each buffer
+#define PTP_POOL_BUF_LEN       (SIZE_HDR + PTP_POOL_AREA_LEN)
+
+#define IS_PTP_SLAB_BUFFER(_pPTPBLK,_pBuf)                                 \
+        (1                                                                 \
+         && (_pPTPBLK)->pPoolSlab                                          \
+         && (BYTE*)(_pBuf) >= (_pPTPBLK)->pPoolSlab                        \
+         && (BYTE*)(_pBuf) <  (_pPTPBLK)->pPoolSlab                        \
+                              + (PTP_POOL_SLAB * PTP_POOL_BUF_LEN)         \
+        )
+
 
 /* ***************************************************************** */
 /*                                                                   */
@@ -98,6 +123,15 @@ struct  _PTPBLK
 
     LOCK        UpdateLock;                // Lock
 
+    LOCK        PoolLock;                  // Buffer pool LOCK
+    BYTE*       pPoolSlab;                 // Buffer pool slab
+    PPTPHDR     pFreePTPHDR;               // First free buffer in pool
+    int         iFreePTPHDR;               // Number of free buffers in pool
+    U64         uPoolMisses;               // Buffers allocated outside pool
+
+    BYTE*       pWriteBuffer;              // Write concatenation buffer
+    int         iWriteBufferLen;           // Write concatenation buffer size
+
     u_int       uDebugMask;                // Debug mask
     u_int       fIPv4Spec:1;               // IPv4 specified
     u_int       fIPv6Spec:1;               // IPv6 specified
@@ -250,6 +284,12 @@ struct  _PTPATH
 
     BYTE        bDLCtype;                  // DLC type
     U32         uSeqNum;                   // Sequence number
+
+    U64         uBlocks;                   // MPC blocks read or written
+    U64         uPackets;                  // IP packets read or written
+    U64         uBytes;                    // IP packet bytes read or written
+    U64         uDropped;                  // IP packets dropped
+    U64         uWakeups;                  // ptp_read wakeups (Read path)
 };
 
 #define HANDSHAKE_ONE    0x01              // Handshake one
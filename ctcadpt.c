@@ -214,6 +214,75 @@ typedef struct _CTCE_SOKPFX
 }
 CTCE_SOKPFX;
 
+// --------------------------------------------------------------------
+// CTCE Shared Memory ring replacing a send-receive socket on one host
+// --------------------------------------------------------------------
+
+#if defined( HAVE_LINUX_FUTEX_H ) && defined( SYS_futex )
+  #define CTCE_SHM                     // Shared memory rings supported
+#endif
+
+#if defined( CTCE_SHM )
+
+#define CTCE_SHM_MAGIC  ( 0x43544345 ) // "CTCE"
+#define CTCE_SHM_SIZE   ( 1024*1024 )  // Ring data size, a power of 2
+#define CTCE_SHM_SPINS  ( 2000 )       // Polls before futex waiting
+                                       // (on multi-processor hosts)
+#define CTCE_SHM_WAIT   ( 3000 )       // Reply wait time (msec)
+#define CTCE_SHM_WITHDRAWN ( 0xFFFFFFFF ) // Offer timed out (claim)
+#define CTCE_SHM_NAME   "/dev/shm/hercules-ctce-%d-%1d-%04X-%d"
+                                       // Sender lport, lcss, devnum,
+                                       // and the receiver's lport
+
+typedef struct _CTCE_SHMRING
+{
+    U32                 magic;         /* CTCE_SHM_MAGIC             */
+    U32                 size;          /* CTCE_SHM_SIZE              */
+    U32                 pid;           /* Sender's process id        */
+    U32                 rpid;          /* Receiver's process id      */
+    U32                 closed;        /* Either side closed ring    */
+    U32                 seq;           /* Offer sequence number      */
+    U32                 claim;         /* seq if accepted, or        */
+                                       /* CTCE_SHM_WITHDRAWN         */
+    BYTE                _resv1[36];    /* (cache line separation)    */
+    U32                 head;          /* Bytes written (futex)      */
+    U32                 head_waiting;  /* Receiver waits for head    */
+    BYTE                _resv2[56];    /* (cache line separation)    */
+    U32                 tail;          /* Bytes read (futex)         */
+    U32                 tail_waiting;  /* Sender waits for tail      */
+    BYTE                _resv3[56];    /* (cache line separation)    */
+    BYTE                data[ CTCE_SHM_SIZE ];
+}
+CTCE_SHMRING;
+
+static CTCE_SHMRING*  CTCE_Shm_Open(  const char*         name,
+                                      const int           create );
+
+static int      CTCE_Shm_Same_Host(   const int           fd );
+
+static void     CTCE_Shm_Shut(        CTCE_SHMRING*       ring );
+
+static int      CTCE_Shm_Write(       CTCE_SHMRING*       ring,
+                                      const int           fd,
+                                      const BYTE*         buf,
+                                      const int           len );
+
+static int      CTCE_Shm_Read(        CTCE_SHMRING*       ring,
+                                      const int           fd,
+                                      BYTE*               buf,
+                                      const int           len );
+
+static void     CTCE_Shm_Release(     DEVBLK*             dev,
+                                      CTCE_SHMRING*       ring );
+
+static U32      ctce_shm_seq = 0;      // Last ring offer sequence number
+
+#endif // defined( CTCE_SHM )
+
+static void     CTCE_Shm_Attach(      DEVBLK*             dev,
+                                      const int           fd,
+                                      const CTCE_SOKPFX*  pSokBuf );
+
 // --------------------------------------------------------------------
 // CTCE Equivalent of CTCG_PARMBLK (used to pass thread arguments)
 // --------------------------------------------------------------------
@@ -606,6 +675,22 @@ static const CTCE_FSM_CELL CTCE_Fsm[16][8] = {
 /* status information.                                                   */
 #define CTCE_HERC_ONLY          ( 0x8000 )
 #define CTCE_HERC_RECV          ( 0x8001 )
+#define CTCE_HERC_SHM           ( 0x4000 ) // Offering shared memory ring
+
+/* A shared memory ring offer is answered by a CTCE_SHMREPLY on the     */
+/* connected socket, which a side not supporting it will never send.     */
+/* The reply carries the sequence number of the offer it answers, so     */
+/* that a late reply to an offer which has already timed out is dropped. */
+#define CTCE_SHM_ACK            ( 'S' )    // Receiver mapped the ring
+#define CTCE_SHM_NAK            ( 'N' )    // Receiver keeps the socket
+
+typedef struct _CTCE_SHMREPLY
+{
+    BYTE                code;          /* CTCE_SHM_ACK or _NAK       */
+    BYTE                _resv[3];      /* (alignment)                */
+    U32                 seq;           /* Sequence number of offer   */
+}
+CTCE_SHMREPLY;
 
 
 /**********************************************************************/
@@ -1519,12 +1604,13 @@ void  CTCE_Query( DEVBLK* pDEVBLK,
 
     BEGIN_DEVICE_CLASS_QUERY( "CTCA", pDEVBLK, ppszClass, iBufLen, pBuffer );
 
-    snprintf( pBuffer, iBufLen, "CTCE %05d/%d %s%s%s %s IO[%"PRIu64"]",
+    snprintf( pBuffer, iBufLen, "CTCE %05d/%d %s%s%s %s IO[%"PRIu64"]%s",
         pDEVBLK->ctce_lport, pDEVBLK->ctce_connect_lport,
         ( pDEVBLK->ctcefd > 0           ) ? "<" : "!",
         ( pDEVBLK->ctce_contention_loser) ? "-" : "=",
         ( pDEVBLK->fd     > 0           ) ? ">" : "!",
-        filename     , pDEVBLK->excps );
+        filename     , pDEVBLK->excps,
+        ( pDEVBLK->ctce_shm_send || pDEVBLK->ctce_shm_recv ) ? " SHM" : "" );
 }
 
 // -------------------------------------------------------------------
@@ -1544,6 +1630,19 @@ int  CTCE_Close( DEVBLK* pDEVBLK )
         pDEVBLK->fd = -1;           // indicate we're now closed
     }
 
+#if defined( CTCE_SHM )
+    // A shared memory ring is closed like a socket, but the receiving
+    // one is only unmapped by the CTCE_RecvThread which is using it.
+    if ( pDEVBLK->ctce_shm_send )
+    {
+        CTCE_Shm_Release( pDEVBLK, pDEVBLK->ctce_shm_send );
+    }
+    if ( pDEVBLK->ctce_shm_recv )
+    {
+        CTCE_Shm_Shut( pDEVBLK->ctce_shm_recv );
+    }
+#endif
+
     // And the same for the receiving socket read device file
     if ( pDEVBLK->ctcefd >= 0 )
     {
@@ -1595,8 +1694,8 @@ int  CTCE_Close( DEVBLK* pDEVBLK )
 //   possible formats (noting that items between [] brackets are optional, and
 //   the items between <> brackets require actual values to be given):
 //
-//      <ldevnum>     CTCE <lport> [<rdevnum>=]<raddress>  <rport>  [[<mtu>] <sml>] [FICON]
-//      <ldevnum>[.n] CTCE <lport> [<rdevnum>]=<raddress> [<rport>] [[<mtu>] <sml>] [FICON]
+//      <ldevnum>     CTCE <lport> [<rdevnum>=]<raddress>  <rport>  [[<mtu>] <sml>] [FICON] [SHM]
+//      <ldevnum>[.n] CTCE <lport> [<rdevnum>]=<raddress> [<rport>] [[<mtu>] <sml>] [FICON] [SHM]
 //
 //   where:
 //
@@ -1615,6 +1714,8 @@ int  CTCE_Close( DEVBLK* pDEVBLK )
 //                   equal sign (=) in front of <raddress>.)
 //      FICON        optional parameter specifying a FICON Channel-to-Channel adapter
 //                   to be emulated (i.e. a FCTC instead of a CTCA)
+//      SHM          optional parameter requesting a shared memory ring instead
+//                   of TCP for the data sent, when both sides share a host
 //
 //   A sample CTCE device configuration is shown below:
 //
@@ -1689,6 +1790,22 @@ int  CTCE_Close( DEVBLK* pDEVBLK )
 //   CTCE connected Hercules instances can be hosted on any Hercules supported
 //   platform (Windows, Linux, MacOS ...).  Both sides do not need to be the same.
 //
+//   Please also note the optional trailing keyword SHM.  When two CTCE
+//   connected Hercules instances run on the same (Linux) host, each side
+//   specifying SHM offers the other side a shared memory ring for the data
+//   it sends, instead of using its send socket.  The offer is made in the
+//   initial record following the connect(), and the other side answers it
+//   on that socket with a reply carrying the offer's sequence number and
+//   whether it claimed and mapped the ring.  The rings bypass the write()
+//   and read() calls and the host TCP/IP stack for each CTC command; a
+//   futex wake-up is only needed when the receiver (or a sender finding
+//   the ring full) is actually waiting.  The TCP socket pair remains
+//   connected, as it still detects the other side going away, so that the
+//   CTCE recovery works as before.  When the other side is on another
+//   host, does not support SHM, or the ring cannot be set up, the data is
+//   sent via TCP.  SHM may be specified on one side only,
+//   in which case only the data sent by that side uses a ring.
+//
 // ---------------------------------------------------------------------
 // Execute a Channel Command Word (CTCE)
 // ---------------------------------------------------------------------
@@ -1967,10 +2084,22 @@ static int  CTCE_Init( DEVBLK *dev, int argc, char *argv[] )
     dev->fd = -1;       // For send / write to the other (y-) side
     dev->ctcefd = -1;   // For receive / read from the other (y-)side
 
-    // We begin by checking the trailing parameter for the optional keyword FICON.
+    // We begin by checking the trailing parameter for the optional keyword SHM,
+    // requesting a shared memory ring instead of TCP when both sides share a host.
+    dev->ctce_shm = ( strcasecmp( argv[argc - 1], "SHM" ) == 0 );
+    argc_updated = argc - dev->ctce_shm;
+#if !defined( CTCE_SHM )
+    if ( dev->ctce_shm )
+    {
+        WRMSG( HHC05088, "W",  // CTCE: Shared memory ring not used for %s data, using TCP: %s"
+            CTCX_DEVNUM( dev ), "any", "not supported on this host" );
+    }
+#endif
+
+    // We then check the next trailing parameter for the optional keyword FICON.
     // FCTC's support for the RCD command must be supplied via Sense ID.
-    dev->ctce_ficon = ( strcasecmp( argv[argc - 1], "FICON" ) == 0 );
-    argc_updated = argc - dev->ctce_ficon;
+    dev->ctce_ficon = ( argc_updated > 0 ) && ( strcasecmp( argv[argc_updated - 1], "FICON" ) == 0 );
+    argc_updated -= dev->ctce_ficon;
     if ( dev->ctce_ficon )
     {
         SetSIDInfo( dev, 0x3088, 0x1E, 0x0000, 0x00 );
@@ -2400,6 +2529,16 @@ static void*  CTCE_ListenThread( void* argp )
   #endif // defined( HAVEHAVE_FULL_KEEPALIVE )
 #endif // defined( HAVE_BASIC_KEEPALIVE )
 
+#if defined( CTCE_SHM )
+                            // A ring used with a previous connection stays with its RecvThread.
+                            dev->ctce_shm_recv = NULL;
+#endif
+                            // The other side may offer a shared memory ring for its data.
+                            if ( pSokBuf->ctce_herc & CTCE_HERC_SHM )
+                            {
+                                CTCE_Shm_Attach( dev, connect_fd, pSokBuf );
+                            }
+
                             // The all-important connect socket descriptor is now established.
                             dev->ctcefd = connect_fd;
 
@@ -2536,7 +2675,12 @@ static void     CTCE_Send(        DEVBLK*             pDEVBLK,
         }
     }
 
-    // Write all of this to the other (y-)side.
+    // Write all of this to the other (y-)side, via the shared memory ring if one is used.
+#if defined( CTCE_SHM )
+    if( pDEVBLK->ctce_shm_send )
+        rc = CTCE_Shm_Write( pDEVBLK->ctce_shm_send, pDEVBLK->fd, ( BYTE * ) pSokBuf, pSokBuf->SndLen );
+    else
+#endif
     rc = write_socket( pDEVBLK->fd, ( BYTE * ) pSokBuf, pSokBuf->SndLen );
 
     if( rc < 0 )
@@ -2683,6 +2827,9 @@ static void*  CTCE_RecvThread( void* argp )
     U64            ctceBytCnt = 0;               // Recvd Byte Count
     BYTE           ctce_recv_mods_UnitStat;      // UnitStat modifications
     int            i = 0;                        // temporary variable
+#if defined( CTCE_SHM )
+    CTCE_SHMRING  *pShmRing;                     // Shared memory ring if used
+#endif
 
     // When the receiver thread is (re-)started, the CTCE devblk is (re-)initialized
     obtain_lock( &pDEVBLK->lock );
@@ -2697,6 +2844,11 @@ static void*  CTCE_RecvThread( void* argp )
     // commands to be different from the one used for sending CTC commands.
     pSokBuf = ( CTCE_SOKPFX* ) ( pDEVBLK->buf + ( pDEVBLK->ctce_buf_next_write ? 0 : pDEVBLK->bufsize / 2 ) );
 
+#if defined( CTCE_SHM )
+    // The data may arrive via the shared memory ring mapped by CTCE_Shm_Attach.
+    pShmRing = pDEVBLK->ctce_shm_recv;
+#endif
+
     // CTCE DEVBLK (re-)initialisation completed.
     release_lock( &pDEVBLK->lock );
 
@@ -2710,12 +2862,25 @@ static void*  CTCE_RecvThread( void* argp )
     {
         // We read whatever the other (y-)side of the CTC has sent us,
         // which by now won't block until the complete buffer is received.
-        iLength = read_socket( pDEVBLK->ctcefd, ( BYTE * ) pSokBuf, pDEVBLK->ctceSndSml );
+#if defined( CTCE_SHM )
+        if( pShmRing )
+        {
+            iLength = CTCE_Shm_Read( pShmRing, pDEVBLK->ctcefd, ( BYTE * ) pSokBuf, pDEVBLK->ctceSndSml );
 
-        // Followed by the receiving the rest if the default SndLen was too small.
-        if( ( pDEVBLK->ctceSndSml < pSokBuf->SndLen ) && ( iLength != 0 ) )
-            iLength += read_socket( pDEVBLK->ctcefd, ( BYTE * ) pSokBuf + pDEVBLK->ctceSndSml,
-                pSokBuf->SndLen - pDEVBLK->ctceSndSml );
+            if( ( pDEVBLK->ctceSndSml < pSokBuf->SndLen ) && ( iLength != 0 ) )
+                iLength += CTCE_Shm_Read( pShmRing, pDEVBLK->ctcefd, ( BYTE * ) pSokBuf + pDEVBLK->ctceSndSml,
+                    pSokBuf->SndLen - pDEVBLK->ctceSndSml );
+        }
+        else
+#endif
+        {
+            iLength = read_socket( pDEVBLK->ctcefd, ( BYTE * ) pSokBuf, pDEVBLK->ctceSndSml );
+
+            // Followed by the receiving the rest if the default SndLen was too small.
+            if( ( pDEVBLK->ctceSndSml < pSokBuf->SndLen ) && ( iLength != 0 ) )
+                iLength += read_socket( pDEVBLK->ctcefd, ( BYTE * ) pSokBuf + pDEVBLK->ctceSndSml,
+                    pSokBuf->SndLen - pDEVBLK->ctceSndSml );
+        }
 
         // Commands sent by the other (y-)side most likely cause DEVBLK
         // changes to our (x-)side and thus need to be lock protected.
@@ -2751,6 +2916,13 @@ static void*  CTCE_RecvThread( void* argp )
                 (void) CTCE_Recovery( pDEVBLK ) ;
                 CTCE_RESTART_CCWTRACE( pDEVBLK );
             }
+#if defined( CTCE_SHM )
+            // Only this thread was still using its shared memory ring.
+            if( pShmRing )
+            {
+                CTCE_Shm_Release( pDEVBLK, pShmRing );
+            }
+#endif
             release_lock( &pDEVBLK->lock );
             return NULL;    // make compiler happy
         } // if( iLength <= 0 )
@@ -3796,6 +3968,15 @@ static int      CTCE_Write_Init( DEVBLK*                   dev,
 {
     int                 rc;                           // Return Code
     CTCE_SOKPFX*        pSokBuf;                      // The buffer to be written
+#if defined( CTCE_SHM )
+    CTCE_SHMRING*       ring = NULL;                  // Shared memory ring offered
+    char                name[64];                     // ... and its name
+    struct pollfd       pfd;                          // Awaiting the reply
+    CTCE_SHMREPLY       reply;                        // ... to our offer
+    U64                 deadline;                     // ... until this time
+    int                 wait;                         // ... msecs left
+    U32                 claim;                        // Claim if timed out
+#endif
 
     pSokBuf = (CTCE_SOKPFX*) dev->buf;
     pSokBuf->ctce_lport  = dev->ctce_lport;
@@ -3804,12 +3985,109 @@ static int      CTCE_Write_Init( DEVBLK*                   dev,
     pSokBuf->devnum      = dev->devnum;
     pSokBuf->ssid        = dev->ssid;
     pSokBuf->ctce_herc   = ( dev->ctcefd > 0 ) ? CTCE_HERC_RECV : 0 ; // 0 = we're not yet receiving
+
+#if defined( CTCE_SHM )
+    // When requested we offer the other side a shared memory ring for the
+    // data we will be sending, provided that it runs on this same host.
+    if ( dev->ctce_shm )
+    {
+        MSGBUF( name, CTCE_SHM_NAME, dev->ctce_lport,
+            SSID_TO_LCSS( dev->ssid ), dev->devnum, dev->ctce_rport );
+        if ( !CTCE_Shm_Same_Host( fd ) )
+        {
+            WRMSG( HHC05088, "I",  // CTCE: Shared memory ring not used for %s data, using TCP: %s"
+                CTCX_DEVNUM( dev ), "outbound", "other side is on another host" );
+        }
+        else if ( ( ring = CTCE_Shm_Open( name, 1 ) ) == NULL )
+        {
+            WRMSG( HHC05088, "W",  // CTCE: Shared memory ring not used for %s data, using TCP: %s"
+                CTCX_DEVNUM( dev ), "outbound", strerror( errno ) );
+        }
+        else
+        {
+            pSokBuf->ctce_herc |= CTCE_HERC_SHM;
+        }
+    }
+#endif
+
     if ( ( rc = write_socket( fd, pSokBuf, pSokBuf->SndLen ) ) == pSokBuf->SndLen )
     {
         rc = 0;
+
+#if defined( CTCE_SHM )
+        // Any ring used with a previous connection has had its day.
+        if ( dev->ctce_shm_send )
+        {
+            CTCE_Shm_Release( dev, dev->ctce_shm_send );
+        }
+
+        // The other side answers our offer once it has mapped the ring (or
+        // not); we stop waiting after a while in case it never answers.
+        // Replies to any other offer are stale and dropped.
+        if ( ring )
+        {
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            reply.code = 0;
+            deadline = host_tod() + ( (U64) CTCE_SHM_WAIT * 1000 * 16 );
+            release_lock( &dev->lock );
+            for ( ; ; )
+            {
+                wait = (int) ( ( (S64) ( deadline - host_tod() ) ) / 16000 );
+                if ( 0
+                    || wait <= 0
+                    || poll( &pfd, 1, wait ) <= 0
+                    || read_socket( fd, &reply, sizeof( reply ) ) != sizeof( reply ) )
+                {
+                    reply.code = 0;
+                    break;
+                }
+                if ( reply.seq == ring->seq )
+                    break;
+            }
+            obtain_lock( &dev->lock );
+            unlink( name );
+
+            // Having had no reply in time, we withdraw the offer, unless
+            // the other side claimed the ring just before: then the ring
+            // is in use and its late reply will be dropped as stale.
+            if ( reply.code != CTCE_SHM_ACK && reply.code != CTCE_SHM_NAK )
+            {
+                claim = 0;
+                if ( !__atomic_compare_exchange_n( &ring->claim, &claim, CTCE_SHM_WITHDRAWN,
+                                                   0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST )
+                    && claim == ring->seq )
+                {
+                    reply.code = CTCE_SHM_ACK;
+                }
+            }
+
+            if ( reply.code == CTCE_SHM_ACK )
+            {
+                dev->ctce_shm_send = ring;
+                WRMSG( HHC05087, "I",  // CTCE: Using shared memory ring for %s data :%5d %s %1d:%04X"
+                    CTCX_DEVNUM( dev ), "outbound", dev->ctce_connect_lport, "->",
+                    SSID_TO_LCSS( dev->ssid ), dev->ctce_rccuu );
+            }
+            else
+            {
+                CTCE_Shm_Release( dev, ring );
+                WRMSG( HHC05088, "W",  // CTCE: Shared memory ring not used for %s data, using TCP: %s"
+                    CTCX_DEVNUM( dev ), "outbound", ( reply.code == CTCE_SHM_NAK )
+                    ? "declined by other side" : "no reply from other side" );
+            }
+        }
+#endif
     }
     else
     {
+#if defined( CTCE_SHM )
+        if ( ring )
+        {
+            unlink( name );
+            CTCE_Shm_Release( dev, ring );
+        }
+#endif
         close_socket( fd );
         WRMSG( HHC05075, "E",  // CTCE: Initial write_socket :%d -> %1d:%04X=%s:%d ; rc=%d!=%d ; error = %s"
             CTCX_DEVNUM( dev ), dev->ctce_lport, SSID_TO_LCSS( dev->ssid ),
@@ -3821,6 +4099,393 @@ static int      CTCE_Write_Init( DEVBLK*                   dev,
 
 } // CTCE_Write_Init
 
+#if defined( CTCE_SHM )
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Same_Host
+// ---------------------------------------------------------------------
+//
+// A connected socket whose local and peer IP addresses are the same
+// connects two processes on this host, e.g. via 127.0.0.1 or via the
+// host's own address.  Only then can a shared memory ring be used.
+//
+
+static int      CTCE_Shm_Same_Host( const int fd )
+{
+    struct sockaddr_in  local, peer;                  // socket address info
+    socklen_t           locallen = sizeof( local );   // as needed for getsockname()
+    socklen_t           peerlen  = sizeof( peer );    // ... and getpeername()
+
+    return ( 1
+        && getsockname( fd, ( struct sockaddr * )&local, &locallen ) == 0
+        && getpeername( fd, ( struct sockaddr * )&peer,  &peerlen  ) == 0
+        && local.sin_family == AF_INET
+        && peer.sin_family  == AF_INET
+        && local.sin_addr.s_addr == peer.sin_addr.s_addr );
+
+} // CTCE_Shm_Same_Host
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Open
+// ---------------------------------------------------------------------
+//
+// The sending side creates (and initialises) the ring, the receiving
+// side opens the existing one.  The name is only needed until the
+// receiver has mapped the ring; the sender removes it afterwards.
+// Returns NULL with errno set when the ring cannot be used.
+//
+
+static CTCE_SHMRING*  CTCE_Shm_Open( const char* name, const int create )
+{
+    CTCE_SHMRING*  ring;                              // The mapped ring
+    struct stat    st;                                // Its file status
+    int            fd;                                // Its file descriptor
+    int            err;                               // Saved errno
+
+    if ( create )
+    {
+        // Remove any ring left over by a side that did not end normally.
+        unlink( name );
+        if ( ( fd = open( name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR ) ) < 0 )
+            return NULL;
+        if ( ftruncate( fd, sizeof( CTCE_SHMRING ) ) < 0 )
+        {
+            err = errno;
+            close( fd );
+            unlink( name );
+            errno = err;
+            return NULL;
+        }
+    }
+    else
+    {
+        if ( ( fd = open( name, O_RDWR ) ) < 0 )
+            return NULL;
+        if ( fstat( fd, &st ) < 0 || st.st_size != sizeof( CTCE_SHMRING ) )
+        {
+            close( fd );
+            errno = EINVAL;
+            return NULL;
+        }
+    }
+
+    ring = mmap( NULL, sizeof( CTCE_SHMRING ), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    err = errno;
+    close( fd );
+    if ( ring == MAP_FAILED )
+    {
+        if ( create )
+            unlink( name );
+        errno = err;
+        return NULL;
+    }
+
+    // A new ring is zeroed by ftruncate; the magic number is set last.
+    if ( create )
+    {
+        ring->size = CTCE_SHM_SIZE;
+        ring->pid  = getpid();
+        do ring->seq = __atomic_add_fetch( &ctce_shm_seq, 1, __ATOMIC_SEQ_CST );
+        while ( ring->seq == 0 || ring->seq == CTCE_SHM_WITHDRAWN );
+        __atomic_store_n( &ring->magic, CTCE_SHM_MAGIC, __ATOMIC_SEQ_CST );
+    }
+    else if ( 0
+        || __atomic_load_n( &ring->magic, __ATOMIC_SEQ_CST ) != CTCE_SHM_MAGIC
+        || ring->size != CTCE_SHM_SIZE
+        || ring->closed )
+    {
+        munmap( ring, sizeof( CTCE_SHMRING ) );
+        errno = EINVAL;
+        return NULL;
+    }
+    else
+    {
+        ring->rpid = getpid();
+    }
+    return ring;
+
+} // CTCE_Shm_Open
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Shut
+// ---------------------------------------------------------------------
+//
+// Marking a ring closed is the equivalent of a socket shutdown: it
+// makes the reader see end-of-file once all data has been read, and
+// the writer fail.  A waiter which misses the futex wake-up notices
+// the closure at its next timeout.
+//
+
+static void     CTCE_Shm_Shut( CTCE_SHMRING* ring )
+{
+    __atomic_store_n( &ring->closed, 1, __ATOMIC_SEQ_CST );
+    syscall( SYS_futex, &ring->head, FUTEX_WAKE, INT_MAX, NULL, NULL, 0 );
+    syscall( SYS_futex, &ring->tail, FUTEX_WAKE, INT_MAX, NULL, NULL, 0 );
+
+} // CTCE_Shm_Shut
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Release
+// ---------------------------------------------------------------------
+
+static void     CTCE_Shm_Release( DEVBLK* dev, CTCE_SHMRING* ring )
+{
+    if ( dev->ctce_shm_send == ring )
+        dev->ctce_shm_send = NULL;
+    if ( dev->ctce_shm_recv == ring )
+        dev->ctce_shm_recv = NULL;
+    CTCE_Shm_Shut( ring );
+    munmap( ring, sizeof( CTCE_SHMRING ) );
+
+} // CTCE_Shm_Release
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Wait
+// ---------------------------------------------------------------------
+//
+// Wait for the other side to move the futex word *pWord away from val,
+// with the *pWaiting flag announcing us.  A one second timeout is used
+// to check whether the other side is still there: its socket is no
+// longer written to, except for a late reply to our ring offer, which
+// is dropped; otherwise its becoming readable means end-of-file or an
+// error.  Returns -1 if the ring was closed or the other side went away.
+//
+
+static int      CTCE_Shm_Wait( CTCE_SHMRING* ring, U32* pWord, U32 val,
+                               U32* pWaiting, U32 other_pid, const int fd )
+{
+    struct timespec  ts = { 1, 0 };                   // Liveness check interval
+    struct pollfd    pfd;                             // Socket of the other side
+    CTCE_SHMREPLY    stale;                           // Late offer reply
+    int              rc = 0;                          // Return code
+
+    __atomic_store_n( pWaiting, 1, __ATOMIC_SEQ_CST );
+    if ( 1
+        && __atomic_load_n( pWord, __ATOMIC_SEQ_CST ) == val
+        && !__atomic_load_n( &ring->closed, __ATOMIC_SEQ_CST )
+        && syscall( SYS_futex, pWord, FUTEX_WAIT, val, &ts, NULL, 0 ) < 0
+        && errno == ETIMEDOUT )
+    {
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if ( ( rc = ( fd < 0 ) ? -1 : poll( &pfd, 1, 0 ) ) > 0 )
+        {
+            rc = ( pfd.revents == POLLIN
+                && recv( fd, (void*) &stale, sizeof( stale ), MSG_DONTWAIT ) > 0 )
+                ? 0 : -1;
+        }
+        if ( 0
+            || rc != 0
+            || ( other_pid && kill( other_pid, 0 ) < 0 && errno == ESRCH ) )
+        {
+            rc = -1;
+        }
+    }
+    __atomic_store_n( pWaiting, 0, __ATOMIC_SEQ_CST );
+    return ( rc < 0 || __atomic_load_n( &ring->closed, __ATOMIC_SEQ_CST ) ) ? -1 : 0;
+
+} // CTCE_Shm_Wait
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Write
+// ---------------------------------------------------------------------
+//
+// The counterpart of write_socket() for a shared memory ring, which is
+// written as a byte stream: returns len, or -1 with errno EPIPE when
+// the ring was closed or the other side went away.
+//
+
+static int      CTCE_Shm_Write( CTCE_SHMRING* ring, const int fd,
+                                const BYTE* buf, const int len )
+{
+    U32     head = ring->head;                        // We are the only writer
+    U32     tail;                                     // Receiver's read position
+    U32     n, off, chunk;                            // Copy lengths and offset
+    int     done = 0;                                 // Bytes written so far
+    int     spins = 0;                                // Polls of a full ring
+    int     maxspins = ( hostinfo.num_procs > 1 ) ? CTCE_SHM_SPINS : 1;
+
+    while ( done < len )
+    {
+        if ( __atomic_load_n( &ring->closed, __ATOMIC_SEQ_CST ) )
+        {
+            errno = EPIPE;
+            return -1;
+        }
+
+        // Wait while the ring is full, polling briefly before sleeping.
+        tail = __atomic_load_n( &ring->tail, __ATOMIC_ACQUIRE );
+        if ( ( n = CTCE_SHM_SIZE - ( head - tail ) ) == 0 )
+        {
+            if ( ++spins >= maxspins )
+            {
+                if ( CTCE_Shm_Wait( ring, &ring->tail, tail, &ring->tail_waiting,
+                                    ring->rpid, fd ) < 0 )
+                {
+                    errno = EPIPE;
+                    return -1;
+                }
+                spins = 0;
+            }
+            continue;
+        }
+        spins = 0;
+
+        // Copy what fits, possibly wrapping around the end of the ring.
+        n = MIN( n, (U32)( len - done ) );
+        off = head & ( CTCE_SHM_SIZE - 1 );
+        chunk = MIN( n, CTCE_SHM_SIZE - off );
+        memcpy( ring->data + off, buf + done, chunk );
+        memcpy( ring->data, buf + done + chunk, n - chunk );
+        head += n;
+        done += n;
+
+        // Publish it, and wake the receiver only when it is waiting.
+        __atomic_store_n( &ring->head, head, __ATOMIC_SEQ_CST );
+        if ( __atomic_exchange_n( &ring->head_waiting, 0, __ATOMIC_SEQ_CST ) )
+            syscall( SYS_futex, &ring->head, FUTEX_WAKE, 1, NULL, NULL, 0 );
+    }
+    return len;
+
+} // CTCE_Shm_Write
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Read
+// ---------------------------------------------------------------------
+//
+// The counterpart of read_socket() for a shared memory ring: returns
+// len, or less (i.e. 0 at a packet boundary) once the ring is closed
+// or the other side went away, just like end-of-file on a socket.
+//
+
+static int      CTCE_Shm_Read( CTCE_SHMRING* ring, const int fd,
+                               BYTE* buf, const int len )
+{
+    U32     tail = ring->tail;                        // We are the only reader
+    U32     head;                                     // Sender's write position
+    U32     n, off, chunk;                            // Copy lengths and offset
+    int     done = 0;                                 // Bytes read so far
+    int     spins = 0;                                // Polls of an empty ring
+    int     maxspins = ( hostinfo.num_procs > 1 ) ? CTCE_SHM_SPINS : 1;
+
+    while ( done < len )
+    {
+        // Wait while the ring is empty, polling briefly before sleeping.
+        head = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE );
+        if ( ( n = head - tail ) == 0 )
+        {
+            if ( __atomic_load_n( &ring->closed, __ATOMIC_SEQ_CST ) )
+                break;
+            if ( ++spins >= maxspins )
+            {
+                if ( CTCE_Shm_Wait( ring, &ring->head, head, &ring->head_waiting,
+                                    ring->pid, fd ) < 0
+                    && __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE ) == head )
+                    break;
+                spins = 0;
+            }
+            continue;
+        }
+        spins = 0;
+
+        // Copy what is needed, possibly wrapping around the end of the ring.
+        n = MIN( n, (U32)( len - done ) );
+        off = tail & ( CTCE_SHM_SIZE - 1 );
+        chunk = MIN( n, CTCE_SHM_SIZE - off );
+        memcpy( buf + done, ring->data + off, chunk );
+        memcpy( buf + done + chunk, ring->data, n - chunk );
+        tail += n;
+        done += n;
+
+        // Free the space, and wake the sender only when it is waiting.
+        __atomic_store_n( &ring->tail, tail, __ATOMIC_SEQ_CST );
+        if ( __atomic_exchange_n( &ring->tail_waiting, 0, __ATOMIC_SEQ_CST ) )
+            syscall( SYS_futex, &ring->tail, FUTEX_WAKE, 1, NULL, NULL, 0 );
+    }
+    return done;
+
+} // CTCE_Shm_Read
+
+#endif // defined( CTCE_SHM )
+
+// ---------------------------------------------------------------------
+// CTCE_Shm_Attach
+// ---------------------------------------------------------------------
+//
+// Called by the CTCE_ListenThread when the initial record received
+// offers a shared memory ring for the data the other side will send.
+// We claim and map it if we can, and always answer the offer with a
+// CTCE_SHMREPLY: CTCE_SHM_ACK or CTCE_SHM_NAK and the offer's sequence
+// number, so that the other side can drop a reply it no longer awaits.
+//
+
+static void     CTCE_Shm_Attach( DEVBLK* dev, const int fd, const CTCE_SOKPFX* pSokBuf )
+{
+    CTCE_SHMREPLY       reply;                        // Our answer to the offer
+#if defined( CTCE_SHM )
+    CTCE_SHMRING*       ring = NULL;                  // The offered ring
+    char                name[64];                     // ... and its name
+    const char*         why;                          // Reason for not using it
+    U32                 claim = 0;                    // Unclaimed ring
+#endif
+
+    memset( &reply, 0, sizeof( reply ) );
+    reply.code = CTCE_SHM_NAK;
+#if defined( CTCE_SHM )
+
+    if ( !CTCE_Shm_Same_Host( fd ) )
+    {
+        why = "other side is on another host";
+    }
+    else
+    {
+        MSGBUF( name, CTCE_SHM_NAME, pSokBuf->ctce_lport,
+            SSID_TO_LCSS( pSokBuf->ssid ), pSokBuf->devnum, dev->ctce_lport );
+        ring = CTCE_Shm_Open( name, 0 );
+        why = strerror( errno );
+    }
+
+    // We may only use the ring if the other side is still waiting for our
+    // reply; once it has timed out it has withdrawn the offer.
+    if ( ring )
+    {
+        reply.seq = ring->seq;
+        if ( !__atomic_compare_exchange_n( &ring->claim, &claim, ring->seq,
+                                           0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) )
+        {
+            munmap( ring, sizeof( CTCE_SHMRING ) );
+            ring = NULL;
+            why = "offer withdrawn by other side";
+        }
+    }
+    if ( ring )
+    {
+        dev->ctce_shm_recv = ring;
+        reply.code = CTCE_SHM_ACK;
+        WRMSG( HHC05087, "I",  // CTCE: Using shared memory ring for %s data :%5d %s %1d:%04X"
+            CTCX_DEVNUM( dev ), "inbound", dev->ctce_lport, "<-", CTCE_DEVNUM( pSokBuf ) );
+    }
+    else
+    {
+        WRMSG( HHC05088, "W",  // CTCE: Shared memory ring not used for %s data, using TCP: %s"
+            CTCX_DEVNUM( dev ), "inbound", why );
+    }
+#else
+    UNREFERENCED( dev );
+    UNREFERENCED( pSokBuf );
+#endif
+
+    // Without a reply the other side would keep on waiting for a while.
+#if defined( CTCE_SHM )
+    if ( write_socket( fd, &reply, sizeof( reply ) ) != sizeof( reply ) && ring )
+        CTCE_Shm_Release( dev, ring );
+#else
+    (void) write_socket( fd, &reply, sizeof( reply ) );
+#endif
+
+} // CTCE_Shm_Attach
+
 // ---------------------------------------------------------------------
 // CTCE_Recovery
 // ---------------------------------------------------------------------
@@ -54,10 +54,12 @@ typedef uint8_t  MAC[ IFHWADDRLEN ];    // Data Type for MAC Addresses
 // --------------------------------------------------------------------
 
 #define LCS_MAX_PORTS   4   // Maximum support ports per LCS device
+#define LCS_MAX_QUEUES  8   // Maximum TAP queues (read threads) per port
 
 struct  _LCSBLK;            // Common Storage for LCS Emulation
 struct  _LCSDEV;            // LCS Device
 struct  _LCSPORT;           // LCS Port (or Relative Adapter)
+struct  _LCSPORTQ;          // LCS Port TAP queue
 struct  _LCSRTE;            // LCS Routing Entries
 struct  _LCSHDR;            // LCS Frame Header
 struct  _LCSCMDHDR;         // LCS Command Frame Header
@@ -80,6 +82,7 @@ struct  _LCSCONN;           // LCS SNA Connection
 typedef struct  _LCSBLK     LCSBLK,     *PLCSBLK;
 typedef struct  _LCSDEV     LCSDEV,     *PLCSDEV;
 typedef struct  _LCSPORT    LCSPORT,    *PLCSPORT;
+typedef struct  _LCSPORTQ   LCSPORTQ,   *PLCSPORTQ;
 typedef struct  _LCSRTE     LCSRTE,     *PLCSRTE;
 typedef struct  _LCSHDR     LCSHDR,     *PLCSHDR;
 typedef struct  _LCSCMDHDR  LCSCMDHDR,  *PLCSCMDHDR;
@@ -633,6 +636,7 @@ struct _LCSIBH                         // LCS SNA Inbound Buffer Header
     PLCSIBH   pNextLCSIBH;             // Pointer to next LCSIBH
     int       iAreaLen;                // Data area length
     int       iDataLen;                // Data length
+    int       iBuffLen;                // Allocated data area length
     BYTE      bData[FLEXIBLE_ARRAY];   //
 } ATTRIBUTE_PACKED;
 
@@ -724,6 +728,14 @@ struct  _LCSDEV
     PLCSIBH     pFirstLCSIBH;           // SNA First LCSIBH in chain
     PLCSIBH     pLastLCSIBH;            // SNA Last LCSIBH in chain
 
+    LOCK        LCSIBHPoolLock;         // SNA LCSIBH free pool LOCK
+    PLCSIBH     pFreeLCSIBH;            // SNA First LCSIBH in free pool
+    int         iFreeLCSIBH;            // SNA Number of LCSIBHs in free pool
+
+#define LCSIBH_POOL_SIZE     2048       // Data area length of pooled LCSIBHs
+#define LCSIBH_POOL_INIT     16         // Pooled LCSIBHs preallocated
+#define LCSIBH_POOL_MAX      64         // Maximum LCSIBHs kept in free pool
+
     LOCK        LCSCONNChainLock;       // SNA LCSCONN Chain LOCK
     PLCSCONN    pFirstLCSCONN;          // SNA First LCSCONN in chain
 
@@ -751,6 +763,21 @@ struct  _LCSDEV
 #define  WCTL  0x17          // Write Control
 #define  SCB   0x14          // Sense Command Byte
 
+// --------------------------------------------------------------------
+// LCS Port TAP queue                           (host byte order)
+// --------------------------------------------------------------------
+// Each queue of a multi-queue TAP interface has its own fd and its own
+// read thread. Queue 0 is the port's own fd (pLCSPORT->fd), which is
+// also the one used for writing frames to the interface.
+
+struct  _LCSPORTQ
+{
+    PLCSPORT    pLCSPORT;                 // -> LCS Port
+    int         iQueue;                   // Queue number
+    int         fd;                       // TUN/TAP fd (queues 1-n only)
+    TID         tid;                      // Read Thread ID
+};
+
 // --------------------------------------------------------------------
 // LCS Port (or Relative Adapter)               (host byte order)
 // --------------------------------------------------------------------
@@ -785,6 +812,8 @@ struct  _LCSPORT
     TID         tid;                      // Read Thread ID
     pid_t       pid;                      // Read Thread pid
     int         icDevices;                // Device count
+    int         nQueues;                  // Number of TAP queues
+    LCSPORTQ    Queue[LCS_MAX_QUEUES];    // TAP queues
     char        szNetIfName[IFNAMSIZ];    // Network Interface Name (e.g. tap0)
     char        szMACAddress[32];         // MAC Address
     char        szGWAddress[32];          // Gateway for W32
@@ -853,6 +882,7 @@ struct  _LCSBLK
 #define LCS_DISC_TRACE_ZERO    0
 #define LCS_DISC_TRACE_MINIMUM 16
 #define LCS_DISC_TRACE_MAXIMUM 65535
+    int         iQueues;                  // TAP queues per port
 
     LOCK        AttnLock;                 // Attention LOCK
     PLCSATTN    pAttns;                   // -> Attention chain
@@ -357,6 +357,7 @@ inline BYTE* ARCH_DEP( maddr_l )
                             regs->dat.storkey = regs->tlb.storkey[ tlbix ];
 
                         maddr = MAINADDR( regs->tlb.main[tlbix], addr );
+                        EMU_STAT( regs, tlbhit );
                     }
                 }
             }
@@ -367,7 +368,12 @@ inline BYTE* ARCH_DEP( maddr_l )
     /* TLB miss: do full address translation */
     /*---------------------------------------*/
     if (!maddr)
+    {
+        /* (real and special space accesses never use the TLB) */
+        if (aea_crn)
+            EMU_STAT( regs, tlbmiss );
         maddr = ARCH_DEP( logical_to_main_l )( addr, arn, regs, acctype, akey, len );
+    }
 
 #if defined( FEATURE_073_TRANSACT_EXEC_FACILITY )
     if (FACILITY_ENABLED( 073_TRANSACT_EXEC, regs ))
@@ -45,6 +45,193 @@
 #define MAX_DECIMAL_LENGTH      16
 #define MAX_DECIMAL_DIGITS      (((MAX_DECIMAL_LENGTH)*2)-1)
 
+/*-------------------------------------------------------------------*/
+/* Binary packed decimal engine                                      */
+/*                                                                   */
+/* Where the host compiler provides a 128 bit integer type, packed   */
+/* decimal operands (at most 31 digits, which is less than 2**103)   */
+/* are converted to binary, the arithmetic is performed by the host  */
+/* integer instructions, and the result is converted back to packed  */
+/* decimal.  The conversions check and combine all the digits held   */
+/* in a doubleword at once (SIMD within a register) rather than one  */
+/* digit per loop iteration.  #define DECIMAL_NO_BINARY to always     */
+/* use the decimal digit string routines.                            */
+/*-------------------------------------------------------------------*/
+#if defined(HAVE___INT128_T) && !defined(DECIMAL_NO_BINARY)
+
+#define DECIMAL_BINARY                  /* Binary engine used        */
+typedef __uint128_t U128_T;
+
+#define DEC_E15     1000000000000000ULL
+#define DEC_E19     ((U128_T) 10000000000000000000ULL)
+
+/* Powers of ten from 10**0 to 10**31 */
+static const U128_T dec_pow10[ MAX_DECIMAL_DIGITS + 1 ] =
+{
+    1ULL,                   10ULL,
+    100ULL,                 1000ULL,
+    10000ULL,               100000ULL,
+    1000000ULL,             10000000ULL,
+    100000000ULL,           1000000000ULL,
+    10000000000ULL,         100000000000ULL,
+    1000000000000ULL,       10000000000000ULL,
+    100000000000000ULL,     1000000000000000ULL,
+    10000000000000000ULL,   100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+    DEC_E19 * 10ULL,        DEC_E19 * 100ULL,
+    DEC_E19 * 1000ULL,      DEC_E19 * 10000ULL,
+    DEC_E19 * 100000ULL,    DEC_E19 * 1000000ULL,
+    DEC_E19 * 10000000ULL,  DEC_E19 * 100000000ULL,
+    DEC_E19 * 1000000000ULL,
+    DEC_E19 * 10000000000ULL,
+    DEC_E19 * 100000000000ULL,
+    DEC_E19 * 1000000000000ULL,
+};
+
+/* Binary values 0-99 as two packed decimal digits */
+#define DEC_BCD_ROW( t )  0x##t##0, 0x##t##1, 0x##t##2, 0x##t##3, \
+                          0x##t##4, 0x##t##5, 0x##t##6, 0x##t##7, \
+                          0x##t##8, 0x##t##9
+static const BYTE dec_bin2bcd[ 100 ] =
+{
+    DEC_BCD_ROW( 0 ), DEC_BCD_ROW( 1 ), DEC_BCD_ROW( 2 ),
+    DEC_BCD_ROW( 3 ), DEC_BCD_ROW( 4 ), DEC_BCD_ROW( 5 ),
+    DEC_BCD_ROW( 6 ), DEC_BCD_ROW( 7 ), DEC_BCD_ROW( 8 ),
+    DEC_BCD_ROW( 9 )
+};
+
+/*-------------------------------------------------------------------*/
+/* Test sixteen packed decimal digits for validity                   */
+/* A digit is invalid if bit 0 and either bit 1 or bit 2 is one.     */
+/* Returns nonzero if any of the digits is invalid                   */
+/*-------------------------------------------------------------------*/
+static INLINE U64 dec_bad_digits( U64 x )
+{
+    return (x >> 3) & ((x >> 2) | (x >> 1)) & 0x1111111111111111ULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert sixteen packed decimal digits to binary                   */
+/* Each step combines adjacent lanes of twice the previous width:    */
+/* digit pairs to bytes, bytes to halfwords, halfwords to words.     */
+/*-------------------------------------------------------------------*/
+static INLINE U64 dec_bcd_to_bin( U64 x )
+{
+    x = ((x >>  4) & 0x0F0F0F0F0F0F0F0FULL) * 10
+      +  (x        & 0x0F0F0F0F0F0F0F0FULL);
+    x = ((x >>  8) & 0x00FF00FF00FF00FFULL) * 100
+      +  (x        & 0x00FF00FF00FF00FFULL);
+    x = ((x >> 16) & 0x0000FFFF0000FFFFULL) * 10000
+      +  (x        & 0x0000FFFF0000FFFFULL);
+    return (x >> 32) * 100000000 + (x & 0xFFFFFFFF);
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert a binary value less than 10**16 to packed decimal digits  */
+/*-------------------------------------------------------------------*/
+static INLINE U64 dec_bin_to_bcd( U64 v )
+{
+U64     x;                              /* Packed decimal digits     */
+int     s;                              /* Shift for next digit pair */
+
+    for (x = 0, s = 0; v; s += 8, v /= 100)
+        x |= (U64) dec_bin2bcd[ v % 100 ] << s;
+    return x;
+}
+
+/*-------------------------------------------------------------------*/
+/* Number of significant decimal digits in a binary value            */
+/*-------------------------------------------------------------------*/
+static INLINE int dec_digits( U128_T v )
+{
+int     n;                              /* Approximate digit count   */
+
+    if (!v)
+        return 0;
+
+    /* Number of significant bits times log10(2) is at most one
+       less than the number of decimal digits */
+    n = (v >> 64) ? 128 - __builtin_clzll( (U64)(v >> 64) )
+                  :  64 - __builtin_clzll( (U64) v );
+    n = (n * 1233) >> 12;
+    return n + (v >= dec_pow10[n]);
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert a 16-byte packed decimal work area to binary              */
+/*                                                                   */
+/* Input:                                                            */
+/*      pack    16-byte work area, the packed decimal number right   */
+/*              aligned and padded to the left with zero digits      */
+/* Output:                                                           */
+/*      result  Absolute value of the number                         */
+/*      sign    -1 if the sign is negative, or +1 if positive        */
+/* Value:                                                            */
+/*              2 if a digit is invalid, plus 1 if the sign is       */
+/*              invalid, or 0 if the number is valid                 */
+/*-------------------------------------------------------------------*/
+static INLINE int dec_unpack( const BYTE *pack, U128_T *result,
+                        int *sign )
+{
+U64     hi;                             /* Digits 1-16               */
+U64     lo;                             /* Digits 17-31 and sign     */
+int     s;                              /* Sign code                 */
+
+    hi = fetch_dw( pack );
+    lo = fetch_dw( pack + 8 );
+    s  = lo & 0x0F;
+    lo >>= 4;
+
+    *sign = (s == 0x0B || s == 0x0D) ? -1 : 1;
+
+    if (hi)
+        *result = (U128_T) dec_bcd_to_bin( hi ) * DEC_E15
+                + dec_bcd_to_bin( lo );
+    else
+        *result = dec_bcd_to_bin( lo );
+
+    return ((dec_bad_digits( hi ) | dec_bad_digits( lo )) ? 2 : 0)
+         | (s < 0x0A);
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert a binary value to a 16-byte packed decimal work area      */
+/*                                                                   */
+/* Input:                                                            */
+/*      value   Absolute value; only its rightmost 31 decimal        */
+/*              digits are converted                                 */
+/*      sign    -1 if a negative sign is to be stored, or +1 if a    */
+/*              positive sign is to be stored                        */
+/* Output:                                                           */
+/*      pack    16-byte work area receiving the packed decimal       */
+/*              number with a preferred sign code                    */
+/*-------------------------------------------------------------------*/
+static INLINE void dec_pack( U128_T value, int sign, BYTE *pack )
+{
+U64     hi;                             /* Digits 1-16               */
+U64     lo;                             /* Digits 17-31              */
+
+    if (value >= dec_pow10[ MAX_DECIMAL_DIGITS ])
+        value %= dec_pow10[ MAX_DECIMAL_DIGITS ];
+
+    if (!(value >> 64))
+    {
+        hi = (U64) value / DEC_E15;
+        lo = (U64) value % DEC_E15;
+    }
+    else
+    {
+        hi = (U64)(value / DEC_E15);
+        lo = (U64)(value % DEC_E15);
+    }
+
+    store_dw( pack,      dec_bin_to_bcd( hi ) );
+    store_dw( pack + 8, (dec_bin_to_bcd( lo ) << 4)
+                       | (sign < 0 ? 0x0D : 0x0C) );
+}
+
+#endif /* defined(HAVE___INT128_T) && !defined(DECIMAL_NO_BINARY) */
+
 /*-------------------------------------------------------------------*/
 /* Convert packed decimal number to binary                           */
 /*                                                                   */
@@ -72,6 +259,35 @@
 /*              invalid digits or sign were detected, else 0.        */
 /*              The result field is not set if the dxf is set to 1.  */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+void packed_to_binary (BYTE *dec, int len, U64 *result,
+                        int *ovf, int *dxf)
+{
+BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
+U128_T  value;                          /* Absolute value            */
+int     sign;                           /* Sign of operand           */
+
+    /* Convert right aligned copy of the operand */
+    memset( pack, 0, sizeof(pack) );
+    memcpy( pack + sizeof(pack) - len - 1, dec, len + 1 );
+
+    *ovf = 0;
+    *dxf = dec_unpack( pack, &value, &sign ) ? 1 : 0;
+    if (*dxf)
+        return;
+
+    /* Overflow if less than max negative or greater than max
+       positive; the result is then the rightmost 64 bits */
+    if (value > (sign < 0 ? 0x8000000000000000ULL
+                          : 0x7FFFFFFFFFFFFFFFULL))
+        *ovf = 1;
+    else if (sign < 0)
+        value = -value;
+
+    *result = (U64) value;
+
+} /* end function packed_to_binary */
+#else
 void packed_to_binary (BYTE *dec, int len, U64 *result,
                         int *ovf, int *dxf)
 {
@@ -188,6 +404,7 @@ U64     neg_u64max = 9223372036854775808ULL;  // (LLONG_MIN)
     *result = dreg;
 
 } /* end function packed_to_binary */
+#endif /*defined(DECIMAL_BINARY)*/
 
 /*-------------------------------------------------------------------*/
 /* Convert binary number to packed decimal                           */
@@ -211,6 +428,17 @@ U64     neg_u64max = 9223372036854775808ULL;  // (LLONG_MIN)
 /*      result  Points to a 16-byte field which will receive the     */
 /*              result as a packed decimal number (31 digits + sign) */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+void binary_to_packed (S64 bin, BYTE *result)
+{
+    /* Convert absolute value, including that of max negative */
+    if (bin < 0)
+        dec_pack( -(U64) bin, -1, result );
+    else
+        dec_pack(  (U64) bin, +1, result );
+
+} /* end function(binary_to_packed) */
+#else
 void binary_to_packed (S64 bin, BYTE *result)
 {
 int     i;                              /* Array subscript           */
@@ -253,7 +481,9 @@ int     d;                              /* Decimal digit or sign     */
     }
 
 } /* end function(binary_to_packed) */
+#endif /*defined(DECIMAL_BINARY)*/
 
+#if !defined(DECIMAL_BINARY)
 /*-------------------------------------------------------------------*/
 /* Add two decimal byte strings as unsigned decimal numbers          */
 /*                                                                   */
@@ -560,9 +790,85 @@ int     temp3, temp4, temp5, qtest;     /* Work areas for algorithm  */
     } /* end for(index2) */
 
 } /* end function divide_decimal */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 #endif /*!defined(_DECIMAL_C)*/
 
+#if defined(DECIMAL_BINARY)
+/*-------------------------------------------------------------------*/
+/* Load a packed decimal storage operand as a binary integer         */
+/*                                                                   */
+/* Input:                                                            */
+/*      addr    Logical address of packed decimal storage operand    */
+/*      len     Length minus one of storage operand (range 0-15)     */
+/*      arn     Access register number associated with operand       */
+/*      regs    CPU register context                                 */
+/* Output:                                                           */
+/*      result  Points to a 128 bit field to receive the absolute    */
+/*              value of the operand.                                */
+/*      sign    Points to an integer which will be set to -1 if a    */
+/*              negative sign was loaded from the operand, or +1 if  */
+/*              a positive sign was loaded from the operand.         */
+/*                                                                   */
+/*      A program check may be generated if the logical address      */
+/*      causes an addressing, translation, or fetch protection       */
+/*      exception, or if the operand causes a data exception         */
+/*      because of invalid decimal digits or sign.                   */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP(load_packed) (VADR addr, int len, int arn, REGS *regs,
+                        U128_T *result, int *sign)
+{
+BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
+
+    /* Fetch the packed decimal operand into work area */
+    memset( pack, 0, sizeof(pack) );
+    ARCH_DEP(vfetchc) (pack+sizeof(pack)-len-1, len, addr, arn, regs);
+
+    /* Convert to binary, checking for valid digits and sign */
+    if (dec_unpack( pack, result, sign ))
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+    }
+
+} /* end function ARCH_DEP(load_packed) */
+
+/*-------------------------------------------------------------------*/
+/* Store binary integer into packed decimal storage operand          */
+/*                                                                   */
+/* Input:                                                            */
+/*      addr    Logical address of packed decimal storage operand    */
+/*      len     Length minus one of storage operand (range 0-15)     */
+/*      arn     Access register number associated with operand       */
+/*      regs    CPU register context                                 */
+/*      value   Absolute value to be stored.  Digits which do not    */
+/*              fit in the operand are lost.                         */
+/*      sign    -1 if a negative sign is to be stored, or +1 if a    */
+/*              positive sign is to be stored.                       */
+/*                                                                   */
+/*      A program check may be generated if the logical address      */
+/*      causes an addressing, translation, or protection exception.  */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP(store_packed) (VADR addr, int len, int arn, REGS *regs,
+                        U128_T value, int sign)
+{
+BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
+
+    /* if operand crosses page, make sure both pages are accessible */
+    if((addr & PAGEFRAME_PAGEMASK) !=
+        ((addr + len) & PAGEFRAME_PAGEMASK))
+        ARCH_DEP(validate_operand) (addr, arn, len, ACCTYPE_WRITE_SKP, regs);
+
+    /* Convert value and sign to packed decimal */
+    dec_pack( value, sign, pack );
+
+    /* Store the result at the operand location */
+    ARCH_DEP(vstorec) (pack+sizeof(pack)-len-1, len, addr, arn, regs);
+
+} /* end function ARCH_DEP(store_packed) */
+
+#else /*!defined(DECIMAL_BINARY)*/
+
 /*-------------------------------------------------------------------*/
 /* Load a packed decimal storage operand into a decimal byte string  */
 /*                                                                   */
@@ -688,11 +994,71 @@ BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
     ARCH_DEP(vstorec) (pack+sizeof(pack)-len-1, len, addr, arn, regs);
 
 } /* end function ARCH_DEP(store_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 /*-------------------------------------------------------------------*/
 /* FA   AP    - Add Decimal                                   [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(add_decimal)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+int     cc;                             /* Condition code            */
+U128_T  v1, v2, v3;                     /* Operand & result values   */
+int     sign1, sign2, sign3;            /* Sign of operands & result */
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Load operands */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v1, &sign1);
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v2, &sign2);
+
+    /* Add or subtract operand values */
+    if (sign1 == sign2)
+    {
+        v3 = v1 + v2;
+        sign3 = sign1;
+    }
+    else if (v1 >= v2)
+    {
+        v3 = v1 - v2;
+        sign3 = sign1;
+    }
+    else
+    {
+        v3 = v2 - v1;
+        sign3 = sign2;
+    }
+
+    /* Set condition code */
+    cc = (v3 == 0) ? 0 : (sign3 < 1) ? 1 : 2;
+
+    /* Overflow if result exceeds first operand length */
+    if (v3 >= dec_pow10[ (l1+1) * 2 - 1 ])
+        cc = 3;
+
+    /* Set positive sign if result is zero */
+    if (v3 == 0)
+        sign3 = 1;
+
+    /* Store result into first operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, v3, sign3);
+
+    /* Set condition code */
+    regs->psw.cc = cc;
+
+    /* Program check if overflow and PSW program mask is set */
+    if (cc == 3 && DOMASK(&regs->psw))
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
+
+} /* end DEF_INST(add_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(add_decimal)
 {
 int     l1, l2;                         /* Length values             */
@@ -764,11 +1130,46 @@ int     sign1, sign2, sign3;            /* Sign of operands & result */
         ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
 
 } /* end DEF_INST(add_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 /*-------------------------------------------------------------------*/
 /* F9   CP    - Compare Decimal                               [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(compare_decimal)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+U128_T  v1, v2;                         /* Operand values            */
+int     sign1, sign2;                   /* Sign of each operand      */
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Load operands */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v1, &sign1);
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v2, &sign2);
+
+    /* Result is equal if both operands are zero */
+    if (v1 == 0 && v2 == 0)
+        regs->psw.cc = 0;
+
+    /* Result is low or high if the signs are different */
+    else if (sign1 != sign2)
+        regs->psw.cc = (sign1 < 0) ? 1 : 2;
+
+    /* If signs are equal then compare the values */
+    else if (v1 != v2)
+        regs->psw.cc = ((v1 < v2) == (sign1 > 0)) ? 1 : 2;
+    else
+        regs->psw.cc = 0;
+
+} /* end DEF_INST(compare_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(compare_decimal)
 {
 int     l1, l2;                         /* Length values             */
@@ -823,11 +1224,80 @@ int     rc;                             /* Return code               */
             regs->psw.cc = 0;
 
 } /* end DEF_INST(compare_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 /*-------------------------------------------------------------------*/
 /* FD   DP    - Divide Decimal                                [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(divide_decimal)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+U128_T  v1;                             /* Operand 1 (dividend)      */
+U128_T  v2;                             /* Operand 2 (divisor)       */
+U128_T  quot, rem;                      /* Quotient and remainder    */
+int     sign1, sign2;                   /* Sign of operands          */
+int     signq, signr;                   /* Sign of quotient/remainder*/
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Program check if the second operand length exceeds 15 digits
+       or is equal to or greater than the first operand length */
+    if (l2 > 7 || l2 >= l1)
+        ARCH_DEP(program_interrupt) (regs, PGM_SPECIFICATION_EXCEPTION);
+
+    /* Load operands */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v1, &sign1);
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v2, &sign2);
+
+    /* Program check if second operand value is zero */
+    if (v2 == 0)
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_DIVIDE_EXCEPTION);
+
+    /* Perform trial comparison to determine potential overflow.
+       The leftmost digit of the divisor is aligned one digit to
+       the right of the leftmost dividend digit.  When the divisor,
+       so aligned, is less than or equal to the dividend, ignoring
+       signs, a divide exception is indicated */
+    if (v2 <= v1 / dec_pow10[ (l1 - l2) * 2 - 1 ])
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_DIVIDE_EXCEPTION);
+
+    /* Perform division; the divisor is less than 10**15 */
+    if (!(v1 >> 64))
+    {
+        quot = (U64) v1 / (U64) v2;
+        rem  = (U64) v1 % (U64) v2;
+    }
+    else
+    {
+        quot = v1 / v2;
+        rem  = v1 % v2;
+    }
+
+    /* Quotient is positive if operand signs are equal, and negative
+       if operand signs are opposite, even if quotient is zero */
+    signq = (sign1 == sign2) ? 1 : -1;
+
+    /* Remainder sign is same as dividend, even if remainder is zero */
+    signr = sign1;
+
+    /* Store remainder into entire first operand location.  The entire
+       field will be filled in order to check for store protection.
+       Subsequently the quotient will be stored in the leftmost bytes
+       of the first operand location, overwriting high order zeroes */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, rem, signr);
+
+    /* Store quotient in leftmost bytes of first operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1-l2-1, b1, regs, quot, signq);
+
+} /* end DEF_INST(divide_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(divide_decimal)
 {
 int     l1, l2;                         /* Length values             */
@@ -891,6 +1361,161 @@ int     signq, signr;                   /* Sign of quotient/remainder*/
     ARCH_DEP(store_decimal) (effective_addr1, l1-l2-1, b1, regs, quot, signq);
 
 } /* end DEF_INST(divide_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
+
+
+/*-------------------------------------------------------------------*/
+/* Edit or edit and mark in a work area                              */
+/*                                                                   */
+/* Used by ED and EDMK when the second operand does not cross a page */
+/* boundary and the operands do not overlap.  The pattern, the       */
+/* source digits and the result are each moved with a single storage */
+/* access instead of one access per byte.                            */
+/*                                                                   */
+/* Input:                                                            */
+/*      mark    1 for EDMK, 0 for ED                                 */
+/*      l       Length minus one of the pattern                      */
+/*      b1      Base register number of the pattern                  */
+/*      addr1   Logical address of the pattern                       */
+/*      b2      Base register number of the source                   */
+/*      addr2   Logical address of the source                        */
+/*      regs    CPU register context                                 */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP(edit_in_work_area) (int mark, int l, int b1,
+                        VADR addr1, int b2, VADR addr2, REGS *regs)
+{
+int     cc = 0;                         /* Condition code            */
+int     sig = 0;                        /* Significance indicator    */
+int     i;                              /* Pattern byte index        */
+int     j;                              /* Source byte index         */
+int     d;                              /* 1=Use right source digit  */
+int     h;                              /* Hexadecimal digit         */
+BYTE    sbyte = 0;                      /* Source operand byte       */
+BYTE    fbyte;                          /* Fill byte                 */
+BYTE    pbyte;                          /* Pattern byte              */
+BYTE    pat[256];                       /* Pattern work area         */
+BYTE    src[256];                       /* Source work area          */
+BYTE    res[256];                       /* Result work area          */
+VADR    mark_addr;                      /* EDMK result byte address  */
+
+    /* Fetch the pattern; the first byte is also the fill byte */
+    ARCH_DEP(vfetchc) (pat, l, addr1, b1, regs);
+    fbyte = pat[0];
+
+    /* Process the pattern from left to right */
+    for (i = 0, j = 0, d = 0; i <= l; i++)
+    {
+        pbyte = pat[i];
+
+        /* If pattern byte is digit selector (X'20') or
+           significance starter (X'21') then fetch next
+           hexadecimal digit from the second operand */
+        if (pbyte == 0x20 || pbyte == 0x21)
+        {
+            if (d == 0)
+            {
+                /* Fetch the source with the first digit selector.
+                   It lies within one page so fetching the whole
+                   length is no different from fetching only the
+                   bytes used */
+                if (j == 0)
+                    ARCH_DEP(vfetchc) (src, l, addr2, b2, regs);
+
+                /* Extract left digit of next source byte */
+                sbyte = src[j++];
+                h = sbyte >> 4;
+                sbyte &= 0x0F;
+                d = 1;
+
+                /* Program check if left digit is not numeric,
+                   after storing the result bytes edited so far */
+                if (h > 9)
+                {
+                    if (i > 0)
+                        ARCH_DEP(vstorec) (res, i - 1, addr1, b1, regs);
+                    regs->dxc = DXC_DECIMAL;
+                    ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+                }
+            }
+            else
+            {
+                /* Use right digit of source byte */
+                h = sbyte;
+                d = 0;
+            }
+
+            /* For the EDMK instruction only, insert address of
+               result byte into general register 1 if the digit
+               is non-zero and significance indicator was off */
+            if (mark && h > 0 && sig == 0)
+            {
+                mark_addr = (addr1 + i) & ADDRESS_MAXWRAP(regs);
+#if defined(FEATURE_001_ZARCH_INSTALLED_FACILITY)
+                if (regs->psw.amode64)
+                    regs->GR_G(1) = mark_addr;
+                else
+#endif
+                if ( regs->psw.amode )
+                    regs->GR_L(1) = mark_addr;
+                else
+                    regs->GR_LA24(1) = mark_addr;
+            }
+
+            /* Replace the pattern byte by the fill character
+               or by a zoned decimal digit */
+            res[i] = (sig == 0 && h == 0) ? fbyte : (0xF0 | h);
+
+            /* Set condition code 2 if digit is non-zero */
+            if (h > 0) cc = 2;
+
+            /* Turn on significance indicator if pattern
+               byte is significance starter or if source
+               digit is non-zero */
+            if (pbyte == 0x21 || h > 0)
+                sig = 1;
+
+            /* Examine right digit for sign code */
+            if (d == 1 && sbyte > 9)
+            {
+                /* Turn off the significance indicator if
+                   the right digit is a plus sign code */
+                if (sbyte != 0x0B && sbyte != 0x0D)
+                    sig = 0;
+
+                /* Take next digit from next source byte */
+                d = 0;
+            }
+        }
+
+        /* If pattern byte is field separator (X'22') then
+           replace it by the fill character, turn off the
+           significance indicator, and zeroize conditon code  */
+        else if (pbyte == 0x22)
+        {
+            res[i] = fbyte;
+            sig = 0;
+            cc = 0;
+        }
+
+        /* If pattern byte is a message byte (anything other
+           than X'20', X'21', or X'22') then replace it by
+           the fill byte if the significance indicator is off */
+        else
+            res[i] = sig ? pbyte : fbyte;
+
+    } /* end for(i) */
+
+    /* Store the edited result */
+    ARCH_DEP(vstorec) (res, l, addr1, b1, regs);
+
+    /* Replace condition code 2 by condition code 1 if the
+       significance indicator is on at the end of editing */
+    if (sig && cc == 2) cc = 1;
+
+    /* Set condition code */
+    regs->psw.cc = cc;
+
+} /* end function ARCH_DEP(edit_in_work_area) */
 
 
 /*-------------------------------------------------------------------*/
@@ -932,6 +1557,16 @@ BYTE    rbyte;                          /* Result byte               */
     else
         trial_run = 0;
 
+    /* Otherwise, unless the operands overlap, edit in a work area */
+    if (!trial_run
+      && ((effective_addr2 - effective_addr1) & ADDRESS_MAXWRAP(regs)) > (VADR)l
+      && ((effective_addr1 - effective_addr2) & ADDRESS_MAXWRAP(regs)) > (VADR)l)
+    {
+        ARCH_DEP(edit_in_work_area) (inst[0] == 0xDF, l, b1, effective_addr1,
+                                     b2, effective_addr2, regs);
+        return;
+    }
+
     for(;trial_run >= 0; trial_run--)
     {
         /* Initialize variables */
@@ -1084,6 +1719,49 @@ BYTE    rbyte;                          /* Result byte               */
 /*-------------------------------------------------------------------*/
 /* FC   MP    - Multiply Decimal                              [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(multiply_decimal)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+U128_T  v1, v2;                         /* Operand values            */
+int     count1;                         /* Significant digit counter */
+int     sign1, sign2, sign3;            /* Sign of operands & result */
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Program check if the second operand length exceeds 15 digits
+       or is equal to or greater than the first operand length */
+    if (l2 > 7 || l2 >= l1)
+        ARCH_DEP(program_interrupt) (regs, PGM_SPECIFICATION_EXCEPTION);
+
+    /* Load operands */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v1, &sign1);
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v2, &sign2);
+
+    /* Program check if the number of bytes in the second operand
+       is less than the number of bytes of high-order zeroes in the
+       first operand; this ensures that overflow cannot occur */
+    count1 = dec_digits( v1 );
+    if (l2 > l1 - (count1/2 + 1))
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+    }
+
+    /* Result is positive if operand signs are equal, and negative
+       if operand signs are opposite, even if result is zero */
+    sign3 = (sign1 == sign2) ? 1 : -1;
+
+    /* Store product into first operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, v1 * v2, sign3);
+
+} /* end DEF_INST(multiply_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(multiply_decimal)
 {
 int     l1, l2;                         /* Length values             */
@@ -1147,6 +1825,7 @@ int     carry;                          /* Carry indicator           */
     ARCH_DEP(store_decimal) (effective_addr1, l1, b1, regs, dec3, sign3);
 
 } /* end DEF_INST(multiply_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 #if defined(_MSVC_) && (_MSC_VER >= VS2010)
@@ -1156,6 +1835,90 @@ int     carry;                          /* Carry indicator           */
 /*-------------------------------------------------------------------*/
 /* F0   SRP   - Shift and Round Decimal                       [SS-c] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(shift_and_round_decimal)
+{
+int     l1, i3;                         /* Length and rounding       */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+int     cc;                             /* Condition code            */
+U128_T  v;                              /* Operand value             */
+U128_T  q;                              /* Value less shifted digits */
+int     digits;                         /* Operand length in digits  */
+int     sign;                           /* Sign of operand/result    */
+int     n;                              /* Shift count               */
+
+    SS(inst, regs, l1, i3, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Load operand */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v, &sign);
+
+    /* Program check if rounding digit is invalid */
+    if (i3 > 9)
+    {
+        regs->dxc = DXC_DECIMAL;
+        ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+    }
+
+    /* Isolate low-order six bits of shift count */
+    n = effective_addr2 & 0x3F;
+    digits = (l1+1) * 2 - 1;
+
+    /* Shift count 0-31 means shift left, 32-63 means shift right */
+    if (n < 32)
+    {
+        /* Set condition code according to operand sign */
+        cc = (v == 0) ? 0 : (sign < 0) ? 1 : 2;
+
+        /* Set cc=3 if non-zero digits will be lost on left shift,
+           and drop the digits which are shifted out */
+        if (v != 0 && n > digits - dec_digits( v ))
+        {
+            cc = 3;
+            v = (n >= digits) ? 0 : v % dec_pow10[ digits - n ];
+        }
+
+        /* Shift operand left */
+        v *= dec_pow10[ n ];
+    }
+    else
+    {
+        /* Calculate number of digits (1-32) to shift right */
+        n = 64 - n;
+
+        /* Add the rounding digit to the leftmost of the digits
+           to be shifted out and propagate the carry to the left */
+        if (n > MAX_DECIMAL_DIGITS)
+            v = 0;
+        else
+        {
+            q = v / dec_pow10[ n-1 ];
+            v = q / 10 + ((int)(q % 10) + i3 >= 10);
+        }
+
+        /* Set condition code according to operand sign */
+        cc = (v == 0) ? 0 : (sign < 0) ? 1 : 2;
+    }
+
+    /* Make sign positive if result is zero */
+    if (cc == 0)
+        sign = +1;
+
+    /* Store result into operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, v, sign);
+
+    /* Set condition code */
+    regs->psw.cc = cc;
+
+    /* Program check if overflow and PSW program mask is set */
+    if (cc == 3 && DOMASK(&regs->psw))
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
+
+} /* end DEF_INST(shift_and_round_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(shift_and_round_decimal)
 {
 int     l1, i3;                         /* Length and rounding       */
@@ -1244,6 +2007,7 @@ int     carry;                          /* Carry indicator           */
         ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
 
 } /* end DEF_INST(shift_and_round_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 #if defined(_MSVC_) && (_MSC_VER >= VS2010)
 #pragma optimize( "", on )
@@ -1253,6 +2017,66 @@ int     carry;                          /* Carry indicator           */
 /*-------------------------------------------------------------------*/
 /* FB   SP    - Subtract Decimal                              [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(subtract_decimal)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+int     cc;                             /* Condition code            */
+U128_T  v1, v2, v3;                     /* Operand & result values   */
+int     sign1, sign2, sign3;            /* Sign of operands & result */
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Load operands */
+    ARCH_DEP(load_packed) (effective_addr1, l1, b1, regs, &v1, &sign1);
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v2, &sign2);
+
+    /* Subtract by adding the negated second operand */
+    sign2 = -sign2;
+    if (sign1 == sign2)
+    {
+        v3 = v1 + v2;
+        sign3 = sign1;
+    }
+    else if (v1 >= v2)
+    {
+        v3 = v1 - v2;
+        sign3 = sign1;
+    }
+    else
+    {
+        v3 = v2 - v1;
+        sign3 = sign2;
+    }
+
+    /* Set condition code */
+    cc = (v3 == 0) ? 0 : (sign3 < 1) ? 1 : 2;
+
+    /* Overflow if result exceeds first operand length */
+    if (v3 >= dec_pow10[ (l1+1) * 2 - 1 ])
+        cc = 3;
+
+    /* Set positive sign if result is zero */
+    if (v3 == 0)
+        sign3 = 1;
+
+    /* Store result into first operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, v3, sign3);
+
+    /* Return condition code */
+    regs->psw.cc = cc;
+
+    /* Program check if overflow and PSW program mask is set */
+    if (cc == 3 && DOMASK(&regs->psw))
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
+
+} /* end DEF_INST(subtract_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(subtract_decimal)
 {
 int     l1, l2;                         /* Length values             */
@@ -1324,11 +2148,53 @@ int     sign1, sign2, sign3;            /* Sign of operands & result */
         ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
 
 } /* end DEF_INST(subtract_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 /*-------------------------------------------------------------------*/
 /* F8   ZAP   - Zero and Add                                  [SS-b] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(zero_and_add)
+{
+int     l1, l2;                         /* Length values             */
+int     b1, b2;                         /* Base register numbers     */
+VADR    effective_addr1,
+        effective_addr2;                /* Effective addresses       */
+int     cc;                             /* Condition code            */
+U128_T  v;                              /* Operand value             */
+int     sign;                           /* Sign                      */
+
+    SS(inst, regs, l1, l2, b1, effective_addr1,
+                                     b2, effective_addr2);
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Load second operand */
+    ARCH_DEP(load_packed) (effective_addr2, l2, b2, regs, &v, &sign);
+
+    /* Set condition code */
+    cc = (v == 0) ? 0 : (sign < 1) ? 1 : 2;
+
+    /* Overflow if result exceeds first operand length */
+    if (v >= dec_pow10[ (l1+1) * 2 - 1 ])
+        cc = 3;
+
+    /* Set positive sign if result is zero */
+    if (v == 0)
+        sign = +1;
+
+    /* Store result into first operand location */
+    ARCH_DEP(store_packed) (effective_addr1, l1, b1, regs, v, sign);
+
+    /* Return condition code */
+    regs->psw.cc = cc;
+
+    /* Program check if overflow and PSW program mask is set */
+    if (cc == 3 && DOMASK(&regs->psw))
+        ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
+
+} /* end DEF_INST(zero_and_add) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(zero_and_add)
 {
 int     l1, l2;                         /* Length values             */
@@ -1369,12 +2235,37 @@ int     sign;                           /* Sign                      */
         ARCH_DEP(program_interrupt) (regs, PGM_DECIMAL_OVERFLOW_EXCEPTION);
 
 } /* end DEF_INST(zero_and_add) */
+#endif /*!defined(DECIMAL_BINARY)*/
 
 
 #if defined(FEATURE_016_EXT_TRANSL_FACILITY_2)
 /*-------------------------------------------------------------------*/
 /* EBC0 TP    - Test Decimal                                 [RSL-a] */
 /*-------------------------------------------------------------------*/
+#if defined(DECIMAL_BINARY)
+DEF_INST(test_decimal)
+{
+int     l1;                             /* Length value              */
+int     b1;                             /* Base register number      */
+VADR    effective_addr1;                /* Effective address         */
+U128_T  v;                              /* Operand value (unused)    */
+int     sign;                           /* Operand sign (unused)     */
+BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
+
+    RSL(inst, regs, l1, b1, effective_addr1);
+
+    CONTRAN_INSTR_CHECK( regs );
+
+    /* Fetch the packed decimal operand into the work area */
+    memset( pack, 0, sizeof(pack) );
+    ARCH_DEP(vfetchc) (pack+sizeof(pack)-l1-1, l1, effective_addr1, b1, regs);
+
+    /* Condition code 2 if any digit is invalid, plus 1 if the sign
+       is invalid */
+    regs->psw.cc = dec_unpack( pack, &v, &sign );
+
+} /* end DEF_INST(test_decimal) */
+#else /*!defined(DECIMAL_BINARY)*/
 DEF_INST(test_decimal)
 {
 int     l1;                             /* Length value              */
@@ -1414,6 +2305,7 @@ BYTE    pack[MAX_DECIMAL_LENGTH];       /* Packed decimal work area  */
     regs->psw.cc = cc;
 
 } /* end DEF_INST(test_decimal) */
+#endif /*!defined(DECIMAL_BINARY)*/
 #endif /*defined(FEATURE_016_EXT_TRANSL_FACILITY_2)*/
 
 
@@ -825,6 +825,482 @@ int             exp;                    /* Adjusted exponent         */
 
 } /* end function dfp_test_data_group */
 
+/*===================================================================*/
+/* BINARY COEFFICIENT FAST PATHS                                     */
+/*===================================================================*/
+/* The common long and extended DFP add, subtract, multiply, compare
+   and quantize operations on finite operands are performed directly
+   on the coefficients held as binary integers.  The densely packed
+   decimal declets are converted using two cached tables.  Whenever
+   a result would need rounding (other than by quantize), would be
+   subnormal or would overflow, or an operand is an infinity or NaN,
+   the fast path declines and the decNumber library is used instead,
+   so the results, condition codes and exceptions are unchanged.
+   The extended format requires a 128-bit host integer type. */
+
+#if defined( HAVE___INT128_T ) && !defined( DFP_NO_FASTPATH )
+  #define DFP_FASTPATH                  /* Long and extended         */
+  #define DFP_FASTPATH_EXT
+  #define DFP_FAST_MAXDIGITS  34
+  typedef __uint128_t DFP_COEF;         /* Binary coefficient        */
+#elif !defined( DFP_NO_FASTPATH )
+  #define DFP_FASTPATH                  /* Long format only          */
+  #define DFP_FAST_MAXDIGITS  16
+  typedef U64 DFP_COEF;                 /* Binary coefficient        */
+#endif
+
+#if defined( DFP_FASTPATH )
+
+/* Unpacked finite DFP value */
+typedef struct _DFPFAST {
+    DFP_COEF    coef;                   /* Coefficient               */
+    int         exp;                    /* Unbiased exponent         */
+    int         sign;                   /* 1=negative                */
+} DFPFAST;
+
+/* Format parameters */
+typedef struct _DFPFMT {
+    int         digits;                 /* Coefficient digits        */
+    int         emin;                   /* Smallest exponent which
+                                           cannot give a subnormal   */
+    int         emax;                   /* Largest unclamped exponent*/
+} DFPFMT;
+
+static const DFPFMT dfp_fmt_long = { 16,  -383,  369 };
+#if defined( DFP_FASTPATH_EXT )
+static const DFPFMT dfp_fmt_ext  = { 34, -6143, 6111 };
+#endif
+
+static U16      dfp_dpd2bin[1024];      /* Declet to binary 0-999    */
+static U16      dfp_bin2dpd[1000];      /* Binary 0-999 to declet    */
+static DFP_COEF dfp_pow10[DFP_FAST_MAXDIGITS+1]; /* Powers of ten  */
+static BYTE     dfp_fast_inited = 0;    /* 1=above tables built      */
+
+/*-------------------------------------------------------------------*/
+/* Build the densely packed decimal conversion tables                */
+/*-------------------------------------------------------------------*/
+static void
+dfp_fast_init(void)
+{
+int             n;                      /* Binary value 0-999        */
+int             a, b, c;                /* Its three decimal digits  */
+int             dpd;                    /* Declet                    */
+int             p, s, w;                /* Declet bits 0-2,3-5,7-9   */
+
+    for (n = 0; n < 1000; n++)
+    {
+        a = n / 100; b = (n / 10) % 10; c = n % 10;
+        switch (((a > 7) << 2) | ((b > 7) << 1) | (c > 7)) {
+        case 0: dpd = (a << 7) | (b << 4) | c; break;
+        case 1: dpd = (a << 7) | (b << 4) | 0x08 | (c & 1); break;
+        case 2: dpd = (a << 7) | ((c & 6) << 4) | ((b & 1) << 4)
+                    | 0x0A | (c & 1); break;
+        case 4: dpd = ((c & 6) << 7) | ((a & 1) << 7) | (b << 4)
+                    | 0x0C | (c & 1); break;
+        case 3: dpd = (a << 7) | 0x40 | ((b & 1) << 4)
+                    | 0x0E | (c & 1); break;
+        case 5: dpd = ((b & 6) << 7) | ((a & 1) << 7) | 0x20
+                    | ((b & 1) << 4) | 0x0E | (c & 1); break;
+        case 6: dpd = ((c & 6) << 7) | ((a & 1) << 7)
+                    | ((b & 1) << 4) | 0x0E | (c & 1); break;
+        default: dpd = ((a & 1) << 7) | 0x60 | ((b & 1) << 4)
+                    | 0x0E | (c & 1); break;
+        } /* end switch */
+        dfp_bin2dpd[n] = (U16)dpd;
+    }
+
+    /* Non-canonical declets decode as the architecture requires,
+       by ignoring bits 0-1 when bits 3-4 and 7-9 are all ones */
+    for (dpd = 0; dpd < 1024; dpd++)
+    {
+        p = (dpd >> 7) & 7; s = (dpd >> 4) & 7; w = dpd & 0x0F;
+        if ((w & 0x08) == 0)
+            { a = p; b = s; c = dpd & 7; }
+        else switch ((w >> 1) & 3) {
+        case 0: a = p; b = s; c = 8 | (w & 1); break;
+        case 1: a = p; b = 8 | (s & 1); c = (s & 6) | (w & 1); break;
+        case 2: a = 8 | (p & 1); b = s; c = (p & 6) | (w & 1); break;
+        default:
+            switch (s >> 1) {
+            case 0: a = 8 | (p & 1); b = 8 | (s & 1);
+                    c = (p & 6) | (w & 1); break;
+            case 1: a = 8 | (p & 1); b = (p & 6) | (s & 1);
+                    c = 8 | (w & 1); break;
+            case 2: a = p; b = 8 | (s & 1); c = 8 | (w & 1); break;
+            default: a = 8 | (p & 1); b = 8 | (s & 1);
+                    c = 8 | (w & 1); break;
+            } /* end switch */
+        } /* end switch */
+        dfp_dpd2bin[dpd] = (U16)(a * 100 + b * 10 + c);
+    }
+
+    dfp_pow10[0] = 1;
+    for (n = 1; n <= DFP_FAST_MAXDIGITS; n++)
+        dfp_pow10[n] = dfp_pow10[n-1] * 10;
+
+    /* Concurrent first calls store identical values, so only the
+       ordering of the tables before the flag needs to be ensured */
+#if defined( HARDWARE_SYNC )
+    HARDWARE_SYNC();
+#endif
+    dfp_fast_inited = 1;
+
+} /* end function dfp_fast_init */
+
+/*-------------------------------------------------------------------*/
+/* Convert between 15 binary coded digits and five declets           */
+/*-------------------------------------------------------------------*/
+static inline U64
+dfp_declets_to_bin(U64 dpd)
+{
+    return (((( (U64)dfp_dpd2bin[(dpd >> 40) & 0x3FF]  * 1000
+              + dfp_dpd2bin[(dpd >> 30) & 0x3FF]) * 1000
+              + dfp_dpd2bin[(dpd >> 20) & 0x3FF]) * 1000
+              + dfp_dpd2bin[(dpd >> 10) & 0x3FF]) * 1000
+              + dfp_dpd2bin[ dpd        & 0x3FF]);
+} /* end function dfp_declets_to_bin */
+
+static inline U64
+dfp_bin_to_declets(U64 n)
+{
+U64     dpd;                            /* Declets                   */
+
+    dpd  = dfp_bin2dpd[n % 1000];        n /= 1000;
+    dpd |= (U64)dfp_bin2dpd[n % 1000] << 10; n /= 1000;
+    dpd |= (U64)dfp_bin2dpd[n % 1000] << 20; n /= 1000;
+    dpd |= (U64)dfp_bin2dpd[n % 1000] << 30; n /= 1000;
+    dpd |= (U64)dfp_bin2dpd[n] << 40;
+    return dpd;
+} /* end function dfp_bin_to_declets */
+
+/*-------------------------------------------------------------------*/
+/* Unpack and pack a decimal64 value held in a U64                   */
+/* dfp64_fast_unpack returns 0 if the value is an infinity or NaN    */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp64_fast_unpack(U64 w, DFPFAST *fp)
+{
+int     cf = (int)(w >> 58) & 0x1F;     /* Combination field         */
+int     lmd, bexp;                      /* Leftmost digit, exponent  */
+
+    if (cf >= 0x1E)
+        return 0;
+    if (cf >= 0x18)
+    {
+        lmd = 8 | (cf & 1);
+        bexp = ((cf >> 1) & 3) << 8;
+    }
+    else
+    {
+        lmd = cf & 7;
+        bexp = (cf >> 3) << 8;
+    }
+    fp->sign = (int)(w >> 63);
+    fp->exp  = (bexp | (int)((w >> 50) & 0xFF)) - 398;
+    fp->coef = (U64)lmd * 1000000000000000ULL
+             + dfp_declets_to_bin(w & 0x3FFFFFFFFFFFFULL);
+    return 1;
+} /* end function dfp64_fast_unpack */
+
+static inline U64
+dfp64_fast_pack(DFPFAST *fp)
+{
+U64     c = (U64)fp->coef;              /* Coefficient below 10**16  */
+int     lmd = (int)(c / 1000000000000000ULL);
+int     bexp = fp->exp + 398;           /* Biased exponent           */
+int     cf;                             /* Combination field         */
+
+    cf = (lmd < 8) ? ((bexp >> 8) << 3) | lmd
+                   : 0x18 | ((bexp >> 8) << 1) | (lmd & 1);
+    return ((U64)fp->sign << 63) | ((U64)cf << 58)
+         | ((U64)(bexp & 0xFF) << 50)
+         | dfp_bin_to_declets(c % 1000000000000000ULL);
+} /* end function dfp64_fast_pack */
+
+#if defined( DFP_FASTPATH_EXT )
+/*-------------------------------------------------------------------*/
+/* Unpack and pack a decimal128 value held in two U64s               */
+/* dfp128_fast_unpack returns 0 if the value is an infinity or NaN   */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp128_fast_unpack(U64 hi, U64 lo, DFPFAST *fp)
+{
+int     cf = (int)(hi >> 58) & 0x1F;    /* Combination field         */
+int     lmd, bexp;                      /* Leftmost digit, exponent  */
+U64     h, l;                           /* Leftmost 16, rightmost 18 */
+
+    if (cf >= 0x1E)
+        return 0;
+    if (cf >= 0x18)
+    {
+        lmd = 8 | (cf & 1);
+        bexp = ((cf >> 1) & 3) << 12;
+    }
+    else
+    {
+        lmd = cf & 7;
+        bexp = (cf >> 3) << 12;
+    }
+    fp->sign = (int)(hi >> 63);
+    fp->exp  = (bexp | (int)((hi >> 46) & 0xFFF)) - 6176;
+
+    /* Declets 0-5 hold the rightmost 18 digits and declets 6-10
+       together with the leftmost digit hold the other 16 digits */
+    l = dfp_declets_to_bin(lo & 0xFFFFFFFFFFFFFULL)
+      + (U64)dfp_dpd2bin[(lo >> 50) & 0x3FF]
+        * 1000000000000000ULL;
+    h = (U64)lmd * 1000000000000000ULL
+      + dfp_declets_to_bin(((hi << 4) | (lo >> 60)) & 0x3FFFFFFFFFFFFULL);
+    fp->coef = (DFP_COEF)h * 1000000000000000000ULL + l;
+    return 1;
+} /* end function dfp128_fast_unpack */
+
+static inline void
+dfp128_fast_pack(DFPFAST *fp, U64 *hi, U64 *lo)
+{
+U64     h = (U64)(fp->coef / 1000000000000000000ULL);
+U64     l = (U64)fp->coef - h * 1000000000000000000ULL;
+int     lmd = (int)(h / 1000000000000000ULL);
+int     bexp = fp->exp + 6176;          /* Biased exponent           */
+int     cf;                             /* Combination field         */
+U64     dh, dl;                         /* Declets 6-10, 0-5         */
+
+    cf = (lmd < 8) ? ((bexp >> 12) << 3) | lmd
+                   : 0x18 | ((bexp >> 12) << 1) | (lmd & 1);
+    dh = dfp_bin_to_declets(h % 1000000000000000ULL);
+    dl = dfp_bin_to_declets(l % 1000000000000000ULL)
+       | ((U64)dfp_bin2dpd[l / 1000000000000000ULL] << 50);
+    *hi = ((U64)fp->sign << 63) | ((U64)cf << 58)
+        | ((U64)(bexp & 0xFFF) << 46) | (dh >> 4);
+    *lo = (dh << 60) | dl;
+} /* end function dfp128_fast_pack */
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
+/*-------------------------------------------------------------------*/
+/* Add two finite values                                             */
+/*                                                                   */
+/* Input:                                                            */
+/*      r       Pointer to result                                    */
+/*      a,b     Pointers to operands                                 */
+/*      floor   1=rounding toward minus infinity                     */
+/*      fmt     Format parameters                                    */
+/* Output:                                                           */
+/*      The return value is 1 if the exact result has been placed    */
+/*      in r, or 0 if the result must be computed by decNumber.      */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp_fast_add(DFPFAST *r, DFPFAST *a, DFPFAST *b, int floor,
+             const DFPFMT *fmt)
+{
+DFPFAST *hi, *lo;                       /* Larger, smaller exponent  */
+DFP_COEF c;                             /* Aligned coefficient       */
+int      d;                             /* Exponent difference       */
+
+    if (a->exp >= b->exp) { hi = a; lo = b; }
+    else                  { hi = b; lo = a; }
+    if (lo->exp < fmt->emin)
+        return 0;
+
+    /* Align to the smaller exponent, which is then the exponent
+       of the exact result */
+    c = hi->coef;
+    d = hi->exp - lo->exp;
+    if (d && c)
+    {
+        if (d >= fmt->digits || c >= dfp_pow10[fmt->digits - d])
+            return 0;
+        c *= dfp_pow10[d];
+    }
+    r->exp = lo->exp;
+
+    if (hi->sign == lo->sign)
+    {
+        r->coef = c + lo->coef;
+        if (r->coef >= dfp_pow10[fmt->digits])
+            return 0;
+        r->sign = hi->sign;
+    }
+    else if (c > lo->coef)
+    {
+        r->coef = c - lo->coef;
+        r->sign = hi->sign;
+    }
+    else if (c < lo->coef)
+    {
+        r->coef = lo->coef - c;
+        r->sign = lo->sign;
+    }
+    else
+    {
+        r->coef = 0;
+        r->sign = floor;
+    }
+    return 1;
+
+} /* end function dfp_fast_add */
+
+/*-------------------------------------------------------------------*/
+/* Multiply two finite values                                        */
+/* Returns 1 if the exact result has been placed in r, otherwise 0   */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp_fast_multiply(DFPFAST *r, DFPFAST *a, DFPFAST *b, const DFPFMT *fmt)
+{
+    r->exp  = a->exp + b->exp;
+    r->sign = a->sign ^ b->sign;
+    if (r->exp < fmt->emin || r->exp > fmt->emax)
+        return 0;
+    if (a->coef == 0 || b->coef == 0)
+    {
+        r->coef = 0;
+        return 1;
+    }
+
+#if defined( DFP_FASTPATH_EXT )
+    /* The product of two long coefficients (each below 2**54) cannot
+       overflow a 128-bit integer.  Otherwise at most one coefficient
+       may exceed 64 bits and the product is formed in two halves so
+       that a product too large for 128 bits is detected */
+    if (fmt->digits > 16)
+    {
+    DFP_COEF x, y, lo, hi;              /* Multiplicands, halves     */
+
+        if (a->coef >> 64) { x = b->coef; y = a->coef; }
+        else               { x = a->coef; y = b->coef; }
+        if (x >> 64)
+            return 0;
+        lo = x * (U64)y;
+        hi = x * (U64)(y >> 64) + (lo >> 64);
+        if (hi >> 64)
+            return 0;
+        r->coef = (hi << 64) | (U64)lo;
+    }
+    else
+        r->coef = a->coef * b->coef;
+#else
+    /* Ensure the product of the 64-bit coefficients cannot wrap */
+    if (a->coef > (dfp_pow10[fmt->digits] - 1) / b->coef)
+        return 0;
+    r->coef = a->coef * b->coef;
+#endif
+    return r->coef < dfp_pow10[fmt->digits];
+
+} /* end function dfp_fast_multiply */
+
+/*-------------------------------------------------------------------*/
+/* Compare two finite values and return condition code 0, 1 or 2     */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp_fast_compare(DFPFAST *a, DFPFAST *b, const DFPFMT *fmt)
+{
+DFPFAST *hi, *lo;                       /* Larger, smaller exponent  */
+int      d;                             /* Exponent difference       */
+int      mag;                           /* Magnitude of a vs b       */
+
+    if (a->coef == 0)
+        return (b->coef == 0) ? 0 : b->sign ? 2 : 1;
+    if (b->coef == 0 || a->sign != b->sign)
+        return a->sign ? 1 : 2;
+
+    /* Compare the magnitudes of two nonzero values of like sign */
+    if (a->exp >= b->exp) { hi = a; lo = b; }
+    else                  { hi = b; lo = a; }
+    d = hi->exp - lo->exp;
+    if (d >= fmt->digits || hi->coef >= dfp_pow10[fmt->digits - d])
+        mag = 1;
+    else
+    {
+        DFP_COEF c = hi->coef * dfp_pow10[d];
+        mag = (c > lo->coef) ? 1 : (c < lo->coef) ? -1 : 0;
+    }
+    if (hi != a) mag = -mag;
+    if (a->sign) mag = -mag;
+    return (mag == 0) ? 0 : (mag < 0) ? 1 : 2;
+
+} /* end function dfp_fast_compare */
+
+/*-------------------------------------------------------------------*/
+/* Quantize a finite value                                           */
+/*                                                                   */
+/* Input:                                                            */
+/*      r       Pointer to result                                    */
+/*      a       Pointer to value to be quantized                     */
+/*      exp     Exponent of the result                               */
+/*      round   decNumber rounding mode                              */
+/*      fmt     Format parameters                                    */
+/* Output:                                                           */
+/*      The return value is 0 if the result must be computed by      */
+/*      decNumber, 1 if an exact result has been placed in r, or     */
+/*      2 if an inexact (rounded) result has been placed in r.       */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp_fast_quantize(DFPFAST *r, DFPFAST *a, int exp, enum rounding round,
+                  const DFPFMT *fmt)
+{
+DFP_COEF rem, half;                     /* Discarded digits, half ulp*/
+int      d;                             /* Exponent difference       */
+int      cls;                           /* 0=exact, 1=below half,
+                                           2=half, 3=above half      */
+int      up;                            /* 1=increment coefficient   */
+
+    if (exp < fmt->emin)
+        return 0;
+    r->sign = a->sign;
+    r->exp  = exp;
+
+    if (a->coef == 0 || exp <= a->exp)
+    {
+        d = a->exp - exp;
+        if (a->coef && (d >= fmt->digits
+                        || a->coef >= dfp_pow10[fmt->digits - d]))
+            return 0;
+        r->coef = a->coef * dfp_pow10[a->coef ? d : 0];
+        return 1;
+    }
+
+    d = exp - a->exp;
+    if (d > fmt->digits)
+    {
+        r->coef = 0;
+        cls = 1;
+    }
+    else
+    {
+        r->coef = a->coef / dfp_pow10[d];
+        rem = a->coef - r->coef * dfp_pow10[d];
+        half = dfp_pow10[d] >> 1;
+        cls = (rem == 0) ? 0 : (rem < half) ? 1 : (rem == half) ? 2 : 3;
+    }
+    if (cls == 0)
+        return 1;
+
+    switch (round) {
+    case DEC_ROUND_HALF_EVEN: up = cls == 3 || (cls == 2 && (r->coef & 1));
+                              break;
+    case DEC_ROUND_CEILING:   up = !a->sign; break;
+    case DEC_ROUND_FLOOR:     up = a->sign; break;
+    case DEC_ROUND_HALF_UP:   up = cls >= 2; break;
+    case DEC_ROUND_HALF_DOWN: up = cls == 3; break;
+    case DEC_ROUND_UP:        up = 1; break;
+    case DEC_ROUND_DOWN:      up = 0; break;
+    default:                  return 0;
+    } /* end switch(round) */
+    r->coef += up;
+    return 2;
+
+} /* end function dfp_fast_quantize */
+
+/*-------------------------------------------------------------------*/
+/* Return the condition code for a finite result                     */
+/*-------------------------------------------------------------------*/
+static inline int
+dfp_fast_cc(DFPFAST *fp)
+{
+    return (fp->coef == 0) ? 0 : fp->sign ? 1 : 2;
+} /* end function dfp_fast_cc */
+
+#endif /*defined( DFP_FASTPATH )*/
+
 #define _DFP_ARCH_INDEPENDENT_
 #endif /*!defined(_DFP_ARCH_INDEPENDENT_)*/
 
@@ -1598,6 +2074,88 @@ QW      *qwp;                           /* Quadword pointer          */
 
 } /* end function dfp_reg_from_decimal128 */
 
+#if defined( DFP_FASTPATH )
+/*-------------------------------------------------------------------*/
+/* Unpack a DFP long register for the binary coefficient fast path   */
+/*                                                                   */
+/* Input:                                                            */
+/*      rn      FP register number                                   */
+/*      fp      Pointer to unpacked value                            */
+/*      regs    CPU register context                                 */
+/* Output:                                                           */
+/*      The return value is 0 if the register contains an infinity  */
+/*      or NaN, otherwise 1 and the unpacked value is set.           */
+/*-------------------------------------------------------------------*/
+static inline int
+ARCH_DEP(dfp64_fast_load) (int rn, DFPFAST *fp, REGS *regs)
+{
+int     i;                              /* FP register subscript     */
+
+    if (!dfp_fast_inited) dfp_fast_init();
+
+    i = FPR2I(rn);                      /* Register index            */
+    return dfp64_fast_unpack(((U64)regs->fpr[i] << 32) | regs->fpr[i+1],
+                             fp);
+
+} /* end function dfp64_fast_load */
+
+/*-------------------------------------------------------------------*/
+/* Load a DFP long register from an unpacked finite value            */
+/*-------------------------------------------------------------------*/
+static inline void
+ARCH_DEP(dfp64_fast_store) (int rn, DFPFAST *fp, REGS *regs)
+{
+int     i;                              /* FP register subscript     */
+U64     w;                              /* Packed value              */
+
+    i = FPR2I(rn);                      /* Register index            */
+    w = dfp64_fast_pack(fp);
+    regs->fpr[i]   = (U32)(w >> 32);    /* Load FPR bits 0-31        */
+    regs->fpr[i+1] = (U32)w;            /* Load FPR bits 32-63       */
+
+} /* end function dfp64_fast_store */
+
+#if defined( DFP_FASTPATH_EXT )
+/*-------------------------------------------------------------------*/
+/* Unpack a DFP extended register for the binary coefficient fast    */
+/* path.  Returns 0 if the register contains an infinity or NaN.     */
+/*-------------------------------------------------------------------*/
+static inline int
+ARCH_DEP(dfp128_fast_load) (int rn, DFPFAST *fp, REGS *regs)
+{
+int     i, j;                           /* FP register subscripts    */
+
+    if (!dfp_fast_inited) dfp_fast_init();
+
+    i = FPR2I(rn);                      /* Left register index       */
+    j = i + FPREX;                      /* Right register index      */
+    return dfp128_fast_unpack(((U64)regs->fpr[i] << 32) | regs->fpr[i+1],
+                              ((U64)regs->fpr[j] << 32) | regs->fpr[j+1],
+                              fp);
+
+} /* end function dfp128_fast_load */
+
+/*-------------------------------------------------------------------*/
+/* Load a DFP extended register from an unpacked finite value        */
+/*-------------------------------------------------------------------*/
+static inline void
+ARCH_DEP(dfp128_fast_store) (int rn, DFPFAST *fp, REGS *regs)
+{
+int     i, j;                           /* FP register subscripts    */
+U64     hi, lo;                         /* Packed value              */
+
+    i = FPR2I(rn);                      /* Left register index       */
+    j = i + FPREX;                      /* Right register index      */
+    dfp128_fast_pack(fp, &hi, &lo);
+    regs->fpr[i]   = (U32)(hi >> 32);   /* Load FPR bits 0-31        */
+    regs->fpr[i+1] = (U32)hi;           /* Load FPR bits 32-63       */
+    regs->fpr[j]   = (U32)(lo >> 32);   /* Load FPR bits 64-95       */
+    regs->fpr[j+1] = (U32)lo;           /* Load FPR bits 96-127      */
+
+} /* end function dfp128_fast_store */
+#endif /*defined( DFP_FASTPATH_EXT )*/
+#endif /*defined( DFP_FASTPATH )*/
+
 /*-------------------------------------------------------------------*/
 /* Check for DFP exception conditions                                */
 /*                                                                   */
@@ -1768,6 +2326,9 @@ decimal128      x1, x2, x3;             /* Extended DFP values       */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH_EXT )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -1779,6 +2340,19 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL128);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH_EXT )
+    /* Exact sums of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp128_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp128_fast_load)(r3, &f3, regs)
+     && dfp_fast_add(&f1, &f2, &f3, set.round == DEC_ROUND_FLOOR,
+                     &dfp_fmt_ext))
+    {
+        ARCH_DEP(dfp128_fast_store)(r1, &f1, regs);
+        regs->psw.cc = dfp_fast_cc(&f1);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
     /* Add FP register r3 to FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal128)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal128)(r3, &x3, regs);
@@ -1818,6 +2392,9 @@ decimal64       x1, x2, x3;             /* Long DFP values           */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -1828,6 +2405,19 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL64);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH )
+    /* Exact sums of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp64_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp64_fast_load)(r3, &f3, regs)
+     && dfp_fast_add(&f1, &f2, &f3, set.round == DEC_ROUND_FLOOR,
+                     &dfp_fmt_long))
+    {
+        ARCH_DEP(dfp64_fast_store)(r1, &f1, regs);
+        regs->psw.cc = dfp_fast_cc(&f1);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH )*/
+
     /* Add FP register r3 to FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal64)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal64)(r3, &x3, regs);
@@ -1867,6 +2457,9 @@ decimal128      x1, x2;                 /* Extended DFP values       */
 decNumber       d1, d2, dr;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH_EXT )
+DFPFAST         f1, f2;                 /* Unpacked binary values    */
+#endif
 
     RRE(inst, regs, r1, r2);
 
@@ -1877,6 +2470,16 @@ BYTE            dxc;                    /* Data exception code       */
     /* Initialise the context for extended DFP */
     decContextDefault(&set, DEC_INIT_DECIMAL128);
 
+#if defined( DFP_FASTPATH_EXT )
+    /* Finite operands are compared without decNumber */
+    if (ARCH_DEP(dfp128_fast_load)(r1, &f1, regs)
+     && ARCH_DEP(dfp128_fast_load)(r2, &f2, regs))
+    {
+        regs->psw.cc = dfp_fast_compare(&f1, &f2, &dfp_fmt_ext);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
     /* Compare FP register r1 with FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal128)(r1, &x1, regs);
     ARCH_DEP(dfp_reg_to_decimal128)(r2, &x2, regs);
@@ -1912,6 +2515,9 @@ decimal64       x1, x2;                 /* Long DFP values           */
 decNumber       d1, d2, dr;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH )
+DFPFAST         f1, f2;                 /* Unpacked binary values    */
+#endif
 
     RRE(inst, regs, r1, r2);
 
@@ -1921,6 +2527,16 @@ BYTE            dxc;                    /* Data exception code       */
     /* Initialise the context for long DFP */
     decContextDefault(&set, DEC_INIT_DECIMAL64);
 
+#if defined( DFP_FASTPATH )
+    /* Finite operands are compared without decNumber */
+    if (ARCH_DEP(dfp64_fast_load)(r1, &f1, regs)
+     && ARCH_DEP(dfp64_fast_load)(r2, &f2, regs))
+    {
+        regs->psw.cc = dfp_fast_compare(&f1, &f2, &dfp_fmt_long);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH )*/
+
     /* Compare FP register r1 with FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal64)(r1, &x1, regs);
     ARCH_DEP(dfp_reg_to_decimal64)(r2, &x2, regs);
@@ -4381,6 +4997,9 @@ decimal128      x1, x2, x3;             /* Extended DFP values       */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH_EXT )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -4392,6 +5011,17 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL128);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH_EXT )
+    /* Exact products of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp128_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp128_fast_load)(r3, &f3, regs)
+     && dfp_fast_multiply(&f1, &f2, &f3, &dfp_fmt_ext))
+    {
+        ARCH_DEP(dfp128_fast_store)(r1, &f1, regs);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
     /* Multiply FP register r2 by FP register r3 */
     ARCH_DEP(dfp_reg_to_decimal128)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal128)(r3, &x3, regs);
@@ -4426,6 +5056,9 @@ decimal64       x1, x2, x3;             /* Long DFP values           */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -4436,6 +5069,17 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL64);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH )
+    /* Exact products of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp64_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp64_fast_load)(r3, &f3, regs)
+     && dfp_fast_multiply(&f1, &f2, &f3, &dfp_fmt_long))
+    {
+        ARCH_DEP(dfp64_fast_store)(r1, &f1, regs);
+        return;
+    }
+#endif /*defined( DFP_FASTPATH )*/
+
     /* Multiply FP register r2 by FP register r3 */
     ARCH_DEP(dfp_reg_to_decimal64)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal64)(r3, &x3, regs);
@@ -4470,6 +5114,9 @@ decimal128      x1, x2, x3;             /* Extended DFP values       */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH_EXT )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRF_RM(inst, regs, r1, r2, r3, m4);
 
@@ -4481,6 +5128,30 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL128);
     ARCH_DEP(dfp_rounding_mode)(&set, m4, regs);
 
+#if defined( DFP_FASTPATH_EXT )
+    /* Finite operands whose result is neither subnormal nor too
+       large for the format are quantized without decNumber */
+    if (ARCH_DEP(dfp128_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp128_fast_load)(r3, &f3, regs))
+    {
+        switch (dfp_fast_quantize(&f1, &f2, f3.exp, set.round,
+                                  &dfp_fmt_ext)) {
+        case 2:
+            set.status |= DEC_IEEE_854_Inexact | DEC_Rounded;
+            /* fall through */
+        case 1:
+            dxc = ARCH_DEP(dfp_status_check)(&set, regs);
+            ARCH_DEP(dfp128_fast_store)(r1, &f1, regs);
+            if (dxc != 0)
+            {
+                regs->dxc = dxc;
+                ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+            }
+            return;
+        } /* end switch */
+    }
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
     /* Quantize FP register r3 using FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal128)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal128)(r3, &x3, regs);
@@ -4515,6 +5186,9 @@ decimal64       x1, x2, x3;             /* Long DFP values           */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRF_RM(inst, regs, r1, r2, r3, m4);
 
@@ -4525,6 +5199,30 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL64);
     ARCH_DEP(dfp_rounding_mode)(&set, m4, regs);
 
+#if defined( DFP_FASTPATH )
+    /* Finite operands whose result is neither subnormal nor too
+       large for the format are quantized without decNumber */
+    if (ARCH_DEP(dfp64_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp64_fast_load)(r3, &f3, regs))
+    {
+        switch (dfp_fast_quantize(&f1, &f2, f3.exp, set.round,
+                                  &dfp_fmt_long)) {
+        case 2:
+            set.status |= DEC_IEEE_854_Inexact | DEC_Rounded;
+            /* fall through */
+        case 1:
+            dxc = ARCH_DEP(dfp_status_check)(&set, regs);
+            ARCH_DEP(dfp64_fast_store)(r1, &f1, regs);
+            if (dxc != 0)
+            {
+                regs->dxc = dxc;
+                ARCH_DEP(program_interrupt) (regs, PGM_DATA_EXCEPTION);
+            }
+            return;
+        } /* end switch */
+    }
+#endif /*defined( DFP_FASTPATH )*/
+
     /* Quantize FP register r3 using FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal64)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal64)(r3, &x3, regs);
@@ -4918,6 +5616,9 @@ decimal128      x1, x2, x3;             /* Extended DFP values       */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH_EXT )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -4929,6 +5630,22 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL128);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH_EXT )
+    /* Exact differences of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp128_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp128_fast_load)(r3, &f3, regs))
+    {
+        f3.sign ^= 1;
+        if (dfp_fast_add(&f1, &f2, &f3, set.round == DEC_ROUND_FLOOR,
+                         &dfp_fmt_ext))
+        {
+            ARCH_DEP(dfp128_fast_store)(r1, &f1, regs);
+            regs->psw.cc = dfp_fast_cc(&f1);
+            return;
+        }
+    }
+#endif /*defined( DFP_FASTPATH_EXT )*/
+
     /* Subtract FP register r3 from FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal128)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal128)(r3, &x3, regs);
@@ -4968,6 +5685,9 @@ decimal64       x1, x2, x3;             /* Long DFP values           */
 decNumber       d1, d2, d3;             /* Working decimal numbers   */
 decContext      set;                    /* Working context           */
 BYTE            dxc;                    /* Data exception code       */
+#if defined( DFP_FASTPATH )
+DFPFAST         f1, f2, f3;             /* Unpacked binary values    */
+#endif
 
     RRR(inst, regs, r1, r2, r3);
 
@@ -4978,6 +5698,22 @@ BYTE            dxc;                    /* Data exception code       */
     decContextDefault(&set, DEC_INIT_DECIMAL64);
     ARCH_DEP(dfp_rounding_mode)(&set, 0, regs);
 
+#if defined( DFP_FASTPATH )
+    /* Exact differences of finite operands bypass decNumber */
+    if (ARCH_DEP(dfp64_fast_load)(r2, &f2, regs)
+     && ARCH_DEP(dfp64_fast_load)(r3, &f3, regs))
+    {
+        f3.sign ^= 1;
+        if (dfp_fast_add(&f1, &f2, &f3, set.round == DEC_ROUND_FLOOR,
+                         &dfp_fmt_long))
+        {
+            ARCH_DEP(dfp64_fast_store)(r1, &f1, regs);
+            regs->psw.cc = dfp_fast_cc(&f1);
+            return;
+        }
+    }
+#endif /*defined( DFP_FASTPATH )*/
+
     /* Subtract FP register r3 from FP register r2 */
     ARCH_DEP(dfp_reg_to_decimal64)(r2, &x2, regs);
     ARCH_DEP(dfp_reg_to_decimal64)(r3, &x3, regs);
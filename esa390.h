@@ -828,8 +828,10 @@ typedef struct LSED LSED;
 #define SIGP_SETARCH             0x12   /* Set architecture mode     */
 #define SIGP_COND_EMERGENCY      0x13   /* Conditional Emergency     */
 #define SIGP_SENSE_RUNNING_STATE 0x15   /* Sense Running State       */
+#define SIGP_STORE_ADDITIONAL    0x17   /* Store additional status
+                                           at address                */
 
-#define MAX_SIGPORDER            0x15   /* Maximum SIGP order value  */
+#define MAX_SIGPORDER            0x17   /* Maximum SIGP order value  */
 #define LOG_SIGPORDER    SIGP_RESTART   /* Log any SIGP > this value
                                           except Sense Running State */
 
@@ -987,7 +989,10 @@ struct PSA_900
 /*01D0*/ QWORD  pgmnew;                 /* Program check new PSW     */
 /*01E0*/ QWORD  mcknew;                 /* Machine check new PSW     */
 /*01F0*/ QWORD  iopnew;                 /* I/O new PSW               */
-/*0200*/ BYTE   resv0200[4096];         /* Reserved                  */
+/*0200*/ BYTE   resv0200[4016];         /* Reserved                  */
+/*11B0*/ DBLWRD mcesad;                 /* Mach.check ext. save area
+                                           designation               */
+/*11B8*/ BYTE   resv11B8[72];           /* Reserved                  */
 /*1200*/ FWORD  storefpr[32];           /* FP register save area     */
 /*1280*/ DBLWRD storegpr[16];           /* General register save area*/
 /*1300*/ QWORD  storepsw;               /* Store status PSW save area*/
@@ -1051,6 +1056,7 @@ typedef struct PSA_900  PSA_900;
 
 #define MCIC_FA  0x0000008000000000ULL  /* Failing stor addr validity*/
 #define MCIC_EC  0x0000002000000000ULL  /* External damage code val. */
+#define MCIC_VR  0x0000004000000000ULL  /* Vector register validity  */
 #define MCIC_FP  0x0000001000000000ULL  /* Floating point reg val.   */
 #define MCIC_GR  0x0000000800000000ULL  /* General register validity */
 #define MCIC_CR  0x0000000400000000ULL  /* Control register validity */
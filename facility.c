@@ -554,7 +554,7 @@ FT( Z900, NONE, NONE, 127_UNDEFINED )
 FT( Z900, NONE, NONE, 128_IBM_INTERNAL )
 
 #if defined(  FEATURE_129_ZVECTOR_FACILITY )
-FT( NONE, NONE, NONE, 129_ZVECTOR )
+FT( Z900, Z900, NONE, 129_ZVECTOR )
 #endif
 
 #if defined(  FEATURE_130_INSTR_EXEC_PROT_FACILITY )
@@ -114,7 +114,7 @@
 //efine FEATURE_078_ENHANCED_DAT_FACILITY_2
 //efine FEATURE_080_DFP_PACK_CONV_FACILITY
 #define FEATURE_081_PPA_IN_ORDER_FACILITY
-//efine FEATURE_129_ZVECTOR_FACILITY
+#define FEATURE_129_ZVECTOR_FACILITY
 //efine FEATURE_130_INSTR_EXEC_PROT_FACILITY
 //efine FEATURE_131_SIDE_EFFECT_ACCESS_FACILITY
 //efine FEATURE_133_GUARDED_STORAGE_FACILITY
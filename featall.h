@@ -76,6 +76,7 @@
 //efine OPTION_LONG_HOSTINFO            /* Detailed host & logo info */
 #undef  OPTION_FOOTPRINT_BUFFER /* 2048 ** Size must be a power of 2 */
 #undef  OPTION_INSTRUCTION_COUNTING     /* First use trace and count */
+//efine OPTION_EMULATION_STATS          /* Emulator hot path counters*/
 #define OPTION_CKD_KEY_TRACING          /* Trace CKD search keys     */
 #undef  MODEL_DEPENDENT_STCM            /* STCM, STCMH always store  */
 #define OPTION_NOP_MODEL158_DIAGNOSE    /* NOP mod 158 specific diags*/
@@ -124,6 +125,10 @@
   #define OPTION_WATCHDOG
 #endif
 
+#if defined( OPTION_EMULATION_STATS )
+  #define OPTION_INSTRUCTION_COUNTING   // ('icount time' = opcode time)
+#endif
+
 #define OPTION_HARDWARE_SYNC_ALL        // All PERFORM_SERIALIZATION
 //#define OPTION_HARDWARE_SYNC_BCR_ONLY   // ONLY the BCR instructions
 #if defined( OPTION_HARDWARE_SYNC_ALL ) && defined( OPTION_HARDWARE_SYNC_BCR_ONLY )
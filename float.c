@@ -371,6 +371,129 @@ DISABLE_GCC_UNUSED_SET_WARNING
     (lls) <<= 1
 
 
+/*-------------------------------------------------------------------*/
+/* Count leading zero bits of a 64 bit integer                       */
+/* Normalization uses this to find the number of leading zero hex    */
+/* digits of a fraction in one step instead of testing and shifting  */
+/* in a loop.                                                        */
+/*                                                                   */
+/* Input:                                                            */
+/*      x       Value, which must not be zero                        */
+/* Value:                                                            */
+/*              number of leading zero bits                          */
+/*-------------------------------------------------------------------*/
+static inline int clz_U64( U64 x )
+{
+#if defined(__GNUC__)
+    return __builtin_clzll( x );
+#elif defined(_MSVC_) && defined(_M_X64)
+    unsigned long n;
+    _BitScanReverse64( &n, x );
+    return 63 - (int) n;
+#else
+    int n = 0;
+    if (!(x & 0xFFFFFFFF00000000ULL)) { n += 32; x <<= 32; }
+    if (!(x & 0xFFFF000000000000ULL)) { n += 16; x <<= 16; }
+    if (!(x & 0xFF00000000000000ULL)) { n +=  8; x <<=  8; }
+    if (!(x & 0xF000000000000000ULL)) { n +=  4; x <<=  4; }
+    if (!(x & 0xC000000000000000ULL)) { n +=  2; x <<=  2; }
+    if (!(x & 0x8000000000000000ULL)) { n +=  1; }
+    return n;
+#endif
+
+} /* end function clz_U64 */
+
+
+/*-------------------------------------------------------------------*/
+/* 128 bit host integer support                                      */
+/*                                                                   */
+/* Where the host compiler provides a 128 bit integer type the long  */
+/* and extended multiply and the divide routines use it directly     */
+/* instead of summing 32 bit partial products or developing the      */
+/* quotient one bit at a time.  #define HFP_NO_U128 to always use    */
+/* the portable code.                                                */
+/*-------------------------------------------------------------------*/
+#if defined(HAVE___INT128_T) && !defined(HFP_NO_U128)
+
+#define HFP_U128                        /* Host 128 bit integer used */
+typedef __uint128_t U128_T;
+
+/*-------------------------------------------------------------------*/
+/* Divide 192 bit integer by normalized 128 bit integer              */
+/* (Knuth, TAOCP vol. 2, 4.3.1 Algorithm D, for a 3 by 2 digit       */
+/* step: with both divisor digits in the quotient digit test the     */
+/* estimate is exact and no add back step is needed)                 */
+/*                                                                   */
+/* Input:                                                            */
+/*      u2,u1,u0  dividend, u2:u1 must be less than the divisor      */
+/*      d       divisor, most significant bit must be one            */
+/*      rem     remainder                                            */
+/* Value:                                                            */
+/*              64 bit quotient                                      */
+/*-------------------------------------------------------------------*/
+static inline U64 div_U192_U128( U64 u2, U64 u1, U64 u0, U128_T d,
+    U128_T *rem )
+{
+U64     d1 = (U64)(d >> 64);
+U64     d0 = (U64) d;
+U128_T  qhat;
+U128_T  rhat;
+
+    qhat = (u2 >= d1) ? 0xFFFFFFFFFFFFFFFFULL
+                      : (((U128_T) u2 << 64) | u1) / d1;
+    rhat = (((U128_T) u2 << 64) | u1) - qhat * d1;
+
+    while (!(rhat >> 64)
+        && qhat * d0 > ((rhat << 64) | u0)) {
+        qhat--;
+        rhat += d1;
+    }
+
+    /* the remainder is less than the divisor, so modulo 2**128      */
+    /* arithmetic yields it exactly                                  */
+    *rem = (((U128_T) u1 << 64) | u0) - qhat * d;
+    return (U64) qhat;
+
+} /* end function div_U192_U128 */
+
+
+/*-------------------------------------------------------------------*/
+/* Divide 256 bit integer by 128 bit integer                         */
+/*                                                                   */
+/* Input:                                                            */
+/*      hi      most significant 128 bit of dividend, must be less   */
+/*              than the divisor                                     */
+/*      lo      least significant 128 bit of dividend                */
+/*      d       divisor                                              */
+/* Value:                                                            */
+/*              128 bit quotient                                     */
+/*-------------------------------------------------------------------*/
+static inline U128_T div_U256_U128( U128_T hi, U128_T lo, U128_T d )
+{
+U128_T  r;
+U64     q1;
+U64     q0;
+int     s;
+
+    /* normalize divisor and dividend */
+    s = (d >> 64) ? clz_U64( (U64)(d >> 64) )
+                  : 64 + clz_U64( (U64) d );
+    if (s) {
+        d <<= s;
+        hi = (hi << s) | (lo >> (128 - s));
+        lo <<= s;
+    }
+
+    q1 = div_U192_U128( (U64)(hi >> 64), (U64) hi, (U64)(lo >> 64), d, &r );
+    q0 = div_U192_U128( (U64)(r >> 64), (U64) r, (U64) lo, d, &r );
+
+    return ((U128_T) q1 << 64) | q0;
+
+} /* end function div_U256_U128 */
+
+#endif /* defined(HAVE___INT128_T) && !defined(HFP_NO_U128) */
+
+
 /*-------------------------------------------------------------------*/
 /* Structure definition for internal short floatingpoint format      */
 /*-------------------------------------------------------------------*/
@@ -661,19 +784,13 @@ U64     value;                          /* Operand value             */
 /*-------------------------------------------------------------------*/
 static inline void normal_sf( SHORT_FLOAT *fl )
 {
+int     shift;
+
     if (fl->short_fract) {
-        if ((fl->short_fract & 0x00FFFF00) == 0) {
-            fl->short_fract <<= 16;
-            fl->expo -= 4;
-        }
-        if ((fl->short_fract & 0x00FF0000) == 0) {
-            fl->short_fract <<= 8;
-            fl->expo -= 2;
-        }
-        if ((fl->short_fract & 0x00F00000) == 0) {
-            fl->short_fract <<= 4;
-            (fl->expo)--;
-        }
+        /* shift out all leading zero hex digits at once */
+        shift = (clz_U64( fl->short_fract ) - 40) & ~3;
+        fl->short_fract <<= shift;
+        fl->expo -= shift >> 2;
     } else {
         fl->sign = POS;
         fl->expo = 0;
@@ -690,23 +807,13 @@ static inline void normal_sf( SHORT_FLOAT *fl )
 /*-------------------------------------------------------------------*/
 static inline void normal_lf( LONG_FLOAT *fl )
 {
+int     shift;
+
     if (fl->long_fract) {
-        if ((fl->long_fract & 0x00FFFFFFFF000000ULL) == 0) {
-            fl->long_fract <<= 32;
-            fl->expo -= 8;
-        }
-        if ((fl->long_fract & 0x00FFFF0000000000ULL) == 0) {
-            fl->long_fract <<= 16;
-            fl->expo -= 4;
-        }
-        if ((fl->long_fract & 0x00FF000000000000ULL) == 0) {
-            fl->long_fract <<= 8;
-            fl->expo -= 2;
-        }
-        if ((fl->long_fract & 0x00F0000000000000ULL) == 0) {
-            fl->long_fract <<= 4;
-            (fl->expo)--;
-        }
+        /* shift out all leading zero hex digits at once */
+        shift = (clz_U64( fl->long_fract ) - 8) & ~3;
+        fl->long_fract <<= shift;
+        fl->expo -= shift >> 2;
     } else {
         fl->sign = POS;
         fl->expo = 0;
@@ -723,53 +830,25 @@ static inline void normal_lf( LONG_FLOAT *fl )
 /*-------------------------------------------------------------------*/
 static inline void normal_ef( EXTENDED_FLOAT *fl )
 {
+int     shift;
+
     if (fl->ms_fract
     || fl->ls_fract) {
-        if (fl->ms_fract == 0) {
-            fl->ms_fract = fl->ls_fract >> 16;
-            fl->ls_fract <<= 48;
-            fl->expo -= 12;
-        }
-        if ((fl->ms_fract & 0x0000FFFFFFFF0000ULL) == 0) {
-            if (fl->ls_fract) {
-                fl->ms_fract = (fl->ms_fract << 32)
-                             | (fl->ls_fract >> 32);
-                fl->ls_fract <<= 32;
-            } else {
-                fl->ms_fract <<= 32;
-            }
-            fl->expo -= 8;
-        }
-        if ((fl->ms_fract & 0x0000FFFF00000000ULL) == 0) {
-            if (fl->ls_fract) {
-                fl->ms_fract = (fl->ms_fract << 16)
-                             | (fl->ls_fract >> 48);
-                fl->ls_fract <<= 16;
-            } else {
-                fl->ms_fract <<= 16;
-            }
-            fl->expo -= 4;
-        }
-        if ((fl->ms_fract & 0x0000FF0000000000ULL) == 0) {
-            if (fl->ls_fract) {
-                fl->ms_fract = (fl->ms_fract << 8)
-                             | (fl->ls_fract >> 56);
-                fl->ls_fract <<= 8;
-            } else {
-                fl->ms_fract <<= 8;
-            }
-            fl->expo -= 2;
-        }
-        if ((fl->ms_fract & 0x0000F00000000000ULL) == 0) {
-            if (fl->ls_fract) {
-                fl->ms_fract = (fl->ms_fract << 4)
-                             | (fl->ls_fract >> 60);
-                fl->ls_fract <<= 4;
-            } else {
-                fl->ms_fract <<= 4;
-            }
-            (fl->expo)--;
+        /* shift out all leading zero hex digits at once */
+        if (fl->ms_fract)
+            shift = (clz_U64( fl->ms_fract ) - 16) & ~3;
+        else
+            shift = 48 + (clz_U64( fl->ls_fract ) & ~3);
+
+        if (shift >= 64) {
+            fl->ms_fract = fl->ls_fract << (shift - 64);
+            fl->ls_fract = 0;
+        } else if (shift) {
+            fl->ms_fract = (fl->ms_fract << shift)
+                         | (fl->ls_fract >> (64 - shift));
+            fl->ls_fract <<= shift;
         }
+        fl->expo -= shift >> 2;
     } else {
         fl->sign = POS;
         fl->expo = 0;
@@ -1958,7 +2037,11 @@ static int mul_sf_to_lf( SHORT_FLOAT *fl, SHORT_FLOAT *mul_fl,
 static int mul_lf_to_ef( LONG_FLOAT *fl, LONG_FLOAT *mul_fl,
     EXTENDED_FLOAT *result_fl, REGS *regs )
 {
+#if defined(HFP_U128)
+U128_T  wk;
+#else
 U64     wk;
+#endif
 
     if (fl->long_fract
     && mul_fl->long_fract) {
@@ -1966,6 +2049,12 @@ U64     wk;
         normal_lf( fl );
         normal_lf( mul_fl );
 
+#if defined(HFP_U128)
+        /* multiply fracts */
+        wk = (U128_T) fl->long_fract * mul_fl->long_fract;
+        result_fl->ls_fract = (U64) wk;
+        result_fl->ms_fract = (U64)(wk >> 64);
+#else
         /* multiply fracts by sum of partial multiplications */
         wk = (fl->long_fract & 0x00000000FFFFFFFFULL) * (mul_fl->long_fract & 0x00000000FFFFFFFFULL);
         result_fl->ls_fract = wk & 0x00000000FFFFFFFFULL;
@@ -1976,6 +2065,7 @@ U64     wk;
         result_fl->ls_fract |= wk << 32;
 
         result_fl->ms_fract = (wk >> 32) + ((fl->long_fract >> 32) * (mul_fl->long_fract >> 32));
+#endif
 
         /* normalize result and compute expo */
         if (result_fl->ms_fract & 0x0000F00000000000ULL) {
@@ -2077,8 +2167,12 @@ U64     wk;
 static int mul_lf( LONG_FLOAT *fl, LONG_FLOAT *mul_fl,
     BYTE ovunf, REGS *regs )
 {
+#if defined(HFP_U128)
+U128_T  wk;
+#else
 U64     wk;
 U32     v;
+#endif
 
     if (fl->long_fract
     && mul_fl->long_fract) {
@@ -2086,6 +2180,19 @@ U32     v;
         normal_lf( fl );
         normal_lf( mul_fl );
 
+#if defined(HFP_U128)
+        /* multiply fracts */
+        wk = (U128_T) fl->long_fract * mul_fl->long_fract;
+
+        /* normalize result and compute expo */
+        if ((U64)(wk >> 64) & 0x0000F00000000000ULL) {
+            fl->long_fract = (U64)(wk >> 56);
+            fl->expo = fl->expo + mul_fl->expo - 64;
+        } else {
+            fl->long_fract = (U64)(wk >> 52);
+            fl->expo = fl->expo + mul_fl->expo - 65;
+        }
+#else
         /* multiply fracts by sum of partial multiplications */
         wk = ((fl->long_fract & 0x00000000FFFFFFFFULL) * (mul_fl->long_fract & 0x00000000FFFFFFFFULL)) >> 32;
 
@@ -2105,6 +2212,7 @@ U32     v;
                            | (v >> 20);
             fl->expo = fl->expo + mul_fl->expo - 65;
         }
+#endif
 
         /* determine sign */
         fl->sign = (fl->sign == mul_fl->sign) ? POS : NEG;
@@ -2140,6 +2248,14 @@ U32     v;
 static int mul_ef( EXTENDED_FLOAT *fl, EXTENDED_FLOAT *mul_fl,
     REGS *regs )
 {
+#if defined(HFP_U128)
+U128_T wk1;
+U128_T wk2;
+U128_T wk3;
+U128_T wk4;
+U128_T wk;
+U64 mid;
+#else
 U64 wk1;
 U64 wk2;
 U64 wk3;
@@ -2147,6 +2263,7 @@ U64 wk4;
 U64 wk;
 U32 wk0;
 U32 v;
+#endif
 
     if ((fl->ms_fract
         || fl->ls_fract)
@@ -2156,6 +2273,34 @@ U32 v;
         normal_ef ( fl );
         normal_ef ( mul_fl );
 
+#if defined(HFP_U128)
+        /* multiply fracts: the 224 bit product is the sum of four   */
+        /* 128 bit partial products                                  */
+        wk1 = (U128_T) fl->ls_fract * mul_fl->ls_fract;
+        wk2 = (U128_T) fl->ls_fract * mul_fl->ms_fract;
+        wk3 = (U128_T) fl->ms_fract * mul_fl->ls_fract;
+        wk4 = (U128_T) fl->ms_fract * mul_fl->ms_fract;
+
+        /* bits 64-127 of the product, plus carry */
+        wk = (wk1 >> 64) + (U64) wk2 + (U64) wk3;
+        mid = (U64) wk;
+
+        /* bits 128-223 of the product */
+        wk = wk4 + (wk2 >> 64) + (wk3 >> 64) + (wk >> 64);
+
+        /* normalize result and compute expo */
+        if ((U64)(wk >> 64) & 0xF0000000UL) {
+            fl->ms_fract = (U64)(wk >> 48);
+            fl->ls_fract = ((U64) wk << 16)
+                         | (mid >> 48);
+            fl->expo = fl->expo + mul_fl->expo - 64;
+        } else {
+            fl->ms_fract = (U64)(wk >> 44);
+            fl->ls_fract = ((U64) wk << 20)
+                         | (mid >> 44);
+            fl->expo = fl->expo + mul_fl->expo - 65;
+        }
+#else
         /* multiply fracts by sum of partial multiplications */
         wk0 = ((fl->ls_fract & 0x00000000FFFFFFFFULL) * (mul_fl->ls_fract & 0x00000000FFFFFFFFULL)) >> 32;
 
@@ -2209,6 +2354,8 @@ U32 v;
             fl->expo = fl->expo + mul_fl->expo - 65;
         }
 
+#endif
+
         /* determine sign */
         fl->sign = (fl->sign == mul_fl->sign) ? POS : NEG;
 
@@ -2292,9 +2439,11 @@ U64     wk;
 /*-------------------------------------------------------------------*/
 static int div_lf( LONG_FLOAT *fl, LONG_FLOAT *div_fl, REGS *regs )
 {
+#if !defined(HFP_U128)
 U64     wk;
 U64     wk2;
 int     i;
+#endif
 
     if (div_fl->long_fract) {
         if (fl->long_fract) {
@@ -2310,6 +2459,11 @@ int     i;
                 div_fl->long_fract <<= 4;
             }
 
+#if defined(HFP_U128)
+            /* divide fractions */
+            fl->long_fract = ((U128_T) fl->long_fract << 56)
+                           / div_fl->long_fract;
+#else
             /* partial divide first hex digit */
             wk2 = fl->long_fract / div_fl->long_fract;
             wk = (fl->long_fract % div_fl->long_fract) << 4;
@@ -2325,6 +2479,7 @@ int     i;
             /* partial divide last hex digit */
             fl->long_fract = (wk2 << 4)
                            | (wk / div_fl->long_fract);
+#endif
 
             /* determine sign */
             fl->sign = (fl->sign == div_fl->sign) ? POS : NEG;
@@ -2361,9 +2516,13 @@ int     i;
 static int div_ef( EXTENDED_FLOAT *fl, EXTENDED_FLOAT *div_fl,
     REGS *regs )
 {
+#if defined(HFP_U128)
+U128_T  wkq;
+#else
 U64     wkm;
 U64     wkl;
 int     i;
+#endif
 
     if (div_fl->ms_fract
     || div_fl->ls_fract) {
@@ -2385,6 +2544,16 @@ int     i;
                 div_fl->ls_fract <<= 4;
             }
 
+#if defined(HFP_U128)
+            /* divide fractions */
+            wkq = div_U256_U128(
+                (((U128_T) fl->ms_fract << 64) | fl->ls_fract) >> 16,
+                (U128_T) fl->ls_fract << 112,
+                ((U128_T) div_fl->ms_fract << 64) | div_fl->ls_fract );
+            fl->ms_fract = (U64)(wkq >> 64);
+            fl->ls_fract = (U64) wkq;
+
+#else
             /* divide fractions */
 
             /* the first binary digit */
@@ -2428,6 +2597,7 @@ int     i;
             if (((S64)wkm) >= 0) {
                 fl->ls_fract |= 1;
             }
+#endif
 
             /* determine sign */
             fl->sign = (fl->sign == div_fl->sign) ? POS : NEG;
@@ -2762,6 +2932,9 @@ static const unsigned short sqtab[] = {
 /*-------------------------------------------------------------------*/
 static U64 div_U128( U64 msa, U64 lsa, U64 div )
 {
+#if defined(HFP_U128)
+    return (U64)((((U128_T) msa << 64) | lsa) / div);
+#else
 U64     q;
 int     i;
 
@@ -2798,6 +2971,7 @@ int     i;
     }
 
     return(q);
+#endif
 
 } /* end function div_U128 */
 
@@ -2953,6 +3127,15 @@ U64     xj;
 static void div_U256( U64 mmsa, U64 msa, U64 lsa, U64 llsa, U64 msd,
     U64 lsd, U64 *msq, U64 *lsq )
 {
+#if defined(HFP_U128)
+U128_T  q;
+
+    q = div_U256_U128( ((U128_T) mmsa << 64) | msa,
+                       ((U128_T) lsa  << 64) | llsa,
+                       ((U128_T) msd  << 64) | lsd );
+    *msq = (U64)(q >> 64);
+    *lsq = (U64) q;
+#else
 int     i;
 
     /* the first binary digit */
@@ -2987,6 +3170,7 @@ int     i;
     if (((S64)mmsa) >= 0) {
         *lsq |= 1;
     }
+#endif
 
 } /* end function div_U256 */
 #endif /* FEATURE_HFP_EXTENSIONS */
@@ -27,7 +27,7 @@
 /* constants                                                                 */
 /*---------------------------------------------------------------------------*/
 #define HAO_WKLEN    256    /* (maximum message length able to tolerate) */
-#define HAO_MAXRULE  64     /* (purely arbitrary and easily increasable) */
+#define HAO_MAXRULE  256    /* (purely arbitrary and easily increasable) */
 #define HAO_MAXCAPT  9      /* (maximum number of capturing groups)      */
 
 /*---------------------------------------------------------------------------*/
@@ -40,6 +40,44 @@ static char    *ao_cmd[HAO_MAXRULE];
 static char    *ao_tgt[HAO_MAXRULE];
 static char     ao_msgbuf[LOG_DEFSIZE+1];   /* (plus+1 for NULL termination) */
 
+/*---------------------------------------------------------------------------*/
+/* prefilter                                                                 */
+/*                                                                           */
+/* Running every rule's regex against every message gets expensive with many */
+/* rules. Instead, the longest literal string that any match of a rule must  */
+/* contain is taken from its target as the rule's key, and the keys of all   */
+/* rules are compiled into a single Aho-Corasick automaton. Each message is  */
+/* scanned by the automaton once, and only the rules whose key it contains   */
+/* (plus those rules for which no key could be found) have their regex run. */
+/*---------------------------------------------------------------------------*/
+typedef struct HAO_ACNODE
+{
+    int   child;                /* first child node (0 = none)               */
+    int   sibling;              /* next child of our parent (0 = none)       */
+    int   fail;                 /* longest proper suffix that is a node      */
+    int   dict;                 /* nearest node on fail chain ending a key   */
+    int   rule;                 /* first rule whose key ends here (-1: none) */
+    BYTE  ch;                   /* character leading to this node            */
+}
+HAO_ACNODE;
+
+typedef struct HAO_STATS
+{
+    U64   hits;                 /* messages matched by the rule              */
+    U64   tests;                /* messages its regex was run against        */
+    U64   skips;                /* messages skipped because of the prefilter */
+    U64   time;                 /* total regexec time (1/16 usecs, host_tod) */
+    U64   maxtime;              /* longest regexec time (1/16 usecs)         */
+}
+HAO_STATS;
+
+static char      *ao_key[HAO_MAXRULE];          /* prefilter key or NULL     */
+static int        ao_keynext[HAO_MAXRULE];      /* next rule with same key   */
+static HAO_STATS  ao_stats[HAO_MAXRULE];        /* per rule statistics       */
+static HAO_ACNODE*ao_ac;                        /* automaton, 0 is the root  */
+static int        ao_acroot[256];               /* root's transitions        */
+static U64        ao_msgcnt;                    /* messages checked          */
+
 /*---------------------------------------------------------------------------*/
 /* function prototypes                                                       */
 /*---------------------------------------------------------------------------*/
@@ -53,6 +91,11 @@ static     void  hao_del(char *arg);
 static     void  hao_list(char *arg);
 static     void  hao_tgt(char *arg);
 static     void* hao_thread(void* dummy);
+static     const char* hao_skipbracket(const char *p);
+static     char* hao_literal(const char *re);
+static     void  hao_acbuild(void);
+static     int   hao_acnext(int state, BYTE c);
+static     void  hao_acscan(const char *msg, BYTE *cand);
 
 /*---------------------------------------------------------------------------*/
 /* void hao_initialize(void)                                                 */
@@ -84,7 +127,9 @@ static int hao_initialize()
     {
         ao_cmd[i] = NULL;
         ao_tgt[i] = NULL;
+        ao_key[i] = NULL;
     }
+    hao_acbuild();
 
     /* initialize message buffer */
     memset( ao_msgbuf, 0, sizeof( ao_msgbuf ));
@@ -314,6 +359,11 @@ static void hao_tgt(char *arg)
         return;
     }
 
+    /* add the rule to the prefilter */
+    ao_key[i] = hao_literal(arg);
+    memset(&ao_stats[i], 0, sizeof(ao_stats[i]));
+    hao_acbuild();
+
     release_lock(&ao_lock);
 
     // "The %s was placed at index %d"
@@ -456,29 +506,59 @@ static void hao_del(char *arg)
         ao_cmd[i] = NULL;
     }
 
+    /* and remove it from the prefilter */
+    free(ao_key[i]);
+    ao_key[i] = NULL;
+    hao_acbuild();
+
     release_lock(&ao_lock);
 
     // "Rule at index %d successfully deleted"
     WRMSG(HHC00086, "I", i);
 }
 
+/*---------------------------------------------------------------------------*/
+/* void hao_liststats(int i)                                                 */
+/*                                                                           */
+/* This function shows the statistics of the rule at index i. It is called   */
+/* by hao_list with the ao_lock held.                                        */
+/*---------------------------------------------------------------------------*/
+static void hao_liststats(int i)
+{
+    HAO_STATS *st = &ao_stats[i];
+    char key[HAO_WKLEN + 2];
+
+    if(ao_key[i])
+        MSGBUF(key, "'%s'", ao_key[i]);
+    else
+        STRLCPY(key, "none");
+
+    // "Index %02d: matched %"PRIu64" of %"PRIu64" tested, %"PRIu64" skipped; regex avg %.1f, max %.1f usecs; prefilter %s"
+    WRMSG(HHC00092, "I", i, st->hits, st->tests, st->skips,
+        st->tests ? (double) st->time / st->tests / 16.0 : 0.0,
+        (double) st->maxtime / 16.0, key);
+}
+
 /*---------------------------------------------------------------------------*/
 /* void hao_list(char *arg)                                                  */
 /*                                                                           */
 /* this function is called when the hao list command is given. It lists all  */
-/* rules. When given an index, only that index will be showed.               */
+/* rules. When given an index, only that index will be showed. Each rule is  */
+/* followed by its match statistics.                                         */
 /*---------------------------------------------------------------------------*/
 static void hao_list(char *arg)
 {
     int i;
     int rc;
     int size;
+    int keyed;
 
     rc = sscanf(arg, "%d", &i);
     if(!rc || rc == -1)
     {
         /* list all rules */
         size = 0;
+        keyed = 0;
 
         /* serialize */
         obtain_lock(&ao_lock);
@@ -494,10 +574,12 @@ static void hao_list(char *arg)
                 }
                 // "Index %02d: target %s -> command %s"
                 WRMSG(HHC00088, "I", i, ao_tgt[i], (ao_cmd[i] ? ao_cmd[i] : "not specified"));
+                hao_liststats(i);
                 size++;
+                if(ao_key[i])
+                    keyed++;
             }
         }
-        release_lock(&ao_lock);
 
         if(!size)
         {
@@ -508,7 +590,10 @@ static void hao_list(char *arg)
         {
             // "%d rule(s) displayed"
             WRMSG(HHC00082, "I", size);
+            // "Prefilter: %d of %d rule(s) have a key; %"PRIu64" message(s) checked"
+            WRMSG(HHC00093, "I", keyed, size, ao_msgcnt);
         }
+        release_lock(&ao_lock);
     }
     else
     {
@@ -532,6 +617,7 @@ static void hao_list(char *arg)
             {
                 // "Index %02d: target %s -> command %s"
                 WRMSG(HHC00088, "I", i, ao_tgt[i], (ao_cmd[i] ? ao_cmd[i] : "not specified"));
+                hao_liststats(i);
             }
 
             release_lock(&ao_lock);
@@ -567,7 +653,10 @@ static void hao_clear(void)
             free(ao_cmd[i]);
             ao_cmd[i] = NULL;
         }
+        free(ao_key[i]);
+        ao_key[i] = NULL;
     }
+    hao_acbuild();
 
     release_lock(&ao_lock);
 
@@ -740,6 +829,303 @@ static size_t hao_subst(char *str, size_t soff, size_t eoff,
     return len;
 }
 
+/*---------------------------------------------------------------------------*/
+/* const char* hao_skipbracket(const char *p)                                */
+/*                                                                           */
+/* This function returns a pointer past the end of the regex bracket         */
+/* expression starting at p (which points to the '['), or NULL if the        */
+/* bracket expression is not terminated.                                     */
+/*---------------------------------------------------------------------------*/
+static const char* hao_skipbracket(const char *p)
+{
+    char delim;
+
+    p++;
+    if (*p == '^')
+        p++;
+    if (*p == ']')
+        p++;
+    while (*p && *p != ']')
+    {
+        if (*p == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+        {
+            delim = p[1];
+            for (p += 2; *p && !(*p == delim && p[1] == ']'); p++);
+            if (!*p)
+                return NULL;
+            p++;
+        }
+        p++;
+    }
+    return *p ? p + 1 : NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/* char* hao_literal(const char *re)                                         */
+/*                                                                           */
+/* This function returns (in storage obtained by malloc) the longest string  */
+/* of literal characters which every match of the extended regex re must     */
+/* contain, or NULL if no such string could be found. It errs on the side of */
+/* caution: anything it does not fully understand ends the current string,  */
+/* parenthesized groups and bracket expressions are skipped over entirely,   */
+/* and a '|' outside of a group means no string can be relied upon at all.   */
+/*---------------------------------------------------------------------------*/
+static char* hao_literal(const char *re)
+{
+    char run[HAO_WKLEN];        /* literal string being collected            */
+    char best[HAO_WKLEN];       /* longest literal string found so far       */
+    int  runlen = 0;
+    int  bestlen = 0;
+    int  depth;
+    int  lastlit = FALSE;       /* previous atom was a literal in run        */
+    const char *p = re;
+    char *key;
+
+#define HAO_ENDRUN()                                                          \
+    do {                                                                      \
+        if (runlen > bestlen)                                                 \
+        {                                                                     \
+            memcpy(best, run, runlen);                                        \
+            bestlen = runlen;                                                 \
+        }                                                                     \
+        runlen = 0;                                                           \
+    } while (0)
+
+    while (*p)
+    {
+        switch (*p)
+        {
+        case '|':
+            return NULL;        /* (alternation: nothing is required)        */
+
+        case '*':
+        case '?':
+        case '{':
+            /* the previous atom is optional: drop it from the string */
+            if (lastlit)
+                runlen--;
+            HAO_ENDRUN();
+            if (*p == '{')
+            {
+                while (*p && *p != '}')
+                    p++;
+                if (!*p)
+                    return NULL;
+            }
+            p++;
+            lastlit = FALSE;
+            continue;
+
+        case '+':
+            /* the previous atom is required once, but may repeat */
+            HAO_ENDRUN();
+            p++;
+            lastlit = FALSE;
+            continue;
+
+        case '(':
+            /* skip the whole group */
+            HAO_ENDRUN();
+            for (depth = 0; *p; )
+            {
+                if (*p == '[')
+                {
+                    if (!(p = hao_skipbracket(p)))
+                        return NULL;
+                    continue;
+                }
+                if (*p == '\\' && p[1])
+                    p++;
+                else if (*p == '(')
+                    depth++;
+                else if (*p == ')' && !--depth)
+                    break;
+                p++;
+            }
+            if (!*p)
+                return NULL;
+            p++;
+            lastlit = FALSE;
+            continue;
+
+        case '[':
+            /* skip the whole bracket expression */
+            HAO_ENDRUN();
+            if (!(p = hao_skipbracket(p)))
+                return NULL;
+            lastlit = FALSE;
+            continue;
+
+        case '.':
+        case '^':
+        case '$':
+            HAO_ENDRUN();
+            p++;
+            lastlit = FALSE;
+            continue;
+
+        case '\\':
+            /* an escaped special character is a literal; anything
+               else (back references, GNU \w \< etc.) is not */
+            if (!p[1] || !strchr(".[]()*+?{}|^$\\/", p[1]))
+            {
+                HAO_ENDRUN();
+                p += p[1] ? 2 : 1;
+                lastlit = FALSE;
+                continue;
+            }
+            p++;
+            /* fall through */
+
+        default:
+            if (runlen < (int) sizeof(run))
+                run[runlen++] = *p;
+            p++;
+            lastlit = TRUE;
+            continue;
+        }
+    }
+    HAO_ENDRUN();
+
+#undef HAO_ENDRUN
+
+    if (!bestlen || !(key = malloc(bestlen + 1)))
+        return NULL;
+
+    memcpy(key, best, bestlen);
+    key[bestlen] = 0;
+    return key;
+}
+
+/*---------------------------------------------------------------------------*/
+/* void hao_acbuild(void)                                                    */
+/*                                                                           */
+/* This function (re)builds the prefilter automaton from the keys of all     */
+/* defined rules. It is called with the ao_lock held whenever a rule is      */
+/* added or deleted. Should storage not be available, the automaton is left  */
+/* empty and every rule is then simply tested against every message.        */
+/*---------------------------------------------------------------------------*/
+static void hao_acbuild(void)
+{
+    int   i, n, m, s, size;
+    int  *queue, head, tail;
+    char *p;
+
+    free(ao_ac);
+    ao_ac = NULL;
+    memset(ao_acroot, 0, sizeof(ao_acroot));
+
+    /* worst case: one node per key character plus the root */
+    for (size = 1, i = 0; i < HAO_MAXRULE; i++)
+        if (ao_key[i])
+            size += (int) strlen(ao_key[i]);
+
+    if (!(ao_ac = calloc(size, sizeof(HAO_ACNODE))))
+        return;
+    if (!(queue = malloc(size * sizeof(int))))
+    {
+        free(ao_ac);
+        ao_ac = NULL;
+        return;
+    }
+
+    /* build the trie of all keys */
+    ao_ac[0].rule = -1;
+    for (size = 1, i = 0; i < HAO_MAXRULE; i++)
+    {
+        if (!ao_key[i])
+            continue;
+
+        for (n = 0, p = ao_key[i]; *p; p++, n = m)
+        {
+            for (m = ao_ac[n].child; m && ao_ac[m].ch != (BYTE) *p; m = ao_ac[m].sibling);
+            if (!m)
+            {
+                m = size++;
+                ao_ac[m].ch      = (BYTE) *p;
+                ao_ac[m].rule    = -1;
+                ao_ac[m].sibling = ao_ac[n].child;
+                ao_ac[n].child   = m;
+            }
+        }
+        ao_keynext[i] = ao_ac[n].rule;
+        ao_ac[n].rule = i;
+    }
+
+    /* the root goes straight to its children, or stays at the root */
+    for (m = ao_ac[0].child; m; m = ao_ac[m].sibling)
+        ao_acroot[ ao_ac[m].ch ] = m;
+
+    /* set the failure links breadth first, shortest keys first */
+    head = tail = 0;
+    for (m = ao_ac[0].child; m; m = ao_ac[m].sibling)
+        queue[tail++] = m;
+
+    while (head < tail)
+    {
+        s = queue[head++];
+        for (m = ao_ac[s].child; m; m = ao_ac[m].sibling)
+        {
+            n = s == 0 ? 0 : hao_acnext(ao_ac[s].fail, ao_ac[m].ch);
+            ao_ac[m].fail = n;
+            ao_ac[m].dict = ao_ac[n].rule >= 0 ? n : ao_ac[n].dict;
+            queue[tail++] = m;
+        }
+    }
+
+    free(queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/* int hao_acnext(int state, BYTE c)                                         */
+/*                                                                           */
+/* This function returns the prefilter automaton's next state after reading  */
+/* character c in the given state.                                           */
+/*---------------------------------------------------------------------------*/
+static int hao_acnext(int state, BYTE c)
+{
+    int n;
+
+    for (;;)
+    {
+        if (!state)
+            return ao_acroot[c];
+
+        for (n = ao_ac[state].child; n; n = ao_ac[n].sibling)
+            if (ao_ac[n].ch == c)
+                return n;
+
+        state = ao_ac[state].fail;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* void hao_acscan(const char *msg, BYTE *cand)                              */
+/*                                                                           */
+/* This function sets cand[i] for every rule i whose regex needs to be run   */
+/* against the message: those whose key occurs in it, and those that have   */
+/* no key at all.                                                            */
+/*---------------------------------------------------------------------------*/
+static void hao_acscan(const char *msg, BYTE *cand)
+{
+    int i, n, state;
+
+    for (i = 0; i < HAO_MAXRULE; i++)
+        cand[i] = !ao_key[i] || !ao_ac;
+
+    if (!ao_ac || !ao_ac[0].child)
+        return;
+
+    for (state = 0; *msg; msg++)
+    {
+        state = hao_acnext(state, (BYTE) *msg);
+
+        for (n = ao_ac[state].rule >= 0 ? state : ao_ac[state].dict; n; n = ao_ac[n].dict)
+            for (i = ao_ac[n].rule; i >= 0; i = ao_keynext[i])
+                cand[i] = TRUE;
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 /* void hao_message(char *buf)                                               */
 /*                                                                           */
@@ -752,9 +1138,11 @@ static void hao_message(char *buf)
     char work[HAO_WKLEN];
     char cmd[HAO_WKLEN];
     regmatch_t rm[HAO_MAXCAPT+1];
-    int i, j, k, numcapt;
+    BYTE cand[HAO_MAXRULE];
+    int i, j, k, numcapt, rc;
     size_t n;
     char *p;
+    U64 start, took;
 
     /* copy and strip spaces */
     hao_cpstrp(work, buf);
@@ -770,14 +1158,35 @@ static void hao_message(char *buf)
     /* serialize */
     obtain_lock(&ao_lock);
 
+    /* find the rules that might match */
+    hao_acscan(work, cand);
+    ao_msgcnt++;
+
     /* check all defined rules */
     for(i = 0; i < HAO_MAXRULE; i++)
     {
         if(ao_tgt[i] && ao_cmd[i])  /* complete rule defined in this slot? */
         {
+            /* can this rule match our message at all? */
+            if (!cand[i])
+            {
+                ao_stats[i].skips++;
+                continue;
+            }
+
             /* does this rule match our message? */
-            if (regexec(&ao_preg[i], work, HAO_MAXCAPT+1, rm, 0) == 0)
+            start = host_tod();
+            rc = regexec(&ao_preg[i], work, HAO_MAXCAPT+1, rm, 0);
+            took = host_tod() - start;
+
+            ao_stats[i].tests++;
+            ao_stats[i].time += took;
+            if (took > ao_stats[i].maxtime)
+                ao_stats[i].maxtime = took;
+
+            if (rc == 0)
             {
+                ao_stats[i].hits++;
                 /* count the capturing group matches */
                 for (j = 0; j <= HAO_MAXCAPT && rm[j].rm_so >= 0; j++);
                 numcapt = j - 1;
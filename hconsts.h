@@ -351,6 +351,11 @@
 #define  KEEPALIVE_PROBE_COUNT      10  /* Max probe timeouts        */
 #endif // (KEEPALIVE)
 
+/*-------------------------------------------------------------------*/
+/* Console tn3270/telnet server event loop threads                   */
+/*-------------------------------------------------------------------*/
+#define  MAX_CNSLTHREADS            16  /* Max console I/O threads   */
+
 /*-------------------------------------------------------------------*/
 /*       Definitions for program product OS restriction flag.        */
 /*-------------------------------------------------------------------*/
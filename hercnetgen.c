@@ -0,0 +1,483 @@
+/* HERCNETGEN.C (C) Copyright Hercules development team, 2026        */
+/*              Network backend packet generator and benchmark       */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This program generates numbered Ethernet frames, sends them to an */
+/* emulated network adapter's user-space backend (see tuntap.h) and  */
+/* counts, checks and times whatever comes back. It can:             */
+/*                                                                   */
+/*  -l        test the "socket" backend through a socket pair: the   */
+/*            adapter side calls NETBE_Read and NETBE_Writev itself; */
+/*            only the backend is measured, not QETH's read_packet   */
+/*            and write_packet or its QDIO buffer handling (serve a  */
+/*            QETH device with "path" for that); needs no privileges */
+/*  -p ifname send and receive through the "packet" (AF_PACKET ring) */
+/*            backend bound to ifname, e.g. "lo" (needs CAP_NET_RAW) */
+/*  path      listen on a Unix socket for a QETH device defined with */
+/*            "backend socket path" and send frames to the guest, or */
+/*            with -e echo back (MACs swapped) what the guest sends  */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#include "hercules.h"
+#include "tuntap.h"
+
+#define UTILITY_NAME    "hercnetgen"
+#define UTILITY_DESC    "Network backend packet generator"
+
+#if defined( TUNTAP_NETBE )
+
+/*-------------------------------------------------------------------*/
+/* Generated frames: broadcast Ethernet frame of a local experiment  */
+/* Ethertype whose payload is a magic number, the frame's sequence   */
+/* number and then a byte pattern derived from the sequence number.  */
+/*-------------------------------------------------------------------*/
+#define GEN_ETHTYPE     0x88B5          /* Local experimental        */
+#define GEN_MAGIC       0x484E4731      /* "HNG1"                    */
+#define GEN_HDRLEN      (14 + 4 + 8)    /* Ethernet, magic, seqno    */
+#define GEN_MAXSIZE     65535           /* Largest frame size        */
+
+static const BYTE gen_srcmac[6] = { 0x02, 0x48, 0x4E, 0x47, 0x00, 0x01 };
+
+/*-------------------------------------------------------------------*/
+/* One end of the link under test: a backend or a plain socket       */
+/*-------------------------------------------------------------------*/
+typedef struct END
+{
+    NETBE*  be;                         /* Backend, or NULL          */
+    int     fd;                         /* Socket when no backend    */
+}
+END;
+
+typedef struct GEN
+{
+    const char*  name;                  /* Test name                 */
+    END*    tx;                         /* Sending end               */
+    END*    rx;                         /* Receiving end             */
+    U64     frames;                     /* Frames to send            */
+    int     size;                       /* Frame size                */
+    U64     sent;                       /* Frames sent               */
+    U64     sentbytes;                  /* Bytes sent                */
+    U64     dropped;                    /* Frames dropped            */
+    U64     usecs;                      /* Time spent sending        */
+    volatile int done;                  /* Sender has finished       */
+}
+GEN;
+
+static U64 now_usecs()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return (U64) tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static int end_fd( END* end )
+{
+    return end->be ? end->be->fd : end->fd;
+}
+
+/*-------------------------------------------------------------------*/
+/* Read or write one frame; wait up to msecs if none can be moved    */
+/*-------------------------------------------------------------------*/
+static int end_xfer( END* end, BYTE* buf, int len, int out, int msecs )
+{
+    struct pollfd  pfd;
+    struct iovec   iov;
+    int            rc;
+
+    for (;;)
+    {
+        iov.iov_base = buf;
+        iov.iov_len  = len;
+        if (end->be)
+            rc = out ? NETBE_Writev( end->be, &iov, 1 )
+                     : NETBE_Readv( end->be, &iov, 1 );
+        else
+            rc = out ? write( end->fd, buf, len )
+                     : read( end->fd, buf, len );
+        if (rc >= 0 || errno != EAGAIN || !msecs)
+            return rc;
+
+        pfd.fd      = end_fd( end );
+        pfd.events  = out ? POLLOUT : POLLIN;
+        pfd.revents = 0;
+        if (poll( &pfd, 1, msecs ) <= 0)
+        {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Build frame number seq of the given size                          */
+/*-------------------------------------------------------------------*/
+static void gen_frame( BYTE* frame, int size, U64 seq )
+{
+    int  i;
+
+    memset( frame, 0xFF, 6 );
+    memcpy( frame + 6, gen_srcmac, 6 );
+    STORE_HW( frame + 12, GEN_ETHTYPE );
+    STORE_FW( frame + 14, GEN_MAGIC );
+    STORE_DW( frame + 18, seq );
+    for (i = GEN_HDRLEN; i < size; i++)
+        frame[i] = (BYTE)(seq + i);
+}
+
+/*-------------------------------------------------------------------*/
+/* Check a received frame: returns -1 if it is not one of ours, 0 if */
+/* it is intact or 1 if it is corrupted. *seq is its sequence number */
+/*-------------------------------------------------------------------*/
+static int chk_frame( BYTE* frame, int len, int size, U64* seq )
+{
+    U16  type;
+    U32  magic;
+    int  i;
+
+    if (len < GEN_HDRLEN)
+        return -1;
+    FETCH_HW( type,  frame + 12 );
+    FETCH_FW( magic, frame + 14 );
+    if (type != GEN_ETHTYPE || magic != GEN_MAGIC)
+        return -1;
+    FETCH_DW( *seq, frame + 18 );
+    if (len != size)
+        return 1;
+    for (i = GEN_HDRLEN; i < len; i++)
+        if (frame[i] != (BYTE)(*seq + i))
+            return 1;
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Sender thread: send the frames as fast as the receiver takes them */
+/*-------------------------------------------------------------------*/
+static void* gen_thread( void* arg )
+{
+    GEN*   gen = (GEN*) arg;
+    BYTE*  frame = malloc( gen->size );
+    U64    seq, drops, start;
+    int    rc;
+
+    drops = gen->tx->be ? gen->tx->be->drops : 0;
+    start = now_usecs();
+    for (seq = 0; frame && seq < gen->frames; seq++)
+    {
+        gen_frame( frame, gen->size, seq );
+        while ((rc = end_xfer( gen->tx, frame, gen->size, 1, 100 )) < 0
+            && errno == EAGAIN);
+        if (rc < 0)
+        {
+            // "Error in function %s: %s"
+            FWRMSG( stderr, HHC00075, "E", "write()", strerror( errno ));
+            break;
+        }
+        gen->sent++;
+        gen->sentbytes += rc;
+    }
+    gen->usecs = now_usecs() - start;
+    if (gen->tx->be)
+        gen->dropped = gen->tx->be->drops - drops;
+    free( frame );
+    gen->done = 1;
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Report a count of frames and bytes and their rate                 */
+/*-------------------------------------------------------------------*/
+static void report( const char* name, const char* what,
+                    U64 frames, U64 bytes, U64 dropped, U64 usecs )
+{
+    if (!usecs)
+        usecs = 1;
+    // "%s: %s %"PRIu64" frames, %"PRIu64" bytes, %"PRIu64" dropped in %u.%03u secs"
+    WRMSG( HHC02812, "I", name, what, frames, bytes, dropped,
+        (unsigned)(usecs / 1000000), (unsigned)((usecs % 1000000) / 1000) );
+    // "%s: %"PRIu64" frames/s, %"PRIu64" Mbit/s"
+    WRMSG( HHC02813, "I", name,
+        (U64)(frames * 1000000.0 / usecs), (U64)(bytes * 8.0 / usecs) );
+}
+
+/*-------------------------------------------------------------------*/
+/* Run one test: send frames from gen->tx while receiving them on    */
+/* gen->rx, until all have arrived or none has for secs seconds.     */
+/*-------------------------------------------------------------------*/
+static int run_test( GEN* gen, int secs )
+{
+    TID    tid;
+    BYTE*  frame = malloc( GEN_MAXSIZE );
+    U64    rcvd = 0, bytes = 0, outseq = 0, corrupt = 0;
+    U64    seq, expect = 0, start, last, now;
+    int    rc, len;
+
+    if (!frame)
+        return -1;
+
+    gen->sent = gen->sentbytes = gen->dropped = 0;
+    gen->done = 0;
+
+    start = last = now_usecs();
+    rc = create_thread( &tid, JOINABLE, gen_thread, gen, "hercnetgen" );
+    if (rc)
+    {
+        // "Error in function create_thread(): %s"
+        FWRMSG( stderr, HHC00102, "E", strerror( rc ));
+        free( frame );
+        return -1;
+    }
+
+    for (;;)
+    {
+        len = end_xfer( gen->rx, frame, GEN_MAXSIZE, 0, 100 );
+        now = now_usecs();
+        if (len > 0)
+        {
+            last = now;
+            rc = chk_frame( frame, len, gen->size, &seq );
+            if (rc < 0)
+                continue;               /* (not ours; ignore it)     */
+            rcvd++;
+            bytes += len;
+            if (rc > 0)
+                corrupt++;
+            if (seq < expect)
+                outseq++;               /* (gaps are lost frames)    */
+            else
+                expect = seq + 1;
+            continue;
+        }
+        if (len < 0 && errno != EAGAIN)
+            break;
+        if (gen->done
+            && (rcvd >= gen->sent - gen->dropped
+                || now - last >= (U64) secs * 1000000))
+            break;
+    }
+    join_thread( tid, NULL );
+
+    report( gen->name, "sent", gen->sent, gen->sentbytes,
+            gen->dropped, gen->usecs );
+    report( gen->name, "received", rcvd, bytes,
+            gen->sent - gen->dropped - min( rcvd, gen->sent - gen->dropped ),
+            last - start );
+    // "%s: %"PRIu64" frames out of sequence, %"PRIu64" frames corrupted"
+    WRMSG( HHC02814, outseq || corrupt ? "W" : "I", gen->name,
+           outseq, corrupt );
+
+    free( frame );
+    return (outseq || corrupt) ? 1 : 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Echo frames received from a QETH device back to it (layer 2: the  */
+/* MAC addresses are swapped) until the device closes the socket.    */
+/*-------------------------------------------------------------------*/
+static int run_echo( END* end )
+{
+    BYTE*  frame = malloc( GEN_MAXSIZE );
+    BYTE   mac[6];
+    U64    frames = 0, bytes = 0, start = 0, last = 0;
+    int    len;
+
+    while (frame && (len = end_xfer( end, frame, GEN_MAXSIZE, 0, 1000 )) != 0)
+    {
+        if (len < 0)
+        {
+            if (errno == EAGAIN)
+                continue;
+            break;
+        }
+        if (!frames)
+            start = now_usecs();
+        if (len >= 14)
+        {
+            memcpy( mac, frame, 6 );
+            memcpy( frame, frame + 6, 6 );
+            memcpy( frame + 6, mac, 6 );
+        }
+        if (end_xfer( end, frame, len, 1, 1000 ) < 0)
+            break;
+        frames++;
+        bytes += len;
+        last = now_usecs();
+    }
+    report( "echo", "echoed", frames, bytes, 0, last - start );
+    free( frame );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* hercnetgen main entry point                                       */
+/*-------------------------------------------------------------------*/
+int main( int argc, char* argv[] )
+{
+    char*   pgm;                        /* less any extension (.ext) */
+    char*   ifname = NULL;              /* -p interface name         */
+    char*   path   = NULL;              /* Socket path to serve      */
+    int     loop   = 0;                 /* -l loopback test          */
+    int     echo   = 0;                 /* -e echo mode              */
+    int     secs   = 1;                 /* -t straggler wait         */
+    NETBE   be;                         /* Backend under test        */
+    END     osa, host;                  /* The two ends of the link  */
+    GEN     gen;                        /* Generator parameters      */
+    int     i, rc, peerfd, lfd;
+
+    INITIALIZE_UTILITY( UTILITY_NAME, UTILITY_DESC, &pgm );
+
+    memset( &gen, 0, sizeof( gen ));
+    gen.frames = 1000000;
+    gen.size   = 1514;
+
+    for (i = 1; i < argc; i++)
+    {
+        if      (!strcmp( argv[i], "-l" ))
+            loop = 1;
+        else if (!strcmp( argv[i], "-e" ))
+            echo = 1;
+        else if (!strcmp( argv[i], "-p" ) && i+1 < argc)
+            ifname = argv[++i];
+        else if (!strcmp( argv[i], "-n" ) && i+1 < argc)
+            gen.frames = strtoull( argv[++i], NULL, 10 );
+        else if (!strcmp( argv[i], "-s" ) && i+1 < argc)
+            gen.size = atoi( argv[++i] );
+        else if (!strcmp( argv[i], "-t" ) && i+1 < argc)
+            secs = atoi( argv[++i] );
+        else if (argv[i][0] != '-' && !path)
+            path = argv[i];
+        else
+            break;
+    }
+    if (0
+        || i < argc
+        || (loop + !!ifname + !!path) != 1
+        || (echo && !path)
+        || gen.size < GEN_HDRLEN || gen.size > GEN_MAXSIZE
+        || secs < 0
+    )
+    {
+        // "Usage: %s [options] { -l | -p ifname | path }"
+        WRMSG( HHC02810, "I", pgm );
+        return 1;
+    }
+
+    memset( &be, 0, sizeof( be ));
+    osa.be  = host.be = NULL;
+    osa.fd  = host.fd = -1;
+
+    if (loop)
+    {
+        /* The adapter's end is the backend; ours is the socket's peer */
+        if (NETBE_SocketPair( &be, &peerfd ) != 0)
+        {
+            // "Error in function %s: %s"
+            FWRMSG( stderr, HHC00075, "E", "NETBE_SocketPair()", strerror( errno ));
+            return 2;
+        }
+        socket_set_blocking_mode( be.fd,  0 );
+        socket_set_blocking_mode( peerfd, 0 );
+        osa.be  = &be;
+        host.fd = peerfd;
+
+        gen.name = "input";             /* host -> adapter           */
+        gen.tx   = &host;
+        gen.rx   = &osa;
+        rc = run_test( &gen, secs );
+
+        gen.name = "output";            /* adapter -> host           */
+        gen.tx   = &osa;
+        gen.rx   = &host;
+        rc |= run_test( &gen, secs );
+
+        NETBE_Close( &be );
+        close( peerfd );
+        return rc;
+    }
+
+    if (ifname)
+    {
+        /* Frames sent on the interface come back to us (e.g. "lo") */
+        if (!(be.hnd = NETBE_Find( "packet" ))
+            || NETBE_Open( &be, ifname, 0 ) != 0)
+        {
+            // "Error in function %s: %s"
+            FWRMSG( stderr, HHC00075, "E", "NETBE_Open()",
+                be.hnd ? strerror( errno ) : "packet backend not available" );
+            return 2;
+        }
+        socket_set_blocking_mode( be.fd, 0 );
+        osa.be   = &be;
+        gen.name = ifname;
+        gen.tx   = &osa;
+        gen.rx   = &osa;
+        rc = run_test( &gen, secs );
+        NETBE_Close( &be );
+        return rc;
+    }
+
+    /* Serve a QETH device defined with "backend socket <path>" */
+    {
+        struct sockaddr_un  sun;
+
+        memset( &sun, 0, sizeof( sun ));
+        sun.sun_family = AF_UNIX;
+        STRLCPY( sun.sun_path, path );
+        unlink( path );
+
+        if (0
+            || (lfd = socket( AF_UNIX, SOCK_SEQPACKET, 0 )) < 0
+            || bind( lfd, (struct sockaddr*) &sun, sizeof( sun )) < 0
+            || listen( lfd, 1 ) < 0
+        )
+        {
+            // "Error in function %s: %s"
+            FWRMSG( stderr, HHC00075, "E", "socket()", strerror( errno ));
+            return 2;
+        }
+        // "Waiting for a connection on %s"
+        WRMSG( HHC02811, "I", path );
+        host.fd = accept( lfd, NULL, NULL );
+        close( lfd );
+        unlink( path );
+        if (host.fd < 0)
+        {
+            // "Error in function %s: %s"
+            FWRMSG( stderr, HHC00075, "E", "accept()", strerror( errno ));
+            return 2;
+        }
+        socket_set_blocking_mode( host.fd, 0 );
+
+        if (echo)
+            rc = run_echo( &host );
+        else
+        {
+            gen.name = path;
+            gen.tx   = &host;
+            gen.rx   = &host;
+            rc = run_test( &gen, secs );
+        }
+        close( host.fd );
+    }
+    return rc;
+}
+
+#else /* !defined( TUNTAP_NETBE ) */
+
+int main( int argc, char* argv[] )
+{
+    char* pgm;
+
+    INITIALIZE_UTILITY( UTILITY_NAME, UTILITY_DESC, &pgm );
+
+    // "Error in function %s: %s"
+    FWRMSG( stderr, HHC00075, "E", pgm, "network backends not supported" );
+    return 2;
+}
+
+#endif /* defined( TUNTAP_NETBE ) */
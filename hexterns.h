@@ -257,6 +257,9 @@ void* timer_thread( void* argp );
 void* rubato_thread( void* argp );
 #endif
 
+/* Functions in module profile.c */
+void profile_sample( U64 now );
+
 /* Functions in module clock.c */
 void update_TOD_clock (void);
 int configure_epoch(int);
@@ -858,25 +858,49 @@ int log_cmd(int argc, char *argv[], char *cmdline)
 /*-------------------------------------------------------------------*/
 /* logopt command - change log options                               */
 /*-------------------------------------------------------------------*/
+static void logopt_fmt( char* buf, size_t bufsz, bool bDateStamp,
+                        bool bTimeStamp, bool bDrop, U32 nWait )
+{
+    char full[16];
+
+    if (bDrop)
+        STRLCPY( full, "DROP" );
+    else
+        MSGBUF( full, "BLOCK=%u", nWait );
+
+    snprintf( buf, bufsz, "%s %s %s"
+        , bDateStamp ? "DATESTAMP" : "NODATESTAMP"
+        , bTimeStamp ? "TIMESTAMP" : "NOTIMESTAMP"
+        , full
+    );
+}
+
 int logopt_cmd( int argc, char* argv[], char* cmdline)
 {
     int i, rc = 0;
     char buf[64];
     bool bDateStamp = !sysblk.logoptnodate;
     bool bTimeStamp = !sysblk.logoptnotime;
+    bool bDrop      =  sysblk.logoptdrop;
+    U32  nWait      =  sysblk.logoptwait;
 
     UNREFERENCED( cmdline );
     UPPER_ARGV_0( argv );
 
     if (argc <= 1)
     {
-        MSGBUF( buf, "%s %s"
-            , bDateStamp ? "DATESTAMP" : "NODATESTAMP"
-            , bTimeStamp ? "TIMESTAMP" : "NOTIMESTAMP"
-        );
+        U64 msgs, dropped, blocked;
+        U32 inuse;
+
+        logopt_fmt( buf, sizeof( buf ), bDateStamp, bTimeStamp, bDrop, nWait );
 
         // "%-14s: %s"
         WRMSG( HHC02203, "I", argv[0], buf );
+
+        log_ringstats( &msgs, &dropped, &blocked, &inuse );
+
+        // "Logger: ring %u of %u slots in use; %"PRIu64" messages, %"PRIu64" dropped, %"PRIu64" waited for room"
+        WRMSG( HHC02103, "I", inuse, LOG_RINGSLOTS, msgs, dropped, blocked );
         return 0;
     }
 
@@ -904,6 +928,25 @@ int logopt_cmd( int argc, char* argv[], char* cmdline)
             bTimeStamp = false;
             continue;
         }
+        if (CMD( argv[i], DROP, 4 ))
+        {
+            bDrop = true;
+            continue;
+        }
+        if (CMD( argv[i], BLOCK, 5 ))
+        {
+            bDrop = false;
+            continue;
+        }
+        if (strncasecmp( argv[i], "BLOCK=", 6 ) == 0)
+        {
+            char c;
+            if (sscanf( argv[i] + 6, "%u%c", &nWait, &c ) == 1)
+            {
+                bDrop = false;
+                continue;
+            }
+        }
 
         // "Invalid argument %s%s"
         WRMSG( HHC02205, "E", argv[i], "" );
@@ -912,11 +955,10 @@ int logopt_cmd( int argc, char* argv[], char* cmdline)
 
     sysblk.logoptnodate = !bDateStamp;
     sysblk.logoptnotime = !bTimeStamp;
+    sysblk.logoptdrop   =  bDrop;
+    sysblk.logoptwait   =  nWait;
 
-    MSGBUF( buf, "%s %s"
-        , bDateStamp ? "DATESTAMP" : "NODATESTAMP"
-        , bTimeStamp ? "TIMESTAMP" : "NOTIMESTAMP"
-    );
+    logopt_fmt( buf, sizeof( buf ), bDateStamp, bTimeStamp, bDrop, nWait );
 
     // "%-14s set to %s"
     WRMSG( HHC02204, "I", argv[0], buf );
@@ -2395,7 +2437,7 @@ int ctc_cmd( int argc, char *argv[], char *cmdline )
 }
 
 /*-------------------------------------------------------------------*/
-/* ptp command - enable/disable PTP debugging                        */
+/* ptp command - enable/disable PTP debugging, display statistics   */
 /*-------------------------------------------------------------------*/
 int ptp_cmd( int argc, char *argv[], char *cmdline )
 {
@@ -2572,6 +2614,96 @@ int ptp_cmd( int argc, char *argv[], char *cmdline )
         return 0;
     }
 
+    // Format:  "ptp  stats  [ <devnum>|ALL ]"
+
+    if ( argc >= 2 && CMD(argv[1],stats,5) )
+    {
+        PTPATH*  pPTPATHre;
+        PTPATH*  pPTPATHwr;
+        BYTE     found = FALSE;
+
+        pDEVGRP = NULL;
+        if ( argc == 3 )
+        {
+            if ( CMD(argv[2],all,3) )
+            {
+                pDEVGRP = NULL;
+            }
+            else if ( parse_single_devnum( argv[2], &lcss, &devnum) == 0 )
+            {
+                if ( !(dev = find_device_by_devnum( lcss, devnum )) )
+                {
+                    // HHC02200 "%1d:%04X device not found"
+                    devnotfound_msg( lcss, devnum );
+                    return -1;
+                }
+
+                if ( !dev->allocated ||
+                     dev->devtype != 0x3088 ||
+                     dev->ctctype != CTC_PTP )
+                {
+                    // HHC02209 "%1d:%04X device is not a '%s'"
+                    WRMSG(HHC02209, "E", lcss, devnum, "PTP" );
+                    return -1;
+                }
+                pDEVGRP = dev->group;
+            }
+            else
+            {
+                // HHC02299 "Invalid command usage. Type 'help %s' for assistance."
+                WRMSG( HHC02299, "E", argv[0] );
+                return -1;
+            }
+        }
+        else if ( argc > 3 )
+        {
+            // HHC02299 "Invalid command usage. Type 'help %s' for assistance."
+            WRMSG( HHC02299, "E", argv[0] );
+            return -1;
+        }
+
+        for ( pDEVBLK = sysblk.firstdev; pDEVBLK; pDEVBLK = pDEVBLK->nextdev )
+        {
+            // Display each complete PTP device group once, when its
+            // read device is reached.
+            if ( !pDEVBLK->allocated ||
+                 pDEVBLK->devtype != 0x3088 ||
+                 pDEVBLK->ctctype != CTC_PTP ||
+                 !pDEVBLK->group ||
+                 !pDEVBLK->group->grp_data ||
+                 pDEVBLK != pDEVBLK->group->memdev[0] )
+                continue;
+            if ( pDEVGRP && pDEVBLK->group != pDEVGRP )
+                continue;
+
+            found = TRUE;
+            pPTPBLK = pDEVBLK->group->grp_data;
+            pPTPATHre = pPTPBLK->pPTPATHRead;
+            pPTPATHwr = pPTPBLK->pPTPATHWrite;
+
+            // HHC02351 "%s device %1d:%04X group read path: ..."
+            WRMSG(HHC02351, "I", pDEVBLK->typname, SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
+                      pPTPATHre->uBlocks, pPTPATHre->uPackets, pPTPATHre->uBytes,
+                      pPTPATHre->uDropped, pPTPATHre->uWakeups );
+            // HHC02352 "%s device %1d:%04X group write path: ..."
+            WRMSG(HHC02352, "I", pDEVBLK->typname, SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
+                      pPTPATHwr->uBlocks, pPTPATHwr->uPackets, pPTPATHwr->uBytes,
+                      pPTPATHwr->uDropped );
+            // HHC02353 "%s device %1d:%04X group buffer pool: ..."
+            WRMSG(HHC02353, "I", pDEVBLK->typname, SSID_TO_LCSS(pDEVBLK->ssid), pDEVBLK->devnum,
+                      pPTPBLK->iFreePTPHDR, pPTPBLK->pPoolSlab ? PTP_POOL_SLAB : 0,
+                      pPTPBLK->uPoolMisses );
+        }
+
+        if (!found)
+        {
+            // HHC02347 "No %s devices found"
+            WRMSG( HHC02347, "I", "PTP" );
+        }
+
+        return 0;
+    }
+
     // HHC02299 "Invalid command usage. Type 'help %s' for assistance."
     WRMSG( HHC02299, "E", argv[0] );
     return -1;
@@ -2603,6 +2735,7 @@ int qeth_cmd( int argc, char *argv[], char *cmdline )
 
     // Format:  "QETH  DEBUG  {ON|OFF}  [ [<devnum>|ALL] [mask ...] ]"
     // Format:  "QETH  ADDR             [ [<devnum>|ALL]            ]"
+    // Format:  "QETH  STATS            [ [<devnum>|ALL]            ]"
 
     if ( argc >= 2 && CMD(argv[1],debug,5) )
     {
@@ -2806,7 +2939,7 @@ int qeth_cmd( int argc, char *argv[], char *cmdline )
         return 0;
     }
 
-    if ( CMD(argv[1],addr,4) )
+    if ( CMD(argv[1],addr,4) || CMD(argv[1],stats,5) )
     {
 
         if ( argc < 3 )
@@ -2877,6 +3010,30 @@ int qeth_cmd( int argc, char *argv[], char *cmdline )
                   found = TRUE;
                   numaddr = 0;
 
+                  /* Or display its packet and interrupt rates instead. */
+                  if (CMD(argv[1],stats,5))
+                  {
+                    if (!grp->iceffpkts && !grp->iceffusecs)
+                      STRLCPY( charaddr, "off" );
+                    else
+                      MSGBUF( charaddr, "%u packets, %u usecs",
+                                grp->iceffpkts, grp->iceffusecs );
+                    // "%s device %1d:%04X group rates: read %u/s, written %u/s, interrupts %u/s"
+                    WRMSG(HHC02348, "I", dev->typname, LCSS_DEVNUM,
+                              grp->rxrate, grp->txrate, grp->intrate );
+                    // "%s device %1d:%04X group totals: read %u, written %u, dropped %u, interrupts %u, coalesced %u; coalescing %s%s"
+                    WRMSG(HHC02349, "I", dev->typname, LCSS_DEVNUM,
+                              dev->qdio.rxcnt, dev->qdio.txcnt, dev->qdio.dropcnt,
+                              grp->intcnt, grp->iccnt, charaddr,
+                              grp->icadapt ? " (adaptive)" : "" );
+                    WRMSG(HHC02350, "I", dev->typname, LCSS_DEVNUM,
+                              grp->siglatcnt ? (unsigned)(grp->siglatsum / grp->siglatcnt) : 0,
+                              grp->siglatmax, grp->siglatcnt,
+                              grp->epfd >= 0 ? "eventfd/epoll" :
+                              grp->efd  >= 0 ? "eventfd/select" : "pipe/select" );
+                    continue;
+                  }
+
                   /* Display registered MAC addresses. */
                   for (i = 0; i < OSA_MAXMAC; i++)
                   {
@@ -4142,6 +4299,52 @@ int cnslport_cmd(int argc, char *argv[], char *cmdline)
     return rc;
 }
 
+/*-------------------------------------------------------------------*/
+/* cnslthreads command - set number of console I/O threads           */
+/*-------------------------------------------------------------------*/
+int cnslthreads_cmd( int argc, char* argv[], char* cmdline )
+{
+    char  buf[16];
+    char  c;
+    int   n;
+
+    UNREFERENCED( cmdline );
+
+    if (argc > 2)
+    {
+        // "Invalid number of arguments for %s"
+        WRMSG( HHC01455, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc == 1)
+    {
+        MSGBUF( buf, "%d", sysblk.cnslthreads );
+        // "%-14s: %s"
+        WRMSG( HHC02203, "I", argv[0], buf );
+        return 0;
+    }
+
+    if (0
+        || sscanf( argv[1], "%d%c", &n, &c ) != 1
+        || n < 1
+        || n > MAX_CNSLTHREADS
+    )
+    {
+        // "Invalid value %s specified for %s"
+        WRMSG( HHC01451, "E", argv[1], argv[0] );
+        return -1;
+    }
+
+    sysblk.cnslthreads = n;
+
+    MSGBUF( buf, "%d", n );
+    // "%-14s set to %s"
+    WRMSG( HHC02204, "I", argv[0], buf );
+
+    return 0;
+}
+
 /*-------------------------------------------------------------------*/
 /* http command - manage HTTP server                                 */
 /*-------------------------------------------------------------------*/
@@ -5868,6 +6071,238 @@ int devlist_cmd( int argc, char* argv[], char* cmdline )
     return 0;
 }
 
+/*-------------------------------------------------------------------*/
+/* iolat command helper functions                                    */
+/*-------------------------------------------------------------------*/
+struct IOLATENT                         /* One line of iolat display */
+{
+    U16         lcss;                   /* Channel subsystem         */
+    U16         devnum;                 /* Device number             */
+    int         ndevs;                  /* Number of devices summed  */
+    char        type[8];                /* Device type name          */
+    IOLAT       lat;                    /* Copy of their statistics  */
+};
+typedef struct IOLATENT IOLATENT;
+
+static int iolat_sort( const void* p1, const void* p2 )
+{
+    const IOLATENT*  e1 = p1;
+    const IOLATENT*  e2 = p2;
+
+    if (e1->lcss != e2->lcss)
+        return (int) e1->lcss - (int) e2->lcss;
+    return (int) e1->devnum - (int) e2->devnum;
+}
+
+static void iolat_sum( IOLAT_HIST* to, const IOLAT_HIST* from )
+{
+    int  i;
+
+    to->count    += from->count;
+    to->sumusecs += from->sumusecs;
+    for (i=0; i < IOLAT_BUCKETS; i++)
+        to->bucket[i] += from->bucket[i];
+}
+
+/* Upper bound of the histogram bucket the given percentile is in    */
+static void iolat_pct( char* buf, size_t bufsz, const IOLAT_HIST* h, int pct )
+{
+    U64  want = (h->count * pct + 99) / 100;
+    U64  seen = 0;
+    int  i;
+
+    for (i=0; i < IOLAT_BUCKETS-1; i++)
+        if ((seen += h->bucket[i]) >= want)
+            break;
+
+    if (i < IOLAT_BUCKETS-1)
+        snprintf( buf, bufsz, "%"PRIu64, (U64) 1 << i );
+    else
+        snprintf( buf, bufsz, ">%"PRIu64, (U64) 1 << (IOLAT_BUCKETS-2) );
+}
+
+/* "average/median/99th percentile" of a histogram                   */
+static char* iolat_fmt( char* buf, size_t bufsz, const IOLAT_HIST* h )
+{
+    char  avg[24], p50[24], p99[24];
+
+    if (!h->count)
+    {
+        STRLCPY( avg, "-" );
+        STRLCPY( p50, "-" );
+        STRLCPY( p99, "-" );
+    }
+    else
+    {
+        MSGBUF( avg, "%"PRIu64, h->sumusecs / h->count );
+        iolat_pct( p50, sizeof( p50 ), h, 50 );
+        iolat_pct( p99, sizeof( p99 ), h, 99 );
+    }
+    snprintf( buf, bufsz, "%7s/%7s/%9s", avg, p50, p99 );
+    return buf;
+}
+
+/*-------------------------------------------------------------------*/
+/* iolat command - display device I/O latency statistics             */
+/*-------------------------------------------------------------------*/
+int iolat_cmd( int argc, char* argv[], char* cmdline )
+{
+    DEVBLK*    dev;
+    IOLATENT*  ents;
+    IOLATENT*  e;
+    U16        lcss = 0;
+    U16        devnum = 0;
+    int        ndevs, n, i, j;
+    bool       bycu   = false;
+    bool       single = false;
+    char       name[16], type[16];
+    char       queue[48], exec[48], intr[48];
+
+    UNREFERENCED( cmdline );
+    UPPER_ARGV_0( argv );
+
+    // Format:  "iolat [devn | CU | RESET]"
+
+    if (argc > 2)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        if (CMD( argv[1], RESET, 5 ))
+        {
+            for (dev = sysblk.firstdev; dev; dev = dev->nextdev)
+            {
+                obtain_lock( &dev->lock );
+                {
+                    memset( &dev->iolat.queue, 0, sizeof( IOLAT_HIST ));
+                    memset( &dev->iolat.exec,  0, sizeof( IOLAT_HIST ));
+                    memset( &dev->iolat.intr,  0, sizeof( IOLAT_HIST ));
+                }
+                release_lock( &dev->lock );
+            }
+            // "I/O latency statistics reset"
+            WRMSG( HHC02836, "I" );
+            return 0;
+        }
+
+        if (CMD( argv[1], CU, 2 ))
+            bycu = true;
+        else
+        {
+            if (parse_single_devnum( argv[1], &lcss, &devnum ) < 0)
+            {
+                // (error message already issued)
+                return -1;
+            }
+            if (!find_device_by_devnum( lcss, devnum ))
+            {
+                // HHC02200 "%1d:%04X device not found"
+                devnotfound_msg( lcss, devnum );
+                return -1;
+            }
+            single = true;
+        }
+    }
+
+    for (ndevs = 0, dev = sysblk.firstdev; dev; dev = dev->nextdev)
+        ndevs++;
+
+    if (!(ents = calloc( ndevs ? ndevs : 1, sizeof( IOLATENT ))))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC02219, "E", "calloc()", strerror( errno ));
+        return -1;
+    }
+
+    /* Copy the statistics of each device (that did any I/O) */
+    for (n = 0, dev = sysblk.firstdev; dev && n < ndevs; dev = dev->nextdev)
+    {
+        if (!dev->allocated)
+            continue;
+
+        if (single && (SSID_TO_LCSS( dev->ssid ) != lcss || dev->devnum != devnum))
+            continue;
+
+        e = &ents[n];
+
+        obtain_lock( &dev->lock );
+        {
+            e->lat = dev->iolat;
+        }
+        release_lock( &dev->lock );
+
+        if (!single && !e->lat.queue.count && !e->lat.exec.count)
+            continue;
+
+        e->lcss   = SSID_TO_LCSS( dev->ssid );
+        e->devnum = dev->devnum;
+        e->ndevs  = 1;
+        STRLCPY( e->type, dev->typname );
+        n++;
+    }
+
+    qsort( ents, n, sizeof( IOLATENT ), iolat_sort );
+
+    /* Sum the devices of each control unit */
+    if (bycu && n)
+    {
+        for (i = 0, j = 1; j < n; j++)
+        {
+            if (ents[j].lcss == ents[i].lcss
+                && (ents[j].devnum >> 8) == (ents[i].devnum >> 8))
+            {
+                iolat_sum( &ents[i].lat.queue, &ents[j].lat.queue );
+                iolat_sum( &ents[i].lat.exec,  &ents[j].lat.exec  );
+                iolat_sum( &ents[i].lat.intr,  &ents[j].lat.intr  );
+                ents[i].ndevs++;
+            }
+            else
+                ents[++i] = ents[j];
+        }
+        n = i + 1;
+    }
+
+    if (!n)
+    {
+        // "No I/O latency has been measured"
+        WRMSG( HHC02837, "I" );
+        free( ents );
+        return 0;
+    }
+
+    // "I/O latency in usecs by %s: count, then average/median/99th percentile of queue, exec and intr"
+    WRMSG( HHC02834, "I", bycu ? "control unit" : "device" );
+
+    for (i = 0; i < n; i++)
+    {
+        e = &ents[i];
+
+        if (bycu)
+        {
+            MSGBUF( name, "%1d:%02Xxx", e->lcss, e->devnum >> 8 );
+            MSGBUF( type, "%d dev", e->ndevs );
+        }
+        else
+        {
+            MSGBUF( name, "%1d:%04X", e->lcss, e->devnum );
+            STRLCPY( type, e->type );
+        }
+
+        // "%-7s %-6s %10"PRIu64"  queue %s  exec %s  intr %s"
+        WRMSG( HHC02835, "I", name, type, e->lat.exec.count,
+            iolat_fmt( queue, sizeof( queue ), &e->lat.queue ),
+            iolat_fmt( exec,  sizeof( exec  ), &e->lat.exec  ),
+            iolat_fmt( intr,  sizeof( intr  ), &e->lat.intr  ));
+    }
+
+    free( ents );
+    return 0;
+}
+
 /*-------------------------------------------------------------------*/
 /* qd command - query device information                             */
 /*-------------------------------------------------------------------*/
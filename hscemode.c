@@ -2215,6 +2215,84 @@ int i_cmd( int argc, char* argv[], char* cmdline )
 
 
 #if defined( OPTION_INSTRUCTION_COUNTING )
+/*-------------------------------------------------------------------*/
+/* Allocate each CPU's own instruction counting table                */
+/*-------------------------------------------------------------------*/
+static bool icount_alloc()
+{
+    int cpu;
+
+    /* Tables are never freed once allocated since a CPU thread might
+       still be using its table at the moment counting is disabled */
+    for (cpu = 0; cpu < sysblk.maxcpu; cpu++)
+    {
+        if (!sysblk.icountcpu[ cpu ])
+        {
+            ICOUNT_CPU* ic = calloc( 1, sizeof( ICOUNT_CPU ));
+
+            if (!ic)
+            {
+                // "Error in function %s: %s"
+                WRMSG( HHC00075, "E", "calloc()", strerror( errno ));
+                return false;
+            }
+            ic->skip = 1;
+            sysblk.icountcpu[ cpu ] = ic;
+        }
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* True if no CPU has counted the instruction in count slot i yet,   */
+/* i.e. it is being used for the first time by any CPU. Only called  */
+/* by ICOUNT_INST when the executing CPU's own slot is still zero,   */
+/* so "First use" is reported once per opcode, not once per CPU.     */
+/*-------------------------------------------------------------------*/
+bool icount_first_use( size_t i )
+{
+    int cpu;
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        ICOUNT_CPU* ic = sysblk.icountcpu[ cpu ];
+
+        if (ic && ((const U64*) &ic->count)[i])
+            return false;
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Sum all CPUs' counts (and times) into a single pair of maps       */
+/*-------------------------------------------------------------------*/
+static void icount_sum( ICOUNT_MAP* count, ICOUNT_MAP* time )
+{
+    const size_t n = sizeof( ICOUNT_MAP ) / sizeof( U64 );
+    size_t i;
+    int cpu;
+
+    memset( count, 0, sizeof( ICOUNT_MAP ));
+    memset( time,  0, sizeof( ICOUNT_MAP ));
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        ICOUNT_CPU* ic = sysblk.icountcpu[ cpu ];
+
+        if (ic)
+        {
+            const U64* c = (const U64*) &ic->count;
+            const U64* t = (const U64*) &ic->time;
+
+            for (i=0; i < n; i++)
+            {
+                ((U64*) count)[i] += c[i];
+                ((U64*) time )[i] += t[i];
+            }
+        }
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /* icount command - display instruction counts                       */
 /*-------------------------------------------------------------------*/
@@ -2226,31 +2304,86 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
                                      in architecture instruction set */
     U64  total;
     U64  count[ MAX_ICOUNT_INSTR ];
+    U64  time [ MAX_ICOUNT_INSTR ];
 
     unsigned char opcode1[ MAX_ICOUNT_INSTR ];
     unsigned char opcode2[ MAX_ICOUNT_INSTR ];
 
+    ICOUNT_MAP*  sum;               /* All CPUs' counts combined     */
+    ICOUNT_MAP*  tim;               /* All CPUs' times combined      */
+
     char buf[ 128 ];
+    char avg[ 64 ];
 
     UNREFERENCED( cmdline );
 
     UPPER_ARGV_0( argv );
 
-    if (argc > 1)
+    if (argc > 2)
     {
-        if (argc > 2)
+        if (argc > 3)
         {
             // "Invalid argument(s). Type 'help %s' for assistance."
             WRMSG( HHC02211, "E", argv[0] );
             return -1;
         }
+        if (CMD( argv[1], SAMPLE, 2 ))
+        {
+            U32   rate;
+            BYTE  c;
+
+            if (0
+                || sscanf( argv[2], "%u%c", &rate, &c ) != 1
+                || rate < 1
+            )
+            {
+                // "Invalid argument %s%s"
+                WRMSG( HHC02205, "E", argv[2], "" );
+                return -1;
+            }
+            sysblk.icountrate = rate;
+            MSGBUF( buf, "1 in %u", rate );
+            // "%-14s set to %s"
+            WRMSG( HHC02204, "I", "icount sample", buf );
+            return 0;
+        }
+        if (CMD( argv[1], TIME, 1 ))
+        {
+            if (CMD( argv[2], ON, 2 ))
+                sysblk.icounttime = true;
+            else if (CMD( argv[2], OFF, 2 ))
+                sysblk.icounttime = false;
+            else
+            {
+                // "Invalid argument %s%s"
+                WRMSG( HHC02205, "E", argv[2], "" );
+                return -1;
+            }
+            // "%-14s set to %s"
+            WRMSG( HHC02204, "I", "icount time", sysblk.icounttime ? "ON" : "OFF" );
+            return 0;
+        }
+        // "Invalid argument %s%s"
+        WRMSG( HHC02205, "E", argv[1], "" );
+        return -1;
+    }
+
+    if (argc > 1)
+    {
         if (0
             || CMD( argv[1], CLEAR, 1 )
             || CMD( argv[1], RESET, 1 )
             || CMD( argv[1], ZERO,  1 )
         )
         {
-            memset( IMAP_FIRST, 0, IMAP_SIZE );
+            for (i=0; i < MAX_CPU_ENGS; i++)
+            {
+                if (sysblk.icountcpu[i])
+                {
+                    memset( &sysblk.icountcpu[i]->count, 0, sizeof( ICOUNT_MAP ));
+                    memset( &sysblk.icountcpu[i]->time,  0, sizeof( ICOUNT_MAP ));
+                }
+            }
             // "%-14s set to %s"
             WRMSG( HHC02204, "I", argv[0], "ZERO" );
             return 0;
@@ -2260,6 +2393,14 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
             || CMD( argv[1], START,  3 )
         )
         {
+            if (!icount_alloc())
+                return -1;
+
+            /* Discard any timing left pending from an earlier run */
+            for (i=0; i < MAX_CPU_ENGS; i++)
+                if (sysblk.icountcpu[i])
+                    sysblk.icountcpu[i]->tslot = NULL;
+
             sysblk.icount = true;
             // "%-14s set to %s"
             WRMSG( HHC02204, "I", argv[0], "ENABLE" );
@@ -2282,9 +2423,19 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
 
     /* Display sorted counts... */
 
+    if (!(sum = malloc( 2 * sizeof( ICOUNT_MAP ))))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "malloc()", strerror( errno ));
+        return -1;
+    }
+    tim = sum + 1;
+    icount_sum( sum, tim );
+
     memset( opcode1, 0, sizeof( opcode1 ));
     memset( opcode2, 0, sizeof( opcode2 ));
     memset( count,   0, sizeof( count   ));
+    memset( time,    0, sizeof( time    ));
 
     /* (collect...) */
 
@@ -2301,17 +2452,19 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
         {                                                   \
           for (i2=0; i2 < _nn; i2++)                        \
           {                                                 \
-            if (sysblk._map[ i2 ])                          \
+            if (sum->_map[ i2 ])                            \
             {                                               \
               opcode1[ i ] = i1;                            \
               opcode2[ i ] = i2;                            \
-              count[ i++ ] = sysblk._map[ i2 ];             \
-              total += sysblk._map[ i2 ];                   \
+              time [ i   ] = tim->_map[ i2 ];               \
+              count[ i++ ] = sum->_map[ i2 ];               \
+              total += sum->_map[ i2 ];                     \
                                                             \
               if (i == (MAX_ICOUNT_INSTR - 1))              \
               {                                             \
                 /* "Too many instructions! (Sorry!)" */     \
                 WRMSG( HHC02252, "E" );                     \
+                free( sum );                                \
                 return -1;                                  \
               }                                             \
             }                                               \
@@ -2321,7 +2474,7 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
 
         ICOUNT_COLLECT_CASE( 0x01, imap01, 256 )
         ICOUNT_COLLECT_CASE( 0xA4, imapa4, 256 )
-        ICOUNT_COLLECT_CASE( 0xA5, imapa5, 256 )
+        ICOUNT_COLLECT_CASE( 0xA5, imapa5,  16 )
         ICOUNT_COLLECT_CASE( 0xA6, imapa6, 256 )
         ICOUNT_COLLECT_CASE( 0xA7, imapa7,  16 )
         ICOUNT_COLLECT_CASE( 0xB2, imapb2, 256 )
@@ -2341,17 +2494,19 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
 
         default:
         {
-          if (sysblk.imapxx[ i1 ])
+          if (sum->imapxx[ i1 ])
           {
             opcode1[ i ] = i1;
             opcode2[ i ] = 0;
-            count[ i++ ] = sysblk.imapxx[ i1 ];
-            total += sysblk.imapxx[ i1 ];
+            time [ i   ] = tim->imapxx[ i1 ];
+            count[ i++ ] = sum->imapxx[ i1 ];
+            total += sum->imapxx[ i1 ];
 
             if (i == (MAX_ICOUNT_INSTR - 1))
             {
                 // "Too many instructions! (Sorry!)"
                 WRMSG( HHC02252, "E" );
+                free( sum );
                 return -1;
             }
           }
@@ -2360,6 +2515,8 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
       }
     }
 
+    free( sum );
+
     /* (sort...) */
 
     for (i1=0; i1 < i; i1++)
@@ -2377,25 +2534,39 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
       opcode1[ (MAX_ICOUNT_INSTR - 1) ] = opcode1[ i1 ];
       opcode2[ (MAX_ICOUNT_INSTR - 1) ] = opcode2[ i1 ];
       count  [ (MAX_ICOUNT_INSTR - 1) ] = count  [ i1 ];
+      time   [ (MAX_ICOUNT_INSTR - 1) ] = time   [ i1 ];
 
       opcode1[ i1 ] = opcode1[ i3 ];
       opcode2[ i1 ] = opcode2[ i3 ];
       count  [ i1 ] = count  [ i3 ];
+      time   [ i1 ] = time   [ i3 ];
 
       opcode1[ i3 ] = opcode1[ (MAX_ICOUNT_INSTR - 1) ];
       opcode2[ i3 ] = opcode2[ (MAX_ICOUNT_INSTR - 1) ];
       count  [ i3 ] = count  [ (MAX_ICOUNT_INSTR - 1) ];
+      time   [ i3 ] = time   [ (MAX_ICOUNT_INSTR - 1) ];
     }
 
 #define  ICOUNT_WIDTH  "12"     /* Print field width */
 
     /* (print...) */
 
+    if (sysblk.icountrate > 1)
+        MSGBUF( buf, "Sorted icount display (sampled 1 in %u):", sysblk.icountrate );
+    else
+        STRLCPY( buf, "Sorted icount display:" );
     // "%s"
-    WRMSG( HHC02292, "I", "Sorted icount display:" );
+    WRMSG( HHC02292, "I", buf );
 
     for (i1=0; i1 < i; i1++)
     {
+      /* Average time per instruction, if any were timed */
+      if (time[ i1 ])
+        MSGBUF( avg, " avg %6" PRIu64 " " ICOUNT_CLOCK_UNITS,
+          time[ i1 ] / count[ i1 ] );
+      else
+        avg[0] = 0;
+
       switch (opcode1[ i1 ])
       {
         case 0x01:
@@ -2420,10 +2591,11 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
         {
           MSGBUF
           (
-            buf, "Inst '%2.2X%2.2X' count %" ICOUNT_WIDTH PRIu64 " (%2d%%)",
+            buf, "Inst '%2.2X%2.2X' count %" ICOUNT_WIDTH PRIu64 " (%2d%%)%s",
             opcode1[ i1 ], opcode2[ i1 ],
             count[ i1 ],
-            (int) (count[ i1 ] * 100 / total)
+            (int) (count[ i1 ] * 100 / total),
+            avg
           );
           // "%s"
           WRMSG( HHC02292, "I", buf );
@@ -2433,9 +2605,10 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
         {
           MSGBUF
           (
-            buf, "Inst '%2.2X'   count %" ICOUNT_WIDTH PRIu64 " (%2d%%)",
+            buf, "Inst '%2.2X'   count %" ICOUNT_WIDTH PRIu64 " (%2d%%)%s",
             opcode1[ i1 ], count[ i1 ],
-            (int) (count[ i1 ] * 100 / total)
+            (int) (count[ i1 ] * 100 / total),
+            avg
           );
           // "%s"
           WRMSG( HHC02292, "I", buf );
@@ -2448,6 +2621,250 @@ int icount_cmd( int argc, char* argv[], char* cmdline )
 }
 #endif /* defined( OPTION_INSTRUCTION_COUNTING ) */
 
+#if defined( OPTION_EMULATION_STATS )
+/*-------------------------------------------------------------------*/
+/* Emulator statistics counters, their names and display headings    */
+/*-------------------------------------------------------------------*/
+static const struct
+{
+    size_t       offset;                /* Offset into EMU_STATS     */
+    const char*  name;                  /* Name for DUMP file        */
+    const char*  heading;               /* Display column heading    */
+}
+emustat_tab[] =
+{
+    { offsetof( EMU_STATS, tlbhit    ), "tlbhit",    "TLB hits"     },
+    { offsetof( EMU_STATS, tlbmiss   ), "tlbmiss",   "TLB misses"   },
+    { offsetof( EMU_STATS, instfetch ), "instfetch", "Instfetch"    },
+    { offsetof( EMU_STATS, crosspage ), "crosspage", "Page crosses" },
+    { offsetof( EMU_STATS, progjmp   ), "progjmp",   "Progjmp exits"},
+};
+
+#define EMUSTAT_CTR( _st, _i ) \
+    (*(U64*)((BYTE*)(_st) + emustat_tab[ (_i) ].offset))
+
+static EMU_STATS  emustat_snap[ MAX_CPU_ENGS ]; /* SNAP counters     */
+static bool       emustat_snapped;              /* SNAP was done     */
+
+/*-------------------------------------------------------------------*/
+/* Get (and optionally reset) one CPU's counters, which include its  */
+/* SIE guest's. Returns false if the CPU is not configured.          */
+/*-------------------------------------------------------------------*/
+static bool emustat_get( int cpu, EMU_STATS* st, bool reset )
+{
+    REGS*  regs;
+    size_t i;
+
+    memset( st, 0, sizeof( EMU_STATS ));
+
+    obtain_lock( &sysblk.cpulock[ cpu ]);
+    {
+        if (!IS_CPU_ONLINE( cpu ))
+        {
+            release_lock( &sysblk.cpulock[ cpu ]);
+            return false;
+        }
+        regs = sysblk.regs[ cpu ];
+
+        for (i=0; i < _countof( emustat_tab ); i++)
+        {
+            EMUSTAT_CTR( st, i ) = EMUSTAT_CTR( &regs->emustats, i );
+#if defined( _FEATURE_SIE )
+            if (regs->guestregs)
+                EMUSTAT_CTR( st, i ) += EMUSTAT_CTR( &regs->guestregs->emustats, i );
+#endif
+        }
+
+        /* The CPU updates its counters without holding any lock, so
+           resetting a running CPU's counters is only approximate: an
+           increment racing the memset may store its pre-reset count
+           back. (Good enough for statistics; see 'help emustat'.) */
+        if (reset)
+        {
+            memset( &regs->emustats, 0, sizeof( EMU_STATS ));
+#if defined( _FEATURE_SIE )
+            if (regs->guestregs)
+                memset( &regs->guestregs->emustats, 0, sizeof( EMU_STATS ));
+#endif
+        }
+    }
+    release_lock( &sysblk.cpulock[ cpu ]);
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Display each CPU's counters and their totals, less those of the   */
+/* snapshot if 'diff'                                                */
+/*-------------------------------------------------------------------*/
+static void emustat_display( bool diff )
+{
+    EMU_STATS  st, total;
+    char       buf[ 256 ];
+    char       cpustr[ 16 ];
+    size_t     i, n;
+    int        cpu, ncpus = 0;
+
+    memset( &total, 0, sizeof( total ));
+
+    n = MSGBUF( buf, "%-5s", "CPU" );
+    for (i=0; i < _countof( emustat_tab ); i++)
+        n += snprintf( buf + n, sizeof( buf ) - n, " %14s", emustat_tab[i].heading );
+    snprintf( buf + n, sizeof( buf ) - n, " %6s", "Hit%" );
+    // "%s"
+    WRMSG( HHC02292, "I", buf );
+
+    for (cpu=0; cpu <= MAX_CPU_ENGS; cpu++)
+    {
+        EMU_STATS* p = (cpu < MAX_CPU_ENGS) ? &st : &total;
+
+        if (cpu < MAX_CPU_ENGS)
+        {
+            if (!emustat_get( cpu, &st, false ))
+                continue;
+
+            for (i=0; i < _countof( emustat_tab ); i++)
+            {
+                if (diff)
+                    EMUSTAT_CTR( &st, i ) -= EMUSTAT_CTR( &emustat_snap[ cpu ], i );
+                EMUSTAT_CTR( &total, i ) += EMUSTAT_CTR( &st, i );
+            }
+            ncpus++;
+            MSGBUF( cpustr, "%s%02X", PTYPSTR( cpu ), cpu );
+        }
+        else if (ncpus > 1)
+            STRLCPY( cpustr, "Total" );
+        else
+            break;
+
+        n = MSGBUF( buf, "%-5s", cpustr );
+        for (i=0; i < _countof( emustat_tab ); i++)
+            n += snprintf( buf + n, sizeof( buf ) - n, " %14"PRIu64, EMUSTAT_CTR( p, i ));
+        if (p->tlbhit + p->tlbmiss)
+            snprintf( buf + n, sizeof( buf ) - n, " %5.1f%%",
+                (p->tlbhit * 100.0) / (p->tlbhit + p->tlbmiss) );
+        // "%s"
+        WRMSG( HHC02292, "I", buf );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Append each CPU's counters to a CSV file, one line per CPU, each  */
+/* line beginning with the host time in seconds since 1970           */
+/*-------------------------------------------------------------------*/
+static int emustat_dump( const char* fname )
+{
+    char       pathname[ MAX_PATH ];
+    EMU_STATS  st;
+    FILE*      f;
+    U64        now;
+    size_t     i;
+    int        cpu, lines = 0;
+
+    hostpath( pathname, fname, sizeof( pathname ));
+
+    if (!(f = fopen( pathname, "a" )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fopen()", strerror( errno ));
+        return -1;
+    }
+
+    /* New file: begin with a heading line naming the columns */
+    if (ftell( f ) == 0)
+    {
+        fprintf( f, "time,cpu" );
+        for (i=0; i < _countof( emustat_tab ); i++)
+            fprintf( f, ",%s", emustat_tab[i].name );
+        fprintf( f, "\n" );
+    }
+
+    now = host_tod() - ETOD_1970;
+
+    for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (!emustat_get( cpu, &st, false ))
+            continue;
+
+        fprintf( f, "%"PRIu64".%06u,%d", (U64)(now / ETOD_SEC),
+            (unsigned)((now % ETOD_SEC) / (ETOD_SEC / 1000000)), cpu );
+        for (i=0; i < _countof( emustat_tab ); i++)
+            fprintf( f, ",%"PRIu64, EMUSTAT_CTR( &st, i ));
+        fprintf( f, "\n" );
+        lines++;
+    }
+
+    if (fclose( f ) != 0)
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fclose()", strerror( errno ));
+        return -1;
+    }
+
+    // "Emulator statistics of %d CPUs appended to %s"
+    WRMSG( HHC02832, "I", lines, fname );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* emustat command - display, compare or reset emulator statistics   */
+/*-------------------------------------------------------------------*/
+int emustat_cmd( int argc, char* argv[], char* cmdline )
+{
+    EMU_STATS  st;
+    int        cpu;
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (argc < 2)
+    {
+        emustat_display( false );
+        return 0;
+    }
+
+    if (argc == 2 && CMD( argv[1], SNAP, 4 ))
+    {
+        for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+            emustat_get( cpu, &emustat_snap[ cpu ], false );
+        emustat_snapped = true;
+        // "%-14s set to %s"
+        WRMSG( HHC02204, "I", argv[0], "SNAP" );
+        return 0;
+    }
+
+    if (argc == 2 && CMD( argv[1], DIFF, 4 ))
+    {
+        if (!emustat_snapped)
+        {
+            // "No emulator statistics snapshot; use 'emustat SNAP' first"
+            WRMSG( HHC02833, "E" );
+            return -1;
+        }
+        emustat_display( true );
+        return 0;
+    }
+
+    if (argc == 2 && CMD( argv[1], RESET, 5 ))
+    {
+        for (cpu=0; cpu < MAX_CPU_ENGS; cpu++)
+            emustat_get( cpu, &st, true );
+        memset( emustat_snap, 0, sizeof( emustat_snap ));
+        emustat_snapped = false;
+        // "%-14s set to %s"
+        WRMSG( HHC02204, "I", argv[0], "RESET" );
+        return 0;
+    }
+
+    if (argc == 3 && CMD( argv[1], DUMP, 4 ))
+        return emustat_dump( argv[2] );
+
+    // "Invalid argument(s). Type 'help %s' for assistance."
+    WRMSG( HHC02211, "E", argv[0] );
+    return -1;
+}
+#endif /* defined( OPTION_EMULATION_STATS ) */
+
 
 /*-------------------------------------------------------------------*/
 /* createCpuId  -  Create the requested CPU ID                       */
@@ -806,117 +806,21 @@ size_t  totamt;                         /* Total amount to be dumped */
 
 
 /*-------------------------------------------------------------------*/
-/*                    display_inst_adj                               */
+/*                    inst_operands                                  */
 /*-------------------------------------------------------------------*/
-static void ARCH_DEP( display_inst_adj )( REGS* iregs, BYTE* inst, bool pgmint )
+/* Determine the addresses of an instruction's storage operands and  */
+/* the address space (access register number or USE_REAL_ADDR) each  */
+/* should be displayed from. b1/b2 are returned as -1 if there is no */
+/* such operand.                                                     */
+/*-------------------------------------------------------------------*/
+void ARCH_DEP( inst_operands )( REGS* regs, BYTE* inst,
+                                int* pb1, VADR* paddr1, int* par1,
+                                int* pb2, VADR* paddr2, int* par2 )
 {
-QWORD   qword;                          /* Doubleword work area      */
-BYTE    opcode;                         /* Instruction operation code*/
-int     ilc;                            /* Instruction length        */
+BYTE    opcode = inst[0];               /* Instruction operation code*/
+int     ilc = ILC( opcode );            /* Instruction length        */
 int     b1=-1, b2=-1, x1;               /* Register numbers          */
-U16     xcode = 0;                      /* Exception code            */
 VADR    addr1 = 0, addr2 = 0;           /* Operand addresses         */
-char    buf[2048];                      /* Message buffer            */
-char    buf2[512];
-int     n;                              /* Number of bytes in buffer */
-REGS*   regs;                           /* Copied regs               */
-
-char    psw_inst_msg[160]   = {0};
-char    op1_stor_msg[128]   = {0};
-char    op2_stor_msg[128]   = {0};
-char    regs_msg_buf[4*512] = {0};
-
-    PTT_PGM( "dinst", inst, 0, pgmint );
-
-    /* Ensure storage exists to attempt the display */
-    if (iregs->mainlim == 0)
-    {
-        WRMSG( HHC02267, "I", "Real address is not valid" );
-        return;
-    }
-
-    n = 0;
-    buf[0] = '\0';
-
-    /* Get a working (modifiable) copy of the REGS */
-    if (iregs->ghostregs)
-        regs = iregs;
-    else if (!(regs = copy_regs( iregs )))
-        return;
-
-#if defined( _FEATURE_SIE )
-    if (SIE_MODE( regs ))
-        n += snprintf( buf + n, sizeof( buf )-n, "SIE: " );
-#endif
-
-    /* Exit if instruction is not valid */
-    if (!inst)
-    {
-        size_t len;
-        MSGBUF( psw_inst_msg, "%s Instruction fetch error\n", buf );
-        display_gregs( regs, regs_msg_buf, sizeof(regs_msg_buf)-1, "HHC02269I " );
-        /* Remove unwanted extra trailing newline from regs_msg_buf */
-        len = strlen( regs_msg_buf );
-        if (len)
-            regs_msg_buf[ len-1 ] = 0;
-        // "%s%s" // (instruction fetch error + regs)
-        WRMSG( HHC02325, "E", psw_inst_msg, regs_msg_buf );
-        if (!iregs->ghostregs)
-            free_aligned( regs );
-        return;
-    }
-
-    /* Save the opcode and determine the instruction length */
-    opcode = inst[0];
-    ilc = ILC( opcode );
-
-    PTT_PGM( "dinst op,ilc", opcode, ilc, pgmint );
-
-    /* If we were called to display the instruction that program
-       checked, then since the "iregs" REGS value that was passed
-       to us (that we made a working copy of) was pointing PAST
-       the instruction that actually program checked (not at it),
-       we need to backup by the ilc amount so that it points at
-       the instruction that program checked, not past it.
-    */
-    PTT_PGM( "dinst ip,IA", regs->ip, regs->psw.IA, pgmint );
-    if (pgmint)
-    {
-        regs->ip -= ilc;
-        regs->psw.IA = PSW_IA_FROM_IP( regs, 0 );
-    }
-    PTT_PGM( "dinst ip,IA", regs->ip, regs->psw.IA, pgmint );
-
-    /* Display the PSW */
-    memset( qword, 0, sizeof( qword ));
-    copy_psw( regs, qword );
-
-    if (sysblk.cpus > 1)
-        n += snprintf( buf + n, sizeof( buf )-n, "%s%02X: ", PTYPSTR( regs->cpuad ), regs->cpuad );
-
-    n += snprintf( buf + n, sizeof( buf )-n,
-                "PSW=%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X ",
-                qword[0], qword[1], qword[2], qword[3],
-                qword[4], qword[5], qword[6], qword[7] );
-
-#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
-    n += snprintf (buf + n, sizeof(buf)-n,
-                "%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X ",
-                qword[8], qword[9], qword[10], qword[11],
-                qword[12], qword[13], qword[14], qword[15]);
-#endif
-
-    /* Format instruction line */
-                 n += snprintf( buf + n, sizeof( buf )-n, "INST=%2.2X%2.2X", inst[0], inst[1] );
-    if (ilc > 2){n += snprintf( buf + n, sizeof( buf )-n, "%2.2X%2.2X",      inst[2], inst[3] );}
-    if (ilc > 4){n += snprintf( buf + n, sizeof( buf )-n, "%2.2X%2.2X",      inst[4], inst[5] );}
-                 n += snprintf( buf + n, sizeof( buf )-n, " %s", (ilc < 4) ? "        " :
-                                                                 (ilc < 6) ? "    " : "" );
-    n += PRINT_INST( inst, buf + n );
-    MSGBUF( psw_inst_msg, MSG( HHC02324, "I", buf ));
-
-    n = 0;
-    buf[0] = '\0';
 
     /* Process the first storage operand */
     if (1
@@ -1046,6 +950,144 @@ char    regs_msg_buf[4*512] = {0};
         PTT_PGM( "dinst rel1=", addr1, offset, relative_long_operand );
     }
 
+    *pb1 = b1;  *paddr1 = addr1;
+    *pb2 = b2;  *paddr2 = addr2;
+
+    /* First operand is real if DAT is off, else in space of base reg */
+    *par1 = REAL_MODE( &regs->psw ) ? USE_REAL_ADDR : b1;
+
+    /* Second operand is also real for LURA, STURA, LURAG and STURG */
+    if (0
+        || REAL_MODE( &regs->psw )
+        || (opcode == 0xB2 && inst[1] == 0x4B)  /*LURA*/
+        || (opcode == 0xB2 && inst[1] == 0x46)  /*STURA*/
+        || (opcode == 0xB9 && inst[1] == 0x05)  /*LURAG*/
+        || (opcode == 0xB9 && inst[1] == 0x25)  /*STURG*/
+    )
+        *par2 = USE_REAL_ADDR;
+    else
+        *par2 = b2;
+
+} /* end function inst_operands */
+
+
+/*-------------------------------------------------------------------*/
+/*                    display_inst_adj                               */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( display_inst_adj )( REGS* iregs, BYTE* inst, bool pgmint )
+{
+QWORD   qword;                          /* Doubleword work area      */
+BYTE    opcode;                         /* Instruction operation code*/
+int     ilc;                            /* Instruction length        */
+int     b1, b2;                         /* Register numbers          */
+int     ar1, ar2;                       /* Operand address spaces    */
+U16     xcode = 0;                      /* Exception code            */
+VADR    addr1 = 0, addr2 = 0;           /* Operand addresses         */
+char    buf[2048];                      /* Message buffer            */
+char    buf2[512];
+int     n;                              /* Number of bytes in buffer */
+REGS*   regs;                           /* Copied regs               */
+
+char    psw_inst_msg[160]   = {0};
+char    op1_stor_msg[128]   = {0};
+char    op2_stor_msg[128]   = {0};
+char    regs_msg_buf[4*512] = {0};
+
+    PTT_PGM( "dinst", inst, 0, pgmint );
+
+    /* Ensure storage exists to attempt the display */
+    if (iregs->mainlim == 0)
+    {
+        WRMSG( HHC02267, "I", "Real address is not valid" );
+        return;
+    }
+
+    n = 0;
+    buf[0] = '\0';
+
+    /* Get a working (modifiable) copy of the REGS */
+    if (iregs->ghostregs)
+        regs = iregs;
+    else if (!(regs = copy_regs( iregs )))
+        return;
+
+#if defined( _FEATURE_SIE )
+    if (SIE_MODE( regs ))
+        n += snprintf( buf + n, sizeof( buf )-n, "SIE: " );
+#endif
+
+    /* Exit if instruction is not valid */
+    if (!inst)
+    {
+        size_t len;
+        MSGBUF( psw_inst_msg, "%s Instruction fetch error\n", buf );
+        display_gregs( regs, regs_msg_buf, sizeof(regs_msg_buf)-1, "HHC02269I " );
+        /* Remove unwanted extra trailing newline from regs_msg_buf */
+        len = strlen( regs_msg_buf );
+        if (len)
+            regs_msg_buf[ len-1 ] = 0;
+        // "%s%s" // (instruction fetch error + regs)
+        WRMSG( HHC02325, "E", psw_inst_msg, regs_msg_buf );
+        if (!iregs->ghostregs)
+            free_aligned( regs );
+        return;
+    }
+
+    /* Save the opcode and determine the instruction length */
+    opcode = inst[0];
+    ilc = ILC( opcode );
+
+    PTT_PGM( "dinst op,ilc", opcode, ilc, pgmint );
+
+    /* If we were called to display the instruction that program
+       checked, then since the "iregs" REGS value that was passed
+       to us (that we made a working copy of) was pointing PAST
+       the instruction that actually program checked (not at it),
+       we need to backup by the ilc amount so that it points at
+       the instruction that program checked, not past it.
+    */
+    PTT_PGM( "dinst ip,IA", regs->ip, regs->psw.IA, pgmint );
+    if (pgmint)
+    {
+        regs->ip -= ilc;
+        regs->psw.IA = PSW_IA_FROM_IP( regs, 0 );
+    }
+    PTT_PGM( "dinst ip,IA", regs->ip, regs->psw.IA, pgmint );
+
+    /* Display the PSW */
+    memset( qword, 0, sizeof( qword ));
+    copy_psw( regs, qword );
+
+    if (sysblk.cpus > 1)
+        n += snprintf( buf + n, sizeof( buf )-n, "%s%02X: ", PTYPSTR( regs->cpuad ), regs->cpuad );
+
+    n += snprintf( buf + n, sizeof( buf )-n,
+                "PSW=%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X ",
+                qword[0], qword[1], qword[2], qword[3],
+                qword[4], qword[5], qword[6], qword[7] );
+
+#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    n += snprintf (buf + n, sizeof(buf)-n,
+                "%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X ",
+                qword[8], qword[9], qword[10], qword[11],
+                qword[12], qword[13], qword[14], qword[15]);
+#endif
+
+    /* Format instruction line */
+                 n += snprintf( buf + n, sizeof( buf )-n, "INST=%2.2X%2.2X", inst[0], inst[1] );
+    if (ilc > 2){n += snprintf( buf + n, sizeof( buf )-n, "%2.2X%2.2X",      inst[2], inst[3] );}
+    if (ilc > 4){n += snprintf( buf + n, sizeof( buf )-n, "%2.2X%2.2X",      inst[4], inst[5] );}
+                 n += snprintf( buf + n, sizeof( buf )-n, " %s", (ilc < 4) ? "        " :
+                                                                 (ilc < 6) ? "    " : "" );
+    n += PRINT_INST( inst, buf + n );
+    MSGBUF( psw_inst_msg, MSG( HHC02324, "I", buf ));
+
+    n = 0;
+    buf[0] = '\0';
+
+    /* Determine the storage operand addresses */
+    ARCH_DEP( inst_operands )( regs, inst, &b1, &addr1, &ar1, &b2, &addr2, &ar2 );
+
     /* Format storage at first storage operand location */
     if (b1 >= 0)
     {
@@ -1060,12 +1102,12 @@ char    regs_msg_buf[4*512] = {0};
             n += snprintf( buf2 + n, sizeof( buf2 )-n, "%s%02X: ",
                           PTYPSTR( regs->cpuad ), regs->cpuad );
 
-        if (REAL_MODE( &regs->psw ))
+        if (ar1 == USE_REAL_ADDR)
             ARCH_DEP( display_virt )( regs, addr1, buf2+n, sizeof( buf2 )-n-1,
                                       USE_REAL_ADDR, ACCTYPE_HW, "", &xcode );
         else
             ARCH_DEP( display_virt )( regs, addr1, buf2+n, sizeof( buf2 )-n-1,
-                                      b1, (opcode == 0x44                 // EX?
+                                      ar1, (opcode == 0x44                // EX?
 #if defined( FEATURE_035_EXECUTE_EXTN_FACILITY )
                                  || (opcode == 0xc6 && !(inst[1] & 0x0f)) // EXRL?
 #endif
@@ -1079,7 +1121,6 @@ char    regs_msg_buf[4*512] = {0};
     /* Format storage at second storage operand location */
     if (b2 >= 0)
     {
-        int ar = b2;
         n = 0;
         buf2[0] = '\0';
 
@@ -1090,17 +1131,8 @@ char    regs_msg_buf[4*512] = {0};
         if (sysblk.cpus > 1)
             n += snprintf( buf2 + n, sizeof( buf2 )-n, "%s%02X: ",
                            PTYPSTR( regs->cpuad ), regs->cpuad );
-        if (0
-            || REAL_MODE( &regs->psw )
-            || (opcode == 0xB2 && inst[1] == 0x4B)  /*LURA*/
-            || (opcode == 0xB2 && inst[1] == 0x46)  /*STURA*/
-            || (opcode == 0xB9 && inst[1] == 0x05)  /*LURAG*/
-            || (opcode == 0xB9 && inst[1] == 0x25)  /*STURG*/
-        )
-            ar = USE_REAL_ADDR;
-
         ARCH_DEP( display_virt )( regs, addr2, buf2+n, sizeof( buf2 )-n-1,
-                                  ar, ACCTYPE_HW, "", &xcode );
+                                  ar2, ACCTYPE_HW, "", &xcode );
 
         MSGBUF( op2_stor_msg, MSG( HHC02326, "I", RTRIM( buf2 )));
     }
@@ -185,6 +185,19 @@
 #ifdef HAVE_SYS_UIO_H
   #include <sys/uio.h>
 #endif
+#ifdef HAVE_SYS_EPOLL_H
+  #include <sys/epoll.h>
+#endif
+#ifdef HAVE_SYS_EVENTFD_H
+  #include <sys/eventfd.h>
+#endif
+#ifdef HAVE_LINUX_FUTEX_H
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+#endif
+#ifdef HAVE_LINUX_IF_PACKET_H
+  #include <linux/if_packet.h>
+#endif
 #ifdef HAVE_SYS_UTSNAME_H
   #include <sys/utsname.h>
 #endif
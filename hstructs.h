@@ -109,6 +109,24 @@
   #error MAX_CPU_ENGS cannot exceed 128
 #endif
 
+#if defined( OPTION_EMULATION_STATS )
+/*-------------------------------------------------------------------*/
+/* Emulator statistics: how often a CPU takes each of the slower     */
+/* paths through the emulator. Only ever updated by the CPU's own    */
+/* thread, and displayed, compared and reset by 'emustat'.           */
+/*-------------------------------------------------------------------*/
+struct EMU_STATS {
+        U64     tlbhit;                 /* MADDRL TLB hits           */
+        U64     tlbmiss;                /* MADDRL TLB misses (DAT)   */
+        U64     instfetch;              /* instfetch slow path calls */
+        U64     crosspage;              /* Operands crossing a page  */
+        U64     progjmp;                /* longjmp(progjmp) exits    */
+};
+#define EMU_STAT( _regs, _ctr )     ((_regs)->emustats._ctr++)
+#else
+#define EMU_STAT( _regs, _ctr )     do {} while (0)
+#endif
+
 /*-------------------------------------------------------------------*/
 /*       Structure definition for CPU register context               */
 /*-------------------------------------------------------------------*/
@@ -188,6 +206,12 @@ struct REGS {                           /* Processor registers       */
         U32     fpr[32];                /* FP registers              */
         U32     fpc;                    /* FP Control register       */
 
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+        /* Bits 0-63 of vector registers 0-15 are the FP registers   */
+        U64     vrl[32];                /* Vector regs bits 64-127   */
+        U64     vrh[16];                /* Vector regs 16-31 bits 0-63*/
+#endif
+
 #define GR_G(_r)     gr[(_r)].D
 #define GR_H(_r)     gr[(_r)].F.H.F       /* Fullword bits 0-31      */
 #define GR_HHH(_r)   gr[(_r)].F.H.H.H.H   /* Halfword bits 0-15      */
@@ -284,6 +308,9 @@ struct REGS {                           /* Processor registers       */
         U64     waittod;                /* Time of day last wait     */
         U64     waittime;               /* Wait time in interval     */
         U64     waittime_accumulated;   /* Wait time accumulated     */
+#if defined( OPTION_EMULATION_STATS )
+        EMU_STATS  emustats;            /* Emulator hot path counters*/
+#endif
 
         CACHE_ALIGN
         DAT     dat;                    /* Fields for DAT use        */
@@ -530,18 +557,21 @@ struct REGS {                           /* Processor registers       */
 
         const INSTR_FUNC    *s370_runtime_opcode_xxxx,
                             *s370_runtime_opcode_e3________xx,
+                            *s370_runtime_opcode_e7________xx,
                             *s370_runtime_opcode_eb________xx,
                             *s370_runtime_opcode_ec________xx,
                             *s370_runtime_opcode_ed________xx;
 
         const INSTR_FUNC    *s390_runtime_opcode_xxxx,
                             *s390_runtime_opcode_e3________xx,
+                            *s390_runtime_opcode_e7________xx,
                             *s390_runtime_opcode_eb________xx,
                             *s390_runtime_opcode_ec________xx,
                             *s390_runtime_opcode_ed________xx;
 
         const INSTR_FUNC    *z900_runtime_opcode_xxxx,
                             *z900_runtime_opcode_e3________xx,
+                            *z900_runtime_opcode_e7________xx,
                             *z900_runtime_opcode_eb________xx,
                             *z900_runtime_opcode_ec________xx,
                             *z900_runtime_opcode_ed________xx;
@@ -610,6 +640,48 @@ struct GSYSINFO {
 };
 
 
+#if defined( OPTION_INSTRUCTION_COUNTING )
+/*-------------------------------------------------------------------*/
+/* Instruction counts (or times) by opcode                           */
+/*-------------------------------------------------------------------*/
+struct ICOUNT_MAP {
+        U64 imap01[256];
+        U64 imapa4[256];
+        U64 imapa5[ 16];
+        U64 imapa6[256];
+        U64 imapa7[ 16];
+        U64 imapb2[256];
+        U64 imapb3[256];
+        U64 imapb9[256];
+        U64 imapc0[ 16];
+        U64 imapc2[ 16];
+        U64 imapc4[ 16];
+        U64 imapc6[ 16];
+        U64 imapc8[ 16];
+        U64 imape3[256];
+        U64 imape4[256];
+        U64 imape5[256];
+        U64 imapeb[256];
+        U64 imapec[256];
+        U64 imaped[256];
+        U64 imapxx[256];
+};
+
+/*-------------------------------------------------------------------*/
+/* Per-CPU instruction counting: only ever updated by its own CPU    */
+/* thread, so the counts need neither locks nor atomic updates and   */
+/* CPUs never contend for their cache lines. 'icount' sums them.     */
+/*-------------------------------------------------------------------*/
+struct ICOUNT_CPU {
+        ICOUNT_MAP  count;              /* Instructions executed     */
+        ICOUNT_MAP  time;               /* Host clock ticks spent    */
+        U64        *tslot;              /* count slot being timed    */
+        U64         tstart;             /* Host clock when it began  */
+        U32         skip;               /* Sampling countdown        */
+};
+#endif // defined( OPTION_INSTRUCTION_COUNTING )
+
+
 /*-------------------------------------------------------------------*/
 /* Operation Modes                                                   */
 /*-------------------------------------------------------------------*/
@@ -988,11 +1060,15 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
                 haveiplparm:1,          /* IPL PARM a la VM          */
                 logoptnodate:1,         /* 1 = don't datestamp log   */
                 logoptnotime:1,         /* 1 = don't timestamp log   */
+                logoptdrop:1,           /* 1 = drop msgs if log ring
+                                               is full, don't wait   */
                 nolrasoe:1,             /* 1 = No trace LRA Special  */
                                         /*     Operation Exceptions  */
                 noch9oflow:1,           /* Suppress CH9 O'Flow trace */
                 devnameonly:1,          /* Display only dev filename */
                 config_processed;       /* config file processed     */
+        U32     logoptwait;             /* msecs to wait for room in
+                                           full log ring (LOGOPT)    */
         U32     ints_state;             /* Common Interrupts Status  */
         CPU_BITMAP config_mask;         /* Configured CPUs           */
         CPU_BITMAP started_mask;        /* Started CPUs              */
@@ -1002,6 +1078,8 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
         U64     traceaddr[2];           /* Tracing address range     */
         U64     auto_trace_beg;         /* Automatic t+ instcount    */
         U64     auto_trace_amt;         /* Automatic tracing amount  */
+        bool    itrace;                 /* Binary trace file active  */
+        bool    profile;                /* Sampling profiler active  */
         BYTE    iplparmstring[64];      /* 64 bytes loadable at IPL  */
         char    loadparm[8+1];          /* Default LOADPARM          */
 #ifdef _FEATURE_ECPSVM
@@ -1060,55 +1138,14 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
 #if defined( OPTION_INSTRUCTION_COUNTING )
 
         bool    icount;                 /* true = enabled, else not. */
-
-#define IMAP_FIRST      sysblk.imap01
-
-        U64 imap01[256];
-        U64 imapa4[256];
-        U64 imapa5[ 16];
-        U64 imapa6[256];
-        U64 imapa7[ 16];
-        U64 imapb2[256];
-        U64 imapb3[256];
-        U64 imapb9[256];
-        U64 imapc0[ 16];
-        U64 imapc2[ 16];
-        U64 imapc4[ 16];
-        U64 imapc6[ 16];
-        U64 imapc8[ 16];
-        U64 imape3[256];
-        U64 imape4[256];
-        U64 imape5[256];
-        U64 imapeb[256];
-        U64 imapec[256];
-        U64 imaped[256];
-        U64 imapxx[256];
-
-#define IMAP_SIZE \
-            ( sizeof(sysblk.imap01) \
-            + sizeof(sysblk.imapa4) \
-            + sizeof(sysblk.imapa5) \
-            + sizeof(sysblk.imapa6) \
-            + sizeof(sysblk.imapa7) \
-            + sizeof(sysblk.imapb2) \
-            + sizeof(sysblk.imapb3) \
-            + sizeof(sysblk.imapb9) \
-            + sizeof(sysblk.imapc0) \
-            + sizeof(sysblk.imapc2) /*@Z9*/ \
-            + sizeof(sysblk.imapc4) /*208*/ \
-            + sizeof(sysblk.imapc6) /*208*/ \
-            + sizeof(sysblk.imapc8) \
-            + sizeof(sysblk.imape3) \
-            + sizeof(sysblk.imape4) \
-            + sizeof(sysblk.imape5) \
-            + sizeof(sysblk.imapeb) \
-            + sizeof(sysblk.imapec) \
-            + sizeof(sysblk.imaped) \
-            + sizeof(sysblk.imapxx) )
+        bool    icounttime;             /* true = also time opcodes  */
+        U32     icountrate;             /* Count 1 in this many      */
+        ICOUNT_CPU* icountcpu[ MAX_CPU_ENGS ]; /* Counts of each CPU */
 
 #endif // defined( OPTION_INSTRUCTION_COUNTING )
 
         char    *cnslport;              /* console port string       */
+        int     cnslthreads;            /* console I/O threads       */
         char    **herclogo;             /* Constructed logo screen   */
         char    *logofile;              /* File name of logo file    */
         size_t  logolines;              /* Logo file number of lines */
@@ -1183,6 +1220,33 @@ enum type_loader {  LDR_MANUAL, /* No automation             */
                     LDR_QUEUE   /* Like AUTO                 */
                  };
 
+/*-------------------------------------------------------------------*/
+/* Device I/O latency: the time from the acceptance of a SSCH, SIO   */
+/* or RSCH until the device thread starts executing the channel      */
+/* program, the time it then takes to execute, and the time from     */
+/* its final status being made pending until that status is either   */
+/* presented as an I/O interrupt or stored by TEST SUBCHANNEL. Each   */
+/* is kept as a histogram of power of 2 microsecond buckets. Updated */
+/* only while holding dev->lock; displayed by the 'iolat' command.   */
+/*-------------------------------------------------------------------*/
+#define IOLAT_BUCKETS   26              /* 1us to 2**24us, and over  */
+
+struct IOLAT_HIST {
+        U64     count;                  /* Number of measurements    */
+        U64     sumusecs;               /* Their total (usecs)       */
+        U64     bucket[ IOLAT_BUCKETS ];/* Measurements <= 2**n usecs*/
+                                        /* (last bucket: all longer) */
+};
+
+struct IOLAT {
+        U64         startat;            /* When start was accepted   */
+        U64         execat;             /* When execution started    */
+        U64         endat;              /* When final status pending */
+        IOLAT_HIST  queue;              /* startat  to  execat       */
+        IOLAT_HIST  exec;               /* execat   to  endat        */
+        IOLAT_HIST  intr;               /* endat  to  interrupt/TSCH */
+};
+
 /*-------------------------------------------------------------------*/
 /* Channel Path config block                                         */
 /*-------------------------------------------------------------------*/
@@ -1233,6 +1297,16 @@ struct TELNET {
         BYTE    send_err;               /* Socket send() failure     */
         BYTE    overflow;               /* Too much data accumulated */
         BYTE    overrun;                /* Unexpected extra data     */
+        BYTE    rparked;                /* Input held; device busy   */
+
+                                        /* ----- Event loop ----- */
+        LOCK    lock;                   /* Output buffer lock        */
+        int     epfd;                   /* Event loop epoll fd or -1 */
+        int     loop;                   /* Event loop index          */
+        U32     epmask;                 /* Events being waited for   */
+        BYTE   *wbuf;                   /* Output not yet sent       */
+        size_t  wlen;                   /* Bytes of output pending   */
+        size_t  wsize;                  /* Output buffer size        */
 };
 
 
@@ -1438,6 +1512,7 @@ struct DEVBLK {                         /* Device configuration block*/
 
         /*  Execute Channel Pgm Counts */
         U64     excps;                  /* Number of channel pgms Ex */
+        IOLAT   iolat;                  /* I/O latency histograms    */
 
         /*  Device dependent data (generic)                          */
         void    *dev_data;
@@ -1546,6 +1621,8 @@ struct DEVBLK {                         /* Device configuration block*/
         int     ctce_trace_cntr;        /* CTCE trace if > 0         */
         int     ctce_attn_delay;        /* CTCE pre-ATTN delay       */
         TID     ctce_listen_tid;        /* CTCE_ListenThread ID      */
+        void*   ctce_shm_send;          /* CTCE send SHM ring        */
+        void*   ctce_shm_recv;          /* CTCE receive SHM ring     */
         u_int   ctce_contention_loser:1;/* CTCE cmd collision        */
         u_int   ctce_ccw_flags_cc:1;    /* CTCE ccw in progres       */
         u_int   ctce_ficon:1;           /* CTCE type FICON           */
@@ -1553,6 +1630,7 @@ struct DEVBLK {                         /* Device configuration block*/
         u_int   ctce_system_reset:1;    /* CTCE initialized          */
         u_int   ctce_buf_next_read:1;   /* CTCE alt. buf use RD      */
         u_int   ctce_buf_next_write:1;  /* CTCE alt. buf use WR      */
+        u_int   ctce_shm:1;             /* CTCE SHM ring requested   */
 
         /*  Device dependent fields for printer                      */
 
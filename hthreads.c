@@ -54,6 +54,9 @@ struct ILOCK                    /* Hercules internal ILOCK structure */
     const char*  il_cr_locat;   /* Location where lock was created   */
     TIMEVAL      il_cr_time;    /* Time of day when it was created   */
     TID          il_cr_tid;     /* Thread-Id of who created it       */
+    U64          il_obtains;    /* Times obtained exclusively        */
+    U64          il_contended;  /* Times had to wait to obtain it    */
+    U64          il_waitdur;    /* Total wait duration (ETOD units)  */
 };
 typedef struct ILOCK ILOCK;     /* Shorter name for the same thing   */
 
@@ -62,13 +65,13 @@ typedef struct ILOCK ILOCK;     /* Shorter name for the same thing   */
 /*-------------------------------------------------------------------*/
 #define PTTRACE(_msg,_data1,_data2,_loc,_result)                      \
   do {                                                                \
-    if (pttclass & PTT_CL_THR)                                        \
+    if ((PTT_CL_COMPILED & PTT_CL_THR) && (pttclass & PTT_CL_THR))    \
       ptt_pthread_trace(PTT_CL_THR,                                   \
         _msg,_data1,_data2,_loc,_result,NULL);                        \
   } while(0)
 #define PTTRACE2(_msg,_data1,_data2,_loc,_result,_tv)                 \
   do {                                                                \
-    if (pttclass & PTT_CL_THR)                                        \
+    if ((PTT_CL_COMPILED & PTT_CL_THR) && (pttclass & PTT_CL_THR))    \
       ptt_pthread_trace(PTT_CL_THR,                                   \
         _msg,_data1,_data2,_loc,_result,_tv);                         \
   } while(0)
@@ -531,6 +534,12 @@ DLL_EXPORT int  hthread_obtain_lock( LOCK* plk, const char* obtain_loc )
             ilk->il_ob_locat = obtain_loc;
             ilk->il_ob_tid = hthread_self();
             memcpy( &ilk->il_ob_time, &tv, sizeof( TIMEVAL ));
+            ilk->il_obtains++;
+            if (waitdur)
+            {
+                ilk->il_contended++;
+                ilk->il_waitdur += waitdur;
+            }
         }
         hthread_mutex_unlock( &ilk->il_locklock );
     }
@@ -782,6 +791,12 @@ DLL_EXPORT int  hthread_obtain_wrlock( RWLOCK* plk, const char* obtain_loc )
             ilk->il_ob_locat = obtain_loc;
             ilk->il_ob_tid = hthread_self();
             memcpy( &ilk->il_ob_time, &tv, sizeof( TIMEVAL ));
+            ilk->il_obtains++;
+            if (waitdur)
+            {
+                ilk->il_contended++;
+                ilk->il_waitdur += waitdur;
+            }
         }
         hthread_mutex_unlock( &ilk->il_locklock );
     }
@@ -1024,6 +1039,7 @@ static void hthread_list_abandoned_locks( TID tid, const char* exit_loc )
 static void hthread_has_exited( TID tid, const char* exit_loc )
 {
     hthread_list_abandoned_locks( tid, exit_loc );
+    ptt_thread_exit();
 
     LockThreadsList();
     {
@@ -1411,6 +1427,40 @@ DLL_EXPORT int locks_cmd( int argc, char* argv[], char* cmdline )
     return rc;
 }
 
+/*-------------------------------------------------------------------*/
+/* Return contention statistics for all locks in a malloc'ed array   */
+/* which the caller must free. Returns the number of array entries.  */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int hthread_get_lock_stats( LOCKSTAT** ppLOCKSTAT )
+{
+    ILOCK*       ilk;               /* Pointer to ILOCK structure    */
+    LOCKSTAT*    lks;               /* Pointer to LOCKSTAT array     */
+    LIST_ENTRY*  ple;               /* Ptr to LIST_ENTRY structure   */
+    int i;
+
+    LockLocksList();
+    {
+        if (!(*ppLOCKSTAT = lks = (LOCKSTAT*) malloc( lockcount * sizeof( LOCKSTAT ))))
+        {
+            UnlockLocksList();
+            return 0;
+        }
+
+        /* The counters are only read, so the ILOCKs need not be locked */
+        for (i=0, ple = locklist.Flink; ple != &locklist; ple = ple->Flink, i++)
+        {
+            ilk = CONTAINING_RECORD( ple, ILOCK, il_link );
+            STRLCPY( lks[i].name, ilk->il_name );
+            lks[i].obtains   = ilk->il_obtains;
+            lks[i].contended = ilk->il_contended;
+            lks[i].waitusecs = ETOD_high64_to_usecs( ilk->il_waitdur );
+        }
+    }
+    UnlockLocksList();
+
+    return i;
+}
+
 /*-------------------------------------------------------------------*/
 /*               Update an internal lock's name                      */
 /*-------------------------------------------------------------------*/
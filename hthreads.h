@@ -267,6 +267,7 @@ typedef void* (THREAD_FUNC)( void* );   /* Generic thread function   */
 #define CCKD_GC_THREAD_NAME     "cckd_gcol"
 #define CON_CONN_THREAD_NAME    "console_connect"
 #define CONN_CLI_THREAD_NAME    "connect_client"
+#define CON_IO_THREAD_NAME      "console_io"
 #define HAO_THREAD_NAME         "hao_thread"
 #define HTTP_SRVR_THREAD_NAME   "http_server"
 #define HTTP_REQ_THREAD_NAME    "http_request"
@@ -288,6 +289,18 @@ struct RWLOCK
 };
 typedef struct RWLOCK RWLOCK;
 
+/*-------------------------------------------------------------------*/
+/*     Lock contention statistics  (see hthread_get_lock_stats)      */
+/*-------------------------------------------------------------------*/
+struct LOCKSTAT
+{
+    char    name[48];           /* Lock name (possibly truncated)    */
+    U64     obtains;            /* Times obtained exclusively        */
+    U64     contended;          /* Times had to wait to obtain it    */
+    U64     waitusecs;          /* Total time spent waiting (usecs)  */
+};
+typedef struct LOCKSTAT LOCKSTAT;
+
 /*-------------------------------------------------------------------*/
 /*                  hthreads exported functions                      */
 /*-------------------------------------------------------------------*/
@@ -330,6 +343,7 @@ HT_DLL_IMPORT int  hthread_equal_threads          ( TID tid1, TID tid2 );
 HT_DLL_IMPORT int  hthread_set_thread_prio        ( TID tid, int prio, const char* location );
 HT_DLL_IMPORT int  hthread_get_thread_prio        ( TID tid, const char* location );
 HT_DLL_IMPORT int  hthread_report_deadlocks       ( const char* sev );
+HT_DLL_IMPORT int  hthread_get_lock_stats         ( LOCKSTAT** ppLOCKSTAT );
 
 HT_DLL_IMPORT void        hthread_set_lock_name   ( LOCK* plk, const char* name );
 HT_DLL_IMPORT const char* hthread_get_lock_name   ( const LOCK* plk );
@@ -41,6 +41,7 @@
 #define HTML_EXPIRE_SECS        (60*60*24*7)
 
 #define HTTP_WELCOME "hercules.html"
+#define HTTP_METRICS "/cgi-bin/metrics"     /* for "/metrics" */
 #define HTML_HEADER  "include/header.htmlpart"
 #define HTML_FOOTER  "include/footer.htmlpart"
 
@@ -650,6 +650,8 @@ static void *http_request(void* arg)
 
     if(!strcasecmp("/",url))
         url = HTTP_WELCOME;
+    else if(!strcasecmp("/metrics",url))
+        url = HTTP_METRICS;
 
     if(strncasecmp("/cgi-bin/",url,9))
         http_download(webblk,url);
@@ -188,9 +188,15 @@ typedef struct TELNET    TELNET;    // Telnet Control Block
 typedef struct DEVBLK    DEVBLK;    // Device configuration block
 typedef struct CHPBLK    CHPBLK;    // Channel Path config block
 typedef struct IOINT     IOINT;     // I/O interrupt queue
+typedef struct IOLAT     IOLAT;     // Device I/O latency histograms
+typedef struct IOLAT_HIST IOLAT_HIST; // One I/O latency histogram
 
 typedef struct GSYSINFO  GSYSINFO;  // Ebcdic machine information
 
+typedef struct ICOUNT_MAP ICOUNT_MAP; // Instruction counts by opcode
+typedef struct ICOUNT_CPU ICOUNT_CPU; // Per-CPU instruction counting
+typedef struct EMU_STATS EMU_STATS; // Emulator hot path counters
+
 typedef struct DEVDATA   DEVDATA;   // xxxxxxxxx
 typedef struct DEVGRP    DEVGRP;    // xxxxxxxxx
 typedef struct DEVHND    DEVHND;    // xxxxxxxxx
@@ -109,6 +109,7 @@
 #include "hercules.h"
 #include "opcode.h"
 #include "inline.h"
+#include "zvector.h"
 
 #if defined(FEATURE_BINARY_FLOATING_POINT)
 
@@ -438,6 +439,394 @@ static INLINE U32 ieee_exception_test_oux(REGS *regs)
     return ieee_trap_conds;
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*                Host floating point "fast path" wrappers                   */
+/*                                                                           */
+/* The most common BFP case by far is round-to-nearest-even arithmetic on    */
+/* normal operands that produces a normal result.  In that case the host's   */
+/* own IEEE 754 hardware computes exactly the same bits SoftFloat does, only */
+/* many times faster.  The below hf32_xxx / hf64_xxx functions have the same */
+/* signature and semantics as their SoftFloat f32_xxx / f64_xxx namesakes:   */
+/* they use the host FPU when the operands and the result are safely within  */
+/* the normal range and otherwise simply call SoftFloat.  NaNs, infinities,  */
+/* denormals, results near the underflow or overflow thresholds and every    */
+/* rounding mode other than round-to-nearest-even therefore always take the  */
+/* SoftFloat path, which remains the reference implementation.               */
+/*                                                                           */
+/* The host FPU's exception flags are NOT used (they are per-thread state    */
+/* that is slow to access and unreliable under compiler optimization).       */
+/* Instead inexact and incremented are derived from the exact rounding error */
+/* of the operation, computed using error-free transformations: TwoSum for   */
+/* add and subtract, and a fused multiply-add for multiply, divide and       */
+/* square root.  Short BFP multiply, divide and square root are done in host */
+/* double precision where the needed error test is exact without an FMA.    */
+/* The long BFP multiply, divide and square root fast paths are only built   */
+/* when the host has a hardware FMA instruction (FP_FAST_FMA).               */
+/*                                                                           */
+/* #define IEEE_NO_HOST_FASTPATH to always use SoftFloat.                    */
+/*****************************************************************************/
+
+#if !defined( IEEE_NO_HOST_FASTPATH )                                       \
+    && (defined( __SSE2_MATH__ ) || defined( __aarch64__ )                  \
+        || defined( _M_X64 )     || defined( _M_ARM64 )                     \
+        || (defined( FLT_EVAL_METHOD ) && FLT_EVAL_METHOD == 0))
+  #define IEEE_HOST_FASTPATH            /* Host FPU is IEEE 754 binary32/64  */
+#endif
+
+#if defined( IEEE_HOST_FASTPATH )
+
+#define HF64_ABS(_v)        ((_v) & 0x7FFFFFFFFFFFFFFFULL)
+#define HF32_ABS(_v)        ((_v) & 0x7FFFFFFF)
+
+/* Operand is zero or normal (not denormal, infinity or NaN) */
+#define HF64_ZERO_OR_NORMAL(_v) \
+        (!HF64_ABS(_v) || (HF64_ABS(_v) - 0x0010000000000000ULL) < 0x7FE0000000000000ULL)
+#define HF32_ZERO_OR_NORMAL(_v) \
+        (!HF32_ABS(_v) || (HF32_ABS(_v) - 0x00800000) < 0x7F000000)
+
+/* Value is finite and at least 2**-960 (long) or 2**-100 (short) in     */
+/* magnitude, i.e. far enough from the underflow threshold that neither   */
+/* the result nor its rounding error can be denormal.                     */
+#define HF64_SAFE(_v) \
+        ((HF64_ABS(_v) - 0x03F0000000000000ULL) < (0x7FF0000000000000ULL - 0x03F0000000000000ULL))
+#define HF32_SAFE(_v) \
+        ((HF32_ABS(_v) - 0x0D800000) < (0x7F800000 - 0x0D800000))
+
+static INLINE double hf64_to_host( float64_t a )
+{
+    double d;
+    memcpy( &d, &a.v, sizeof( d ));
+    return d;
+}
+
+static INLINE float64_t hf64_from_host( double d )
+{
+    float64_t a;
+    memcpy( &a.v, &d, sizeof( d ));
+    return a;
+}
+
+static INLINE float hf32_to_host( float32_t a )
+{
+    float f;
+    memcpy( &f, &a.v, sizeof( f ));
+    return f;
+}
+
+static INLINE float32_t hf32_from_host( float f )
+{
+    float32_t a;
+    memcpy( &a.v, &f, sizeof( f ));
+    return a;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Raise inexact if the rounding error 'err' (exact result minus rounded     */
+/* result) is nonzero, plus incremented if rounding increased the magnitude  */
+/* of the result, i.e. if the error and the result have opposite signs.      */
+/*---------------------------------------------------------------------------*/
+#define HF_SET_INEXACT( _res, _err )                                              \
+    do {                                                                          \
+        if ((_err) != 0)                                                          \
+            softfloat_exceptionFlags |= ((_err) < 0) != ((_res) < 0)              \
+                ? softfloat_flag_inexact | softfloat_flag_incremented             \
+                : softfloat_flag_inexact;                                         \
+    } while (0)
+
+/*---------------------------------------------------------------------------*/
+/*                        Add and subtract (TwoSum)                          */
+/*---------------------------------------------------------------------------*/
+static INLINE float64_t hf64_add( float64_t a, float64_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF64_ZERO_OR_NORMAL( a.v ) && HF64_ZERO_OR_NORMAL( b.v ) ))
+    {
+        double x = hf64_to_host( a ), y = hf64_to_host( b ), s, bb, err;
+        float64_t r;
+
+        s = x + y;
+        r = hf64_from_host( s );
+
+        if (!HF64_ABS( r.v ))           /* Exact zero (x == -y, or both zero) */
+            return r;
+
+        if (likely( HF64_SAFE( r.v )))
+        {
+            bb  = s - x;
+            err = (x - (s - bb)) + (y - bb);
+            HF_SET_INEXACT( s, err );
+            return r;
+        }
+    }
+    return f64_add( a, b );
+}
+
+static INLINE float64_t hf64_sub( float64_t a, float64_t b )
+{
+    float64_t nb;
+
+    if (unlikely( softfloat_roundingMode != softfloat_round_near_even
+        || !HF64_ZERO_OR_NORMAL( b.v ) ))
+        return f64_sub( a, b );
+
+    nb.v = b.v ^ 0x8000000000000000ULL; /* a - b is exactly a + (-b)     */
+    return hf64_add( a, nb );
+}
+
+static INLINE float32_t hf32_add( float32_t a, float32_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF32_ZERO_OR_NORMAL( a.v ) && HF32_ZERO_OR_NORMAL( b.v ) ))
+    {
+        float x = hf32_to_host( a ), y = hf32_to_host( b ), s, bb, err;
+        float32_t r;
+
+        s = x + y;
+        r = hf32_from_host( s );
+
+        if (!HF32_ABS( r.v ))
+            return r;
+
+        if (likely( HF32_SAFE( r.v )))
+        {
+            bb  = s - x;
+            err = (x - (s - bb)) + (y - bb);
+            HF_SET_INEXACT( s, err );
+            return r;
+        }
+    }
+    return f32_add( a, b );
+}
+
+static INLINE float32_t hf32_sub( float32_t a, float32_t b )
+{
+    float32_t nb;
+
+    if (unlikely( softfloat_roundingMode != softfloat_round_near_even
+        || !HF32_ZERO_OR_NORMAL( b.v ) ))
+        return f32_sub( a, b );
+
+    nb.v = b.v ^ 0x80000000;            /* a - b is exactly a + (-b)     */
+    return hf32_add( a, nb );
+}
+
+/*---------------------------------------------------------------------------*/
+/*                 Short multiply, divide and square root                    */
+/*                                                                           */
+/* Done in host double precision.  The double result of a multiply of two   */
+/* 24-bit significands is exact, and double rounding of a double precision  */
+/* quotient or square root to single precision is innocuous.  The exact     */
+/* error test then needs only a (likewise exact) double multiply.           */
+/*---------------------------------------------------------------------------*/
+static INLINE float32_t hf32_mul( float32_t a, float32_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF32_ZERO_OR_NORMAL( a.v ) && HF32_ZERO_OR_NORMAL( b.v ) ))
+    {
+        double p = (double) hf32_to_host( a ) * (double) hf32_to_host( b );
+        float  f = (float) p;
+        float32_t r = hf32_from_host( f );
+
+        if (!HF32_ABS( a.v ) || !HF32_ABS( b.v ))
+            return r;                   /* Exact (signed) zero           */
+
+        if (likely( HF32_SAFE( r.v )))
+        {
+            HF_SET_INEXACT( f, p - (double) f );
+            return r;
+        }
+    }
+    return f32_mul( a, b );
+}
+
+static INLINE float32_t hf32_div( float32_t a, float32_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF32_ABS( b.v )
+        && HF32_ZERO_OR_NORMAL( a.v ) && HF32_ZERO_OR_NORMAL( b.v ) ))
+    {
+        double x = hf32_to_host( a ), y = hf32_to_host( b );
+        float  f = (float)(x / y);
+        float32_t r = hf32_from_host( f );
+
+        if (!HF32_ABS( a.v ))
+            return r;                   /* Exact (signed) zero           */
+
+        if (likely( HF32_SAFE( r.v )))
+        {
+            /* x - f*y has the sign of (exact - f) times the sign of y   */
+            double rem = x - (double) f * y;
+            HF_SET_INEXACT( f, y < 0 ? -rem : rem );
+            return r;
+        }
+    }
+    return f32_div( a, b );
+}
+
+static INLINE float32_t hf32_sqrt( float32_t a )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && !(a.v & 0x80000000) && HF32_ZERO_OR_NORMAL( a.v ) ))
+    {
+        double x = hf32_to_host( a );
+        float  f = (float) sqrt( x );
+
+        if (a.v)                        /* (square root of normal is normal) */
+            HF_SET_INEXACT( f, x - (double) f * f );
+        return hf32_from_host( f );
+    }
+    return f32_sqrt( a );
+}
+
+/*---------------------------------------------------------------------------*/
+/*        Long multiply, divide and square root (hardware FMA only)          */
+/*---------------------------------------------------------------------------*/
+#if defined( FP_FAST_FMA )
+
+static INLINE float64_t hf64_mul( float64_t a, float64_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF64_ZERO_OR_NORMAL( a.v ) && HF64_ZERO_OR_NORMAL( b.v ) ))
+    {
+        double x = hf64_to_host( a ), y = hf64_to_host( b );
+        double p = x * y;
+        float64_t r = hf64_from_host( p );
+
+        if (!HF64_ABS( a.v ) || !HF64_ABS( b.v ))
+            return r;
+
+        if (likely( HF64_SAFE( r.v )))
+        {
+            HF_SET_INEXACT( p, fma( x, y, -p ));
+            return r;
+        }
+    }
+    return f64_mul( a, b );
+}
+
+static INLINE float64_t hf64_div( float64_t a, float64_t b )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && HF64_ABS( b.v )
+        && HF64_ZERO_OR_NORMAL( a.v ) && HF64_ZERO_OR_NORMAL( b.v ) ))
+    {
+        double x = hf64_to_host( a ), y = hf64_to_host( b );
+        double q = x / y;
+        float64_t r = hf64_from_host( q );
+
+        if (!HF64_ABS( a.v ))
+            return r;
+
+        if (likely( HF64_SAFE( r.v ) && HF64_SAFE( a.v )))
+        {
+            double rem = fma( -q, y, x );
+            HF_SET_INEXACT( q, y < 0 ? -rem : rem );
+            return r;
+        }
+    }
+    return f64_div( a, b );
+}
+
+static INLINE float64_t hf64_sqrt( float64_t a )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && !(a.v & 0x8000000000000000ULL) && HF64_ZERO_OR_NORMAL( a.v ) ))
+    {
+        double x = hf64_to_host( a );
+        double s = sqrt( x );
+
+        if (!a.v)
+            return a;
+
+        if (likely( HF64_SAFE( a.v )))
+        {
+            HF_SET_INEXACT( s, fma( -s, s, x ));
+            return hf64_from_host( s );
+        }
+    }
+    return f64_sqrt( a );
+}
+
+/*---------------------------------------------------------------------------*/
+/* Fused multiply-add.  The rounding error of a fused multiply-add cannot    */
+/* be cheaply recovered, so the fast path is only taken when the exact       */
+/* inexact/incremented state is irrelevant: the FPC inexact flag is already  */
+/* on and inexact is not trap-enabled.  Then all that matters is that the    */
+/* result is neither tiny nor huge, and inexact may be raised unconditionally*/
+/* (it is already set in the FPC and can never trap).                        */
+/*---------------------------------------------------------------------------*/
+static INLINE float64_t hf64_mulAdd( float64_t a, float64_t b, float64_t c, U32 fpc )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && (fpc & (FPC_FLAG_SFX | FPC_MASK_IMX)) == FPC_FLAG_SFX
+        && HF64_ZERO_OR_NORMAL( a.v ) && HF64_ZERO_OR_NORMAL( b.v )
+        && HF64_ZERO_OR_NORMAL( c.v ) ))
+    {
+        float64_t r = hf64_from_host( fma( hf64_to_host( a ), hf64_to_host( b ), hf64_to_host( c )));
+
+        if (likely( HF64_SAFE( r.v )))
+        {
+            softfloat_exceptionFlags |= softfloat_flag_inexact;
+            return r;
+        }
+    }
+    return f64_mulAdd( a, b, c );
+}
+
+#else /* !defined( FP_FAST_FMA ) */
+
+#define hf64_mul( _a, _b )              f64_mul( _a, _b )
+#define hf64_div( _a, _b )              f64_div( _a, _b )
+#define hf64_sqrt( _a )                 f64_sqrt( _a )
+#define hf64_mulAdd( _a, _b, _c, _fpc ) f64_mulAdd( _a, _b, _c )
+
+#endif /* defined( FP_FAST_FMA ) */
+
+#if defined( FP_FAST_FMAF )
+
+static INLINE float32_t hf32_mulAdd( float32_t a, float32_t b, float32_t c, U32 fpc )
+{
+    if (likely( softfloat_roundingMode == softfloat_round_near_even
+        && (fpc & (FPC_FLAG_SFX | FPC_MASK_IMX)) == FPC_FLAG_SFX
+        && HF32_ZERO_OR_NORMAL( a.v ) && HF32_ZERO_OR_NORMAL( b.v )
+        && HF32_ZERO_OR_NORMAL( c.v ) ))
+    {
+        float32_t r = hf32_from_host( fmaf( hf32_to_host( a ), hf32_to_host( b ), hf32_to_host( c )));
+
+        if (likely( HF32_SAFE( r.v )))
+        {
+            softfloat_exceptionFlags |= softfloat_flag_inexact;
+            return r;
+        }
+    }
+    return f32_mulAdd( a, b, c );
+}
+
+#else /* !defined( FP_FAST_FMAF ) */
+
+#define hf32_mulAdd( _a, _b, _c, _fpc ) f32_mulAdd( _a, _b, _c )
+
+#endif /* defined( FP_FAST_FMAF ) */
+
+#else /* !defined( IEEE_HOST_FASTPATH ) */
+
+#define hf64_add( _a, _b )              f64_add( _a, _b )
+#define hf64_sub( _a, _b )              f64_sub( _a, _b )
+#define hf64_mul( _a, _b )              f64_mul( _a, _b )
+#define hf64_div( _a, _b )              f64_div( _a, _b )
+#define hf64_sqrt( _a )                 f64_sqrt( _a )
+#define hf64_mulAdd( _a, _b, _c, _fpc ) f64_mulAdd( _a, _b, _c )
+#define hf32_add( _a, _b )              f32_add( _a, _b )
+#define hf32_sub( _a, _b )              f32_sub( _a, _b )
+#define hf32_mul( _a, _b )              f32_mul( _a, _b )
+#define hf32_div( _a, _b )              f32_div( _a, _b )
+#define hf32_sqrt( _a )                 f32_sqrt( _a )
+#define hf32_mulAdd( _a, _b, _c, _fpc ) f32_mulAdd( _a, _b, _c )
+
+#endif /* defined( IEEE_HOST_FASTPATH ) */
+
+
 /*                          ---  E N D  ---                                  */
 /*                                                                           */
 /*           'SoftFloat' IEEE Binary Floating Point package                  */
@@ -1145,7 +1534,7 @@ DEF_INST(add_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f64_add( op1, op2 );
+    ans = hf64_add( op1, op2 );
 
     /* following optimized around "normal" case: no ieee exceptions or no traps enabled  */
     if (softfloat_exceptionFlags)
@@ -1180,7 +1569,7 @@ DEF_INST(add_bfp_long)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f64_add( op1, op2 );
+    ans = hf64_add( op1, op2 );
 
     /* following optimized around "normal" case: no ieee exceptions or no traps enabled  */
     if (softfloat_exceptionFlags)
@@ -1215,7 +1604,7 @@ DEF_INST(add_bfp_short_reg)
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
 
-    ans = f32_add( op1, op2 );
+    ans = hf32_add( op1, op2 );
 
     /* following optimized around "normal" case: no ieee exceptions or no traps enabled  */
     if (softfloat_exceptionFlags)
@@ -1251,7 +1640,7 @@ DEF_INST(add_bfp_short)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f32_add( op1, op2 );
+    ans = hf32_add( op1, op2 );
 
     /* following optimized around "normal" case: no ieee exceptions or no traps enabled  */
     if (softfloat_exceptionFlags)
@@ -2832,7 +3221,7 @@ DEF_INST(divide_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;                   /* clear all Softfloat exceptions  */
     SET_SF_RM_FROM_FPC;                             /* set rounding mode from FPC      */
-    ans = f64_div( op1, op2 );
+    ans = hf64_div( op1, op2 );
 
     if (softfloat_exceptionFlags)           /* any IEEE exceptions from Softfloat?  */
     {
@@ -2870,7 +3259,7 @@ DEF_INST(divide_bfp_long)
 
     softfloat_exceptionFlags = 0;                   /* clear all Softfloat exceptions  */
     SET_SF_RM_FROM_FPC;                             /* set rounding mode from FPC      */
-    ans = f64_div(op1, op2);
+    ans = hf64_div(op1, op2);
 
     if (softfloat_exceptionFlags)           /* any IEEE exceptions from Softfloat?  */
     {
@@ -2906,7 +3295,7 @@ DEF_INST(divide_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;           /* clear all Softfloat exceptions       */
     SET_SF_RM_FROM_FPC;                     /* set rounding mode from FPC           */
-    ans = f32_div( op1, op2 );
+    ans = hf32_div( op1, op2 );
 
     if (softfloat_exceptionFlags)           /* any IEEE exceptions from Softfloat?  */
     {
@@ -2943,7 +3332,7 @@ DEF_INST(divide_bfp_short)
 
     softfloat_exceptionFlags = 0;           /* clear all Softfloat exceptions       */
     SET_SF_RM_FROM_FPC;                     /* set rounding mode from FPC           */
-    ans = f32_div(op1, op2);
+    ans = hf32_div(op1, op2);
 
     if (softfloat_exceptionFlags)           /* any IEEE exceptions from Softfloat?  */
     {
@@ -3865,7 +4254,7 @@ DEF_INST(multiply_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                  */
-    ans = f64_mul( op1, op2 );
+    ans = hf64_mul( op1, op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -3901,7 +4290,7 @@ DEF_INST(multiply_bfp_long)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f64_mul(op1, op2);
+    ans = hf64_mul(op1, op2);
 
     if (softfloat_exceptionFlags)
     {
@@ -4039,7 +4428,7 @@ DEF_INST(multiply_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f32_mul( op1, op2 );
+    ans = hf32_mul( op1, op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -4074,7 +4463,7 @@ DEF_INST(multiply_bfp_short)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                    */
-    ans = f32_mul( op1, op2 );
+    ans = hf32_mul( op1, op2 );
 
 
     if (softfloat_exceptionFlags)
@@ -4109,7 +4498,7 @@ DEF_INST(multiply_add_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f64_mulAdd(op2, op3, op1);
+    ans = hf64_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4144,7 +4533,7 @@ DEF_INST(multiply_add_bfp_long)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f64_mulAdd(op2, op3, op1);
+    ans = hf64_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4178,7 +4567,7 @@ DEF_INST(multiply_add_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f32_mulAdd(op2, op3, op1);
+    ans = hf32_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4213,7 +4602,7 @@ DEF_INST(multiply_add_bfp_short)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f32_mulAdd(op2, op3, op1);
+    ans = hf32_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4252,7 +4641,7 @@ DEF_INST(multiply_subtract_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f64_mulAdd(op2, op3, op1 );
+    ans = hf64_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4291,7 +4680,7 @@ DEF_INST(multiply_subtract_bfp_long)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f64_mulAdd(op2, op3, op1);
+    ans = hf64_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4330,7 +4719,7 @@ DEF_INST(multiply_subtract_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f32_mulAdd(op2, op3, op1);
+    ans = hf32_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4370,7 +4759,7 @@ DEF_INST(multiply_subtract_bfp_short)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    ans = f32_mulAdd(op2, op3, op1);
+    ans = hf32_mulAdd(op2, op3, op1, regs->fpc );
 
     if (softfloat_exceptionFlags)
     {
@@ -4435,7 +4824,7 @@ DEF_INST(squareroot_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    op1 = f64_sqrt( op2 );
+    op1 = hf64_sqrt( op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -4467,7 +4856,7 @@ DEF_INST(squareroot_bfp_long)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    op1 = f64_sqrt( op2 );
+    op1 = hf64_sqrt( op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -4498,7 +4887,7 @@ DEF_INST(squareroot_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    op1 = f32_sqrt( op2 );
+    op1 = hf32_sqrt( op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -4530,7 +4919,7 @@ DEF_INST(squareroot_bfp_short)
 
     softfloat_exceptionFlags = 0;
     SET_SF_RM_FROM_FPC;                     /* Set rounding mode from FPC                   */
-    op1 = f32_sqrt( op2 );
+    op1 = hf32_sqrt( op2 );
 
     if (softfloat_exceptionFlags)
     {
@@ -4602,7 +4991,7 @@ DEF_INST(subtract_bfp_long_reg)
 
     softfloat_exceptionFlags = 0;                           /* Clear all Softfloat IEEE flags                       */
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f64_sub(op1, op2);                                /* Add two float64_t values                             */
+    ans = hf64_sub(op1, op2);                               /* Add two float64_t values                             */
 
     if (softfloat_exceptionFlags)                           /* Any IEEE Exceptions?                                 */
     {
@@ -4639,7 +5028,7 @@ DEF_INST(subtract_bfp_long)
 
     softfloat_exceptionFlags = 0;                           /* Clear all Softfloat IEEE flags                       */
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f64_sub(op1, op2);                                /* Add two float64_t values                             */
+    ans = hf64_sub(op1, op2);                               /* Add two float64_t values                             */
 
     if (softfloat_exceptionFlags)                           /* Any IEEE Exceptions?                                 */
     {
@@ -4675,7 +5064,7 @@ DEF_INST(subtract_bfp_short_reg)
 
     softfloat_exceptionFlags = 0;                           /* Clear all Softfloat IEEE flags                       */
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f32_sub(op1, op2);                                /* Add two float64_t values                             */
+    ans = hf32_sub(op1, op2);                               /* Add two float64_t values                             */
 
     if (softfloat_exceptionFlags)                           /* Any IEEE Exceptions?                                 */
     {
@@ -4713,7 +5102,7 @@ DEF_INST(subtract_bfp_short)
 
     softfloat_exceptionFlags = 0;                           /* Clear all Softfloat IEEE flags                       */
     SET_SF_RM_FROM_FPC;            /* Set rounding mode from FPC                           */
-    ans = f32_sub(op1, op2);                                /* Add two float64_t values                             */
+    ans = hf32_sub(op1, op2);                               /* Add two float64_t values                             */
 
     if (softfloat_exceptionFlags)                           /* Any IEEE Exceptions?                                 */
     {
@@ -5209,6 +5598,679 @@ DEF_INST(divide_integer_bfp_short_reg)
 
 }
 
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+
+/*****************************************************************************/
+/*                                                                           */
+/*             z/Architecture Vector Facility: vector BFP                    */
+/*                                                                           */
+/* Only the long BFP format is supported by the base vector facility, so    */
+/* every element is a float64_t and a vector holds two of them.  IEEE       */
+/* exceptions are handled per element: the first element that raises a     */
+/* trap-enabled exception causes a vector processing exception with the     */
+/* element index and exception type in the VXC, and the operation is        */
+/* suppressed (neither the result nor the FPC flags are updated).           */
+/* Otherwise the flags of all the elements are ORed into the FPC.           */
+/*                                                                           */
+/*****************************************************************************/
+
+#define VFP_SE          0x08        /* M-field bit: Single-Element control   */
+#define VFP_XXC         0x04        /* M-field bit: IEEE-inexact control     */
+
+#define VFP_ELEMS( _m ) (((_m) & VFP_SE) ? 1 : 2)
+
+                                    /* Specification exception if the FPF   */
+                                    /* is not long, or for invalid M bits   */
+#define VFP_SPEC_CHECK( _cond, _regs )                                        \
+        if (_cond)                                                            \
+            (_regs)->program_interrupt( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+                                    /* Valid vector BFP rounding mode?      */
+#define VFP_RM_CHECK( _m, _regs )                                             \
+        VFP_SPEC_CHECK( (_m) > 7 || !map_valid_m3_values_fpef[ (_m) & 0x7 ], _regs )
+
+/*-------------------------------------------------------------------*/
+/* Test the SoftFloat exceptions of vector element 'elem'.  If any   */
+/* of them is trap-enabled a vector processing exception is raised   */
+/* and this function does not return.  Otherwise the exceptions are  */
+/* accumulated in *flags for a later vfp_set_fpc_flags call.         */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vfp_element_exceptions )( REGS* regs, int elem, BYTE xxc, BYTE* flags )
+{
+    BYTE sf = softfloat_exceptionFlags;
+    U32  traps;
+    BYTE vxc;
+
+    if (xxc)                                    /* Inexact suppressed?      */
+        sf &= ~softfloat_flag_inexact;
+
+    if ((sf & softfloat_flag_tiny) && (regs->fpc & FPC_MASK_IMU))
+        sf |= softfloat_flag_underflow;         /* per SA22-7832-10 9-20    */
+
+    traps = (regs->fpc & FPC_MASK) & (((U32)sf) << 27);
+
+    if (traps)
+    {
+        vxc = (traps & FPC_MASK_IMI) ? 1 :      /* IEEE invalid operation   */
+              (traps & FPC_MASK_IMZ) ? 2 :      /* IEEE division by zero    */
+              (traps & FPC_MASK_IMO) ? 3 :      /* IEEE overflow            */
+              (traps & FPC_MASK_IMU) ? 4 :      /* IEEE underflow           */
+                                       5;       /* IEEE inexact             */
+        regs->dxc = (elem << 4) | vxc;
+        regs->program_interrupt( regs, PGM_VECTOR_PROCESSING_EXCEPTION );
+    }
+
+    *flags |= sf;
+}
+
+/* Transfer the accumulated element exceptions to the FPC flags      */
+#define VFP_SET_FPC_FLAGS( _regs, _flags )                                    \
+        (_regs)->fpc |= (((U32)(_flags)) << 19) & 0x00F80000
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VFA, VFS, VFM, VFD and VFSQ                 */
+/*-------------------------------------------------------------------*/
+#define VFP_OP_ADD      0
+#define VFP_OP_SUB      1
+#define VFP_OP_MUL      2
+#define VFP_OP_DIV      3
+#define VFP_OP_SQRT     4
+
+static void ARCH_DEP( vfp_arithmetic )( REGS* regs, int op, int v1, int v2, int v3, BYTE se )
+{
+    VRQW a, b, r;
+    float64_t op1, op2, ans;
+    BYTE flags = 0;
+    int i;
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    r.d[1] = 0;
+
+    SET_SF_RM_FROM_FPC;
+
+    for (i=0; i < VFP_ELEMS( se ); i++)
+    {
+        op1.v = VR_D( a, i );
+        op2.v = VR_D( b, i );
+
+        softfloat_exceptionFlags = 0;
+        switch (op)
+        {
+        case VFP_OP_ADD:  ans = hf64_add( op1, op2 ); break;
+        case VFP_OP_SUB:  ans = hf64_sub( op1, op2 ); break;
+        case VFP_OP_MUL:  ans = hf64_mul( op1, op2 ); break;
+        case VFP_OP_DIV:  ans = hf64_div( op1, op2 ); break;
+        default:          ans = hf64_sqrt( op1 );     break;
+        }
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, 0, &flags );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E3 VFA   - VECTOR FP ADD                                [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_add )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_arithmetic )( regs, VFP_OP_ADD, v1, v2, v3, m5 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E2 VFS   - VECTOR FP SUBTRACT                           [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_subtract )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_arithmetic )( regs, VFP_OP_SUB, v1, v2, v3, m5 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E7 VFM   - VECTOR FP MULTIPLY                           [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_multiply )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_arithmetic )( regs, VFP_OP_MUL, v1, v2, v3, m5 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E5 VFD   - VECTOR FP DIVIDE                             [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_divide )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_arithmetic )( regs, VFP_OP_DIV, v1, v2, v3, m5 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7CE VFSQ  - VECTOR FP SQUARE ROOT                        [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_square_root )
+{
+    int v1, v2, m3, m4, m5;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 3 || (m4 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_arithmetic )( regs, VFP_OP_SQRT, v1, v2, v2, m4 );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VFMA and VFMS                               */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( vfp_multiply_add )( REGS* regs, int v1, int v2, int v3, int v4, BYTE se, int sub )
+{
+    VRQW a, b, c, r;
+    float64_t op2, op3, op4, ans;
+    BYTE flags = 0;
+    int i;
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    r.d[1] = 0;
+
+    SET_SF_RM_FROM_FPC;
+
+    for (i=0; i < VFP_ELEMS( se ); i++)
+    {
+        op2.v = VR_D( a, i );
+        op3.v = VR_D( b, i );
+        op4.v = VR_D( c, i );
+
+        /* if the addend is not a NaN, the sign bit is inverted for VFMS */
+        if (sub && !FLOAT64_ISNAN( op4 ))
+            op4.v ^= 0x8000000000000000ULL;
+
+        softfloat_exceptionFlags = 0;
+        ans = hf64_mulAdd( op2, op3, op4, regs->fpc );
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, 0, &flags );
+        VR_D( r, i ) = ans.v;
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E78F VFMA  - VECTOR FP MULTIPLY AND ADD                   [VRR-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_multiply_and_add )
+{
+    int v1, v2, v3, v4, m5, m6;
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m6 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_multiply_add )( regs, v1, v2, v3, v4, m5, 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E78E VFMS  - VECTOR FP MULTIPLY AND SUBTRACT              [VRR-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_multiply_and_subtract )
+{
+    int v1, v2, v3, v4, m5, m6;
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m6 != 3 || (m5 & ~VFP_SE), regs );
+
+    ARCH_DEP( vfp_multiply_add )( regs, v1, v2, v3, v4, m5, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for VFCE, VFCH and VFCHE                        */
+/*-------------------------------------------------------------------*/
+#define VFP_CMP_EQ      0
+#define VFP_CMP_H       1
+#define VFP_CMP_HE      2
+
+static void ARCH_DEP( vfp_compare )( REGS* regs, int cmp, int v1, int v2, int v3, BYTE se, BYTE cs )
+{
+    VRQW a, b, r;
+    float64_t op2, op3;
+    BYTE flags = 0;
+    int i, n, matches = 0;
+    BYTE hit;
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    r.d[1] = 0;
+    n = VFP_ELEMS( se );
+
+    for (i=0; i < n; i++)
+    {
+        op2.v = VR_D( a, i );
+        op3.v = VR_D( b, i );
+
+        softfloat_exceptionFlags = 0;
+        switch (cmp)
+        {
+        case VFP_CMP_EQ:  hit = f64_eq( op2, op3 ); break;  /* quiet      */
+        case VFP_CMP_H:   hit = f64_lt( op3, op2 ); break;  /* signaling  */
+        default:          hit = f64_le( op3, op2 ); break;  /* signaling  */
+        }
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, 0, &flags );
+        VR_D( r, i ) = hit ? 0xFFFFFFFFFFFFFFFFULL : 0;
+        matches += hit ? 1 : 0;
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+
+    if (cs)
+        regs->psw.cc = matches == n ? 0 : matches ? 1 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7E8 VFCE  - VECTOR FP COMPARE EQUAL                      [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_compare_equal )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE) || (m6 & ~0x1), regs );
+
+    ARCH_DEP( vfp_compare )( regs, VFP_CMP_EQ, v1, v2, v3, m5, m6 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7EB VFCH  - VECTOR FP COMPARE HIGH                       [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_compare_high )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE) || (m6 & ~0x1), regs );
+
+    ARCH_DEP( vfp_compare )( regs, VFP_CMP_H, v1, v2, v3, m5, m6 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7EA VFCHE - VECTOR FP COMPARE HIGH OR EQUAL              [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_compare_high_or_equal )
+{
+    int v1, v2, v3, m4, m5, m6;
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE) || (m6 & ~0x1), regs );
+
+    ARCH_DEP( vfp_compare )( regs, VFP_CMP_HE, v1, v2, v3, m5, m6 );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7CB WFC   - VECTOR FP COMPARE SCALAR                     [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_compare_scalar )
+{
+    int v1, v2, m3, m4, m5;
+    VRQW a, b;
+    float64_t op1, op2;
+    BYTE newcc, flags = 0;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 3 || m4 || m5, regs );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    op1.v = VR_D( a, 0 );
+    op2.v = VR_D( b, 0 );
+
+    softfloat_exceptionFlags = 0;
+    newcc = FLOAT64_COMPARE( op1, op2 );
+
+    ARCH_DEP( vfp_element_exceptions )( regs, 0, 0, &flags );
+    VFP_SET_FPC_FLAGS( regs, flags );
+    regs->psw.cc = newcc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7CA WFK   - VECTOR FP COMPARE AND SIGNAL SCALAR          [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_compare_and_signal_scalar )
+{
+    int v1, v2, m3, m4, m5;
+    VRQW a, b;
+    float64_t op1, op2;
+    BYTE newcc, flags = 0;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 3 || m4 || m5, regs );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    op1.v = VR_D( a, 0 );
+    op2.v = VR_D( b, 0 );
+
+    softfloat_exceptionFlags = 0;
+    newcc = FLOAT64_COMPARE_AND_SIGNAL( op1, op2 );
+
+    ARCH_DEP( vfp_element_exceptions )( regs, 0, 0, &flags );
+    VFP_SET_FPC_FLAGS( regs, flags );
+    regs->psw.cc = newcc;
+}
+
+/*-------------------------------------------------------------------*/
+/* Common processing for the vector BFP conversions and VFI.  The    */
+/* M4 field holds the XxC and SE controls, M5 the rounding method.   */
+/*-------------------------------------------------------------------*/
+#define VFP_CVT_TO_FIX      0           /* VCGD:  long BFP to S64    */
+#define VFP_CVT_TO_LOG      1           /* VCLGD: long BFP to U64    */
+#define VFP_CVT_FROM_FIX    2           /* VCDG:  S64 to long BFP    */
+#define VFP_CVT_FROM_LOG    3           /* VCDLG: U64 to long BFP    */
+#define VFP_CVT_INTEGER     4           /* VFI:   long BFP integer   */
+
+static void ARCH_DEP( vfp_convert )( REGS* regs, int cvt, int v1, int v2, BYTE m4, BYTE m5 )
+{
+    VRQW a, r;
+    float64_t op;
+    BYTE flags = 0;
+    BYTE xxc = m4 & VFP_XXC;
+    U64  res;
+    int i;
+
+    vr_fetch( regs, v2, &a );
+    r.d[1] = 0;
+
+    SET_SF_RM_FROM_M3( m5 );
+
+    for (i=0; i < VFP_ELEMS( m4 ); i++)
+    {
+        op.v = VR_D( a, i );
+
+        softfloat_exceptionFlags = 0;
+        switch (cvt)
+        {
+        case VFP_CVT_TO_FIX:
+            if (FLOAT64_ISNAN( op ))    /* NaN: maximum negative integer  */
+            {
+                res = 0x8000000000000000ULL;
+                softfloat_raiseFlags( softfloat_flag_invalid );
+            }
+            else
+                res = (U64) f64_to_i64( op, softfloat_roundingMode, !xxc );
+            if ((softfloat_exceptionFlags & softfloat_flag_invalid) && !xxc)
+                softfloat_exceptionFlags |= softfloat_flag_inexact;
+            break;
+
+        case VFP_CVT_TO_LOG:
+            if (FLOAT64_ISNAN( op ))    /* NaN: zero                      */
+            {
+                res = 0;
+                softfloat_raiseFlags( softfloat_flag_invalid );
+            }
+            else
+                res = f64_to_ui64( op, softfloat_roundingMode, !xxc );
+            if ((softfloat_exceptionFlags & softfloat_flag_invalid) && !xxc)
+                softfloat_exceptionFlags |= softfloat_flag_inexact;
+            break;
+
+        case VFP_CVT_FROM_FIX:
+            res = i64_to_f64( (S64) op.v ).v;
+            break;
+
+        case VFP_CVT_FROM_LOG:
+            res = ui64_to_f64( op.v ).v;
+            break;
+
+        default:
+            res = f64_roundToInt( op, softfloat_roundingMode, !xxc ).v;
+            break;
+        }
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, xxc, &flags );
+        VR_D( r, i ) = res;
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+}
+
+#define VFP_CONVERT_INST( _name, _cvt )                                       \
+DEF_INST( _name )                                                             \
+{                                                                             \
+    int v1, v2, m3, m4, m5;                                                   \
+                                                                              \
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );                                  \
+                                                                              \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                           \
+    ZVECTOR_CHECK( regs );                                                    \
+    VFP_SPEC_CHECK( m3 != 3 || (m4 & ~(VFP_SE | VFP_XXC)), regs );            \
+    VFP_RM_CHECK( m5, regs );                                                 \
+                                                                              \
+    ARCH_DEP( vfp_convert )( regs, _cvt, v1, v2, m4, m5 );                    \
+}
+
+/*-------------------------------------------------------------------*/
+/* E7C2 VCGD  - VECTOR FP CONVERT TO FIXED 64-BIT            [VRR-a] */
+/* E7C0 VCLGD - VECTOR FP CONVERT TO LOGICAL 64-BIT          [VRR-a] */
+/* E7C3 VCDG  - VECTOR FP CONVERT FROM FIXED 64-BIT          [VRR-a] */
+/* E7C1 VCDLG - VECTOR FP CONVERT FROM LOGICAL 64-BIT        [VRR-a] */
+/* E7C7 VFI   - VECTOR LOAD FP INTEGER                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+VFP_CONVERT_INST( vector_fp_convert_to_fixed_64,     VFP_CVT_TO_FIX   )
+VFP_CONVERT_INST( vector_fp_convert_to_logical_64,   VFP_CVT_TO_LOG   )
+VFP_CONVERT_INST( vector_fp_convert_from_fixed_64,   VFP_CVT_FROM_FIX )
+VFP_CONVERT_INST( vector_fp_convert_from_logical_64, VFP_CVT_FROM_LOG )
+VFP_CONVERT_INST( vector_load_fp_integer,            VFP_CVT_INTEGER  )
+
+/*-------------------------------------------------------------------*/
+/* E7C4 VFLL  - VECTOR FP LOAD LENGTHENED                    [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_load_lengthened )
+{
+    int v1, v2, m3, m4, m5;
+    VRQW a, r;
+    float32_t op;
+    BYTE flags = 0;
+    int i;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 2 || (m4 & ~VFP_SE), regs );
+
+    vr_fetch( regs, v2, &a );
+    r.d[1] = 0;
+
+    for (i=0; i < VFP_ELEMS( m4 ); i++)
+    {
+        op.v = VR_F( a, i << 1 );       /* Even numbered short elements  */
+
+        softfloat_exceptionFlags = 0;
+        VR_D( r, i ) = f32_to_f64( op ).v;
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, 0, &flags );
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7C5 VFLR  - VECTOR FP LOAD ROUNDED                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_load_rounded )
+{
+    int v1, v2, m3, m4, m5;
+    VRQW a, r;
+    float64_t op;
+    BYTE flags = 0;
+    BYTE xxc;
+    int i;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 3 || (m4 & ~(VFP_SE | VFP_XXC)), regs );
+    VFP_RM_CHECK( m5, regs );
+
+    vr_fetch( regs, v2, &a );
+    r.d[0] = r.d[1] = 0;
+    xxc = m4 & VFP_XXC;
+
+    SET_SF_RM_FROM_M3( m5 );
+
+    for (i=0; i < VFP_ELEMS( m4 ); i++)
+    {
+        op.v = VR_D( a, i );
+
+        softfloat_exceptionFlags = 0;
+        VR_F( r, i << 1 ) = f64_to_f32( op ).v;
+
+        ARCH_DEP( vfp_element_exceptions )( regs, i, xxc, &flags );
+    }
+
+    vr_store( regs, v1, &r );
+    VFP_SET_FPC_FLAGS( regs, flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7CC VFPSO - VECTOR FP PERFORM SIGN OPERATION             [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_perform_sign_operation )
+{
+    int v1, v2, m3, m4, m5;
+    VRQW a, r;
+    int i;
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m3 != 3 || (m4 & ~VFP_SE) || m5 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    r.d[1] = 0;
+
+    for (i=0; i < VFP_ELEMS( m4 ); i++)
+    {
+        switch (m5)
+        {
+        case 0:  VR_D( r, i ) = VR_D( a, i ) ^  0x8000000000000000ULL; break;
+        case 1:  VR_D( r, i ) = VR_D( a, i ) |  0x8000000000000000ULL; break;
+        default: VR_D( r, i ) = VR_D( a, i ) & ~0x8000000000000000ULL; break;
+        }
+    }
+
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E74A VFTCI - VECTOR FP TEST DATA CLASS IMMEDIATE          [VRI-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_fp_test_data_class_immediate )
+{
+    int v1, v2, i3, m4, m5;
+    VRQW a, r;
+    float64_t op;
+    int i, n, matches = 0;
+
+    VRI_E( inst, regs, v1, v2, i3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    VFP_SPEC_CHECK( m4 != 3 || (m5 & ~VFP_SE), regs );
+
+    vr_fetch( regs, v2, &a );
+    r.d[1] = 0;
+    n = VFP_ELEMS( m5 );
+
+    for (i=0; i < n; i++)
+    {
+        op.v = VR_D( a, i );
+        if (float64_class( op ) & (U32) i3)
+        {
+            VR_D( r, i ) = 0xFFFFFFFFFFFFFFFFULL;
+            matches++;
+        }
+        else
+            VR_D( r, i ) = 0;
+    }
+
+    vr_store( regs, v1, &r );
+    regs->psw.cc = matches == n ? 0 : matches ? 1 : 3;
+}
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
 /* Some functions are 'generic' functions which are NOT dependent
    upon any specific build architecture and thus only need to be
    built once since they work identically for all architectures.
@@ -715,6 +715,7 @@ int     rc;
     sysblk.msglvl = DEFAULT_MLVL;
     sysblk.logoptnotime = 0;
     sysblk.logoptnodate = 1;
+    sysblk.logoptwait   = LOG_DEFWAIT;
 
     /* Initialize program name and version strings arrays */
     init_progname( argc, argv );
@@ -783,8 +784,9 @@ int     rc;
 
     sysblk.sysgroup = DEFAULT_SYSGROUP;
 
-    /* set default console port address */
+    /* set default console port address and I/O thread count */
     sysblk.cnslport = strdup("3270");
+    sysblk.cnslthreads = 1;
 
     /* Initialize automatic creation of missing tape file to default */
     sysblk.auto_tape_create = DEF_AUTO_TAPE_CREATE;
@@ -792,6 +794,11 @@ int     rc;
     /* Default command separator is OFF (disabled) */
     sysblk.cmdsep = 0;
 
+#if defined( OPTION_INSTRUCTION_COUNTING )
+    /* Count every instruction when instruction counting is enabled */
+    sysblk.icountrate = 1;
+#endif
+
 #if defined(_FEATURE_SYSTEM_CONSOLE)
     /* set default for scpecho to TRUE */
     sysblk.scpecho = TRUE;
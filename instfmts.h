@@ -104,6 +104,23 @@
 #undef SS_L
 #undef SSE
 #undef SSF
+#undef RXE_M3
+#undef VRX
+#undef VRV
+#undef VRS_A
+#undef VRS_B
+#undef VRS_C
+#undef VRI_A
+#undef VRI_B
+#undef VRI_C
+#undef VRI_D
+#undef VRI_E
+#undef VRR_A
+#undef VRR_B
+#undef VRR_C
+#undef VRR_D
+#undef VRR_E
+#undef VRR_F
 #undef VS
 #undef S_NW
 
@@ -665,6 +682,26 @@
     INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
 }
 
+/*-------------------------------------------------------------------*/
+/*   RXE_M3 - register and indexed storage with extended op code     */
+/*-------------------------------------------------------------------*/
+// This is z/Arch RXE format, including the m3 field.
+
+#define RXE_M3( _inst, _regs, _r1, _b2, _effective_addr2, _m3 )  RXE_M3_DECODER( _inst, _regs, _r1, _b2, _effective_addr2, _m3, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | r1  | x2  | b2  |       d2        | m3  | /// |    XOP    |    RXE
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define RXE_M3_DECODER( _inst, _regs, _r1, _b2, _effective_addr2, _m3, _len, _ilc ) \
+{                                                                   \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    RXE_DECODER( (_inst), (_regs), (_r1), (_b2), (_effective_addr2), (_len), (_ilc) ); \
+}
+
 /*-------------------------------------------------------------------*/
 /*  RXF - register & indexed storage w/ext.opcode and additional R3  */
 /*-------------------------------------------------------------------*/
@@ -1734,6 +1771,387 @@
     INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
 }
 
+/*********************************************************************/
+/*********************************************************************/
+/**                                                                 **/
+/**                z/Architecture Vector Facility                   **/
+/**                                                                 **/
+/*********************************************************************/
+/*********************************************************************/
+
+/*-------------------------------------------------------------------*/
+/* The vector register fields of the below formats are only 4 bits   */
+/* wide.  The high-order bit of each register number is supplied by */
+/* the RXB field (bits 36-39): RXB bit 0 for the field in bits 8-11, */
+/* bit 1 for bits 12-15, bit 2 for bits 16-19 and bit 3 for 32-35.   */
+/*-------------------------------------------------------------------*/
+
+#define RXB_V1( _inst )     (((_inst)[4] & 0x08) << 1)
+#define RXB_V2( _inst )     (((_inst)[4] & 0x04) << 2)
+#define RXB_V3( _inst )     (((_inst)[4] & 0x02) << 3)
+#define RXB_V4( _inst )     (((_inst)[4] & 0x01) << 4)
+
+/*-------------------------------------------------------------------*/
+/*      VRX - vector register and indexed storage operation          */
+/*-------------------------------------------------------------------*/
+// This is z/Arch VRX format.
+
+#define VRX( _inst, _regs, _v1, _b2, _effective_addr2, _m3 )  VRX_DECODER( _inst, _regs, _v1, _b2, _effective_addr2, _m3, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | x2  | b2  |       d2        | m3  | rxb |    XOP    |    VRX
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRX_DECODER( _inst, _regs, _v1, _b2, _effective_addr2, _m3, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_effective_addr2) = (temp >>  0) & 0xfff;                      \
+    (_b2)              = (temp >> 16) & 0xf;  /* (actually x2) */   \
+    (_v1)              = ((temp >> 20) & 0xf) | RXB_V1( _inst );    \
+    (_m3)              = (_inst)[4] >> 4;                           \
+                                                                    \
+    if (( _b2 ))                              /* (actually x2) */   \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_b2) = (temp >> 12) & 0xf;               /* (the REAL b2) */   \
+                                                                    \
+    if (( _b2 ))                              /* (the REAL b2) */   \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+/*-------------------------------------------------------------------*/
+/*      VRV - vector register and vector index storage operation     */
+/*-------------------------------------------------------------------*/
+// This is z/Arch VRV format.  The element of v2 used as the index
+// is selected by the instruction itself, so only the base and the
+// displacement are added here; the caller must still wrap the sum.
+
+#define VRV( _inst, _regs, _v1, _v2, _b2, _effective_addr2, _m3 )  VRV_DECODER( _inst, _regs, _v1, _v2, _b2, _effective_addr2, _m3, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | b2  |       d2        | m3  | rxb |    XOP    |    VRV
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRV_DECODER( _inst, _regs, _v1, _v2, _b2, _effective_addr2, _m3, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_effective_addr2) = (temp >>  0) & 0xfff;                      \
+    (_b2)              = (temp >> 12) & 0xf;                        \
+    (_v2)              = ((temp >> 16) & 0xf) | RXB_V2( _inst );    \
+    (_v1)              = ((temp >> 20) & 0xf) | RXB_V1( _inst );    \
+    (_m3)              = (_inst)[4] >> 4;                           \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+/*-------------------------------------------------------------------*/
+/*      VRS - vector register and storage operation                  */
+/*-------------------------------------------------------------------*/
+// This is z/Arch VRS-a, VRS-b and VRS-c formats.  The three formats
+// differ only in which of the two register fields designates a
+// general register instead of a vector register.
+
+#define VRS_A( _inst, _regs, _v1, _v3, _b2, _effective_addr2, _m4 )  VRS_DECODER( _inst, _regs, _v1, _v3, _b2, _effective_addr2, _m4, RXB_V1( _inst ), RXB_V2( _inst ), 6, 6 )
+#define VRS_B( _inst, _regs, _v1, _r3, _b2, _effective_addr2, _m4 )  VRS_DECODER( _inst, _regs, _v1, _r3, _b2, _effective_addr2, _m4, RXB_V1( _inst ),               0, 6, 6 )
+#define VRS_C( _inst, _regs, _r1, _v3, _b2, _effective_addr2, _m4 )  VRS_DECODER( _inst, _regs, _r1, _v3, _b2, _effective_addr2, _m4,               0, RXB_V2( _inst ), 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v3  | b2  |       d2        | m4  | rxb |    XOP    |    VRS-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | r3  | b2  |       d2        | m4  | rxb |    XOP    |    VRS-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | r1  | v3  | b2  |       d2        | m4  | rxb |    XOP    |    VRS-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRS_DECODER( _inst, _regs, _r1, _r3, _b2, _effective_addr2, _m4, _rxb1, _rxb3, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_effective_addr2) = (temp >>  0) & 0xfff;                      \
+    (_b2)              = (temp >> 12) & 0xf;                        \
+    (_r3)              = ((temp >> 16) & 0xf) | (_rxb3);            \
+    (_r1)              = ((temp >> 20) & 0xf) | (_rxb1);            \
+    (_m4)              = (_inst)[4] >> 4;                           \
+                                                                    \
+    if (( _b2 ))                                                    \
+        (_effective_addr2) += (_regs)->GR(( _b2 ));                 \
+                                                                    \
+    (_effective_addr2) &= ADDRESS_MAXWRAP(( _regs ));               \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+/*-------------------------------------------------------------------*/
+/*      VRI - vector register and immediate operation                */
+/*-------------------------------------------------------------------*/
+// This is z/Arch VRI-a format.
+
+#define VRI_A( _inst, _regs, _v1, _i2, _m3 )  VRI_A_DECODER( _inst, _regs, _v1, _i2, _m3, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | /// |          i2           | m3  | rxb |    XOP    |    VRI-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_A_DECODER( _inst, _regs, _v1, _i2, _m3, _len, _ilc )    \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_i2) = (temp >>  0) & 0xffff;                                  \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRI-b format.
+
+#define VRI_B( _inst, _regs, _v1, _i2, _i3, _m4 )  VRI_B_DECODER( _inst, _regs, _v1, _i2, _i3, _m4, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | /// |    i2     |    i3     | m4  | rxb |    XOP    |    VRI-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_B_DECODER( _inst, _regs, _v1, _i2, _i3, _m4, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_i3) = (temp >>  0) & 0xff;                                    \
+    (_i2) = (temp >>  8) & 0xff;                                    \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRI-c format.
+
+#define VRI_C( _inst, _regs, _v1, _v3, _i2, _m4 )  VRI_C_DECODER( _inst, _regs, _v1, _v3, _i2, _m4, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v3  |          i2           | m4  | rxb |    XOP    |    VRI-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_C_DECODER( _inst, _regs, _v1, _v3, _i2, _m4, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_i2) = (temp >>  0) & 0xffff;                                  \
+    (_v3) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRI-d format.
+
+#define VRI_D( _inst, _regs, _v1, _v2, _v3, _i4, _m5 )  VRI_D_DECODER( _inst, _regs, _v1, _v2, _v3, _i4, _m5, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// |    i4     | m5  | rxb |    XOP    |    VRI-d
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_D_DECODER( _inst, _regs, _v1, _v2, _v3, _i4, _m5, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_i4) = (temp >>  0) & 0xff;                                    \
+    (_v3) = ((temp >> 12) & 0xf) | RXB_V3( _inst );                 \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m5) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRI-e format.
+
+#define VRI_E( _inst, _regs, _v1, _v2, _i3, _m4, _m5 )  VRI_E_DECODER( _inst, _regs, _v1, _v2, _i3, _m4, _m5, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  |       i3        | m5  | m4  | rxb |    XOP    |    VRI-e
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRI_E_DECODER( _inst, _regs, _v1, _v2, _i3, _m4, _m5, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m5) = (temp >>  0) & 0xf;                                     \
+    (_i3) = (temp >>  4) & 0xfff;                                   \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+/*-------------------------------------------------------------------*/
+/*      VRR - vector register and register operation                 */
+/*-------------------------------------------------------------------*/
+// This is z/Arch VRR-a format.
+
+#define VRR_A( _inst, _regs, _v1, _v2, _m3, _m4, _m5 )  VRR_A_DECODER( _inst, _regs, _v1, _v2, _m3, _m4, _m5, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | /// | /// | m5  | m4  | m3  | rxb |    XOP    |    VRR-a
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_A_DECODER( _inst, _regs, _v1, _v2, _m3, _m4, _m5, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m4) = (temp >>  0) & 0xf;                                     \
+    (_m5) = (temp >>  4) & 0xf;                                     \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m3) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRR-b format.
+
+#define VRR_B( _inst, _regs, _v1, _v2, _v3, _m4, _m5 )  VRR_B_DECODER( _inst, _regs, _v1, _v2, _v3, _m4, _m5, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// | m5  | /// | m4  | rxb |    XOP    |    VRR-b
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_B_DECODER( _inst, _regs, _v1, _v2, _v3, _m4, _m5, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m5) = (temp >>  4) & 0xf;                                     \
+    (_v3) = ((temp >> 12) & 0xf) | RXB_V3( _inst );                 \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRR-c format.
+
+#define VRR_C( _inst, _regs, _v1, _v2, _v3, _m4, _m5, _m6 )  VRR_C_DECODER( _inst, _regs, _v1, _v2, _v3, _m4, _m5, _m6, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | /// | m6  | m5  | m4  | rxb |    XOP    |    VRR-c
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_C_DECODER( _inst, _regs, _v1, _v2, _v3, _m4, _m5, _m6, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m5) = (temp >>  0) & 0xf;                                     \
+    (_m6) = (temp >>  4) & 0xf;                                     \
+    (_v3) = ((temp >> 12) & 0xf) | RXB_V3( _inst );                 \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_m4) = (_inst)[4] >> 4;                                        \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRR-d format.
+
+#define VRR_D( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6 )  VRR_D_DECODER( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | m5  | m6  | /// | v4  | rxb |    XOP    |    VRR-d
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_D_DECODER( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m6) = (temp >>  4) & 0xf;                                     \
+    (_m5) = (temp >>  8) & 0xf;                                     \
+    (_v3) = ((temp >> 12) & 0xf) | RXB_V3( _inst );                 \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_v4) = ((_inst)[4] >> 4)    | RXB_V4( _inst );                 \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRR-e format.
+
+#define VRR_E( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6 )  VRR_E_DECODER( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | v2  | v3  | m6  | /// | m5  | v4  | rxb |    XOP    |    VRR-e
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_E_DECODER( _inst, _regs, _v1, _v2, _v3, _v4, _m5, _m6, _len, _ilc ) \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_m5) = (temp >>  0) & 0xf;                                     \
+    (_m6) = (temp >>  8) & 0xf;                                     \
+    (_v3) = ((temp >> 12) & 0xf) | RXB_V3( _inst );                 \
+    (_v2) = ((temp >> 16) & 0xf) | RXB_V2( _inst );                 \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+    (_v4) = ((_inst)[4] >> 4)    | RXB_V4( _inst );                 \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
+// This is z/Arch VRR-f format.
+
+#define VRR_F( _inst, _regs, _v1, _r2, _r3 )  VRR_F_DECODER( _inst, _regs, _v1, _r2, _r3, 6, 6 )
+
+//  0           1           2           3           4           5           6
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  |     OP    | v1  | r2  | r3  | /// | /// | /// | /// | rxb |    XOP    |    VRR-f
+//  +-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+-----+
+//  0     4     8     12    16    20    24    28    32    36    40    44   47
+
+#define VRR_F_DECODER( _inst, _regs, _v1, _r2, _r3, _len, _ilc )    \
+{                                                                   \
+    U32 temp = fetch_fw( _inst );                                   \
+                                                                    \
+    (_r3) = (temp >> 12) & 0xf;                                     \
+    (_r2) = (temp >> 16) & 0xf;                                     \
+    (_v1) = ((temp >> 20) & 0xf) | RXB_V1( _inst );                 \
+                                                                    \
+    INST_UPDATE_PSW( (_regs), (_len), (_ilc) );                     \
+}
+
 /*********************************************************************/
 /*********************************************************************/
 /**                                                                 **/
@@ -295,6 +295,10 @@ int ARCH_DEP( system_reset )( const int target_mode, const bool clear,
 
 #if defined( _FEATURE_S370_S390_VECTOR_FACILITY )
                 memset( regs->vf->vr, 0, sizeof( regs->vf->vr ));
+#endif
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+                memset( regs->vrl, 0, sizeof( regs->vrl ));
+                memset( regs->vrh, 0, sizeof( regs->vrh ));
 #endif
                 /* Clear the instruction counter and CPU time used */
                 cpu_reset_instcount_and_cputime( regs );
@@ -695,6 +699,7 @@ int ARCH_DEP( initial_cpu_reset )( REGS* regs )
     memset ( &regs->psw,           0, sizeof( regs->psw           ));
     memset ( &regs->captured_zpsw, 0, sizeof( regs->captured_zpsw ));
     memset ( &regs->cr_struct,     0, sizeof( regs->cr_struct     ));
+    regs->CR_G( CR_ASD_REAL ) = TLB_REAL_ASD;   /* (see cpu_init) */
     regs->fpc    = 0;
     regs->PX     = 0;
     regs->psw.AMASK_G = AMASK24;
@@ -0,0 +1,727 @@
+/* ITRACE.C     (C) Copyright Hercules development team, 2026        */
+/*              Binary instruction trace to file                     */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* While a trace file is open ('tfile' command) each instruction     */
+/* selected for tracing by 't+' is written as a compact binary record*/
+/* (see itrace.h) rather than formatted and logged. Every CPU fills  */
+/* one of its own two buffers without any locking; full buffers are  */
+/* compressed and written to the file by the "itrace writer" thread. */
+/* Should a CPU fill both of its buffers before the writer thread    */
+/* has caught up, records are counted as lost rather than the CPU    */
+/* being made to wait. The file is decoded offline by 'itrcprt'.     */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+DISABLE_GCC_UNUSED_FUNCTION_WARNING;
+
+#define _ITRACE_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+#include "opcode.h"
+#include "itrace.h"
+
+#ifndef _ITRACE_C_ONCE_
+#define _ITRACE_C_ONCE_
+
+/*-------------------------------------------------------------------*/
+/* Per-CPU trace buffers                                             */
+/*-------------------------------------------------------------------*/
+struct ITRC_CPU
+{
+    BYTE*   buf[2];                     /* Trace buffers             */
+    U32     len[2];                     /* Length of full buffer     */
+    volatile bool full[2];              /* Buffer awaits the writer  */
+    int     cur;                        /* Buffer being filled       */
+    U32     used;                       /* Bytes used in buf[cur]    */
+    BYTE    arch_mode;                  /* Mode of records in buffer */
+    volatile bool busy;                 /* CPU is building a record  */
+    U64     lost;                       /* Lost and not yet reported */
+    U64     records;                    /* Records traced            */
+    U64     lostrecs;                   /* Records lost              */
+    U64     psw;                        /* PSW as last recorded      */
+    U64     gr[16];                     /* GRs as last recorded      */
+};
+typedef struct ITRC_CPU ITRC_CPU;
+
+#define ITRC_DEFBUFSIZE (256 * 1024)    /* Default buffer size       */
+#define ITRC_MINBUFSIZE (16 * 1024)     /* Minimum buffer size       */
+#define ITRC_MAXNAME    32              /* Max mnemonic/name length  */
+
+/* Largest possible INST record plus largest possible MNEM record    */
+#define ITRC_MAXREC     ( sizeof( ITRC_RECHDR ) + 8 + 8 + 8 + 6 + 2  \
+                        + (16 * 8) + 2 * (12 + ITRC_OPDATA)          \
+                        + sizeof( ITRC_RECHDR ) + 2                  \
+                        + 2 * (1 + ITRC_MAXNAME) )
+
+#if defined( HAVE_ZLIB )
+  #define ITRC_FILE             gzFile
+  #define ITRC_OPEN( _fn )      gzopen( (_fn), "wb1" )
+  #define ITRC_WRITE( _f,_b,_n) (gzwrite( (_f), (_b), (unsigned)(_n) ) == (int)(_n))
+  #define ITRC_CLOSE( _f )      gzclose( _f )
+#else
+  #define ITRC_FILE             FILE*
+  #define ITRC_OPEN( _fn )      fopen( (_fn), "wb" )
+  #define ITRC_WRITE( _f,_b,_n) (fwrite( (_b), 1, (_n), (_f) ) == (size_t)(_n))
+  #define ITRC_CLOSE( _f )      fclose( _f )
+#endif
+
+static ITRC_CPU*  itrc_cpu[ MAX_CPU_ENGS ];  /* Each CPU's buffers   */
+static ITRC_FILE  itrc_file;            /* Trace file                */
+static char*      itrc_fname;           /* Trace file name           */
+static U32        itrc_bufsize;         /* Size of each buffer       */
+static bool       itrc_stor;            /* Capture storage operands  */
+static U64        itrc_bytes;           /* Bytes written to file     */
+static bool       itrc_ioerr;           /* Write to file failed      */
+static BYTE       itrc_named[ 65536/8 ];/* Opcode keys already named */
+static LOCK       itrc_lock;            /* Writer thread lock        */
+static COND       itrc_cond;            /* Writer thread wakeup      */
+static TID        itrc_tid;             /* Writer thread             */
+static bool       itrc_stop;            /* Writer thread must exit   */
+static bool       itrc_inited;          /* Lock and cond initialized */
+
+/*-------------------------------------------------------------------*/
+/* Hand the full buffer to the writer thread and switch buffers.     */
+/* Returns false if the other buffer has not been written yet.       */
+/*-------------------------------------------------------------------*/
+static bool itrc_switch( ITRC_CPU* ic )
+{
+    int other = ic->cur ^ 1;
+
+    if (ic->full[ other ])
+        return false;
+
+    if (ic->used)
+    {
+        ic->len[ ic->cur ] = ic->used;
+        HARDWARE_SYNC();
+        ic->full[ ic->cur ] = true;
+
+        obtain_lock( &itrc_lock );
+        signal_condition( &itrc_cond );
+        release_lock( &itrc_lock );
+
+        ic->cur  = other;
+        ic->used = 0;
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Write one buffer to the trace file as a block                     */
+/*-------------------------------------------------------------------*/
+static void itrc_write_block( int cpu, BYTE arch_mode, BYTE* buf, U32 len )
+{
+    ITRC_BLKHDR  blk;
+
+    if (itrc_ioerr || !len)
+        return;
+
+    STORE_FW( blk.len,   len );
+    STORE_HW( blk.cpuad, (U16) cpu );
+    blk.arch_mode = arch_mode;
+    blk.resv      = 0;
+
+    if (0
+        || !ITRC_WRITE( itrc_file, &blk, sizeof( blk ))
+        || !ITRC_WRITE( itrc_file, buf,  len )
+    )
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "write()", strerror( errno ));
+        itrc_ioerr = true;
+        return;
+    }
+    itrc_bytes += sizeof( blk ) + len;
+}
+
+/*-------------------------------------------------------------------*/
+/* Write every buffer that a CPU has handed over                     */
+/*-------------------------------------------------------------------*/
+static bool itrc_write_full()
+{
+    ITRC_CPU*  ic;
+    bool       wrote = false;
+    int        cpu, b;
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (!(ic = itrc_cpu[ cpu ]))
+            continue;
+
+        for (b = 0; b < 2; b++)
+        {
+            if (ic->full[b])
+            {
+                HARDWARE_SYNC();
+                itrc_write_block( cpu, ic->buf[b][0], ic->buf[b] + 1, ic->len[b] - 1 );
+                HARDWARE_SYNC();
+                ic->full[b] = false;
+                wrote = true;
+            }
+        }
+    }
+    return wrote;
+}
+
+/*-------------------------------------------------------------------*/
+/* Writer thread                                                     */
+/*-------------------------------------------------------------------*/
+static void* itrc_writer( void* arg )
+{
+    bool stop = false;
+
+    UNREFERENCED( arg );
+
+    while (!stop)
+    {
+        obtain_lock( &itrc_lock );
+        {
+            if (!itrc_stop)
+                timed_wait_condition_relative_usecs( &itrc_cond, &itrc_lock, 1000000, NULL );
+            stop = itrc_stop;
+        }
+        release_lock( &itrc_lock );
+
+        while (itrc_write_full())
+            ;   /* (keep going until nothing is left) */
+    }
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Free all trace buffers. The ITRC_CPU structures themselves are    */
+/* never freed: a CPU may have fetched its pointer just before       */
+/* tracing was stopped, and only then finds out (via 'busy').        */
+/*-------------------------------------------------------------------*/
+static void itrc_free()
+{
+    int cpu;
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (itrc_cpu[ cpu ])
+        {
+            free( itrc_cpu[ cpu ]->buf[0] );
+            free( itrc_cpu[ cpu ]->buf[1] );
+            itrc_cpu[ cpu ]->buf[0] = NULL;
+            itrc_cpu[ cpu ]->buf[1] = NULL;
+        }
+    }
+    free( itrc_fname );
+    itrc_fname = NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Open the trace file, allocate buffers and start the writer        */
+/*-------------------------------------------------------------------*/
+static int itrc_open( const char* fname, U32 bufsize, bool stor )
+{
+    ITRC_FILEHDR  hdr;
+    ITRC_CPU*     ic;
+    int           cpu, rc;
+
+    if (!itrc_inited)
+    {
+        initialize_lock( &itrc_lock );
+        initialize_condition( &itrc_cond );
+        itrc_inited = true;
+    }
+
+    /* Reset what is left of an earlier trace */
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if ((ic = itrc_cpu[ cpu ]))
+        {
+            ic->full[0]  = ic->full[1] = false;
+            ic->cur      = 0;
+            ic->used     = 0;
+            ic->lost     = 0;
+            ic->records  = 0;
+            ic->lostrecs = 0;
+        }
+    }
+
+    for (cpu = 0; cpu < sysblk.maxcpu; cpu++)
+    {
+        if (!IS_CPU_ONLINE( cpu ))
+            continue;
+
+        /* First byte of each buffer is the block's architecture */
+        if (0
+            || (!itrc_cpu[ cpu ] && !(itrc_cpu[ cpu ] = calloc( 1, sizeof( ITRC_CPU ))))
+            || !((ic = itrc_cpu[ cpu ])->buf[0] = malloc( bufsize + 1 ))
+            || !(ic->buf[1] = malloc( bufsize + 1 ))
+        )
+        {
+            // "Error in function %s: %s"
+            WRMSG( HHC00075, "E", "malloc()", strerror( errno ));
+            itrc_free();
+            return -1;
+        }
+    }
+
+    if (!(itrc_file = ITRC_OPEN( fname )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "open()", strerror( errno ));
+        itrc_free();
+        return -1;
+    }
+
+    memcpy( hdr.magic, ITRC_MAGIC, sizeof( hdr.magic ));
+    STORE_HW( hdr.version, ITRC_VERSION );
+    STORE_HW( hdr.hdrlen,  sizeof( hdr ));
+    STORE_FW( hdr.resv,    0 );
+
+    itrc_fname   = strdup( fname );
+    itrc_bufsize = bufsize;
+    itrc_stor    = stor;
+    itrc_bytes   = 0;
+    itrc_ioerr   = false;
+    itrc_stop    = false;
+    memset( itrc_named, 0, sizeof( itrc_named ));
+
+    if (!ITRC_WRITE( itrc_file, &hdr, sizeof( hdr )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "write()", strerror( errno ));
+        ITRC_CLOSE( itrc_file );
+        itrc_free();
+        return -1;
+    }
+    itrc_bytes = sizeof( hdr );
+
+    if ((rc = create_thread( &itrc_tid, JOINABLE, itrc_writer, NULL, "itrace writer" )))
+    {
+        // "Error in function create_thread(): %s"
+        WRMSG( HHC00102, "E", strerror( rc ));
+        ITRC_CLOSE( itrc_file );
+        itrc_free();
+        return -1;
+    }
+
+    HARDWARE_SYNC();
+    sysblk.itrace = true;
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Sum the counts of all CPUs                                        */
+/*-------------------------------------------------------------------*/
+static void itrc_counts( U64* records, U64* lost )
+{
+    int cpu;
+
+    *records = *lost = 0;
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (itrc_cpu[ cpu ])
+        {
+            *records += itrc_cpu[ cpu ]->records;
+            *lost    += itrc_cpu[ cpu ]->lostrecs;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Stop tracing, write whatever remains and close the trace file     */
+/*-------------------------------------------------------------------*/
+static void itrc_close()
+{
+    ITRC_CPU*  ic;
+    U64        records, lost;
+    int        cpu;
+
+    /* Stop tracing and wait for any CPU still building a record
+       (sleeping, as we likely have a higher priority than it does) */
+    sysblk.itrace = false;
+    HARDWARE_SYNC();
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+        if ((ic = itrc_cpu[ cpu ]))
+            while (ic->busy)
+                usleep( 1000 );
+
+    /* Stop the writer thread once it has written all full buffers */
+    obtain_lock( &itrc_lock );
+    {
+        itrc_stop = true;
+        signal_condition( &itrc_cond );
+    }
+    release_lock( &itrc_lock );
+    join_thread( itrc_tid, NULL );
+
+    /* Write the partially filled buffers, then any records lost
+       since (a block with just a LOST record) */
+    itrc_write_full();
+
+    for (cpu = 0; cpu < MAX_CPU_ENGS; cpu++)
+    {
+        if (!(ic = itrc_cpu[ cpu ]))
+            continue;
+
+        if (ic->used)
+            itrc_write_block( cpu, ic->arch_mode,
+                ic->buf[ ic->cur ] + 1, ic->used - 1 );
+
+        if (ic->lost)
+        {
+            BYTE  rec[ sizeof( ITRC_RECHDR ) + 8 ];
+
+            rec[0] = ITRC_LOST;
+            rec[1] = 0;
+            STORE_HW( rec + 2, sizeof( rec ));
+            STORE_DW( rec + 4, ic->lost );
+            itrc_write_block( cpu, ic->arch_mode, rec, sizeof( rec ));
+        }
+    }
+
+    if (ITRC_CLOSE( itrc_file ) != 0 && !itrc_ioerr)
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "close()", strerror( errno ));
+
+    itrc_counts( &records, &lost );
+
+    // "Binary instruction trace to %s ended: %"PRIu64" records, %"PRIu64" bytes, %"PRIu64" records lost"
+    WRMSG( HHC02816, "I", itrc_fname, records, itrc_bytes, lost );
+
+    itrc_free();
+}
+
+/*-------------------------------------------------------------------*/
+/* tfile command - binary instruction trace to file                  */
+/*-------------------------------------------------------------------*/
+int tfile_cmd( int argc, char* argv[], char* cmdline )
+{
+    U32   bufsize = ITRC_DEFBUFSIZE;
+    bool  stor    = false;
+    U64   records, lost;
+    int   i;
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    /* Display status */
+    if (argc < 2)
+    {
+        if (!sysblk.itrace)
+        {
+            // "Binary instruction trace is not active"
+            WRMSG( HHC02817, "I" );
+            return 0;
+        }
+        itrc_counts( &records, &lost );
+
+        // "Binary instruction trace to %s: %"PRIu64" records, %"PRIu64" bytes, %"PRIu64" records lost"
+        WRMSG( HHC02818, "I", itrc_fname, records, itrc_bytes, lost );
+        return 0;
+    }
+
+    /* Close the trace file */
+    if (CMD( argv[1], OFF, 3 ) || CMD( argv[1], CLOSE, 5 ))
+    {
+        if (argc > 2)
+        {
+            // "Invalid argument(s). Type 'help %s' for assistance."
+            WRMSG( HHC02211, "E", argv[0] );
+            return -1;
+        }
+        if (!sysblk.itrace)
+        {
+            // "Binary instruction trace is not active"
+            WRMSG( HHC02817, "I" );
+            return 0;
+        }
+        itrc_close();
+        return 0;
+    }
+
+    /* Open a new trace file */
+    if (sysblk.itrace)
+    {
+        // "Binary instruction trace is already active to %s"
+        WRMSG( HHC02819, "E", itrc_fname );
+        return -1;
+    }
+
+    for (i = 2; i < argc; i++)
+    {
+        U32   kb;
+        BYTE  c;
+
+        if (CMD( argv[i], STOR, 4 ))
+            stor = true;
+        else if (1
+            && strncasecmp( argv[i], "BUFSIZE=", 8 ) == 0
+            && sscanf( argv[i] + 8, "%u%c", &kb, &c ) == 1
+            && kb * 1024 >= ITRC_MINBUFSIZE
+            && kb <= 65536
+        )
+            bufsize = kb * 1024;
+        else
+        {
+            // "Invalid argument %s%s"
+            WRMSG( HHC02205, "E", argv[i], "" );
+            return -1;
+        }
+    }
+
+    if (itrc_open( argv[1], bufsize, stor ) != 0)
+        return -1;
+
+    // "Binary instruction trace to %s started%s"
+    WRMSG( HHC02815, "I", itrc_fname, stor ? " with storage operands" : "" );
+    return 0;
+}
+
+#endif /* _ITRACE_C_ONCE_ */
+
+/*-------------------------------------------------------------------*/
+/* Current PSW less its instruction address (and ilc) bits           */
+/*-------------------------------------------------------------------*/
+static inline U64 ARCH_DEP( itrc_psw )( REGS* regs )
+{
+#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    return make_psw64( regs, 900, false );
+#else
+ #if defined( FEATURE_BCMODE )
+    if (!ECMODE( &regs->psw ))
+        return make_psw64( regs, 370, true ) & ~0xC0FFFFFFULL;
+ #endif
+    return make_psw64( regs, 390, false ) & ~0x7FFFFFFFULL;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* Build an operand into a record; returns where the next one goes   */
+/*-------------------------------------------------------------------*/
+static BYTE* ARCH_DEP( itrc_operand )( REGS* regs, BYTE* p, VADR vaddr, int ar )
+{
+    U64   raddr = vaddr;
+    RADR  aaddr;
+    int   stid;
+    U16   xcode = 0;
+    int   len = 0;
+
+    STORE_DW( p, vaddr );
+    p[8] = (ar == USE_REAL_ADDR);
+
+    if (ar != USE_REAL_ADDR)
+        xcode = ARCH_DEP( virt_to_real )( &raddr, &stid, vaddr, ar, regs, ACCTYPE_HW );
+
+    if (!xcode && !SIE_MODE( regs ))
+    {
+        aaddr = APPLY_PREFIXING( raddr, regs->PX );
+
+        if (aaddr <= regs->mainlim)
+        {
+            /* Up to 16 bytes, but not beyond the page or storage */
+            len = PAGEFRAME_PAGESIZE - (int)(aaddr & PAGEFRAME_BYTEMASK);
+            if (len > ITRC_OPDATA)
+                len = ITRC_OPDATA;
+            if (aaddr + len - 1 > regs->mainlim)
+                len = (int)(regs->mainlim - aaddr + 1);
+            memcpy( p + 12, regs->mainstor + aaddr, len );
+        }
+    }
+
+    p[9] = (BYTE) len;
+    STORE_HW( p + 10, xcode );
+    return p + 12 + len;
+}
+
+/*-------------------------------------------------------------------*/
+/* Trace an instruction into the executing CPU's trace buffer        */
+/*-------------------------------------------------------------------*/
+void ARCH_DEP( itrace_inst )( REGS* regs, BYTE* inst )
+{
+    ITRC_CPU*  ic = itrc_cpu[ regs->cpuad ];
+    BYTE*      rec;                     /* Record being built        */
+    BYTE*      p;                       /* Next field of record      */
+    BYTE*      pmask;                   /* Where gprmask goes        */
+    U64        psw;                     /* PSW less IA               */
+    U16        key;                     /* Opcode key                */
+    U16        mask = 0;                /* Registers recorded        */
+    BYTE       flags = 0;               /* Record flags              */
+    bool       fresh;                   /* First record of block     */
+    int        r;
+
+    if (!ic || !inst)
+        return;
+
+    /* Tell itrc_close we are using our buffer, then make sure
+       tracing has not been stopped in the meantime (and that we
+       have buffers: a CPU that was offline when it started has
+       none, nor has one left over from an earlier trace) */
+    ic->busy = true;
+    HARDWARE_SYNC();
+
+    if (!sysblk.itrace || !ic->buf[0])
+    {
+        ic->busy = false;
+        return;
+    }
+
+    /* Start a new buffer if the architecture mode has changed or
+       there may not be enough room for this record in this one */
+    if (ic->used && (ic->arch_mode != regs->arch_mode
+        || ic->used + ITRC_MAXREC > itrc_bufsize + 1))
+    {
+        if (!itrc_switch( ic ))
+        {
+            ic->lost++;
+            ic->lostrecs++;
+            ic->busy = false;
+            return;
+        }
+    }
+
+    /* First byte of every buffer holds its architecture mode */
+    if (!ic->used)
+    {
+        ic->buf[ ic->cur ][0] = ic->arch_mode = regs->arch_mode;
+        ic->used = 1;
+    }
+    fresh = (ic->used == 1);
+    rec = p = ic->buf[ ic->cur ] + ic->used;
+
+    /* Report the records that were lost before this block */
+    if (fresh && ic->lost)
+    {
+        p[0] = ITRC_LOST;
+        p[1] = 0;
+        STORE_HW( p + 2, sizeof( ITRC_RECHDR ) + 8 );
+        STORE_DW( p + 4, ic->lost );
+        p += sizeof( ITRC_RECHDR ) + 8;
+        ic->lost = 0;
+    }
+
+    /* Name each opcode the first time it is traced */
+    key = itrc_opkey( inst );
+    if (!(itrc_named[ key >> 3 ] & (0x80 >> (key & 7))))
+    {
+        char   buf[ 256 ];
+        char*  mnem;
+        char*  name;
+        size_t mlen, nlen;
+
+        itrc_named[ key >> 3 ] |= (0x80 >> (key & 7));
+
+        buf[0] = 0;
+        PRINT_INST( inst, buf );
+
+        /* Mnemonic is the first word, name the last */
+        for (mnem = buf; *mnem == ' '; mnem++);
+        mlen = strcspn( mnem, " " );
+        name = strrchr( mnem, ' ' );
+        name = name ? name + 1 : mnem + mlen;
+        nlen = strlen( name );
+        if (mlen > ITRC_MAXNAME) mlen = ITRC_MAXNAME;
+        if (nlen > ITRC_MAXNAME) nlen = ITRC_MAXNAME;
+
+        p[0] = ITRC_MNEM;
+        p[1] = 0;
+        STORE_HW( p + 2, (U16)(sizeof( ITRC_RECHDR ) + 2 + 1 + mlen + 1 + nlen ));
+        STORE_HW( p + 4, key );
+        p += sizeof( ITRC_RECHDR ) + 2;
+        *p++ = (BYTE) mlen; memcpy( p, mnem, mlen ); p += mlen;
+        *p++ = (BYTE) nlen; memcpy( p, name, nlen ); p += nlen;
+    }
+
+    /* Now the instruction record itself */
+    rec = p;
+    p += sizeof( ITRC_RECHDR );
+
+    STORE_DW( p, host_tod() - ETOD_1970 );
+    p += 8;
+    STORE_DW( p, PSW_IA_FROM_IP( regs, 0 ));
+    p += 8;
+
+    psw = ARCH_DEP( itrc_psw )( regs );
+    if (fresh || psw != ic->psw)
+    {
+        flags |= ITRC_F_PSW;
+        STORE_DW( p, psw );
+        p += 8;
+        ic->psw = psw;
+    }
+
+    memcpy( p, inst, ILC( inst[0] ));
+    p += ILC( inst[0] );
+
+    pmask = p;
+    p += 2;
+    for (r = 0; r < 16; r++)
+    {
+        if (fresh || regs->GR_G( r ) != ic->gr[r])
+        {
+            mask |= (0x8000 >> r);
+            STORE_DW( p, regs->GR_G( r ));
+            p += 8;
+            ic->gr[r] = regs->GR_G( r );
+        }
+    }
+    STORE_HW( pmask, mask );
+
+    if (itrc_stor)
+    {
+        int   b1, b2, ar1, ar2;
+        VADR  addr1, addr2;
+
+        ARCH_DEP( inst_operands )( regs, inst, &b1, &addr1, &ar1, &b2, &addr2, &ar2 );
+
+        if (b1 >= 0)
+        {
+            flags |= ITRC_F_OP1;
+            p = ARCH_DEP( itrc_operand )( regs, p, addr1, ar1 );
+        }
+        if (b2 >= 0)
+        {
+            flags |= ITRC_F_OP2;
+            p = ARCH_DEP( itrc_operand )( regs, p, addr2, ar2 );
+        }
+    }
+
+#if defined( _FEATURE_SIE )
+    if (SIE_MODE( regs ))
+        flags |= ITRC_F_SIE;
+#endif
+
+    rec[0] = ITRC_INST;
+    rec[1] = flags;
+    STORE_HW( rec + 2, (U16)(p - rec) );
+
+    ic->used = (U32)(p - ic->buf[ ic->cur ]);
+    ic->records++;
+
+    HARDWARE_SYNC();
+    ic->busy = false;
+}
+
+/*-------------------------------------------------------------------*/
+/* Compile ARCH_DEP() functions for other build architectures...     */
+/*-------------------------------------------------------------------*/
+
+#if !defined(_GEN_ARCH)             // (first time here?)
+
+#if defined(_ARCH_NUM_1)
+ #define  _GEN_ARCH _ARCH_NUM_1      // (set next build architecture)
+ #include "itrace.c"                // (compile ourselves again)
+#endif
+
+#if defined(_ARCH_NUM_2)
+ #undef   _GEN_ARCH
+ #define  _GEN_ARCH _ARCH_NUM_2      // (set next build architecture)
+ #include "itrace.c"                // (compile ourselves again)
+#endif
+
+#endif /*!defined(_GEN_ARCH)*/
@@ -0,0 +1,134 @@
+/* ITRACE.H     (C) Copyright Hercules development team, 2026        */
+/*              Binary instruction trace file format                 */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* When a binary instruction trace file is open ('tfile' command),   */
+/* every instruction that 't+' would have displayed is instead       */
+/* written as a compact binary record into a buffer belonging to the */
+/* CPU that executed it. Full buffers are written (gzip compressed   */
+/* when zlib is available) to the file by a separate thread, and are */
+/* decoded offline by the 'itrcprt' utility.                         */
+/*                                                                   */
+/* All multi-byte fields are big-endian. The file is a FILE HEADER   */
+/* followed by any number of BLOCKS, each being the contents of one  */
+/* CPU buffer. Within each block the first INST record carries the   */
+/* complete PSW and all general registers; later records carry only  */
+/* whatever changed since the previous record of the same block.     */
+/*-------------------------------------------------------------------*/
+
+#ifndef _ITRACE_H_
+#define _ITRACE_H_
+
+/*-------------------------------------------------------------------*/
+/* File header                                                       */
+/*-------------------------------------------------------------------*/
+#define ITRC_MAGIC      "HERCITRC"      /* File identification       */
+#define ITRC_VERSION    1               /* File format version       */
+
+struct ITRC_FILEHDR
+{
+    BYTE    magic[8];                   /* ITRC_MAGIC                */
+    HWORD   version;                    /* ITRC_VERSION              */
+    HWORD   hdrlen;                     /* Length of this header     */
+    FWORD   resv;                       /* (reserved)                */
+};
+typedef struct ITRC_FILEHDR ITRC_FILEHDR;
+
+/*-------------------------------------------------------------------*/
+/* Block header: precedes each buffer of records of one CPU          */
+/*-------------------------------------------------------------------*/
+struct ITRC_BLKHDR
+{
+    FWORD   len;                        /* Length of records that    */
+                                        /* follow this header        */
+    HWORD   cpuad;                      /* CPU address               */
+    BYTE    arch_mode;                  /* ARCH_370/390/900_IDX      */
+    BYTE    resv;                       /* (reserved)                */
+};
+typedef struct ITRC_BLKHDR ITRC_BLKHDR;
+
+/*-------------------------------------------------------------------*/
+/* Record header: begins every record                                */
+/*-------------------------------------------------------------------*/
+struct ITRC_RECHDR
+{
+    BYTE    type;                       /* Record type (see below)   */
+    BYTE    flags;                      /* Record flags (see below)  */
+    HWORD   len;                        /* Length including header   */
+};
+typedef struct ITRC_RECHDR ITRC_RECHDR;
+
+#define ITRC_INST       1               /* Instruction executed      */
+#define ITRC_MNEM       2               /* Opcode mnemonic and name  */
+#define ITRC_LOST       3               /* Records lost (no buffer)  */
+
+/*-------------------------------------------------------------------*/
+/* ITRC_INST record: following the record header are, in order:     */
+/*                                                                   */
+/*   DBLWRD  tod      host time since 1970 in 1/16 microseconds      */
+/*   DBLWRD  ia       address of the instruction                     */
+/*   DBLWRD  psw      PSW without its instruction address bits,      */
+/*                    only if flags & ITRC_F_PSW                     */
+/*   BYTE    inst[]   the instruction itself (2, 4 or 6 bytes)       */
+/*   HWORD   gprmask  X'8000' >> r for each general register r       */
+/*                    whose value then follows                       */
+/*   DBLWRD  gr[]     the value of each of those registers           */
+/*   op1, op2         each only if flags & ITRC_F_OP1/ITRC_F_OP2:    */
+/*     DBLWRD  addr   operand address                                */
+/*     BYTE    real   1 = real address, 0 = virtual address          */
+/*     BYTE    len    bytes of storage that follow (0 to 16), or 0   */
+/*                    if the address could not be translated         */
+/*     HWORD   xcode  translation exception code, if any             */
+/*     BYTE    data[] the storage at the operand address             */
+/*-------------------------------------------------------------------*/
+#define ITRC_F_PSW      0x80            /* PSW changed (is present)  */
+#define ITRC_F_OP1      0x40            /* First operand present     */
+#define ITRC_F_OP2      0x20            /* Second operand present    */
+#define ITRC_F_SIE      0x10            /* Executed under SIE        */
+
+#define ITRC_OPDATA     16              /* Max operand data captured */
+
+/*-------------------------------------------------------------------*/
+/* ITRC_MNEM record: written the first time each opcode is traced,   */
+/* so the decoder can name instructions without the opcode tables:   */
+/*                                                                   */
+/*   HWORD   key      itrc_opkey() of the instruction                */
+/*   BYTE    mlen     length of mnemonic                             */
+/*   char    mnem[]   mnemonic, e.g. "LR"                            */
+/*   BYTE    nlen     length of name                                 */
+/*   char    name[]   descriptive name, e.g. "load_register"         */
+/*                                                                   */
+/* ITRC_LOST record: written at the start of a block when records    */
+/* had to be discarded because both of the CPU's buffers were full:  */
+/*                                                                   */
+/*   DBLWRD  count    number of instruction records lost             */
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/* Opcode key: first opcode byte plus the extended opcode, if any    */
+/*-------------------------------------------------------------------*/
+static INLINE U16 itrc_opkey( const BYTE* inst )
+{
+    switch (inst[0])
+    {
+    case 0x01: case 0xA4: case 0xA6: case 0xB2: case 0xB3:
+    case 0xB9: case 0xE4: case 0xE5: case 0xE6:
+        return (inst[0] << 8) | inst[1];
+
+    case 0xA5: case 0xA7: case 0xC0: case 0xC2: case 0xC4:
+    case 0xC6: case 0xC8: case 0xCC:
+        return (inst[0] << 8) | (inst[1] & 0x0F);
+
+    case 0xE3: case 0xE7: case 0xEB: case 0xEC: case 0xED:
+        return (inst[0] << 8) | inst[5];
+
+    default:
+        return (inst[0] << 8);
+    }
+}
+
+#endif /* _ITRACE_H_ */
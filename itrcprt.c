@@ -0,0 +1,367 @@
+/* ITRCPRT.C    (C) Copyright Hercules development team, 2026        */
+/*              Binary instruction trace print utility               */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This program decodes a binary instruction trace file written by   */
+/* the Hercules 'tfile' command (see itrace.h) and prints the traced */
+/* instructions, optionally only those of a given CPU, address range */
+/* or instruction. The file is read twice: first to learn the opcode */
+/* mnemonics it contains, then to print the instructions.            */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#include "hercules.h"
+#include "itrace.h"
+
+#define UTILITY_NAME    "itrcprt"
+#define UTILITY_DESC    "Binary instruction trace print"
+
+#if defined( HAVE_ZLIB )
+  #define ITRC_FILE             gzFile
+  #define ITRC_OPEN( _fn )      gzopen( (_fn), "rb" )
+  #define ITRC_READ( _f,_b,_n)  (gzread( (_f), (_b), (unsigned)(_n) ) == (int)(_n))
+  #define ITRC_REWIND( _f )     gzrewind( _f )
+  #define ITRC_CLOSE( _f )      gzclose( _f )
+#else
+  #define ITRC_FILE             FILE*
+  #define ITRC_OPEN( _fn )      fopen( (_fn), "rb" )
+  #define ITRC_READ( _f,_b,_n)  (fread( (_b), 1, (_n), (_f) ) == (size_t)(_n))
+  #define ITRC_REWIND( _f )     rewind( _f )
+  #define ITRC_CLOSE( _f )      fclose( _f )
+#endif
+
+/*-------------------------------------------------------------------*/
+/* Options and state                                                 */
+/*-------------------------------------------------------------------*/
+static int    opt_cpu = -1;             /* -c CPU, or -1 for all     */
+static U64    opt_beg = 0;              /* -a first address          */
+static U64    opt_end = ~0ULL;          /* -a last address           */
+static char*  opt_mnem;                 /* -o mnemonic, or NULL      */
+static U64    opt_max = ~0ULL;          /* -n instructions to print  */
+static bool   opt_regs;                 /* -r display all registers  */
+
+static char*  mnem[ 65536 ];            /* Mnemonic of each opcode   */
+static char*  name[ 65536 ];            /* Name of each opcode       */
+
+static U64    traced;                   /* Instructions in file      */
+static U64    printed;                  /* Instructions printed      */
+static U64    lost;                     /* Instructions lost         */
+
+/* Each CPU's registers as of its previous instruction */
+static U64    cpu_gr[ MAX_CPU_ENGS ][16];
+
+/*-------------------------------------------------------------------*/
+/* Remember the mnemonic and name from a MNEM record                 */
+/*-------------------------------------------------------------------*/
+static bool save_mnem( BYTE* p, U16 len )
+{
+    U16  key;
+    int  mlen, nlen;
+
+    if (len < 3)
+        return false;
+
+    FETCH_HW( key, p );
+    mlen = p[2];
+    if (3 + mlen + 1 > len || 3 + mlen + 1 + (nlen = p[3 + mlen]) > len)
+        return false;
+
+    if (!mnem[ key ])
+    {
+        mnem[ key ] = calloc( 1, mlen + 1 );
+        name[ key ] = calloc( 1, nlen + 1 );
+        if (!mnem[ key ] || !name[ key ])
+            return false;
+        memcpy( mnem[ key ], p + 3, mlen );
+        memcpy( name[ key ], p + 3 + mlen + 1, nlen );
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Print an instruction record; returns false if it is malformed     */
+/*-------------------------------------------------------------------*/
+static bool print_inst( int cpu, BYTE arch_mode, BYTE flags, BYTE* p, U16 len )
+{
+    BYTE*   end = p + len;
+    U64     tod, ia, psw = 0;
+    U16     key, mask;
+    BYTE*   inst;
+    int     ilc, r, n, i;
+    bool    zarch = (arch_mode == ARCH_900_IDX);
+    char    buf[ 128 ];
+    time_t  secs;
+    struct tm* tm;
+
+    traced++;
+
+    if (len < 8 + 8)
+        return false;
+
+    FETCH_DW( tod, p ); p += 8;
+    FETCH_DW( ia,  p ); p += 8;
+
+    if (flags & ITRC_F_PSW)
+    {
+        if (p + 8 > end)
+            return false;
+        FETCH_DW( psw, p ); p += 8;
+    }
+
+    if (p + 2 > end || p + (ilc = ILC( p[0] )) + 2 > end)
+        return false;
+    inst = p;
+    p += ilc;
+
+    FETCH_HW( mask, p ); p += 2;
+    for (r = 0; r < 16; r++)
+    {
+        if (mask & (0x8000 >> r))
+        {
+            if (p + 8 > end)
+                return false;
+            FETCH_DW( cpu_gr[ cpu ][ r ], p ); p += 8;
+        }
+    }
+
+    /* Apply the filters */
+    key = itrc_opkey( inst );
+    if (0
+        || printed >= opt_max
+        || (opt_cpu >= 0 && opt_cpu != cpu)
+        || ia < opt_beg || ia > opt_end
+        || (opt_mnem && (!mnem[ key ] || strcasecmp( opt_mnem, mnem[ key ] ) != 0))
+    )
+        return true;
+
+    printed++;
+
+    /* Time, CPU and PSW (when it changed) */
+    secs = (time_t)(tod / 16000000);
+    tm = localtime( &secs );
+    strftime( buf, sizeof( buf ), "%H:%M:%S", tm );
+    printf( "%s.%06u CP%02X", buf, (unsigned)((tod / 16) % 1000000), cpu );
+
+    if (!(flags & ITRC_F_PSW))
+        printf( zarch ? "%34s" : "%18s", "" );
+    else if (zarch)
+        printf( " %16.16"PRIX64" %16.16"PRIX64, psw, ia );
+    else
+        printf( " %8.8X %8.8X", (U32)(psw >> 32), (U32)psw | (U32)ia );
+
+    /* Instruction address, instruction and mnemonic */
+    printf( zarch ? " %16.16"PRIX64" " : " %8.8"PRIX64" ", ia );
+    for (i = 0; i < 6; i++)
+        printf( i < ilc ? "%2.2X" : "  ", inst[i] );
+    printf( " %-8s %s%s\n", mnem[ key ] ? mnem[ key ] : "?",
+        name[ key ] ? name[ key ] : "", flags & ITRC_F_SIE ? " (SIE)" : "" );
+
+    /* The registers that were changed, or all of them */
+    for (r = 0, n = 0; r < 16; r++)
+    {
+        if (!opt_regs && !(mask & (0x8000 >> r)))
+            continue;
+        if (zarch)
+            printf( "%sR%-2d=%16.16"PRIX64, n % 4 ? " " : "    ", r, cpu_gr[ cpu ][ r ] );
+        else
+            printf( "%sR%-2d=%8.8X", n % 4 ? " " : "    ", r, (U32) cpu_gr[ cpu ][ r ] );
+        if (++n % 4 == 0)
+            printf( "\n" );
+    }
+    if (n % 4)
+        printf( "\n" );
+
+    /* The storage operands */
+    for (i = 0; i < 2; i++)
+    {
+        U64   addr;
+        U16   xcode;
+        int   dlen, j;
+
+        if (!(flags & (i ? ITRC_F_OP2 : ITRC_F_OP1)))
+            continue;
+
+        if (p + 12 > end || p + 12 + (dlen = p[9]) > end)
+            return false;
+
+        FETCH_DW( addr,  p );
+        FETCH_HW( xcode, p + 10 );
+
+        printf( "    OP%d %c:%16.16"PRIX64, i + 1, p[8] ? 'R' : 'V', addr );
+        if (xcode)
+            printf( " Translation exception %4.4X", xcode );
+        else
+            for (j = 0; j < dlen; j++)
+                printf( "%s%2.2X", j % 4 ? "" : " ", p[ 12 + j ] );
+        printf( "\n" );
+        p += 12 + dlen;
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Read the trace file once, saving mnemonics or printing records    */
+/*-------------------------------------------------------------------*/
+static int read_trace( ITRC_FILE f, const char* fname, bool print )
+{
+    ITRC_FILEHDR  hdr;
+    ITRC_BLKHDR   blk;
+    BYTE*         buf = NULL;
+    U32           bufsize = 0, blen, off;
+    U16           hdrlen, rlen;
+    int           cpu;
+    BYTE          skip[ 256 ];
+
+    if (0
+        || !ITRC_READ( f, &hdr, sizeof( hdr ))
+        || memcmp( hdr.magic, ITRC_MAGIC, sizeof( hdr.magic )) != 0
+        || fetch_hw( hdr.version ) != ITRC_VERSION
+        || (hdrlen = fetch_hw( hdr.hdrlen )) < sizeof( hdr )
+        || hdrlen - sizeof( hdr ) > sizeof( skip )
+        || !ITRC_READ( f, skip, hdrlen - sizeof( hdr ))
+    )
+    {
+        // "%s is not a binary instruction trace file"
+        FWRMSG( stderr, HHC02821, "E", fname );
+        return -1;
+    }
+
+    while ((!print || printed < opt_max) && ITRC_READ( f, &blk, sizeof( blk )))
+    {
+        blen = fetch_fw( blk.len );
+        cpu  = fetch_hw( blk.cpuad );
+
+        if (blen > bufsize)
+        {
+            free( buf );
+            if (!(buf = malloc( bufsize = blen )))
+            {
+                // "Error in function %s: %s"
+                FWRMSG( stderr, HHC00075, "E", "malloc()", strerror( errno ));
+                return -1;
+            }
+        }
+
+        if (cpu >= MAX_CPU_ENGS || !ITRC_READ( f, buf, blen ))
+        {
+            // "%s: bad record at block offset %u"
+            FWRMSG( stderr, HHC02822, "E", fname, 0 );
+            free( buf );
+            return -1;
+        }
+
+        for (off = 0; off < blen; off += rlen)
+        {
+            BYTE* rec = buf + off;
+
+            if (off + sizeof( ITRC_RECHDR ) > blen
+                || (rlen = fetch_hw( rec + 2 )) < sizeof( ITRC_RECHDR )
+                || off + rlen > blen)
+                break;
+
+            if (!print)
+            {
+                if (rec[0] == ITRC_MNEM
+                    && !save_mnem( rec + 4, rlen - 4 ))
+                    break;
+                continue;
+            }
+
+            if (rec[0] == ITRC_INST)
+            {
+                if (!print_inst( cpu, blk.arch_mode, rec[1], rec + 4, rlen - 4 ))
+                    break;
+            }
+            else if (rec[0] == ITRC_LOST && rlen >= 4 + 8)
+            {
+                U64 n = fetch_dw( rec + 4 );
+
+                lost += n;
+                if (opt_cpu < 0 || opt_cpu == cpu)
+                    printf( "*** CP%02X: %"PRIu64" instructions lost ***\n", cpu, n );
+            }
+        }
+
+        if (off != blen)
+        {
+            // "%s: bad record at block offset %u"
+            FWRMSG( stderr, HHC02822, "E", fname, off );
+            free( buf );
+            return -1;
+        }
+    }
+
+    free( buf );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* ITRCPRT main entry point                                          */
+/*-------------------------------------------------------------------*/
+int main( int argc, char* argv[] )
+{
+    char*      pgm;                     /* less any extension (.ext) */
+    char*      fname = NULL;            /* Trace file name           */
+    ITRC_FILE  f;                       /* Trace file                */
+    char       c;
+    int        i, rc;
+
+    INITIALIZE_UTILITY( UTILITY_NAME, UTILITY_DESC, &pgm );
+
+    for (i = 1; i < argc; i++)
+    {
+        if      (!strcmp( argv[i], "-r" ))
+            opt_regs = true;
+        else if (!strcmp( argv[i], "-c" ) && i+1 < argc
+            && sscanf( argv[++i], "%x%c", &opt_cpu, &c ) == 1
+            && opt_cpu < MAX_CPU_ENGS)
+            ;
+        else if (!strcmp( argv[i], "-a" ) && i+1 < argc
+            && (sscanf( argv[++i], "%"SCNx64"-%"SCNx64"%c", &opt_beg, &opt_end, &c ) == 2
+             || (sscanf( argv[i], "%"SCNx64"%c", &opt_beg, &c ) == 1
+                 && (opt_end = opt_beg, true)))
+            && opt_beg <= opt_end)
+            ;
+        else if (!strcmp( argv[i], "-o" ) && i+1 < argc)
+            opt_mnem = argv[++i];
+        else if (!strcmp( argv[i], "-n" ) && i+1 < argc)
+            opt_max = strtoull( argv[++i], NULL, 10 );
+        else if (argv[i][0] != '-' && !fname)
+            fname = argv[i];
+        else
+            break;
+    }
+    if (i < argc || !fname)
+    {
+        // "Usage: %s [options] tracefile"
+        WRMSG( HHC02820, "I", pgm );
+        return 1;
+    }
+
+    if (!(f = ITRC_OPEN( fname )))
+    {
+        // "Error in function %s: %s"
+        FWRMSG( stderr, HHC00075, "E", "open()", strerror( errno ));
+        return 2;
+    }
+
+    rc = read_trace( f, fname, false );
+    if (rc == 0)
+    {
+        ITRC_REWIND( f );
+        rc = read_trace( f, fname, true );
+    }
+    ITRC_CLOSE( f );
+
+    fflush( stdout );
+
+    // "%"PRIu64" instructions displayed, %"PRIu64" traced, %"PRIu64" lost"
+    FWRMSG( stderr, HHC02823, "I", printed, traced, lost );
+
+    return rc ? 2 : 0;
+}
@@ -48,6 +48,179 @@ static FILE *logger_hrdcpy;             /* Hardcopy log or zero      */
 static int   logger_hrdcpyfd;           /* Hardcopt fd or -1         */
 static char  logger_filename[MAX_PATH];
 
+/*********************************************************************/
+/* logger message ring                                               */
+/*********************************************************************/
+/*                                                                   */
+/* Messages issued via logmsg are not written to the logger pipe but */
+/* are placed into an in-process ring of fixed size slots which the  */
+/* logger thread drains.  Any number of threads may write to it at   */
+/* the same time without obtaining any lock: a writer reserves as    */
+/* many consecutive slots as its message needs by advancing the ring */
+/* head with compare-and-swap, copies its message into them and then */
+/* publishes each slot by storing its sequence number.  Each slot's  */
+/* sequence number equals its ring position while the slot is free,  */
+/* position + 1 once it holds data, and position + LOG_RINGSLOTS     */
+/* after the logger has consumed it (i.e. free for the next lap).    */
+/*                                                                   */
+/* The logger pipe is still read too, since stdout is redirected to  */
+/* it.  When the ring is empty the logger waits on both the pipe and */
+/* a small wakeup pipe which a writer only writes to when the logger */
+/* has said it is about to wait, so bursts cost no system calls.     */
+/*                                                                   */
+/* When the ring is full, a writer either drops its message at once  */
+/* (LOGOPT DROP) or waits for room for up to sysblk.logoptwait msecs */
+/* (LOGOPT BLOCK=msecs) before dropping it.                          */
+/*                                                                   */
+/*********************************************************************/
+
+#define LOG_RINGMASK    (LOG_RINGSLOTS - 1)
+
+#if defined( _MSVC_ )
+  #define LOG_RINGSYNC()    MemoryBarrier()
+#else
+  #define LOG_RINGSYNC()    __sync_synchronize()
+#endif
+
+typedef struct LOGSLOT
+{
+    volatile U32  seq;                  /* see above                 */
+             U32  len;                  /* message bytes in slot     */
+             char data[ LOG_SLOTDATA ]; /* message text              */
+}
+LOGSLOT;
+
+static LOGSLOT*     logring;            /* the message ring          */
+static volatile U32 logring_head;       /* next position to reserve  */
+static U32          logring_tail;       /* next position to consume  */
+static volatile U32 logring_idle;       /* 1 = logger about to wait  */
+static int          logring_wakefd[2] = /* logger wakeup pipe        */
+                            { -1, -1 };
+static volatile U64 logring_msgs;       /* messages written to ring  */
+static volatile U64 logring_dropped;    /* messages dropped          */
+static volatile U64 logring_blocked;    /* messages that had to wait */
+
+/*-------------------------------------------------------------------*/
+/* Atomically add one to a message ring counter                      */
+/*-------------------------------------------------------------------*/
+static void logring_count( volatile U64* counter )
+{
+    U64 old = *counter;
+    while (cmpxchg8( &old, old + 1, counter ));
+}
+
+/*********************************************************************/
+/*             log_write  -  write message to the ring               */
+/*********************************************************************/
+/*                                                                   */
+/* returns:                                                          */
+/*                                                                   */
+/*   0          the message was placed in the ring, or was dropped   */
+/*              because the ring stayed full (and was counted).      */
+/*                                                                   */
+/*  -1          the ring is not available (the logger is not active  */
+/*              or the message is too long for it), and the caller   */
+/*              must write the message some other way.               */
+/*                                                                   */
+/*********************************************************************/
+DLL_EXPORT int log_write( const char* msg, int len )
+{
+    LOGSLOT*  slot;
+    U32       pos, last, seq, need, i;
+    U64       waited = 0;
+    bool      blocked = false;
+
+    if (!logger_active || !logring)
+        return -1;
+
+    if (len <= 0)
+        return 0;
+
+    need = (len + LOG_SLOTDATA - 1) / LOG_SLOTDATA;
+
+    if (need > LOG_RINGSLOTS / 4)
+        return -1;
+
+    /* Reserve 'need' consecutive slots. Since the logger frees slots
+       strictly in order, the whole range is free when its last slot
+       is free for this lap.
+    */
+    for (;;)
+    {
+        pos  = logring_head;
+        last = pos + need - 1;
+        seq  = logring[ last & LOG_RINGMASK ].seq;
+
+        if (seq == last)
+        {
+            if (cmpxchg4( &pos, pos + need, &logring_head ) == 0)
+                break;
+            continue;
+        }
+
+        if ((S32)(seq - last) > 0)
+            continue;           /* (another writer got there first)  */
+
+        /* The ring is full. Wait for the logger to make room unless
+           our policy is to drop, we have waited long enough, or we
+           ARE the logger (which would then be waiting on itself).
+        */
+        if (0
+            || sysblk.logoptdrop
+            || waited >= (U64) sysblk.logoptwait * 1000
+            || equal_threads( thread_id(), sysblk.loggertid )
+        )
+        {
+            logring_count( &logring_dropped );
+            return 0;
+        }
+
+        if (!blocked)
+        {
+            blocked = true;
+            logring_count( &logring_blocked );
+        }
+
+        usleep( 1000 );
+        waited += 1000;
+    }
+
+    /* Copy the message into the slots and publish each of them */
+    for (i=0; i < need; i++, msg += LOG_SLOTDATA, len -= LOG_SLOTDATA)
+    {
+        slot = &logring[ (pos + i) & LOG_RINGMASK ];
+        slot->len = len < LOG_SLOTDATA ? len : LOG_SLOTDATA;
+        memcpy( slot->data, msg, slot->len );
+        LOG_RINGSYNC();
+        slot->seq = pos + i + 1;
+    }
+
+    logring_count( &logring_msgs );
+
+    /* Wake the logger if it is waiting (or about to) */
+    LOG_RINGSYNC();
+    if (logring_idle)
+    {
+        U32 idle = 1;
+        if (cmpxchg4( &idle, 0, &logring_idle ) == 0)
+            VERIFY( write_pipe( logring_wakefd[ LOG_WRITE ], "*", 1 ) == 1 );
+    }
+
+    return 0;
+}
+
+/*********************************************************************/
+/*          log_ringstats  -  return message ring statistics         */
+/*********************************************************************/
+DLL_EXPORT void log_ringstats( U64* msgs, U64* dropped, U64* blocked,
+                               U32* inuse )
+{
+    *msgs    = logring_msgs;
+    *dropped = logring_dropped;
+    *blocked = logring_blocked;
+    *inuse   = logring ? (logring_head - logring_tail) : 0;
+}
+
 /*********************************************************************/
 /*              log_read  -  read system log                         */
 /*********************************************************************/
@@ -304,6 +477,191 @@ DLL_EXPORT void logger_timestamped_logfile_write( const void* pBuff, size_t nByt
     }
 }
 
+/*-------------------------------------------------------------------*/
+/* Process 'bytes_read' bytes of new log data which has been placed  */
+/* into the message buffer at the current message index.  Hardcopy   */
+/* output is buffered and written out once for the whole batch.      */
+/*-------------------------------------------------------------------*/
+static void logger_consume( int bytes_read )
+{
+    /* If Hercules is not running in daemon mode and panel
+       initialization is not yet complete, write message
+       to stderr so the user can see it on the terminal */
+    if (!sysblk.daemon_mode)
+    {
+        if (!sysblk.panel_init)
+        {
+            char* pLeft2 = logger_buffer + logger_currmsg;
+            int   nLeft2 = bytes_read;
+
+            /* (ignore any errors; we did the best we could) */
+            if (nLeft2)
+                fwrite( pLeft2, nLeft2, 1, stderr );
+        }
+    }
+
+    obtain_lock( &logger_lock );
+    {
+        /* Write log data to hardcopy file */
+        if (logger_hrdcpy)
+        {
+            /* Prefix each line with a date/time stamp if needed */
+
+            static bool dostamp = true; // (MAYBE!)
+            char*  pLeft  = logger_buffer + logger_currmsg;
+            int    nLeft  = bytes_read;
+            char*  pRight = NULL;
+            int    nRight = 0;
+            char*  pNL    = NULL;   /* (pointer to NEWLINE character) */
+
+            if (dostamp)
+            {
+                if (STAMPLOG)
+                    logger_logfile_timestamp();
+                dostamp = false;
+            }
+
+            while ((pNL = memchr( pLeft, '\n', nLeft )) != NULL)
+            {
+                pRight  = pNL + 1;
+                nRight  = nLeft - ((int)(pRight - pLeft));
+                nLeft  -= nRight;
+
+                if (nLeft)
+                    logger_logfile_write( pLeft, nLeft );
+
+                pLeft = pRight;
+                nLeft = nRight;
+
+                if (!nLeft)
+                {
+                    dostamp = true;
+                    break;
+                }
+
+                if (STAMPLOG)
+                    logger_logfile_timestamp();
+            }
+
+            if (nLeft)
+                logger_logfile_write( pLeft, nLeft );
+
+            fflush( logger_hrdcpy );
+        }
+    }
+    release_lock( &logger_lock );
+
+    /* Increment buffer index to next available position */
+    logger_currmsg += bytes_read;
+
+    if (logger_currmsg >= logger_bufsize)
+    {
+        logger_currmsg = 0;
+        logger_wrapped = 1;
+    }
+
+    /* Notify all interested parties new log data is available */
+    obtain_lock( &logger_lock );
+    {
+        broadcast_condition( &logger_cond );
+    }
+    release_lock( &logger_lock );
+}
+
+/*-------------------------------------------------------------------*/
+/* Move messages from the ring into the message buffer, at most      */
+/* LOG_DEFSIZE bytes at a time, and return the number of bytes moved */
+/*-------------------------------------------------------------------*/
+static int logger_drain_ring()
+{
+    LOGSLOT*  slot;
+    int       total = 0;
+    int       batch = 0;
+    int       room;
+
+    while (total < LOG_DEFSIZE)
+    {
+        slot = &logring[ logring_tail & LOG_RINGMASK ];
+
+        if (slot->seq != logring_tail + 1)
+            break;              /* (empty, or not yet published)     */
+
+        LOG_RINGSYNC();
+
+        room = logger_bufsize - logger_currmsg - batch;
+
+        if ((int) slot->len < room)
+        {
+            memcpy( logger_buffer + logger_currmsg + batch,
+                    slot->data, slot->len );
+            batch += slot->len;
+        }
+        else
+        {
+            /* Fill the buffer up to its end, then wrap */
+            memcpy( logger_buffer + logger_currmsg + batch,
+                    slot->data, room );
+            logger_consume( batch + room );
+            batch = slot->len - room;
+            memcpy( logger_buffer + logger_currmsg,
+                    slot->data + room, batch );
+        }
+
+        total += slot->len;
+
+        /* Free the slot for the next lap */
+        LOG_RINGSYNC();
+        slot->seq = logring_tail + LOG_RINGSLOTS;
+        logring_tail++;
+    }
+
+    if (batch)
+        logger_consume( batch );
+
+    return total;
+}
+
+/*-------------------------------------------------------------------*/
+/* Wait until either the ring or the logger pipe has data, and then  */
+/* return TRUE if the logger pipe is the one that has it.            */
+/*-------------------------------------------------------------------*/
+static bool logger_wait()
+{
+    fd_set  readset;
+    char    wake[64];
+    int     maxfd;
+
+    /* Tell writers we are about to wait, then check once more that
+       the ring is still empty so no message can be left behind. */
+    logring_idle = 1;
+    LOG_RINGSYNC();
+
+    if (logring[ logring_tail & LOG_RINGMASK ].seq == logring_tail + 1)
+    {
+        logring_idle = 0;
+        return false;
+    }
+
+    FD_ZERO( &readset );
+    FD_SET( logger_syslogfd[ LOG_READ ], &readset );
+    FD_SET( logring_wakefd [ LOG_READ ], &readset );
+
+    maxfd = MAX( logger_syslogfd[ LOG_READ ], logring_wakefd[ LOG_READ ]);
+
+    if (select( maxfd + 1, &readset, NULL, NULL, NULL ) <= 0)
+    {
+        logring_idle = 0;
+        return false;
+    }
+
+    logring_idle = 0;
+
+    if (FD_ISSET( logring_wakefd[ LOG_READ ], &readset ))
+        VERIFY( read_pipe( logring_wakefd[ LOG_READ ], wake, sizeof( wake )) > 0 );
+
+    return FD_ISSET( logger_syslogfd[ LOG_READ ], &readset ) ? true : false;
+}
+
 static void* logger_thread( void* arg )
 {
     int bytes_read;
@@ -325,20 +683,28 @@ static void* logger_thread( void* arg )
     }
     release_lock( &logger_lock );
 
-    /* This read causes logger to exit when the write end is closed */
-    while
-    (
-        (bytes_read =
+    for (;;)
+    {
+        /* Drain the message ring first */
+        if (logger_drain_ring())
+            continue;
+
+        if (!logger_wait())
+            continue;
+
+        /* This read causes logger to exit when the write end is closed */
+        bytes_read =
             read_pipe   // read the maximum amount possible
             (
                 logger_syslogfd[ LOG_READ ],
                  (logger_buffer  + logger_currmsg),
                 ((logger_bufsize - logger_currmsg) < LOG_DEFSIZE ?
                  (logger_bufsize - logger_currmsg) : LOG_DEFSIZE)
-            )
-        )
-    )
-    {
+            );
+
+        if (!bytes_read)
+            break;
+
         if (bytes_read < 0)
         {
             int read_pipe_errno = HSO_errno;
@@ -364,90 +730,15 @@ static void* logger_thread( void* arg )
             bytes_read = 0;
         }
 
-        /* If Hercules is not running in daemon mode and panel
-           initialization is not yet complete, write message
-           to stderr so the user can see it on the terminal */
-        if (!sysblk.daemon_mode)
-        {
-            if (!sysblk.panel_init)
-            {
-                char* pLeft2 = logger_buffer + logger_currmsg;
-                int   nLeft2 = bytes_read;
-
-                /* (ignore any errors; we did the best we could) */
-                if (nLeft2)
-                    fwrite( pLeft2, nLeft2, 1, stderr );
-            }
-        }
-
-        obtain_lock( &logger_lock );
-        {
-            /* Write log data to hardcopy file */
-            if (logger_hrdcpy)
-            {
-                /* Prefix each line with a date/time stamp if needed */
-
-                static bool dostamp = true; // (MAYBE!)
-                char*  pLeft  = logger_buffer + logger_currmsg;
-                int    nLeft  = bytes_read;
-                char*  pRight = NULL;
-                int    nRight = 0;
-                char*  pNL    = NULL;   /* (pointer to NEWLINE character) */
-
-                if (dostamp)
-                {
-                    if (STAMPLOG)
-                        logger_logfile_timestamp();
-                    dostamp = false;
-                }
-
-                while ((pNL = memchr( pLeft, '\n', nLeft )) != NULL)
-                {
-                    pRight  = pNL + 1;
-                    nRight  = nLeft - ((int)(pRight - pLeft));
-                    nLeft  -= nRight;
-
-                    if (nLeft)
-                        logger_logfile_write( pLeft, nLeft );
-
-                    pLeft = pRight;
-                    nLeft = nRight;
-
-                    if (!nLeft)
-                    {
-                        dostamp = true;
-                        break;
-                    }
-
-                    if (STAMPLOG)
-                        logger_logfile_timestamp();
-                }
-
-                if (nLeft)
-                    logger_logfile_write( pLeft, nLeft );
-            }
-        }
-        release_lock( &logger_lock );
-
-        /* Increment buffer index to next available position */
-        logger_currmsg += bytes_read;
+        logger_consume( bytes_read );
 
-        if (logger_currmsg >= logger_bufsize)
-        {
-            logger_currmsg = 0;
-            logger_wrapped = 1;
-        }
+    } /* end for (;;) */
 
-        /* Notify all interested parties new log data is available */
-        obtain_lock( &logger_lock );
-        {
-            broadcast_condition( &logger_cond );
-        }
-        release_lock( &logger_lock );
+    logger_active = 0;
 
-    } /* end while (...) */
+    /* Pick up anything written to the ring before we went inactive */
+    logger_drain_ring();
 
-    logger_active = 0;
     sysblk.loggertid = 0;
 
     /* Logger is now terminating */
@@ -553,7 +844,7 @@ DLL_EXPORT void logger_init( void )
         }
 
         if (logger_hrdcpy)
-            setvbuf( logger_hrdcpy, NULL, _IONBF, 0 );
+            setvbuf( logger_hrdcpy, NULL, _IOFBF, LOG_HRDCPYBUF );
     }
     else
     {
@@ -571,13 +862,30 @@ DLL_EXPORT void logger_init( void )
         exit(1);
     }
 
-    if (create_pipe( logger_syslogfd ))
+    if (!(logring = malloc( LOG_RINGSLOTS * sizeof( LOGSLOT ))))
+    {
+        char buf[40];
+        MSGBUF( buf, "malloc(%d)", (int)(LOG_RINGSLOTS * sizeof( LOGSLOT )));
+        // "Logger: error in function %s: %s"
+        fprintf( stderr, MSG( HHC02102, "E", buf, strerror( errno )));
+        exit(1);
+    }
+
+    /* Each slot starts out free for its first lap */
+    for (rc=0; rc < LOG_RINGSLOTS; rc++)
+    {
+        logring[ rc ].seq = rc;
+        logring[ rc ].len = 0;
+    }
+
+    if (create_pipe( logger_syslogfd ) || create_pipe( logring_wakefd ))
     {
         // "Logger: error in function %s: %s"
         fprintf( stderr, MSG( HHC02102, "E", "create_pipe()", strerror( errno )));
         exit(1);  /* Hercules running without syslog */
     }
     socket_set_blocking_mode(logger_syslogfd[ LOG_WRITE ], O_NONBLOCK);
+    socket_set_blocking_mode(logring_wakefd [ LOG_WRITE ], O_NONBLOCK);
 
     setvbuf( logger_syslog[ LOG_WRITE ], NULL, _IONBF, 0 );
 
@@ -673,8 +981,9 @@ DLL_EXPORT void log_sethrdcpy( const char* filename )
             }
             else
             {
-                /* Set no buffering and switch to using new logfile */
-                setvbuf( new_hrdcpy, NULL, _IONBF, 0 );
+                /* Set full buffering (the logger flushes it after each
+                   batch of messages) and switch to using new logfile */
+                setvbuf( new_hrdcpy, NULL, _IOFBF, LOG_HRDCPYBUF );
 
                 obtain_lock( &logger_lock );
                 {
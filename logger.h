@@ -33,6 +33,18 @@
   #endif
 #endif
 
+/*-------------------------------------------------------------------*/
+/* Logger message ring: number of slots (must be a power of 2), the  */
+/* message bytes each slot holds, and the default number of msecs a  */
+/* writer waits for room when the ring is full before dropping its   */
+/* message (LOGOPT BLOCK=msecs).                                     */
+/*-------------------------------------------------------------------*/
+#define LOG_RINGSLOTS       4096
+#define LOG_SLOTDATA        120
+#define LOG_DEFWAIT         50
+
+#define LOG_HRDCPYBUF       (64 * 1024)     // hardcopy stdio buffer
+
 /*-------------------------------------------------------------------*/
 /* log message logging facility                                      */
 /*-------------------------------------------------------------------*/
@@ -47,6 +59,8 @@ LOGR_DLL_IMPORT void   log_sethrdcpy   ( const char* filename );
 LOGR_DLL_IMPORT void   log_wakeup      ( void* arg );
 LOGR_DLL_IMPORT char*  log_dsphrdcpy   ();
 LOGR_DLL_IMPORT int    logger_isactive ();
+LOGR_DLL_IMPORT int    log_write       ( const char* msg, int len );
+LOGR_DLL_IMPORT void   log_ringstats   ( U64* msgs, U64* dropped, U64* blocked, U32* inuse );
 
 #define TIMESTAMPLOG   (!sysblk.logoptnotime)
 #define DATESTAMPLOG   (!sysblk.logoptnodate)
@@ -264,6 +264,10 @@ static int do_write_pipe( int fd, const char *msg, int len)
 
 /*-------------------------------------------------------------------*/
 /* internal helper function:  write message to logger facility pipe  */
+/*                                                                   */
+/* The message normally goes into the logger's lock-free message     */
+/* ring (see logger.c).  The pipe is only used when the ring cannot  */
+/* take it (logger not yet/no longer active, or very long message).  */
 /*-------------------------------------------------------------------*/
 static void _flog_write_pipe( FILE* f, const char* msg )
 {
@@ -278,7 +282,10 @@ static void _flog_write_pipe( FILE* f, const char* msg )
         || sysblk.shutdown
         || stdout != f
         || !logger_syslogfd[ LOG_WRITE ]
-        || (rc = do_write_pipe( logger_syslogfd[ LOG_WRITE ], msg, len )) < 0
+        || (1
+            && (rc = log_write( msg, len )) < 0
+            && (rc = do_write_pipe( logger_syslogfd[ LOG_WRITE ], msg, len )) < 0
+           )
     )
     {
         // Something went wrong or we're shutting down.
@@ -550,6 +550,14 @@ typedef struct _MPC_IPA {
                       )
 #endif /*defined(ENABLE_IPV6)*/
 
+/*  Below is the additional assists Hercules claims to support when  */
+/*  the QETH 'offload' option is used (TUN/TAP virtio-net header).   */
+#define IPA_SUPP_OFFLOAD ( 0 \
+                      | IPA_INBOUND_CHECKSUM \
+                      | IPA_OUTBOUND_CHECKSUM \
+                      | IPA_OUTBOUND_TSO \
+                      )
+
 #define IPA_CMD_STARTLAN 0x01   /* Start LAN operations              */
 #define IPA_CMD_STOPLAN 0x02    /* Stop LAN operations               */
 #define IPA_CMD_SETVMAC 0x21    /* Set Layer-2 MAC address           */
@@ -763,6 +771,18 @@ typedef struct _MPC_IPA_SAS {
 /*00C*/ union {
             U32    flags_32;
             BYTE   ip[16];
+            struct {            /* IPA_xxBOUND_CHECKSUM              */
+/*00C*/       FWORD  supported; /* Supported checksums               */
+/*010*/       FWORD  enabled;   /* Enabled checksums                 */
+#define IPA_CHECKSUM_UDP        0x00000001
+#define IPA_CHECKSUM_TCP        0x00000002
+#define IPA_CHECKSUM_IP_HDR     0x00000004
+            } chksum;
+            struct {            /* IPA_OUTBOUND_TSO                  */
+/*00C*/       FWORD  mss;       /* Maximum large send size           */
+/*010*/       FWORD  supported; /* Supported large send types        */
+#define IPA_LARGE_SEND_TCP      0x00000002
+            } tso;
             /* There are other things that are part of the union. */
         } data;
     } MPC_IPA_SAS;
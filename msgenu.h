@@ -280,7 +280,9 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00089 "The are no HAO rules defined"
 #define HHC00090 "HAO thread waiting for logger facility to become active"
 #define HHC00091 "Logger facility now active; HAO thread proceeding"
-//efine HHC00092 - HHC00099 (available)
+#define HHC00092 "Index %02d: matched %"PRIu64" of %"PRIu64" tested, %"PRIu64" skipped; regex avg %.1f, max %.1f usecs; prefilter %s"
+#define HHC00093 "Prefilter: %d of %d rule(s) have a key; %"PRIu64" message(s) checked"
+//efine HHC00094 - HHC00099 (available)
 
 // reserve 100-129 thread related
 #define HHC00100 "Thread id "TIDPAT", prio %d, name '%s' started"
@@ -1302,7 +1304,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02100 "Logger: log not active"
 #define HHC02101 "Logger: log closed"
 #define HHC02102 "Logger: error in function %s: %s"
-//efine HHC02103 (available)
+#define HHC02103 "Logger: ring %u of %u slots in use; %"PRIu64" messages, %"PRIu64" dropped, %"PRIu64" waited for room"
 #define HHC02104 "Logger: log switched to %s"
 #define HHC02105 "Logger: log to %s"
 #define HHC02106 "Logger: log switched off"
@@ -1461,9 +1463,13 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02345 "%s device %1d:%04X group has registered IP address %s"
 #define HHC02346 "%s device %1d:%04X group has no registered MAC or IP addresses"
 #define HHC02347 "No %s devices found"
-//efine HHC02348 (available)
-//efine HHC02349 (available)
-//efine HHC02350 - HHC02359 (available)
+#define HHC02348 "%s device %1d:%04X group rates: read %u/s, written %u/s, interrupts %u/s"
+#define HHC02349 "%s device %1d:%04X group totals: read %u, written %u, dropped %u, interrupts %u, coalesced %u; coalescing %s%s"
+#define HHC02350 "%s device %1d:%04X group SIGA-w to transmit latency: average %u usecs, maximum %u usecs (%u samples); %s signalling"
+#define HHC02351 "%s device %1d:%04X group read path: blocks %"PRIu64", packets %"PRIu64", bytes %"PRIu64", dropped %"PRIu64", wakeups %"PRIu64
+#define HHC02352 "%s device %1d:%04X group write path: blocks %"PRIu64", packets %"PRIu64", bytes %"PRIu64", dropped %"PRIu64
+#define HHC02353 "%s device %1d:%04X group buffer pool: %d free of %d, %"PRIu64" allocated outside pool"
+//efine HHC02354 - HHC02359 (available)
 //efine HHC02360 - HHC02369 (available)
 #define HHC02370 "Automatic tracing started at instrcount %"PRIu64" (BEG+%"PRIu64")"
 #define HHC02371 "Automatic tracing stopped at instrcount %"PRIu64" (AMT+%"PRIu64")"
@@ -2163,7 +2169,60 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02804 "%1d:%04X File protect enabled"
 #define HHC02805 "%1d:%04X Volser = %s"
 #define HHC02806 "%1d:%04X Unlabeled tape"
-//efine HHC02806 - HHC02899 (available)
+//efine HHC02807 - HHC02809 (available)
+
+// hercnetgen
+#define HHC02810 "Usage: %s [options] { -l | -p ifname | path }\n" \
+       "HHC02810I   -l          loopback test of the socket backend (no privileges needed)\n" \
+       "HHC02810I   -p ifname   send and receive through the packet backend on ifname\n" \
+       "HHC02810I   path        serve a QETH 'backend socket path' connection\n" \
+       "HHC02810I options:\n" \
+       "HHC02810I   -n frames   number of frames to send (default 1000000)\n" \
+       "HHC02810I   -s size     frame size in bytes (default 1514)\n" \
+       "HHC02810I   -t secs     seconds to wait for stragglers after sending (default 1)\n" \
+       "HHC02810I   -e          echo received frames back instead of sending (path only)"
+#define HHC02811 "Waiting for a connection on %s"
+#define HHC02812 "%s: %s %"PRIu64" frames, %"PRIu64" bytes, %"PRIu64" dropped in %u.%03u secs"
+#define HHC02813 "%s: %"PRIu64" frames/s, %"PRIu64" Mbit/s"
+#define HHC02814 "%s: %"PRIu64" frames out of sequence, %"PRIu64" frames corrupted"
+
+// itrace, itrcprt
+#define HHC02815 "Binary instruction trace to %s started%s"
+#define HHC02816 "Binary instruction trace to %s ended: %"PRIu64" records, %"PRIu64" bytes, %"PRIu64" records lost"
+#define HHC02817 "Binary instruction trace is not active"
+#define HHC02818 "Binary instruction trace to %s: %"PRIu64" records, %"PRIu64" bytes, %"PRIu64" records lost"
+#define HHC02819 "Binary instruction trace is already active to %s"
+#define HHC02820 "Usage: %s [options] tracefile\n" \
+       "HHC02820I options:\n" \
+       "HHC02820I   -c cpu         only instructions executed by this CPU (hex)\n" \
+       "HHC02820I   -a addr[-addr] only instructions at these addresses (hex)\n" \
+       "HHC02820I   -o mnemonic    only this instruction\n" \
+       "HHC02820I   -n count       stop after this many instructions\n" \
+       "HHC02820I   -r             show all registers, not just those changed"
+#define HHC02821 "%s is not a binary instruction trace file"
+#define HHC02822 "%s: bad record at block offset %u"
+#define HHC02823 "%"PRIu64" instructions displayed, %"PRIu64" traced, %"PRIu64" lost"
+
+// profile
+#define HHC02824 "Profiler is %s: %"PRIu64" samples at %u/sec, %s waiting, %u addresses, %"PRIu64" dropped"
+#define HHC02825 "Profiler started: %u samples/sec per CPU, %u addresses"
+#define HHC02826 "Profiler rate %u/sec exceeds the timer interval rate; use 'timerint' to lower the interval"
+#define HHC02827 "Address map %s line %d is invalid"
+#define HHC02828 "Address map %s loaded: %d modules"
+#define HHC02829 "No address map is loaded"
+#define HHC02830 "Profile written to %s: %"PRIu64" lines"
+#define HHC02831 "Profiler has no samples"
+
+// emustat
+#define HHC02832 "Emulator statistics of %d CPUs appended to %s"
+#define HHC02833 "No emulator statistics snapshot; use 'emustat SNAP' first"
+
+// iolat
+#define HHC02834 "I/O latency in usecs by %s: count, then average/median/99th percentile of queue, exec and intr"
+#define HHC02835 "%-7s %-6s %10"PRIu64"  queue %s  exec %s  intr %s"
+#define HHC02836 "I/O latency statistics reset"
+#define HHC02837 "No I/O latency has been measured"
+//efine HHC02838 - HHC02899 (available)
 
 // range 029nn - 02949 console.c
 #define HHC02900 "%s COMM: Send() failed: %s"
@@ -2436,7 +2495,9 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC05085 "%1d:%04X CTCE: Invalid ATTNDELAY value %s ignored"
 #define HHC05086 "%1d:%04X CTCE: Recovery is about to issue Hercules command: %s %s"
 
-//efine HHC05087 - HHC05099 (available)
+#define HHC05087 "%1d:%04X CTCE: Using shared memory ring for %s data :%5d %s %1d:%04X"
+#define HHC05088 "%1d:%04X CTCE: Shared memory ring not used for %s data, using TCP: %s"
+//efine HHC05089 - HHC05099 (available)
 
 // range 05100 - 05199 available
 // range 05200 - 05299 available
@@ -190,80 +190,94 @@ extern int iprint_router_func( BYTE inst[], char mnemonic[], char* prtbuf );
 
 #if defined( OPTION_INSTRUCTION_COUNTING )
 
+/* Host clock used to time individual opcodes: the processor's
+   timestamp counter where we can read it cheaply, else host TOD  */
+#if defined( _GCC_SSE2_ ) || (defined( _MSVC_ ) && (defined( _M_IX86 ) || defined( _M_X64 )))
+  #define ICOUNT_CLOCK()        ((U64) __rdtsc())
+  #define ICOUNT_CLOCK_UNITS    "cycles"
+#else
+  #define ICOUNT_CLOCK()        ((U64) host_tod())
+  #define ICOUNT_CLOCK_UNITS    "TOD units"
+#endif
+
+/* Offset from a count slot to its matching time slot */
+#define ICOUNT_TIME_OFFSET  \
+    ((offsetof( ICOUNT_CPU, time ) - offsetof( ICOUNT_CPU, count )) / sizeof( U64 ))
+
+/* True if no CPU has counted the instruction in count slot i yet  */
+extern bool icount_first_use( size_t i );
+
+/* Point _slot at the _map counter for this instruction's opcode */
+#define ICOUNT_SLOT( _slot, _map, _inst )                           \
+    do                                                              \
+    {                                                               \
+        switch ((_inst)[0]) {                                       \
+        case 0x01: _slot = &(_map)->imap01[ (_inst)[1]        ]; break; \
+        case 0xA4: _slot = &(_map)->imapa4[ (_inst)[1]        ]; break; \
+        case 0xA5: _slot = &(_map)->imapa5[ (_inst)[1] & 0x0F ]; break; \
+        case 0xA6: _slot = &(_map)->imapa6[ (_inst)[1]        ]; break; \
+        case 0xA7: _slot = &(_map)->imapa7[ (_inst)[1] & 0x0F ]; break; \
+        case 0xB2: _slot = &(_map)->imapb2[ (_inst)[1]        ]; break; \
+        case 0xB3: _slot = &(_map)->imapb3[ (_inst)[1]        ]; break; \
+        case 0xB9: _slot = &(_map)->imapb9[ (_inst)[1]        ]; break; \
+        case 0xC0: _slot = &(_map)->imapc0[ (_inst)[1] & 0x0F ]; break; \
+        case 0xC2: _slot = &(_map)->imapc2[ (_inst)[1] & 0x0F ]; break; \
+        case 0xC4: _slot = &(_map)->imapc4[ (_inst)[1] & 0x0F ]; break; \
+        case 0xC6: _slot = &(_map)->imapc6[ (_inst)[1] & 0x0F ]; break; \
+        case 0xC8: _slot = &(_map)->imapc8[ (_inst)[1] & 0x0F ]; break; \
+        case 0xE3: _slot = &(_map)->imape3[ (_inst)[5]        ]; break; \
+        case 0xE4: _slot = &(_map)->imape4[ (_inst)[1]        ]; break; \
+        case 0xE5: _slot = &(_map)->imape5[ (_inst)[1]        ]; break; \
+        case 0xEB: _slot = &(_map)->imapeb[ (_inst)[5]        ]; break; \
+        case 0xEC: _slot = &(_map)->imapec[ (_inst)[5]        ]; break; \
+        case 0xED: _slot = &(_map)->imaped[ (_inst)[5]        ]; break; \
+        default:   _slot = &(_map)->imapxx[ (_inst)[0]        ]; break; \
+        }                                                           \
+    } while (0)
+
+/*-------------------------------------------------------------------*/
+/* Count an instruction in the executing CPU's own table. Only one   */
+/* in every 'icountrate' instructions is counted (and timed), with   */
+/* a weight of 'icountrate', so sampled totals remain comparable.    */
+/* An opcode's time runs until the CPU's next counted instruction.   */
+/*-------------------------------------------------------------------*/
 #define ICOUNT_INST( _inst, _regs )                                 \
     do                                                              \
     {                                                               \
-        if (sysblk.icount)                                          \
+        ICOUNT_CPU*  ic;                                            \
+        U64*         slot;                                          \
+                                                                    \
+        if (!sysblk.icount                                          \
+            || !(ic = sysblk.icountcpu[ (_regs)->cpuad ]))          \
+            break;                                                  \
+                                                                    \
+        if (ic->tslot)                                              \
+        {                                                           \
+            ic->tslot[ ICOUNT_TIME_OFFSET ] +=                      \
+                (ICOUNT_CLOCK() - ic->tstart) * sysblk.icountrate;  \
+            ic->tslot = NULL;                                       \
+        }                                                           \
+                                                                    \
+        if (ic->skip > 1)                                           \
+        {                                                           \
+            ic->skip--;                                             \
+            break;                                                  \
+        }                                                           \
+        ic->skip = sysblk.icountrate;                               \
+                                                                    \
+        ICOUNT_SLOT( slot, &ic->count, (_inst) );                   \
+        if (!*slot && icount_first_use( slot - (U64*) &ic->count )) \
         {                                                           \
-            int used;                                               \
-            switch ((_inst)[0]) {                                   \
-            case 0x01:                                              \
-                used = sysblk.imap01[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xA4:                                              \
-                used = sysblk.imapa4[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xA5:                                              \
-                used = sysblk.imapa5[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xA6:                                              \
-                used = sysblk.imapa6[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xA7:                                              \
-                used = sysblk.imapa7[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xB2:                                              \
-                used = sysblk.imapb2[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xB3:                                              \
-                used = sysblk.imapb3[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xB9:                                              \
-                used = sysblk.imapb9[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xC0:                                              \
-                used = sysblk.imapc0[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xC2:                                              \
-                used = sysblk.imapc2[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xC4:                                              \
-                used = sysblk.imapc4[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xC6:                                              \
-                used = sysblk.imapc6[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xC8:                                              \
-                used = sysblk.imapc8[(_inst)[1] & 0x0F]++;          \
-                break;                                              \
-            case 0xE3:                                              \
-                used = sysblk.imape3[(_inst)[5]]++;                 \
-                break;                                              \
-            case 0xE4:                                              \
-                used = sysblk.imape4[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xE5:                                              \
-                used = sysblk.imape5[(_inst)[1]]++;                 \
-                break;                                              \
-            case 0xEB:                                              \
-                used = sysblk.imapeb[(_inst)[5]]++;                 \
-                break;                                              \
-            case 0xEC:                                              \
-                used = sysblk.imapec[(_inst)[5]]++;                 \
-                break;                                              \
-            case 0xED:                                              \
-                used = sysblk.imaped[(_inst)[5]]++;                 \
-                break;                                              \
-            default:                                                \
-                used = sysblk.imapxx[(_inst)[0]]++;                 \
-            }                                                       \
+            /* "%s" */                                              \
+            WRMSG( HHC02292, "I", "First use" );                    \
+            ARCH_DEP( display_inst )( (_regs), (_inst) );           \
+        }                                                           \
+        *slot += sysblk.icountrate;                                 \
                                                                     \
-            if (!used)                                              \
-            {                                                       \
-                /* "%s" */                                          \
-                WRMSG( HHC02292, "I", "First use" );                \
-                ARCH_DEP( display_inst )( (_regs), (_inst) );       \
-            }                                                       \
+        if (sysblk.icounttime)                                      \
+        {                                                           \
+            ic->tslot  = slot;                                      \
+            ic->tstart = ICOUNT_CLOCK();                            \
         }                                                           \
     } while (0)
 
@@ -1370,6 +1384,22 @@ do {                                                                  \
 
 #endif /*!defined( FEATURE_BASIC_FP_EXTENSIONS )*/
 
+#undef ZVECTOR_CHECK
+
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+
+    /* Program check if vector instruction is executed when either the
+       AFP register control or the vector enablement control is zero */
+#define ZVECTOR_CHECK(_regs) \
+        if( (((_regs)->CR(0) & (CR0_AFP | CR0_VOP)) != (CR0_AFP | CR0_VOP)) \
+            || (SIE_MODE((_regs)) \
+                && ((HOST(_regs)->CR(0) & (CR0_AFP | CR0_VOP)) != (CR0_AFP | CR0_VOP))) ) { \
+            (_regs)->dxc = DXC_VECTOR_INSTRUCTION; \
+            (_regs)->program_interrupt( (_regs), PGM_DATA_EXCEPTION); \
+        }
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
 #define TLBIX(_addr) (((VADR_L)(_addr) >> TLB_PAGESHIFT) & TLB_MASK)
 
 #define MAINADDR(_main, _addr) \
@@ -2052,6 +2082,13 @@ void init_regs_runtime_opcode_pointers( REGS* regs );
 /* Functions in module hscmisc.c */
 void ARCH_DEP( display_inst )       ( REGS* regs, BYTE* inst );
 void ARCH_DEP( display_pgmint_inst )( REGS* regs, BYTE* inst );
+void ARCH_DEP( inst_operands )( REGS* regs, BYTE* inst,
+                                int* b1, VADR* addr1, int* ar1,
+                                int* b2, VADR* addr2, int* ar2 );
+
+
+/* Functions in module itrace.c */
+void ARCH_DEP( itrace_inst )( REGS* regs, BYTE* inst );
 
 
 /* Functions in module sie.c */
@@ -2788,6 +2825,148 @@ DEF_INST( cipher_message_with_output_feedback );
 DEF_INST( cipher_message_with_counter );
 #endif
 
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+DEF_INST( vector_load_element_8 );
+DEF_INST( vector_load_element_16 );
+DEF_INST( vector_load_element_64 );
+DEF_INST( vector_load_element_32 );
+DEF_INST( vector_load_logical_element_and_zero );
+DEF_INST( vector_load_and_replicate );
+DEF_INST( vector_load );
+DEF_INST( vector_load_to_block_boundary );
+DEF_INST( vector_store_element_8 );
+DEF_INST( vector_store_element_16 );
+DEF_INST( vector_store_element_64 );
+DEF_INST( vector_store_element_32 );
+DEF_INST( vector_store );
+DEF_INST( vector_gather_element_64 );
+DEF_INST( vector_gather_element_32 );
+DEF_INST( vector_scatter_element_64 );
+DEF_INST( vector_scatter_element_32 );
+DEF_INST( vector_load_gr_from_vr_element );
+DEF_INST( vector_load_vr_element_from_gr );
+DEF_INST( load_count_to_block_boundary );
+DEF_INST( vector_element_shift_left );
+DEF_INST( vector_element_rotate_left_logical );
+DEF_INST( vector_load_multiple );
+DEF_INST( vector_load_with_length );
+DEF_INST( vector_element_shift_right_logical );
+DEF_INST( vector_element_shift_right_arithmetic );
+DEF_INST( vector_store_multiple );
+DEF_INST( vector_store_with_length );
+DEF_INST( vector_load_element_immediate_8 );
+DEF_INST( vector_load_element_immediate_16 );
+DEF_INST( vector_load_element_immediate_64 );
+DEF_INST( vector_load_element_immediate_32 );
+DEF_INST( vector_generate_byte_mask );
+DEF_INST( vector_replicate_immediate );
+DEF_INST( vector_generate_mask );
+DEF_INST( vector_fp_test_data_class_immediate );
+DEF_INST( vector_replicate );
+DEF_INST( vector_population_count );
+DEF_INST( vector_count_trailing_zeros );
+DEF_INST( vector_count_leading_zeros );
+DEF_INST( vector_load_vector );
+DEF_INST( vector_isolate_string );
+DEF_INST( vector_sign_extend_to_doubleword );
+DEF_INST( vector_merge_low );
+DEF_INST( vector_merge_high );
+DEF_INST( vector_load_vr_from_grs_disjoint );
+DEF_INST( vector_sum_across_word );
+DEF_INST( vector_sum_across_doubleword );
+DEF_INST( vector_checksum );
+DEF_INST( vector_sum_across_quadword );
+DEF_INST( vector_and );
+DEF_INST( vector_and_with_complement );
+DEF_INST( vector_or );
+DEF_INST( vector_nor );
+DEF_INST( vector_exclusive_or );
+DEF_INST( vector_element_shift_left_vector );
+DEF_INST( vector_element_rotate_and_insert_under_mask );
+DEF_INST( vector_element_rotate_left_logical_vector );
+DEF_INST( vector_shift_left );
+DEF_INST( vector_shift_left_by_byte );
+DEF_INST( vector_shift_left_double_by_byte );
+DEF_INST( vector_element_shift_right_logical_vector );
+DEF_INST( vector_element_shift_right_arithmetic_vector );
+DEF_INST( vector_shift_right_logical );
+DEF_INST( vector_shift_right_logical_by_byte );
+DEF_INST( vector_shift_right_arithmetic );
+DEF_INST( vector_shift_right_arithmetic_by_byte );
+DEF_INST( vector_find_element_equal );
+DEF_INST( vector_find_element_not_equal );
+DEF_INST( vector_find_any_element_equal );
+DEF_INST( vector_permute_doubleword_immediate );
+DEF_INST( vector_string_range_compare );
+DEF_INST( vector_permute );
+DEF_INST( vector_select );
+DEF_INST( vector_fp_multiply_and_subtract );
+DEF_INST( vector_fp_multiply_and_add );
+DEF_INST( vector_pack );
+DEF_INST( vector_pack_logical_saturate );
+DEF_INST( vector_pack_saturate );
+DEF_INST( vector_multiply_logical_high );
+DEF_INST( vector_multiply_low );
+DEF_INST( vector_multiply_high );
+DEF_INST( vector_multiply_logical_even );
+DEF_INST( vector_multiply_logical_odd );
+DEF_INST( vector_multiply_even );
+DEF_INST( vector_multiply_odd );
+DEF_INST( vector_multiply_and_add_logical_high );
+DEF_INST( vector_multiply_and_add_low );
+DEF_INST( vector_multiply_and_add_high );
+DEF_INST( vector_multiply_and_add_logical_even );
+DEF_INST( vector_multiply_and_add_logical_odd );
+DEF_INST( vector_multiply_and_add_even );
+DEF_INST( vector_multiply_and_add_odd );
+DEF_INST( vector_galois_field_multiply_sum );
+DEF_INST( vector_add_with_carry_compute_carry );
+DEF_INST( vector_add_with_carry );
+DEF_INST( vector_galois_field_multiply_sum_and_accumulate );
+DEF_INST( vector_subtract_with_borrow_compute_borrow_indication );
+DEF_INST( vector_subtract_with_borrow_indication );
+DEF_INST( vector_fp_convert_to_logical_64 );
+DEF_INST( vector_fp_convert_from_logical_64 );
+DEF_INST( vector_fp_convert_to_fixed_64 );
+DEF_INST( vector_fp_convert_from_fixed_64 );
+DEF_INST( vector_fp_load_lengthened );
+DEF_INST( vector_fp_load_rounded );
+DEF_INST( vector_load_fp_integer );
+DEF_INST( vector_fp_compare_and_signal_scalar );
+DEF_INST( vector_fp_compare_scalar );
+DEF_INST( vector_fp_perform_sign_operation );
+DEF_INST( vector_fp_square_root );
+DEF_INST( vector_unpack_logical_low );
+DEF_INST( vector_unpack_logical_high );
+DEF_INST( vector_unpack_low );
+DEF_INST( vector_unpack_high );
+DEF_INST( vector_test_under_mask );
+DEF_INST( vector_element_compare_logical );
+DEF_INST( vector_element_compare );
+DEF_INST( vector_load_complement );
+DEF_INST( vector_load_positive );
+DEF_INST( vector_fp_subtract );
+DEF_INST( vector_fp_add );
+DEF_INST( vector_fp_divide );
+DEF_INST( vector_fp_multiply );
+DEF_INST( vector_fp_compare_equal );
+DEF_INST( vector_fp_compare_high_or_equal );
+DEF_INST( vector_fp_compare_high );
+DEF_INST( vector_average_logical );
+DEF_INST( vector_add_compute_carry );
+DEF_INST( vector_average );
+DEF_INST( vector_add );
+DEF_INST( vector_subtract_compute_borrow_indication );
+DEF_INST( vector_subtract );
+DEF_INST( vector_compare_equal );
+DEF_INST( vector_compare_high_logical );
+DEF_INST( vector_compare_high );
+DEF_INST( vector_minimum_logical );
+DEF_INST( vector_maximum_logical );
+DEF_INST( vector_minimum );
+DEF_INST( vector_maximum );
+#endif
+
 #if defined( FEATURE_145_INS_REF_BITS_MULT_FACILITY )
 DEF_INST( insert_reference_bits_multiple );
 #endif
@@ -3413,6 +3592,7 @@ DEF_INST( extract_and_set_storage_attributes );
 /*-------------------------------------------------------------------*/
 
 DEF_INST( execute_e3________xx );
+DEF_INST( execute_e7________xx );
 DEF_INST( execute_eb________xx );
 DEF_INST( execute_ec________xx );
 DEF_INST( execute_ed________xx );
@@ -0,0 +1,829 @@
+/* PROFILE.C    (C) Copyright Hercules development team, 2026        */
+/*              Guest sampling profiler                              */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* While the profiler is on ('profile ON' command) the timer thread  */
+/* samples every online CPU at a fixed rate, recording where its PSW */
+/* points, the primary ASN, whether it is in the problem state and   */
+/* whether it is running a SIE guest. Identical samples are counted  */
+/* in a hash table which the 'profile' command displays by address,  */
+/* by 4K page or by module (from a map file of address ranges), and  */
+/* can write as a collapsed stack file suitable for flame graphs.    */
+/*                                                                   */
+/* Sampling does not slow the CPUs at all: the timer thread reads    */
+/* the instruction address of a running CPU from its instruction     */
+/* fetch accelerator without synchronizing with it, and retries or   */
+/* falls back to the PSW should it see the CPU change pages.         */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _PROFILE_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+
+/*-------------------------------------------------------------------*/
+/* Samples                                                           */
+/*-------------------------------------------------------------------*/
+struct PROF_ENTRY
+{
+    U64     ia;                         /* Instruction address       */
+    U64     count;                      /* Times sampled (0 = free)  */
+    U16     asn;                        /* Primary ASN               */
+    BYTE    flags;                      /* PROF_xxx flags            */
+};
+typedef struct PROF_ENTRY PROF_ENTRY;
+
+#define PROF_SIE        0x01            /* SIE guest was running     */
+#define PROF_PROB       0x02            /* Problem state             */
+#define PROF_REAL       0x04            /* DAT was off               */
+
+/*-------------------------------------------------------------------*/
+/* Address map: named address ranges ("modules")                     */
+/*-------------------------------------------------------------------*/
+struct PROF_MOD
+{
+    U64     beg;                        /* First address             */
+    U64     end;                        /* Last address              */
+    char*   name;                       /* Module name               */
+    U64     count;                      /* Samples (for display)     */
+};
+typedef struct PROF_MOD PROF_MOD;
+
+#define PROF_DEFRATE    1000            /* Default samples/sec/CPU   */
+#define PROF_MAXRATE    100000          /* Maximum samples/sec/CPU   */
+#define PROF_DEFSIZE    65536           /* Default table entries     */
+#define PROF_DEFTOP     20              /* Default lines displayed   */
+#define PROF_PAGESIZE   4096            /* Page size for PAGES       */
+
+static LOCK        prof_lock;           /* Lock for all of below     */
+static bool        prof_inited;         /* prof_lock initialized     */
+static PROF_ENTRY* prof_tab;            /* Sample hash table         */
+static U32         prof_size;           /* Table entries (power of 2)*/
+static U32         prof_used;           /* Entries in use            */
+static U32         prof_rate;           /* Samples/second per CPU    */
+static U64         prof_next;           /* TOD of next sample        */
+static U64         prof_intv;           /* TOD units between samples */
+static U64         prof_samples;        /* Total samples             */
+static U64         prof_wait;           /* Samples of waiting CPUs   */
+static U64         prof_dropped;        /* Samples not fitting table */
+static U64         prof_cpu[ MAX_CPU_ENGS ]; /* Samples of each CPU  */
+static PROF_MOD*   prof_mods;           /* Address map, sorted       */
+static int         prof_nmods;          /* Entries in address map    */
+
+/*-------------------------------------------------------------------*/
+/* Hash table lookup: returns the entry for this sample, or NULL if  */
+/* the sample is new and the table is too full to hold it.           */
+/*-------------------------------------------------------------------*/
+static PROF_ENTRY* prof_find( U64 ia, U16 asn, BYTE flags )
+{
+    U64  h = (ia >> 1) ^ ((U64) asn << 40) ^ ((U64) flags << 56);
+    U32  i;
+
+    h *= 0x9E3779B97F4A7C15ULL;         /* (Fibonacci hashing)       */
+    i  = (U32)(h >> 32) & (prof_size - 1);
+
+    for (;; i = (i + 1) & (prof_size - 1))
+    {
+        PROF_ENTRY* e = &prof_tab[i];
+
+        if (!e->count)
+        {
+            /* Keep a quarter of the table free for fast lookups */
+            if (prof_used >= prof_size - prof_size / 4)
+                return NULL;
+            e->ia    = ia;
+            e->asn   = asn;
+            e->flags = flags;
+            prof_used++;
+            return e;
+        }
+        if (e->ia == ia && e->asn == asn && e->flags == flags)
+            return e;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Instruction address a running CPU is executing at                 */
+/*-------------------------------------------------------------------*/
+static U64 prof_ia( REGS* regs )
+{
+    BYTE*  aip;
+    BYTE*  ip;
+    U64    aiv;
+    U64    mask;
+    int    i;
+
+    if (regs->arch_mode == ARCH_900_IDX && regs->psw.amode64)
+        mask = ~0ULL;
+    else if (regs->arch_mode != ARCH_370_IDX && regs->psw.amode)
+        mask = 0x7FFFFFFF;
+    else
+        mask = 0x00FFFFFF;
+
+    /* Our reads can race the CPU moving to another page, so only
+       trust a consistent looking snapshot of 'ip' within the page,
+       and only while the instruction address is valid ('ip' is not
+       maintained once the AIA has been invalidated) */
+    for (i = 0; i < 3; i++)
+    {
+        if (!VALID_AIE( regs ))
+            break;
+
+        aip = regs->aip;
+        aiv = regs->AIV_G;
+        ip  = regs->ip;
+        HARDWARE_SYNC();
+
+        if (1
+            && VALID_AIE( regs )
+            && aip
+            && ip >= aip
+            && ip <  aip + PROF_PAGESIZE
+            && aip == regs->aip
+            && aiv == regs->AIV_G
+        )
+            return (aiv + (U64)(ip - aip)) & mask;
+    }
+
+    /* Otherwise the PSW address is right at least at every branch
+       (and whenever the instruction address is invalid) */
+    return regs->psw.IA_G & mask;
+}
+
+/*-------------------------------------------------------------------*/
+/* Sample all CPUs (called by timer thread every timer interval)     */
+/*-------------------------------------------------------------------*/
+void profile_sample( U64 now )
+{
+    REGS*        regs;
+    PROF_ENTRY*  e;
+    BYTE         flags;
+    U16          asn;
+    int          cpu;
+
+    if (now < prof_next)
+        return;
+
+    obtain_lock( &prof_lock );
+
+    if (!sysblk.profile)
+    {
+        release_lock( &prof_lock );
+        return;
+    }
+
+    /* Stay in step with the clock, but never try to catch up */
+    prof_next += prof_intv;
+    if (prof_next <= now)
+        prof_next = now + prof_intv;
+
+    for (cpu = 0; cpu < sysblk.hicpu; cpu++)
+    {
+        obtain_lock( &sysblk.cpulock[ cpu ]);
+        {
+            if (0
+                || !IS_CPU_ONLINE( cpu )
+                || (regs = sysblk.regs[ cpu ])->cpustate != CPUSTATE_STARTED
+            )
+            {
+                release_lock( &sysblk.cpulock[ cpu ]);
+                continue;
+            }
+
+            flags = 0;
+
+#if defined( _FEATURE_SIE )
+            if (regs->sie_active && regs->guestregs)
+            {
+                regs = regs->guestregs;
+                flags |= PROF_SIE;
+            }
+#endif
+            prof_samples++;
+            prof_cpu[ cpu ]++;
+
+            if (WAITSTATE( &regs->psw ))
+            {
+                prof_wait++;
+                release_lock( &sysblk.cpulock[ cpu ]);
+                continue;
+            }
+
+            if (PROBSTATE( &regs->psw ))
+                flags |= PROF_PROB;
+
+            /* (S/370 has no ASN) */
+            asn = regs->arch_mode == ARCH_370_IDX ? 0 : regs->CR_LHL(4);
+
+            /* (PSW bit 5 is DAT mode) */
+            if (!(regs->psw.sysmask & 0x04))
+                flags |= PROF_REAL;
+
+            if ((e = prof_find( prof_ia( regs ), asn, flags )))
+                e->count++;
+            else
+                prof_dropped++;
+        }
+        release_lock( &sysblk.cpulock[ cpu ]);
+    }
+
+    release_lock( &prof_lock );
+}
+
+/*-------------------------------------------------------------------*/
+/* Allocate a new sample table (caller holds prof_lock)              */
+/*-------------------------------------------------------------------*/
+static bool prof_reset( U32 size )
+{
+    PROF_ENTRY* tab;
+
+    if (!(tab = calloc( size, sizeof( PROF_ENTRY ))))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "calloc()", strerror( errno ));
+        return false;
+    }
+
+    free( prof_tab );
+    prof_tab     = tab;
+    prof_size    = size;
+    prof_used    = 0;
+    prof_samples = 0;
+    prof_wait    = 0;
+    prof_dropped = 0;
+    memset( prof_cpu, 0, sizeof( prof_cpu ));
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Module containing an address, or NULL                             */
+/*-------------------------------------------------------------------*/
+static PROF_MOD* prof_module( U64 ia )
+{
+    int lo = 0, hi = prof_nmods - 1, mid;
+
+    while (lo <= hi)
+    {
+        mid = (lo + hi) / 2;
+        if (ia < prof_mods[ mid ].beg)
+            hi = mid - 1;
+        else if (ia > prof_mods[ mid ].end)
+            lo = mid + 1;
+        else
+            return &prof_mods[ mid ];
+    }
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Address as module+offset if it is in a module                     */
+/*-------------------------------------------------------------------*/
+static char* prof_symbol( U64 ia, char* buf, size_t bufsz )
+{
+    PROF_MOD* m = prof_module( ia );
+
+    if (m)
+        snprintf( buf, bufsz, "%s+%"PRIX64, m->name, ia - m->beg );
+    else
+        buf[0] = 0;
+    return buf;
+}
+
+static void prof_free_map()
+{
+    int i;
+
+    for (i = 0; i < prof_nmods; i++)
+        free( prof_mods[i].name );
+    free( prof_mods );
+    prof_mods  = NULL;
+    prof_nmods = 0;
+}
+
+static int prof_mod_cmp( const void* a, const void* b )
+{
+    const PROF_MOD* ma = a;
+    const PROF_MOD* mb = b;
+    return ma->beg < mb->beg ? -1 : ma->beg > mb->beg ? 1 : 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Load an address map file. Each line is "start end name", with     */
+/* start and end (inclusive) in hex. Blank lines and lines starting  */
+/* with '#' or '*' are ignored.                                      */
+/*-------------------------------------------------------------------*/
+static int prof_load_map( const char* fname )
+{
+    char       line[ 512 ];
+    char       name[ 256 ];
+    char       pathname[ MAX_PATH ];
+    U64        beg, end;
+    PROF_MOD*  mods = NULL;
+    int        n = 0, max = 0, lineno = 0, i;
+    int        rc = 0;
+    FILE*      f;
+
+    hostpath( pathname, fname, sizeof( pathname ));
+
+    if (!(f = fopen( pathname, "r" )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fopen()", strerror( errno ));
+        return -1;
+    }
+
+    while (fgets( line, sizeof( line ), f ))
+    {
+        lineno++;
+
+        if (sscanf( line, " %255s", name ) != 1 || name[0] == '#' || name[0] == '*')
+            continue;
+
+        if (0
+            || sscanf( line, "%"SCNx64" %"SCNx64" %255s", &beg, &end, name ) != 3
+            || end < beg
+        )
+        {
+            // "Address map %s line %d is invalid"
+            WRMSG( HHC02827, "E", fname, lineno );
+            fclose( f );
+            for (i = 0; i < n; i++)
+                free( mods[i].name );
+            free( mods );
+            return -1;
+        }
+
+        if (n >= max)
+        {
+            PROF_MOD* p = realloc( mods, (max ? max * 2 : 256) * sizeof( PROF_MOD ));
+            if (!p)
+            {
+                // "Error in function %s: %s"
+                WRMSG( HHC00075, "E", "realloc()", strerror( errno ));
+                rc = -1;
+                break;
+            }
+            mods = p;
+            max  = max ? max * 2 : 256;
+        }
+        if (!(mods[n].name = strdup( name )))
+        {
+            // "Error in function %s: %s"
+            WRMSG( HHC00075, "E", "strdup()", strerror( errno ));
+            rc = -1;
+            break;
+        }
+        mods[n].beg   = beg;
+        mods[n].end   = end;
+        mods[n].count = 0;
+        n++;
+    }
+
+    if (!rc && ferror( f ))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fgets()", strerror( errno ));
+        rc = -1;
+    }
+    fclose( f );
+
+    /* The map is not loaded at all if it could not be loaded whole */
+    if (rc)
+    {
+        for (i = 0; i < n; i++)
+            free( mods[i].name );
+        free( mods );
+        return -1;
+    }
+
+    qsort( mods, n, sizeof( PROF_MOD ), prof_mod_cmp );
+
+    obtain_lock( &prof_lock );
+    {
+        prof_free_map();
+        prof_mods  = mods;
+        prof_nmods = n;
+    }
+    release_lock( &prof_lock );
+
+    // "Address map %s loaded: %d modules"
+    WRMSG( HHC02828, "I", fname, n );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Percent of all samples, formatted                                 */
+/*-------------------------------------------------------------------*/
+static char* prof_pct( U64 count, char* buf, size_t bufsz )
+{
+    U64 pct = prof_samples ? (count * 10000) / prof_samples : 0;
+    snprintf( buf, bufsz, "%3u.%02u%%", (unsigned)(pct / 100), (unsigned)(pct % 100) );
+    return buf;
+}
+
+static int prof_key_cmp( const void* a, const void* b )
+{
+    const PROF_ENTRY* ea = a;
+    const PROF_ENTRY* eb = b;
+    if (ea->ia    != eb->ia)    return ea->ia    < eb->ia    ? -1 : 1;
+    if (ea->asn   != eb->asn)   return ea->asn   < eb->asn   ? -1 : 1;
+    if (ea->flags != eb->flags) return ea->flags < eb->flags ? -1 : 1;
+    return 0;
+}
+
+static int prof_count_cmp( const void* a, const void* b )
+{
+    U64 ca = ((const PROF_ENTRY*) a)->count;
+    U64 cb = ((const PROF_ENTRY*) b)->count;
+    return ca > cb ? -1 : ca < cb ? 1 : 0;
+}
+
+static int prof_mod_count_cmp( const void* a, const void* b )
+{
+    U64 ca = ((const PROF_MOD*) a)->count;
+    U64 cb = ((const PROF_MOD*) b)->count;
+    return ca > cb ? -1 : ca < cb ? 1 : 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Copy of the samples, merged by page if 'pages' (caller holds lock)*/
+/*-------------------------------------------------------------------*/
+static PROF_ENTRY* prof_snapshot( bool pages, U32* pn )
+{
+    PROF_ENTRY*  snap;
+    PROF_ENTRY*  e;
+    U32          i, n = 0;
+
+    if (!(snap = malloc( (prof_used + 1) * sizeof( PROF_ENTRY ))))
+        return NULL;
+
+    for (i = 0; i < prof_size; i++)
+    {
+        if (!prof_tab[i].count)
+            continue;
+        snap[n] = prof_tab[i];
+        if (pages)
+            snap[n].ia &= ~(U64)(PROF_PAGESIZE - 1);
+        n++;
+    }
+
+    if (pages && n)
+    {
+        U32 j;
+
+        /* Merge entries of the same page, ASN and flags */
+        qsort( snap, n, sizeof( PROF_ENTRY ), prof_key_cmp );
+        for (i = 1, j = 0; i < n; i++)
+        {
+            e = &snap[j];
+            if (snap[i].ia == e->ia && snap[i].asn == e->asn && snap[i].flags == e->flags)
+                e->count += snap[i].count;
+            else
+                snap[ ++j ] = snap[i];
+        }
+        n = j + 1;
+    }
+
+    qsort( snap, n, sizeof( PROF_ENTRY ), prof_count_cmp );
+    *pn = n;
+    return snap;
+}
+
+/*-------------------------------------------------------------------*/
+/* Display the busiest addresses or pages                            */
+/*-------------------------------------------------------------------*/
+static void prof_display_top( int top, bool pages )
+{
+    PROF_ENTRY*  snap;
+    U32          n, i;
+    char         buf[ 256 ];
+    char         pct[ 16 ];
+    char         sym[ 128 ];
+
+    if (!(snap = prof_snapshot( pages, &n )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "malloc()", strerror( errno ));
+        return;
+    }
+
+    MSGBUF( buf, "%4s %12s %8s %-16s %4s %-4s %s", "Rank", "Samples", "Percent",
+        pages ? "Page" : "Address", "ASN", "Mode", pages ? "" : "Module" );
+    WRMSG( HHC02292, "I", buf );
+
+    for (i = 0; i < n && (int) i < top; i++)
+    {
+        MSGBUF( buf, "%4u %12"PRIu64" %8s %16.16"PRIX64" %4.4X %c%c%c  %s",
+            i + 1, snap[i].count, prof_pct( snap[i].count, pct, sizeof( pct )),
+            snap[i].ia, snap[i].asn,
+            snap[i].flags & PROF_PROB ? 'P' : 'S',
+            snap[i].flags & PROF_REAL ? 'R' : 'V',
+            snap[i].flags & PROF_SIE  ? 'G' : ' ',
+            pages ? "" : prof_symbol( snap[i].ia, sym, sizeof( sym )));
+        WRMSG( HHC02292, "I", buf );
+    }
+    free( snap );
+}
+
+/*-------------------------------------------------------------------*/
+/* Display the busiest modules                                       */
+/*-------------------------------------------------------------------*/
+static void prof_display_modules( int top )
+{
+    PROF_MOD*  mods;
+    PROF_MOD*  m;
+    U64        other = 0;
+    U32        i;
+    int        n;
+    char       buf[ 256 ];
+    char       pct[ 16 ];
+
+    if (!prof_nmods)
+    {
+        // "No address map is loaded"
+        WRMSG( HHC02829, "E" );
+        return;
+    }
+
+    for (n = 0; n < prof_nmods; n++)
+        prof_mods[n].count = 0;
+
+    for (i = 0; i < prof_size; i++)
+    {
+        if (!prof_tab[i].count)
+            continue;
+        if ((m = prof_module( prof_tab[i].ia )))
+            m->count += prof_tab[i].count;
+        else
+            other += prof_tab[i].count;
+    }
+
+    if (!(mods = malloc( prof_nmods * sizeof( PROF_MOD ))))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "malloc()", strerror( errno ));
+        return;
+    }
+    memcpy( mods, prof_mods, prof_nmods * sizeof( PROF_MOD ));
+    qsort( mods, prof_nmods, sizeof( PROF_MOD ), prof_mod_count_cmp );
+
+    MSGBUF( buf, "%4s %12s %8s %-16s %-16s %s", "Rank", "Samples", "Percent",
+        "Start", "End", "Module" );
+    WRMSG( HHC02292, "I", buf );
+
+    for (n = 0; n < prof_nmods && n < top && mods[n].count; n++)
+    {
+        MSGBUF( buf, "%4d %12"PRIu64" %8s %16.16"PRIX64" %16.16"PRIX64" %s",
+            n + 1, mods[n].count, prof_pct( mods[n].count, pct, sizeof( pct )),
+            mods[n].beg, mods[n].end, mods[n].name );
+        WRMSG( HHC02292, "I", buf );
+    }
+
+    MSGBUF( buf, "%4s %12"PRIu64" %8s %s", "", other,
+        prof_pct( other, pct, sizeof( pct )), "(not in any module)" );
+    WRMSG( HHC02292, "I", buf );
+
+    free( mods );
+}
+
+/*-------------------------------------------------------------------*/
+/* Write the samples as a collapsed stack file: one line per sample  */
+/* of "host-or-guest;ASN;state;module;address count", which tools    */
+/* such as flamegraph.pl read directly.                              */
+/*-------------------------------------------------------------------*/
+static int prof_write( const char* fname )
+{
+    char    pathname[ MAX_PATH ];
+    FILE*   f;
+    U32     i;
+    U64     lines = 0;
+    char    sym[ 128 ];
+
+    hostpath( pathname, fname, sizeof( pathname ));
+
+    if (!(f = fopen( pathname, "w" )))
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fopen()", strerror( errno ));
+        return -1;
+    }
+
+    for (i = 0; i < prof_size; i++)
+    {
+        PROF_ENTRY* e = &prof_tab[i];
+        PROF_MOD*   m;
+
+        if (!e->count)
+            continue;
+
+        m = prof_module( e->ia );
+        if (m)
+            prof_symbol( e->ia, sym, sizeof( sym ));
+        else
+            snprintf( sym, sizeof( sym ), "%"PRIX64, e->ia );
+
+        fprintf( f, "%s;ASN_%4.4X;%s;%s;%s %"PRIu64"\n",
+            e->flags & PROF_SIE  ? "guest"   : "host",
+            e->asn,
+            e->flags & PROF_PROB ? "problem" : "supervisor",
+            m ? m->name : "unknown",
+            sym, e->count );
+        lines++;
+    }
+
+    if (prof_wait)
+    {
+        fprintf( f, "wait %"PRIu64"\n", prof_wait );
+        lines++;
+    }
+
+    if (fclose( f ) != 0)
+    {
+        // "Error in function %s: %s"
+        WRMSG( HHC00075, "E", "fclose()", strerror( errno ));
+        return -1;
+    }
+
+    // "Profile written to %s: %"PRIu64" lines"
+    WRMSG( HHC02830, "I", fname, lines );
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* profile command - guest sampling profiler                         */
+/*-------------------------------------------------------------------*/
+int profile_cmd( int argc, char* argv[], char* cmdline )
+{
+    U32   rate = PROF_DEFRATE;
+    U32   size = PROF_DEFSIZE;
+    int   top  = PROF_DEFTOP;
+    int   rc   = 0;
+    int   i;
+    char  c;
+    char  pct[ 16 ];
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (!prof_inited)
+    {
+        initialize_lock( &prof_lock );
+        prof_inited = true;
+    }
+
+    /* Display status */
+    if (argc < 2)
+    {
+        obtain_lock( &prof_lock );
+        {
+            // "Profiler is %s: %"PRIu64" samples at %u/sec, %s waiting, %u addresses, %"PRIu64" dropped"
+            WRMSG( HHC02824, "I", sysblk.profile ? "on" : "off",
+                prof_samples, prof_rate, prof_pct( prof_wait, pct, sizeof( pct )),
+                prof_used, prof_dropped );
+        }
+        release_lock( &prof_lock );
+        return 0;
+    }
+
+    /* Start sampling */
+    if (CMD( argv[1], ON, 2 ))
+    {
+        for (i = 2; i < argc; i++)
+        {
+            if (1
+                && strncasecmp( argv[i], "RATE=", 5 ) == 0
+                && sscanf( argv[i] + 5, "%u%c", &rate, &c ) == 1
+                && rate >= 1 && rate <= PROF_MAXRATE
+            )
+                continue;
+            if (1
+                && strncasecmp( argv[i], "SIZE=", 5 ) == 0
+                && sscanf( argv[i] + 5, "%u%c", &size, &c ) == 1
+                && size >= 1024 && size <= (1 << 24)
+            )
+            {
+                /* (round up to a power of 2) */
+                U32 n = 1024;
+                while (n < size)
+                    n <<= 1;
+                size = n;
+                continue;
+            }
+            // "Invalid argument %s%s"
+            WRMSG( HHC02205, "E", argv[i], "" );
+            return -1;
+        }
+
+        obtain_lock( &prof_lock );
+        {
+            if (prof_reset( size ))
+            {
+                prof_rate = rate;
+                prof_intv = ETOD_SEC / rate;
+                prof_next = 0;
+                sysblk.profile = true;
+
+                // "Profiler started: %u samples/sec per CPU, %u addresses"
+                WRMSG( HHC02825, "I", rate, size - size / 4 );
+
+                if (sysblk.timerint * (U64) rate > 1000000)
+                    // "Profiler rate %u/sec exceeds the timer interval rate; use 'timerint' to lower the interval"
+                    WRMSG( HHC02826, "W", rate );
+            }
+            else
+                rc = -1;
+        }
+        release_lock( &prof_lock );
+        return rc;
+    }
+
+    /* Stop sampling, keeping the samples */
+    if (CMD( argv[1], OFF, 3 ))
+    {
+        obtain_lock( &prof_lock );
+        sysblk.profile = false;
+        release_lock( &prof_lock );
+
+        // "%-14s set to %s"
+        WRMSG( HHC02204, "I", "profile", "off" );
+        return 0;
+    }
+
+    /* Discard the samples */
+    if (CMD( argv[1], CLEAR, 5 ))
+    {
+        obtain_lock( &prof_lock );
+        if (prof_tab)
+            rc = prof_reset( prof_size ) ? 0 : -1;
+        release_lock( &prof_lock );
+        return rc;
+    }
+
+    /* Load an address map */
+    if (CMD( argv[1], MAP, 3 ))
+    {
+        if (argc != 3)
+        {
+            // "Invalid argument(s). Type 'help %s' for assistance."
+            WRMSG( HHC02211, "E", argv[0] );
+            return -1;
+        }
+        return prof_load_map( argv[2] );
+    }
+
+    /* Everything else needs samples */
+    if (!prof_tab)
+    {
+        // "Profiler has no samples"
+        WRMSG( HHC02831, "E" );
+        return -1;
+    }
+
+    /* Write collapsed stack file */
+    if (CMD( argv[1], WRITE, 5 ))
+    {
+        if (argc != 3)
+        {
+            // "Invalid argument(s). Type 'help %s' for assistance."
+            WRMSG( HHC02211, "E", argv[0] );
+            return -1;
+        }
+        obtain_lock( &prof_lock );
+        rc = prof_write( argv[2] );
+        release_lock( &prof_lock );
+        return rc;
+    }
+
+    /* Display */
+    if (0
+        || argc > 3
+        || (argc == 3 && (sscanf( argv[2], "%d%c", &top, &c ) != 1 || top < 1))
+    )
+    {
+        // "Invalid argument(s). Type 'help %s' for assistance."
+        WRMSG( HHC02211, "E", argv[0] );
+        return -1;
+    }
+
+    obtain_lock( &prof_lock );
+    {
+        if      (CMD( argv[1], TOP,     3 )) prof_display_top( top, false );
+        else if (CMD( argv[1], PAGES,   4 )) prof_display_top( top, true  );
+        else if (CMD( argv[1], MODULES, 3 )) prof_display_modules( top );
+        else
+        {
+            // "Invalid argument %s%s"
+            WRMSG( HHC02205, "E", argv[1], "" );
+            rc = -1;
+        }
+    }
+    release_lock( &prof_lock );
+    return rc;
+}
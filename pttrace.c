@@ -27,11 +27,51 @@ struct PTT_TRACE
     const void*     data1;              /* Data 1                    */
     const void*     data2;              /* Data 2                    */
     const char*     loc;                /* File name:line number     */
-    struct timeval  tv;                 /* Time of day               */
+    U64             stamp;              /* PTT_CLOCK() when traced   */
     S64             rc;                 /* Return code               */
 };
 typedef struct PTT_TRACE PTT_TRACE;
 
+/*-------------------------------------------------------------------*/
+/* Per-thread trace table                                            */
+/*-------------------------------------------------------------------*/
+/* Each thread traces into its own ring which only it ever updates,  */
+/* so no lock is needed to trace an event. Rings are chained on a    */
+/* list that is only ever added to; a thread's ring is released for  */
+/* reuse by some later thread when the thread exits. 'ptt' merges    */
+/* all of the rings by timestamp when it displays them.              */
+/*-------------------------------------------------------------------*/
+struct PTT_RING
+{
+    struct PTT_RING* next;              /* Next ring on list         */
+    PTT_TRACE*      tab;                /* Trace table entries       */
+    int             n;                  /* Number of table entries   */
+    int             x;                  /* Index of next entry       */
+    U32             gen;                /* pttgen when tab allocated */
+    bool            inuse;              /* Owned by a running thread */
+    bool            wrapped;            /* Table has wrapped         */
+};
+typedef struct PTT_RING PTT_RING;
+
+/*-------------------------------------------------------------------*/
+/* Trace clock: the processor's timestamp counter where it can be    */
+/* read cheaply, otherwise the host TOD clock. Either is converted   */
+/* to time of day only when the table is printed.                    */
+/*-------------------------------------------------------------------*/
+#if defined( _GCC_SSE2_ ) || (defined( _MSVC_ ) && (defined( _M_IX86 ) || defined( _M_X64 )))
+  #define PTT_CLOCK()       ((U64) __rdtsc())
+#else
+  #define PTT_CLOCK()       ((U64) host_tod())
+#endif
+
+#define PTT_USECS( _tv )  ((S64)(_tv)->tv_sec * 1000000 + (_tv)->tv_usec)
+
+#if defined( _MSVC_ )
+  #define PTT_TLS           __declspec( thread )
+#else
+  #define PTT_TLS           __thread
+#endif
+
 /*-------------------------------------------------------------------*/
 /* Trace classes table                                               */
 /*-------------------------------------------------------------------*/
@@ -47,12 +87,16 @@ typedef struct PTTCL PTTCL;
 /*-------------------------------------------------------------------*/
 /* Global variables                                                  */
 /*-------------------------------------------------------------------*/
-HLOCK      pttlock;                     /* Pthreads trace lock       */
+HLOCK      pttlock;                     /* Protects list of rings    */
 DLL_EXPORT U64 pttclass  = 0;           /* Pthreads trace class      */
-int        pttracen      = 0;           /* Number of table entries   */
-int        pttracex      = 0;           /* Index of current entry    */
-PTT_TRACE *pttrace       = NULL;        /* Pointer to current entry  */
-int        pttnolock     = 0;           /* 1=no table locking        */
+int        pttracen      = 0;           /* Entries in each table     */
+U32        pttgen        = 0;           /* Table size generation     */
+PTT_RING  *pttrings      = NULL;        /* List of per-thread rings  */
+static PTT_TLS PTT_RING *pttmyring;     /* This thread's own ring    */
+U64        pttbasestamp  = 0;           /* PTT_CLOCK() at pttbasetv  */
+TIMEVAL    pttbasetv;                   /* Time of day of basestamp  */
+int        pttnolock     = 0;           /* (obsolete; tracing itself */
+                                        /*  never locks any longer)  */
 int        pttnotod      = 0;           /* 1=don't call gettimeofday */
 int        pttnowrap     = 0;           /* 1=don't wrap              */
 bool       pttdtax       = false;       /* true=dump table at exit   */
@@ -100,21 +144,8 @@ PTTCL      pttcltab[] =                 /* trace class names table   */
 /*-------------------------------------------------------------------*/
 #define PTT_TRACE_SIZE          sizeof(PTT_TRACE)
 
-#define OBTAIN_PTTLOCK                                               \
-  do if (!pttnolock) {                                               \
-    int rc = hthread_mutex_lock( &pttlock );                         \
-    if (rc)                                                          \
-      BREAK_INTO_DEBUGGER();                                         \
-  }                                                                  \
-  while (0)
-
-#define RELEASE_PTTLOCK                                              \
-  do if (!pttnolock) {                                               \
-    int rc = hthread_mutex_unlock( &pttlock );                       \
-    if (rc)                                                          \
-      BREAK_INTO_DEBUGGER();                                         \
-  }                                                                  \
-  while (0)
+#define OBTAIN_PTTLOCK      hthread_mutex_lock(   &pttlock )
+#define RELEASE_PTTLOCK     hthread_mutex_unlock( &pttlock )
 
 /*-------------------------------------------------------------------*/
 /* Trace classes table lookup and helper functions                   */
@@ -336,28 +367,7 @@ DLL_EXPORT int ptt_cmd( int argc, char* argv[], char* cmdline )
             }
             else if (argc == 1 && sscanf(argv[0], "%d%c", &n, &c) == 1 && n >= 0)
             {
-                OBTAIN_PTTLOCK;
-                if (pttracen == 0)
-                {
-                    if (pttrace != NULL)
-                    {
-                        RELEASE_PTTLOCK;
-                        // "Pttrace: trace is busy"
-                        WRMSG(HHC90010, "E");
-                        return -1;
-                    }
-                }
-                else if (pttrace)
-                {
-                    pttracen = 0;
-                    RELEASE_PTTLOCK;
-                    usleep(1000);
-                    OBTAIN_PTTLOCK;
-                    free (pttrace);
-                    pttrace = NULL;
-                }
                 ptt_trace_init( n, FALSE );
-                RELEASE_PTTLOCK;
             }
             else
             {
@@ -412,13 +422,7 @@ DLL_EXPORT int ptt_cmd( int argc, char* argv[], char* cmdline )
 /*-------------------------------------------------------------------*/
 DLL_EXPORT void ptt_trace_init( int nTableSize, BOOL init )
 {
-    if (nTableSize > 0)
-        pttrace = calloc( nTableSize, PTT_TRACE_SIZE );
-    else
-        pttrace = NULL;
-
-    pttracen = pttrace ? nTableSize : 0;
-    pttracex = 0;
+    PTT_RING* ring;
 
     if (init)       /* First time? */
     {
@@ -442,156 +446,327 @@ DLL_EXPORT void ptt_trace_init( int nTableSize, BOOL init )
         pttto     = 0;
         ptttotid  = 0;
     }
+    else
+    {
+        /* Stop tracing and give any thread that was in the middle
+           of tracing an event the chance to finish doing so. */
+        OBTAIN_PTTLOCK;
+        pttracen = 0;
+        RELEASE_PTTLOCK;
+        usleep( 1000 );
+    }
+
+    /* Each thread allocates its own new table of the new size the
+       next time it traces an event (see ptt_ring_table). */
+    OBTAIN_PTTLOCK;
+    {
+        /* Free the tables of rings no thread owns any longer */
+        for (ring = pttrings; ring; ring = ring->next)
+        {
+            if (!ring->inuse)
+            {
+                free( ring->tab );
+                ring->tab = NULL;
+                ring->n   = 0;
+            }
+        }
+        pttgen++;
+        pttbasestamp = PTT_CLOCK();
+        gettimeofday( &pttbasetv, NULL );
+        pttracen = nTableSize > 0 ? nTableSize : 0;
+    }
+    RELEASE_PTTLOCK;
+}
+
+/*-------------------------------------------------------------------*/
+/* Obtain a ring for the current thread, reusing a released one      */
+/*-------------------------------------------------------------------*/
+static PTT_RING* ptt_ring_claim()
+{
+    PTT_RING* ring;
+
+    OBTAIN_PTTLOCK;
+    {
+        for (ring = pttrings; ring; ring = ring->next)
+            if (!ring->inuse)
+                break;
+
+        if (!ring && (ring = calloc( 1, sizeof( PTT_RING ))))
+        {
+            ring->next = pttrings;
+            pttrings   = ring;
+        }
+        if (ring)
+            ring->inuse = true;
+    }
+    RELEASE_PTTLOCK;
+
+    return pttmyring = ring;
+}
+
+/*-------------------------------------------------------------------*/
+/* (Re)allocate a ring's table whenever the table size changes       */
+/*-------------------------------------------------------------------*/
+static bool ptt_ring_table( PTT_RING* ring, int n )
+{
+    PTT_TRACE* tab = calloc( n, PTT_TRACE_SIZE );
+
+    if (!tab)
+        return false;
+
+    OBTAIN_PTTLOCK;
+    {
+        free( ring->tab );
+        ring->tab     = tab;
+        ring->n       = n;
+        ring->x       = 0;
+        ring->wrapped = false;
+        ring->gen     = pttgen;
+    }
+    RELEASE_PTTLOCK;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Release the current thread's ring when the thread exits. Its      */
+/* entries are kept (and printed) until another thread reuses it.    */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT void ptt_thread_exit()
+{
+    if (pttmyring)
+    {
+        OBTAIN_PTTLOCK;
+        pttmyring->inuse = false;
+        RELEASE_PTTLOCK;
+        pttmyring = NULL;
+    }
 }
 
 /*-------------------------------------------------------------------*/
 /* Primary PTT tracing function to fill in a PTT_TRACE table entry.  */
+/* The entry goes into the calling thread's own table, so this needs */
+/* no lock except the very first time a thread traces an event (or   */
+/* the first time after the table size is changed).                  */
 /*-------------------------------------------------------------------*/
 DLL_EXPORT void ptt_pthread_trace (U64 trclass, const char *msg,
                                    const void *data1, const void *data2,
                                    const char *loc, S64 rc, TIMEVAL* pTV)
 {
-int i, n;
-
-    if (pttrace == NULL || pttracen == 0 || !(pttclass & trclass)) return;
-    /*
-     * Messages from timer.c, clock.c and/or logger.c are not usually
-     * that interesting and take up table space.  Check the flags to
-     * see if we want to trace them.
-     */
-    loc = TRIMLOC( loc );
-    if (!(pttclass & PTT_CL_TMR) && !strncasecmp( loc, "timer.c:",  8)) return;
-    if (!(pttclass & PTT_CL_TMR) && !strncasecmp( loc, "clock.c:",  8)) return;
-    if (!(pttclass & PTT_CL_LOG) && !strncasecmp( loc, "logger.c:", 9)) return;
-    if (!(pttclass & PTT_CL_LOG) && !strncasecmp( loc, "logmsg.c:", 9)) return;
+PTT_RING*  ring;
+PTT_TRACE* p;
+int        n;
+
+    /* The caller's time of day, if any, is superseded by the much
+       cheaper trace clock, read just a few instructions later */
+    UNREFERENCED( pTV );
+
+    if ((n = pttracen) == 0 || !(pttclass & trclass)) return;
+
+    if (!(ring = pttmyring) && !(ring = ptt_ring_claim()))
+        return;
+
+    if (ring->gen != pttgen || !ring->tab)
+        if (!ptt_ring_table( ring, n ))
+            return;
 
     /* Check for 'nowrap' */
-    if (pttnowrap && pttracex + 1 >= pttracen) return;
+    if (pttnowrap && ring->wrapped) return;
 
     /* Consume another trace table entry */
-    OBTAIN_PTTLOCK;
-    if (pttrace == NULL || (n = pttracen) == 0)
+    p = &ring->tab[ ring->x ];
+    if (++ring->x >= ring->n)
     {
-        RELEASE_PTTLOCK;
-        return;
+        ring->x = 0;
+        ring->wrapped = true;
     }
-    i = pttracex++;
-    if (pttracex >= n)
-        pttracex = 0;
-    RELEASE_PTTLOCK;
 
-    /* Fill in the trace table entry */
-    if (pttnotod == 0)
-    {
-        if (pTV)
-            memcpy( &pttrace[i].tv, pTV, sizeof( TIMEVAL ));
-        else
-            gettimeofday( &pttrace[i].tv, NULL );
-    }
-    pttrace[i].tid     = thread_id();
-    pttrace[i].trclass = trclass;
-    pttrace[i].msg     = msg;
-    pttrace[i].data1   = data1;
-    pttrace[i].data2   = data2;
-    pttrace[i].loc     = loc;
-    pttrace[i].rc      = rc;
+    /* Fill in the trace table entry. Note the location is trimmed
+       and filtered only when the table is printed, not here. */
+    p->stamp   = pttnotod ? 0 : PTT_CLOCK();
+    p->tid     = thread_id();
+    p->trclass = trclass;
+    p->msg     = msg;
+    p->data1   = data1;
+    p->data2   = data2;
+    p->loc     = loc;
+    p->rc      = rc;
 }
 
 /*-------------------------------------------------------------------*/
-/* Function to print all PTT_TRACE table entries.                    */
+/* Helpers used to merge and print every thread's trace table        */
+/*-------------------------------------------------------------------*/
+static int ptt_cmp_stamp( const void* a, const void* b )
+{
+    const PTT_TRACE* p1 = *(const PTT_TRACE**) a;
+    const PTT_TRACE* p2 = *(const PTT_TRACE**) b;
+    return p1->stamp < p2->stamp ? -1 : p1->stamp > p2->stamp ? 1 : 0;
+}
+
+static bool ptt_filtered( const PTT_TRACE* p, const char* loc )
+{
+    /* Messages from timer.c, clock.c and/or logger.c are not usually
+       that interesting.  Check the flags to see if we want to see them.
+    */
+    if (!(pttclass & PTT_CL_TMR) && !strncasecmp( loc, "timer.c:",  8)) return true;
+    if (!(pttclass & PTT_CL_TMR) && !strncasecmp( loc, "clock.c:",  8)) return true;
+    if (!(pttclass & PTT_CL_LOG) && !strncasecmp( loc, "logger.c:", 9)) return true;
+    if (!(pttclass & PTT_CL_LOG) && !strncasecmp( loc, "logmsg.c:", 9)) return true;
+    UNREFERENCED( p );
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/* Function to print all PTT_TRACE table entries of all threads,     */
+/* merged into timestamp order.                                      */
 /* Return code is the  #of table entries printed.                    */
 /*-------------------------------------------------------------------*/
 DLL_EXPORT int ptt_pthread_print ()
 {
-int   i, n, count = 0;
-char  retcode[32]; // (retcode is 'int'; if x64, 19 digits or more!)
-char  tod[27];     // "YYYY-MM-DD HH:MM:SS.uuuuuu"
+int         i, n, count = 0, total = 0;
+char        retcode[32]; // (retcode is 'int'; if x64, 19 digits or more!)
+char        tod[27];     // "YYYY-MM-DD HH:MM:SS.uuuuuu"
+PTT_RING*   ring;
+PTT_TRACE** sorted;
+TIMEVAL     nowtv, tv;
+U64         nowstamp;
+double      perusec;     // PTT_CLOCK() ticks per microsecond
+S64         usecs;
+
+    if (!(n = pttracen))
+        return 0;
+
+    /* Temporarily disable tracing by indicating an empty table and
+       give any thread in the middle of tracing time to finish it */
+    OBTAIN_PTTLOCK;
+    pttracen = 0;
+    RELEASE_PTTLOCK;
+    usleep( 1000 );
 
-    if (pttrace && pttracen)
+    /* Calibrate the trace clock against the time of day */
+    for (;;)
+    {
+        nowstamp = PTT_CLOCK();
+        gettimeofday( &nowtv, NULL );
+        usecs = PTT_USECS( &nowtv ) - PTT_USECS( &pttbasetv );
+        if (usecs >= 10000)
+            break;
+        usleep( 10000 );
+    }
+    perusec = (double)(nowstamp - pttbasestamp) / (double) usecs;
+
+    /* Gather all current entries of every thread's table... */
+    OBTAIN_PTTLOCK;
+    for (ring = pttrings; ring; ring = ring->next)
+        if (ring->tab && ring->gen == pttgen)
+            total += ring->wrapped ? ring->n : ring->x;
+
+    if (!total || !(sorted = malloc( total * sizeof( PTT_TRACE* ))))
     {
-        /* Temporarily disable tracing by indicating an empty table */
-        OBTAIN_PTTLOCK;
-        n = pttracen;       /* save number of trace table entries   */
-        pttracen = 0;       /* indicate empty table to stop tracing */
         RELEASE_PTTLOCK;
+        pttracen = n;
+        return 0;
+    }
 
-        /* Print the trace table */
-        i = pttracex;
-        do
+    total = 0;
+    for (ring = pttrings; ring; ring = ring->next)
+    {
+        if (ring->tab && ring->gen == pttgen)
         {
-            if (pttrace[i].tid)
-            {
-                char threadname[16];
-                char lockname[32];
-                const char* lname;
-
-                FormatTIMEVAL( &pttrace[i].tv, tod, sizeof( tod ));
-                get_thread_name( pttrace[i].tid, threadname );
-
-                if (pttrace[i].trclass & PTT_CL_THR)
-                {
-                    /* For the thread class, an 'rc' of PTT_MAGIC
-                       indicates its value is uninteresting to us,
-                       so we don't bother showing it. Otherwise we
-                       format it as a +/- decimal value.
-                    */
-                    if (pttrace[i].rc == PTT_MAGIC)
-                        retcode[0] = 0;
-                    else
-                        MSGBUF( retcode, "%"PRId64, pttrace[i].rc );
-                }
-                else
-                {
-                    /* Not thread class: format return code
-                       as just another 64-bit hex value.
-                    */
-                    MSGBUF( retcode, "%16.16"PRIx64, pttrace[i].rc );
-                }
-
-                /* If this is the thread class we know the data1 value
-                   is USUALLY the address of the lock identifying which
-                   lock was being obtained/released, so as a courtesy
-                   we display its name after the message.  This might
-                   not always work as the data1 value for SOME thread
-                   trace entries might be NULL or be some other value.
-                */
-                lname = (pttrace[i].trclass & PTT_CL_THR) ?
-                    get_lock_name( (LOCK*) pttrace[i].data1 ) : "";
-
-                MSGBUF( lockname, "%s%s", lname[0] ? " " : "", lname );
-
-                if (lockname[0] && !retcode[0])
-                    retcode[0] = ' ', retcode[1] = 0;
-
-                // "%s "TIDPAT" %-15.15s %-18.18s %-18.18s"PTR_FMTx" "PTR_FMTx" %s%s"
-                WRMSG( HHC90021, "I"
-                    , &tod[11]                          // Time of day (HH:MM:SS.usecs)
-                    , TID_CAST( pttrace[i].tid )        // Thread id
-                    , threadname                        // Thread name
-                    , pttrace[i].loc                    // File name (string; 18 chars)
-                    , pttrace[i].msg                    // Trace message (string; 18 chars)
-                    , PTR_CAST( pttrace[i].data1 )      // Data value 1
-                    , PTR_CAST( pttrace[i].data2 )      // Data value 2
-                    , retcode                           // Return code (or empty string)
-                    , lockname                          // Lock name   (or empty string)
-                );
-
-                count++;
-            }
-            if (++i >= n) i = 0;
-        } while (i != pttracex);
-
-        /* Clear all the table entries we just printed and
-           enable tracing again starting at entry number 0.
-           NOTE: there is no need to obtain the lock since:
-           a) pttracex is never accessed unless pttracen is
-           non-zero, b) because pttracen is an int, setting
-           it to non-zero again should be atomic.
+            int e = ring->wrapped ? ring->n : ring->x;
+            for (i=0; i < e; i++)
+                if (ring->tab[i].tid)
+                    sorted[ total++ ] = &ring->tab[i];
+        }
+    }
+    RELEASE_PTTLOCK;
+
+    /* ...and merge them into timestamp order */
+    qsort( sorted, total, sizeof( PTT_TRACE* ), ptt_cmp_stamp );
+
+    /* Print the trace table */
+    for (i=0; i < total; i++)
+    {
+        PTT_TRACE*  p = sorted[i];
+        const char* loc = TRIMLOC( p->loc );
+        char threadname[16];
+        char lockname[32];
+        const char* lname;
+
+        if (ptt_filtered( p, loc ))
+            continue;
+
+        /* Convert trace clock value back to time of day */
+        if (p->stamp)
+        {
+            usecs = (S64)((double)(S64)(p->stamp - pttbasestamp) / perusec);
+            usecs += PTT_USECS( &pttbasetv );
+            tv.tv_sec  = (long)(usecs / 1000000);
+            tv.tv_usec = (long)(usecs % 1000000);
+        }
+        else
+            tv.tv_sec = tv.tv_usec = 0;
+
+        FormatTIMEVAL( &tv, tod, sizeof( tod ));
+        get_thread_name( p->tid, threadname );
+
+        if (p->trclass & PTT_CL_THR)
+        {
+            /* For the thread class, an 'rc' of PTT_MAGIC
+               indicates its value is uninteresting to us,
+               so we don't bother showing it. Otherwise we
+               format it as a +/- decimal value.
+            */
+            if (p->rc == PTT_MAGIC)
+                retcode[0] = 0;
+            else
+                MSGBUF( retcode, "%"PRId64, p->rc );
+        }
+        else
+        {
+            /* Not thread class: format return code
+               as just another 64-bit hex value.
+            */
+            MSGBUF( retcode, "%16.16"PRIx64, p->rc );
+        }
+
+        /* If this is the thread class we know the data1 value
+           is USUALLY the address of the lock identifying which
+           lock was being obtained/released, so as a courtesy
+           we display its name after the message.  This might
+           not always work as the data1 value for SOME thread
+           trace entries might be NULL or be some other value.
         */
-        memset( pttrace, 0, PTT_TRACE_SIZE * n );
-        pttracex = 0;
-        pttracen = n;
+        lname = (p->trclass & PTT_CL_THR) ?
+            get_lock_name( (LOCK*) p->data1 ) : "";
+
+        MSGBUF( lockname, "%s%s", lname[0] ? " " : "", lname );
+
+        if (lockname[0] && !retcode[0])
+            retcode[0] = ' ', retcode[1] = 0;
+
+        // "%s "TIDPAT" %-15.15s %-18.18s %-18.18s"PTR_FMTx" "PTR_FMTx" %s%s"
+        WRMSG( HHC90021, "I"
+            , &tod[11]                          // Time of day (HH:MM:SS.usecs)
+            , TID_CAST( p->tid )                // Thread id
+            , threadname                        // Thread name
+            , loc                               // File name (string; 18 chars)
+            , p->msg                            // Trace message (string; 18 chars)
+            , PTR_CAST( p->data1 )              // Data value 1
+            , PTR_CAST( p->data2 )              // Data value 2
+            , retcode                           // Return code (or empty string)
+            , lockname                          // Lock name   (or empty string)
+        );
+
+        count++;
     }
 
+    free( sorted );
+
+    /* Clear all the table entries we just printed and enable tracing
+       again: bumping the generation has every thread start over with
+       a fresh table the next time it traces an event. */
+    ptt_trace_init( n, FALSE );
+
     return count;
 }
@@ -89,12 +89,20 @@
 //efine PTT_CL_ZZZ   0x4000000000000000 /* User class 47             */
 //efine PTT_CL_ZZZ   0x8000000000000000 /* User class 48             */
 
+/*-------------------------------------------------------------------*/
+/*  Classes which may be traced at all. Define as a subset of the    */
+/*  classes at build time to compile all other PTT calls out.        */
+/*-------------------------------------------------------------------*/
+#ifndef PTT_CL_COMPILED
+#define PTT_CL_COMPILED  0xFFFFFFFFFFFFFFFFULL
+#endif
+
 /*-------------------------------------------------------------------*/
 /*                  Primary PTT Tracing macro                        */
 /*-------------------------------------------------------------------*/
 #define PTT( _class, _msg, _data1, _data2, _rc )                     \
 do {                                                                 \
-  if (pttclass & (_class))                                           \
+  if ((PTT_CL_COMPILED & (_class)) && (pttclass & (_class)))         \
     ptt_pthread_trace( (_class), (_msg),(void*)(uintptr_t)(_data1),  \
                                          (void*)(uintptr_t)(_data2), \
                                          PTT_LOC,                    \
@@ -138,6 +146,7 @@ PTT_DLL_IMPORT void ptt_trace_init    ( int nTableSize, BOOL init );
 PTT_DLL_IMPORT int  ptt_cmd           ( int argc, char* argv[], char* cmdline );
 PTT_DLL_IMPORT void ptt_pthread_trace ( U64, const char*, const void*, const void*, const char*, S64, TIMEVAL* );
 PTT_DLL_IMPORT int  ptt_pthread_print ();/* rc = #of entries printed */
+PTT_DLL_IMPORT void ptt_thread_exit   ();/* release thread's table   */
 PTT_DLL_IMPORT U64  pttclass;
 PTT_DLL_IMPORT bool ptt_dtax(); // Dump Table At Exit
 
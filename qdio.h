@@ -24,6 +24,8 @@ typedef struct _QDIO_DEV {
     unsigned rxcnt;             /* Packets read                      */
     unsigned txcnt;             /* Packets written                   */
     unsigned dropcnt;           /* Packets dropped                   */
+    U64      rxbytes;           /* Bytes read                        */
+    U64      txbytes;           /* Bytes written                     */
 
     int     idxstate;           /* IDX state                         */
 #define MPC_IDX_STATE_INACTIVE  0x00 // ZZ THIS FIELD NEEDS TO MOVE
@@ -875,24 +875,6 @@ static int qeth_select (int nfds, fd_set* rdset, struct timeval* tv)
     PTT_QETH_TRACE( "af select", 0,0,0 );
     return rc;
 }
-static int qeth_read_pipe (int fd, BYTE *sig)
-{
-    int rc, errnum;
-    PTT_QETH_TRACE( "b4 rdpipe", 0,0,*sig );
-    for (;;) {
-        rc = read_pipe( fd, sig, 1 );
-        if (rc > 0)
-            break;
-        errnum = HSO_errno;
-        if (!QETH_TEMP_PIPE_ERROR( errnum ))
-            break;
-        sched_yield();
-    }
-    if (rc <= 0)
-        errno = errnum;
-    PTT_QETH_TRACE( "af rdpipe", 0,0,*sig );
-    return rc;
-}
 static int qeth_write_pipe (int fd, BYTE *sig)
 {
     int rc, errnum;
@@ -913,6 +895,133 @@ static int qeth_write_pipe (int fd, BYTE *sig)
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Activate Queues signalling. A signal is posted by setting its bit */
+/* in qsigs (the latest read and write packing mode signals are also */
+/* remembered) and the device thread is only woken when the first    */
+/* signal becomes pending, through an eventfd waited on with epoll   */
+/* where available or through the socket pipe and select otherwise.  */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_SYS_EPOLL_H ) && defined( HAVE_SYS_EVENTFD_H )
+  #define QETH_EPOLL            /* Use eventfd and epoll             */
+#endif
+
+static void qeth_post_sig( OSA_GRP* grp, BYTE sig )
+{
+    U32  was;
+
+    obtain_lock( &grp->siglock );
+    {
+        was = grp->qsigs;
+        grp->qsigs |= (1 << sig);
+
+        if (QDSIG_READ == sig || QDSIG_RDMULT == sig)
+            grp->qsigrd = sig;
+        else if (QDSIG_WRIT == sig || QDSIG_WRMULT == sig)
+        {
+            grp->qsigwr = sig;
+            if (!grp->sigatime)
+                grp->sigatime = ETOD_high64_to_usecs( host_tod() );
+        }
+    }
+    release_lock( &grp->siglock );
+
+    /* Wake the device thread unless a wakeup is already pending */
+    if (!was)
+    {
+#if defined( QETH_EPOLL )
+        if (grp->efd >= 0)
+            VERIFY( eventfd_write( grp->efd, 1 ) == 0 );
+        else
+#endif
+            VERIFY( qeth_write_pipe( grp->ppfd[1], &sig ) == 1 );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Wait up to usecs for the TUN/TAP device to become readable or for */
+/* a signal to be posted. Returns the posted signals (one bit each), */
+/* sets *ttready if the TUN/TAP device is readable and *sigatime to  */
+/* the time of the oldest SIGA-w not yet serviced (or zero). epoll   */
+/* only has millisecond timeouts so shorter waits use select.        */
+/*-------------------------------------------------------------------*/
+static U32 qeth_wait_for_work( OSA_GRP* grp, long usecs,
+                               int* ttready, U64* sigatime )
+{
+    int  sigready = 0;
+    U32  sigs = 0;
+
+    *ttready  = 0;
+    *sigatime = 0;
+
+#if defined( QETH_EPOLL )
+    if (grp->epfd >= 0 && (!usecs || usecs >= 1000))
+    {
+        struct epoll_event ev[2];
+        int i, n;
+
+        PTT_QETH_TRACE( "b4 epoll", 0,0,0 );
+        n = epoll_wait( grp->epfd, ev, 2, (int)((usecs + 999) / 1000) );
+        PTT_QETH_TRACE( "af epoll", n,0,0 );
+
+        for (i=0; i < n; i++)
+        {
+            if (ev[i].data.fd == grp->efd)
+                sigready = 1;
+            else
+                *ttready = 1;
+        }
+    }
+    else
+#endif
+    {
+        fd_set readset;
+        struct timeval tv;
+        int sfd = (grp->efd >= 0) ? grp->efd : grp->ppfd[0];
+
+        FD_ZERO( &readset );
+        FD_SET( sfd,        &readset );
+        if (!grp->ttgone)
+            FD_SET( grp->ttfd,  &readset );
+        tv.tv_sec  = usecs / 1000000;
+        tv.tv_usec = usecs % 1000000;
+
+        if (qeth_select( max( sfd, grp->ttfd ) + 1, &readset, &tv ) > 0)
+        {
+            sigready = FD_ISSET( sfd,       &readset ) ? 1 : 0;
+            *ttready = !grp->ttgone && FD_ISSET( grp->ttfd, &readset ) ? 1 : 0;
+        }
+    }
+
+    if (sigready)
+    {
+        /* Consume the wakeup, then take all pending signals */
+#if defined( QETH_EPOLL )
+        if (grp->efd >= 0)
+        {
+            eventfd_t cnt;
+            eventfd_read( grp->efd, &cnt );
+        }
+        else
+#endif
+        {
+            BYTE buf[16];
+            read_pipe( grp->ppfd[0], buf, sizeof( buf ));
+        }
+
+        obtain_lock( &grp->siglock );
+        {
+            sigs = grp->qsigs;
+            grp->qsigs = 0;
+            *sigatime = grp->sigatime;
+            grp->sigatime = 0;
+        }
+        release_lock( &grp->siglock );
+    }
+    return sigs;
+}
+
+
 /*-------------------------------------------------------------------*/
 /*  Helper macro to call "qeth_errnum_msg()" function                */
 /*-------------------------------------------------------------------*/
@@ -1023,6 +1132,22 @@ static void qeth_report_using( DEVBLK *dev, OSA_GRP *grp )
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Network backend: the TUN/TAP interface ("tap", the default) or a  */
+/* user-space backend (see tuntap.h) which has no host interface we */
+/* could or should configure: frames are only read and written.     */
+/*-------------------------------------------------------------------*/
+#if defined( TUNTAP_NETBE )
+  #define QETH_HOSTIF( grp )    ((grp)->netbe->hnd->hostif)
+  #define QETH_IFACE( grp )     ((grp)->netbe->hnd->iface)
+  #define QETH_BENAME( grp )    ((grp)->netbe->hnd->name)
+#else
+  #define QETH_HOSTIF( grp )    (1)
+  #define QETH_IFACE( grp )     (1)
+  #define QETH_BENAME( grp )    ("tap")
+#endif
+
+
 /*-------------------------------------------------------------------*/
 /* Enable the TUNTAP interface  (set IFF_UP flag)                    */
 /*-------------------------------------------------------------------*/
@@ -1047,7 +1172,7 @@ static int qeth_enable_interface (DEVBLK *dev, OSA_GRP *grp)
             | (grp->promisc ? IFF_PROMISC : 0)
             );
 
-    rc = TUNTAP_SetFlags( grp->ttifname, flags );
+    rc = QETH_HOSTIF( grp ) ? TUNTAP_SetFlags( grp->ttifname, flags ) : 0;
     if (rc != 0)
     {
         QERRMSG( dev, grp, errno,
@@ -1122,6 +1247,20 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
         return -1;              /* Return failure */
     }
 
+#if defined( TUNTAP_NETBE )
+    if (!QETH_HOSTIF( grp ))
+    {
+        /* Open the user-space backend; its target names the peer */
+        const char* name;
+        if (NETBE_Open( grp->netbe, grp->betarget, grp->l3 ) != 0)
+            return QERRMSG( dev, grp, errno,
+                "E", "NETBE_Open() failed" );
+        grp->ttfd = grp->netbe->fd;
+        name = strrchr( grp->betarget, '/' );
+        STRLCPY( grp->ttifname, name ? name+1 : grp->betarget );
+    }
+    else
+#endif
     /* Create the new interface by opening the TUNTAP device */
     if ((rc = TUNTAP_CreateInterface
     (
@@ -1130,6 +1269,9 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
             | IFF_NO_PI
             | IFF_OSOCK
             | (grp->l3 ? IFF_TUN : IFF_TAP)
+#if defined( TUNTAP_OFFLOAD )
+            | (grp->offload ? IFF_VNET_HDR : 0)
+#endif
         ,
         &grp->ttfd,
         grp->ttifname
@@ -1137,6 +1279,9 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
     )) != 0)
         return QERRMSG( dev, grp, errno,
             "E", "TUNTAP_CreateInterface() failed" );
+#if defined( TUNTAP_NETBE )
+    grp->netbe->fd = grp->ttfd;
+#endif
 
     /* Update DEVBLK file descriptors */
     for (i=0; i < dev->group->acount; i++)
@@ -1147,6 +1292,7 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
                          dev->devnum,
                          dev->typname,
                          grp->ttifname,
+                         !QETH_HOSTIF( grp ) ? QETH_BENAME( grp ) :
                          (grp->l3 ? "TUN" : "TAP"));
 
     /* Set NON-Blocking mode by disabling Blocking mode */
@@ -1154,6 +1300,32 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
         QERRMSG( dev, grp, rc,
             "W", "socket_set_blocking_mode() failed" );
 
+    /* With offloads the host may only hand us complete frames since
+       the guest is never offered large receive or inbound checksum
+       completion: clear any offloads the interface may have had. */
+    if (grp->offload && TUNTAP_SetOffload( grp->ttfd, 0 ) != 0)
+        QERRMSG( dev, grp, errno,
+            "W", "TUNTAP_SetOffload() failed" );
+
+#if defined( QETH_EPOLL )
+    /* Have the Activate Queues epoll wait for packets too, else
+       fall back to select (which still waits on the eventfd) */
+    if (grp->epfd >= 0)
+    {
+        struct epoll_event ev;
+        memset( &ev, 0, sizeof( ev ));
+        ev.events  = EPOLLIN;
+        ev.data.fd = grp->ttfd;
+        if (epoll_ctl( grp->epfd, EPOLL_CTL_ADD, grp->ttfd, &ev ) != 0)
+        {
+            QERRMSG( dev, grp, errno,
+                "W", "epoll_ctl() failed" );
+            close( grp->epfd );
+            grp->epfd = -1;
+        }
+    }
+#endif
+
     /* Set the interface's MTU size, if possible */
     {
         /* Save original requested value, if any */
@@ -1187,7 +1359,8 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
             }
 
             MSGBUF( buf, "TUNTAP_SetMTU(%s) failed", grp->ttmtu );
-            if ((rc = TUNTAP_SetMTU( grp->ttifname, grp->ttmtu )) != 0)
+            if (QETH_HOSTIF( grp )
+                && (rc = TUNTAP_SetMTU( grp->ttifname, grp->ttmtu )) != 0)
                 return QERRMSG( dev, grp, errno, "E", buf );
         }
     }
@@ -1196,7 +1369,7 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
     /* Make sure the interface has a valid MAC address.      */
     /* TUN's of course don't have MAC addresses, only TAP's. */
     if (grp->tthwaddr) {
-        if (!grp->l3)
+        if (!grp->l3 && QETH_HOSTIF( grp ))
         {
             if ((rc = TUNTAP_SetMACAddr( grp->ttifname, grp->tthwaddr )) != 0)
             {
@@ -1212,6 +1385,10 @@ static int qeth_create_interface (DEVBLK *dev, OSA_GRP *grp)
     /* but we need to keep up a pretence.                    */
     InitMACAddr( dev, grp );
 
+    /* A user-space backend has no host interface to configure */
+    if (!QETH_HOSTIF( grp ))
+        return 0;
+
     /* If possible, assign an IPv4 address to the guest interface */
     if (1
 #if defined( OPTION_W32_CTCI )
@@ -1773,7 +1950,8 @@ U16 offph;
                               if (was_enabled)
                                   VERIFY( qeth_disable_interface( dev, grp ) == 0);
 #endif
-                              rc = TUNTAP_SetDestAddr( grp->ttifname, ipaddr );
+                              rc = !QETH_HOSTIF( grp ) ? 0 :
+                                   TUNTAP_SetDestAddr( grp->ttifname, ipaddr );
 #if defined( OPTION_W32_CTCI )
                               if (was_enabled)
                                   VERIFY( qeth_enable_interface( dev, grp ) == 0);
@@ -1931,6 +2109,22 @@ U16 offph;
                         grp->ipae4 |= ano;
                         grp->ipae6 |= ano;
                         grp->ipae0 |= ano;
+                        /* The offload assists report their capabilities */
+                        if (ano & (IPA_INBOUND_CHECKSUM | IPA_OUTBOUND_CHECKSUM))
+                        {
+                            STORE_FW(ipa_sas->data.chksum.supported,
+                                IPA_CHECKSUM_UDP | IPA_CHECKSUM_TCP | IPA_CHECKSUM_IP_HDR);
+                            STORE_FW(ipa_sas->data.chksum.enabled, 0);
+                            len = max(len, 8 + 8);  /* (hdr less ano + data) */
+                            STORE_HW(ipa_sas->hdr.len,len);
+                        }
+                        else if (ano & IPA_OUTBOUND_TSO)
+                        {
+                            STORE_FW(ipa_sas->data.tso.mss, QETH_TSO_MAXSIZE);
+                            STORE_FW(ipa_sas->data.tso.supported, IPA_LARGE_SEND_TCP);
+                            len = max(len, 8 + 8);  /* (hdr less ano + data) */
+                            STORE_HW(ipa_sas->hdr.len,len);
+                        }
                         STORE_HW(ipa_sas->hdr.rc,IPA_RC_OK);
                         STORE_HW(ipa->rc,IPA_RC_OK);
                         break;
@@ -1943,8 +2137,23 @@ U16 offph;
                         STORE_HW(ipa->rc,IPA_RC_OK);
                         break;
 
-                    case IPA_SAS_CMD_CONFIGURE:  /* 0x0003 */
                     case IPA_SAS_CMD_ENABLE:     /* 0x0004 */
+                        /* Checksum assists echo what will be done */
+                        if (ano & (IPA_INBOUND_CHECKSUM | IPA_OUTBOUND_CHECKSUM))
+                        {
+                        U32 cks;
+                            FETCH_FW(cks,ipa_sas->data.chksum.supported);
+                            cks &= IPA_CHECKSUM_UDP | IPA_CHECKSUM_TCP | IPA_CHECKSUM_IP_HDR;
+                            STORE_FW(ipa_sas->data.chksum.supported, cks);
+                            STORE_FW(ipa_sas->data.chksum.enabled, cks);
+                            len = max(len, 8 + 8);  /* (hdr less ano + data) */
+                            STORE_HW(ipa_sas->hdr.len,len);
+                        }
+                        STORE_HW(ipa_sas->hdr.rc,IPA_RC_OK);
+                        STORE_HW(ipa->rc,IPA_RC_OK);
+                        break;
+
+                    case IPA_SAS_CMD_CONFIGURE:  /* 0x0003 */
                     case IPA_SAS_CMD_0005:       /* 0x0005 */
                     case IPA_SAS_CMD_0006:       /* 0x0006 */
                     case IPA_SAS_CMD_0008:       /* 0x0008 */
@@ -2451,6 +2660,11 @@ U16 reqtype;
 #else
         grp->ipas6 = 0;
 #endif
+        if (grp->offload)
+        {
+            grp->ipas4 |= IPA_SUPP_OFFLOAD;
+            grp->ipas6 |= grp->ipas6 ? IPA_SUPP_OFFLOAD : 0;
+        }
         grp->ipae0 = 0;
         grp->ipae4 = 0;
         grp->ipae6 = 0;
@@ -2541,6 +2755,7 @@ static void raise_adapter_interrupt( DEVBLK* dev )
             release_lock( &dev->lock );
 
             RELEASE_INTLOCK( NULL );
+            grp->intcnt++;
             return;
         }
 
@@ -2556,6 +2771,60 @@ static void raise_adapter_interrupt( DEVBLK* dev )
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Update the packet and interrupt rates at the end of each rate     */
+/* interval. In adaptive mode also decide how much input interrupt   */
+/* coalescing the current input rate calls for: none at low rates   */
+/* (lowest latency), rising with the rate up to the configured (or   */
+/* default) packet count and delay limits.                           */
+/*-------------------------------------------------------------------*/
+static void update_rates( DEVBLK* dev, OSA_GRP* grp, U64 now )
+{
+    U64 elapsed = now - grp->ratetime;
+
+    if (elapsed < QETH_RATEUSECS)
+        return;
+
+    grp->rxrate  = (unsigned)(((U64)(dev->qdio.rxcnt - grp->raterx)  * 1000000) / elapsed);
+    grp->txrate  = (unsigned)(((U64)(dev->qdio.txcnt - grp->ratetx)  * 1000000) / elapsed);
+    grp->intrate = (unsigned)(((U64)(grp->intcnt     - grp->rateint) * 1000000) / elapsed);
+
+    grp->ratetime = now;
+    grp->raterx   = dev->qdio.rxcnt;
+    grp->ratetx   = dev->qdio.txcnt;
+    grp->rateint  = grp->intcnt;
+
+    if (grp->icadapt)
+    {
+        U32 maxpkts = grp->icpkts ? grp->icpkts : QETH_IC_PKTS;
+
+        grp->iceffpkts = min( grp->rxrate / QETH_IC_ADAPTDIV, maxpkts );
+        if (grp->iceffpkts < 2)
+        {
+            grp->iceffpkts  = 0;
+            grp->iceffusecs = 0;
+        }
+        else
+            grp->iceffusecs = grp->icusecs ? grp->icusecs : QETH_IC_USECS;
+    }
+}
+
+
+/*-------------------------------------------------------------------*/
+/* Determine whether a held "input available" interrupt is now due:  */
+/* when coalescing is off, when the guest has run out of empty input */
+/* buffers, or when either the packet count or delay limit is hit.   */
+/*-------------------------------------------------------------------*/
+static int input_interrupt_due( DEVBLK* dev, OSA_GRP* grp, U64 now )
+{
+    if (grp->icnow || (!grp->iceffpkts && !grp->iceffusecs))
+        return TRUE;
+    if (grp->iceffpkts && dev->qdio.rxcnt - grp->icrxcnt >= grp->iceffpkts)
+        return TRUE;
+    return (now - grp->icheld >= grp->iceffusecs);
+}
+
+
 /*-------------------------------------------------------------------*/
 /* Internal function return code flags                               */
 /*-------------------------------------------------------------------*/
@@ -2575,6 +2844,29 @@ typedef short QRC;              /* Internal function return code     */
 #define QRC_ESBNOEOF   -10      /* No last Last Storage Block flag   */
 
 
+/*-------------------------------------------------------------------*/
+/* Output packet/frame fragment list (vectored TUN/TAP writes)       */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_SYS_UIO_H ) && !defined( OPTION_W32_CTCI )
+  #define QETH_WRITEV           /* Use writev for fragmented frames  */
+  typedef struct iovec QETH_IOV;
+#else
+  typedef struct _QETH_IOV {    /* (same layout as struct iovec)     */
+      void*   iov_base;
+      size_t  iov_len;
+  } QETH_IOV;
+#endif
+
+#if defined( QETH_WRITEV )
+  #define QETH_ZEROCOPY         /* readv frames into guest storage   */
+#endif
+
+#if defined( QETH_WRITEV ) && defined( TUNTAP_OFFLOAD )
+  #define QETH_OFFLOAD          /* Checksum/TSO offload to TUN/TAP   */
+  #define QETH_OFFLOAD_HDRS 256 /* Frame header bytes we may edit    */
+#endif
+
+
 /*-------------------------------------------------------------------*/
 /* Helper function to report errors associated with an SBALE.        */
 /*-------------------------------------------------------------------*/
@@ -2709,85 +3001,385 @@ static inline int l3_cast_type_ipv6( BYTE* dest_addr, OSA_GRP* grp )
 }
 
 
+#if defined( TUNTAP_NETBE )
+/*-------------------------------------------------------------------*/
+/* The peer of a user-space backend has gone away (a read returned   */
+/* end of file). Report it once and stop waiting on the descriptor,  */
+/* which would otherwise remain readable forever. Output is dropped  */
+/* from now on, as it would be on a wire with nobody at the far end. */
+/*-------------------------------------------------------------------*/
+static void qeth_netbe_gone( DEVBLK* dev, OSA_GRP *grp )
+{
+    grp->ttgone = 1;
+#if defined( QETH_EPOLL )
+    if (grp->epfd >= 0)
+        epoll_ctl( grp->epfd, EPOLL_CTL_DEL, grp->ttfd, NULL );
+#endif
+    // HHC00912 "%1d:%04X %s: error reading from device %s: %d %s"
+    WRMSG(HHC00912, "E", LCSS_DEVNUM,
+        dev->typname, grp->ttifname, ECONNRESET, strerror( ECONNRESET ));
+}
+#endif
+
+
+/*-------------------------------------------------------------------*/
+/* Refill the receive batch from the TUN/TAP device. The device is   */
+/* in non-blocking mode so we simply keep reading frames until it    */
+/* runs dry, the batch is full, or there is no longer room for a     */
+/* maximum size frame. One wakeup thus services a whole burst and    */
+/* the zero timeout 'select' per frame is no longer needed. Returns  */
+/* the number of frames now waiting in the batch, or -1 with errno   */
+/* set if the very first read failed for any reason but EAGAIN.      */
+/* With offloads each frame's virtio-net header is removed here and  */
+/* only its flags are kept. Once a backend's peer has disconnected   */
+/* there is never anything more to read.                             */
+/*-------------------------------------------------------------------*/
+static int read_batch( DEVBLK* dev, OSA_GRP *grp )
+{
+    int   off = 0;                      /* Offset of next frame      */
+    int   len;                          /* Frame length              */
+
+    grp->rxbnum = grp->rxbpos = 0;
+
+    if (!grp->rxbuf)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (grp->ttgone)
+        return 0;
+
+    PTT_QETH_TRACE( "rdbat entr", grp->rxbufsz, 0, 0 );
+    while (grp->rxbnum < QETH_RXBATCH && grp->rxbufsz - off >= dev->bufsize)
+    {
+#if defined( TUNTAP_NETBE )
+        len = NETBE_Read( grp->netbe, grp->rxbuf + off, dev->bufsize );
+#else
+        len = TUNTAP_Read( dev->fd, grp->rxbuf + off, dev->bufsize );
+#endif
+        if (len <= 0)
+        {
+#if defined( TUNTAP_NETBE )
+            if (!len && !QETH_HOSTIF( grp ))
+            {
+                qeth_netbe_gone( dev, grp );
+                break;
+            }
+#endif
+            if (len < 0 && !grp->rxbnum && errno != EAGAIN)
+            {
+                PTT_QETH_TRACE( "*rdbat exit", grp->rxbufsz, len, errno );
+                return -1;
+            }
+            break;
+        }
+        grp->rxboff[ grp->rxbnum ] = off;
+        grp->rxblen[ grp->rxbnum ] = len;
+        grp->rxbvfl[ grp->rxbnum ] = 0;
+        if (grp->offload)
+        {
+            if (len < (int) sizeof( TUNTAP_VNETHDR ))
+                continue;               /* (runt; discard it)        */
+            grp->rxbvfl[ grp->rxbnum ] = ((TUNTAP_VNETHDR*)(grp->rxbuf + off))->flags;
+            grp->rxboff[ grp->rxbnum ] += sizeof( TUNTAP_VNETHDR );
+            grp->rxblen[ grp->rxbnum ] -= sizeof( TUNTAP_VNETHDR );
+        }
+        grp->rxbnum++;
+        off += (len + 7) & ~7;          /* (keep frames aligned)     */
+    }
+    PTT_QETH_TRACE( "rdbat exit", grp->rxbufsz, off, grp->rxbnum );
+    return grp->rxbnum;
+}
+
+
 /*-------------------------------------------------------------------*/
 /* Determine if TUN/TAP device has more packets waiting for us.      */
-/* Does a 'select' on the TUN/TAP device using a zero timeout        */
-/* and returns 1 if more packets are waiting or 0 (false) otherwise. */
-/* Note: boolean function. Does not report errors. If the select     */
-/* call fails then this function simply returns 0 = false (EOF).     */
+/* Returns 1 if frames remain in the current receive batch or if a   */
+/* refill of the batch found more waiting, or 0 (false) otherwise.   */
+/* Note: boolean function. Does not report errors. If the refill     */
+/* fails then this function simply returns 0 = false (EOF).          */
 /*-------------------------------------------------------------------*/
 static BYTE more_packets( DEVBLK* dev )
 {
-    fd_set readset;
-    struct timeval tv = {0,0};
-    FD_ZERO( &readset );
-    FD_SET( dev->fd, &readset );
-    return (qeth_select( dev->fd+1, &readset, &tv ) > 0);
+    OSA_GRP* grp = (OSA_GRP*) dev->group->grp_data;
+    if (grp->rxbpos < grp->rxbnum)
+        return 1;
+    return (read_batch( dev, grp ) > 0);
 }
 
 
 /*-------------------------------------------------------------------*/
-/* Read one packet/frame from TUN/TAP device into dev->buf.          */
-/* dev->buflen updated with length of packet/frame just read.        */
+/* Return the next packet/frame from the receive batch, refilling    */
+/* the batch from the TUN/TAP device if it is empty. *pkt is set to  */
+/* point to the packet/frame and dev->buflen is set to its length.   */
 /*-------------------------------------------------------------------*/
-static QRC read_packet( DEVBLK* dev, OSA_GRP *grp )
+static QRC read_packet( DEVBLK* dev, OSA_GRP *grp, BYTE** pkt )
 {
     int errnum;
+    int n;
 
-    PTT_QETH_TRACE( "rdpack entr", dev->bufsize, 0, 0 );
-    dev->buflen = TUNTAP_Read( dev->fd, dev->buf, dev->bufsize );
-    errnum = errno;
+    PTT_QETH_TRACE( "rdpack entr", dev->bufsize, grp->rxbpos, grp->rxbnum );
 
-    if (unlikely(dev->buflen < 0))
+    if (grp->rxbpos >= grp->rxbnum)
     {
-        if (errnum == EAGAIN)
-        {
-            errno = EAGAIN;
-            PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_EPKEOF );
-            return QRC_EPKEOF;
-        }
-        else
+        n = read_batch( dev, grp );
+        errnum = errno;
+
+        if (unlikely(n < 0))
         {
             // HHC00912 "%1d:%04X %s: error reading from device %s: %d %s"
             WRMSG(HHC00912, "E", LCSS_DEVNUM,
                 dev->typname, grp->ttifname, errnum, strerror( errnum ));
             errno = errnum;
+            dev->buflen = -1;
             PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_EIOERR );
             return QRC_EIOERR;
         }
+
+        if (unlikely(n == 0))
+        {
+            errno = EAGAIN;
+            dev->buflen = 0;
+            PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_EPKEOF );
+            return QRC_EPKEOF;
+        }
     }
 
-    if (unlikely(dev->buflen == 0))
+    /* Hand out the next frame of the batch */
+    *pkt = grp->rxbuf + grp->rxboff[ grp->rxbpos ];
+    grp->rxvflags = grp->rxbvfl[ grp->rxbpos ];
+    dev->buflen = grp->rxblen[ grp->rxbpos++ ];
+
+    /* Count packets received */
+    dev->qdio.rxcnt++;
+    dev->qdio.rxbytes += dev->buflen;
+
+    PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_SUCCESS );
+    return QRC_SUCCESS;
+}
+
+
+#if defined( QETH_ZEROCOPY )
+/*-------------------------------------------------------------------*/
+/* Read the next packet/frame from the TUN/TAP device straight into  */
+/* the queue buffer's Storage Blocks starting at Storage Block sb,   */
+/* leaving room for the hdrlen byte OSA header in front of it. This  */
+/* avoids copying the frame from the receive batch buffer. *pkt is   */
+/* set to the frame in guest storage (or to NULL if the first block  */
+/* cannot hold its headers contiguously, meaning the caller should   */
+/* use read_packet instead) and dev->buflen is set to its length.    */
+/* The Storage Blocks are not updated: copy_packet_to_storage does   */
+/* that (and stores the header) once the caller has built it.        */
+/*-------------------------------------------------------------------*/
+static QRC read_packet_to_storage( DEVBLK* dev, OSA_GRP *grp,
+                                   QDIO_SBAL *sbal, BYTE sbalk, int sb,
+                                   int hdrlen, BYTE** pkt )
+{
+    QETH_IOV iov[ QMAXSTBK + 2 ];       /* Storage Blocks + extras   */
+    TUNTAP_VNETHDR vh;                  /* virtio-net header         */
+    U64 sba;                            /* Storage Block Address     */
+    U32 sblen;                          /* Storage Block length      */
+    QRC stop = QRC_ENOSPC;              /* Why the block list ended  */
+    int cap = 0;                        /* Storage Block capacity    */
+    int n = 0;                          /* Number of iov entries     */
+    int i, len, errnum;
+
+    *pkt = NULL;
+
+    if (unlikely( grp->ttgone ))
     {
         errno = EAGAIN;
-        PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_EPKEOF );
+        dev->buflen = 0;
+        return QRC_EPKEOF;
+    }
+
+    /* The virtio-net header, if any, goes into our own buffer */
+    if (grp->offload)
+    {
+        iov[n].iov_base = &vh;
+        iov[n].iov_len  = sizeof( vh );
+        n++;
+    }
+
+    /* Gather the usable Storage Blocks, enough for a maximum size
+       frame. The first must be able to hold the OSA header and the
+       frame's own headers, else the frame is read the normal way. */
+    for (i = sb; i < QMAXSTBK && cap < dev->bufsize; i++)
+    {
+        FETCH_DW( sba,   sbal->sbale[i].addr   );
+        FETCH_FW( sblen, sbal->sbale[i].length );
+        if (!sblen)
+        {
+            stop = QRC_EZEROBLK;
+            break;
+        }
+        if (qeth_storage_access_check( sba, sblen-1, sbalk, STORKEY_CHANGE, dev ))
+        {
+            stop = QRC_ESTORCHK;
+            break;
+        }
+        if (i == sb)
+        {
+            if (sblen < (U32)(hdrlen + QETH_RXZC_MIN))
+                return QRC_SUCCESS;
+            sba   += hdrlen;
+            sblen -= hdrlen;
+        }
+        iov[n].iov_base = dev->mainstor + sba;
+        iov[n].iov_len  = sblen;
+        cap += sblen;
+        n++;
+    }
+    if (i == sb)
+        return QRC_SUCCESS;
+
+    /* Anything beyond the Storage Blocks lands in the (currently
+       unused) receive batch buffer so the frame is not truncated */
+    iov[n].iov_base = grp->rxbuf;
+    iov[n].iov_len  = dev->bufsize;
+    n++;
+
+    PTT_QETH_TRACE( "rdzc entr", sb, i, cap );
+    for (;;)
+    {
+        len = NETBE_Readv( grp->netbe, iov, n );
+        if (!grp->offload || len <= 0)
+            break;
+        if (len >= (int) sizeof( vh ))
+        {
+            len -= sizeof( vh );
+            break;
+        }
+        /* (runt; discard it) */
+    }
+    errnum = errno;
+
+    if (unlikely( len < 0 ))
+    {
+        dev->buflen = len;
+        if (errnum == EAGAIN)
+        {
+            PTT_QETH_TRACE( "rdzc exit", sb, len, QRC_EPKEOF );
+            return QRC_EPKEOF;
+        }
+        // HHC00912 "%1d:%04X %s: error reading from device %s: %d %s"
+        WRMSG(HHC00912, "E", LCSS_DEVNUM,
+            dev->typname, grp->ttifname, errnum, strerror( errnum ));
+        errno = errnum;
+        PTT_QETH_TRACE( "rdzc exit", sb, len, QRC_EIOERR );
+        return QRC_EIOERR;
+    }
+    if (unlikely( !len ))
+    {
+        if (!QETH_HOSTIF( grp ))
+            qeth_netbe_gone( dev, grp );
+        errno = EAGAIN;
+        dev->buflen = 0;
+        PTT_QETH_TRACE( "rdzc exit", sb, len, QRC_EPKEOF );
         return QRC_EPKEOF;
     }
 
     /* Count packets received */
     dev->qdio.rxcnt++;
+    dev->qdio.rxbytes += len;
+    dev->buflen = len;
+    grp->rxvflags = grp->offload ? vh.flags : 0;
 
-    PTT_QETH_TRACE( "rdpack exit", dev->bufsize, dev->buflen, QRC_SUCCESS );
+    /* Too big for the Storage Blocks? (copying would fail too) */
+    if (len > cap)
+    {
+        PTT_QETH_TRACE( "*rdzc exit", sb, len, stop );
+        if (QRC_EZEROBLK == stop)
+            return SBALE_ERROR( QRC_EZEROBLK, dev,sbal,sbalk,i);
+        if (QRC_ESTORCHK == stop)
+            return SBALE_ERROR( QRC_ESTORCHK, dev,sbal,sbalk,i);
+        return SBALE_ERROR( QRC_ENOSPC, dev,sbal,sbalk,QMAXSTBK-1);
+    }
+
+    *pkt = grp->rxzcpkt = iov[ grp->offload ? 1 : 0 ].iov_base;
+    PTT_QETH_TRACE( "rdzc exit", sb, len, QRC_SUCCESS );
     return QRC_SUCCESS;
 }
+#endif /* defined( QETH_ZEROCOPY ) */
 
 
 /*-------------------------------------------------------------------*/
-/* Write one L2/L3 packet/frame to the TUN/TAP device.               */
+/* Return the next packet/frame destined for Storage Block sb of the */
+/* queue buffer. Once the receive batch is empty frames are read     */
+/* directly into the Storage Blocks if possible (except when tracing */
+/* packets, which needs them in one piece), else via the batch.      */
+/*-------------------------------------------------------------------*/
+static QRC next_packet( DEVBLK* dev, OSA_GRP *grp, QDIO_SBAL *sbal,
+                        BYTE sbalk, int sb, int hdrlen, BYTE** pkt )
+{
+#if defined( QETH_ZEROCOPY )
+    if (grp->rxbpos >= grp->rxbnum && grp->rxbuf
+        && !(grp->debugmask & DBGQETHPACKET))
+    {
+        QRC qrc = read_packet_to_storage( dev, grp, sbal, sbalk,
+                                          sb, hdrlen, pkt );
+        if (qrc < 0 || *pkt)
+            return qrc;
+    }
+#else
+    UNREFERENCED( sbal );
+    UNREFERENCED( sbalk );
+    UNREFERENCED( sb );
+    UNREFERENCED( hdrlen );
+#endif
+    return read_packet( dev, grp, pkt );
+}
+
+
+/*-------------------------------------------------------------------*/
+/* Write one L2/L3 packet/frame to the TUN/TAP device. The frame is  */
+/* passed as a list of one or more fragments, which when possible    */
+/* are still in guest storage. Multiple fragments are written with a */
+/* single vectored write (one write is always one frame to TUN/TAP). */
 /*-------------------------------------------------------------------*/
 static QRC write_packet( DEVBLK* dev, OSA_GRP *grp,
-                         BYTE* pkt, int pktlen )
+                         QETH_IOV* iov, int iovcnt, int pktlen )
 {
     int wrote, errnum;
+#if defined( TUNTAP_NETBE )
+    U64 drops = grp->netbe->drops;
+#endif
 
-    PTT_QETH_TRACE( "wrpack entr", 0, pktlen, 0 );
-    wrote = TUNTAP_Write( dev->fd, pkt, pktlen );
+    PTT_QETH_TRACE( "wrpack entr", iovcnt, pktlen, 0 );
+#if defined( TUNTAP_NETBE )
+    if (unlikely( grp->ttgone ))
+    {
+        dev->qdio.dropcnt++;
+        PTT_QETH_TRACE( "wrpack exit", iovcnt, pktlen, QRC_SUCCESS );
+        return QRC_SUCCESS;
+    }
+    wrote = NETBE_Writev( grp->netbe, iov, iovcnt );
+#else
+#if defined( QETH_WRITEV )
+    if (iovcnt > 1)
+        wrote = writev( dev->fd, iov, iovcnt );
+    else
+#endif
+        wrote = TUNTAP_Write( dev->fd, iov[0].iov_base, pktlen );
+#endif
     errnum = errno;
 
+#if defined( TUNTAP_NETBE )
+    /* (the backend had no room for the frame and dropped it) */
+    if (unlikely( grp->netbe->drops != drops ))
+    {
+        dev->qdio.dropcnt++;
+        PTT_QETH_TRACE( "wrpack exit", iovcnt, pktlen, QRC_SUCCESS );
+        return QRC_SUCCESS;
+    }
+#endif
+
     if (likely(wrote == pktlen))
     {
         dev->qdio.txcnt++;
-        PTT_QETH_TRACE( "wrpack exit", 0, pktlen, QRC_SUCCESS );
+        dev->qdio.txbytes += pktlen;
+        PTT_QETH_TRACE( "wrpack exit", iovcnt, pktlen, QRC_SUCCESS );
         return QRC_SUCCESS;
     }
 
@@ -2795,11 +3387,201 @@ static QRC write_packet( DEVBLK* dev, OSA_GRP *grp,
     WRMSG(HHC00911, "E", LCSS_DEVNUM,
         dev->typname, grp->ttifname, errnum, strerror( errnum ));
     errno = errnum;
-    PTT_QETH_TRACE( "wrpack exit", 0, pktlen, QRC_EIOERR );
+    PTT_QETH_TRACE( "wrpack exit", iovcnt, pktlen, QRC_EIOERR );
     return QRC_EIOERR;
 }
 
 
+#if defined( QETH_OFFLOAD )
+/*-------------------------------------------------------------------*/
+/* Internet checksum helpers: sum (big-endian) 16-bit words of data  */
+/* into a 32-bit accumulator, and fold an accumulator to 16 bits.    */
+/*-------------------------------------------------------------------*/
+static U32 inet_csum_add( U32 sum, const BYTE* p, int len )
+{
+    for (; len > 1; p += 2, len -= 2)
+        sum += (p[0] << 8) | p[1];
+    if (len)
+        sum += p[0] << 8;
+    return sum;
+}
+
+static U16 inet_csum_fold( U32 sum )
+{
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return (U16) sum;
+}
+
+
+/*-------------------------------------------------------------------*/
+/* Build the virtio-net header and fragment list for writing one     */
+/* packet/frame to a TUN/TAP device opened with IFF_VNET_HDR. If the */
+/* guest asked for checksums to be inserted (or for TCP segmentation */
+/* with a TSO header) the IP and TCP/UDP headers are copied into the */
+/* work area, where the IP header is completed and the TCP or UDP    */
+/* checksum field primed with the pseudo-header sum, and the host is */
+/* then told to checksum and/or segment the rest. Guest storage is   */
+/* never modified. hdr points to the OSA header, iov/iovcnt/pktlen   */
+/* describe the packet/frame and out (at least iovcnt+2 entries) is  */
+/* set to the list to be written. Returns the number of entries, or */
+/* zero if the frame must be dropped (a TSO header with no MSS).     */
+/*-------------------------------------------------------------------*/
+static int offload_packet( OSA_GRP* grp, BYTE* hdr,
+                           QETH_IOV* iov, int iovcnt, int pktlen,
+                           TUNTAP_VNETHDR* vnet, BYTE* work,
+                           QETH_IOV* out )
+{
+    OSA_HDR_TSO* tso = NULL;            /* TSO extension header      */
+    BYTE  req;                          /* Checksums requested       */
+    BYTE  proto;                        /* IP protocol/next header   */
+    int   cplen;                        /* Header bytes copied       */
+    int   l3off, l4off;                 /* IP and TCP/UDP offsets    */
+    int   csumoff;                      /* Offset of L4 checksum     */
+    int   n, i, off, len;
+    U16   ethtype, mss = 0;
+    U32   sum;
+
+    memset( vnet, 0, sizeof( TUNTAP_VNETHDR ));
+    out[0].iov_base = vnet;
+    out[0].iov_len  = sizeof( TUNTAP_VNETHDR );
+
+    /* What does the guest want us to do? */
+    switch (hdr[0])
+    {
+    case HDR_ID_TSO:
+    case HDR_ID_L2TSO:
+        tso = (OSA_HDR_TSO*)(hdr + sizeof( OSA_HDR3 ));
+        FETCH_HW( mss, tso->mss );
+        if (!mss)
+            return 0;       /* (no segment size: can't be segmented) */
+        req = HDR3_EXFLAG_TPCKSUM | HDR3_EXFLAG_PKCKSUM;
+        break;
+    case HDR_ID_LAYER3:
+        req = ((OSA_HDR3*)hdr)->ext_flags
+            & (HDR3_EXFLAG_TPCKSUM | HDR3_EXFLAG_PKCKSUM);
+        break;
+    case HDR_ID_LAYER2:
+        req  = (((OSA_HDR2*)hdr)->flags[1] & HDR2_FLAGS1_TPCKSUM) ? HDR3_EXFLAG_TPCKSUM : 0;
+        req |= (((OSA_HDR2*)hdr)->flags[1] & HDR2_FLAGS1_PKCKSUM) ? HDR3_EXFLAG_PKCKSUM : 0;
+        break;
+    default:
+        req = 0;
+    }
+    if (!req)
+        goto as_is;
+
+    /* Copy the leading headers to the work area */
+    cplen = min( pktlen, QETH_OFFLOAD_HDRS );
+    for (off=0, i=0; off < cplen; off += len, i++)
+    {
+        len = min( (int) iov[i].iov_len, cplen - off );
+        memcpy( work + off, iov[i].iov_base, len );
+    }
+
+    /* Locate the IP header */
+    l3off = 0;
+    if (!grp->l3)
+    {
+        if (cplen < (int) sizeof( ETHFRM ) + 4)
+            goto as_is;
+        FETCH_HW( ethtype, work + 12 );
+        l3off = sizeof( ETHFRM );
+        if (ethtype == ETH_TYPE_VLANTAG)
+        {
+            FETCH_HW( ethtype, work + 16 );
+            l3off += 4;
+        }
+        if (ethtype != ETH_TYPE_IP && ethtype != ETH_TYPE_IPV6)
+            goto as_is;
+    }
+
+    /* Locate the TCP/UDP header and complete the IP header */
+    if (cplen < l3off + 40)
+        goto as_is;
+    if ((work[l3off] & 0xF0) == 0x40)
+    {
+        proto = work[l3off+9];
+        l4off = l3off + (work[l3off] & 0x0F) * 4;
+        if (l4off > cplen)
+            goto as_is;
+        if (tso)
+            STORE_HW( work + l3off + 2, min( pktlen - l3off, 0xFFFF ));
+        if (tso || (req & HDR3_EXFLAG_PKCKSUM))
+        {
+            STORE_HW( work + l3off + 10, 0 );
+            sum = inet_csum_add( 0, work + l3off, l4off - l3off );
+            STORE_HW( work + l3off + 10, (U16) ~inet_csum_fold( sum ));
+        }
+        sum = inet_csum_add( 0, work + l3off + 12, 8 );
+    }
+    else if ((work[l3off] & 0xF0) == 0x60)
+    {
+        proto = work[l3off+6];
+        l4off = l3off + 40;
+        /* Skip the extension headers that may precede TCP/UDP */
+        while ((proto == 0 || proto == 43 || proto == 60)
+            && l4off + 8 <= cplen)
+        {
+            proto = work[l4off];
+            l4off += (work[l4off+1] + 1) * 8;
+        }
+        if (tso)
+            STORE_HW( work + l3off + 4, min( pktlen - l3off - 40, 0xFFFF ));
+        sum = inet_csum_add( 0, work + l3off + 8, 32 );
+    }
+    else
+        goto as_is;
+
+    /* Prime the TCP/UDP checksum with the pseudo-header sum */
+    if (!(req & HDR3_EXFLAG_TPCKSUM) || (proto != 6 && proto != 17)
+        || (tso && proto != 6))
+        goto as_is_copied;
+    csumoff = (proto == 6) ? 16 : 6;
+    if (l4off + (proto == 6 ? 20 : 8) > cplen)
+        goto as_is_copied;
+    sum += proto + (pktlen - l4off);
+    STORE_HW( work + l4off + csumoff, inet_csum_fold( sum ));
+
+    vnet->flags       = VNETHDR_F_NEEDS_CSUM;
+    vnet->csum_start  = l4off;
+    vnet->csum_offset = csumoff;
+
+    /* Let the host do the TCP segmentation */
+    if (tso)
+    {
+        vnet->gso_type = ((work[l3off] & 0xF0) == 0x40)
+                       ? VNETHDR_GSO_TCPV4 : VNETHDR_GSO_TCPV6;
+        vnet->gso_size = mss;
+        vnet->hdr_len  = l4off + (work[l4off+12] >> 4) * 4;
+    }
+
+as_is_copied:
+
+    /* Write the edited headers followed by the rest of the frame */
+    out[1].iov_base = work;
+    out[1].iov_len  = cplen;
+    for (n=2, off=0, i=0; i < iovcnt; off += iov[i++].iov_len)
+    {
+        if (off + (int) iov[i].iov_len <= cplen)
+            continue;
+        len = max( cplen - off, 0 );
+        out[n].iov_base = (BYTE*) iov[i].iov_base + len;
+        out[n].iov_len  = iov[i].iov_len - len;
+        n++;
+    }
+    return n;
+
+as_is:
+
+    /* Nothing to do: write the frame unchanged */
+    for (i=0; i < iovcnt; i++)
+        out[i+1] = iov[i];
+    return iovcnt + 1;
+}
+#endif /* defined( QETH_OFFLOAD ) */
+
+
 /*-------------------------------------------------------------------*/
 /* Copy data fragment into OSA queue buffer storage.                 */
 /* Uses the entries from the passed Storage Block Address List to    */
@@ -2875,34 +3657,37 @@ static QRC copy_fragment_to_storage( DEVBLK* dev, QDIO_SBAL *sbal,
 
 
 /*-------------------------------------------------------------------*/
-/* Copy packet/frame data from one/more OSA queue storage buffers    */
-/* into DEVBLK device buffer. Uses the entries from the passed       */
-/* Storage Block Address List to copy the packet/frame data which    */
-/* might be split across several Storage Blocks. Stops when either   */
-/* the entire output packet has been consolidated into the DEVBLK    */
-/* buffer or the ending Storage Block is reached and consumed.       */
+/* Locate packet/frame data in one/more OSA queue storage buffers.   */
+/* Uses the entries from the passed Storage Block Address List to    */
+/* find the packet/frame data which might be split across several    */
+/* Storage Blocks, building a list of the fragments as they lie in   */
+/* guest storage (no data is copied). Stops when either the entire   */
+/* output packet has been located or the ending Storage Block is     */
+/* reached and consumed.                                             */
 /*-------------------------------------------------------------------*/
 /* sbal points to the Storage Block Address List for the buffer.     */
 /* sbalk is the associated protection key for the queue buffer.      */
 /* sb is a ptr to the current SBAL Storage Block number.             */
-/* sbsrc is where in the first Storage Block to begin copying from.  */
+/* sbsrc is where in the first Storage Block the data begins.        */
 /* sblen is the length of the first Storage Block minus the OSA hdr. */
-/* dev->bufres holds the expected packet/frame size and dev->buflen  */
-/* starts at zero. Both are updated as the copying proceeds.         */
-/*-------------------------------------------------------------------*/
-static QRC copy_storage_fragments( DEVBLK* dev, OSA_GRP *grp,
-                                   QDIO_SBAL *sbal, BYTE sbalk,
-                                   int* sb, BYTE* sbsrc, U32 sblen )
+/* pktlen is the expected packet/frame size. iov is the fragment     */
+/* list (at least QMAXSTBK entries) and iovcnt is set to the number  */
+/* of fragments found.                                               */
+/*-------------------------------------------------------------------*/
+static QRC gather_storage_fragments( DEVBLK* dev, OSA_GRP *grp,
+                                     QDIO_SBAL *sbal, BYTE sbalk,
+                                     int* sb, BYTE* sbsrc, U32 sblen,
+                                     int pktlen, QETH_IOV* iov,
+                                     int* iovcnt )
 {
     U64 sba;                            /* Storage Block Address     */
-    BYTE *dst;                          /* Destination address       */
-    U32 len;                            /* Copy length               */
+    U32 len;                            /* Fragment length           */
 
-    dst = dev->buf + dev->buflen;       /* Build destination pointer */
+    *iovcnt = 0;
 
-    /* Copy data from each Storage Block in turn until the entire
-       packet/frame has been copied or we reach the ending Block. */
-    while (dev->bufres > 0)
+    /* Walk each Storage Block in turn until the entire packet/frame
+       has been located or we reach the ending Block. */
+    while (pktlen > 0)
     {
         /* End of current storage block? */
         if (!sblen)
@@ -2910,10 +3695,9 @@ static QRC copy_storage_fragments( DEVBLK* dev, OSA_GRP *grp,
             /* Is this the last storage block? */
             if (WR_LOGICALLY_LAST_SBALE( sbal->sbale[*sb].flags[0] ))
             {
-                /* We have copied as much data as we possibly can but
-                dev->bufres is not zero so the Storage Blocks Entries
-                are wrong. THIS SHOULD NEVER OCCUR since our device
-                buffer size is always set to the maximum size of 64K. */
+                /* We have located as much data as we possibly can but
+                pktlen is not zero so the Storage Blocks Entries are
+                wrong. THIS SHOULD NEVER OCCUR. */
                 return SBALE_ERROR( QRC_EPKSBLEN, dev,sbal,sbalk,*sb);
             }
 
@@ -2939,65 +3723,119 @@ static QRC copy_storage_fragments( DEVBLK* dev, OSA_GRP *grp,
             sbsrc = (BYTE*)(dev->mainstor + sba);
         }
 
-        /* Copying packet/frame to device from this storage block */
-        len = min( (U32)dev->bufres, sblen );
-        memcpy( dst, sbsrc, len );
+        /* Add this storage block's part of the packet/frame */
+        len = min( (U32)pktlen, sblen );
+        iov[ *iovcnt ].iov_base = sbsrc;
+        iov[ *iovcnt ].iov_len  = len;
+        *iovcnt = *iovcnt + 1;
 
-        dst         += len;
-        dev->buflen += len;
-        dev->bufres -= len;
-        sbsrc       += len;
-        sblen       -= len;
+        pktlen -= len;
+        sbsrc  += len;
+        sblen  -= len;
     }
 
     return QRC_SUCCESS;
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Mark the Storage Blocks holding a packet/frame that was read by   */
+/* read_packet_to_storage, whose data thus already lies in them, and */
+/* store its OSA header in front of it. Sets each block's length and */
+/* fragment flags just as copying the frame into them would.         */
+/*-------------------------------------------------------------------*/
+static void mark_packet_in_storage( DEVBLK* dev, QDIO_SBAL *sbal,
+                                    int* sb, BYTE* hdr, int hdrlen,
+                                    int frmlen )
+{
+    U64 sba;                            /* Storage Block Address     */
+    U32 sblen;                          /* Storage Block length      */
+    U32 rem = hdrlen + frmlen;          /* Bytes not yet accounted   */
+    BYTE frag0;                         /* SBALE fragment flag       */
+
+    FETCH_DW( sba, sbal->sbale[*sb].addr );
+    memcpy( dev->mainstor + sba, hdr, hdrlen );
+
+    frag0 = SBALE_FLAG0_FRAG_FIRST;
+    for (;;)
+    {
+        FETCH_DW( sba,   sbal->sbale[*sb].addr   );
+        FETCH_FW( sblen, sbal->sbale[*sb].length );
+        ARCH_DEP( or_dev_4K_storage_key )( dev, sba, STORKEY_CHANGE );
+        if (rem <= sblen)
+            break;
+        STORE_FW( sbal->sbale[*sb].length, sblen );
+        STORE_FW( sbal->sbale[*sb].flags,    0   );
+        SET_SBALE_FRAG( sbal->sbale[*sb].flags[0], frag0 );
+        frag0 = SBALE_FLAG0_FRAG_MIDDLE;
+        rem -= sblen;
+        *sb = *sb + 1;
+    }
+
+    /* Mark last fragment */
+    frag0 = SBALE_FLAG0_FRAG_LAST;
+    STORE_FW( sbal->sbale[*sb].length, rem );
+    STORE_FW( sbal->sbale[*sb].flags,   0  );
+    SET_SBALE_FRAG( sbal->sbale[*sb].flags[0], frag0 );
+}
+
+
 /*-------------------------------------------------------------------*/
 /* Copy packet/frame from dev->buf into OSA queue buffer storage.    */
 /* Uses the entries from the passed Storage Block Address List to    */
 /* split the packet/frame across several Storage Blocks as needed.   */
 /* dev->buflen should be set to the length of the packet/frame.      */
+/* A frame read_packet_to_storage already placed in the Storage      */
+/* Blocks is not copied again; only its header is stored.            */
 /*-------------------------------------------------------------------*/
 /* sbal points to the Storage Block Address List for the buffer.     */
-/* sb is the Storage Block number to begin processing with.          */
+/* sb is a ptr to the Storage Block number to begin processing with  */
+/* and is updated to the last Storage Block the packet/frame used.   */
 /* sbalk is the associated protection key for the queue buffer.      */
 /* hdr points to pre-built OSA_HDR2/OSA_HDR3 and hdrlen is its size. */
 /*-------------------------------------------------------------------*/
 static QRC copy_packet_to_storage( DEVBLK* dev, OSA_GRP *grp,
-                                   QDIO_SBAL *sbal, int sb, BYTE sbalk,
+                                   QDIO_SBAL *sbal, int* sb, BYTE sbalk,
                                    BYTE* hdr, int hdrlen,
                                    BYTE* frm, int frmlen )
 {
-    int ssb = sb;                       /* Starting Storage Block    */
+    int ssb = *sb;                      /* Starting Storage Block    */
     U32 sboff = 0;                      /* Storage Block offset      */
     U32 sbrem = 0;                      /* Storage Block remaining   */
     BYTE frag0;                         /* SBALE fragment flag       */
     QRC qrc;                            /* Internal return code      */
 
-    /* Start with the header first */
-    frag0 = SBALE_FLAG0_FRAG_FIRST;
-    if ((qrc = copy_fragment_to_storage( dev, sbal, sbalk,
-        &sb, &frag0, &sboff, &sbrem, hdr, hdrlen )) < 0 )
-        return qrc;
+    if (frm == grp->rxzcpkt)
+    {
+        /* Frame is already in place */
+        grp->rxzcpkt = NULL;
+        mark_packet_in_storage( dev, sbal, sb, hdr, hdrlen, frmlen );
+    }
+    else
+    {
+        /* Start with the header first */
+        frag0 = SBALE_FLAG0_FRAG_FIRST;
+        if ((qrc = copy_fragment_to_storage( dev, sbal, sbalk,
+            sb, &frag0, &sboff, &sbrem, hdr, hdrlen )) < 0 )
+            return qrc;
 
-    /* Then copy the packet/frame */
-    if ((qrc = copy_fragment_to_storage( dev, sbal, sbalk,
-        &sb, &frag0, &sboff, &sbrem, frm, frmlen )) < 0 )
-        return qrc;
+        /* Then copy the packet/frame */
+        if ((qrc = copy_fragment_to_storage( dev, sbal, sbalk,
+            sb, &frag0, &sboff, &sbrem, frm, frmlen )) < 0 )
+            return qrc;
 
-    /* Mark last fragment */
-    frag0 = SBALE_FLAG0_FRAG_LAST;
-    STORE_FW( sbal->sbale[sb].length, sboff );
-    STORE_FW( sbal->sbale[sb].flags,     0   );
-    SET_SBALE_FRAG( sbal->sbale[sb].flags[0], frag0 );
+        /* Mark last fragment */
+        frag0 = SBALE_FLAG0_FRAG_LAST;
+        STORE_FW( sbal->sbale[*sb].length, sboff );
+        STORE_FW( sbal->sbale[*sb].flags,     0   );
+        SET_SBALE_FRAG( sbal->sbale[*sb].flags[0], frag0 );
+    }
 
     /* Dump the SBALE's we consumed */
     if (grp->debugmask & DBGQETHSBALE)
     {
         int  i;
-        for (i=ssb; i <= sb; i++)
+        for (i=ssb; i <= *sb; i++)
         {
             FETCH_FW( sbrem, sbal->sbale[i].length );
             frag0 = sbal->sbale[i].flags[0];
@@ -3018,19 +3856,22 @@ static QRC read_L2_packets( DEVBLK* dev, OSA_GRP *grp,
 {
     OSA_HDR2 o2hdr;
     ETHFRM* eth;
+    BYTE* pkt;
     int mactype;
     QRC qrc;
     int sb = 0;     /* Start with Storage Block zero */
     U16  hwEthernetType;
     char cPktType[8];
 
-    do {
+    for (;;)
+    {
         /* Find (another) frame for our MAC */
-        eth = (ETHFRM*)dev->buf;
         for(;;)
         {
-            if ((qrc = read_packet( dev, grp )) < 0)
-                return qrc; /*(probably EOF)*/
+            if ((qrc = next_packet( dev, grp, sbal, sbalk, sb,
+                                    sizeof( o2hdr ), &pkt )) < 0)
+                break; /*(probably EOF)*/
+            eth = (ETHFRM*)pkt;
 
             /* Verify the frame is being sent to us */
             if (!(mactype = validate_mac( eth->bDestMAC, MAC_TYPE_ANY, grp )))
@@ -3039,6 +3880,16 @@ static QRC read_L2_packets( DEVBLK* dev, OSA_GRP *grp,
             break;
         }
 
+        /* No more frames? Then we're done if the buffer has some */
+        if (qrc < 0)
+        {
+            if (!sb || (qrc != QRC_EPKEOF && qrc != QRC_EIOERR))
+                return qrc; /*(probably EOF)*/
+            sb--;
+            qrc = QRC_SUCCESS;
+            break;
+        }
+
         /* Build the Layer 2 OSA header */
         memset( &o2hdr, 0, sizeof( OSA_HDR2 ));
         STORE_HW( o2hdr.pktlen, dev->buflen );
@@ -3056,6 +3907,11 @@ static QRC read_L2_packets( DEVBLK* dev, OSA_GRP *grp,
             break;
         }
 
+        /* Pass on the host's checksum verification, if wanted */
+        if ((grp->rxvflags & VNETHDR_F_DATA_VALID)
+            && (grp->ipae0 & IPA_INBOUND_CHECKSUM))
+            o2hdr.flags[1] |= HDR2_FLAGS1_TPCKSUM | HDR2_FLAGS1_PKCKSUM;
+
         /* Debugging */
         if (grp->debugmask & DBGQETHPACKET)
         {
@@ -3072,15 +3928,18 @@ static QRC read_L2_packets( DEVBLK* dev, OSA_GRP *grp,
             WRMSG( HHC00986, "D", LCSS_DEVNUM,
                 dev->typname, dev->buflen, cPktType, grp->ttifname );
             net_data_trace( dev, (BYTE*) &o2hdr, sizeof( o2hdr ), TO_GUEST, 'D', "L2 hdr", 0 );
-            net_data_trace( dev,    dev->buf,     dev->buflen,    TO_GUEST, 'D', "Frame ", 0 );
+            net_data_trace( dev,    pkt,          dev->buflen,    TO_GUEST, 'D', "Frame ", 0 );
         }
 
         /* Copy header and frame to buffer storage block(s) */
-        qrc = copy_packet_to_storage( dev, grp, sbal, sb, sbalk,
+        qrc = copy_packet_to_storage( dev, grp, sbal, &sb, sbalk,
                                       (BYTE*) &o2hdr, sizeof( o2hdr ),
-                                      dev->buf, dev->buflen );
+                                      pkt, dev->buflen );
+
+        /* Pack another frame into the next storage block if we can */
+        if (qrc < 0 || !grp->rdpack || ++sb >= QMAXSTBK)
+            break;
     }
-    while (qrc >= 0 && grp->rdpack && more_packets( dev ) && ++sb < QMAXSTBK);
 
     /* Mark end of buffer */
     if (sb >= QMAXSTBK) sb--;
@@ -3099,17 +3958,26 @@ static QRC read_L3_packets( DEVBLK* dev, OSA_GRP *grp,
     IP4FRM* ip4;
     IP6FRM* ip6;
     OSA_HDR3 o3hdr;
+    BYTE* pkt;
     QRC qrc;
     BYTE udp = 17;
     int sb = 0;     /* Start with Storage Block zero */
     int   iPktVer;
     char  cPktType[8];
 
-    do
+    for (;;)
     {
         /* Read another packet into the device buffer */
-        if ((qrc = read_packet( dev, grp )) != 0)
-            return qrc; /*(probably EOF)*/
+        if ((qrc = next_packet( dev, grp, sbal, sbalk, sb,
+                                sizeof( o3hdr ), &pkt )) != 0)
+        {
+            /* No more packets? Then we're done if the buffer has some */
+            if (!sb || (qrc != QRC_EPKEOF && qrc != QRC_EIOERR))
+                return qrc; /*(probably EOF)*/
+            sb--;
+            qrc = QRC_SUCCESS;
+            break;
+        }
 
         /* Build the Layer 3 OSA header */
         memset( &o3hdr, 0, sizeof( OSA_HDR3 ));
@@ -3120,26 +3988,26 @@ static QRC read_L3_packets( DEVBLK* dev, OSA_GRP *grp,
 
         /* Check the IP packet version. The first 4-bits of the     */
         /* first byte of the IP header contains the version number. */
-        iPktVer = ( ( dev->buf[0] & 0xF0 ) >> 4 );
+        iPktVer = ( ( pkt[0] & 0xF0 ) >> 4 );
         if (iPktVer == 4)
         {
-            ip4 = (IP4FRM*)dev->buf;
+            ip4 = (IP4FRM*)pkt;
             STRLCPY( cPktType, " IPv4" );
             memcpy( &o3hdr.dest_addr[12], &ip4->lDstIP, 4 );
             memcpy( o3hdr.in_cksum, ip4->hwChecksum, 2 );
             o3hdr.flags = l3_cast_type_ipv4( &o3hdr.dest_addr[12], grp );
             if (o3hdr.flags == HDR3_FLAGS_NOTFORUS)
-                return QRC_EPKEOF; /* Not our packet */
+                continue; /* Not our packet (try next packet) */
             o3hdr.ext_flags = (ip4->bProtocol == udp) ? HDR3_EXFLAG_UDP : 0;
         }
         else if (iPktVer == 6)
         {
-            ip6 = (IP6FRM*)dev->buf;
+            ip6 = (IP6FRM*)pkt;
             STRLCPY( cPktType, " IPv6" );
             memcpy( o3hdr.dest_addr, ip6->bDstAddr, 16 );
             o3hdr.flags = l3_cast_type_ipv6( o3hdr.dest_addr, grp );
             if (o3hdr.flags == HDR3_FLAGS_NOTFORUS)
-                return QRC_EPKEOF; /* Not our packet */
+                continue; /* Not our packet (try next packet) */
 /* ????     o3hdr.flags |= HDR3_FLAGS_PASSTHRU | HDR3_FLAGS_IPV6;    */
             o3hdr.flags |= HDR3_FLAGS_IPV6;
             o3hdr.ext_flags = (ip6->bNextHeader == udp) ? HDR3_EXFLAG_UDP : 0;
@@ -3150,6 +4018,11 @@ static QRC read_L3_packets( DEVBLK* dev, OSA_GRP *grp,
             STRLCPY( cPktType, "" );
         }
 
+        /* Pass on the host's checksum verification, if wanted */
+        if ((grp->rxvflags & VNETHDR_F_DATA_VALID)
+            && ((iPktVer == 6 ? grp->ipae6 : grp->ipae4) & IPA_INBOUND_CHECKSUM))
+            o3hdr.ext_flags |= HDR3_EXFLAG_TPCKSUM | HDR3_EXFLAG_PKCKSUM;
+
         /* Debugging */
         if (grp->debugmask & DBGQETHPACKET)
         {
@@ -3157,15 +4030,18 @@ static QRC read_L3_packets( DEVBLK* dev, OSA_GRP *grp,
             WRMSG(HHC00913, "D", LCSS_DEVNUM, dev->typname,
                             cPktType, dev->buflen, grp->ttifname );
 /*          net_data_trace( dev, (BYTE*)&o3hdr, sizeof(o3hdr), TO_GUEST, 'D', "L3 hdr", 0 );        */
-            net_data_trace( dev, dev->buf, dev->buflen, TO_GUEST, 'D', "Packet", 0 );
+            net_data_trace( dev, pkt, dev->buflen, TO_GUEST, 'D', "Packet", 0 );
         }
 
         /* Copy header and packet to buffer storage block(s) */
-        qrc = copy_packet_to_storage( dev, grp, sbal, sb, sbalk,
+        qrc = copy_packet_to_storage( dev, grp, sbal, &sb, sbalk,
                                       (BYTE*) &o3hdr, sizeof( o3hdr ),
-                                      dev->buf, dev->buflen );
+                                      pkt, dev->buflen );
+
+        /* Pack another packet into the next storage block if we can */
+        if (qrc < 0 || !grp->rdpack || ++sb >= QMAXSTBK)
+            break;
     }
-    while (qrc >= 0 && grp->rdpack && more_packets( dev ) && ++sb < QMAXSTBK);
 
     /* Mark end of buffer */
     if (sb >= QMAXSTBK) sb--;
@@ -3254,7 +4130,7 @@ static QRC read_l3r_buffers( DEVBLK* dev, OSA_GRP *grp,
             }
 
             /* Copy header and packet to buffer storage block(s) */
-            qrc = copy_packet_to_storage( dev, grp, sbal, sb, sbalk,
+            qrc = copy_packet_to_storage( dev, grp, sbal, &sb, sbalk,
                                           (BYTE*)&o3hdr, sizeof(o3hdr),
                                           bufdata, datalen );
         }
@@ -3294,6 +4170,9 @@ static QRC write_buffered_packets( DEVBLK* dev, OSA_GRP *grp,
     int pktlen;                         /* Packet or frame length    */
     int sb;                             /* Storage Block number      */
     int ssb;                            /* Starting Storage Block    */
+    QETH_IOV iov[QMAXSTBK];             /* Packet or frame fragments */
+    int iovcnt;                         /* Number of fragments       */
+    int i;                              /* (work)                    */
     QRC qrc;                            /* Internal return code      */
     BYTE hdr_id;                        /* OSA Header Block Id       */
     BYTE flag0;                         /* Storage Block Flag        */
@@ -3373,7 +4252,25 @@ static QRC write_buffered_packets( DEVBLK* dev, OSA_GRP *grp,
             pktlen = length;
             break;
         }
+#if defined( QETH_OFFLOAD )
         case HDR_ID_TSO:
+        case HDR_ID_L2TSO:
+        {
+            /* (only valid with offloads, and for the matching layer) */
+            if (!grp->offload || (hdr_id == HDR_ID_TSO) != (grp->l3 != 0))
+                return SBALE_ERROR( QRC_EPKTYP, dev,sbal,sbalk,sb);
+            hdrlen = sizeof(OSA_HDR3) + sizeof(OSA_HDR_TSO);
+            if (sblen < (U32) hdrlen)
+                return SBALE_ERROR( QRC_EPKSBLEN, dev,sbal,sbalk,sb);
+            pkt = hdr + hdrlen;
+            if (hdr_id == HDR_ID_TSO)
+                FETCH_HW( length, ((OSA_HDR3*)hdr)->length );
+            else
+                FETCH_HW( length, ((OSA_HDR2*)hdr)->pktlen );
+            pktlen = length;
+            break;
+        }
+#endif
         case HDR_ID_OSN:
         default:
             return SBALE_ERROR( QRC_EPKTYP, dev,sbal,sbalk,sb);
@@ -3384,13 +4281,12 @@ static QRC write_buffered_packets( DEVBLK* dev, OSA_GRP *grp,
         if (pktlen > dev->bufsize)
             return SBALE_ERROR( QRC_EPKSIZ, dev,sbal,sbalk,sb);
 
-        /* Copy the actual packet/frame into the device buffer */
+        /* Locate the actual packet/frame in the Storage Block(s) */
         sblen -= hdrlen;
-        dev->bufres = pktlen;
-        dev->buflen = 0;
 
-        if ((qrc = copy_storage_fragments( dev, grp, sbal, sbalk,
-                                           &sb, pkt, sblen )) < 0)
+        if ((qrc = gather_storage_fragments( dev, grp, sbal, sbalk,
+                                             &sb, pkt, sblen, pktlen,
+                                             iov, &iovcnt )) < 0)
             return qrc;
 
         /* Save ending flag */
@@ -3399,11 +4295,39 @@ static QRC write_buffered_packets( DEVBLK* dev, OSA_GRP *grp,
         /* Trace the pack/frame if debugging is enabled */
         if (grp->debugmask & DBGQETHSBALE)
             DBGTRC( dev, "Output SBALE(%d-%d): Len: %04X (%d)",
-                ssb, sb, dev->buflen, dev->buflen );
+                ssb, sb, pktlen, pktlen );
+
+        /* A packet/frame lying in a single Storage Block is written
+           straight from guest storage. One split across several is
+           written with one vectored write, unless it must be looked
+           at as a whole below (L3 pass-through or IPv6 packets, or
+           packet tracing) in which case it is consolidated into the
+           device buffer first, as it also is if writev is missing. */
+        if (iovcnt > 1)
+        {
+#if defined( QETH_WRITEV )
+            IP6FRM* ip6 = (IP6FRM*) iov[0].iov_base;
+            if ((grp->debugmask & DBGQETHPACKET) || (hdr_id == HDR_ID_LAYER3
+                && (((OSA_HDR3*)hdr)->flags & HDR3_FLAGS_PASSTHRU
+                    || iov[0].iov_len < sizeof(IP6FRM)
+                    || (ip6->bVersTCFlow[0] & 0xF0) == 0x60)))
+#endif
+            {
+                for (pktlen=0, i=0; i < iovcnt; pktlen += iov[i++].iov_len)
+                    memcpy( dev->buf + pktlen, iov[i].iov_base, iov[i].iov_len );
+                iov[0].iov_base = dev->buf;
+                iov[0].iov_len  = pktlen;
+                iovcnt = 1;
+            }
+        }
+        else if (!iovcnt)
+        {
+            iov[0].iov_base = pkt;      /* (zero length packet/frame) */
+            iov[0].iov_len  = 0;
+        }
 
-        /* Initialize packet pointer and packet length */
-        pkt    = dev->buf;
-        pktlen = dev->buflen;
+        /* Initialize packet pointer (to the first fragment if more) */
+        pkt = iov[0].iov_base;
 
         /* I know the following looks pretty weird but it seems to be         */
         /* necessary when using IPv6 over layer 3. IPv6 uses ICMPv6 Neighbor  */
@@ -3507,7 +4431,35 @@ static QRC write_buffered_packets( DEVBLK* dev, OSA_GRP *grp,
         }
 
         /* Write the packet */
-        qrc = write_packet( dev, grp, pkt, pktlen );
+        if (iovcnt <= 1)
+        {
+            iov[0].iov_base = pkt;
+            iov[0].iov_len  = pktlen;
+            iovcnt = 1;
+        }
+#if defined( QETH_OFFLOAD )
+        if (grp->offload)
+        {
+            TUNTAP_VNETHDR vnet;
+            BYTE work[ QETH_OFFLOAD_HDRS ];
+            QETH_IOV vio[ QMAXSTBK + 2 ];
+
+            i = offload_packet( grp, hdr, iov, iovcnt, pktlen, &vnet, work, vio );
+            if (!i)
+            {
+                /* TSO frame without a segment size: drop it */
+                dev->qdio.dropcnt++;
+                if (grp->debugmask & DBGQETHDROP)
+                    // "%1d:%04X %s: %s: Output dropped: %s"
+                    WRMSG( HHC03811, "W", LCSS_DEVNUM,
+                        dev->typname, grp->ttifname, "TSO frame with zero MSS" );
+                continue;
+            }
+            qrc = write_packet( dev, grp, vio, i, sizeof( vnet ) + pktlen );
+        }
+        else
+#endif
+            qrc = write_packet( dev, grp, iov, iovcnt, pktlen );
 
 #if defined( ENABLE_IPV6 )
 
@@ -3663,9 +4615,8 @@ int did_read = 0;                       /* Indicates some data read  */
     */
     if (!did_read && more_packets( dev ))
     {
-        char buff[4096];
-        int packet_len = TUNTAP_Read( grp->ttfd, buff, sizeof( buff ));
-        if (packet_len)
+        BYTE* pkt;
+        if (QRC_SUCCESS == read_packet( dev, grp, &pkt ))
         {
             dev->qdio.dropcnt++;
             PTT_QETH_TRACE( "*prcinq drop", dev->qdio.i_qmask, 0, 0 );
@@ -3679,6 +4630,7 @@ int did_read = 0;                       /* Indicates some data read  */
         /* No available/empty Input Queues were to be found */
         /* Wake up the program so it can process its queues */
         grp->iqPCI = TRUE;
+        grp->icnow = TRUE;
     }
     PTT_QETH_TRACE( "prinq exit", 0,0,0 );
 }
@@ -3735,7 +4687,12 @@ int found_buff = 0;                     /* Found primed O/P buffer   */
 
                         sk = dev->qdio.o_sbalk[qn];
 
-                        if ((qrc = write_buffered_packets( dev, grp, sbal, sk )) >= 0)
+                        /* (lets TunTap32 batch the whole buffer) */
+                        TUNTAP_BegMWrite( dev->fd, dev->bufsize );
+                        qrc = write_buffered_packets( dev, grp, sbal, sk );
+                        TUNTAP_EndMWrite( dev->fd );
+
+                        if (qrc >= 0)
                             slsb->slsbe[bn] = SLSBE_OUTPUT_COMPLETED;
                     }
 
@@ -3814,7 +4771,7 @@ static void qeth_halt_data_device( DEVBLK* dev, OSA_GRP* grp )
             {
                 /* Ask, then wait for, the Activate Queues loop to exit */
                 PTT_QETH_TRACE( "b4 halt data", 0,0,0 );
-                VERIFY( qeth_write_pipe( grp->ppfd[1], &sig ) == 1);
+                qeth_post_sig( grp, sig );
                 wait_condition( &grp->qdcond, &grp->qlock );
                 dev->scsw.flag2 &= ~SCSW2_Q;
                 PTT_QETH_TRACE( "af halt data", 0,0,0 );
@@ -3960,10 +4917,65 @@ U32 mask4;
             VERIFY( socket_set_blocking_mode( grp->ppfd[0], 0 ) == 0);
             VERIFY( socket_set_blocking_mode( grp->ppfd[1], 0 ) == 0);
 
+            /* Signal with an eventfd and wait with epoll if we can,
+               otherwise the above pipe and select are used instead */
+
+            initialize_lock( &grp->siglock );
+            MSGBUF( buf,    "&grp->siglock %1d:%04X",     LCSS_DEVNUM );
+            set_lock_name(   &grp->siglock, buf );
+
+            grp->efd  = -1;
+            grp->epfd = -1;
+#if defined( QETH_EPOLL )
+            if ((grp->efd = eventfd( 0, EFD_NONBLOCK )) >= 0)
+            {
+                struct epoll_event ev;
+                memset( &ev, 0, sizeof( ev ));
+                ev.events  = EPOLLIN;
+                ev.data.fd = grp->efd;
+                if ((grp->epfd = epoll_create1( 0 )) >= 0
+                    && epoll_ctl( grp->epfd, EPOLL_CTL_ADD, grp->efd, &ev ) != 0)
+                {
+                    close( grp->epfd );
+                    grp->epfd = -1;
+                }
+            }
+#endif
+
             /* Set defaults */
 
             grp->ttdev = strdup( DEF_NETDEV );
             grp->ttfd  = -1;
+#if defined( TUNTAP_NETBE )
+            if (!(grp->netbe = calloc( 1, sizeof( NETBE ))))
+            {
+                char etext[40];
+                MSGBUF( etext, "calloc(%d)", (int) sizeof( NETBE ));
+                // HHC00900 "%1d:%04X %s: error in function %s: %s"
+                WRMSG(HHC00900, "E", LCSS_DEVNUM, dev->typname,
+                                     etext, strerror(errno) );
+                retcode = -1;
+            }
+            else
+            {
+                grp->netbe->hnd = &netbe_tap;
+                grp->netbe->fd  = -1;
+            }
+#endif
+
+            /* Receive batch buffer: room for a full batch of normal
+               size frames plus one more of the maximum size. */
+
+            grp->rxbufsz = dev->bufsize + QETH_RXBATCH * QETH_RXBATCH_FRAME;
+            if (!(grp->rxbuf = malloc( grp->rxbufsz )))
+            {
+                char etext[40];
+                MSGBUF( etext, "malloc(%d)", grp->rxbufsz );
+                // HHC00900 "%1d:%04X %s: error in function %s: %s"
+                WRMSG(HHC00900, "E", LCSS_DEVNUM, dev->typname,
+                                     etext, strerror(errno) );
+                retcode = -1;
+            }
         }
         else
             /* This code is executed for the second and subsequent devices in the group. */
@@ -4064,12 +5076,55 @@ U32 mask4;
             grp->ttmtu = strdup(argv[++i]);
             continue;
         }
+#if defined( TUNTAP_NETBE )
+        else if(!strcasecmp("backend",argv[i]) && (i+1) < argc)
+        {
+            const NETBE_HANDLER* hnd = NETBE_Find( argv[i+1] );
+            if (!hnd || (hnd->open && (i+2) >= argc))
+            {
+                // HHC00916 "%1d:%04X %s: option %s value %s invalid"
+                WRMSG(HHC00916, "E", LCSS_DEVNUM, dev->typname,
+                                     argv[i], argv[i+1] );
+                retcode = -1;
+                i++;
+                continue;
+            }
+            if (grp->netbe)
+                grp->netbe->hnd = hnd;
+            i++;
+            free( grp->betarget );
+            grp->betarget = hnd->open ? strdup(argv[++i]) : NULL;
+            continue;
+        }
+#endif
         else if(!strcasecmp("chpid",argv[i]) && (i+1) < argc)
         {
             free( grp->ttchpid );
             grp->ttchpid = strdup(argv[++i]);
             continue;
         }
+        else if(!strcasecmp("icpkts",argv[i]) && (i+1) < argc && atoi(argv[i+1]) >= 0)
+        {
+            grp->icpkts = atoi(argv[++i]);
+            continue;
+        }
+        else if(!strcasecmp("icusecs",argv[i]) && (i+1) < argc && atoi(argv[i+1]) >= 0)
+        {
+            grp->icusecs = atoi(argv[++i]);
+            continue;
+        }
+        else if(!strcasecmp("icadaptive",argv[i]))
+        {
+            grp->icadapt = 1;
+            continue;
+        }
+#if defined( QETH_OFFLOAD )
+        else if (!strcasecmp("offload",argv[i]))
+        {
+            grp->offload = 1;
+            continue;
+        }
+#endif
         else if (!strcasecmp("debug",argv[i]))
         {
             grp->debugmask = DBGQETHPACKET+DBGQETHDATA+DBGQETHUPDOWN;
@@ -4135,6 +5190,10 @@ U32 mask4;
         if (!grp->ttdev)
             grp->ttdev = strdup( DEF_NETDEV );
 
+        /* Offloads need the TUN/TAP virtio-net header */
+        if (!QETH_HOSTIF( grp ))
+            grp->offload = 0;
+
         /* Check the grp->tthwaddr value */
         if (grp->tthwaddr)
         {
@@ -4351,6 +5410,18 @@ U32 mask4;
                 (destlink << 8) | (cua->devnum & 0x00FF);
         }
 
+        /* Initialize the input interrupt coalescing in effect. A
+           packet count always comes with a delay limit so that a
+           trickle of input is never held indefinitely. Adaptive
+           mode starts with none until the input rate is known. */
+        if (!grp->icadapt)
+        {
+            grp->iceffpkts  = grp->icpkts;
+            grp->iceffusecs = grp->icusecs;
+            if (grp->icpkts && !grp->icusecs)
+                grp->iceffusecs = QETH_IC_USECS;
+        }
+
         /* Initialize mask fields */
         if(grp->ttpfxlen) {
             mask4 = makepfxmask4( grp->ttpfxlen );
@@ -4449,6 +5520,14 @@ OSA_GRP *grp = (OSA_GRP*)(group ? group->grp_data : NULL);
         PTT_QETH_TRACE( "b4 clos ttfd", 0,0,0 );
         grp->ttfd = -1;
         dev->fd = -1;
+#if defined( TUNTAP_NETBE )
+        if (grp->netbe && !QETH_HOSTIF( grp ))
+        {
+            if (ttfd >= 0)
+                NETBE_Close( grp->netbe );
+        }
+        else
+#endif
         if(ttfd > 0)
             TUNTAP_Close(ttfd);
         PTT_QETH_TRACE( "af clos ttfd", 0,0,0 );
@@ -4458,6 +5537,10 @@ OSA_GRP *grp = (OSA_GRP*)(group ? group->grp_data : NULL);
             close_pipe(grp->ppfd[0]);
         if(grp->ppfd[1])
             close_pipe(grp->ppfd[1]);
+        if (grp->epfd >= 0)
+            close( grp->epfd );
+        if (grp->efd >= 0)
+            close( grp->efd );
         PTT_QETH_TRACE( "af clos pipe", 0,0,0 );
 
         PTT_QETH_TRACE( "b4 clos othr", 0,0,0 );
@@ -4471,6 +5554,9 @@ OSA_GRP *grp = (OSA_GRP*)(group ? group->grp_data : NULL);
         free( grp->ttpfxlen6 );
         free( grp->ttmtu     );
         free( grp->ttchpid   );
+        free( grp->rxbuf     );
+        free( grp->betarget  );
+        free( grp->netbe     );
 
         PTT_QETH_TRACE( "af clos othr", 0,0,0 );
 
@@ -4481,6 +5567,7 @@ OSA_GRP *grp = (OSA_GRP*)(group ? group->grp_data : NULL);
         destroy_condition( &grp->qrcond );
         destroy_condition( &grp->qdcond );
         destroy_lock( &grp->qlock );
+        destroy_lock( &grp->siglock );
         destroy_lock( &grp->idx.lockbhr );
         destroy_lock( &grp->l3r.lockbhr );
 
@@ -5151,11 +6238,14 @@ U32 num;                                /* Number of bytes to move   */
     /* ACTIVATE QUEUES                                               */
     /*---------------------------------------------------------------*/
     {
-    fd_set readset;                         /* select read set       */
-    struct timeval tv;                      /* select polling        */
-    int fd;                                 /* select fd             */
-    int rc=0;                               /* select rc (0=timeout) */
-    BYTE sig;                               /* thread pipe signal    */
+    long usecs;                             /* wait timeout (usecs)  */
+    int ttready;                            /* TUN/TAP is readable   */
+    U32 sigs;                               /* signals received      */
+    U64 sigatime;                           /* oldest SIGA-w (usecs) */
+    unsigned txcnt;                         /* packets sent so far   */
+    BYTE sig = QDSIG_RESET;                 /* last signal received  */
+    U64 now;                                /* current time (usecs)  */
+    unsigned pkts;                          /* packets before pass   */
 
         /*
         ** PROGRAMMING NOTE: we use a relatively short timeout value
@@ -5169,72 +6259,101 @@ U32 num;                                /* Number of bytes to move   */
         DBGTRC( dev, "Activate Queues: Entry iqm=%8.8x oqm=%8.8x",dev->qdio.i_qmask, dev->qdio.o_qmask);
         PTT_QETH_TRACE( "actq entr", 0,0,0 );
 
+        /* Start the first rate interval with no interrupt held */
+        now = ETOD_high64_to_usecs( host_tod() );
+        grp->ratetime = grp->lastwork = now;
+        grp->raterx   = dev->qdio.rxcnt;
+        grp->ratetx   = dev->qdio.txcnt;
+        grp->rateint  = grp->intcnt;
+        grp->icpend   = grp->icnow = FALSE;
+
         /* Loop until halt signal is received via notification pipe */
         while (1)
         {
-            /* Prepare to wait for additional packets or pipe signal */
-            FD_ZERO( &readset );
-            FD_SET( grp->ppfd[0], &readset );
-            FD_SET( grp->ttfd,    &readset );
-            fd = max( grp->ppfd[0], grp->ttfd );
-            tv.tv_sec  = 0;
-            tv.tv_usec = OSA_TIMEOUTUS;         /* Select timeout usecs  */
+            /* Prepare to wait for additional packets or a signal */
+            usecs = OSA_TIMEOUTUS;
 
-            /* Wait (but only very briefly) for more work to arrive */
-            rc = qeth_select( fd+1, &readset, &tv );
+            /* While packets are moving adaptive mode polls briefly */
+            if (grp->icadapt && now - grp->lastwork < QETH_POLLIDLE)
+                usecs = QETH_POLLUSECS;
+
+            /* Don't wait if frames from the last batch are pending */
+            else if (grp->rxbpos < grp->rxbnum)
+                usecs = 0;
 
-            /* Read pipe signal if one was sent */
-            if (unlikely( rc && FD_ISSET( grp->ppfd[0], &readset )))
+            /* Don't wait past when a held interrupt becomes due */
+            if (grp->icpend && grp->iceffusecs)
             {
-                sig = QDSIG_RESET;
-                VERIFY( qeth_read_pipe( grp->ppfd[0], &sig ) == 1);
-                if (QDSIG_HALT == sig || grp->debugmask & DBGQETHQUEUES)
-                    DBGTRC( dev, "Activate Queues: %s received", qsig2str( sig ));
+                U64 due = grp->icheld + grp->iceffusecs;
+                if (due <= now)
+                    usecs = 0;
+                else if (due - now < (U64) usecs)
+                    usecs = (long)(due - now);
+            }
+
+            /* Wait (but only very briefly) for more work to arrive */
+            sigs = qeth_wait_for_work( grp, usecs, &ttready, &sigatime );
+            pkts = dev->qdio.rxcnt + dev->qdio.txcnt;
+            txcnt = dev->qdio.txcnt;
 
+            /* Act on any signals that were posted */
+            if (unlikely( sigs ))
+            {
                 /* Exit immediately when requested to do so */
-                if (QDSIG_HALT == sig)
+                if (sigs & (1 << QDSIG_HALT))
+                {
+                    sig = QDSIG_HALT;
+                    DBGTRC( dev, "Activate Queues: %s received", qsig2str( sig ));
                     break;
+                }
 
-                switch (sig)
+                if (sigs & ((1 << QDSIG_READ) | (1 << QDSIG_RDMULT)))
                 {
-                case QDSIG_READ:
-                    grp->rdpack = 0;
-                    break;
-                case QDSIG_RDMULT:
-                    grp->rdpack = 1;
-                    break;
-                case QDSIG_WRIT:
-                    grp->wrpack = 0;
-                    break;
-                case QDSIG_WRMULT:
-                    grp->wrpack = 1;
-                    break;
-                case QDSIG_WAKEUP:
-                    break;
-                default:
-                    ASSERT(0);  /* (should NEVER occur) */
+                    sig = grp->qsigrd;
+                    grp->rdpack = (QDSIG_RDMULT == sig) ? 1 : 0;
+                    if (grp->debugmask & DBGQETHQUEUES)
+                        DBGTRC( dev, "Activate Queues: %s received", qsig2str( sig ));
+                }
+
+                if (sigs & ((1 << QDSIG_WRIT) | (1 << QDSIG_WRMULT)))
+                {
+                    sig = grp->qsigwr;
+                    grp->wrpack = (QDSIG_WRMULT == sig) ? 1 : 0;
+                    if (grp->debugmask & DBGQETHQUEUES)
+                        DBGTRC( dev, "Activate Queues: %s received", qsig2str( sig ));
                 }
+
+                if ((sigs & (1 << QDSIG_WAKEUP)) && (grp->debugmask & DBGQETHQUEUES))
+                    DBGTRC( dev, "Activate Queues: %s received", qsig2str( QDSIG_WAKEUP ));
             }
 
             /* Check if any new packets have arrived */
-            if ((rc && FD_ISSET( grp->ttfd, &readset )) || grp->l3r.firstbhr)
+            if (ttready
+                || grp->rxbpos < grp->rxbnum || grp->l3r.firstbhr)
             {
                 /* Process packets if Queue is available */
                 if (likely( dev->qdio.i_qmask ))
                 {
                     process_input_queues( dev );
 
-                    /* Present "input available" interrupt if needed */
+                    /* Hold "input available" interrupt if needed */
                     if (grp->iqPCI)
                     {
                         PTT_QETH_TRACE( "actq iqPCI", 0,0,0 );
                         grp->iqPCI = FALSE;
-                        raise_adapter_interrupt( dev );
+                        if (!grp->icpend)
+                        {
+                            grp->icpend = TRUE;
+                            grp->icheld = ETOD_high64_to_usecs( host_tod() );
+                        }
+                        else
+                            grp->iccnt++;
                     }
                 }
                 else /* (no I/P queues? VERY unlikely!) */
                 {
-                    if (QRC_SUCCESS == read_packet( dev, grp ))
+                    BYTE* pkt;
+                    if (QRC_SUCCESS == read_packet( dev, grp, &pkt ))
                     {
                         dev->qdio.dropcnt++;
                         PTT_QETH_TRACE( "*actq drop", dev->qdio.i_qmask, 0, 0 );
@@ -5257,14 +6376,42 @@ U32 num;                                /* Number of bytes to move   */
             {
                 process_output_queues(dev);
 
+                /* Measure SIGA-w to transmit latency */
+                if (sigatime && dev->qdio.txcnt != txcnt)
+                {
+                    U64 lat = ETOD_high64_to_usecs( host_tod() ) - sigatime;
+                    grp->siglatsum += lat;
+                    grp->siglatcnt++;
+                    if (lat > grp->siglatmax)
+                        grp->siglatmax = (unsigned) lat;
+                }
+
                 /* Present "output processed" interrupt if needed */
+                /* (which also presents any held input interrupt)  */
                 if (grp->oqPCI)
                 {
                     PTT_QETH_TRACE( "actq oqPCI", 0,0,0 );
                     grp->oqPCI = FALSE;
+                    grp->icpend = grp->icnow = FALSE;
+                    grp->icrxcnt = dev->qdio.rxcnt;
                     raise_adapter_interrupt( dev );
                 }
             }
+
+            /* Note when packets last moved and update the rates */
+            now = ETOD_high64_to_usecs( host_tod() );
+            if (dev->qdio.rxcnt + dev->qdio.txcnt != pkts)
+                grp->lastwork = now;
+            update_rates( dev, grp, now );
+
+            /* Present "input available" interrupt once it is due */
+            if (grp->icpend && input_interrupt_due( dev, grp, now ))
+            {
+                PTT_QETH_TRACE( "actq intr", dev->qdio.rxcnt - grp->icrxcnt, 0,0 );
+                grp->icpend = grp->icnow = FALSE;
+                grp->icrxcnt = dev->qdio.rxcnt;
+                raise_adapter_interrupt( dev );
+            }
         }
         PTT_QETH_TRACE( "actq break", dev->devnum, 0,0 );
 
@@ -5397,7 +6544,7 @@ int noselrd, rc = 0;
             BYTE sig = QDSIG_READ;
             if (grp->debugmask & DBGQETHSIGA)
                 DBGTRC( dev, "SIGA-r: sending %s", qsig2str( sig ));
-            VERIFY( qeth_write_pipe( grp->ppfd[1], &sig ) == 1);
+            qeth_post_sig( grp, sig );
         }
     }
 
@@ -5439,7 +6586,7 @@ OSA_GRP *grp = (OSA_GRP*)dev->group->grp_data;
     {
         if (grp->debugmask & DBGQETHSIGA)
             DBGTRC( dev, "SIGA-o: sending %s", qsig2str( sig ));
-        VERIFY( qeth_write_pipe( grp->ppfd[1], &sig ) == 1);
+        qeth_post_sig( grp, sig );
     }
 
     return 0;
@@ -6394,7 +7541,16 @@ static void InitMACAddr( DEVBLK* dev, OSA_GRP* grp )
     if (!grp->l3) {
 
         /* Retrieve the MAC Address directly from the TAP interface */
-        rc = TUNTAP_GetMACAddr( grp->ttifname, &tthwaddr );
+        /* (a user-space backend's peer is not ours: use the given */
+        /* or a generated MAC address rather than the peer's own)  */
+        if (QETH_HOSTIF( grp ))
+            rc = TUNTAP_GetMACAddr( grp->ttifname, &tthwaddr );
+        else
+        {
+            tthwaddr = grp->tthwaddr;
+            grp->tthwaddr = NULL;
+            rc = tthwaddr ? 0 : -1;
+        }
 
         /* Did we get what we wanted? */
         if (0
@@ -6471,12 +7627,13 @@ static void InitMACAddr( DEVBLK* dev, OSA_GRP* grp )
 /*-------------------------------------------------------------------*/
 static void InitMTU( DEVBLK* dev, OSA_GRP* grp )
 {
-    char* ttmtu;
+    char* ttmtu = NULL;
     U16 uMTU;
-    int rc = 0;
+    int rc = -1;
 
     /* Retrieve the MTU value directly from the TUNTAP interface */
-    rc = TUNTAP_GetMTU( grp->ttifname, &ttmtu );
+    if (QETH_IFACE( grp ))
+        rc = TUNTAP_GetMTU( grp->ttifname, &ttmtu );
 
     /* Did we get what we wanted? */
     if (0
@@ -6605,7 +7762,6 @@ static void process_l3_icmpv6_packet(DEVBLK* dev, OSA_GRP* grp, IP6FRM* ip6)
     U16        ip6re_payload_size;  // Response ICMPv6 data size
     char       unspecified[16];
     char       solicitednode[16];
-    BYTE       sig;
 
     // Initialize variables
     memset( unspecified, 0, 16 );
@@ -6681,8 +7837,7 @@ static void process_l3_icmpv6_packet(DEVBLK* dev, OSA_GRP* grp, IP6FRM* ip6)
 
         // Add response buffer to chain.
         add_buffer_to_chain( &grp->l3r, bhrre );
-        sig = QDSIG_WAKEUP;
-        VERIFY( qeth_write_pipe( grp->ppfd[1], &sig ) == 1);
+        qeth_post_sig( grp, QDSIG_WAKEUP );
         return;
       }
 
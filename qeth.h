@@ -32,6 +32,16 @@
 #define OSA_MAXIPV6            32     /* Max supported IPv6 addresses*/
 #define OSA_MAXMAC             32     /* Max supported MAC addresses */
 #define OSA_TIMEOUTUS       50000     /* Read select timeout (usecs) */
+#define QETH_RXBATCH           16     /* Max frames per read batch   */
+#define QETH_RXBATCH_FRAME   2048     /* Nominal batched frame size  */
+#define QETH_RXZC_MIN          64     /* Min zero-copy 1st SBALE data*/
+#define QETH_TSO_MAXSIZE   0xF000     /* Max TCP segmentation size   */
+#define QETH_IC_USECS         100     /* Dflt max intr delay (usecs) */
+#define QETH_IC_PKTS           64     /* Dflt adaptive max packets   */
+#define QETH_IC_ADAPTDIV     2000     /* Adaptive: pkts/s per packet */
+#define QETH_POLLUSECS         50     /* Adaptive poll interval      */
+#define QETH_POLLIDLE       10000     /* Adaptive: stop polling after*/
+#define QETH_RATEUSECS     500000     /* Rate measurement interval   */
 
 #define QTOKEN1        0xD8C5E3F1     /* QETH token 1 (QET1 ebcdic)  */
 #define QTOKEN2        0xD8C5E3F2     /* QETH token 2 (QET2 ebcdic)  */
@@ -240,7 +250,54 @@ typedef struct _OSA_GRP {
     int   oqPCI;                /* Output Queue PCI was requested    */
 
     int   ttfd;                 /* File Descriptor TUNTAP Device     */
+    struct NETBE *netbe;        /* Network backend (see tuntap.h)    */
+    int   ttgone;               /* Backend peer has disconnected     */
+    char *betarget;             /* Backend socket path or interface  */
     int   ppfd[2];              /* Thread signalling socket pipe     */
+    int   efd;                  /* Thread signalling eventfd or -1   */
+    int   epfd;                 /* epoll instance (efd + ttfd) or -1 */
+
+    LOCK  siglock;              /* Lock for the pending signals      */
+    U32   qsigs;                /* Pending QDSIG_xxx signals (bits)  */
+    BYTE  qsigrd;               /* Latest QDSIG_READ/RDMULT signal   */
+    BYTE  qsigwr;               /* Latest QDSIG_WRIT/WRMULT signal   */
+    U64   sigatime;             /* Oldest unserviced SIGA-w (usecs)  */
+    U64   siglatsum;            /* SIGA-w to transmit total (usecs)  */
+    unsigned siglatcnt;         /* SIGA-w to transmit samples        */
+    unsigned siglatmax;         /* SIGA-w to transmit max (usecs)    */
+
+    BYTE *rxbuf;                /* Receive batch buffer              */
+    int   rxbufsz;              /* Receive batch buffer size         */
+    int   rxbnum;               /* Frames in receive batch           */
+    int   rxbpos;               /* Next frame in receive batch       */
+    int   rxboff[QETH_RXBATCH]; /* Receive batch frame offsets       */
+    int   rxblen[QETH_RXBATCH]; /* Receive batch frame lengths       */
+    BYTE  rxbvfl[QETH_RXBATCH]; /* Receive batch virtio-net flags    */
+    BYTE  rxvflags;             /* virtio-net flags of current frame */
+    BYTE *rxzcpkt;              /* Frame read straight into storage  */
+
+    int   offload;              /* TUN/TAP offloads (IFF_VNET_HDR)   */
+
+    U32   icpkts;               /* Coalesce: packets per interrupt   */
+    U32   icusecs;              /* Coalesce: max interrupt delay     */
+    int   icadapt;              /* Coalesce: adaptive moderation     */
+    U32   iceffpkts;            /* Coalesce: packets now in effect   */
+    U32   iceffusecs;           /* Coalesce: delay now in effect     */
+    int   icpend;               /* Input interrupt is being held     */
+    int   icnow;                /* Present held interrupt at once    */
+    U64   icheld;               /* When it was first held (usecs)    */
+    U64   lastwork;             /* When packets last moved (usecs)   */
+    unsigned icrxcnt;           /* rxcnt at last input interrupt     */
+    unsigned intcnt;            /* Adapter interrupts presented      */
+    unsigned iccnt;             /* Input interrupts coalesced        */
+
+    U64   ratetime;             /* Start of rate interval (usecs)    */
+    unsigned raterx;            /* rxcnt  at start of interval       */
+    unsigned ratetx;            /* txcnt  at start of interval       */
+    unsigned rateint;           /* intcnt at start of interval       */
+    unsigned rxrate;            /* Packets read per second           */
+    unsigned txrate;            /* Packets written per second        */
+    unsigned intrate;           /* Adapter interrupts per second     */
 
     U32   seqnumth;             /* MPC_TH sequence number            */
     U32   seqnumis;             /* MPC_RRH sequence number issuer    */
@@ -281,6 +338,7 @@ typedef struct _OSA_GRP {
 #define HDR_ID_LAYER2    0x02   /* Ethernet Layer 2 Frame            */
 #define HDR_ID_TSO       0x03   /* Layer 3 TCP Segmentation Offload  */
 #define HDR_ID_OSN       0x04   /* Channel Data Link Control (CDLC)  */
+#define HDR_ID_L2TSO     0x06   /* Layer 2 TCP Segmentation Offload  */
 
 
 /*-------------------------------------------------------------------*/
@@ -311,6 +369,9 @@ struct OSA_HDR2 {
 #define HDR2_FLAGS0_BROADCAST   0x05
 #define HDR2_FLAGS0_MULTICAST   0x04
 #define HDR2_FLAGS0_NOCAST      0x00
+#define HDR2_FLAGS1_UDP         0x40    /* 1=UDP packet; 0=TCP       */
+#define HDR2_FLAGS1_TPCKSUM     0x20    /* Transport checksum        */
+#define HDR2_FLAGS1_PKCKSUM     0x10    /* IP header checksum        */
 #define HDR2_FLAGS2_MULTICAST   0x01
 #define HDR2_FLAGS2_BROADCAST   0x02
 #define HDR2_FLAGS2_UNICAST     0x03
@@ -368,6 +429,26 @@ struct OSA_HDR3 {
 typedef struct OSA_HDR3 OSA_HDR3;
 
 
+/*-------------------------------------------------------------------*/
+/* OSA TCP Segmentation Offload extension header (follows the        */
+/* OSA_HDR2/OSA_HDR3 when the header id is HDR_ID_L2TSO/HDR_ID_TSO)  */
+/*-------------------------------------------------------------------*/
+struct OSA_HDR_TSO {
+/*000*/ HWORD   hdr_tot_len;    /* Length of this extension header   */
+/*002*/ BYTE    imb_hdr_no;     /* Number of headers (1)             */
+/*003*/ BYTE    resv003;        /*                                   */
+/*004*/ BYTE    hdr_type;       /* Header type (1)                   */
+/*005*/ BYTE    hdr_version;    /* Header version (1)                */
+/*006*/ HWORD   hdr_len;        /* Header length                     */
+/*008*/ FWORD   payload_len;    /* TCP payload length                */
+/*00C*/ HWORD   mss;            /* Maximum segment size              */
+/*00E*/ HWORD   dg_hdr_len;     /* IP + TCP header length            */
+/*010*/ BYTE    resv010[16];    /*                                   */
+/*020*/ } ATTRIBUTE_PACKED;     /* Total length: 32 bytes            */
+
+typedef struct OSA_HDR_TSO OSA_HDR_TSO;
+
+
 #if defined(_MSVC_)
  #pragma pack(pop)
 #endif
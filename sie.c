@@ -718,6 +718,10 @@ int     i;                              /* (work)                    */
 #if defined( FEATURE_BINARY_FLOATING_POINT )
     GUESTREGS->fpc =  regs->fpc;
 #endif
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+    memcpy( GUESTREGS->vrl, regs->vrl, sizeof( regs->vrl ));
+    memcpy( GUESTREGS->vrh, regs->vrh, sizeof( regs->vrh ));
+#endif
 
     /* Load GR14 and GR15 */
     FETCH_W( GUESTREGS->GR(14), STATEBK->gr14 );
@@ -1329,6 +1333,8 @@ endloop:        ; // (nop to make compiler happy)
                here, thereby causing the instruction counter to not be
                properly updated. Thus, we must update it here instead.
            */
+            EMU_STAT( GUESTREGS, progjmp );
+
             if (sysblk.ipled)
             {
                 regs->instcount += MAX_CPU_LOOPS/2;
@@ -1657,6 +1663,10 @@ void ARCH_DEP( sie_exit )( REGS* regs, int icode )
 #if defined( FEATURE_BINARY_FLOATING_POINT )
     regs->fpc = GUESTREGS->fpc;
 #endif
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+    memcpy( regs->vrl, GUESTREGS->vrl, sizeof( regs->vrl ));
+    memcpy( regs->vrh, GUESTREGS->vrh, sizeof( regs->vrh ));
+#endif
 
     /* Invalidate instruction address accelerator */
     INVALIDATE_AIA(regs);
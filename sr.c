@@ -13,6 +13,7 @@
 
 #include "hercules.h"
 #include "opcode.h"
+#include "zvector.h"
 
 //#define SR_DEBUG    // #define to enable TRACE stmts
 
@@ -77,6 +78,9 @@ REGS    *regs;
 DEVBLK  *dev;
 IOINT   *ioq;
 BYTE     psw[16];
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+BYTE     vr[512];
+#endif
 
     UNREFERENCED(cmdline);
 
@@ -252,6 +256,10 @@ BYTE     psw[16];
         for (j = 0; j < 32; j++)
             SR_WRITE_VALUE(file, SR_CPU_FPR+j, regs->fpr[j],sizeof(regs->fpr[0]));
         SR_WRITE_VALUE(file, SR_CPU_FPC, regs->fpc, sizeof(regs->fpc));
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+        vr_store_all(regs, vr);
+        SR_WRITE_BUF(file, SR_CPU_VR, vr, 512);
+#endif
         SR_WRITE_VALUE(file, SR_CPU_DXC, regs->dxc, sizeof(regs->dxc));
         SR_WRITE_VALUE(file, SR_CPU_MC, regs->MC_G, sizeof(regs->MC_G));
         SR_WRITE_VALUE(file, SR_CPU_EA, regs->EA_G, sizeof(regs->EA_G));
@@ -897,6 +905,19 @@ int      numconfdev=0;
             SR_READ_VALUE(file, len, &regs->fpc, sizeof(regs->fpc));
             break;
 
+        case SR_CPU_VR:
+            SR_NULL_REGS_CHECK(regs);
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+            if (len == 512)
+            {
+                SR_READ_BUF(file, buf, len);
+                vr_load_all(regs, (BYTE *)buf);
+                break;
+            }
+#endif
+            SR_READ_SKIP(file, len);
+            break;
+
         case SR_CPU_DXC:
             SR_NULL_REGS_CHECK(regs);
             SR_READ_VALUE(file, len, &regs->dxc, sizeof(regs->dxc));
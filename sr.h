@@ -312,6 +312,7 @@
 #define SR_CPU_SIGP_INI_RESET   0xace2011a
 #define SR_CPU_VTIMERINT        0xace2011b
 #define SR_CPU_RTIMERINT        0xace2011c
+#define SR_CPU_VR               0xace2011d
 #define SR_CPU_MALFCPU          0xace20120
 #define SR_CPU_MALFCPU_0        0xace20120
 #define SR_CPU_MALFCPU_1        0xace20121
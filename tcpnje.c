@@ -95,6 +95,12 @@ DECLARE_TCPNJE_ACK;     /* Declares TCPNJE_ACK array             */
 
 DECLARE_TCPNJE_NAK;     /* Declares TCPNJE_NAK array             */
 
+/* Completed TTBs queued for sending are gathered into one writev() */
+/* call instead of being sent out one send() at a time.              */
+#if defined(HAVE_SYS_UIO_H) && !defined(_MSVC_)
+  #define TCPNJE_WRITEV
+#endif
+
 #define DBGMSG(_level, ...) if ((tn->dev->ccwtrace && (_level & tn->trace)) || (_level & tn->debug)) logmsg(__VA_ARGS__)
 
 /*---------------------------------------------------------------*/
@@ -117,6 +123,7 @@ static PARSER ptab[] = {
     {"bufsize", "%s"},
     {"listen", "%s"},
     {"connect", "%s"},
+    {"buffers", "%s"},
     {NULL, NULL}
 };
 
@@ -136,7 +143,8 @@ enum {
     TCPNJE_KW_TRACE,
     TCPNJE_KW_BUFSIZE,
     TCPNJE_KW_LISTEN,
-    TCPNJE_KW_CONNECT
+    TCPNJE_KW_CONNECT,
+    TCPNJE_KW_BUFFERS
 } tcpnje_kw;
 
 static void logdump(char *txt, DEVBLK *dev, BYTE *bfr, size_t sz)
@@ -216,6 +224,7 @@ static char *guest_to_host_string(char *string, size_t length, const BYTE *ebcdi
 static void tcpnje_clean_device(DEVBLK *dev)
 {
     struct TCPNJE *tn;
+    int i;
 
     if (!dev)
     {
@@ -250,6 +259,14 @@ static void tcpnje_clean_device(DEVBLK *dev)
             free(tn->tcpoutbuf.base.address);
             tn->tcpoutbuf.base.address = NULL;
         }
+        for (i = 0; i < TCPNJE_MAX_BUFFERS; i++)
+        {
+            if (tn->tcpoutq[i].base.address != NULL)
+            {
+                free(tn->tcpoutq[i].base.address);
+                tn->tcpoutq[i].base.address = NULL;
+            }
+        }
         /* release the TCPNJE lock */
         release_lock(&tn->lock);
 
@@ -819,6 +836,71 @@ static int tcpnje_read(int fd, struct TNBUFFER *buffer, size_t wanted, struct TC
     return -((wanted - (buffer->inptr.address - buffer->base.address)) > 0);
 }
 /*-------------------------------------------------------------------*/
+/* TCPNJE Check receive ring for a complete TTB in worker thread     */
+/*                                                                   */
+/* The TTB/TTR input buffer is used as a ring holding several TTBs.  */
+/* tcpnje_read() is asked to fill it, so one recv() brings in as     */
+/* many TTBs as the network has ready and each is then passed to     */
+/* RSCS in place from tn->inblock.  A TTB is never split across the  */
+/* end of the ring: when the partial TTB at the end of the data      */
+/* received so far might not fit, it is moved back to the beginning. */
+/* Only that partial TTB is ever copied.                             */
+/*                                                                   */
+/* Returns: <0 Invalid TTB length received.  Link stopped.           */
+/*          =0 More data required.                                   */
+/*          >0 A complete TTB is available at tn->inblock.           */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+static int tcpnje_inblock(struct TCPNJE *tn)
+{
+    size_t avail, wanted;
+
+    avail = tn->tcpinbuf.inptr.address - tn->inblock;
+
+    /* If everything received has been used, start again at the top */
+    if (avail == 0)
+    {
+        tn->inblock = tn->tcpinbuf.base.address;
+        tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
+        return 0;
+    }
+
+    /* Until the TTB is in, assume the block is a full sized one */
+    wanted = tn->dev->bufsize;
+
+    if (avail >= SIZEOF_TTB)
+    {
+        wanted = ntohs(((struct TTB *)tn->inblock)->length);
+
+        if ((wanted < SIZEOF_TTB + SIZEOF_TTR) || (wanted > tn->tcpinbuf.size))
+        {
+            DBGMSG(1, "HHCTN172E %4.4X:TCPNJE - invalid incoming TTB length %d. Stopping link.\n",
+                    tn->dev->devnum, (int)wanted);
+            tcpnje_close(tn->sfd, tn);
+            tn->inblock = tn->tcpinbuf.base.address;
+            tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
+            return -1;
+        }
+
+        if (avail >= wanted)
+        {
+            DBGMSG(2048, "HHCTN135D %4.4X:TCPNJE incoming TTB, length %d. Connection state %s\n",
+                        tn->dev->devnum, (int)wanted, tcpnje_state_text[tn->state]);
+            return 1;
+        }
+    }
+
+    /* Make sure the rest of this TTB will fit in the ring */
+    if (tn->inblock + wanted > tn->tcpinbuf.base.address + tn->tcpinbuf.size)
+    {
+        memmove(tn->tcpinbuf.base.address, tn->inblock, avail);
+        tn->inblock = tn->tcpinbuf.base.address;
+        tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address + avail;
+    }
+
+    return 0;
+}
+/*-------------------------------------------------------------------*/
 /* TCPNJE Write socket data in worker thread                         */
 /*                                                                   */
 /* Write a TCPNJE block to the network.  Handle the case where the   */
@@ -906,6 +988,144 @@ static int tcpnje_write(int fd, struct TNBUFFER *buffer, struct TCPNJE *tn)
     return 0;
 }
 /*-------------------------------------------------------------------*/
+/* TCPNJE Write queued TTBs to the network in worker thread          */
+/*                                                                   */
+/* Send as much of the output queue as the network will take.  All   */
+/* the TTBs waiting are gathered into a single writev() call where   */
+/* this is available.  A TTB only partly sent stays at the head of   */
+/* the queue with its outptr marking where to carry on from.  RSCS   */
+/* is only held (via holdoutgoing) once every queue slot is waiting, */
+/* as until then it can carry on filling tcpoutbuf.                  */
+/*                                                                   */
+/* Returns: <0 Permanent error.  Queued data discarded.              */
+/*          =0 Output queue completely sent.                         */
+/*          >0 Temporary error. Some data may have been written.     */
+/*             Later retry may write more data.                      */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+static int tcpnje_writeq(struct TCPNJE *tn)
+{
+    struct TNBUFFER *buffer;
+#if defined(TCPNJE_WRITEV)
+    struct iovec iov[TCPNJE_MAX_BUFFERS];
+#endif
+    int i, count, written, done, part, savederrno = 0;
+
+    /* Find how much data we want to write this time around */
+    for (count = 0, i = 0; i < tn->outqcount; i++)
+    {
+        buffer = &tn->tcpoutq[(tn->outqhead + i) % tn->buffers];
+        count += buffer->inptr.address - buffer->outptr.address;
+    }
+    written = 0;
+
+    while (tn->outqcount > 0)
+    {
+#if defined(TCPNJE_WRITEV)
+        for (i = 0; i < tn->outqcount; i++)
+        {
+            buffer = &tn->tcpoutq[(tn->outqhead + i) % tn->buffers];
+            iov[i].iov_base = buffer->outptr.address;
+            iov[i].iov_len = buffer->inptr.address - buffer->outptr.address;
+        }
+        done = writev(tn->sfd, iov, tn->outqcount);
+#else /* defined(TCPNJE_WRITEV) */
+        buffer = &tn->tcpoutq[tn->outqhead];
+        done = send(tn->sfd, buffer->outptr.address,
+                    buffer->inptr.address - buffer->outptr.address, 0);
+#endif /* defined(TCPNJE_WRITEV) */
+
+        if (done < 0)
+        {
+            savederrno = HSO_errno;   /* In case logmsg() mangles errno */
+            break;
+        }
+        written += done;
+
+        /* Step through the queue over what has gone out */
+        while (done > 0)
+        {
+            buffer = &tn->tcpoutq[tn->outqhead];
+            part = buffer->inptr.address - buffer->outptr.address;
+            if (part > done) part = done;
+
+            logdump("To net", tn->dev, buffer->outptr.address, part);
+
+            buffer->outptr.address += part;
+            done -= part;
+
+            /* TTB completely sent?  Free its slot for the next one */
+            if (buffer->outptr.address == buffer->inptr.address)
+            {
+                buffer->outptr.address = buffer->base.address;
+                buffer->inptr.address = buffer->base.address;
+                tn->outqhead = (tn->outqhead + 1) % tn->buffers;
+                tn->outqcount--;
+                tn->outblockcount++;
+            }
+        }
+    }
+
+    DBGMSG(128, "HHCTN105D %4.4X:TCPNJE - wrote %d out of %d bytes\n",
+            tn->dev->devnum, written, count);
+
+    /* Did the whole queue get written? */
+    if (tn->outqcount > 0)
+    {
+        if (0
+#ifndef WIN32
+             || EAGAIN == savederrno
+#endif
+             || HSO_EWOULDBLOCK == savederrno
+           )
+        {
+            /* Only stop RSCS once there is nowhere left to queue output */
+            if (!tn->holdoutgoing && (tn->outqcount >= tn->buffers))
+            {
+                DBGMSG(128, "HHCTN106D %4.4X:TCPNJE - holding outgoing data transmission due to write contention\n",
+                        tn->dev->devnum);
+                tn->holdoutgoing = 1;
+            }
+            else if (tn->holdoutgoing && (tn->outqcount < tn->buffers))
+            {
+                DBGMSG(128, "HHCTN107D %4.4X:TCPNJE - resuming outgoing data transmission after successful network write\n",
+                        tn->dev->devnum);
+                tn->holdoutgoing = 0;
+            }
+            return 1;
+        }
+        else
+        {
+            DBGMSG(4, "HHCTN049E %4.4X:TCPNJE - Attempt to write %d bytes to output socket only wrote %d bytes. Error: %s\n",
+                    tn->dev->devnum, count, written, strerror(savederrno));
+            tcpnje_close(tn->sfd, tn);
+
+            /* Nowhere to send the rest now.  Discard it. */
+            while (tn->outqcount > 0)
+            {
+                buffer = &tn->tcpoutq[tn->outqhead];
+                buffer->outptr.address = buffer->base.address;
+                buffer->inptr.address = buffer->base.address;
+                tn->outqhead = (tn->outqhead + 1) % tn->buffers;
+                tn->outqcount--;
+            }
+            tn->holdoutgoing = 0;
+            return -1;
+        }
+    }
+
+    /* If write was completed successfully after previous contention, resume sending. */
+    if (tn->holdoutgoing)
+    {
+        DBGMSG(128, "HHCTN107D %4.4X:TCPNJE - resuming outgoing data transmission after successful network write\n",
+                tn->dev->devnum);
+
+        tn->holdoutgoing = 0;
+    }
+
+    return 0;
+}
+/*-------------------------------------------------------------------*/
 /* Send TCPNJE control record (OPEN/ACK/NAK)                         */
 /*-------------------------------------------------------------------*/
 static void tcpnje_ttc(int fd, const BYTE *type, int reason, struct TCPNJE *tn)
@@ -1198,6 +1418,8 @@ static void tcpnje_process_request(struct TNBUFFER *buffer, struct TCPNJE *tn)
 
                     /* Prepare to receive the first TTB */
                     othertn->tcpinbuf.inptr.address = othertn->tcpinbuf.base.address;
+                    othertn->inblock = othertn->tcpinbuf.base.address;
+                    othertn->tcpinbuf.valid = 0;
 
                     DBGMSG(256, "HHCTN053I %4.4X:TCPNJE - passing TCPNJE OPEN for link %s - %s to device %4.4X\n",
                               tn->dev->devnum, guest_to_host_string(lnodestring, sizeof(lnodestring), buffer->base.ttc->ohost),
@@ -1301,6 +1523,8 @@ static void tcpnje_process_request(struct TNBUFFER *buffer, struct TCPNJE *tn)
 
     /* Prepare to receive the first TTB */
     tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
+    tn->inblock = tn->tcpinbuf.base.address;
+    tn->tcpinbuf.valid = 0;
 
     return;
 }
@@ -1363,6 +1587,8 @@ static void tcpnje_process_reply(struct TNBUFFER *buffer, struct TCPNJE *tn)
 
         /* Prepare to receive the first TTB */
         tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
+        tn->inblock = tn->tcpinbuf.base.address;
+        tn->tcpinbuf.valid = 0;
     }
     else if (!memcmp(buffer->base.ttc->type, TCPNJE_NAK, sizeof(buffer->base.ttc->type)))
     {
@@ -1417,6 +1643,7 @@ static void *tcpnje_thread(void *vtn)
     struct TCPNJE *tn;                 /* Work TN Control Block Pointer     */
     int devnum;                 /* device number copy for convenience*/
     int rc;                     /* return code from various rtns     */
+    int i;                      /* Output queue slot index           */
     int selectcount;            /* Count of reasons select() returned*/
     int tempfd;                 /* FileDesc to accept connections    */
     int writecont;              /* Write contention active           */
@@ -1424,7 +1651,6 @@ static void *tcpnje_thread(void *vtn)
     int maxfd;                  /* highest FD for select             */
     int tn_shutdown;            /* Thread shutdown internal flag     */
     int init_signaled;          /* Thread initialisation signaled    */
-    int TTBlength = 0;          /* Length of TTB in host byte order  */
     int eintrcount = 0;         /* Number of times EINTR occured     */
     int errorcount067 = 0;      /* Number of times HHCTN067E issued  */
     int errorcount100 = 0;      /* Number of times HHCTN100E issued  */
@@ -1498,6 +1724,13 @@ static void *tcpnje_thread(void *vtn)
             case TCPNJE_PEND_IDLE:
                 break;
             case TCPNJE_PEND_READ:
+                /* RSCS has finished with any TTB it was given.  Step  */
+                /* past it to the next one in the receive ring.        */
+                if (tn->tcpinbuf.valid)
+                {
+                    tn->inblock += ntohs(((struct TTB *)tn->inblock)->length);
+                }
+
                 /* Flag that we don't have a complete buffer yet */
                 tn->tcpinbuf.valid = 0;
 
@@ -1507,6 +1740,16 @@ static void *tcpnje_thread(void *vtn)
                     tn->curpending = TCPNJE_PEND_IDLE;
                     signal_condition(&tn->ipc);
                 }
+                /* If the next TTB came in with an earlier one, it is  */
+                /* ready for RSCS now without going near the network.  */
+                else if (tcpnje_inblock(tn) > 0)
+                {
+                    tn->tcpinbuf.valid = 1;
+                    tn->inblockcount++;
+
+                    tn->curpending = TCPNJE_PEND_IDLE;
+                    signal_condition(&tn->ipc);
+                }
                 /* If we are connected but don't have any data, get some */
                 else
                 {
@@ -1526,7 +1769,7 @@ static void *tcpnje_thread(void *vtn)
                 }
                 break;
             case TCPNJE_PEND_WRITE:
-                rc = tcpnje_write(tn->sfd, &tn->tcpoutbuf, tn);
+                rc = tcpnje_writeq(tn);
                 if (rc > 0)
                 {
                     /* Write blocked.  Flag retry required. */
@@ -1569,8 +1812,18 @@ static void *tcpnje_thread(void *vtn)
                     /* Initialise output buffer pointers */
                     tn->tcpoutbuf.outptr.address = tn->tcpoutbuf.base.address;
                     tn->tcpoutbuf.inptr.address = tn->tcpoutbuf.base.address;
+                    /* Empty the output queue */
+                    for (i = 0; i < tn->buffers; i++)
+                    {
+                        tn->tcpoutq[i].outptr.address = tn->tcpoutq[i].base.address;
+                        tn->tcpoutq[i].inptr.address = tn->tcpoutq[i].base.address;
+                    }
+                    tn->outqhead = 0;
+                    tn->outqcount = 0;
                     /* Initialise input buffer pointer */
                     tn->tcpinbuf.outptr.address = tn->tcpinbuf.base.address;
+                    tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
+                    tn->inblock = tn->tcpinbuf.base.address;
                     /* Initialise input buffer valid flag */
                     tn->tcpinbuf.valid = 0;
                     /* Reset the input suspended due to FCS flag */
@@ -1597,6 +1850,9 @@ static void *tcpnje_thread(void *vtn)
                     tn->inbytecount = 0;
                     tn->outbuffcount = 0;
                     tn->outbytecount = 0;
+                    tn->inblockcount = 0;
+                    tn->outblockcount = 0;
+                    tn->statstart = time(NULL);
                     /* Reset counts of various errors */
                     errorcount067 = 0;
                     errorcount100 = 0;
@@ -1927,7 +2183,7 @@ static void *tcpnje_thread(void *vtn)
                 /* One of the causes of select() returning accounted for */
                 selectcount--;
 
-                rc = tcpnje_write(tn->sfd, &tn->tcpoutbuf, tn);
+                rc = tcpnje_writeq(tn);
                 if (rc == 0)
                 {
                     /* Write completed successfully */
@@ -2024,43 +2280,26 @@ static void *tcpnje_thread(void *vtn)
             /* One of the causes of select() returning accounted for */
             selectcount--;
 
-            rc = tcpnje_read(tn->sfd, &tn->tcpinbuf, SIZEOF_TTB, tn);
+            /* Take in as much as will fit in the receive ring.  This */
+            /* may well be several TTBs, which are then handed to     */
+            /* RSCS one after the other without further recv() calls. */
+            tcpnje_read(tn->sfd, &tn->tcpinbuf, tn->tcpinbuf.size, tn);
 
-            /* Have we read in a complete TTB yet? */
-            if (rc == 0)
-            {
-                /* We now have the exact number of bytes in the TTB.
-                   Get the size of the whole block from it.           */
-                TTBlength = ntohs(tn->tcpinbuf.base.ttb->length);
+            DBGMSG(2048, "HHCTN136D %4.4X:TCPNJE - bytes received but not yet read by RSCS %ld. Connection state %s\n",
+                    devnum, (long)(tn->tcpinbuf.inptr.address - tn->inblock), tcpnje_state_text[tn->state]);
 
-                DBGMSG(2048, "HHCTN135D %4.4X:TCPNJE incoming TTB, length %d. Connection state %s\n",
-                            devnum, TTBlength, tcpnje_state_text[tn->state]);
-            }
-
-            if (rc >= 0)
+            if ((tn->sfd >= 0) && (tcpnje_inblock(tn) > 0))
             {
-                /* We have at least the TTB and possibly more.
-                   Now ensure the block is completely read in */
-                rc = tcpnje_read(tn->sfd, &tn->tcpinbuf, TTBlength, tn);
-
-                DBGMSG(2048, "HHCTN136D %4.4X:TCPNJE - bytes required %d - read so far %ld. Connection state %s\n",
-                        devnum, TTBlength, tn->tcpinbuf.inptr.address - tn->tcpinbuf.base.address, tcpnje_state_text[tn->state]);
+                /* We have now received a complete TCPNJE buffer so advise
+                   CCW executor that there is now data available to read. */
+                tn->tcpinbuf.valid = 1;
+                tn->inblockcount++;
 
-                if (rc == 0)
-                {
-                    /* We have now received a complete TCPNJE buffer so advise
-                       CCW executor that there is now data available to read. */
-                    tn->tcpinbuf.valid = 1;
-
-                    tn->curpending = TCPNJE_PEND_IDLE;
-                    signal_condition(&tn->ipc);
-
-                    DBGMSG(2048, "HHCTN137D %4.4X:TCPNJE - TTB read complete. Connection state %s\n",
-                            devnum, tcpnje_state_text[tn->state]);
+                tn->curpending = TCPNJE_PEND_IDLE;
+                signal_condition(&tn->ipc);
 
-                    /* Prepare to receive next incoming TTB */
-                    tn->tcpinbuf.inptr.address = tn->tcpinbuf.base.address;
-                }
+                DBGMSG(2048, "HHCTN137D %4.4X:TCPNJE - TTB read complete. Connection state %s\n",
+                        devnum, tcpnje_state_text[tn->state]);
             }
         }
 
@@ -2429,6 +2668,7 @@ static int tcpnje_init_handler(DEVBLK *dev, int argc, char *argv[])
         tn->trace = TCPNJE_DEFAULT_TRACE;      /* Trace level bitmask */
         tn->maxidlewrites = TCPNJE_DEFAULT_KEEPALIVE;
         dev->bufsize = TCPNJE_DEFAULT_BUFSIZE;
+        tn->buffers = TCPNJE_DEFAULT_BUFFERS;
         tn->listen = TCPNJE_DEFAULT_LISTEN;
         tn->connect = TCPNJE_DEFAULT_CONNECT;
 
@@ -2612,7 +2852,7 @@ static int tcpnje_init_handler(DEVBLK *dev, int argc, char *argv[])
                     tn->trace = atoi(res.text);
                     break;
                 case TCPNJE_KW_BUFSIZE:
-                    if (atoi(res.text) < 1024)
+                    if ((atoi(res.text) < 1024) || (atoi(res.text) > TCPNJE_MAX_BUFSIZE))
                     {
                         msg013e(tn, "BUFSIZE", res.text);
                         errcnt++;
@@ -2626,6 +2866,15 @@ static int tcpnje_init_handler(DEVBLK *dev, int argc, char *argv[])
                 case TCPNJE_KW_CONNECT:
                     tn->connect = atoi(res.text);
                     break;
+                case TCPNJE_KW_BUFFERS:
+                    if ((atoi(res.text) < 1) || (atoi(res.text) > TCPNJE_MAX_BUFFERS))
+                    {
+                        msg013e(tn, "BUFFERS", res.text);
+                        errcnt++;
+                        break;
+                    }
+                    tn->buffers = atoi(res.text);
+                    break;
                 default:
                     break;
             }
@@ -2774,7 +3023,8 @@ static int tcpnje_init_handler(DEVBLK *dev, int argc, char *argv[])
             return -1;
         }
 
-        tn->tcpinbuf.size = dev->bufsize;
+        /* The input buffer is a ring holding several TTBs */
+        tn->tcpinbuf.size = dev->bufsize * tn->buffers;
         tn->tcpinbuf.base.address = malloc(tn->tcpinbuf.size);
         if (tn->tcpinbuf.base.address == NULL)
         {
@@ -2792,6 +3042,20 @@ static int tcpnje_init_handler(DEVBLK *dev, int argc, char *argv[])
             return -1;
         }
 
+        /* Each output queue slot owns a buffer which is swapped with */
+        /* tcpoutbuf when a completed TTB is queued for sending.      */
+        for (i = 0; i < tn->buffers; i++)
+        {
+            tn->tcpoutq[i].size = dev->bufsize;
+            tn->tcpoutq[i].base.address = malloc(tn->tcpoutq[i].size);
+            if (tn->tcpoutq[i].base.address == NULL)
+            {
+                logmsg("HHCTN027E %4.4X:TCPNJE - memory allocation failure for TCPNJE TTB/TTR output buffer\n",
+                        dev->devnum);
+                return -1;
+            }
+        }
+
         dev->numsense = 2;
         memset(dev->sense, 0, sizeof(dev->sense));
 
@@ -2888,6 +3152,7 @@ static void tcpnje_query_device(DEVBLK *dev, char **class,
     struct TCPNJE *tn;
     char rnodestring[9], lnodestring[9];
     char    filename[ PATH_MAX + 1 ];
+    time_t  elapsed;
 
     tn = (struct TCPNJE *) dev->commadpt;
 
@@ -2898,7 +3163,12 @@ static void tcpnje_query_device(DEVBLK *dev, char **class,
 
     BEGIN_DEVICE_CLASS_QUERY( "LINE", dev, class, buflen, buffer);
 
-    snprintf(buffer, buflen, "TCPNJE %s %s RH=%s RP=%d RN=%s LP=%d LN=%s IN=%d OUT=%d OP=%s",
+    /* Transfer rates are averaged since the connection was set up */
+    elapsed = time(NULL) - tn->statstart;
+    if (elapsed < 1) elapsed = 1;
+
+    snprintf(buffer, buflen, "TCPNJE %s %s RH=%s RP=%d RN=%s LP=%d LN=%s IN=%"PRIu64" OUT=%"PRIu64" "
+            "TTB/S=%u/%u B/S=%"PRIu64"/%"PRIu64" OP=%s",
             tn->enabled ? "ENAB" : "DISA",
             tcpnje_state_text[tn->state],
 #if 0
@@ -2911,6 +3181,10 @@ static void tcpnje_query_device(DEVBLK *dev, char **class,
             guest_to_host_string(lnodestring, sizeof(lnodestring), tn->lnode),
             tn->inbytecount,
             tn->outbytecount,
+            (U32)(tn->inblockcount / elapsed),
+            (U32)(tn->outblockcount / elapsed),
+            tn->inbytecount / elapsed,
+            tn->outbytecount / elapsed,
             tcpnje_pendccw_text[tn->curpending]);
 }
 
@@ -2972,6 +3246,10 @@ static int tcpnje_close_device(DEVBLK *dev)
 /* in the values in the TTB at it's beginning.  Then send the        */
 /* completed TCPNJE buffer out to the TCP/IP network.                */
 /*                                                                   */
+/* The completed buffer is swapped into the next free slot of the    */
+/* output queue, so RSCS can carry on filling the slot's old buffer  */
+/* while the worker thread is still sending earlier ones.            */
+/*                                                                   */
 /* This routine should be called whenever the output buffer has got  */
 /* sufficiently full that the next record to be written may not fit  */
 /* in it.  It should be called for every record if an NJE signon has */
@@ -2984,6 +3262,8 @@ static int tcpnje_close_device(DEVBLK *dev)
 /*-------------------------------------------------------------------*/
 static void tcpnje_flush(struct TCPNJE *tn)
 {
+    struct TNBUFFER buffer, *slot;
+
     /* Increment idle writes counter in case this is one.  It will   */
     /* get cleared shortly if it turns out not to be.                */
     tn->idlewrites++;
@@ -2993,13 +3273,11 @@ static void tcpnje_flush(struct TCPNJE *tn)
     if ((tn->tcpoutbuf.inptr.address != tn->tcpoutbuf.base.address) ||
          (tn->idlewrites > tn->maxidlewrites))
     {
-        /* If the holdoutgoing flag is set, the current buffer has   */
-        /* already begun to be transmitted but has not been fully    */
-        /* sent yet.  Therefore the terminating TTR has already been */
-        /* added and the TTB has been filled in.  Just signal the    */
-        /* worker thread to have another go at completing the        */
-        /* transmission of the buffer and hope for the best.         */
-        if (!tn->holdoutgoing)
+        /* If every slot in the output queue is still waiting to be  */
+        /* sent, the current buffer can't be queued yet.  Just signal*/
+        /* the worker thread to have another go at sending the queue */
+        /* and hope for the best.                                    */
+        if (tn->outqcount < tn->buffers)
         {
             /* Add an all zeros TTR to the end of the output buffer  */
             tn->tcpoutbuf.inptr.block->record.ttr.flags = 0;
@@ -3019,6 +3297,13 @@ static void tcpnje_flush(struct TCPNJE *tn)
 
             /* Place output pointer at the start of the buffer       */
             tn->tcpoutbuf.outptr.address = tn->tcpoutbuf.base.address;
+
+            /* Queue it for sending and take over the slot's buffer  */
+            slot = &tn->tcpoutq[(tn->outqhead + tn->outqcount) % tn->buffers];
+            buffer = *slot;
+            *slot = tn->tcpoutbuf;
+            tn->tcpoutbuf = buffer;
+            tn->outqcount++;
         }
 
         /* Reset keepalive counter */
@@ -3404,8 +3689,7 @@ BYTE    signoff[] =    {0x10, 0x02, 0x90, 0x8f, 0xcf,
                     /* Point to the first record in the new buffer */
                     if (tn->tcpinbuf.valid)
                     {
-                        tn->tcpinbuf.outptr.address =
-                            tn->tcpinbuf.base.address;
+                        tn->tcpinbuf.outptr.address = tn->inblock;
                     }
 
                     /* If the I/O was halted - indicate Unit Exception */
@@ -3476,8 +3760,7 @@ BYTE    signoff[] =    {0x10, 0x02, 0x90, 0x8f, 0xcf,
                         /* Point to the first record in the new buffer    */
                         if (tn->tcpinbuf.valid)
                         {
-                            tn->tcpinbuf.outptr.address =
-                                tn->tcpinbuf.base.address;
+                            tn->tcpinbuf.outptr.address = tn->inblock;
                         }
 
                         /* If the I/O was halted - indicate Unit Exception */
@@ -4087,8 +4370,20 @@ BYTE    signoff[] =    {0x10, 0x02, 0x90, 0x8f, 0xcf,
                     /* it appears that RSCS will cope and retry the same write again */
                     /* and all will still be well, at least for some RSCS versions.  */
                     /* I'm not looking forward to trying this with a CTC though.     */
-                    DBGMSG(16, "HHCTN095E %4.4X:TCPNJE WRITE - outgoing record size %d will not fit in output buffer\n",
-                            dev->devnum, count);
+                    if (tn->holdoutgoing)
+                    {
+                        /* The output queue is full and the network has not yet  */
+                        /* taken any of it.  Hopefully this situation should not */
+                        /* arise because RSCS should already have been told to   */
+                        /* stop sending out data.                                */
+                        DBGMSG(16, "HHCTN096W %4.4X:TCPNJE WRITE - outgoing record cannot be buffered as buffer is busy\n",
+                                dev->devnum);
+                    }
+                    else
+                    {
+                        DBGMSG(16, "HHCTN095E %4.4X:TCPNJE WRITE - outgoing record size %d will not fit in output buffer\n",
+                                dev->devnum, count);
+                    }
 
                     *residual = count;
                     *unitstat = CSW_CE | CSW_DE | CSW_UC;
@@ -4097,62 +4392,46 @@ BYTE    signoff[] =    {0x10, 0x02, 0x90, 0x8f, 0xcf,
                     break;
                 }
 
-                /* If the last buffer is still in the process of being sent, this    */
-                /* record can't be put into it yet.  Hopefully this situation should */
-                /* not arise because RSCS should already have been told to stop      */
-                /* sending out data.  However, if it does, the only option is to     */
-                /* fail.  See comments just above.                                   */
+                /* tcpoutbuf is never itself being sent.  It is swapped into the     */
+                /* output queue by tcpnje_flush() so the record can always go in.    */
+                /* Put TTR header for this record into the output buffer */
+                tn->tcpoutbuf.inptr.block->record.ttr.flags = 0;
+                tn->tcpoutbuf.inptr.block->record.ttr.unused = 0;
+                tn->tcpoutbuf.inptr.block->record.ttr.length = htons(count);
 
-                if (!tn->holdoutgoing)
-                {
-                    /* Put TTR header for this record into the output buffer */
-                    tn->tcpoutbuf.inptr.block->record.ttr.flags = 0;
-                    tn->tcpoutbuf.inptr.block->record.ttr.unused = 0;
-                    tn->tcpoutbuf.inptr.block->record.ttr.length = htons(count);
+                /* Put the actual data to be written into the output buffer */
+                memcpy(&tn->tcpoutbuf.inptr.block->record.tpb, tpb, count);
+                tn->tcpoutbuf.inptr.address += SIZEOF_TTR + count;
 
-                    /* Put the actual data to be written into the output buffer */
-                    memcpy(&tn->tcpoutbuf.inptr.block->record.tpb, tpb, count);
-                    tn->tcpoutbuf.inptr.address += SIZEOF_TTR + count;
-
-                    /* Count the data to be transmitted.  Some overhead is included */
-                    /* and some data is not counted due to compression.    */
+                /* Count the data to be transmitted.  Some overhead is included */
+                /* and some data is not counted due to compression.    */
 
-                    if (count > 2)
-                    {
-                        tn->outbytecount += count;
-                        tn->outbuffcount++;
-                    }
+                if (count > 2)
+                {
+                    tn->outbytecount += count;
+                    tn->outbuffcount++;
+                }
 
-                    /* If we are not yet signed on, we must send the buffer now.     */
-                    /* Same if RSCS has send a control function, signoff for example.*/
-                    /* If we are signed on, we can accumulate records and not send   */
-                    /* until RSCS stops sending out data for the moment.  If it      */
-                    /* appears that the next record to be written might not fit in   */
-                    /* the buffer, we should send the buffer out now in order to     */
-                    /* take the opportunity to tell RSCS not to send more data out   */
-                    /* before the next write happens when it is too late.            */
-                    if ((tn->state < NJECONPRI) || (tpb->rcb == 0xf0))
-                    {
-                        tcpnje_flush(tn);
-                    }
-                    else if (tn->tcpoutbuf.inptr.address - tn->tcpoutbuf.base.address +
-                        2 * SIZEOF_TTR + tn->tpbufsize > tn->tcpoutbuf.size)
-                    {
-                        DBGMSG(2048, "HHCTN166D %4.4X:TCPNJE WRITE - Sending outgoing buffer as it is nearly full\n",
-                               dev->devnum);
-                        tcpnje_flush(tn);
-                    }
+                /* If we are not yet signed on, we must send the buffer now.     */
+                /* Same if RSCS has send a control function, signoff for example.*/
+                /* If we are signed on, we can accumulate records and not send   */
+                /* until RSCS stops sending out data for the moment.  If it      */
+                /* appears that the next record to be written might not fit in   */
+                /* the buffer, we should send the buffer out now in order to     */
+                /* take the opportunity to tell RSCS not to send more data out   */
+                /* before the next write happens when it is too late.            */
+                if ((tn->state < NJECONPRI) || (tpb->rcb == 0xf0))
+                {
+                    tcpnje_flush(tn);
                 }
-                else
+                else if (tn->tcpoutbuf.inptr.address - tn->tcpoutbuf.base.address +
+                    2 * SIZEOF_TTR + tn->tpbufsize > tn->tcpoutbuf.size)
                 {
-                    DBGMSG(16, "HHCTN096W %4.4X:TCPNJE WRITE - outgoing record cannot be buffered as buffer is busy\n",
-                            dev->devnum);
-                    *residual = count;
-                    *unitstat = CSW_CE | CSW_DE | CSW_UC;
-                    dev->sense[0] = SENSE_IR;
-                    dev->sense[1] = 0;
-                    break;
+                    DBGMSG(2048, "HHCTN166D %4.4X:TCPNJE WRITE - Sending outgoing buffer as it is nearly full\n",
+                           dev->devnum);
+                    tcpnje_flush(tn);
                 }
+
                 /* All bytes dealt with, one way or another - residual = 0 */
                 *residual = 0;
                 *unitstat = CSW_CE | CSW_DE;
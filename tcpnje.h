@@ -5,6 +5,9 @@
 
 #define TCPNJE_DEFAULT_PORT      175  /* Standard port for TCPNJE / VMNET     */
 #define TCPNJE_DEFAULT_BUFSIZE  8192  /* Default TCPNJE / VMNET buffer size   */
+#define TCPNJE_MAX_BUFSIZE     65535  /* TTB length field is only 16 bits     */
+#define TCPNJE_DEFAULT_BUFFERS     4  /* Default output queue / receive ring  */
+#define TCPNJE_MAX_BUFFERS        32  /* Maximum output queue / receive ring  */
 #define TCPNJE_DEFAULT_LISTEN      1  /* Default is to listen                 */
 #define TCPNJE_DEFAULT_CONNECT     1  /* Default is to connect                */
 
@@ -102,7 +105,7 @@ struct TNBUFFER                 /* TCP/IP input or output transfer buffer   */
     BYTE valid;                 /* Flag indicating buffer contents valid    */
 };
 
-#define TCPNJE_VERSION "TCPNJE10" /* Version of struct TCPNJE               */
+#define TCPNJE_VERSION "TCPNJE11" /* Version of struct TCPNJE               */
 
 struct TCPNJE
 {
@@ -121,11 +124,20 @@ struct TCPNJE
     struct TNBUFFER ttcpasbuf;  /* TTC structure buffer for passive opens   */
     struct TNBUFFER tcpinbuf;   /* TTB/TTR input buffer structure           */
     struct TNBUFFER tcpoutbuf;  /* TTB/TTR output buffer structure          */
+    struct TNBUFFER tcpoutq[TCPNJE_MAX_BUFFERS]; /* Completed TTBs queued   */
+                                /* for sending, each owning its storage     */
+    BYTE  *inblock;             /* Start of current TTB in tcpinbuf ring    */
+    int    buffers;             /* Output queue slots / receive ring TTBs   */
+    int    outqhead;            /* Output queue slot being sent             */
+    int    outqcount;           /* Output queue slots waiting to be sent    */
     S32    ackcount;            /* Outgoing buffers not yet ACKed count     */
     U32    inbuffcount;         /* Incoming TPbuffer count (statistics only)*/
-    U32    inbytecount;         /* Incoming data count (statistics only)    */
+    U64    inbytecount;         /* Incoming data count (statistics only)    */
     U32    outbuffcount;        /* Outgoing TPbuffer count (statistics only)*/
-    U32    outbytecount;        /* Outgoing data count (statistics only)    */
+    U64    outbytecount;        /* Outgoing data count (statistics only)    */
+    U32    inblockcount;        /* Incoming TTB count (statistics only)     */
+    U32    outblockcount;       /* Outgoing TTB count (statistics only)     */
+    time_t statstart;           /* When statistics were last reset          */
     U32    idlewrites;          /* Idle write count for keepalive purposes  */
     U32    maxidlewrites;       /* Maximum number of idle writes allowed    */
     int    pipe[2];             /* pipe used for I/O to thread signaling    */
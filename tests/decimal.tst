@@ -0,0 +1,1424 @@
+*Testcase decimal.tst: Packed decimal instructions
+
+#Testcase decimal.tst: Packed decimal instructions
+#..Runs each of AP, SP, ZAP, CP, MP, DP, SRP, ED, EDMK, CVB, CVBG,
+#..CVD and CVDG against a table of randomly generated operands, with
+#..a mix of lengths, signs, overflows, invalid digits and signs, and
+#..edit patterns.  The results, condition codes and program
+#..interruption codes are folded into a checksum; the expected values
+#..are those of the decimal.c digit string code that preceded the
+#..binary packed decimal engine.
+#
+#   Each 48 byte table entry holds:
+#
+#     +0   first operand (left aligned)       } replaced by the
+#     +16  second operand (left aligned)      } operands after execution
+#     +32  L1/L2, L1/I3 or L byte
+#     +33  condition code (from IPM)
+#     +34  program interruption code, or zero
+#     +36  SRP shift count
+#     +40  general register 1 after execution (EDMK, CVB, CVBG)
+#
+#   200  LA    R5,X'900'              Work area
+#   204  L     R3,X'A10'              Table address
+#   208  L     R4,X'A14'              Number of entries
+#   20C  MVC   0(32,R5),0(R3)         Copy operands to work area
+#   212  IC    R2,32(,R3)             Length byte for EX
+#   216  IC    R9,36(,R3)             SRP shift count
+#   21A  LGHI  R1,-1
+#   21E  BAS   R14,X'400'             Instruction being tested
+#   222  IPM   R6
+#   226  STCM  R6,B'1000',33(R3)
+#   22A  MVC   0(32,R3),0(R5)         Save operands after execution
+#   230  STG   R1,40(,R3)
+#   236  LA    R3,48(,R3)
+#   23A  BRCT  R4,X'20C'
+#   23E  LA    R8,0
+#   242  L     R10,X'A10'
+#   246  L     R11,X'A18'             Table length
+#   24A  CKSM  R8,R10                 Checksum the whole table
+#   24E  BRC   1,X'24A'
+#   252  ST    R8,X'A00'
+#   256  LPSWE X'2E0'
+#
+#   300  MVC   34(2,R3),X'8E'         Program check: save code
+#   306  B     X'22A'                   and continue with next entry
+#
+#   400  EX    R2,X'410'              Subroutine for the SS format
+#   404  BR    R14                      instructions, with the
+#   410  xx00 5000 5010                 instruction at X'410'.
+#                                       The CVB/CVD family is
+#                                       called directly at X'400'.
+
+sysclear
+archlvl z
+
+#
+# Following suppresses logging of program checks.  This test program, as part
+# of its normal operation, generates many program check messages that have no
+# value in the validation process.
+#
+ostailor quiet
+
+r    1A0=00000001800000000000000000000200
+r    1D0=00000001800000000000000000000300
+r    200=4150090058300A1058400A14D21F500030004320302043903024A719FFFF4DE0
+r    220=0400B2220060BE683021D21F30005000E3103028002441330030A746FFE94180
+r    240=000058A00A1058B00A18B241008AA714FFFE50800A00B2B202E0
+r    2E0=00020001800000000000000000000000
+r    300=D2013022008E47F0022A
+r    A10=000010000000003000000900
+
+*Testcase decimal AP
+r    400=4420041007FE00000000000000000000FA0050005010 # AP   0(0,R5),16(0,R5)
+r   1000=000000300B000000000000000000000074035343223556367846212096292300
+r   1020=4E000000000000000000000000000000
+r   1030=98093984958585760146436879420B0009348939557017381930616297000000
+r   1050=EC000000000000000000000000000000
+r   1060=00010000000300000000000000000000416C0000000000000000000000000000
+r   1080=51000000000000000000000000000000
+r   1090=999999999999999999999A000000000094641330640440084360134019557C00
+r   10B0=AE000000000000000000000000000000
+r   10C0=02200B000000000000000000000000004C000000000000000000000000000000
+r   10E0=20000000000000000000000000000000
+r   10F0=00000000000003000D0000000000000000000000000003000D00000000000000
+r   1110=88000000000000000000000000000000
+r   1120=007B0000000000000000000000000000007F0000000000000000000000000000
+r   1140=11000000000000000000000000000000
+r   1150=711418922892259617517435300D0000711418922892259617517435300C0000
+r   1170=DD000000000000000000000000000000
+r   1180=0000000000000004000000000000000C00000000000000000000000C00000000
+r   11A0=FB000000000000000000000000000000
+r   11B0=9370135B00000000000000000000000000000400000D00000000000000000000
+r   11D0=35000000000000000000000000000000
+r   11E0=000000001B00000000000000000000007038279087501F000000000000000000
+r   1200=46000000000000000000000000000000
+r   1210=000000034A00000000000000000000000000000005043C000000000000000000
+r   1230=46000000000000000000000000000000
+r   1240=97538360750479015049799A000000002576963F000000000000000000000000
+r   1260=B3000000000000000000000000000000
+r   1270=9999999C999D0000000000000000000000094F00000000000000000000000000
+r   1290=52000000000000000000000000000000
+r   12A0=C4366C000000000000000000000000004678480742117938159C000000000000
+r   12C0=29000000000000000000000000000000
+r   12D0=0000000000000000000096391F000000794377827234600619323F0000000000
+r   12F0=CA000000000000000000000000000000
+r   1300=000000097189208008610000000000000000000000000000048297985B000000
+r   1320=9C000000000000000000000000000000
+r   1330=00000000000000000000000000050000000070000000000F0000000000000000
+r   1350=D7000000000000000000000000000000
+r   1360=16186324001875059353948A000000002478333526772652393A000000000000
+r   1380=B9000000000000000000000000000000
+r   1390=0000000000000000000E00000000000000000000000000000800000000000000
+r   13B0=98000000000000000000000000000000
+r   13C0=0000004556192211723208877A000000000080000C0000000000000000000000
+r   13E0=C4000000000000000000000000000000
+r   13F0=791509088D0000000000000000000000791509088B0000000000000000000000
+r   1410=44000000000000000000000000000000
+r   1420=000000000000000000000000000200000000000B000000000000000000000000
+r   1440=D3000000000000000000000000000000
+r   1450=7794360869014260262934312808519A6950FE00000000000000000000000000
+r   1470=F2000000000000000000000000000000
+r   1480=000000000000821876100B0000000000702190580487305D0000000000000000
+r   14A0=A7000000000000000000000000000000
+r   14B0=70726776794714563183180530967C001052709F000000000000000000000000
+r   14D0=E3000000000000000000000000000000
+r   14E0=00000000000000000000000814291F009C000000000000000000000000000000
+r   1500=E0000000000000000000000000000000
+r   1510=000000000000000043904400000000000F000000000000000000000000000000
+r   1530=A0000000000000000000000000000000
+r   1540=00710C00000000000000000000000000319687984726681C0000000000000000
+r   1560=27000000000000000000000000000000
+r   1570=00000335293B0000000000000000000077662D00000000000000000000000000
+r   1590=52000000000000000000000000000000
+r   15A0=00000000729088848902889D000000000000000000000F000000000000000000
+r   15C0=B6000000000000000000000000000000
+r   15D0=000000000000000000000A0000000000316921287241440C0000000000000000
+r   15F0=A7000000000000000000000000000000
+r   1600=05184D00000000000000000000000000200000000000000C0000000000000000
+r   1620=27000000000000000000000000000000
+r   1630=535104277934213D0000000000000000999999999999999F0000000000000000
+r   1650=77000000000000000000000000000000
+r   1660=99999F0000000000000000000000000099999D00000000000000000000000000
+r   1680=22000000000000000000000000000000
+r   1690=7009779D000000000000000000000000999999999999999A0000000000000000
+r   16B0=37000000000000000000000000000000
+r   16C0=000000000008389366186B000000000099999999999999999999999999999100
+r   16E0=AE000000000000000000000000000000
+r   16F0=999999999999999999999999999C000099999999999999999C00000000000000
+r   1710=D8000000000000000000000000000000
+r   1720=9670844B00000000000000000000000075448504468702757427912642459200
+r   1740=3E000000000000000000000000000000
+r   1750=0000000363034115978A0000000000000000000363034115978A000000000000
+r   1770=99000000000000000000000000000000
+r   1780=0000000000000000000000000000000099999E00000000000000000000000000
+r   17A0=92000000000000000000000000000000
+r   17B0=834987942675FA000000000000000000834987942675FD000000000000000000
+r   17D0=66000000000000000000000000000000
+r   17E0=05372926460004690390652D000000000000000000000000000D000000000000
+r   1800=B9000000000000000000000000000000
+r   1810=0353453587076755592793475402425C00000281289902836F00000000000000
+r   1830=F8000000000000000000000000000000
+r   1840=00000A0000000000000000000000000000000000000000000C00000000000000
+r   1860=28000000000000000000000000000000
+r   1870=000000000000000000000000000D0000000000000C0000000000000000000000
+r   1890=D4000000000000000000000000000000
+r   18A0=243C0000000000000000000000000000243D0000000000000000000000000000
+r   18C0=11000000000000000000000000000000
+r   18D0=124165612822435C00000000000000000000000046941E000000000000000000
+r   18F0=76000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "AP checksum" E5301093
+*Done
+
+*Testcase decimal SP
+r    400=4420041007FE00000000000000000000FB0050005010 # SP   0(0,R5),16(0,R5)
+r   1000=0000000000100D00000000000000000099999999999999999999999B00000000
+r   1020=6B000000000000000000000000000000
+r   1030=7853753663167A00000000000000000004663616607D00000000000000000000
+r   1050=65000000000000000000000000000000
+r   1060=0A0000000000000000000000000000000C000000000000000000000000000000
+r   1080=00000000000000000000000000000000
+r   1090=65972784280110958F0000000000000003000D00000000000000000000000000
+r   10B0=82000000000000000000000000000000
+r   10C0=24561088570345142473618531420C005347B8985B0000000000000000000000
+r   10E0=E4000000000000000000000000000000
+r   10F0=00003813212515073588327B000000000000000000000000000740309B000000
+r   1110=BC000000000000000000000000000000
+r   1120=999C000000000000000000000000000006749270049119758D00000000000000
+r   1140=18000000000000000000000000000000
+r   1150=000000000000000000000000000C00003322B37C000000000000000000000000
+r   1170=D3000000000000000000000000000000
+r   1180=582972110799991A0000000000000000582972110799991A0000000000000000
+r   11A0=77000000000000000000000000000000
+r   11B0=000A00000000000000000000000000000000050D000000000000000000000000
+r   11D0=13000000000000000000000000000000
+r   11E0=9999999999999999999999999999999E999999999999999A0000000000000000
+r   1200=F7000000000000000000000000000000
+r   1210=3484062499579A000000000000000000205706050306276126745D0000000000
+r   1230=6A000000000000000000000000000000
+r   1240=8743680081074759425732716D000000745621838E0000000000000000000000
+r   1260=C4000000000000000000000000000000
+r   1270=024C000000000000000000000000000099999999999999999999999D00000000
+r   1290=1B000000000000000000000000000000
+r   12A0=9277422227670C0000000000000000000050243263352955653944486220618E
+r   12C0=6F000000000000000000000000000000
+r   12D0=99999999999F0000000000000000000099999999999D00000000000000000000
+r   12F0=55000000000000000000000000000000
+r   1300=429289609591238402065838723B00009999999999999999999999999A000000
+r   1320=DC000000000000000000000000000000
+r   1330=000000570155951017643432832A0000000000570155951017643432832C0000
+r   1350=DD000000000000000000000000000000
+r   1360=96594595268836004533521A000000003D000000000000000000000000000000
+r   1380=B0000000000000000000000000000000
+r   1390=7516665619144871632C0000000000007516665619144871632C000000000000
+r   13B0=99000000000000000000000000000000
+r   13C0=0000012452139B02590E0000000000008323716262689B000000000000000000
+r   13E0=96000000000000000000000000000000
+r   13F0=0000087C0000000000000000000000002D000000000000000000000000000000
+r   1410=30000000000000000000000000000000
+r   1420=8902435371103D0000000000000000008902435371103B000000000000000000
+r   1440=66000000000000000000000000000000
+r   1450=00020F00000000000000000000000000011129640028176A0000000000000000
+r   1470=27000000000000000000000000000000
+r   1480=5799359227640833027758841745446D825316989872543800536D0000000000
+r   14A0=FA000000000000000000000000000000
+r   14B0=42869481814C0000000000000000000042869481814F00000000000000000000
+r   14D0=55000000000000000000000000000000
+r   14E0=54471D00000000000000000000000000348968952671356F0000000000000000
+r   1500=27000000000000000000000000000000
+r   1510=00000000000600000F0000000000000000000000000600000D00000000000000
+r   1530=88000000000000000000000000000000
+r   1540=0000448180703559374A000000000000000000001B0000000000000000000000
+r   1560=94000000000000000000000000000000
+r   1570=000000000B0000000000000000000000000000000000898611011373530C0000
+r   1590=4D000000000000000000000000000000
+r   15A0=000000000000005A000000000000000029807216762980392D00000000000000
+r   15C0=78000000000000000000000000000000
+r   15D0=0000000000000000000E0000000000000000000300000F000000000000000000
+r   15F0=96000000000000000000000000000000
+r   1600=0000000000000000000B00000000000099999999999F00000000000000000000
+r   1620=95000000000000000000000000000000
+r   1630=0575630000000000000000000000000005756B00000000000000000000000000
+r   1650=22000000000000000000000000000000
+r   1660=0000000040000D0000000000000000009999999999999C000000000000000000
+r   1680=66000000000000000000000000000000
+r   1690=011C0000000000000000000000000000011C0000000000000000000000000000
+r   16B0=11000000000000000000000000000000
+r   16C0=170456889967377119275029517E0000001266131153691158562130808C0000
+r   16E0=DD000000000000000000000000000000
+r   16F0=000000000000000B0000000000000000000000000000000D0000000000000000
+r   1710=77000000000000000000000000000000
+r   1720=0000000B0000000000000000000000000000000000000000100000000E000000
+r   1740=3C000000000000000000000000000000
+r   1750=00000000000000075B00000000000000000000000000000B0000000000000000
+r   1770=87000000000000000000000000000000
+r   1780=623C000000000000000000000000000000036815589058635504472156864700
+r   17A0=1E000000000000000000000000000000
+r   17B0=0055350C0000000000000000000000000055350E000000000000000000000000
+r   17D0=33000000000000000000000000000000
+r   17E0=9999999999999D00000000000000000099999999999999999999999999999D00
+r   1800=6E000000000000000000000000000000
+r   1810=02485607265884897D00000000000000374786855473953670732586151D0000
+r   1830=8D000000000000000000000000000000
+r   1840=14213731397815057F00000000000000745221600972389037974038EB000000
+r   1860=8C000000000000000000000000000000
+r   1870=00000000000058228868945F0000000050694C00000000000000000000000000
+r   1890=B2000000000000000000000000000000
+r   18A0=7672411E000000000000000000000000829861608472347374909A0000000000
+r   18C0=3A000000000000000000000000000000
+r   18D0=853418354980206976406331475D000000700C00000000000000000000000000
+r   18F0=D2000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "SP checksum" B2CB20BA
+*Done
+
+*Testcase decimal ZAP
+r    400=4420041007FE00000000000000000000F80050005010 # ZAP  0(0,R5),16(0,R5)
+r   1000=892649699C000000000000000000000067382102997838827967139D00000000
+r   1020=4B000000000000000000000000000000
+r   1030=6225319346289F000000000000000000000000078783633998928580617C0000
+r   1050=6D000000000000000000000000000000
+r   1060=0000235732386229783013642D00000000000000076363430F00000000000000
+r   1080=C8000000000000000000000000000000
+r   1090=99999999999999999999999999999A000007204463263C000000000000000000
+r   10B0=E6000000000000000000000000000000
+r   10C0=422032279671582E732049482731183F0050000D000000000000000000000000
+r   10E0=F3000000000000000000000000000000
+r   10F0=11321263625F0000000000000000000099999999999999999F00000000000000
+r   1110=58000000000000000000000000000000
+r   1120=819C0000000000000000000000000000000100000000000000000A0000000000
+r   1140=1A000000000000000000000000000000
+r   1150=000F00000000000000000000000000009999999999999999999999999999999A
+r   1170=1F000000000000000000000000000000
+r   1180=9999999999999A0000000000000000000000000A000000000000000000000000
+r   11A0=63000000000000000000000000000000
+r   11B0=2833940379693C00000000000000000064818D00000000000000000000000000
+r   11D0=62000000000000000000000000000000
+r   11E0=1773501405780233636582801A00000000700E00000000000000000000000000
+r   1200=C2000000000000000000000000000000
+r   1210=4A0000000000000000000000000000000000000000000000000000000000000B
+r   1230=0F000000000000000000000000000000
+r   1240=652365245E00000000000000000000005852019330672821989297570C000000
+r   1260=4C000000000000000000000000000000
+r   1270=999999999999999999999999999C00000000002281105E000000000000000000
+r   1290=D6000000000000000000000000000000
+r   12A0=04377523491E00000000000000000000000000000000000A0000000000000000
+r   12C0=57000000000000000000000000000000
+r   12D0=610657801933892F0000000000000000000179771046131767614751338F0000
+r   12F0=7D000000000000000000000000000000
+r   1300=9999999A0000000000000000000000000000000000000000000033340712039D
+r   1320=3F000000000000000000000000000000
+r   1330=000000000947413230863C000000000016236304152C00000000000000000000
+r   1350=A5000000000000000000000000000000
+r   1360=00000000000D00000000000000000000000000000003745B0000000000000000
+r   1380=57000000000000000000000000000000
+r   1390=0000000000000008608679631D0000000000339477863E000000000000000000
+r   13B0=C6000000000000000000000000000000
+r   13C0=00000084404622841544395B000000000000AB00000000000000000000000000
+r   13E0=B2000000000000000000000000000000
+r   13F0=000005000000000000000000000D0000000005000000000000000000000F0000
+r   1410=DD000000000000000000000000000000
+r   1420=5668539679459373035545728E00000099999999999999999999999999999900
+r   1440=CE000000000000000000000000000000
+r   1450=00000001560095910A0000000000000000000001560095910B00000000000000
+r   1470=88000000000000000000000000000000
+r   1480=99999999999D0000000000000000000072028503490027207C00000000000000
+r   14A0=58000000000000000000000000000000
+r   14B0=8F0000000000000000000000000000005963044A000000000000000000000000
+r   14D0=03000000000000000000000000000000
+r   14E0=832491695D000000000000000000000000000000070000000B00000000000000
+r   1500=48000000000000000000000000000000
+r   1510=00100C0000000000000000000000000000DC0000000000000000000000000000
+r   1530=21000000000000000000000000000000
+r   1540=00003001412D00000000000000000000000F0000000000000000000000000000
+r   1560=51000000000000000000000000000000
+r   1570=0000000000000000000000004D0000002317998070727861018578166C000000
+r   1590=CC000000000000000000000000000000
+r   15A0=000000000000000000000000000A0000622799188302256819354E0000000000
+r   15C0=DA000000000000000000000000000000
+r   15D0=000000009000000000000000000C00000000000000000002000000000E000000
+r   15F0=DC000000000000000000000000000000
+r   1600=00000040971A0000000000000000000000000047857F00000000000000000000
+r   1620=55000000000000000000000000000000
+r   1630=600000000000000000000000000C000090230017121A00000000000000000000
+r   1650=D5000000000000000000000000000000
+r   1660=99999999999992000000000000000000FC000000000000000000000000000000
+r   1680=60000000000000000000000000000000
+r   1690=000000082599167E000000000000000077675409613D00000000000000000000
+r   16B0=75000000000000000000000000000000
+r   16C0=481131159674892D00000000000000004851354006047C000000000000000000
+r   16E0=76000000000000000000000000000000
+r   16F0=9A00000000000000000000000000000099999999999999999999999999999D00
+r   1710=0E000000000000000000000000000000
+r   1720=00000000000000000000000000000D000000000000001C000000000000000000
+r   1740=E6000000000000000000000000000000
+r   1750=0000000020000000A0000000000C0000691A0000000000000000000000000000
+r   1770=D1000000000000000000000000000000
+r   1780=00040000000000000000000B0000000000040000000000000000000C00000000
+r   17A0=BB000000000000000000000000000000
+r   17B0=62101661115868394201649E0000000000000000000000000000000000060D00
+r   17D0=BE000000000000000000000000000000
+r   17E0=0000000000000000000000000800000F99999999999C00000000000000000000
+r   1800=F5000000000000000000000000000000
+r   1810=00006A0000000000000000000000000000006C00000000000000000000000000
+r   1830=22000000000000000000000000000000
+r   1840=03713779139631556460255D0000000000000000090000000F00000000000000
+r   1860=B8000000000000000000000000000000
+r   1870=DB000000000000000000000000000000606637861460648759067D0000000000
+r   1890=0A000000000000000000000000000000
+r   18A0=88636329666B000000000000000000002D000000000000000000000000000000
+r   18C0=50000000000000000000000000000000
+r   18D0=4260031C0000000000000000000000004260031D000000000000000000000000
+r   18F0=33000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "ZAP checksum" 1F1454B8
+*Done
+
+*Testcase decimal CP
+r    400=4420041007FE00000000000000000000F90050005010 # CP   0(0,R5),16(0,R5)
+r   1000=91675171239003129842696399315D000000000000050A000000000000000000
+r   1020=E6000000000000000000000000000000
+r   1030=00000000000000000000000000000C000000000000000D000000000000000000
+r   1050=E6000000000000000000000000000000
+r   1060=00002D000000000000000000000000000000000741270540839D000000000000
+r   1080=29000000000000000000000000000000
+r   1090=6077518205438174622458909F000000096266449B0000000000000000000000
+r   10B0=C4000000000000000000000000000000
+r   10C0=060C00000000000000000000000000001705239761409881902285084D000000
+r   10E0=1C000000000000000000000000000000
+r   10F0=07436F000000000000000000000000005498417760470228193B000000000000
+r   1110=29000000000000000000000000000000
+r   1120=115742755418614427585F0000000000115742755418614427585C0000000000
+r   1140=AA000000000000000000000000000000
+r   1150=0000000000000000000000000000000A00000145148C00000000000000000000
+r   1170=F5000000000000000000000000000000
+r   1180=0000000000000C00000000000000000094523746334939751246358C00000000
+r   11A0=6B000000000000000000000000000000
+r   11B0=4391799798513010583E00000000000000001000000000000D00000000000000
+r   11D0=98000000000000000000000000000000
+r   11E0=9999999999999999999999999D0000000000000003000C000000000000000000
+r   1200=C6000000000000000000000000000000
+r   1210=0000000000000000000070000B00000005000C00000000000000000000000000
+r   1230=C2000000000000000000000000000000
+r   1240=9999999C0000000000000000000000000000000000000000000C000000000000
+r   1260=39000000000000000000000000000000
+r   1270=000000000000000000000000000C00006728892136235707045127666C000000
+r   1290=DC000000000000000000000000000000
+r   12A0=000000000000005097968C00000000000B000000000000000000000000000000
+r   12C0=A0000000000000000000000000000000
+r   12D0=0000085282804968701429219C0000000000085282804968701429219C000000
+r   12F0=CC000000000000000000000000000000
+r   1300=00000000000000000000000000000D00288803572F0000000000000000000000
+r   1320=E4000000000000000000000000000000
+r   1330=0000000F00000000000000000000000000020D00000000000000000000000000
+r   1350=32000000000000000000000000000000
+r   1360=67862225717618328856569182759D00778314549648900528872280258C0000
+r   1380=ED000000000000000000000000000000
+r   1390=0000000000000000000E0000000000002314169937229140670934192854831E
+r   13B0=9F000000000000000000000000000000
+r   13C0=91940045815D00000000000000000000040C0000000000000000000000000000
+r   13E0=51000000000000000000000000000000
+r   13F0=0000000772469365410651277D0000000000000772469365410651277D000000
+r   1410=CC000000000000000000000000000000
+r   1420=030000000000000000000C00000000000000003329073393117944308C000000
+r   1440=AC000000000000000000000000000000
+r   1450=1D00000000000000000000000000000005617D00000000000000000000000000
+r   1470=02000000000000000000000000000000
+r   1480=5021810322110687110C000000000000599A0000000000000000000000000000
+r   14A0=91000000000000000000000000000000
+r   14B0=99999999999999999E000000000000000008953865844A000000000000000000
+r   14D0=86000000000000000000000000000000
+r   14E0=1388718D00000000000000000000000036509020156110092854431300327907
+r   1500=3F000000000000000000000000000000
+r   1510=0000007B00000000000000000000000000000032950252048C00000000000000
+r   1530=38000000000000000000000000000000
+r   1540=7000000000000000000000000E0000000000000007441034025679923120929C
+r   1560=CF000000000000000000000000000000
+r   1570=7C00000000000000000000000000000040575181565212335279591947319A00
+r   1590=0E000000000000000000000000000000
+r   15A0=82128450439249421165550850947A0082128450439249421165550850947E00
+r   15C0=EE000000000000000000000000000000
+r   15D0=52356E0000000000000000000000000078769639176169644C00000000000000
+r   15F0=28000000000000000000000000000000
+r   1600=0000000078994A0000000000000000000053207428515774322574772D000000
+r   1620=6C000000000000000000000000000000
+r   1630=21880532374037752D00000000000000000000000E0000000000000000000000
+r   1650=84000000000000000000000000000000
+r   1660=0000000000060C000000000000000000599012631454883258045846267B0000
+r   1680=6D000000000000000000000000000000
+r   1690=999999999999999C0000000000000000999999999999999D0000000000000000
+r   16B0=77000000000000000000000000000000
+r   16C0=870C0000000000000000000000000000870C0000000000000000000000000000
+r   16E0=11000000000000000000000000000000
+r   16F0=0021470160467160994E0000000000000021470160467160994F000000000000
+r   1710=99000000000000000000000000000000
+r   1720=74248237935550733376554D00000000087C0000000000000000000000000000
+r   1740=B1000000000000000000000000000000
+r   1750=000000000000000000000000000C0000000000000000061403512C0000000000
+r   1770=DA000000000000000000000000000000
+r   1780=8355083365429613014845079143030E00060213245173773B00000000000000
+r   17A0=F8000000000000000000000000000000
+r   17B0=000B0000000000000000000000000000381148880019978C0000000000000000
+r   17D0=17000000000000000000000000000000
+r   17E0=00000000000000000000000F000000009A000000000000000000000000000000
+r   1800=B0000000000000000000000000000000
+r   1810=8233171645183D00000000000000000002395D00000000000000000000000000
+r   1830=62000000000000000000000000000000
+r   1840=227414541693262146494F000000000000000034F90E00000000000000000000
+r   1860=A5000000000000000000000000000000
+r   1870=00000000000000000425033427353D00999999999999999999999B0000000000
+r   1890=EA000000000000000000000000000000
+r   18A0=3780113C0000000000000000000000003780113E000000000000000000000000
+r   18C0=33000000000000000000000000000000
+r   18D0=00000000000000000D0000000000000021026873976A00000000000000000000
+r   18F0=85000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "CP checksum" ED34A4FE
+*Done
+
+*Testcase decimal MP
+r    400=4420041007FE00000000000000000000FC0050005010 # MP   0(0,R5),16(0,R5)
+r   1000=000000000000000000000000000002002D000000000000000000000000000000
+r   1020=E0000000000000000000000000000000
+r   1030=0000000000000A00000000000000000099999999999A00000000000000000000
+r   1050=65000000000000000000000000000000
+r   1060=00000A000000000000000000000000005D000000000000000000000000000000
+r   1080=20000000000000000000000000000000
+r   1090=0000000000000000000000000008602F021023117986878D0000000000000000
+r   10B0=F7000000000000000000000000000000
+r   10C0=00000000000000904037711393919A001C000000000000000000000000000000
+r   10E0=E0000000000000000000000000000000
+r   10F0=0000000000000000003D00000000000030683D00000000000000000000000000
+r   1110=92000000000000000000000000000000
+r   1120=00000D000000000000000000000000001D000000000000000000000000000000
+r   1140=20000000000000000000000000000000
+r   1150=00000000000000000000000008000000000000000000000E0000000000000000
+r   1170=C7000000000000000000000000000000
+r   1180=00000000000000004700000000000000000000000000387D0000000000000000
+r   11A0=87000000000000000000000000000000
+r   11B0=0000000000080D000000000000000000001B0000000000000000000000000000
+r   11D0=61000000000000000000000000000000
+r   11E0=00000000000000000000000999999D00230523049F0000000000000000000000
+r   1200=E4000000000000000000000000000000
+r   1210=0000000000261983165D000000000000831857465F0000000000000000000000
+r   1230=94000000000000000000000000000000
+r   1240=00000000000000000000000000008C00000000000C0000000000000000000000
+r   1260=E4000000000000000000000000000000
+r   1270=00000000000000000A00000000000000596923559055134C0000000000000000
+r   1290=87000000000000000000000000000000
+r   12A0=00000000000A000000000000000000003851339C000000000000000000000000
+r   12C0=53000000000000000000000000000000
+r   12D0=0000000000000000000000000000001C7710384892782C000000000000000000
+r   12F0=F6000000000000000000000000000000
+r   1300=0000000D00000000000000000000000099999D00000000000000000000000000
+r   1320=32000000000000000000000000000000
+r   1330=00000000000000002D000000000000000000000000000E000000000000000000
+r   1350=86000000000000000000000000000000
+r   1360=00000000000000000008826516501D00918677945F0000000000000000000000
+r   1380=E4000000000000000000000000000000
+r   1390=000065650231379478003A0000000000497D0000000000000000000000000000
+r   13B0=A1000000000000000000000000000000
+r   13C0=000000000000000000008C0000000000969E0000000000000000000000000000
+r   13E0=A1000000000000000000000000000000
+r   13F0=0000000000000005707D0000000000006F000000000000000000000000000000
+r   1410=90000000000000000000000000000000
+r   1420=0000000000999D000000000000000000999B0000000000000000000000000000
+r   1440=61000000000000000000000000000000
+r   1450=00000000000000000000000B0000000000000000092C00000000000000000000
+r   1470=B5000000000000000000000000000000
+r   1480=00000000068794842B000000000000009F000000000000000000000000000000
+r   14A0=80000000000000000000000000000000
+r   14B0=00000000000000000000057C0000000099999D00000000000000000000000000
+r   14D0=B2000000000000000000000000000000
+r   14E0=00000000000000000000007678862E0092459270172F00000000000000000000
+r   1500=E5000000000000000000000000000000
+r   1510=0000000000000000000000090F000000999999999999999F0000000000000000
+r   1530=C7000000000000000000000000000000
+r   1540=00000000099999999D0000000000000000000006000000000000000000000000
+r   1560=83000000000000000000000000000000
+r   1570=00044E000000000000000000000000006D000000000000000000000000000000
+r   1590=20000000000000000000000000000000
+r   15A0=0000000000000000000000000072979A00000D00000000000000000000000000
+r   15C0=F2000000000000000000000000000000
+r   15D0=000000000000001A000000000000000004000E00000000000000000000000000
+r   15F0=72000000000000000000000000000000
+r   1600=0000000000000000000000621A0000007908444166019E000000000000000000
+r   1620=C6000000000000000000000000000000
+r   1630=0000000000000000000999999A000000649851727688355A0000000000000000
+r   1650=C7000000000000000000000000000000
+r   1660=000000000000000006000000000E00004127598D000000000000000000000000
+r   1680=D3000000000000000000000000000000
+r   1690=0000000009468944474497545544381C00006002000000000000000000000000
+r   16B0=F3000000000000000000000000000000
+r   16C0=0000000000000F00000000000000000089982198085B00000000000000000000
+r   16E0=65000000000000000000000000000000
+r   16F0=0000055759970C0000000000000000006D000000000000000000000000000000
+r   1710=60000000000000000000000000000000
+r   1720=00000000000D00000000000000000000090000000C0000000000000000000000
+r   1740=54000000000000000000000000000000
+r   1750=0000000000000211540D0000000000000000000A000000000000000000000000
+r   1770=93000000000000000000000000000000
+r   1780=0000000000000004385197288B000000999E0000000000000000000000000000
+r   17A0=C1000000000000000000000000000000
+r   17B0=0000000009413D0000000000000000005E000000000000000000000000000000
+r   17D0=60000000000000000000000000000000
+r   17E0=00000000000000000000000A00000000000000000000008C0000000000000000
+r   1800=B7000000000000000000000000000000
+r   1810=00000000000000000022354E00000000514771683493813B0000000000000000
+r   1830=B7000000000000000000000000000000
+r   1840=0000000000700000000000000000000F00000E00000000000000000000000000
+r   1860=F2000000000000000000000000000000
+r   1870=00000000000000007598551C000000006D000000000000000000000000000000
+r   1890=B0000000000000000000000000000000
+r   18A0=000000000000000000000003594D000006000000000E00000000000000000000
+r   18C0=D5000000000000000000000000000000
+r   18D0=000000000000000000000099999D000035012464768C00000000000000000000
+r   18F0=D5000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "MP checksum" FD8CE89B
+*Done
+
+*Testcase decimal DP
+r    400=4420041007FE00000000000000000000FD0050005010 # DP   0(0,R5),16(0,R5)
+r   1000=0000405915268897986948196544921F48954252216B00000000000000000000
+r   1020=F5000000000000000000000000000000
+r   1030=0000000000695130433152839441788F99999999999D00000000000000000000
+r   1050=F5000000000000000000000000000000
+r   1060=0300815157777270024722931053690E753C5B00000000000000000000000000
+r   1080=F2000000000000000000000000000000
+r   1090=0000000000084365450B000000000000959997891201889D0000000000000000
+r   10B0=97000000000000000000000000000000
+r   10C0=000000000000000000000000000E00000000055190314E000000000000000000
+r   10E0=D6000000000000000000000000000000
+r   10F0=03699C000000000000000000000000007E000000000000000000000000000000
+r   1110=20000000000000000000000000000000
+r   1120=005898457266755D00000000000000001B000000000000000000000000000000
+r   1140=70000000000000000000000000000000
+r   1150=0000000000000000628E000000000000002C0000000000000000000000000000
+r   1170=91000000000000000000000000000000
+r   1180=0093373128709682288418332340377D5D000000000000000000000000000000
+r   11A0=F0000000000000000000000000000000
+r   11B0=0000257236626643930B0000000000000000186C000000000000000000000000
+r   11D0=93000000000000000000000000000000
+r   11E0=0000000000000009999999999999999C306312524414838C0000000000000000
+r   1200=F7000000000000000000000000000000
+r   1210=0000023796144246622864083B000000616409633956487F0000000000000000
+r   1230=C7000000000000000000000000000000
+r   1240=0000544A000000000000000000000000001F0000000000000000000000000000
+r   1260=31000000000000000000000000000000
+r   1270=00000000001683342C0000000000000000000000522F00000000000000000000
+r   1290=85000000000000000000000000000000
+r   12A0=0000000000000824932097754B000000000000040000000E0000000000000000
+r   12C0=C7000000000000000000000000000000
+r   12D0=0455598E000000000000000000000000000C0000000000000000000000000000
+r   12F0=31000000000000000000000000000000
+r   1300=000000000000001383432F0000000000089606411739280E0000000000000000
+r   1320=A7000000000000000000000000000000
+r   1330=00000772071874466334127B000000000035217B6B0000000000000000000000
+r   1350=B4000000000000000000000000000000
+r   1360=0000099999999999999999999999999A350592674881661E0000000000000000
+r   1380=F7000000000000000000000000000000
+r   1390=00000000000071307106016D000000009999999999999C000000000000000000
+r   13B0=B6000000000000000000000000000000
+r   13C0=06059901079481578617093025683A000000000D000000000000000000000000
+r   13E0=E3000000000000000000000000000000
+r   13F0=071391296848037A00000000000000000009000000000E000000000000000000
+r   1410=76000000000000000000000000000000
+r   1420=00000094912238271828845473443D00000000003F0000000000000000000000
+r   1440=E4000000000000000000000000000000
+r   1450=00014314307C000000000000000000009500170C000000000000000000000000
+r   1470=53000000000000000000000000000000
+r   1480=0000000000000000000000000000000C451876187D0000000000000000000000
+r   14A0=F4000000000000000000000000000000
+r   14B0=006509178974935384966D0000000000999B0000000000000000000000000000
+r   14D0=A1000000000000000000000000000000
+r   14E0=000000074704413389930272514C00007443363C000000000000000000000000
+r   1500=D3000000000000000000000000000000
+r   1510=0000000000000009999999999E0000002E000000000000000000000000000000
+r   1530=C0000000000000000000000000000000
+r   1540=011196750040837504401C0000000000944962364995978C0000000000000000
+r   1560=A7000000000000000000000000000000
+r   1570=0036213393410D00000000000000000000001D00000000000000000000000000
+r   1590=62000000000000000000000000000000
+r   15A0=0000000000000000000000263B00000007000000000B00000000000000000000
+r   15C0=C5000000000000000000000000000000
+r   15D0=005781028786081385209636977B00004A000000000000000000000000000000
+r   15F0=D0000000000000000000000000000000
+r   1600=0000000000069C0000000000000000003E000000000000000000000000000000
+r   1620=60000000000000000000000000000000
+r   1630=00000000020047363D00000000000000000000000300000B0000000000000000
+r   1650=87000000000000000000000000000000
+r   1660=0000000000020035477090873C000000344158876415421E0000000000000000
+r   1680=C7000000000000000000000000000000
+r   1690=0000006577904052140E000000000000000000000C0000000000000000000000
+r   16B0=94000000000000000000000000000000
+r   16C0=0000000000007709372449325478490056409167548D00000000000000000000
+r   16E0=E5000000000000000000000000000000
+r   16F0=00000000000000000002000000000000908C0000000000000000000000000000
+r   1710=91000000000000000000000000000000
+r   1720=0661886721839A00000000000000000022000000000000000000000000000000
+r   1740=60000000000000000000000000000000
+r   1750=000D00000000009D00000000000000000000000B00000A000000000000000000
+r   1770=76000000000000000000000000000000
+r   1780=0006069166262792003825858865816F370770568216738D0000000000000000
+r   17A0=F7000000000000000000000000000000
+r   17B0=00000000000000000000000D00000000418122957D0000000000000000000000
+r   17D0=B4000000000000000000000000000000
+r   17E0=00000059412305922B0000000000000090005A00000000000000000000000000
+r   1800=82000000000000000000000000000000
+r   1810=0725845935598019144D000000000000000000000000071D0000000000000000
+r   1830=97000000000000000000000000000000
+r   1840=00000045222014163168327E00000000999999999999999F0000000000000000
+r   1860=B7000000000000000000000000000000
+r   1870=0000000000000000002186979C00000079841636434B00000000000000000000
+r   1890=C5000000000000000000000000000000
+r   18A0=000000000000000000000000070D0000000003000D0000000000000000000000
+r   18C0=D4000000000000000000000000000000
+r   18D0=0000000000000000000000000455000000000000000000000000000000000000
+r   18F0=D4000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "DP checksum" D7EFE987
+*Done
+
+*Testcase decimal SRP
+r    400=4420041007FE00000000000000000000F00050009000 # SRP  0(0,R5),0(R9),0
+r   1000=3756743747224575145522610151257A00000000000000000000000000000000
+r   1020=F8000000380000000000000000000000
+r   1030=999999999999999999999999999B000000000000000000000000000000000000
+r   1050=D20000003F0000000000000000000000
+r   1060=000000900D000000000000000000000000000000000000000000000000000000
+r   1080=420000002D0000000000000000000000
+r   1090=00000081187783803161534D0000000000000000000000000000000000000000
+r   10B0=B6000000010000000000000000000000
+r   10C0=00068D0000000000000000000000000000000000000000000000000000000000
+r   10E0=24000000230000000000000000000000
+r   10F0=095C000000000000000000000000000000000000000000000000000000000000
+r   1110=10000000050000000000000000000000
+r   1120=4801398598605537395856000000000000000000000000000000000000000000
+r   1140=A50000000F0000000000000000000000
+r   1150=000000007000000000000D000000000000000000000000000000000000000000
+r   1170=A8000000000000000000000000000000
+r   1180=1877793271091F00000000000000000000000000000000000000000000000000
+r   11A0=640000003B0000000000000000000000
+r   11B0=49960054700116485727994D0000000000000000000000000000000000000000
+r   11D0=B30000000F0000000000000000000000
+r   11E0=0D00000000000000000000000000000000000000000000000000000000000000
+r   1200=02000000040000000000000000000000
+r   1210=00000000001000000B0000000000000000000000000000000000000000000000
+r   1230=890000001F0000000000000000000000
+r   1240=72268F0000000000000000000000000000000000000000000000000000000000
+r   1260=2E000000050000000000000000000000
+r   1270=9999999999999999999999999999999F00000000000000000000000000000000
+r   1290=F10000000D0000000000000000000000
+r   12A0=899657315833607C000000000000000000000000000000000000000000000000
+r   12C0=72000000040000000000000000000000
+r   12D0=000000000000000D000000000000000000000000000000000000000000000000
+r   12F0=780000003E0000000000000000000000
+r   1300=000C000000000000000000000000000000000000000000000000000000000000
+r   1320=11000000130000000000000000000000
+r   1330=137138853392672544825D000000000000000000000000000000000000000000
+r   1350=A8000000220000000000000000000000
+r   1360=00000D0000000000000000000000000000000000000000000000000000000000
+r   1380=24000000050000000000000000000000
+r   1390=000000000000000000060000000F000000000000000000000000000000000000
+r   13B0=D40000001D0000000000000000000000
+r   13C0=03093C0000000000000000000000000000000000000000000000000000000000
+r   13E0=23000000210000000000000000000000
+r   13F0=9999999999999999999999999999999F00000000000000000000000000000000
+r   1410=F9000000340000000000000000000000
+r   1420=00000000085676910F0000000000000000000000000000000000000000000000
+r   1440=830000003F0000000000000000000000
+r   1450=437937174060584C000000000000000000000000000000000000000000000000
+r   1470=70000000210000000000000000000000
+r   1480=7638568337666829378871425A00000000000000000000000000000000000000
+r   14A0=C2000000000000000000000000000000
+r   14B0=47816164113907132606963C0000000000000000000000000000000000000000
+r   14D0=BE000000090000000000000000000000
+r   14E0=000000000000000000500000000F000000000000000000000000000000000000
+r   1500=D10000001F0000000000000000000000
+r   1510=02026C0000000000000000000000000000000000000000000000000000000000
+r   1530=25000000080000000000000000000000
+r   1540=00000000046398835333C91F0000000000000000000000000000000000000000
+r   1560=B30000003A0000000000000000000000
+r   1570=999E000000000000000000000000000000000000000000000000000000000000
+r   1590=18000000030000000000000000000000
+r   15A0=00000D0000000000000000000000000000000000000000000000000000000000
+r   15C0=200000003B0000000000000000000000
+r   15D0=0073772D00000000000000000000000000000000000000000000000000000000
+r   15F0=35000000030000000000000000000000
+r   1600=9999999999999999999999999999999F00000000000000000000000000000000
+r   1620=F7000000030000000000000000000000
+r   1630=0000260E00000000000000000000000000000000000000000000000000000000
+r   1650=300000000E0000000000000000000000
+r   1660=81994D0000000000000000000000000000000000000000000000000000000000
+r   1680=23000000070000000000000000000000
+r   1690=17929961193740035592547C0000000000000000000000000000000000000000
+r   16B0=B40000003E0000000000000000000000
+r   16C0=000020000000000C000000000000000000000000000000000000000000000000
+r   16E0=720000001D0000000000000000000000
+r   16F0=99999999999999999999999A0000000000000000000000000000000000000000
+r   1710=B90000000C0000000000000000000000
+r   1720=0005223149125299581D00000000000000000000000000000000000000000000
+r   1740=900000003F0000000000000000000000
+r   1750=201408759757141113445841536D000000000000000000000000000000000000
+r   1770=D1000000000000000000000000000000
+r   1780=00000000000000000044682473543E0000000000000000000000000000000000
+r   17A0=E6000000280000000000000000000000
+r   17B0=00000009112909831099714E0000000000000000000000000000000000000000
+r   17D0=B6000000040000000000000000000000
+r   17E0=0000006000000000000F00000000000000000000000000000000000000000000
+r   1800=92000000150000000000000000000000
+r   1810=000000002C000000000000000000000000000000000000000000000000000000
+r   1830=42000000200000000000000000000000
+r   1840=0000000000008763407B00000000000000000000000000000000000000000000
+r   1860=95000000040000000000000000000000
+r   1870=999999999999999B000000000000000000000000000000000000000000000000
+r   1890=75000000210000000000000000000000
+r   18A0=03541580050593530965099C0000000000000000000000000000000000000000
+r   18C0=B30000002C0000000000000000000000
+r   18D0=5114062118652109768912752942677A00000000000000000000000000000000
+r   18F0=F3000000150000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "SRP checksum" 8C531575
+*Done
+
+*Testcase decimal ED
+r    400=4420041007FE00000000000000000000DE0050005010 # ED   0(0,R5),16(R5)
+r   1000=22F04020D920224000000000000000009045325B32461940429734E890180389
+r   1020=07000000000000000000000000000000
+r   1030=F0C3D9D920D95CD9D92040200000000021632F896427304976234507221F8979
+r   1050=0B000000000000000000000000000000
+r   1060=F02121C3C30000000000000000000000300D43747662576461765C0A05902656
+r   1080=04000000000000000000000000000000
+r   1090=40D9D9002021C3204B5C5CC3F02020202C564C757473058B9205575F91F24B46
+r   10B0=0F000000000000000000000000000000
+r   10C0=224BC34BF000000000000000000000003603335039477782906005376779773F
+r   10E0=04000000000000000000000000000000
+r   10F0=40D9202000000000000000000000000027262485520708926B83666E2E437282
+r   1110=03000000000000000000000000000000
+r   1120=5C202022F00021202020C36B00000000583291374D19399C428420927D922554
+r   1140=0C000000000000000000000000000000
+r   1150=0022206B4BD9205C22C3204B226B00200C08074510E7696806661716665B1D95
+r   1170=0F000000000000000000000000000000
+r   1180=F021D9222020D90000000000000000004483638D834277110321758195356068
+r   11A0=06000000000000000000000000000000
+r   11B0=212000000000000000000000000000008105888799705A47184F377487523E37
+r   11D0=01000000000000000000000000000000
+r   11E0=2120C3205CF040F0212020402140200096485757003B2349289A524800844750
+r   1200=0E000000000000000000000000000000
+r   1210=40204B20C3225C6B6B22F0216BC300004B4B51194126251600233688651A8002
+r   1230=0D000000000000000000000000000000
+r   1240=5C21D9222120220000000000000000001583551732542376849C11010C642837
+r   1260=06000000000000000000000000000000
+r   1270=205C2040D9210000000000000000000002634084128A665B0379B32310429911
+r   1290=05000000000000000000000000000000
+r   12A0=214B6B20200000000000000000000000743A76141E7642648314334E033C1484
+r   12C0=04000000000000000000000000000000
+r   12D0=202221C3216B000000000000000000000A993D004C7122758358875591818098
+r   12F0=05000000000000000000000000000000
+r   1300=40F020D92020F04B2020402000000000662D70853A5473669265077234A26529
+r   1320=0B000000000000000000000000000000
+r   1330=21D94BD9224B21404B204000000000005032376769495315453856389C9A8875
+r   1350=0B000000000000000000000000000000
+r   1360=0020222120202000000000000000000005586E8417898384938105798175391C
+r   1380=06000000000000000000000000000000
+r   1390=21C34020000000000000000000000000013489883056854C9711804F80227729
+r   13B0=03000000000000000000000000000000
+r   13C0=22C34B6B21220021202021400000000054644968354B71045257906349658516
+r   13E0=0B000000000000000000000000000000
+r   13F0=F04020002000D9C320206B000000000072848766027001456204937664167135
+r   1410=0A000000000000000000000000000000
+r   1420=5CF02100D9206B000000000000000000798342980E903178422E41328C97000A
+r   1440=06000000000000000000000000000000
+r   1450=205CD92220202020F0000000000000006C210345731B419013195549C9257527
+r   1470=08000000000000000000000000000000
+r   1480=4020F0F00000000000000000000000005186731567419C495800067597801519
+r   14A0=03000000000000000000000000000000
+r   14B0=222100202120000040C32000000000004344957C129F557C4377889436546806
+r   14D0=0A000000000000000000000000000000
+r   14E0=F04B20F00000000000000000000000000879060206321C688851764412566188
+r   1500=03000000000000000000000000000000
+r   1510=40202021C34B6B5C204B21200000000092566181250C958291958E169148834E
+r   1530=0B000000000000000000000000000000
+r   1540=00000000000000000000000000000000724D04961061825D6451704192513246
+r   1560=00000000000000000000000000000000
+r   1570=205C205C20D9222121D9212000000000132B651880832A3F6D29130115930840
+r   1590=0B000000000000000000000000000000
+r   15A0=4021212120C320205C00200000000000770C326E62066B042742416182375888
+r   15C0=0A000000000000000000000000000000
+r   15D0=202022000000000000000000000000004267255599499353894525028B146404
+r   15F0=02000000000000000000000000000000
+r   1600=20C320D95C40212000000000000000006A827E89513894497324302283753C21
+r   1620=07000000000000000000000000000000
+r   1630=2040F020205C200000000000000000002759013D99079831855447600537043E
+r   1650=06000000000000000000000000000000
+r   1660=00D95C5C21224B2140C3202020400000079432644267645712214330281C9452
+r   1680=0D000000000000000000000000000000
+r   1690=404022C320F0F022000000000000000071742C26456C414E802D3843992B5D72
+r   16B0=07000000000000000000000000000000
+r   16C0=0040200000000000000000000000000089053315533B250791430F66250B574D
+r   16E0=02000000000000000000000000000000
+r   16F0=40202020406B004B00000000000000009646724A00326D3170463300446E3566
+r   1710=07000000000000000000000000000000
+r   1720=40D95C2021210020F02122202000000063295294559F335198889C1D85804011
+r   1740=0C000000000000000000000000000000
+r   1750=5C4BF020C320D9402122000000000000722D5755475956288674505134058793
+r   1770=09000000000000000000000000000000
+r   1780=226B6B21F02020205C5CF0202000000090032D92407694279446606032808B17
+r   17A0=0C000000000000000000000000000000
+r   17B0=F0216B5C202220D920D92020C340222227769330503A7A826846376217E15D65
+r   17D0=0F000000000000000000000000000000
+r   17E0=F02020212020C35C21D9D92020225C20680753400C88833150572256F140309C
+r   1800=0F000000000000000000000000000000
+r   1810=2100200021C300000000000000000000823419320A9C5797001244806C8D3114
+r   1830=05000000000000000000000000000000
+r   1840=40204020D920C30000000000000000000C3B478F172A747303434B667007912F
+r   1860=06000000000000000000000000000000
+r   1870=F0402021200000000000000000000000813502220D68421B5B1033763E4633FD
+r   1890=04000000000000000000000000000000
+r   18A0=20F020206B202100000000000000000035631B073E0860388F963D968C749693
+r   18C0=06000000000000000000000000000000
+r   18D0=5CF02022F0C3224B000000000000000017206B377684709558524F714C28307B
+r   18F0=07000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "ED checksum" BAA229B3
+*Done
+
+*Testcase decimal EDMK
+r    400=4420041007FE00000000000000000000DF0050005010 # EDMK 0(0,R5),16(R5)
+r   1000=40C322C3210000000000000000000000145A616309553801915305393931924F
+r   1020=04000000000000000000000000000000
+r   1030=405CC34B22F0204000C320C35C000000229251612E817651897218171681281F
+r   1050=0C000000000000000000000000000000
+r   1060=5CC300000000000000000000000000002009094736962C09785412314916059B
+r   1080=01000000000000000000000000000000
+r   1090=22F000C3200000000000000000000000746511931526104472743D031299685D
+r   10B0=04000000000000000000000000000000
+r   10C0=2020204B204B00F020205C000000000057262264288113300569513B4E376032
+r   10E0=0A000000000000000000000000000000
+r   10F0=21214021206B0000200000000000000026158546569ED2750317428F568A2253
+r   1110=08000000000000000000000000000000
+r   1120=00F0224020205C5C22D96B00000000009841836B9383026B12855B20E2182603
+r   1140=0A000000000000000000000000000000
+r   1150=200000000000000000000000000000002C595B094052163458401E6775545675
+r   1170=00000000000000000000000000000000
+r   1180=2221F0F021205CC30000000000000000540411831D41816E2766756061206A21
+r   11A0=07000000000000000000000000000000
+r   11B0=4020202000202020214020D94B6B200021386794947A40986675492C72666716
+r   11D0=0E000000000000000000000000000000
+r   11E0=2100000000000000000000000000000087962249621974935666785995672805
+r   1200=00000000000000000000000000000000
+r   1210=4040C3F020000000000000000000000089811072888D46FE7C83889E9B033083
+r   1230=04000000000000000000000000000000
+r   1240=5C5C200000000000000000000000000023895B270654207696747B7C17872759
+r   1260=02000000000000000000000000000000
+r   1270=200020212020D9C320210000000000004007642E798693993F037380513B6620
+r   1290=09000000000000000000000000000000
+r   12A0=5C5CC300205C5C6B2000000000000000649458158051509F981280399812574D
+r   12C0=08000000000000000000000000000000
+r   12D0=40C320000000000000000000000000009306648454446762056E92094F06707D
+r   12F0=02000000000000000000000000000000
+r   1300=5C2000000000000000000000000000007B176372E01775271359560183459377
+r   1320=01000000000000000000000000000000
+r   1330=22204B200000000000000000000000001050370702743237111B3E7420870848
+r   1350=03000000000000000000000000000000
+r   1360=2220204B40202120204020D95C0000004A9A8759001711683309524616C55752
+r   1380=0C000000000000000000000000000000
+r   1390=40004B2120D96BC3202120206B4000008E82417E1523955741155D4918510091
+r   13B0=0D000000000000000000000000000000
+r   13C0=5C5C214B0000000000000000000000007100341510162908727E792905669405
+r   13E0=03000000000000000000000000000000
+r   13F0=00200000F020212240200000000000003929842F94609535794035679C6C3565
+r   1410=09000000000000000000000000000000
+r   1420=406B2000000000000000000000000000182013033314587962099C3908237893
+r   1440=02000000000000000000000000000000
+r   1450=402021214BF0204020F0214BC32020228082211220035E0187B0931250708325
+r   1470=0F000000000000000000000000000000
+r   1480=22225C20F0202020D9200000000000007127918F9597304808068723484E504C
+r   14A0=09000000000000000000000000000000
+r   14B0=004021002020F02021206B20000000004699001C75893511292E099311785069
+r   14D0=0B000000000000000000000000000000
+r   14E0=402020F02020C3205CD920206BF00000677C381259508364159B682999673479
+r   1500=0D000000000000000000000000000000
+r   1510=21F02021D92221204BD94020D900000007691498061B2484516668811891571A
+r   1530=0C000000000000000000000000000000
+r   1540=5C402020D9202040D92120212021000044008835837230066935674202900389
+r   1560=0D000000000000000000000000000000
+r   1570=224BC3000000000000000000000000000F86168C1E4B01253701697970344425
+r   1590=02000000000000000000000000000000
+r   15A0=F0402020D92020202000000000000000781C5843040541767482771023029418
+r   15C0=08000000000000000000000000000000
+r   15D0=206B2020202020214BD90000000000007D887197128610185E41452080342129
+r   15F0=09000000000000000000000000000000
+r   1600=22F02021404B2220202120C3200000003B33503696000435168131169A6B0420
+r   1620=0D000000000000000000000000000000
+r   1630=002021D900004BC320C320000000000082660769269596431332122579013C6B
+r   1650=0A000000000000000000000000000000
+r   1660=204B20F0200000000000000000000000280178034687784D0D1E7D95817B819B
+r   1680=04000000000000000000000000000000
+r   1690=40D920D9D9220000000000000000000035997CB1339520830107129B95958283
+r   16B0=05000000000000000000000000000000
+r   16C0=212022202020202020C34BC3C3200000218A5055227963150296801152099F3D
+r   16E0=0D000000000000000000000000000000
+r   16F0=2021C3D92000D920C3216B00000000003794352A588022304D567497632F4895
+r   1710=0A000000000000000000000000000000
+r   1720=5C000000000000000000000000000000103808348E25801199815A6606748C4C
+r   1740=00000000000000000000000000000000
+r   1750=F0D9202020C35C2000205C00000000005770354C0636689234054B08903A0D51
+r   1770=0A000000000000000000000000000000
+r   1780=205C402000000000000000000000000089606E40539E8015092F3A4B14258142
+r   17A0=03000000000000000000000000000000
+r   17B0=2120C3212122202140204B40216BC30002815270680912813894391C265D8051
+r   17D0=0E000000000000000000000000000000
+r   17E0=402020226B204B202120002021206B00921A23577468822A16746D4B5617C650
+r   1800=0E000000000000000000000000000000
+r   1810=2220D920F020224B202040D9202100005646354261583642017C723967890190
+r   1830=0D000000000000000000000000000000
+r   1840=205C4B2020200000000000000000000057118E989F14204001204704864178DF
+r   1860=05000000000000000000000000000000
+r   1870=225C2000000000000000000000000000094D781024905D389A9C9A14590A2A06
+r   1890=02000000000000000000000000000000
+r   18A0=21202120202020000000000000000000252563359196226681019862854D1175
+r   18C0=08000000000000000000000000000000
+r   18D0=22402020000000000000000000000000843714335941187F610C028A4200E700
+r   18F0=03000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "EDMK checksum" E890A137
+*Done
+
+*Testcase decimal CVB
+r    400=4F10500007FE                                 # CVB  R1,0(,R5)
+r   1000=000000099999999F000000000000000000000000000000000000000000000000
+r   1020=00000000000000000000000000000000
+r   1030=000000000000500D000000000000000000000000000000000000000000000000
+r   1050=00000000000000000000000000000000
+r   1060=000000000000048B000000000000000000000000000000000000000000000000
+r   1080=00000000000000000000000000000000
+r   1090=000000000000000D000000000000000000000000000000000000000000000000
+r   10B0=00000000000000000000000000000000
+r   10C0=000000000300000B000000000000000000000000000000000000000000000000
+r   10E0=00000000000000000000000000000000
+r   10F0=000000000000000E000000000000000000000000000000000000000000000000
+r   1110=00000000000000000000000000000000
+r   1120=000000099999999F000000000000000000000000000000000000000000000000
+r   1140=00000000000000000000000000000000
+r   1150=000000000000475F000000000000000000000000000000000000000000000000
+r   1170=00000000000000000000000000000000
+r   1180=007435639470786A000000000000000000000000000000000000000000000000
+r   11A0=00000000000000000000000000000000
+r   11B0=0000000000000005000000000000000000000000000000000000000000000000
+r   11D0=00000000000000000000000000000000
+r   11E0=000000000000004C000000000000000000000000000000000000000000000000
+r   1200=00000000000000000000000000000000
+r   1210=000080000000000D000000000000000000000000000000000000000000000000
+r   1230=00000000000000000000000000000000
+r   1240=000103277112096C000000000000000000000000000000000000000000000000
+r   1260=00000000000000000000000000000000
+r   1270=000000000021769C000000000000000000000000000000000000000000000000
+r   1290=00000000000000000000000000000000
+r   12A0=000000000000000D000000000000000000000000000000000000000000000000
+r   12C0=00000000000000000000000000000000
+r   12D0=000000000000006D000000000000000000000000000000000000000000000000
+r   12F0=00000000000000000000000000000000
+r   1300=000000000000000A000000000000000000000000000000000000000000000000
+r   1320=00000000000000000000000000000000
+r   1330=000000000000000C000000000000000000000000000000000000000000000000
+r   1350=00000000000000000000000000000000
+r   1360=000000009999999F000000000000000000000000000000000000000000000000
+r   1380=00000000000000000000000000000000
+r   1390=000000000000009B000000000000000000000000000000000000000000000000
+r   13B0=00000000000000000000000000000000
+r   13C0=000000000000218A000000000000000000000000000000000000000000000000
+r   13E0=00000000000000000000000000000000
+r   13F0=000000000057700B000000000000000000000000000000000000000000000000
+r   1410=00000000000000000000000000000000
+r   1420=000000000000000B000000000000000000000000000000000000000000000000
+r   1440=00000000000000000000000000000000
+r   1450=000000000000000C000000000000000000000000000000000000000000000000
+r   1470=00000000000000000000000000000000
+r   1480=000000000000009D000000000000000000000000000000000000000000000000
+r   14A0=00000000000000000000000000000000
+r   14B0=006038440560056A000000000000000000000000000000000000000000000000
+r   14D0=00000000000000000000000000000000
+r   14E0=000000000099999D000000000000000000000000000000000000000000000000
+r   1500=00000000000000000000000000000000
+r   1510=000000000000000A000000000000000000000000000000000000000000000000
+r   1530=00000000000000000000000000000000
+r   1540=000000000846680D000000000000000000000000000000000000000000000000
+r   1560=00000000000000000000000000000000
+r   1570=0000000000000014000000000000000000000000000000000000000000000000
+r   1590=00000000000000000000000000000000
+r   15A0=000000004984145C000000000000000000000000000000000000000000000000
+r   15C0=00000000000000000000000000000000
+r   15D0=000000000000869D000000000000000000000000000000000000000000000000
+r   15F0=00000000000000000000000000000000
+r   1600=0000000999999991000000000000000000000000000000000000000000000000
+r   1620=00000000000000000000000000000000
+r   1630=000A00000000001C000000000000000000000000000000000000000000000000
+r   1650=00000000000000000000000000000000
+r   1660=000000000000006D000000000000000000000000000000000000000000000000
+r   1680=00000000000000000000000000000000
+r   1690=000000000000067D000000000000000000000000000000000000000000000000
+r   16B0=00000000000000000000000000000000
+r   16C0=000003819259652A000000000000000000000000000000000000000000000000
+r   16E0=00000000000000000000000000000000
+r   16F0=000999999999999E000000000000000000000000000000000000000000000000
+r   1710=00000000000000000000000000000000
+r   1720=000062697422963C000000000000000000000000000000000000000000000000
+r   1740=00000000000000000000000000000000
+r   1750=000000000305604C000000000000000000000000000000000000000000000000
+r   1770=00000000000000000000000000000000
+r   1780=000000000000107A000000000000000000000000000000000000000000000000
+r   17A0=00000000000000000000000000000000
+r   17B0=000000009999999C000000000000000000000000000000000000000000000000
+r   17D0=00000000000000000000000000000000
+r   17E0=000000000000036E000000000000000000000000000000000000000000000000
+r   1800=00000000000000000000000000000000
+r   1810=000001429424575D000000000000000000000000000000000000000000000000
+r   1830=00000000000000000000000000000000
+r   1840=005160864943265D000000000000000000000000000000000000000000000000
+r   1860=00000000000000000000000000000000
+r   1870=000000000000000B000000000000000000000000000000000000000000000000
+r   1890=00000000000000000000000000000000
+r   18A0=000000000499742C000000000000000000000000000000000000000000000000
+r   18C0=00000000000000000000000000000000
+r   18D0=008303583594037B000000000000000000000000000000000000000000000000
+r   18F0=00000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "CVB checksum" D0381E27
+*Done
+
+*Testcase decimal CVBG
+r    400=E3105000000E07FE                             # CVBG R1,0(,R5)
+r   1000=0000000000000000481868501812708E00000000000000000000000000000000
+r   1020=00000000000000000000000000000000
+r   1030=0000000000000000000000000000000B00000000000000000000000000000000
+r   1050=00000000000000000000000000000000
+r   1060=0000000000000000000000000000000C00000000000000000000000000000000
+r   1080=00000000000000000000000000000000
+r   1090=0000000000000040000000000000000F00000000000000000000000000000000
+r   10B0=00000000000000000000000000000000
+r   10C0=0000000000009999999999999999999400000000000000000000000000000000
+r   10E0=00000000000000000000000000000000
+r   10F0=0000000000000000000000000700000D00000000000000000000000000000000
+r   1110=00000000000000000000000000000000
+r   1120=0000000000000000000000000000000E00000000000000000000000000000000
+r   1140=00000000000000000000000000000000
+r   1150=0000000000011782281002221984081D00000000000000000000000000000000
+r   1170=00000000000000000000000000000000
+r   1180=0000000000000000000000000000000C00000000000000000000000000000000
+r   11A0=00000000000000000000000000000000
+r   11B0=00000000000000000000000000A0000D00000000000000000000000000000000
+r   11D0=00000000000000000000000000000000
+r   11E0=0000000000000047342839787433683F00000000000000000000000000000000
+r   1200=00000000000000000000000000000000
+r   1210=0000000000006286044326739396201C00000000000000000000000000000000
+r   1230=00000000000000000000000000000000
+r   1240=0000000000000000000000000053689D00000000000000000000000000000000
+r   1260=00000000000000000000000000000000
+r   1270=0000000000000000000062922529439E00000000000000000000000000000000
+r   1290=00000000000000000000000000000000
+r   12A0=0000000000000000000000000060000A00000000000000000000000000000000
+r   12C0=00000000000000000000000000000000
+r   12D0=0000000000083644780690156230517E00000000000000000000000000000000
+r   12F0=00000000000000000000000000000000
+r   1300=0000000000073177312265775140799F00000000000000000000000000000000
+r   1320=00000000000000000000000000000000
+r   1330=0000000000000000000000000080040C00000000000000000000000000000000
+r   1350=00000000000000000000000000000000
+r   1360=0000000000099999999999999999999A00000000000000000000000000000000
+r   1380=00000000000000000000000000000000
+r   1390=0000000000000000000003281300267C00000000000000000000000000000000
+r   13B0=00000000000000000000000000000000
+r   13C0=0000000000003702663606702229251D00000000000000000000000000000000
+r   13E0=00000000000000000000000000000000
+r   13F0=0000000000000000000000000000019F00000000000000000000000000000000
+r   1410=00000000000000000000000000000000
+r   1420=0000000000007251390950794865952F00000000000000000000000000000000
+r   1440=00000000000000000000000000000000
+r   1450=0000000000000000000000000000000D00000000000000000000000000000000
+r   1470=00000000000000000000000000000000
+r   1480=0000000000007118720263192063122E00000000000000000000000000000000
+r   14A0=00000000000000000000000000000000
+r   14B0=0000000000041400971347016017377C00000000000000000000000000000000
+r   14D0=00000000000000000000000000000000
+r   14E0=0000000000009999999999999999999D00000000000000000000000000000000
+r   1500=00000000000000000000000000000000
+r   1510=0000000000000000000000000000000D00000000000000000000000000000000
+r   1530=00000000000000000000000000000000
+r   1540=0000000999999999999999999999999D00000000000000000000000000000000
+r   1560=00000000000000000000000000000000
+r   1570=0000000000000000000000004710532E00000000000000000000000000000000
+r   1590=00000000000000000000000000000000
+r   15A0=0000000000003898385594186663840E00000000000000000000000000000000
+r   15C0=00000000000000000000000000000000
+r   15D0=0000000000000000000000900000000C00000000000000000000000000000000
+r   15F0=00000000000000000000000000000000
+r   1600=0000000000099999999999999999999E00000000000000000000000000000000
+r   1620=00000000000000000000000000000000
+r   1630=0000000000000005000000000000000100000000000000000000000000000000
+r   1650=00000000000000000000000000000000
+r   1660=0000000000075002973893383254978F00000000000000000000000000000000
+r   1680=00000000000000000000000000000000
+r   1690=0000000000000000000576618417111D00000000000000000000000000000000
+r   16B0=00000000000000000000000000000000
+r   16C0=0000000000068472301127035958462C00000000000000000000000000000000
+r   16E0=00000000000000000000000000000000
+r   16F0=0000000000005337025697623108403E00000000000000000000000000000000
+r   1710=00000000000000000000000000000000
+r   1720=0000000000009999999999999999999C00000000000000000000000000000000
+r   1740=00000000000000000000000000000000
+r   1750=0000000000009999999999999999999D00000000000000000000000000000000
+r   1770=00000000000000000000000000000000
+r   1780=0001393252391799680857293739019A00000000000000000000000000000000
+r   17A0=00000000000000000000000000000000
+r   17B0=0000000000005703102264021390067D00000000000000000000000000000000
+r   17D0=00000000000000000000000000000000
+r   17E0=0000000000000000000000000700000C00000000000000000000000000000000
+r   1800=00000000000000000000000000000000
+r   1810=0000000000000000000000000385664F00000000000000000000000000000000
+r   1830=00000000000000000000000000000000
+r   1840=0000000000003833137664317856148A00000000000000000000000000000000
+r   1860=00000000000000000000000000000000
+r   1870=0000000000003968070827058701399F00000000000000000000000000000000
+r   1890=00000000000000000000000000000000
+r   18A0=0000000000000000008000000000000D00000000000000000000000000000000
+r   18C0=00000000000000000000000000000000
+r   18D0=0000000000000000426762131675878C00000000000000000000000000000000
+r   18F0=00000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "CVBG checksum" 8A90A792
+*Done
+
+*Testcase decimal CVD
+r    400=581050104E10500007FE                         # L R1,16(,R5); CVD R1,0(,R5)
+r   1000=0000000000000000000000000000000000000000000000000000000000000000
+r   1020=00000000000000000000000000000000
+r   1030=0000000000000000000000000000000080000000000000000000000000000000
+r   1050=00000000000000000000000000000000
+r   1060=0000000000000000000000000000000000000509000000000000000000000000
+r   1080=00000000000000000000000000000000
+r   1090=00000000000000000000000000000000047901C1000000000000000000000000
+r   10B0=00000000000000000000000000000000
+r   10C0=0000000000000000000000000000000080000000000000000000000000000000
+r   10E0=00000000000000000000000000000000
+r   10F0=0000000000000000000000000000000000018337000000000000000000000000
+r   1110=00000000000000000000000000000000
+r   1120=00000000000000000000000000000000CE696A85000000000000000000000000
+r   1140=00000000000000000000000000000000
+r   1150=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1170=00000000000000000000000000000000
+r   1180=0000000000000000000000000000000080000000000000000000000000000000
+r   11A0=00000000000000000000000000000000
+r   11B0=00000000000000000000000000000000C2E4358B000000000000000000000000
+r   11D0=00000000000000000000000000000000
+r   11E0=000000000000000000000000000000003914E8DB000000000000000000000000
+r   1200=00000000000000000000000000000000
+r   1210=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1230=00000000000000000000000000000000
+r   1240=00000000000000000000000000000000F0CEBECB000000000000000000000000
+r   1260=00000000000000000000000000000000
+r   1270=0000000000000000000000000000000080000000000000000000000000000000
+r   1290=00000000000000000000000000000000
+r   12A0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   12C0=00000000000000000000000000000000
+r   12D0=000000000000000000000000000000001B8651C7000000000000000000000000
+r   12F0=00000000000000000000000000000000
+r   1300=00000000000000000000000000000000FFFFFFFF000000000000000000000000
+r   1320=00000000000000000000000000000000
+r   1330=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1350=00000000000000000000000000000000
+r   1360=00000000000000000000000000000000FFFFFFFF000000000000000000000000
+r   1380=00000000000000000000000000000000
+r   1390=0000000000000000000000000000000016108E96000000000000000000000000
+r   13B0=00000000000000000000000000000000
+r   13C0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   13E0=00000000000000000000000000000000
+r   13F0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1410=00000000000000000000000000000000
+r   1420=000000000000000000000000000000000000083C000000000000000000000000
+r   1440=00000000000000000000000000000000
+r   1450=0000000000000000000000000000000088F33C64000000000000000000000000
+r   1470=00000000000000000000000000000000
+r   1480=0000000000000000000000000000000000000000000000000000000000000000
+r   14A0=00000000000000000000000000000000
+r   14B0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   14D0=00000000000000000000000000000000
+r   14E0=0000000000000000000000000000000002E78CF9000000000000000000000000
+r   1500=00000000000000000000000000000000
+r   1510=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1530=00000000000000000000000000000000
+r   1540=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1560=00000000000000000000000000000000
+r   1570=00000000000000000000000000000000FFFFFFFF000000000000000000000000
+r   1590=00000000000000000000000000000000
+r   15A0=000000000000000000000000000000001F1A75CB000000000000000000000000
+r   15C0=00000000000000000000000000000000
+r   15D0=000000000000000000000000000000006D91274F000000000000000000000000
+r   15F0=00000000000000000000000000000000
+r   1600=0000000000000000000000000000000000000000000000000000000000000000
+r   1620=00000000000000000000000000000000
+r   1630=0000000000000000000000000000000000000000000000000000000000000000
+r   1650=00000000000000000000000000000000
+r   1660=0000000000000000000000000000000069FC7A9A000000000000000000000000
+r   1680=00000000000000000000000000000000
+r   1690=0000000000000000000000000000000000000000000000000000000000000000
+r   16B0=00000000000000000000000000000000
+r   16C0=00000000000000000000000000000000FFFFFFFF000000000000000000000000
+r   16E0=00000000000000000000000000000000
+r   16F0=000000000000000000000000000000000001432E000000000000000000000000
+r   1710=00000000000000000000000000000000
+r   1720=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1740=00000000000000000000000000000000
+r   1750=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1770=00000000000000000000000000000000
+r   1780=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   17A0=00000000000000000000000000000000
+r   17B0=00000000000000000000000000000000FFFFFFFF000000000000000000000000
+r   17D0=00000000000000000000000000000000
+r   17E0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1800=00000000000000000000000000000000
+r   1810=000000000000000000000000000000004E197F06000000000000000000000000
+r   1830=00000000000000000000000000000000
+r   1840=0000000000000000000000000000000080000000000000000000000000000000
+r   1860=00000000000000000000000000000000
+r   1870=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   1890=00000000000000000000000000000000
+r   18A0=000000000000000000000000000000007FFFFFFF000000000000000000000000
+r   18C0=00000000000000000000000000000000
+r   18D0=00000000000000000000000000000000999B946C000000000000000000000000
+r   18F0=00000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "CVD checksum" F6F72F8C
+*Done
+
+*Testcase decimal CVDG
+r    400=E31050100004E3105000002E07FE                 # LG R1,16(,R5); CVDG R1,0(,R5)
+r   1000=0000000000000000000000000000000080000000000000000000000000000000
+r   1020=00000000000000000000000000000000
+r   1030=0000000000000000000000000000000000000000000B99870000000000000000
+r   1050=00000000000000000000000000000000
+r   1060=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   1080=00000000000000000000000000000000
+r   1090=0000000000000000000000000000000000000000000000000000000000000000
+r   10B0=00000000000000000000000000000000
+r   10C0=0000000000000000000000000000000080000000000000000000000000000000
+r   10E0=00000000000000000000000000000000
+r   10F0=0000000000000000000000000000000000000000000000000000000000000000
+r   1110=00000000000000000000000000000000
+r   1120=00000000000000000000000000000000000000000000015A0000000000000000
+r   1140=00000000000000000000000000000000
+r   1150=0000000000000000000000000000000065E7A44C4E96133D0000000000000000
+r   1170=00000000000000000000000000000000
+r   1180=00000000000000000000000000000000FFFFFFFFFFFFFFFF0000000000000000
+r   11A0=00000000000000000000000000000000
+r   11B0=0000000000000000000000000000000000000000000000000000000000000000
+r   11D0=00000000000000000000000000000000
+r   11E0=0000000000000000000000000000000000857D0DD55280AF0000000000000000
+r   1200=00000000000000000000000000000000
+r   1210=00000000000000000000000000000000FFFFFFFFFFFFFFFF0000000000000000
+r   1230=00000000000000000000000000000000
+r   1240=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   1260=00000000000000000000000000000000
+r   1270=0000000000000000000000000000000080000000000000000000000000000000
+r   1290=00000000000000000000000000000000
+r   12A0=000000000000000000000000000000009AEF97073B8844890000000000000000
+r   12C0=00000000000000000000000000000000
+r   12D0=00000000000000000000000000000000BF71470B5096C98D0000000000000000
+r   12F0=00000000000000000000000000000000
+r   1300=0000000000000000000000000000000080000000000000000000000000000000
+r   1320=00000000000000000000000000000000
+r   1330=000000000000000000000000000000007CB3B65019D509940000000000000000
+r   1350=00000000000000000000000000000000
+r   1360=0000000000000000000000000000000000000000000000000000000000000000
+r   1380=00000000000000000000000000000000
+r   1390=0000000000000000000000000000000080000000000000000000000000000000
+r   13B0=00000000000000000000000000000000
+r   13C0=0000000000000000000000000000000000000000000000000000000000000000
+r   13E0=00000000000000000000000000000000
+r   13F0=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   1410=00000000000000000000000000000000
+r   1420=00000000000000000000000000000000C45DBB06226419DF0000000000000000
+r   1440=00000000000000000000000000000000
+r   1450=000000000000000000000000000000000008D54598A66F280000000000000000
+r   1470=00000000000000000000000000000000
+r   1480=0000000000000000000000000000000053405BC26957EE780000000000000000
+r   14A0=00000000000000000000000000000000
+r   14B0=00000000000000000000000000000000F8F37B836EBAD9380000000000000000
+r   14D0=00000000000000000000000000000000
+r   14E0=000000000000000000000000000000008A446BC6F8232BFF0000000000000000
+r   1500=00000000000000000000000000000000
+r   1510=0000000000000000000000000000000000000000000000000000000000000000
+r   1530=00000000000000000000000000000000
+r   1540=00000000000000000000000000000000C5FF0ABBABB2BA9F0000000000000000
+r   1560=00000000000000000000000000000000
+r   1570=00000000000000000000000000000000FFFFFFFFFFFFFFFF0000000000000000
+r   1590=00000000000000000000000000000000
+r   15A0=0000000000000000000000000000000080000000000000000000000000000000
+r   15C0=00000000000000000000000000000000
+r   15D0=0000000000000000000000000000000080000000000000000000000000000000
+r   15F0=00000000000000000000000000000000
+r   1600=0000000000000000000000000000000000000000000000000000000000000000
+r   1620=00000000000000000000000000000000
+r   1630=0000000000000000000000000000000000000007B2643D6F0000000000000000
+r   1650=00000000000000000000000000000000
+r   1660=0000000000000000000000000000000000000000000000000000000000000000
+r   1680=00000000000000000000000000000000
+r   1690=0000000000000000000000000000000000000000000000000000000000000000
+r   16B0=00000000000000000000000000000000
+r   16C0=00000000000000000000000000000000000000010022A3220000000000000000
+r   16E0=00000000000000000000000000000000
+r   16F0=00000000000000000000000000000000FFFFFFFFFFFFFFFF0000000000000000
+r   1710=00000000000000000000000000000000
+r   1720=0000000000000000000000000000000000000000000A38F60000000000000000
+r   1740=00000000000000000000000000000000
+r   1750=00000000000000000000000000000000FFFFFFFFFFFFFFFF0000000000000000
+r   1770=00000000000000000000000000000000
+r   1780=0000000000000000000000000000000080000000000000000000000000000000
+r   17A0=00000000000000000000000000000000
+r   17B0=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   17D0=00000000000000000000000000000000
+r   17E0=00000000000000000000000000000000B4D8BA5C8DE81E820000000000000000
+r   1800=00000000000000000000000000000000
+r   1810=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   1830=00000000000000000000000000000000
+r   1840=0000000000000000000000000000000000000000000000000000000000000000
+r   1860=00000000000000000000000000000000
+r   1870=000000000000000000000000000000007FFFFFFFFFFFFFFF0000000000000000
+r   1890=00000000000000000000000000000000
+r   18A0=0000000000000000000000000000000000000000000000000000000000000000
+r   18C0=00000000000000000000000000000000
+r   18D0=00000000000000000000000000000000000000441C6118D80000000000000000
+r   18F0=00000000000000000000000000000000
+runtest 1.0
+*Compare
+r A00.4
+*Want "CVDG checksum" 80673369
+*Done
+
+ostailor default   # restore messages for subsequent tests
@@ -26,7 +26,7 @@ defsym    FW1   F3F6FFFB    # Facilities 000-031
 defsym    FW2   FCFDFC24    # Facilities 032-063
 defsym    FW3   207C4000    # Facilities 064-095
 defsym    FW4   00000000    # Facilities 096-127
-defsym    FW5   00004000    # Facilities 128-159
+defsym    FW5   40004000    # Facilities 128-159
 #----------------------------------------------------------------------
 
 runtest 0.1
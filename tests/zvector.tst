@@ -0,0 +1,349 @@
+* z/Architecture Vector Facility: a few basic instructions.
+*
+*   200  LCTL  0,0,X'800'           Enable AFP and vector registers
+*   204  VL    V1,X'900'
+*   20A  VL    V2,X'910'
+*   210  VAB   V3,V1,V2             Add (byte)
+*   216  VST   V3,X'A00'
+*   21C  VL    V5,X'920'
+*   222  VFEEBS V4,V1,V5            Find element equal, set cc
+*   228  IPM   R1
+*   22C  ST    R1,X'A40'
+*   230  VST   V4,X'A30'
+*   236  VL    V7,X'930'
+*   23C  VL    V8,X'940'
+*   242  VFADB V9,V7,V8             Add (long BFP)
+*   248  VST   V9,X'A10'
+*   24E  VLM   V16,V17,X'950'       Registers 16-31 via RXB
+*   254  VSTM  V16,V17,X'A50'
+*   25A  LPSWE X'2E0'
+
+*Testcase zvector
+sysclear
+archmode z
+r    1A0=00000001800000000000000000000200
+r    1D0=0002000180000000FFFFFFFFDEADDEAD
+r    200=B7000800E71009000006E72009100006
+r    210=E731200000F3E7300A00000EE7500920
+r    220=0006E74150100080B222001050100A40
+r    230=E7400A30000EE77009300006E7800940
+r    240=0006E797800030E3E7900A10000EE701
+r    250=09500C36E7010A500C3EB2B202E0
+r    2E0=00020001800000000000000000000000
+r    800=000600E0
+r    900=000102030405060708090A0B0C0D0E0F
+r    910=10101010101010101010101010101010
+r    920=07070707070707070707070707070707
+r    930=3FF00000000000004000000000000000
+r    940=3FE00000000000003FD0000000000000
+r    950=0123456789ABCDEFFEDCBA9876543210
+r    960=11111111111111112222222222222222
+numcpu 1
+runtest .1
+*Compare
+r 00000A00.10
+*Want "VAB"          10111213 14151617 18191A1B 1C1D1E1F
+*Compare
+r 00000A30.10
+*Want "VFEEBS"       00000000 00000007 00000000 00000000
+*Compare
+r 00000A40.4
+*Want "VFEEBS cc"    10000000
+*Compare
+r 00000A10.10
+*Want "VFADB"        3FF80000 00000000 40020000 00000000
+*Compare
+r 00000A50.10
+*Want "VSTM V16"     01234567 89ABCDEF FEDCBA98 76543210
+*Compare
+r 00000A60.10
+*Want "VSTM V17"     11111111 11111111 22222222 22222222
+*Done
+
+* Vector string instructions: VFAE, VFEE, VFENE and VSTRC with the
+* IN, RT, ZS and CS flags, byte and halfword elements.  Each test
+* loads its operands into V2-V4 and stores the V1 result at C00 +
+* 16*n and the IPM condition code at E00 + 4*n.
+*
+*   200  LCTL  0,0,X'7F8'           Enable AFP and vector registers
+*   204  VL    V2,X'800'            First test's operands ...
+*   210  VFAEBS V1,V2,V3            ... the instruction under test
+*   216  IPM   R1
+*   21A  ST    R1,X'E00'
+*   21E  VST   V1,X'C00'
+*        ...                        (29 tests)
+*   5DA  LPSWE X'7E0'
+
+*Testcase zvector string
+sysclear
+archmode z
+r    1A0=00000001800000000000000000000200
+r    1D0=0002000180000000FFFFFFFFDEADDEAD
+r    200=B70007F8E72008000006E73008100006
+r    210=E71230100082B222001050100E00E710
+r    220=0C00000EE72008000006E73008200006
+r    230=E71230300082B222001050100E04E710
+r    240=0C10000EE72008000006E73008300006
+r    250=E71230300082B222001050100E08E710
+r    260=0C20000EE72008000006E73008400006
+r    270=E71230100082B222001050100E0CE710
+r    280=0C30000EE72008000006E73008500006
+r    290=E71230900082B222001050100E10E710
+r    2A0=0C40000EE72008000006E73008600006
+r    2B0=E71230500082B222001050100E14E710
+r    2C0=0C50000EE72008700006E73008800006
+r    2D0=E71230301082B222001050100E18E710
+r    2E0=0C60000EE72008700006E73008900006
+r    2F0=E71230501082B222001050100E1CE710
+r    300=0C70000EE72008700006E73008A00006
+r    310=E71230901082B222001050100E20E710
+r    320=0C80000EE72008000006E73008B00006
+r    330=E71230100080B222001050100E24E710
+r    340=0C90000EE72008000006E73008B00006
+r    350=E71230300080B222001050100E28E710
+r    360=0CA0000EE72008000006E73008C00006
+r    370=E71230300080B222001050100E2CE710
+r    380=0CB0000EE72008000006E73008400006
+r    390=E71230100080B222001050100E30E710
+r    3A0=0CC0000EE72008700006E73008D00006
+r    3B0=E71230101080B222001050100E34E710
+r    3C0=0CD0000EE72008000006E73008C00006
+r    3D0=E71230100081B222001050100E38E710
+r    3E0=0CE0000EE72008C00006E73008000006
+r    3F0=E71230100081B222001050100E3CE710
+r    400=0CF0000EE72008000006E73008000006
+r    410=E71230300081B222001050100E40E710
+r    420=0D00000EE72008000006E73008000006
+r    430=E71230100081B222001050100E44E710
+r    440=0D10000EE72008E00006E73008F00006
+r    450=E71230101081B222001050100E48E710
+r    460=0D20000EE72008F00006E73008E00006
+r    470=E71230101081B222001050100E4CE710
+r    480=0D30000EE72009000006E73009100006
+r    490=E74009200006E7123010408AB2220010
+r    4A0=50100E50E7100D40000EE72009000006
+r    4B0=E73009100006E74009200006E7123030
+r    4C0=408AB222001050100E54E7100D50000E
+r    4D0=E72009300006E73009100006E7400920
+r    4E0=0006E7123030408AB222001050100E58
+r    4F0=E7100D60000EE72009000006E7300910
+r    500=0006E74009200006E7123090408AB222
+r    510=001050100E5CE7100D70000EE7200900
+r    520=0006E73009100006E74009400006E712
+r    530=3050408AB222001050100E60E7100D80
+r    540=000EE72009000006E73009500006E740
+r    550=09600006E7123050408AB22200105010
+r    560=0E64E7100D90000EE72009700006E730
+r    570=09800006E74009900006E7123130408A
+r    580=B222001050100E68E7100DA0000EE720
+r    590=09700006E73009800006E74009900006
+r    5A0=E7123150408AB222001050100E6CE710
+r    5B0=0DB0000EE72009A00006E73009800006
+r    5C0=E74009900006E7123110408AB2220010
+r    5D0=50100E70E7100DC0000EB2B207E0
+r    7E0=00020001800000000000000000000000
+r    7F8=000600E0
+r    800=414243440045464748494A4B4C4D4E4F
+r    810=43585858585858585858585858585858
+r    820=47474747474747474747474747474747
+r    830=42424242424242424242424242424242
+r    840=5A5A5A5A5A5A5A5A5A5A5A5A5A5A5A5A
+r    850=41424141414141414141414141414141
+r    860=41434541414141414141414141414141
+r    870=00410042004300000044004500460047
+r    880=42000043420042004200420042004200
+r    890=00410045420042004200420041004200
+r    8A0=00410042004200420042004200420042
+r    8B0=5A5A5A5A5A5A5A5A5A495A5A5A5A5A5A
+r    8C0=414243580045464748494A4B4C4D4E4F
+r    8D0=01410142014301430144004501460147
+r    8E0=00410042800100000044004500460047
+r    8F0=004100427FFF00000044004500460047
+r    900=61623363370039203132333435363738
+r    910=30396363000000000000000000000000
+r    920=A0C00000000000000000000000000000
+r    930=61003363373931323334353637383930
+r    940=A0C08080000000000000000000000000
+r    950=62620000000000000000000000000000
+r    960=40400000000000000000000000000000
+r    970=00410000015081500200018000000042
+r    980=01009000000000000000000000000000
+r    990=A000C000000000000000000000000000
+r    9A0=00410042004300440045004600470048
+numcpu 1
+runtest .1
+*Compare
+r 00000C00.10
+*Want "VFAEBS"            00000000 00000002 00000000 00000000
+*Compare
+r 00000E00.4
+*Want "VFAEBS cc"         10000000
+*Compare
+r 00000C10.10
+*Want "VFAEZBS z"         00000000 00000004 00000000 00000000
+*Compare
+r 00000E04.4
+*Want "VFAEZBS z cc"      00000000
+*Compare
+r 00000C20.10
+*Want "VFAEZBS m"         00000000 00000001 00000000 00000000
+*Compare
+r 00000E08.4
+*Want "VFAEZBS m cc"      20000000
+*Compare
+r 00000C30.10
+*Want "VFAEBS none"       00000000 00000010 00000000 00000000
+*Compare
+r 00000E0C.4
+*Want "VFAEBS none cc"    30000000
+*Compare
+r 00000C40.10
+*Want "VFAEBS IN"         00000000 00000002 00000000 00000000
+*Compare
+r 00000E10.4
+*Want "VFAEBS IN cc"      10000000
+*Compare
+r 00000C50.10
+*Want "VFAEBS RT"         FF00FF00 00FF0000 00000000 00000000
+*Compare
+r 00000E14.4
+*Want "VFAEBS RT cc"      10000000
+*Compare
+r 00000C60.10
+*Want "VFAEZHS"           00000000 00000004 00000000 00000000
+*Compare
+r 00000E18.4
+*Want "VFAEZHS cc"        20000000
+*Compare
+r 00000C70.10
+*Want "VFAEHS RT"         FFFF0000 00000000 0000FFFF 00000000
+*Compare
+r 00000E1C.4
+*Want "VFAEHS RT cc"      10000000
+*Compare
+r 00000C80.10
+*Want "VFAEHS IN"         00000000 00000004 00000000 00000000
+*Compare
+r 00000E20.4
+*Want "VFAEHS IN cc"      10000000
+*Compare
+r 00000C90.10
+*Want "VFEEBS"            00000000 00000009 00000000 00000000
+*Compare
+r 00000E24.4
+*Want "VFEEBS cc"         10000000
+*Compare
+r 00000CA0.10
+*Want "VFEEZBS z"         00000000 00000004 00000000 00000000
+*Compare
+r 00000E28.4
+*Want "VFEEZBS z cc"      00000000
+*Compare
+r 00000CB0.10
+*Want "VFEEZBS m"         00000000 00000000 00000000 00000000
+*Compare
+r 00000E2C.4
+*Want "VFEEZBS m cc"      20000000
+*Compare
+r 00000CC0.10
+*Want "VFEEBS none"       00000000 00000010 00000000 00000000
+*Compare
+r 00000E30.4
+*Want "VFEEBS none cc"    30000000
+*Compare
+r 00000CD0.10
+*Want "VFEEHS"            00000000 0000000A 00000000 00000000
+*Compare
+r 00000E34.4
+*Want "VFEEHS cc"         10000000
+*Compare
+r 00000CE0.10
+*Want "VFENEBS lo"        00000000 00000003 00000000 00000000
+*Compare
+r 00000E38.4
+*Want "VFENEBS lo cc"     10000000
+*Compare
+r 00000CF0.10
+*Want "VFENEBS hi"        00000000 00000003 00000000 00000000
+*Compare
+r 00000E3C.4
+*Want "VFENEBS hi cc"     20000000
+*Compare
+r 00000D00.10
+*Want "VFENEZBS z"        00000000 00000004 00000000 00000000
+*Compare
+r 00000E40.4
+*Want "VFENEZBS z cc"     00000000
+*Compare
+r 00000D10.10
+*Want "VFENEBS eq"        00000000 00000010 00000000 00000000
+*Compare
+r 00000E44.4
+*Want "VFENEBS eq cc"     30000000
+*Compare
+r 00000D20.10
+*Want "VFENEHS hi"        00000000 00000004 00000000 00000000
+*Compare
+r 00000E48.4
+*Want "VFENEHS hi cc"     20000000
+*Compare
+r 00000D30.10
+*Want "VFENEHS lo"        00000000 00000004 00000000 00000000
+*Compare
+r 00000E4C.4
+*Want "VFENEHS lo cc"     10000000
+*Compare
+r 00000D40.10
+*Want "VSTRCBS"           00000000 00000002 00000000 00000000
+*Compare
+r 00000E50.4
+*Want "VSTRCBS cc"        10000000
+*Compare
+r 00000D50.10
+*Want "VSTRCZBS m"        00000000 00000002 00000000 00000000
+*Compare
+r 00000E54.4
+*Want "VSTRCZBS m cc"     20000000
+*Compare
+r 00000D60.10
+*Want "VSTRCZBS z"        00000000 00000001 00000000 00000000
+*Compare
+r 00000E58.4
+*Want "VSTRCZBS z cc"     00000000
+*Compare
+r 00000D70.10
+*Want "VSTRCBS IN"        00000000 00000000 00000000 00000000
+*Compare
+r 00000E5C.4
+*Want "VSTRCBS IN cc"     10000000
+*Compare
+r 00000D80.10
+*Want "VSTRCBS RT"        0000FFFF FF00FF00 FFFFFFFF FFFFFFFF
+*Compare
+r 00000E60.4
+*Want "VSTRCBS RT cc"     10000000
+*Compare
+r 00000D90.10
+*Want "VSTRCBS lt"        FF00FF00 FFFFFFFF FFFFFFFF FFFFFFFF
+*Compare
+r 00000E64.4
+*Want "VSTRCBS lt cc"     10000000
+*Compare
+r 00000DA0.10
+*Want "VSTRCZHS"          00000000 00000002 00000000 00000000
+*Compare
+r 00000E68.4
+*Want "VSTRCZHS cc"       00000000
+*Compare
+r 00000DB0.10
+*Want "VSTRCHS RT"        00000000 FFFFFFFF FFFFFFFF 00000000
+*Compare
+r 00000E6C.4
+*Want "VSTRCHS RT cc"     10000000
+*Compare
+r 00000DC0.10
+*Want "VSTRCHS none"      00000000 00000010 00000000 00000000
+*Compare
+r 00000E70.4
+*Want "VSTRCHS none cc"   30000000
+*Done
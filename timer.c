@@ -321,6 +321,10 @@ bool    txf_PPA;                        /* true == PPA assist needed */
 
         } /* end if (intv_secs >= one_sec) */
 
+        /* Sample the CPUs if the profiler is on */
+        if (sysblk.profile)
+            profile_sample( now );
+
         /* Sleep for another timer update interval... */
 
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
@@ -816,6 +816,33 @@ int      TUNTAP_GetFlags ( char*  pszNetDevName,
 }   // End of function  TUNTAP_GetFlags()
 
 
+//
+// TUNTAP_SetOffload
+//
+// Tells the kernel which offloads (TUN_F_xxx flags) the reader of
+// an IFF_VNET_HDR interface is prepared to handle in the frames it
+// reads. Zero means frames are always delivered fully checksummed
+// and segmented. Frames written by us may use any offload the
+// virtio-net header can describe regardless of this setting.
+//
+
+int      TUNTAP_SetOffload ( int           fd,
+                             unsigned int  uOffloads )
+{
+#if defined( TUNTAP_OFFLOAD )
+    // PROGRAMMING NOTE: this applies to our own open file descriptor
+    // and needs no privileges, so (like TUNTAP_GetFlags above) we
+    // issue the ioctl directly rather than going through hercifc.
+    return ioctl( fd, TUNSETOFFLOAD, (unsigned long) uOffloads );
+#else
+    UNREFERENCED( fd );
+    UNREFERENCED( uOffloads );
+    errno = ENOTSUP;
+    return -1;
+#endif
+}   // End of function  TUNTAP_SetOffload()
+
+
 //
 // TUNTAP_AddRoute
 //
@@ -1446,4 +1473,324 @@ void net_data_trace( DEVBLK* pDEVBLK, BYTE* pAddr, int iLen, BYTE bDir, BYTE bSe
     }
 }
 
+#if defined( TUNTAP_NETBE )
+// ====================================================================
+// User-space Network Backends
+// ====================================================================
+
+//
+// tap: the kernel TUN/TAP device (opened by TUNTAP_CreateInterface)
+//
+static int netbe_fd_readv( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    return readv( be->fd, iov, iovcnt );
+}
+
+static int netbe_fd_writev( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    return writev( be->fd, iov, iovcnt );
+}
+
+static void netbe_fd_close( NETBE* be )
+{
+    if (be->fd >= 0)
+        close( be->fd );
+}
+
+const NETBE_HANDLER netbe_tap =
+{
+    "tap", 1, 1, NULL, netbe_fd_readv, netbe_fd_writev, NULL
+};
+
+//
+// Writev for backends whose peer may not keep up: frames the host
+// has no room for are dropped (as a real wire would) and counted.
+//
+static int netbe_drop_writev( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    int  i, len, wrote;
+
+    wrote = writev( be->fd, iov, iovcnt );
+    if (wrote < 0 && (errno == EAGAIN || errno == ENOBUFS))
+    {
+        for (i = 0, len = 0; i < iovcnt; i++)
+            len += (int) iov[i].iov_len;
+        be->drops++;
+        return len;
+    }
+    return wrote;
+}
+
+//
+// socket: SOCK_SEQPACKET Unix domain socket, one frame per message
+//
+static int netbe_socket_open( NETBE* be, const char* target, int l3 )
+{
+    struct sockaddr_un  sun;
+
+    UNREFERENCED( l3 );
+
+    if (!target || strlen( target ) >= sizeof( sun.sun_path ))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    memset( &sun, 0, sizeof( sun ));
+    sun.sun_family = AF_UNIX;
+    STRLCPY( sun.sun_path, target );
+
+    if ((be->fd = socket( AF_UNIX, SOCK_SEQPACKET, 0 )) < 0)
+        return -1;
+    if (connect( be->fd, (struct sockaddr*) &sun, sizeof( sun )) < 0)
+    {
+        int errnum = errno;
+        close( be->fd );
+        be->fd = -1;
+        errno = errnum;
+        return -1;
+    }
+    return 0;
+}
+
+static const NETBE_HANDLER netbe_socket =
+{
+    "socket", 0, 0, netbe_socket_open, netbe_fd_readv, netbe_drop_writev, netbe_fd_close
+};
+
+//
+// packet: AF_PACKET socket bound to an existing host interface. Input
+// arrives in a TPACKET_V3 ring shared with the kernel: the kernel fills
+// a block with many frames and hands the whole block over at once (or
+// after tp_retire_blk_tov milliseconds), so a burst costs one wakeup
+// and no system call per frame. Output is a plain write on the bound
+// socket. Layer 2 (Ethernet frames) only.
+//
+// (TPACKET_V3 is an enum; TP_FT_REQ_FILL_RXHASH came with it)
+//
+#if defined( HAVE_LINUX_IF_PACKET_H ) && defined( TP_FT_REQ_FILL_RXHASH )
+  #define NETBE_PACKET_V3
+#endif
+#if defined( NETBE_PACKET_V3 )
+
+#ifndef ETH_P_ALL
+#define ETH_P_ALL       0x0003          // (from <linux/if_ether.h>)
+#endif
+
+#define NETBE_PKT_BLKSIZE   (256*1024)  // Ring block size
+#define NETBE_PKT_BLKNUM    16          // Ring blocks
+#define NETBE_PKT_FRMSIZE   2048        // Nominal frame size
+#define NETBE_PKT_BLKTOV    1           // Block retire timeout (msecs)
+
+static void netbe_packet_close( NETBE* be )
+{
+    if (be->ring)
+        munmap( be->ring, be->ringsize );
+    be->ring = NULL;
+    netbe_fd_close( be );
+}
+
+static int netbe_packet_open( NETBE* be, const char* target, int l3 )
+{
+    struct tpacket_req3  req;
+    struct sockaddr_ll   sll;
+    struct packet_mreq   mr;
+    int                  ver = TPACKET_V3;
+    unsigned int         ifindex;
+    int                  errnum;
+
+    if (l3)
+    {
+        errno = EPROTONOSUPPORT;
+        return -1;
+    }
+    if (!target || !(ifindex = if_nametoindex( target )))
+    {
+        errno = ENODEV;
+        return -1;
+    }
+    if ((be->fd = socket( AF_PACKET, SOCK_RAW, htons( ETH_P_ALL ))) < 0)
+        return -1;
+
+    memset( &req, 0, sizeof( req ));
+    req.tp_block_size     = NETBE_PKT_BLKSIZE;
+    req.tp_block_nr       = NETBE_PKT_BLKNUM;
+    req.tp_frame_size     = NETBE_PKT_FRMSIZE;
+    req.tp_frame_nr       = (NETBE_PKT_BLKSIZE / NETBE_PKT_FRMSIZE) * NETBE_PKT_BLKNUM;
+    req.tp_retire_blk_tov = NETBE_PKT_BLKTOV;
+
+    if (0
+        || setsockopt( be->fd, SOL_PACKET, PACKET_VERSION, &ver, sizeof( ver )) < 0
+        || setsockopt( be->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof( req )) < 0
+    )
+        goto error;
+
+    be->blksize  = req.tp_block_size;
+    be->blknum   = req.tp_block_nr;
+    be->ringsize = (size_t) be->blksize * be->blknum;
+    be->blkcur   = 0;
+    be->pktleft  = 0;
+    be->ring = mmap( NULL, be->ringsize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_LOCKED, be->fd, 0 );
+    if (MAP_FAILED == be->ring)
+    {
+        /* (retry without locking the ring into memory) */
+        be->ring = mmap( NULL, be->ringsize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED, be->fd, 0 );
+        if (MAP_FAILED == be->ring)
+        {
+            be->ring = NULL;
+            goto error;
+        }
+    }
+
+#if defined( PACKET_IGNORE_OUTGOING )
+    {
+        int one = 1;            /* (older kernels: filtered on read) */
+        setsockopt( be->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof( one ));
+    }
+#endif
+
+    memset( &sll, 0, sizeof( sll ));
+    sll.sll_family   = AF_PACKET;
+    sll.sll_protocol = htons( ETH_P_ALL );
+    sll.sll_ifindex  = ifindex;
+    if (bind( be->fd, (struct sockaddr*) &sll, sizeof( sll )) < 0)
+        goto error;
+
+    /* The guest's MAC address is not the host interface's */
+    memset( &mr, 0, sizeof( mr ));
+    mr.mr_ifindex = ifindex;
+    mr.mr_type    = PACKET_MR_PROMISC;
+    if (setsockopt( be->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mr, sizeof( mr )) < 0)
+        goto error;
+
+    return 0;
+
+error:
+    errnum = errno;
+    netbe_packet_close( be );
+    be->fd = -1;
+    errno = errnum;
+    return -1;
+}
+
+static int netbe_packet_readv( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    struct tpacket_block_desc*  blk;
+    struct tpacket3_hdr*        hdr;
+    struct sockaddr_ll*         sll;
+    BYTE*   data;
+    int     i, len, cpy, got;
+
+    for (;;)
+    {
+        blk = (struct tpacket_block_desc*)(be->ring + (size_t) be->blkcur * be->blksize);
+
+        if (!be->pktleft)
+        {
+            if (!(blk->hdr.bh1.block_status & TP_STATUS_USER))
+            {
+                errno = EAGAIN;
+                return -1;
+            }
+            HARDWARE_SYNC();
+            be->pktleft = blk->hdr.bh1.num_pkts;
+            be->pkt     = (BYTE*) blk + blk->hdr.bh1.offset_to_first_pkt;
+        }
+
+        hdr = NULL;
+        if (be->pktleft)
+        {
+            hdr = (struct tpacket3_hdr*) be->pkt;
+            be->pkt += hdr->tp_next_offset;
+            be->pktleft--;
+
+            sll = (struct sockaddr_ll*)((BYTE*) hdr
+                + TPACKET_ALIGN( sizeof( struct tpacket3_hdr )));
+            if (PACKET_OUTGOING == sll->sll_pkttype)
+                hdr = NULL;             /* (our own output; skip it) */
+        }
+
+        got = 0;
+        if (hdr)
+        {
+            data = (BYTE*) hdr + hdr->tp_mac;
+            len  = hdr->tp_snaplen;
+            for (i = 0; i < iovcnt && len > 0; i++)
+            {
+                cpy = min( len, (int) iov[i].iov_len );
+                memcpy( iov[i].iov_base, data, cpy );
+                data += cpy;
+                got  += cpy;
+                len  -= cpy;
+            }
+        }
+
+        /* Hand an exhausted block back to the kernel */
+        if (!be->pktleft)
+        {
+            HARDWARE_SYNC();
+            blk->hdr.bh1.block_status = TP_STATUS_KERNEL;
+            HARDWARE_SYNC();
+            be->blkcur = (be->blkcur + 1) % be->blknum;
+        }
+
+        if (hdr)
+            return got;
+    }
+}
+
+static const NETBE_HANDLER netbe_packet =
+{
+    "packet", 0, 1, netbe_packet_open, netbe_packet_readv, netbe_drop_writev, netbe_packet_close
+};
+
+#endif // defined( NETBE_PACKET_V3 )
+
+static const NETBE_HANDLER* netbe_handlers[] =
+{
+    &netbe_tap,
+#if defined( NETBE_PACKET_V3 )
+    &netbe_packet,
+#endif
+    &netbe_socket,
+};
+
+//
+// NETBE_Find
+//
+// Returns the backend handler of the given name or NULL if unknown.
+//
+const NETBE_HANDLER* NETBE_Find( const char* name )
+{
+    size_t  i;
+
+    for (i = 0; i < _countof( netbe_handlers ); i++)
+        if (!strcasecmp( name, netbe_handlers[i]->name ))
+            return netbe_handlers[i];
+    return NULL;
+}
+
+//
+// NETBE_SocketPair
+//
+// Opens a "socket" backend connected to a new socket in this process
+// (returned in *peerfd) instead of to a named peer. Used by loopback
+// tests and benchmarks.
+//
+int NETBE_SocketPair( NETBE* be, int* peerfd )
+{
+    int  fds[2];
+
+    if (socketpair( AF_UNIX, SOCK_SEQPACKET, 0, fds ) < 0)
+        return -1;
+    memset( be, 0, sizeof( NETBE ));
+    be->hnd = &netbe_socket;
+    be->fd  = fds[0];
+    *peerfd = fds[1];
+    return 0;
+}
+
+#endif // defined( TUNTAP_NETBE )
+
 #endif /*  !defined(__SOLARIS__)  jbs*/
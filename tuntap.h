@@ -51,6 +51,19 @@
   /* is configured and that only the interface name is to be set.    */
   #define IFF_NO_HERCIFC  0x10000
 
+  /* Linux TUN/TAP offloads: with IFF_VNET_HDR every frame read from */
+  /* or written to the device is preceded by a virtio-net header     */
+  /* describing checksum and segmentation offload for the frame.     */
+#if defined( HAVE_LINUX_IF_TUN_H ) && defined( IFF_VNET_HDR ) && defined( TUNSETOFFLOAD )
+  #define TUNTAP_OFFLOAD            /* IFF_VNET_HDR offloads available */
+#endif
+
+  /* Linux multi-queue TAP: each further TUNSETIFF of the same name  */
+  /* with IFF_MULTI_QUEUE attaches another queue (fd) to interface.  */
+#if defined( HAVE_LINUX_IF_TUN_H ) && defined( IFF_MULTI_QUEUE )
+  #define TUNTAP_MULTIQUEUE         /* IFF_MULTI_QUEUE is available    */
+#endif
+
 #if !defined(HAVE_NET_IF_H)
   /* Standard interface flags. */
   #define IFF_UP          0x1       /* interface is up               */
@@ -129,6 +142,31 @@ extern int      TUNTAP_SetFlags         ( char*   pszNetDevName,
 
 extern int      TUNTAP_GetFlags         ( char*   pszNetDevName,
                                           int*    piFlags );
+
+extern int      TUNTAP_SetOffload       ( int     fd,
+                                          unsigned int uOffloads );
+
+//
+// virtio-net header preceding each frame when IFF_VNET_HDR is used
+// (struct virtio_net_hdr; fields are in host byte order)
+//
+struct TUNTAP_VNETHDR
+{
+    BYTE    flags;
+#define VNETHDR_F_NEEDS_CSUM    0x01    // Checksum csum_start/offset
+#define VNETHDR_F_DATA_VALID    0x02    // Checksum already verified
+    BYTE    gso_type;
+#define VNETHDR_GSO_NONE        0x00    // Not a GSO frame
+#define VNETHDR_GSO_TCPV4       0x01    // GSO frame, IPv4 TCP (TSO)
+#define VNETHDR_GSO_UDP         0x03    // GSO frame, IPv4 UDP (UFO)
+#define VNETHDR_GSO_TCPV6       0x04    // GSO frame, IPv6 TCP
+#define VNETHDR_GSO_ECN         0x80    // TCP has ECN set
+    U16     hdr_len;                    // Length of protocol headers
+    U16     gso_size;                   // Segment size (MSS)
+    U16     csum_start;                 // Where to start checksumming
+    U16     csum_offset;                // Where to store the checksum
+};
+typedef struct TUNTAP_VNETHDR TUNTAP_VNETHDR;
 #ifdef OPTION_TUNTAP_DELADD_ROUTES
 extern int      TUNTAP_AddRoute         ( char*   pszNetDevName,
                                           char*   pszDestAddr,
@@ -194,4 +232,95 @@ extern void net_data_trace( DEVBLK* dev, BYTE* addr, int len, BYTE dir, BYTE sev
   #define TUNTAP_IOCtl          ioctl
 #endif // defined( OPTION_W32_CTCI )
 
+// ====================================================================
+//                  User-space Network Backends
+// ====================================================================
+//
+// A network backend moves whole frames (or IP packets) between an
+// emulated adapter and the host. "tap" is the kernel TUN/TAP device
+// created by TUNTAP_CreateInterface. "packet" is an AF_PACKET socket
+// bound to an existing host interface whose input is received through
+// a TPACKET_V3 memory-mapped ring. "socket" is a SOCK_SEQPACKET Unix
+// domain socket connected to a user-space peer (one frame per message)
+// which needs no privileges; it is used for testing and benchmarking.
+//
+#if !defined( OPTION_W32_CTCI ) && defined( HAVE_SYS_UIO_H )
+
+#define TUNTAP_NETBE                    // Network backends available
+
+typedef struct NETBE         NETBE;
+typedef struct NETBE_HANDLER NETBE_HANDLER;
+
+struct NETBE_HANDLER
+{
+    const char*  name;                  // Name as used on "backend"
+    int          hostif;                // Creates a TUN/TAP interface
+    int          iface;                 // Target is a host interface
+    int        (*open)  ( NETBE* be, const char* target, int l3 );
+    int        (*readv) ( NETBE* be, const struct iovec* iov, int iovcnt );
+    int        (*writev)( NETBE* be, const struct iovec* iov, int iovcnt );
+    void       (*close) ( NETBE* be );
+};
+
+struct NETBE
+{
+    const NETBE_HANDLER* hnd;           // Backend handler
+    int     fd;                         // Socket or TUN/TAP device
+    BYTE*   ring;                       // TPACKET_V3 receive ring
+    size_t  ringsize;                   // Size of the mapped ring
+    U32     blksize;                    // Size of one ring block
+    U32     blknum;                     // Number of ring blocks
+    U32     blkcur;                     // Block now being consumed
+    U32     pktleft;                    // Frames left in the block
+    BYTE*   pkt;                        // Next frame in the block
+    U64     drops;                      // Frames dropped on output
+};
+
+extern const NETBE_HANDLER   netbe_tap;
+extern const NETBE_HANDLER*  NETBE_Find      ( const char* name );
+extern int                   NETBE_SocketPair( NETBE* be, int* peerfd );
+
+//
+// Open/close a backend. The "tap" backend is opened by the caller via
+// TUNTAP_CreateInterface and merely has its file descriptor recorded.
+//
+static inline int NETBE_Open( NETBE* be, const char* target, int l3 )
+{
+    be->ring = NULL;
+    be->pkt  = NULL;
+    be->pktleft = 0;
+    be->drops = 0;
+    return be->hnd->open ? be->hnd->open( be, target, l3 ) : 0;
+}
+static inline void NETBE_Close( NETBE* be )
+{
+    if (be->hnd->close)
+        be->hnd->close( be );
+    be->fd = -1;
+}
+
+//
+// Read one frame (into one or more fragments) or write one frame. Like
+// readv/writev: return the length or -1 with errno set (EAGAIN = no
+// frame is waiting). Output the host could not queue is dropped and
+// counted in be->drops rather than reported as an error.
+//
+static inline int NETBE_Readv( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    return be->hnd->readv( be, iov, iovcnt );
+}
+static inline int NETBE_Read( NETBE* be, void* buf, int len )
+{
+    struct iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len  = len;
+    return be->hnd->readv( be, &iov, 1 );
+}
+static inline int NETBE_Writev( NETBE* be, const struct iovec* iov, int iovcnt )
+{
+    return be->hnd->writev( be, iov, iovcnt );
+}
+
+#endif // !defined( OPTION_W32_CTCI ) && defined( HAVE_SYS_UIO_H )
+
 #endif // __TUNTAP_H_
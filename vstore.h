@@ -309,6 +309,7 @@ inline void ARCH_DEP( vstore2_full )( U16 value, VADR addr, int arn, REGS* regs
 BYTE   *main1, *main2;                  /* Mainstor addresses        */
 BYTE   *sk;                             /* Storage key addresses     */
 
+    EMU_STAT( regs, crosspage );
     main1 = MADDR( addr, arn, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey );
     sk = regs->dat.storkey;
     main2 = MADDR( (addr + 1) & ADDRESS_MAXWRAP( regs ), arn, regs,
@@ -338,6 +339,7 @@ BYTE   *sk;                             /* Storage key addresses     */
 int     len;                            /* Length to end of page     */
 BYTE    temp[4];                        /* Copied value              */
 
+    EMU_STAT( regs, crosspage );
     len = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
     main1 = MADDRL( addr, len, arn, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey );
     sk = regs->dat.storkey;
@@ -372,6 +374,7 @@ BYTE   *sk;                             /* Storage key addresses     */
 int     len;                            /* Length to end of page     */
 BYTE    temp[8];                        /* Copied value              */
 
+    EMU_STAT( regs, crosspage );
     len = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
     main1 = MADDRL( addr, len, arn, regs, ACCTYPE_WRITE_SKP, regs->psw.pkey );
     sk = regs->dat.storkey;
@@ -402,6 +405,7 @@ inline U16 ARCH_DEP( vfetch2_full )( VADR addr, int arn, REGS* regs )
 BYTE   *mn;                             /* Main storage addresses    */
 U16     value;
 
+    EMU_STAT( regs, crosspage );
     mn = MADDR( addr, arn, regs, ACCTYPE_READ, regs->psw.pkey );
     value = *mn << 8;
     mn = MADDR( (addr + 1) & ADDRESS_MAXWRAP( regs ), arn, regs,
@@ -430,6 +434,7 @@ BYTE   *mn;                             /* Main storage addresses    */
 int     len;                            /* Length to end of page     */
 BYTE    temp[8];                        /* Copy destination          */
 
+    EMU_STAT( regs, crosspage );
     len = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
     mn = MADDRL( addr, len, arn, regs, ACCTYPE_READ, regs->psw.pkey );
     memcpy( temp, mn, len);
@@ -459,6 +464,8 @@ BYTE   *mn;                             /* Main storage addresses    */
 int     len;                            /* Length to end of page     */
 BYTE    temp[16];                       /* Copy destination          */
 
+    EMU_STAT( regs, crosspage );
+
     /* Get absolute address of first byte of operand */
     len = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
     mn = MADDRL( addr, len, arn, regs, ACCTYPE_READ, regs->psw.pkey );
@@ -499,6 +506,7 @@ int     len2;                           /* Length to end of page     */
     }
     else
     {
+        EMU_STAT( regs, crosspage );
         len2 = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
         main1 = MADDRL( addr, len2, arn, regs, ACCTYPE_WRITE_SKP,
                         regs->psw.pkey );
@@ -640,6 +648,7 @@ int     len2;                           /* Length to copy on page    */
     }
     else
     {
+        EMU_STAT( regs, crosspage );
         len2 = PAGEFRAME_PAGESIZE - (addr & PAGEFRAME_BYTEMASK);
         main1 = MADDRL( addr, len2, arn, regs, ACCTYPE_READ, regs->psw.pkey );
         main2 = MADDRL( (addr + len2) & ADDRESS_MAXWRAP( regs ), len + 1 - len2,
@@ -782,6 +791,8 @@ int     pagesz;                         /* Effective page size       */
 int     offset;                         /* Address offset into page  */
 int     len;                            /* Length for page crossing  */
 
+    EMU_STAT( regs, instfetch );
+
     addr = exec ? regs->ET : VALID_AIE( regs ) ?
         PSW_IA_FROM_IP( regs, 0 ) : regs->psw.IA;
 
@@ -1029,6 +1040,7 @@ int     len1,     len2;                 /* Lengths to copy           */
         else
         {
             /* (2) - Source operand crosses a boundary */
+            EMU_STAT( regs, crosspage );
             len1 = PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK);
             source2 = MADDRL( (addr2 + len1) & ADDRESS_MAXWRAP( regs ),
                    len + 1 - len1, arn2, regs, ACCTYPE_READ, key2 );
@@ -1041,6 +1053,7 @@ int     len1,     len2;                 /* Lengths to copy           */
     else
     {
         /* Destination operand crosses a boundary */
+        EMU_STAT( regs, crosspage );
         len1 = PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK);
         dest2 = MADDRL( (addr1 + len1) & ADDRESS_MAXWRAP( regs ),
             len + 1 - len1, arn1, regs, ACCTYPE_WRITE_SKP, key1 );
@@ -1182,6 +1195,7 @@ int     len1,     len2;                 /* Lengths to copy           */
         else
         {
             /* (2) - Source operand crosses a boundary */
+            EMU_STAT( regs, crosspage );
             len1 = PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK);
             source2 = MADDRL( (addr2 + len1) & ADDRESS_MAXWRAP( regs ),
                    len + 1 - len1, arn2, regs, ACCTYPE_READ, key2 );
@@ -1194,6 +1208,7 @@ int     len1,     len2;                 /* Lengths to copy           */
     else
     {
         /* Destination operand crosses a boundary */
+        EMU_STAT( regs, crosspage );
         len1 = PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK);
         dest2 = MADDRL( (addr1 + len1) & ADDRESS_MAXWRAP( regs ),
             len + 1 - len1, arn1, regs, ACCTYPE_WRITE_SKP, key1 );
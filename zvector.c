@@ -0,0 +1,3294 @@
+/* ZVECTOR.C    (C) Copyright Hercules development, 2026             */
+/*              z/Architecture Vector Facility instructions          */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This module implements the non-floating-point instructions of the */
+/* z/Architecture Vector Facility (facility bit 129) as documented   */
+/* in chapters 21-23 of SA22-7832-10 "z/Architecture Principles of   */
+/* Operation".  The vector floating point instructions are in ieee.c */
+/* next to the scalar BFP instructions whose SoftFloat support they  */
+/* share.                                                            */
+/*                                                                   */
+/* Vector registers are copied into a VRQW work area (see zvector.h) */
+/* whose layout matches the host's own 128-bit SIMD registers.  The  */
+/* element-wise compare and arithmetic helpers below, and therefore  */
+/* the string search instructions VFAE, VFEE, VFENE and VSTRC, use   */
+/* SSE2 on x86 hosts and NEON on 64-bit ARM hosts, falling back to a */
+/* simple element loop on other hosts or for element sizes that the  */
+/* host instruction set does not support.                            */
+/*-------------------------------------------------------------------*/
+
+#include "hstdinc.h"
+
+#define _ZVECTOR_C_
+#define _HENGINE_DLL_
+
+#include "hercules.h"
+#include "opcode.h"
+#include "inline.h"
+#include "zvector.h"
+
+#if defined( FEATURE_129_ZVECTOR_FACILITY )
+
+#if !defined( _ZVECTOR_NONARCHDEP_ )
+
+/*-------------------------------------------------------------------*/
+/*                     Element size helpers                          */
+/*-------------------------------------------------------------------*/
+#define ES_NUM( _es )       (16 >> (_es))   /* Elements per vector   */
+#define ES_BITS( _es )      ( 8 << (_es))   /* Bits per element      */
+#define ES_MASK( _es )      ((_es) >= 3 ? 0xFFFFFFFFFFFFFFFFULL      \
+                                 : ((1ULL << ES_BITS( _es )) - 1))
+
+static const U64 es_lsbs[4] =           /* Rightmost bit of each     */
+{                                       /* element of a doubleword   */
+    0x0101010101010101ULL,
+    0x0001000100010001ULL,
+    0x0000000100000001ULL,
+    0x0000000000000001ULL,
+};
+
+/*-------------------------------------------------------------------*/
+/*              Access a vector element by its size                  */
+/*-------------------------------------------------------------------*/
+static INLINE U64 vr_get( const VRQW* vr, int es, int i )
+{
+    switch (es)
+    {
+    case 0:  return VR_B( *vr, i );
+    case 1:  return VR_H( *vr, i );
+    case 2:  return VR_F( *vr, i );
+    default: return VR_D( *vr, i );
+    }
+}
+
+static INLINE S64 vr_gets( const VRQW* vr, int es, int i )
+{
+    switch (es)
+    {
+    case 0:  return (S8)  VR_B( *vr, i );
+    case 1:  return (S16) VR_H( *vr, i );
+    case 2:  return (S32) VR_F( *vr, i );
+    default: return (S64) VR_D( *vr, i );
+    }
+}
+
+static INLINE void vr_put( VRQW* vr, int es, int i, U64 val )
+{
+    switch (es)
+    {
+    case 0:  VR_B( *vr, i ) = (BYTE) val; break;
+    case 1:  VR_H( *vr, i ) = (U16)  val; break;
+    case 2:  VR_F( *vr, i ) = (U32)  val; break;
+    default: VR_D( *vr, i ) =        val; break;
+    }
+}
+
+/* Set every element of the vector to the same value */
+static INLINE void vr_splat( VRQW* vr, int es, U64 val )
+{
+    vr->d[0] = vr->d[1] = (val & ES_MASK( es )) * es_lsbs[ es ];
+}
+
+/* Result is element a where the mask is ones, element b otherwise */
+static INLINE void vr_select( VRQW* r, const VRQW* m,
+                              const VRQW* a, const VRQW* b )
+{
+    r->d[0] = (a->d[0] & m->d[0]) | (b->d[0] & ~m->d[0]);
+    r->d[1] = (a->d[1] & m->d[1]) | (b->d[1] & ~m->d[1]);
+}
+
+/*-------------------------------------------------------------------*/
+/*                       Bit count helpers                           */
+/*-------------------------------------------------------------------*/
+static INLINE int zv_clz64( U64 x )     /* (x must not be zero)      */
+{
+#if defined( __GNUC__ )
+    return __builtin_clzll( x );
+#else
+    int  n  = 0;
+    for (; !(x & 0x8000000000000000ULL); x <<= 1)
+        n++;
+    return n;
+#endif
+}
+
+static INLINE int zv_ctz64( U64 x )     /* (x must not be zero)      */
+{
+#if defined( __GNUC__ )
+    return __builtin_ctzll( x );
+#else
+    int  n  = 0;
+    for (; !(x & 1); x >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*  Return the byte index of the leftmost nonzero byte of a vector,  */
+/*  or 16 if the vector is all zeros.  Since each doubleword of the  */
+/*  work area holds its numeric value, the leftmost byte is always   */
+/*  the most significant one regardless of the host's byte order.    */
+/*-------------------------------------------------------------------*/
+static INLINE int vr_leftmost( const VRQW* vr )
+{
+    if (vr->d[0])
+        return      zv_clz64( vr->d[0] ) >> 3;
+    if (vr->d[1])
+        return 8 + (zv_clz64( vr->d[1] ) >> 3);
+    return 16;
+}
+
+/*-------------------------------------------------------------------*/
+/*             Element-wise compare and arithmetic                   */
+/*-------------------------------------------------------------------*/
+/* The compares set each element of the result to all ones if the    */
+/* comparison is true, else to all zeros.  Element sizes the host's  */
+/* SIMD unit can handle directly are done with a single instruction; */
+/* all others (e.g. doublewords on SSE2) fall through to the loop.   */
+/*-------------------------------------------------------------------*/
+#if defined( ZVECTOR_NEON )
+  #define NEON_OP( _op, _t, _a, _b )                                  \
+    vreinterpretq_u8_u ## _t( _op( vreinterpretq_u ## _t ## _u8( _a ),\
+                                   vreinterpretq_u ## _t ## _u8( _b )))
+  #define NEON_SOP( _op, _t, _a, _b )                                 \
+    vreinterpretq_u8_u ## _t( _op( vreinterpretq_s ## _t ## _u8( _a ),\
+                                   vreinterpretq_s ## _t ## _u8( _b )))
+#endif
+
+static INLINE void vr_cmpeq( VRQW* r, const VRQW* a, const VRQW* b, int es )
+{
+    int  i;
+
+#if defined( ZVECTOR_SSE2 )
+    switch (es)
+    {
+    case 0: r->x = _mm_cmpeq_epi8 ( a->x, b->x ); return;
+    case 1: r->x = _mm_cmpeq_epi16( a->x, b->x ); return;
+    case 2: r->x = _mm_cmpeq_epi32( a->x, b->x ); return;
+    }
+#elif defined( ZVECTOR_NEON )
+    switch (es)
+    {
+    case 0: r->x = vceqq_u8( a->x, b->x );               return;
+    case 1: r->x = NEON_OP( vceqq_u16, 16, a->x, b->x ); return;
+    case 2: r->x = NEON_OP( vceqq_u32, 32, a->x, b->x ); return;
+    case 3: r->x = NEON_OP( vceqq_u64, 64, a->x, b->x ); return;
+    }
+#endif
+    for (i=0; i < ES_NUM( es ); i++)
+        vr_put( r, es, i, vr_get( a, es, i ) == vr_get( b, es, i ) ? ~0ULL : 0 );
+}
+
+/* Signed compare high: a > b */
+static INLINE void vr_cmph( VRQW* r, const VRQW* a, const VRQW* b, int es )
+{
+    int  i;
+
+#if defined( ZVECTOR_SSE2 )
+    switch (es)
+    {
+    case 0: r->x = _mm_cmpgt_epi8 ( a->x, b->x ); return;
+    case 1: r->x = _mm_cmpgt_epi16( a->x, b->x ); return;
+    case 2: r->x = _mm_cmpgt_epi32( a->x, b->x ); return;
+    }
+#elif defined( ZVECTOR_NEON )
+    switch (es)
+    {
+    case 0: r->x = vcgtq_s8( vreinterpretq_s8_u8( a->x ),
+                             vreinterpretq_s8_u8( b->x ));    return;
+    case 1: r->x = NEON_SOP( vcgtq_s16, 16, a->x, b->x );     return;
+    case 2: r->x = NEON_SOP( vcgtq_s32, 32, a->x, b->x );     return;
+    case 3: r->x = NEON_SOP( vcgtq_s64, 64, a->x, b->x );     return;
+    }
+#endif
+    for (i=0; i < ES_NUM( es ); i++)
+        vr_put( r, es, i, vr_gets( a, es, i ) > vr_gets( b, es, i ) ? ~0ULL : 0 );
+}
+
+/* Logical (unsigned) compare high: a > b */
+static INLINE void vr_cmphl( VRQW* r, const VRQW* a, const VRQW* b, int es )
+{
+    int  i;
+
+#if defined( ZVECTOR_SSE2 )
+    if (es < 3)
+    {
+        __m128i  bias, ax, bx;          /* (flip the sign bits)      */
+
+        switch (es)
+        {
+        case 0:  bias = _mm_set1_epi8 ( (char)  0x80       ); break;
+        case 1:  bias = _mm_set1_epi16( (short) 0x8000     ); break;
+        default: bias = _mm_set1_epi32( (int)   0x80000000 ); break;
+        }
+        ax = _mm_xor_si128( a->x, bias );
+        bx = _mm_xor_si128( b->x, bias );
+
+        switch (es)
+        {
+        case 0:  r->x = _mm_cmpgt_epi8 ( ax, bx ); return;
+        case 1:  r->x = _mm_cmpgt_epi16( ax, bx ); return;
+        default: r->x = _mm_cmpgt_epi32( ax, bx ); return;
+        }
+    }
+#elif defined( ZVECTOR_NEON )
+    switch (es)
+    {
+    case 0: r->x = vcgtq_u8( a->x, b->x );                 return;
+    case 1: r->x = NEON_OP( vcgtq_u16, 16, a->x, b->x ); return;
+    case 2: r->x = NEON_OP( vcgtq_u32, 32, a->x, b->x ); return;
+    case 3: r->x = NEON_OP( vcgtq_u64, 64, a->x, b->x ); return;
+    }
+#endif
+    for (i=0; i < ES_NUM( es ); i++)
+        vr_put( r, es, i, vr_get( a, es, i ) > vr_get( b, es, i ) ? ~0ULL : 0 );
+}
+
+/* Modulo add and subtract */
+static INLINE void vr_add( VRQW* r, const VRQW* a, const VRQW* b, int es )
+{
+    int  i;
+
+#if defined( ZVECTOR_SSE2 )
+    switch (es)
+    {
+    case 0: r->x = _mm_add_epi8 ( a->x, b->x ); return;
+    case 1: r->x = _mm_add_epi16( a->x, b->x ); return;
+    case 2: r->x = _mm_add_epi32( a->x, b->x ); return;
+    case 3: r->x = _mm_add_epi64( a->x, b->x ); return;
+    }
+#elif defined( ZVECTOR_NEON )
+    switch (es)
+    {
+    case 0: r->x = vaddq_u8( a->x, b->x );                 return;
+    case 1: r->x = NEON_OP( vaddq_u16, 16, a->x, b->x ); return;
+    case 2: r->x = NEON_OP( vaddq_u32, 32, a->x, b->x ); return;
+    case 3: r->x = NEON_OP( vaddq_u64, 64, a->x, b->x ); return;
+    }
+#endif
+    for (i=0; i < ES_NUM( es ); i++)
+        vr_put( r, es, i, vr_get( a, es, i ) + vr_get( b, es, i ));
+}
+
+static INLINE void vr_sub( VRQW* r, const VRQW* a, const VRQW* b, int es )
+{
+    int  i;
+
+#if defined( ZVECTOR_SSE2 )
+    switch (es)
+    {
+    case 0: r->x = _mm_sub_epi8 ( a->x, b->x ); return;
+    case 1: r->x = _mm_sub_epi16( a->x, b->x ); return;
+    case 2: r->x = _mm_sub_epi32( a->x, b->x ); return;
+    case 3: r->x = _mm_sub_epi64( a->x, b->x ); return;
+    }
+#elif defined( ZVECTOR_NEON )
+    switch (es)
+    {
+    case 0: r->x = vsubq_u8( a->x, b->x );                 return;
+    case 1: r->x = NEON_OP( vsubq_u16, 16, a->x, b->x ); return;
+    case 2: r->x = NEON_OP( vsubq_u32, 32, a->x, b->x ); return;
+    case 3: r->x = NEON_OP( vsubq_u64, 64, a->x, b->x ); return;
+    }
+#endif
+    for (i=0; i < ES_NUM( es ); i++)
+        vr_put( r, es, i, vr_get( a, es, i ) - vr_get( b, es, i ));
+}
+
+/*-------------------------------------------------------------------*/
+/*                    128-bit arithmetic helpers                     */
+/*-------------------------------------------------------------------*/
+/* Add two quadwords plus a carry in, returning the carry out        */
+static INLINE int zv_add128( VRQW* r, const VRQW* a, const VRQW* b, int cin )
+{
+    U64  lo, hi;
+    int  c;
+
+    lo = a->d[1] + b->d[1];
+    c  = lo < a->d[1];
+    lo += cin;
+    c |= lo < (U64) cin;
+
+    hi = a->d[0] + b->d[0];
+    cin = c;
+    c  = hi < a->d[0];
+    hi += cin;
+    c |= hi < (U64) cin;
+
+    r->d[0] = hi;
+    r->d[1] = lo;
+    return c;
+}
+
+/* Shift a quadword left or right by 0-127 bits */
+static INLINE void zv_shl128( VRQW* r, const VRQW* a, int n )
+{
+    U64  hi = a->d[0], lo = a->d[1];
+
+    if (n >= 64)     { hi = lo << (n - 64); lo = 0; }
+    else if (n)      { hi = (hi << n) | (lo >> (64 - n)); lo <<= n; }
+    r->d[0] = hi;
+    r->d[1] = lo;
+}
+
+static INLINE void zv_shr128( VRQW* r, const VRQW* a, int n, bool arith )
+{
+    U64  hi = a->d[0], lo = a->d[1];
+    U64  fill = (arith && (S64) hi < 0) ? ~0ULL : 0;
+
+    if (n >= 64)
+    {
+        lo = (n == 64) ? hi : (hi >> (n - 64)) | (fill << (128 - n));
+        hi = fill;
+    }
+    else if (n)
+    {
+        lo = (lo >> n) | (hi << (64 - n));
+        hi = (hi >> n) | (fill << (64 - n));
+    }
+    r->d[0] = hi;
+    r->d[1] = lo;
+}
+
+/* Carry-less multiply of two doublewords giving a quadword */
+static INLINE void zv_clmul64( VRQW* r, U64 a, U64 b )
+{
+    U64  hi = 0, lo = 0;
+    int  i;
+
+    for (i=0; i < 64; i++, b >>= 1)
+    {
+        if (b & 1)
+        {
+            lo ^= a << i;
+            if (i)
+                hi ^= a >> (64 - i);
+        }
+    }
+    r->d[0] = hi;
+    r->d[1] = lo;
+}
+
+/*-------------------------------------------------------------------*/
+/*     Element count helpers for VCLZ, VCTZ and VECTOR STRING ops    */
+/*-------------------------------------------------------------------*/
+static INLINE U64 zv_clz( U64 x, int es )
+{
+    return x ? (U64)(zv_clz64( x ) - (64 - ES_BITS( es ))) : (U64) ES_BITS( es );
+}
+
+static INLINE U64 zv_ctz( U64 x, int es )
+{
+    return x ? (U64) zv_ctz64( x ) : (U64) ES_BITS( es );
+}
+
+/* Rotate an element left by n (0 to element size - 1) bits */
+static INLINE U64 zv_rotl( U64 x, int n, int es )
+{
+    if (!n)
+        return x;
+    return ((x << n) | (x >> (ES_BITS( es ) - n))) & ES_MASK( es );
+}
+
+/* Set the condition code from an all-ones/all-zeros element mask   */
+/* as the vector compare instructions do: 0 if every element was    */
+/* true, 3 if none was, 1 otherwise.                                */
+static INLINE BYTE zv_mask_cc( const VRQW* m )
+{
+    if ((m->d[0] & m->d[1]) == ~0ULL)
+        return 0;
+    if ((m->d[0] | m->d[1]) == 0)
+        return 3;
+    return 1;
+}
+
+/* Condition code for the VECTOR FIND and STRING RANGE instructions */
+static INLINE BYTE zv_find_cc( int first_match, int first_zero )
+{
+    if (first_zero == 16 && first_match == 16)
+        return 3;                       /* No match, no zero         */
+    if (first_zero == 16)
+        return 1;                       /* Match, no zero            */
+    if (first_match < first_zero)
+        return 2;                       /* Match before the zero     */
+    return 0;                           /* Zero came first           */
+}
+
+#endif /* !defined( _ZVECTOR_NONARCHDEP_ ) */
+
+/*-------------------------------------------------------------------*/
+/*      Program check if element size or index is out of range       */
+/*-------------------------------------------------------------------*/
+#undef  ZVECTOR_SPEC_CHECK
+#define ZVECTOR_SPEC_CHECK( _cond, _regs )                            \
+    if (_cond)                                                        \
+        (_regs)->program_interrupt( (_regs), PGM_SPECIFICATION_EXCEPTION )
+
+/*-------------------------------------------------------------------*/
+/* E700 VLEB   - Vector Load Element (8)                       [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_8 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_B( vr, m3 ) = ARCH_DEP( vfetchb )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E701 VLEH   - Vector Load Element (16)                      [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_16 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 7, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_H( vr, m3 ) = ARCH_DEP( vfetch2 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E702 VLEG   - Vector Load Element (64)                      [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_64 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 1, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_D( vr, m3 ) = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E703 VLEF   - Vector Load Element (32)                      [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_32 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_F( vr, m3 ) = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/*   Fetch one element of the given size from storage                */
+/*-------------------------------------------------------------------*/
+static INLINE U64 ARCH_DEP( zv_fetch_element )( int es, VADR addr, int arn, REGS* regs )
+{
+    switch (es)
+    {
+    case 0:  return ARCH_DEP( vfetchb )( addr, arn, regs );
+    case 1:  return ARCH_DEP( vfetch2 )( addr, arn, regs );
+    case 2:  return ARCH_DEP( vfetch4 )( addr, arn, regs );
+    default: return ARCH_DEP( vfetch8 )( addr, arn, regs );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* E704 VLLEZ  - Vector Load Logical Element and Zero          [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_logical_element_and_zero )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    /* The element goes into the rightmost element of doubleword 0 */
+    vr.d[0] = ARCH_DEP( zv_fetch_element )( m3, effective_addr2, b2, regs );
+    vr.d[1] = 0;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E705 VLREP  - Vector Load and Replicate                     [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_and_replicate )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_splat( &vr, m3, ARCH_DEP( zv_fetch_element )( m3, effective_addr2, b2, regs ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E706 VL     - Vector Load                                   [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Operand work area         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    UNREFERENCED( m3 );                 /* (alignment hint only)     */
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    ARCH_DEP( vfetchc )( buf, sizeof( buf ) - 1, effective_addr2, b2, regs );
+    vr.d[0] = fetch_dw( buf     );
+    vr.d[1] = fetch_dw( buf + 8 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E707 VLBB   - Vector Load to Block Boundary                 [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_to_block_boundary )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Operand work area         */
+U32     boundary;                       /* Block boundary size       */
+int     len;                            /* Bytes to block boundary   */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 6, regs );
+
+    boundary = 64 << m3;
+    len = boundary - (effective_addr2 & (boundary - 1));
+    if (len > 16)
+        len = 16;
+
+    /* Bytes beyond the boundary are unpredictable: keep old ones */
+    vr_fetch( regs, v1, &vr );
+    store_dw( buf,     vr.d[0] );
+    store_dw( buf + 8, vr.d[1] );
+
+    ARCH_DEP( vfetchc )( buf, len - 1, effective_addr2, b2, regs );
+
+    vr.d[0] = fetch_dw( buf     );
+    vr.d[1] = fetch_dw( buf + 8 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E708 VSTEB  - Vector Store Element (8)                      [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_element_8 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstoreb )( VR_B( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E709 VSTEH  - Vector Store Element (16)                     [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_element_16 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 7, regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstore2 )( VR_H( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E70A VSTEG  - Vector Store Element (64)                     [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_element_64 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 1, regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstore8 )( VR_D( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E70B VSTEF  - Vector Store Element (32)                     [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_element_32 )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstore4 )( VR_F( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E70E VST    - Vector Store                                  [VRX] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store )
+{
+int     v1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Operand work area         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRX( inst, regs, v1, b2, effective_addr2, m3 );
+
+    UNREFERENCED( m3 );                 /* (alignment hint only)     */
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &vr );
+    store_dw( buf,     vr.d[0] );
+    store_dw( buf + 8, vr.d[1] );
+    ARCH_DEP( vstorec )( buf, sizeof( buf ) - 1, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E712 VGEG   - Vector Gather Element (64)                    [VRV] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_gather_element_64 )
+{
+int     v1, v2, m3, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr, vx;                         /* Vector work areas         */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 1, regs );
+
+    vr_fetch( regs, v2, &vx );
+    effective_addr2 = (effective_addr2 + VR_D( vx, m3 )) & ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_D( vr, m3 ) = ARCH_DEP( vfetch8 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E713 VGEF   - Vector Gather Element (32)                    [VRV] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_gather_element_32 )
+{
+int     v1, v2, m3, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr, vx;                         /* Vector work areas         */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &vx );
+    effective_addr2 = (effective_addr2 + VR_F( vx, m3 )) & ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_F( vr, m3 ) = ARCH_DEP( vfetch4 )( effective_addr2, b2, regs );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E71A VSCEG  - Vector Scatter Element (64)                   [VRV] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_scatter_element_64 )
+{
+int     v1, v2, m3, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr, vx;                         /* Vector work areas         */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 1, regs );
+
+    vr_fetch( regs, v2, &vx );
+    effective_addr2 = (effective_addr2 + VR_D( vx, m3 )) & ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstore8 )( VR_D( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E71B VSCEF  - Vector Scatter Element (32)                   [VRV] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_scatter_element_32 )
+{
+int     v1, v2, m3, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr, vx;                         /* Vector work areas         */
+
+    VRV( inst, regs, v1, v2, b2, effective_addr2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &vx );
+    effective_addr2 = (effective_addr2 + VR_F( vx, m3 )) & ADDRESS_MAXWRAP( regs );
+
+    vr_fetch( regs, v1, &vr );
+    ARCH_DEP( vstore4 )( VR_F( vr, m3 ), effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E721 VLGV   - Vector Load GR from VR Element              [VRS-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_gr_from_vr_element )
+{
+int     r1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRS_C( inst, regs, r1, v3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    /* The second operand address is used as the element index */
+    vr_fetch( regs, v3, &vr );
+    regs->GR_G( r1 ) = vr_get( &vr, m4, effective_addr2 & (ES_NUM( m4 ) - 1) );
+}
+
+/*-------------------------------------------------------------------*/
+/* E722 VLVG   - Vector Load VR Element from GR              [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vr_element_from_gr )
+{
+int     v1, r3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v1, &vr );
+    vr_put( &vr, m4, effective_addr2 & (ES_NUM( m4 ) - 1), regs->GR_G( r3 ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E727 LCBB   - Load Count to Block Boundary                  [RXE] */
+/*-------------------------------------------------------------------*/
+DEF_INST( load_count_to_block_boundary )
+{
+int     r1, m3, b2;                     /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+U32     boundary;                       /* Block boundary size       */
+U32     count;                          /* Bytes to block boundary   */
+
+    RXE_M3( inst, regs, r1, b2, effective_addr2, m3 );
+
+    ZVECTOR_SPEC_CHECK( m3 > 6, regs );
+
+    boundary = 64 << m3;
+    count = boundary - (effective_addr2 & (boundary - 1));
+    if (count > 16)
+        count = 16;
+
+    regs->GR_L( r1 ) = count;
+    regs->psw.cc = (count == 16) ? 0 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E730 VESL   - Vector Element Shift Left                   [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_left )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Element index, count      */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    n = effective_addr2 & (ES_BITS( m4 ) - 1);
+    vr_fetch( regs, v3, &vr );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &vr, m4, i, vr_get( &vr, m4, i ) << n );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E733 VERLL  - Vector Element Rotate Left Logical          [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_rotate_left_logical )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Element index, count      */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    n = effective_addr2 & (ES_BITS( m4 ) - 1);
+    vr_fetch( regs, v3, &vr );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &vr, m4, i, zv_rotl( vr_get( &vr, m4, i ), n, m4 ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E736 VLM    - Vector Load Multiple                        [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_multiple )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[256];                       /* Operand work area         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Register index, count     */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    UNREFERENCED( m4 );                 /* (alignment hint only)     */
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( v3 < v1 || v3 - v1 > 15, regs );
+
+    /* Fetch the whole operand before any register is changed */
+    n = v3 - v1 + 1;
+    ARCH_DEP( vfetchc )( buf, (n * 16) - 1, effective_addr2, b2, regs );
+
+    for (i=0; i < n; i++)
+    {
+        vr.d[0] = fetch_dw( buf + (i * 16)     );
+        vr.d[1] = fetch_dw( buf + (i * 16) + 8 );
+        vr_store( regs, v1 + i, &vr );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* E737 VLL    - Vector Load With Length                     [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_with_length )
+{
+int     v1, r3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Operand work area         */
+U32     len;                            /* Highest byte index        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+
+    UNREFERENCED( m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    len = regs->GR_L( r3 );
+    if (len > 15)
+        len = 15;
+
+    memset( buf, 0, sizeof( buf ));
+    ARCH_DEP( vfetchc )( buf, len, effective_addr2, b2, regs );
+
+    vr.d[0] = fetch_dw( buf     );
+    vr.d[1] = fetch_dw( buf + 8 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E738 VESRL  - Vector Element Shift Right Logical          [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_right_logical )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Element index, count      */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    n = effective_addr2 & (ES_BITS( m4 ) - 1);
+    vr_fetch( regs, v3, &vr );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &vr, m4, i, vr_get( &vr, m4, i ) >> n );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E73A VESRA  - Vector Element Shift Right Arithmetic       [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_right_arithmetic )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Element index, count      */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    n = effective_addr2 & (ES_BITS( m4 ) - 1);
+    vr_fetch( regs, v3, &vr );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &vr, m4, i, (U64)(vr_gets( &vr, m4, i ) >> n ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E73E VSTM   - Vector Store Multiple                       [VRS-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_multiple )
+{
+int     v1, v3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[256];                       /* Operand work area         */
+VRQW    vr;                             /* Vector work area          */
+int     i, n;                           /* Register index, count     */
+
+    VRS_A( inst, regs, v1, v3, b2, effective_addr2, m4 );
+
+    UNREFERENCED( m4 );                 /* (alignment hint only)     */
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( v3 < v1 || v3 - v1 > 15, regs );
+
+    n = v3 - v1 + 1;
+    for (i=0; i < n; i++)
+    {
+        vr_fetch( regs, v1 + i, &vr );
+        store_dw( buf + (i * 16),     vr.d[0] );
+        store_dw( buf + (i * 16) + 8, vr.d[1] );
+    }
+    ARCH_DEP( vstorec )( buf, (n * 16) - 1, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E73F VSTL   - Vector Store With Length                    [VRS-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_store_with_length )
+{
+int     v1, r3, m4, b2;                 /* Instruction fields        */
+VADR    effective_addr2;                /* Effective address         */
+BYTE    buf[16];                        /* Operand work area         */
+U32     len;                            /* Highest byte index        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRS_B( inst, regs, v1, r3, b2, effective_addr2, m4 );
+
+    UNREFERENCED( m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    len = regs->GR_L( r3 );
+    if (len > 15)
+        len = 15;
+
+    vr_fetch( regs, v1, &vr );
+    store_dw( buf,     vr.d[0] );
+    store_dw( buf + 8, vr.d[1] );
+    ARCH_DEP( vstorec )( buf, len, effective_addr2, b2, regs );
+}
+
+/*-------------------------------------------------------------------*/
+/* E740 VLEIB  - Vector Load Element Immediate (8)           [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_immediate_8 )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_B( vr, m3 ) = (BYTE) i2;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E741 VLEIH  - Vector Load Element Immediate (16)          [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_immediate_16 )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 7, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_H( vr, m3 ) = (U16) i2;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E742 VLEIG  - Vector Load Element Immediate (64)          [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_immediate_64 )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 1, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_D( vr, m3 ) = (U64)(S64)(S16) i2;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E743 VLEIF  - Vector Load Element Immediate (32)          [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_element_immediate_32 )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v1, &vr );
+    VR_F( vr, m3 ) = (U32)(S32)(S16) i2;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E744 VGBM   - Vector Generate Byte Mask                   [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_generate_byte_mask )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+int     i;                              /* Byte index                */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    UNREFERENCED( m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    for (i=0; i < 16; i++)
+        VR_B( vr, i ) = (i2 & (0x8000 >> i)) ? 0xFF : 0x00;
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E745 VREPI  - Vector Replicate Immediate                  [VRI-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_replicate_immediate )
+{
+int     v1, i2, m3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_A( inst, regs, v1, i2, m3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_splat( &vr, m3, (U64)(S64)(S16) i2 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E746 VGM    - Vector Generate Mask                        [VRI-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_generate_mask )
+{
+int     v1, i2, i3, m4;                 /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+U64     mask = 0;                       /* Generated element mask    */
+int     bits, b;                        /* Element size, bit number  */
+
+    VRI_B( inst, regs, v1, i2, i3, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    /* Bits i2 through i3 are set, wrapping around if i2 > i3 */
+    bits = ES_BITS( m4 );
+    i2 &= bits - 1;
+    i3 &= bits - 1;
+    for (b = i2;; b = (b + 1) & (bits - 1))
+    {
+        mask |= 1ULL << (bits - 1 - b);
+        if (b == i3)
+            break;
+    }
+
+    vr_splat( &vr, m4, mask );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E74D VREP   - Vector Replicate                            [VRI-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_replicate )
+{
+int     v1, v3, i2, m4;                 /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRI_C( inst, regs, v1, v3, i2, m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3 || i2 >= ES_NUM( m4 ), regs );
+
+    vr_fetch( regs, v3, &vr );
+    vr_splat( &vr, m4, vr_get( &vr, m4, i2 ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E750 VPOPCT - Vector Population Count                     [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_population_count )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+U64     x;                              /* Doubleword being counted  */
+int     i;                              /* Doubleword index          */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 != 0, regs );
+
+    /* Count the one bits of all eight bytes of a doubleword at once */
+    vr_fetch( regs, v2, &vr );
+    for (i=0; i < 2; i++)
+    {
+        x = vr.d[i];
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        vr.d[i] = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    }
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E752 VCTZ   - Vector Count Trailing Zeros                 [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_count_trailing_zeros )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+int     i;                              /* Element index             */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &vr );
+    for (i=0; i < ES_NUM( m3 ); i++)
+        vr_put( &vr, m3, i, zv_ctz( vr_get( &vr, m3, i ), m3 ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E753 VCLZ   - Vector Count Leading Zeros                  [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_count_leading_zeros )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+int     i;                              /* Element index             */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &vr );
+    for (i=0; i < ES_NUM( m3 ); i++)
+        vr_put( &vr, m3, i, zv_clz( vr_get( &vr, m3, i ), m3 ));
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E756 VLR    - Vector Load Vector                          [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vector )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m3 );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &vr );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E75C VISTR  - Vector Isolate String                       [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_isolate_string )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr, zero, zm;                   /* Vector work areas         */
+int     first_zero;                     /* Byte index of zero elem   */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 2, regs );
+
+    vr_fetch( regs, v2, &vr );
+    zero.d[0] = zero.d[1] = 0;
+    vr_cmpeq( &zm, &vr, &zero, m3 );
+    first_zero = vr_leftmost( &zm );
+
+    /* Clear the zero element and everything to the right of it */
+    if (first_zero < 8)
+    {
+        vr.d[0] &= first_zero ? ~0ULL << (64 - (first_zero * 8)) : 0;
+        vr.d[1]  = 0;
+    }
+    else if (first_zero < 16)
+        vr.d[1] &= (first_zero > 8) ? ~0ULL << (128 - (first_zero * 8)) : 0;
+
+    vr_store( regs, v1, &vr );
+
+    if (m5 & 0x1)
+        regs->psw.cc = (first_zero < 16) ? 0 : 3;
+}
+
+/*-------------------------------------------------------------------*/
+/* E75F VSEG   - Vector Sign Extend to Doubleword            [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_sign_extend_to_doubleword )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+int     i;                              /* Doubleword index          */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 2, regs );
+
+    /* The rightmost element of each doubleword is sign extended */
+    vr_fetch( regs, v2, &vr );
+    for (i=0; i < 2; i++)
+        vr.d[i] = (U64) vr_gets( &vr, m3, ((i + 1) * (ES_NUM( m3 ) / 2)) - 1 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E760 VMRL   - Vector Merge Low                            [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_merge_low )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+int     i, n;                           /* Element index, count      */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = ES_NUM( m4 ) / 2;
+    for (i=0; i < n; i++)
+    {
+        vr_put( &r, m4, (i * 2),     vr_get( &a, m4, n + i ));
+        vr_put( &r, m4, (i * 2) + 1, vr_get( &b, m4, n + i ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E761 VMRH   - Vector Merge High                           [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_merge_high )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+int     i, n;                           /* Element index, count      */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = ES_NUM( m4 ) / 2;
+    for (i=0; i < n; i++)
+    {
+        vr_put( &r, m4, (i * 2),     vr_get( &a, m4, i ));
+        vr_put( &r, m4, (i * 2) + 1, vr_get( &b, m4, i ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E762 VLVGP  - Vector Load VR from GRs Disjoint            [VRR-f] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_vr_from_grs_disjoint )
+{
+int     v1, r2, r3;                     /* Instruction fields        */
+VRQW    vr;                             /* Vector work area          */
+
+    VRR_F( inst, regs, v1, r2, r3 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr.d[0] = regs->GR_G( r2 );
+    vr.d[1] = regs->GR_G( r3 );
+    vr_store( regs, v1, &vr );
+}
+
+/*-------------------------------------------------------------------*/
+/* E764 VSUM   - Vector Sum Across Word                      [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_sum_across_word )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+int     i, j, n;                        /* Indexes, elements/word    */
+U32     sum;                            /* Word sum                  */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 1, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = 4 >> m4;
+    for (i=0; i < 4; i++)
+    {
+        /* Elements of word i plus the rightmost element of word i */
+        sum = (U32) vr_get( &b, m4, (i * n) + n - 1 );
+        for (j=0; j < n; j++)
+            sum += (U32) vr_get( &a, m4, (i * n) + j );
+        VR_F( r, i ) = sum;
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E765 VSUMG  - Vector Sum Across Doubleword                [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_sum_across_doubleword )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+int     i, j, n;                        /* Indexes, elements/dword   */
+U64     sum;                            /* Doubleword sum            */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 < 1 || m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = 8 >> m4;
+    for (i=0; i < 2; i++)
+    {
+        sum = vr_get( &b, m4, (i * n) + n - 1 );
+        for (j=0; j < n; j++)
+            sum += vr_get( &a, m4, (i * n) + j );
+        r.d[i] = sum;
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E766 VCKSM  - Vector Checksum                             [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_checksum )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+U32     sum, prev;                      /* Checksum                  */
+int     i;                              /* Word index                */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    /* Add the words with end-around carry */
+    sum = VR_F( b, 1 );
+    for (i=0; i < 4; i++)
+    {
+        prev = sum;
+        sum += VR_F( a, i );
+        if (sum < prev)
+            sum++;
+    }
+
+    r.d[0] = sum;
+    r.d[1] = 0;
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E767 VSUMQ  - Vector Sum Across Quadword                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_sum_across_quadword )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r, t;                     /* Vector work areas         */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 < 2 || m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    r.d[0] = 0;
+    r.d[1] = vr_get( &b, m4, ES_NUM( m4 ) - 1 );
+    t.d[0] = 0;
+    for (i=0; i < ES_NUM( m4 ); i++)
+    {
+        t.d[1] = vr_get( &a, m4, i );
+        zv_add128( &r, &r, &t, 0 );
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E768 VN     - Vector AND                                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_and )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    a.d[0] &= b.d[0];
+    a.d[1] &= b.d[1];
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E769 VNC    - Vector AND with Complement                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_and_with_complement )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    a.d[0] &= ~b.d[0];
+    a.d[1] &= ~b.d[1];
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E76A VO     - Vector OR                                   [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_or )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    a.d[0] |= b.d[0];
+    a.d[1] |= b.d[1];
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E76B VNO    - Vector NOR                                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_nor )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    a.d[0] = ~(a.d[0] | b.d[0]);
+    a.d[1] = ~(a.d[1] | b.d[1]);
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E76D VX     - Vector Exclusive OR                         [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_exclusive_or )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    a.d[0] ^= b.d[0];
+    a.d[1] ^= b.d[1];
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E770 VESLV  - Vector Element Shift Left Vector            [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_left_vector )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &a, m4, i, vr_get( &a, m4, i )
+                << (vr_get( &b, m4, i ) & (ES_BITS( m4 ) - 1)));
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E772 VERIM  - Vector Element Rotate and Insert Under Mask [VRI-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_rotate_and_insert_under_mask )
+{
+int     v1, v2, v3, i4, m5;             /* Instruction fields        */
+VRQW    r, a, m;                        /* Vector work areas         */
+U64     rot;                            /* Rotated element           */
+int     i, n;                           /* Element index, count      */
+
+    VRI_D( inst, regs, v1, v2, v3, i4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m5 > 3, regs );
+
+    vr_fetch( regs, v1, &r );
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &m );
+    n = i4 & (ES_BITS( m5 ) - 1);
+    for (i=0; i < ES_NUM( m5 ); i++)
+    {
+        rot = zv_rotl( vr_get( &a, m5, i ), n, m5 );
+        vr_put( &r, m5, i, (vr_get( &r, m5, i ) & ~vr_get( &m, m5, i ))
+                                     | (rot &  vr_get( &m, m5, i )));
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E773 VERLLV - Vector Element Rotate Left Logical Vector   [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_rotate_left_logical_vector )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &a, m4, i, zv_rotl( vr_get( &a, m4, i ),
+                (int)(vr_get( &b, m4, i ) & (ES_BITS( m4 ) - 1)), m4 ));
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E774 VSL    - Vector Shift Left                           [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_left )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shl128( &a, &a, VR_B( b, 7 ) & 0x07 );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E775 VSLB   - Vector Shift Left by Byte                   [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_left_by_byte )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shl128( &a, &a, VR_B( b, 7 ) & 0x78 );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E777 VSLDB  - Vector Shift Left Double by Byte            [VRI-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_left_double_by_byte )
+{
+int     v1, v2, v3, i4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+int     n;                              /* Shift amount in bits      */
+
+    VRI_D( inst, regs, v1, v2, v3, i4, m5 );
+
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    /* Bytes i4 through i4+15 of the concatenated v2 and v3 */
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = (i4 & 0x0F) * 8;
+    if (n)
+    {
+        zv_shl128( &a, &a, n );
+        zv_shr128( &b, &b, 128 - n, false );
+        a.d[0] |= b.d[0];
+        a.d[1] |= b.d[1];
+    }
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E778 VESRLV - Vector Element Shift Right Logical Vector   [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_right_logical_vector )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &a, m4, i, vr_get( &a, m4, i )
+                >> (vr_get( &b, m4, i ) & (ES_BITS( m4 ) - 1)));
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E77A VESRAV - Vector Element Shift Right Arith. Vector    [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_shift_right_arithmetic_vector )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < ES_NUM( m4 ); i++)
+        vr_put( &a, m4, i, (U64)(vr_gets( &a, m4, i )
+                >> (vr_get( &b, m4, i ) & (ES_BITS( m4 ) - 1))));
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E77C VSRL   - Vector Shift Right Logical                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_right_logical )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shr128( &a, &a, VR_B( b, 7 ) & 0x07, false );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E77D VSRLB  - Vector Shift Right Logical by Byte          [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_right_logical_by_byte )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shr128( &a, &a, VR_B( b, 7 ) & 0x78, false );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E77E VSRA   - Vector Shift Right Arithmetic               [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_right_arithmetic )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shr128( &a, &a, VR_B( b, 7 ) & 0x07, true );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E77F VSRAB  - Vector Shift Right Arithmetic by Byte       [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_shift_right_arithmetic_by_byte )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    zv_shr128( &a, &a, VR_B( b, 7 ) & 0x78, true );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E780 VFEE   - Vector Find Element Equal                   [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_element_equal )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b, m, zero;                  /* Vector work areas         */
+int     first_equal, first_zero = 16;   /* Byte indexes of matches   */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    vr_cmpeq( &m, &a, &b, m4 );
+    first_equal = vr_leftmost( &m );
+
+    if (m5 & 0x2)                       /* Zero search?              */
+    {
+        zero.d[0] = zero.d[1] = 0;
+        vr_cmpeq( &m, &a, &zero, m4 );
+        first_zero = vr_leftmost( &m );
+    }
+
+    m.d[0] = MIN( first_equal, first_zero );
+    m.d[1] = 0;
+    vr_store( regs, v1, &m );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_find_cc( first_equal, first_zero );
+}
+
+/*-------------------------------------------------------------------*/
+/* E781 VFENE  - Vector Find Element Not Equal               [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_element_not_equal )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b, m, zero;                  /* Vector work areas         */
+int     first_ne, first_zero = 16;      /* Byte indexes of matches   */
+BYTE    cc = 3;                         /* Condition code            */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    vr_cmpeq( &m, &a, &b, m4 );
+    m.d[0] = ~m.d[0];
+    m.d[1] = ~m.d[1];
+    first_ne = vr_leftmost( &m );
+
+    if (m5 & 0x2)                       /* Zero search?              */
+    {
+        zero.d[0] = zero.d[1] = 0;
+        vr_cmpeq( &m, &a, &zero, m4 );
+        first_zero = vr_leftmost( &m );
+    }
+
+    if (first_zero < first_ne)
+        cc = 0;
+    else if (first_ne < 16)
+        cc = vr_get( &a, m4, first_ne >> m4 )
+           < vr_get( &b, m4, first_ne >> m4 ) ? 1 : 2;
+
+    m.d[0] = MIN( first_ne, first_zero );
+    m.d[1] = 0;
+    vr_store( regs, v1, &m );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = cc;
+}
+
+/*-------------------------------------------------------------------*/
+/* E782 VFAE   - Vector Find Any Element Equal               [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_find_any_element_equal )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b, m, acc, zero;             /* Vector work areas         */
+int     first_equal, first_zero = 16;   /* Byte indexes of matches   */
+int     i;                              /* Element index             */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    /* Compare all of v2 against each element of v3 in turn */
+    acc.d[0] = acc.d[1] = 0;
+    for (i=0; i < ES_NUM( m4 ); i++)
+    {
+        vr_splat( &m, m4, vr_get( &b, m4, i ));
+        vr_cmpeq( &m, &a, &m, m4 );
+        acc.d[0] |= m.d[0];
+        acc.d[1] |= m.d[1];
+    }
+
+    if (m5 & 0x8)                       /* Invert result?            */
+    {
+        acc.d[0] = ~acc.d[0];
+        acc.d[1] = ~acc.d[1];
+    }
+    first_equal = vr_leftmost( &acc );
+
+    if (m5 & 0x2)                       /* Zero search?              */
+    {
+        zero.d[0] = zero.d[1] = 0;
+        vr_cmpeq( &m, &a, &zero, m4 );
+        first_zero = vr_leftmost( &m );
+    }
+
+    if (m5 & 0x4)                       /* Result type: element mask */
+        vr_store( regs, v1, &acc );
+    else
+    {
+        m.d[0] = MIN( first_equal, first_zero );
+        m.d[1] = 0;
+        vr_store( regs, v1, &m );
+    }
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_find_cc( first_equal, first_zero );
+}
+
+/*-------------------------------------------------------------------*/
+/* E784 VPDI   - Vector Permute Doubleword Immediate         [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_permute_doubleword_immediate )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    r.d[0] = a.d[ (m4 & 0x4) ? 1 : 0 ];
+    r.d[1] = b.d[ (m4 & 0x1) ? 1 : 0 ];
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/*  Compare each element of a vector with one range limit under the  */
+/*  control of the VSTRC equal (0x80), low (0x40) and high (0x20)    */
+/*  control bits, ORing the resulting element mask into r.           */
+/*-------------------------------------------------------------------*/
+static INLINE void ARCH_DEP( zv_range_compare )( VRQW* r, const VRQW* a,
+                                                 U64 limit, BYTE ctl, int es )
+{
+    VRQW  l, m;
+
+    r->d[0] = r->d[1] = 0;
+    vr_splat( &l, es, limit );
+
+    if (ctl & 0x80)
+    {
+        vr_cmpeq( &m, a, &l, es );
+        r->d[0] |= m.d[0];
+        r->d[1] |= m.d[1];
+    }
+    if (ctl & 0x40)
+    {
+        vr_cmphl( &m, &l, a, es );
+        r->d[0] |= m.d[0];
+        r->d[1] |= m.d[1];
+    }
+    if (ctl & 0x20)
+    {
+        vr_cmphl( &m, a, &l, es );
+        r->d[0] |= m.d[0];
+        r->d[1] |= m.d[1];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* E78A VSTRC  - Vector String Range Compare                 [VRR-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_string_range_compare )
+{
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, c, lo, hi, acc, zero;     /* Vector work areas         */
+int     first_match, first_zero = 16;   /* Byte indexes of matches   */
+int     shift, i;                       /* Control shift, index      */
+
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m5 > 2, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+
+    /* Each even/odd element pair of v3 is a range whose limits are  */
+    /* compared as controlled by the same elements of v4.  Rather    */
+    /* than looping over every element of v2, each range is checked  */
+    /* against the whole of v2 at once.                              */
+    shift = ES_BITS( m5 ) - 8;
+    acc.d[0] = acc.d[1] = 0;
+    for (i=0; i < ES_NUM( m5 ); i += 2)
+    {
+        ARCH_DEP( zv_range_compare )( &lo, &a, vr_get( &b, m5, i ),
+                               (BYTE)(vr_get( &c, m5, i ) >> shift), m5 );
+        ARCH_DEP( zv_range_compare )( &hi, &a, vr_get( &b, m5, i + 1 ),
+                               (BYTE)(vr_get( &c, m5, i + 1 ) >> shift), m5 );
+        acc.d[0] |= lo.d[0] & hi.d[0];
+        acc.d[1] |= lo.d[1] & hi.d[1];
+    }
+
+    if (m6 & 0x8)                       /* Invert result?            */
+    {
+        acc.d[0] = ~acc.d[0];
+        acc.d[1] = ~acc.d[1];
+    }
+    first_match = vr_leftmost( &acc );
+
+    if (m6 & 0x2)                       /* Zero search?              */
+    {
+        zero.d[0] = zero.d[1] = 0;
+        vr_cmpeq( &lo, &a, &zero, m5 );
+        first_zero = vr_leftmost( &lo );
+    }
+
+    if (m6 & 0x4)                       /* Result type: element mask */
+        vr_store( regs, v1, &acc );
+    else
+    {
+        /* Only matches to the left of the zero element count */
+        if (first_match >= first_zero)
+            first_match = 16;
+        lo.d[0] = MIN( first_match, first_zero );
+        lo.d[1] = 0;
+        vr_store( regs, v1, &lo );
+    }
+
+    if (m6 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_find_cc( first_match, first_zero );
+}
+
+/*-------------------------------------------------------------------*/
+/* E78C VPERM  - Vector Permute                              [VRR-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_permute )
+{
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, c, r;                     /* Vector work areas         */
+int     i, x;                           /* Byte index, source index  */
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    for (i=0; i < 16; i++)
+    {
+        x = VR_B( c, i ) & 0x1F;
+        VR_B( r, i ) = (x < 16) ? VR_B( a, x ) : VR_B( b, x - 16 );
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E78D VSEL   - Vector Select                               [VRR-e] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_select )
+{
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, c;                        /* Vector work areas         */
+
+    VRR_E( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    vr_select( &a, &c, &a, &b );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E794 VPK    - Vector Pack                                 [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_pack )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+int     i, n;                           /* Element index, count      */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 < 1 || m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n = ES_NUM( m4 );
+    for (i=0; i < n; i++)
+    {
+        vr_put( &r, m4 - 1, i,     vr_get( &a, m4, i ));
+        vr_put( &r, m4 - 1, n + i, vr_get( &b, m4, i ));
+    }
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E795 VPKLS  - Vector Pack Logical Saturate                [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_pack_logical_saturate )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+U64     max, x;                         /* Saturation limit, element */
+int     i, n, sat = 0;                  /* Index, count, saturated   */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 < 1 || m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n   = ES_NUM( m4 );
+    max = ES_MASK( m4 - 1 );
+    for (i=0; i < 2 * n; i++)
+    {
+        x = (i < n) ? vr_get( &a, m4, i ) : vr_get( &b, m4, i - n );
+        if (x > max)
+        {
+            x = max;
+            sat++;
+        }
+        vr_put( &r, m4 - 1, i, x );
+    }
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = !sat ? 0 : (sat == 2 * n) ? 3 : 1;
+}
+
+/*-------------------------------------------------------------------*/
+/* E797 VPKS   - Vector Pack Saturate                        [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_pack_saturate )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+S64     max, min, x;                    /* Saturation limits, elem   */
+int     i, n, sat = 0;                  /* Index, count, saturated   */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 < 1 || m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    n   = ES_NUM( m4 );
+    max = (S64)(ES_MASK( m4 - 1 ) >> 1);
+    min = -max - 1;
+    for (i=0; i < 2 * n; i++)
+    {
+        x = (i < n) ? vr_gets( &a, m4, i ) : vr_gets( &b, m4, i - n );
+        if (x > max)
+        {
+            x = max;
+            sat++;
+        }
+        else if (x < min)
+        {
+            x = min;
+            sat++;
+        }
+        vr_put( &r, m4 - 1, i, (U64) x );
+    }
+    vr_store( regs, v1, &r );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = !sat ? 0 : (sat == 2 * n) ? 3 : 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*                  Vector multiply helpers                          */
+/*-------------------------------------------------------------------*/
+/* Element sizes 0-2 only, so every product (plus addend) fits into  */
+/* 64 bits.  c is the optional addend of the multiply and add forms. */
+/*-------------------------------------------------------------------*/
+#define ZV_MUL_LOW      0               /* Low half of product       */
+#define ZV_MUL_HIGH     1               /* High half, signed         */
+#define ZV_MUL_LHIGH    2               /* High half, logical        */
+
+static INLINE void ARCH_DEP( zv_multiply )( VRQW* r, const VRQW* a,
+                        const VRQW* b, const VRQW* c, int es, int type )
+{
+    int  i;
+    U64  p;
+
+    for (i=0; i < ES_NUM( es ); i++)
+    {
+        if (type == ZV_MUL_HIGH)
+            p = (U64)((vr_gets( a, es, i ) * vr_gets( b, es, i )
+                    + (c ? vr_gets( c, es, i ) : 0)) >> ES_BITS( es ));
+        else
+        {
+            p = vr_get( a, es, i ) * vr_get( b, es, i )
+              + (c ? vr_get( c, es, i ) : 0);
+            if (type == ZV_MUL_LHIGH)
+                p >>= ES_BITS( es );
+        }
+        vr_put( r, es, i, p );
+    }
+}
+
+/* Multiply the even (odd = 0) or odd (odd = 1) elements giving     */
+/* double-width products, adding the double-width elements of c     */
+static INLINE void ARCH_DEP( zv_multiply_wide )( VRQW* r, const VRQW* a,
+                const VRQW* b, const VRQW* c, int es, int odd, bool sgn )
+{
+    int  i, j;
+    U64  p;
+
+    for (i=0; i < ES_NUM( es ) / 2; i++)
+    {
+        j = (i * 2) + odd;
+        if (sgn)
+            p = (U64)(vr_gets( a, es, j ) * vr_gets( b, es, j ))
+              + (c ? (U64) vr_gets( c, es + 1, i ) : 0);
+        else
+            p = vr_get( a, es, j ) * vr_get( b, es, j )
+              + (c ? vr_get( c, es + 1, i ) : 0);
+        vr_put( r, es + 1, i, p );
+    }
+}
+
+#define ZV_MULTIPLY_INST( _name, _type )                              \
+DEF_INST( _name )                                                     \
+{                                                                     \
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */ \
+VRQW    a, b, r;                        /* Vector work areas         */ \
+                                                                      \
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );                      \
+                                                                      \
+    UNREFERENCED( m5 );                                               \
+    UNREFERENCED( m6 );                                               \
+                                                                      \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                   \
+    ZVECTOR_CHECK( regs );                                            \
+    ZVECTOR_SPEC_CHECK( m4 > 2, regs );                               \
+                                                                      \
+    vr_fetch( regs, v2, &a );                                         \
+    vr_fetch( regs, v3, &b );                                         \
+    _type;                                                            \
+    vr_store( regs, v1, &r );                                         \
+}
+
+#define ZV_MULTIPLY_ADD_INST( _name, _type )                          \
+DEF_INST( _name )                                                     \
+{                                                                     \
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */ \
+VRQW    a, b, c, r;                     /* Vector work areas         */ \
+                                                                      \
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );                      \
+                                                                      \
+    UNREFERENCED( m6 );                                               \
+                                                                      \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                   \
+    ZVECTOR_CHECK( regs );                                            \
+    ZVECTOR_SPEC_CHECK( m5 > 2, regs );                               \
+                                                                      \
+    vr_fetch( regs, v2, &a );                                         \
+    vr_fetch( regs, v3, &b );                                         \
+    vr_fetch( regs, v4, &c );                                         \
+    _type;                                                            \
+    vr_store( regs, v1, &r );                                         \
+}
+
+/*-------------------------------------------------------------------*/
+/* E7A1 VMLH   - Vector Multiply Logical High                [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_logical_high,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, NULL, m4, ZV_MUL_LHIGH ))
+
+/*-------------------------------------------------------------------*/
+/* E7A2 VML    - Vector Multiply Low                         [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_low,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, NULL, m4, ZV_MUL_LOW ))
+
+/*-------------------------------------------------------------------*/
+/* E7A3 VMH    - Vector Multiply High                        [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_high,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, NULL, m4, ZV_MUL_HIGH ))
+
+/*-------------------------------------------------------------------*/
+/* E7A4 VMLE   - Vector Multiply Logical Even                [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_logical_even,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, NULL, m4, 0, false ))
+
+/*-------------------------------------------------------------------*/
+/* E7A5 VMLO   - Vector Multiply Logical Odd                 [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_logical_odd,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, NULL, m4, 1, false ))
+
+/*-------------------------------------------------------------------*/
+/* E7A6 VME    - Vector Multiply Even                        [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_even,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, NULL, m4, 0, true ))
+
+/*-------------------------------------------------------------------*/
+/* E7A7 VMO    - Vector Multiply Odd                         [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_INST( vector_multiply_odd,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, NULL, m4, 1, true ))
+
+/*-------------------------------------------------------------------*/
+/* E7A9 VMALH  - Vector Multiply and Add Logical High        [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_logical_high,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, &c, m5, ZV_MUL_LHIGH ))
+
+/*-------------------------------------------------------------------*/
+/* E7AA VMAL   - Vector Multiply and Add Low                 [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_low,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, &c, m5, ZV_MUL_LOW ))
+
+/*-------------------------------------------------------------------*/
+/* E7AB VMAH   - Vector Multiply and Add High                [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_high,
+    ARCH_DEP( zv_multiply )( &r, &a, &b, &c, m5, ZV_MUL_HIGH ))
+
+/*-------------------------------------------------------------------*/
+/* E7AC VMALE  - Vector Multiply and Add Logical Even        [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_logical_even,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, &c, m5, 0, false ))
+
+/*-------------------------------------------------------------------*/
+/* E7AD VMALO  - Vector Multiply and Add Logical Odd         [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_logical_odd,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, &c, m5, 1, false ))
+
+/*-------------------------------------------------------------------*/
+/* E7AE VMAE   - Vector Multiply and Add Even                [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_even,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, &c, m5, 0, true ))
+
+/*-------------------------------------------------------------------*/
+/* E7AF VMAO   - Vector Multiply and Add Odd                 [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_MULTIPLY_ADD_INST( vector_multiply_and_add_odd,
+    ARCH_DEP( zv_multiply_wide )( &r, &a, &b, &c, m5, 1, true ))
+
+/*-------------------------------------------------------------------*/
+/*  Galois field multiply sum: each double-width result element is   */
+/*  the XOR of the carry-less products of an even/odd element pair   */
+/*-------------------------------------------------------------------*/
+static INLINE void ARCH_DEP( zv_gf_multiply_sum )( VRQW* r, const VRQW* a,
+                                                   const VRQW* b, int es )
+{
+    VRQW  p, q;
+    int   i;
+
+    if (es == 3)
+    {
+        zv_clmul64( &p, a->d[0], b->d[0] );
+        zv_clmul64( &q, a->d[1], b->d[1] );
+        r->d[0] = p.d[0] ^ q.d[0];
+        r->d[1] = p.d[1] ^ q.d[1];
+        return;
+    }
+    r->d[0] = r->d[1] = 0;
+    for (i=0; i < ES_NUM( es ) / 2; i++)
+    {
+        zv_clmul64( &p, vr_get( a, es, 2 * i     ), vr_get( b, es, 2 * i     ));
+        zv_clmul64( &q, vr_get( a, es, 2 * i + 1 ), vr_get( b, es, 2 * i + 1 ));
+        vr_put( r, es + 1, i, p.d[1] ^ q.d[1] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* E7B4 VGFM   - Vector Galois Field Multiply Sum            [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_galois_field_multiply_sum )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, r;                        /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    ARCH_DEP( zv_gf_multiply_sum )( &r, &a, &b, m4 );
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7BC VGFMA  - Vector Galois Field Multiply Sum and Accum. [VRR-d] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_galois_field_multiply_sum_and_accumulate )
+{
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, c, r;                     /* Vector work areas         */
+
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );
+
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m5 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_fetch( regs, v4, &c );
+    ARCH_DEP( zv_gf_multiply_sum )( &r, &a, &b, m5 );
+    r.d[0] ^= c.d[0];
+    r.d[1] ^= c.d[1];
+    vr_store( regs, v1, &r );
+}
+
+/*-------------------------------------------------------------------*/
+/*  Quadword add/subtract with carry: the carry (or borrow           */
+/*  indication) in is bit 127 of v4.  Returns the 128-bit result in  */
+/*  r and the carry out as function value.                           */
+/*-------------------------------------------------------------------*/
+#define ZV_CARRY_INST( _name, _sub, _carry_out )                      \
+DEF_INST( _name )                                                     \
+{                                                                     \
+int     v1, v2, v3, v4, m5, m6;         /* Instruction fields        */ \
+VRQW    a, b, c;                        /* Vector work areas         */ \
+int     carry;                          /* Carry out                 */ \
+                                                                      \
+    VRR_D( inst, regs, v1, v2, v3, v4, m5, m6 );                      \
+                                                                      \
+    UNREFERENCED( m6 );                                               \
+                                                                      \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                   \
+    ZVECTOR_CHECK( regs );                                            \
+    ZVECTOR_SPEC_CHECK( m5 != 4, regs );                              \
+                                                                      \
+    vr_fetch( regs, v2, &a );                                         \
+    vr_fetch( regs, v3, &b );                                         \
+    vr_fetch( regs, v4, &c );                                         \
+    if (_sub)                                                         \
+    {                                                                 \
+        b.d[0] = ~b.d[0];                                             \
+        b.d[1] = ~b.d[1];                                             \
+    }                                                                 \
+    carry = zv_add128( &a, &a, &b, (int)(c.d[1] & 1) );               \
+    if (_carry_out)                                                   \
+    {                                                                 \
+        a.d[0] = 0;                                                   \
+        a.d[1] = carry;                                               \
+    }                                                                 \
+    vr_store( regs, v1, &a );                                         \
+}
+
+/*-------------------------------------------------------------------*/
+/* E7B9 VACCC  - Vector Add with Carry Compute Carry         [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_CARRY_INST( vector_add_with_carry_compute_carry, 0, 1 )
+
+/*-------------------------------------------------------------------*/
+/* E7BB VAC    - Vector Add with Carry                       [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_CARRY_INST( vector_add_with_carry, 0, 0 )
+
+/*-------------------------------------------------------------------*/
+/* E7BD VSBCBI - Vector Sub. with Borrow Comp. Borrow Ind.   [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_CARRY_INST( vector_subtract_with_borrow_compute_borrow_indication, 1, 1 )
+
+/*-------------------------------------------------------------------*/
+/* E7BF VSBI   - Vector Subtract with Borrow Indication      [VRR-d] */
+/*-------------------------------------------------------------------*/
+ZV_CARRY_INST( vector_subtract_with_borrow_indication, 1, 0 )
+
+/*-------------------------------------------------------------------*/
+/*   Unpack the high (elements 0 to n/2-1) or low half of a vector   */
+/*   into double-width elements, sign extended or zero extended      */
+/*-------------------------------------------------------------------*/
+#define ZV_UNPACK_INST( _name, _low, _sgn )                           \
+DEF_INST( _name )                                                     \
+{                                                                     \
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */ \
+VRQW    a, r;                           /* Vector work areas         */ \
+int     i, n;                           /* Element index, count      */ \
+                                                                      \
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );                          \
+                                                                      \
+    UNREFERENCED( m4 );                                               \
+    UNREFERENCED( m5 );                                               \
+                                                                      \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                   \
+    ZVECTOR_CHECK( regs );                                            \
+    ZVECTOR_SPEC_CHECK( m3 > 2, regs );                               \
+                                                                      \
+    vr_fetch( regs, v2, &a );                                         \
+    n = ES_NUM( m3 ) / 2;                                             \
+    for (i=0; i < n; i++)                                             \
+        vr_put( &r, m3 + 1, i, (_sgn)                                 \
+            ? (U64) vr_gets( &a, m3, ((_low) ? n : 0) + i )           \
+            :       vr_get ( &a, m3, ((_low) ? n : 0) + i ));         \
+    vr_store( regs, v1, &r );                                         \
+}
+
+/*-------------------------------------------------------------------*/
+/* E7D4 VUPLL  - Vector Unpack Logical Low                   [VRR-a] */
+/*-------------------------------------------------------------------*/
+ZV_UNPACK_INST( vector_unpack_logical_low,  1, 0 )
+
+/*-------------------------------------------------------------------*/
+/* E7D5 VUPLH  - Vector Unpack Logical High                  [VRR-a] */
+/*-------------------------------------------------------------------*/
+ZV_UNPACK_INST( vector_unpack_logical_high, 0, 0 )
+
+/*-------------------------------------------------------------------*/
+/* E7D6 VUPL   - Vector Unpack Low                           [VRR-a] */
+/*-------------------------------------------------------------------*/
+ZV_UNPACK_INST( vector_unpack_low,          1, 1 )
+
+/*-------------------------------------------------------------------*/
+/* E7D7 VUPH   - Vector Unpack High                          [VRR-a] */
+/*-------------------------------------------------------------------*/
+ZV_UNPACK_INST( vector_unpack_high,         0, 1 )
+
+/*-------------------------------------------------------------------*/
+/* E7D8 VTM    - Vector Test Under Mask                      [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_test_under_mask )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    a, m;                           /* Vector work areas         */
+U64     t0, t1;                         /* Selected bits             */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m3 );
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &m );
+    t0 = a.d[0] & m.d[0];
+    t1 = a.d[1] & m.d[1];
+
+    if (!(t0 | t1))
+        regs->psw.cc = 0;               /* Selected bits all zeros   */
+    else if (t0 == m.d[0] && t1 == m.d[1])
+        regs->psw.cc = 3;               /* Selected bits all ones    */
+    else
+        regs->psw.cc = 1;               /* Selected bits mixed       */
+}
+
+/*-------------------------------------------------------------------*/
+/* E7D9 VECL   - Vector Element Compare Logical              [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_compare_logical )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+U64     x, y;                           /* Compared elements         */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    /* The rightmost element of doubleword 0 is compared */
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    x = vr_get( &a, m3, (ES_NUM( m3 ) / 2) - 1 );
+    y = vr_get( &b, m3, (ES_NUM( m3 ) / 2) - 1 );
+    regs->psw.cc = (x == y) ? 0 : (x < y) ? 1 : 2;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7DB VEC    - Vector Element Compare                      [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_element_compare )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+S64     x, y;                           /* Compared elements         */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v1, &a );
+    vr_fetch( regs, v2, &b );
+    x = vr_gets( &a, m3, (ES_NUM( m3 ) / 2) - 1 );
+    y = vr_gets( &b, m3, (ES_NUM( m3 ) / 2) - 1 );
+    regs->psw.cc = (x == y) ? 0 : (x < y) ? 1 : 2;
+}
+
+/*-------------------------------------------------------------------*/
+/* E7DE VLC    - Vector Load Complement                      [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_complement )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    a, zero;                        /* Vector work areas         */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    zero.d[0] = zero.d[1] = 0;
+    vr_sub( &a, &zero, &a, m3 );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7DF VLP    - Vector Load Positive                        [VRR-a] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_load_positive )
+{
+int     v1, v2, m3, m4, m5;             /* Instruction fields        */
+VRQW    a, n, m, zero;                  /* Vector work areas         */
+
+    VRR_A( inst, regs, v1, v2, m3, m4, m5 );
+
+    UNREFERENCED( m4 );
+    UNREFERENCED( m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m3 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    zero.d[0] = zero.d[1] = 0;
+    n = zero;
+    vr_sub( &n, &zero, &a, m3 );        /* Complemented elements     */
+    vr_cmph( &m, &zero, &a, m3 );       /* Negative elements         */
+    vr_select( &a, &m, &n, &a );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F0 VAVGL  - Vector Average Logical                      [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_average_logical )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+U64     x, y;                           /* Element values            */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+#if defined( ZVECTOR_SSE2 )
+    if (m4 < 2)
+    {
+        a.x = m4 ? _mm_avg_epu16( a.x, b.x ) : _mm_avg_epu8( a.x, b.x );
+        vr_store( regs, v1, &a );
+        return;
+    }
+#endif
+    /* (a + b + 1) / 2 without overflowing the element */
+    for (i=0; i < ES_NUM( m4 ); i++)
+    {
+        x = vr_get( &a, m4, i );
+        y = vr_get( &b, m4, i );
+        vr_put( &a, m4, i, (x >> 1) + (y >> 1) + ((x | y) & 1) );
+    }
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F1 VACC   - Vector Add Compute Carry                    [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_add_compute_carry )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, s, c;                     /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 4, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (m4 == 4)
+    {
+        c.d[1] = zv_add128( &s, &a, &b, 0 );
+        c.d[0] = 0;
+    }
+    else
+    {
+        /* There was a carry wherever the sum is below an addend */
+        vr_add( &s, &a, &b, m4 );
+        vr_cmphl( &c, &a, &s, m4 );
+        c.d[0] &= es_lsbs[ m4 ];
+        c.d[1] &= es_lsbs[ m4 ];
+    }
+    vr_store( regs, v1, &c );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F2 VAVG   - Vector Average                              [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_average )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+S64     x, y;                           /* Element values            */
+int     i;                              /* Element index             */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    for (i=0; i < ES_NUM( m4 ); i++)
+    {
+        x = vr_gets( &a, m4, i );
+        y = vr_gets( &b, m4, i );
+        vr_put( &a, m4, i, (U64)((x >> 1) + (y >> 1) + ((x | y) & 1)) );
+    }
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F3 VA     - Vector Add                                  [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_add )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 4, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    if (m4 == 4)
+        zv_add128( &a, &a, &b, 0 );
+    else
+        vr_add( &a, &a, &b, m4 );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F5 VSCBI  - Vector Subtract Compute Borrow Indication   [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_subtract_compute_borrow_indication )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b, c;                        /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 4, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+
+    if (m4 == 4)
+    {
+        c.d[0] = 0;
+        c.d[1] = (a.d[0] > b.d[0]) || (a.d[0] == b.d[0] && a.d[1] >= b.d[1]);
+    }
+    else
+    {
+        /* No borrow (indication one) wherever a is not below b */
+        vr_cmphl( &c, &b, &a, m4 );
+        c.d[0] = ~c.d[0] & es_lsbs[ m4 ];
+        c.d[1] = ~c.d[1] & es_lsbs[ m4 ];
+    }
+    vr_store( regs, v1, &c );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F7 VS     - Vector Subtract                             [VRR-c] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_subtract )
+{
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );
+
+    UNREFERENCED( m5 );
+    UNREFERENCED( m6 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 4, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    if (m4 == 4)
+    {
+        b.d[0] = ~b.d[0];
+        b.d[1] = ~b.d[1];
+        zv_add128( &a, &a, &b, 1 );
+    }
+    else
+        vr_sub( &a, &a, &b, m4 );
+    vr_store( regs, v1, &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F8 VCEQ   - Vector Compare Equal                        [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_compare_equal )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_cmpeq( &a, &a, &b, m4 );
+    vr_store( regs, v1, &a );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_mask_cc( &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7F9 VCHL   - Vector Compare High Logical                 [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_compare_high_logical )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_cmphl( &a, &a, &b, m4 );
+    vr_store( regs, v1, &a );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_mask_cc( &a );
+}
+
+/*-------------------------------------------------------------------*/
+/* E7FB VCH    - Vector Compare High                         [VRR-b] */
+/*-------------------------------------------------------------------*/
+DEF_INST( vector_compare_high )
+{
+int     v1, v2, v3, m4, m5;             /* Instruction fields        */
+VRQW    a, b;                           /* Vector work areas         */
+
+    VRR_B( inst, regs, v1, v2, v3, m4, m5 );
+
+    TRAN_FLOAT_INSTR_CHECK( regs );
+    ZVECTOR_CHECK( regs );
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );
+
+    vr_fetch( regs, v2, &a );
+    vr_fetch( regs, v3, &b );
+    vr_cmph( &a, &a, &b, m4 );
+    vr_store( regs, v1, &a );
+
+    if (m5 & 0x1)                       /* Condition code set?       */
+        regs->psw.cc = zv_mask_cc( &a );
+}
+
+/*-------------------------------------------------------------------*/
+/*   Minimum and maximum: select from v2 or v3 under a compare mask  */
+/*-------------------------------------------------------------------*/
+#define ZV_MINMAX_INST( _name, _cmp, _max )                           \
+DEF_INST( _name )                                                     \
+{                                                                     \
+int     v1, v2, v3, m4, m5, m6;         /* Instruction fields        */ \
+VRQW    a, b, m;                        /* Vector work areas         */ \
+                                                                      \
+    VRR_C( inst, regs, v1, v2, v3, m4, m5, m6 );                      \
+                                                                      \
+    UNREFERENCED( m5 );                                               \
+    UNREFERENCED( m6 );                                               \
+                                                                      \
+    TRAN_FLOAT_INSTR_CHECK( regs );                                   \
+    ZVECTOR_CHECK( regs );                                            \
+    ZVECTOR_SPEC_CHECK( m4 > 3, regs );                               \
+                                                                      \
+    vr_fetch( regs, v2, &a );                                         \
+    vr_fetch( regs, v3, &b );                                         \
+    _cmp( &m, &a, &b, m4 );             /* Where a is greater        */ \
+    if (_max)                                                         \
+        vr_select( &a, &m, &a, &b );                                  \
+    else                                                              \
+        vr_select( &a, &m, &b, &a );                                  \
+    vr_store( regs, v1, &a );                                         \
+}
+
+/*-------------------------------------------------------------------*/
+/* E7FC VMNL   - Vector Minimum Logical                      [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MINMAX_INST( vector_minimum_logical, vr_cmphl, 0 )
+
+/*-------------------------------------------------------------------*/
+/* E7FD VMXL   - Vector Maximum Logical                      [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MINMAX_INST( vector_maximum_logical, vr_cmphl, 1 )
+
+/*-------------------------------------------------------------------*/
+/* E7FE VMN    - Vector Minimum                              [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MINMAX_INST( vector_minimum,         vr_cmph,  0 )
+
+/*-------------------------------------------------------------------*/
+/* E7FF VMX    - Vector Maximum                              [VRR-c] */
+/*-------------------------------------------------------------------*/
+ZV_MINMAX_INST( vector_maximum,         vr_cmph,  1 )
+
+/* Some functions are 'generic' functions which are NOT dependent
+   upon any specific build architecture and thus only need to be
+   built once since they work identically for all architectures.
+   Thus the below #define to prevent them from being built again.
+   Also note that this #define must come BEFORE the #endif check
+   for 'FEATURE_129_ZVECTOR_FACILITY' or build errors occur.
+*/
+#define _ZVECTOR_NONARCHDEP_
+
+#endif /* defined( FEATURE_129_ZVECTOR_FACILITY ) */
+
+/*-------------------------------------------------------------------*/
+/*          (delineates ARCH_DEP from non-arch_dep)                  */
+/*-------------------------------------------------------------------*/
+
+#if !defined( _GEN_ARCH )
+
+  #if defined(              _ARCH_NUM_1 )
+    #define   _GEN_ARCH     _ARCH_NUM_1
+    #include "zvector.c"
+  #endif
+
+  #if defined(              _ARCH_NUM_2 )
+    #undef    _GEN_ARCH
+    #define   _GEN_ARCH     _ARCH_NUM_2
+    #include "zvector.c"
+  #endif
+
+#endif /*!defined(_GEN_ARCH)*/
+
+/* end of zvector.c */
@@ -0,0 +1,131 @@
+/* ZVECTOR.H    (C) Copyright Hercules development, 2026             */
+/*              z/Architecture Vector Facility definitions           */
+/*                                                                   */
+/*   Released under "The Q Public License Version 1"                 */
+/*   (http://www.hercules-390.org/herclic.html) as modifications to  */
+/*   Hercules.                                                       */
+
+/*-------------------------------------------------------------------*/
+/* This header defines the vector register work area used by the     */
+/* z/Architecture Vector Facility instructions (zvector.c and the    */
+/* vector floating point instructions in ieee.c) together with the   */
+/* functions that move a vector register between the REGS structure  */
+/* and such a work area.                                             */
+/*                                                                   */
+/* The leftmost 64 bits of vector registers 0-15 ARE the floating    */
+/* point registers.  REGS therefore only holds bits 64-127 of every  */
+/* vector register (vrl) plus bits 0-63 of vector registers 16-31    */
+/* (vrh).  Instructions never access those arrays directly; they     */
+/* always go through the below vr_fetch / vr_store functions.        */
+/*-------------------------------------------------------------------*/
+
+#ifndef _ZVECTOR_H_
+#define _ZVECTOR_H_
+
+#if defined( _FEATURE_129_ZVECTOR_FACILITY )
+
+/*-------------------------------------------------------------------*/
+/*                  Vector register work area                        */
+/*-------------------------------------------------------------------*/
+/* The two doublewords are kept in architectural order (d[0] holds   */
+/* bits 0-63) but each doubleword is in HOST byte order, so that the */
+/* elements of a vector line up with the lanes of the host's own     */
+/* 128-bit SIMD registers.  Element-wise operations can thus use the */
+/* host SIMD instructions directly.  The VR_B/VR_H/VR_F/VR_D macros  */
+/* must be used to address an element by its architectural number.  */
+/*-------------------------------------------------------------------*/
+
+#if defined( _GCC_SSE2_ ) || defined( _MSVC_ )
+  #define ZVECTOR_SSE2                  /* Use SSE2 intrinsics       */
+#elif defined( __GNUC__ ) && defined( __aarch64__ ) && defined( __ARM_NEON ) \
+   && !defined( WORDS_BIGENDIAN )
+  #include <arm_neon.h>
+  #define ZVECTOR_NEON                  /* Use NEON intrinsics       */
+#endif
+
+typedef union
+{
+    U64     d[2];                       /* Doubleword elements       */
+    U32     f[4];                       /* Word elements             */
+    U16     h[8];                       /* Halfword elements         */
+    BYTE    b[16];                      /* Byte elements             */
+#if defined( ZVECTOR_SSE2 )
+    __m128i x;                          /* Host SSE2 register        */
+#elif defined( ZVECTOR_NEON )
+    uint8x16_t x;                       /* Host NEON register        */
+#endif
+}
+VRQW;
+
+#if defined( WORDS_BIGENDIAN )
+  #define VR_B( _vr, _i )   ((_vr).b[ (_i)     ])
+  #define VR_H( _vr, _i )   ((_vr).h[ (_i)     ])
+  #define VR_F( _vr, _i )   ((_vr).f[ (_i)     ])
+#else
+  #define VR_B( _vr, _i )   ((_vr).b[ (_i) ^ 7 ])
+  #define VR_H( _vr, _i )   ((_vr).h[ (_i) ^ 3 ])
+  #define VR_F( _vr, _i )   ((_vr).f[ (_i) ^ 1 ])
+#endif
+  #define VR_D( _vr, _i )   ((_vr).d[ (_i)     ])
+
+/*-------------------------------------------------------------------*/
+/*           Move a vector register to or from REGS                  */
+/*-------------------------------------------------------------------*/
+static INLINE void vr_fetch( REGS* regs, int v, VRQW* vr )
+{
+    if (v < 16)
+        vr->d[0] = ((U64) regs->fpr[ v << 1 ] << 32) | regs->fpr[ (v << 1) + 1 ];
+    else
+        vr->d[0] = regs->vrh[ v - 16 ];
+
+    vr->d[1] = regs->vrl[ v ];
+}
+
+static INLINE void vr_store( REGS* regs, int v, const VRQW* vr )
+{
+    if (v < 16)
+    {
+        regs->fpr[  v << 1      ] = (U32)(vr->d[0] >> 32);
+        regs->fpr[ (v << 1) + 1 ] = (U32)(vr->d[0]      );
+    }
+    else
+        regs->vrh[ v - 16 ] = vr->d[0];
+
+    regs->vrl[ v ] = vr->d[1];
+}
+
+/*-------------------------------------------------------------------*/
+/*   Store all 32 vector registers in architectural (big-endian)     */
+/*   format into a 512 byte area, or load them back from one.  Used  */
+/*   by SIGP store additional status, machine check extended save    */
+/*   areas and the suspend/resume support.                           */
+/*-------------------------------------------------------------------*/
+static INLINE void vr_store_all( REGS* regs, BYTE* area )
+{
+    VRQW  vr;
+    int   v;
+
+    for (v=0; v < 32; v++, area += 16)
+    {
+        vr_fetch( regs, v, &vr );
+        store_dw( area,     vr.d[0] );
+        store_dw( area + 8, vr.d[1] );
+    }
+}
+
+static INLINE void vr_load_all( REGS* regs, const BYTE* area )
+{
+    VRQW  vr;
+    int   v;
+
+    for (v=0; v < 32; v++, area += 16)
+    {
+        vr.d[0] = fetch_dw( area     );
+        vr.d[1] = fetch_dw( area + 8 );
+        vr_store( regs, v, &vr );
+    }
+}
+
+#endif /* defined( _FEATURE_129_ZVECTOR_FACILITY ) */
+
+#endif /* _ZVECTOR_H_ */